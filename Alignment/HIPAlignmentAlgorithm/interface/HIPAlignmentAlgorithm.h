@@ -67,6 +67,9 @@ class HIPAlignmentAlgorithm : public AlignmentAlgorithmBase
   void fillRoot(const edm::EventSetup& setup);
   bool calcParameters(Alignable* ali,int setDet, double start, double step);
   void collector(void);
+  // user variables of the iteration, to ROOT or to the binary file
+  void writeUserVariables(int iter);
+  std::string binaryFileName(const std::string& rootFileName) const;
   int  fillEventwiseTree(const char *filename, int iter, int ierr);
   // private data members
 
@@ -85,6 +88,8 @@ class HIPAlignmentAlgorithm : public AlignmentAlgorithmBase
   // names of IO root files
   std::string outfile,outfile2,outpath,suvarfile,sparameterfile;
   std::string struefile,smisalignedfile,salignedfile,siterationfile,ssurveyfile;
+  // user variables in a binary file, merged faster by the collector
+  bool theBinaryUserVariables;
 
   // alignment position error parameters
   bool theApplyAPE;
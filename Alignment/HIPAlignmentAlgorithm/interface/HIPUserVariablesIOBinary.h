@@ -0,0 +1,32 @@
+#ifndef HIPUserVariablesIOBinary_H
+#define HIPUserVariablesIOBinary_H
+
+#include <vector>
+
+class Alignable;
+class AlignmentUserVariables;
+
+/** Binary IO of HIPUserVariables, with the content of the tree of
+ *  HIPUserVariablesIORoot: one flat file per iteration, written and
+ *  read in one go.  The records are in the order of the Alignables, so
+ *  reading them back with the same Alignables needs no search.
+ */
+
+class HIPUserVariablesIOBinary
+{
+
+  public:
+
+  typedef std::vector<Alignable*> Alignables;
+
+  /** write user variables */
+  void writeHIPUserVariables (const Alignables& alivec, 
+    const char* filename, int iter, bool validCheck, int& ierr);
+
+  /** read user variables, one per Alignable, 0 if not in the file */
+  std::vector<AlignmentUserVariables*> readHIPUserVariables 
+    (const Alignables& alivec, const char* filename, int iter, int& ierr);
+
+};
+
+#endif
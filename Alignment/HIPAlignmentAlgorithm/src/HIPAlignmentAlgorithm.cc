@@ -24,6 +24,7 @@
 #include "Alignment/CommonAlignmentAlgorithm/interface/AlignmentParameterSelector.h"
 #include "Alignment/HIPAlignmentAlgorithm/interface/HIPUserVariables.h"
 #include "Alignment/HIPAlignmentAlgorithm/interface/HIPUserVariablesIORoot.h"
+#include "Alignment/HIPAlignmentAlgorithm/interface/HIPUserVariablesIOBinary.h"
 #include "Alignment/MuonAlignment/interface/AlignableMuon.h"
 #include <DataFormats/GeometrySurface/interface/LocalError.h> 
 #include "Alignment/TrackerAlignment/interface/AlignableTracker.h"
@@ -61,6 +62,7 @@ HIPAlignmentAlgorithm::HIPAlignmentAlgorithm(const edm::ParameterSet& cfg):
   salignedfile = cfg.getParameter<std::string>("alignedFile");
   siterationfile = cfg.getParameter<std::string>("iterationFile");
   suvarfile = cfg.getParameter<std::string>("uvarFile");
+  theBinaryUserVariables = cfg.existsAs<bool>("binaryUserVariables") ? cfg.getParameter<bool>("binaryUserVariables") : false;
   sparameterfile = cfg.getParameter<std::string>("parameterFile");
   ssurveyfile = cfg.getParameter<std::string>("surveyFile");
 	
@@ -365,11 +367,8 @@ void HIPAlignmentAlgorithm::terminate(const edm::EventSetup& iSetup)
     }
 	
   // write user variables
-  HIPUserVariablesIORoot HIPIO;
-
    if(!isCollector) //don't store userVariable in main, to save time
-   HIPIO.writeHIPUserVariables (theAlignables,suvarfile.c_str(),
-			       theIteration,false,ioerr);
+   writeUserVariables(theIteration);
 	
   // now calculate alignment corrections ...
   int ialigned=0;
@@ -413,8 +412,7 @@ void HIPAlignmentAlgorithm::terminate(const edm::EventSetup& iSetup)
 
   // write user variables	
   if(isCollector)
-  HIPIO.writeHIPUserVariables (theAlignables,suvarfile.c_str(),
-                               theIteration,false,ioerr);
+  writeUserVariables(theIteration);
 
   // write new absolute positions to disk
   theIO.writeAlignableAbsolutePositions(theAlignables,
@@ -1343,12 +1341,41 @@ bool HIPAlignmentAlgorithm::calcParameters(Alignable* ali , int setDet, double s
 
 //-----------------------------------------------------------------------------
 
+std::string HIPAlignmentAlgorithm::binaryFileName(const std::string& rootFileName) const
+{
+  std::string fileName(rootFileName);
+  const std::string rootExtension(".root");
+  if (fileName.size()>=rootExtension.size() &&
+      fileName.compare(fileName.size()-rootExtension.size(),rootExtension.size(),rootExtension)==0)
+    fileName.erase(fileName.size()-rootExtension.size());
+  return fileName+".bin";
+}
+
+//-----------------------------------------------------------------------------
+
+void HIPAlignmentAlgorithm::writeUserVariables(int iter)
+{
+  if (theBinaryUserVariables) {
+    HIPUserVariablesIOBinary HIPIO;
+    HIPIO.writeHIPUserVariables(theAlignables,binaryFileName(suvarfile).c_str(),
+                                iter,false,ioerr);
+  }
+  else {
+    HIPUserVariablesIORoot HIPIO;
+    HIPIO.writeHIPUserVariables(theAlignables,suvarfile.c_str(),
+                                iter,false,ioerr);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
 void HIPAlignmentAlgorithm::collector(void)
 {
   edm::LogWarning("Alignment") << "[HIPAlignmentAlgorithm::collector] called for iteration "
 			       << theIteration << std::endl;
 	
   HIPUserVariablesIORoot HIPIO;
+  HIPUserVariablesIOBinary HIPIOBinary;
 
 	
   for (int ijob=1;ijob<=theCollectorNJobs;ijob++) {
@@ -1361,7 +1388,9 @@ void HIPAlignmentAlgorithm::collector(void)
     ss >> str;
     std::string uvfile = theCollectorPath+"/job"+str+"/IOUserVariables.root";
 		
-    std::vector<AlignmentUserVariables*> uvarvec = 
+    std::vector<AlignmentUserVariables*> uvarvec = theBinaryUserVariables ?
+      HIPIOBinary.readHIPUserVariables(theAlignables, binaryFileName(uvfile).c_str(),
+				       theIteration, ioerr) :
       HIPIO.readHIPUserVariables(theAlignables, uvfile.c_str(),
 				 theIteration, ioerr);
     
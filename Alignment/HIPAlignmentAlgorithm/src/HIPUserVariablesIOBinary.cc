@@ -0,0 +1,169 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "Alignment/CommonAlignment/interface/Alignable.h"
+#include "Alignment/CommonAlignment/interface/AlignmentParameters.h"
+#include "Alignment/HIPAlignmentAlgorithm/interface/HIPUserVariables.h"
+
+// this class's header
+#include "Alignment/HIPAlignmentAlgorithm/interface/HIPUserVariablesIOBinary.h"
+
+namespace {
+  const char magic[8] = {'H','I','P','U','V','A','R','1'};
+
+  // record of one Alignable:
+  // id, objId, nhit, np, ndof, jtvj[np*(np+1)/2], jtve[np], chi2, par[np], parError[np]
+
+  template <typename T>
+  void put(std::vector<char>& buffer, const T& value)
+  {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  template <typename T>
+  bool get(const std::vector<char>& buffer, size_t& pos, T& value)
+  {
+    if (pos + sizeof(T) > buffer.size()) return false;
+    std::memcpy(&value, &buffer[pos], sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void 
+HIPUserVariablesIOBinary::writeHIPUserVariables (const Alignables& alivec, 
+  const char* filename, int iter, bool validCheck, int& ierr)
+{
+  ierr=0;
+  std::vector<char> buffer(magic, magic + sizeof(magic));
+  put(buffer, iter);
+  int count=0;
+  put(buffer, count); // set below
+
+  for (auto ali : alivec) {
+    AlignmentParameters* ap=ali->alignmentParameters();
+    if (validCheck && !ap->isValid()) continue;
+
+    HIPUserVariables* uvar = dynamic_cast<HIPUserVariables*>(ap->userVariables());
+    if (uvar==0) {
+      edm::LogError("Alignment") <<"UserVariables not found!"; 
+      ierr=-2;
+      return;
+    }
+
+    int np=uvar->jtve.num_row();
+    put(buffer, static_cast<unsigned int>(ali->id()));
+    put(buffer, static_cast<int>(ali->alignableObjectId()));
+    put(buffer, uvar->nhit);
+    put(buffer, np);
+    put(buffer, uvar->alindof);
+    for(int row=0;row<np;row++)
+      for(int col=row;col<np;col++) put(buffer, double(uvar->jtvj[row][col]));
+    for(int row=0;row<np;row++) put(buffer, double(uvar->jtve[row]));
+    put(buffer, uvar->alichi2);
+    for(int row=0;row<np;row++) put(buffer, double(uvar->alipar[row]));
+    for(int row=0;row<np;row++) put(buffer, double(uvar->alierr[row]));
+    count++;
+  }
+  std::memcpy(&buffer[sizeof(magic) + sizeof(iter)], &count, sizeof(count));
+
+  std::ofstream file(filename, std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!file) { ierr=-1; return; }
+  file.write(&buffer[0], buffer.size());
+  file.close();
+  if (!file) { ierr=-3; return; }
+
+  edm::LogInfo("Alignment") << "@SUB=HIPUserVariablesIOBinary::writeHIPUserVariables"
+                            << "Write variables all,written: " << alivec.size() <<","<< count;
+}
+
+// ----------------------------------------------------------------------------
+
+std::vector<AlignmentUserVariables*> 
+HIPUserVariablesIOBinary::readHIPUserVariables (const Alignables& alivec, 
+  const char* filename, int iter, int& ierr)
+{
+  std::vector<AlignmentUserVariables*> result;
+  ierr=0;
+
+  std::ifstream file(filename, std::ios::binary | std::ios::in);
+  if (!file) { ierr=-1; return result; }
+  const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  size_t pos=sizeof(magic);
+  int fileIter=0;
+  int count=0;
+  if (buffer.size() < sizeof(magic) || std::memcmp(&buffer[0], magic, sizeof(magic)) != 0 ||
+      !get(buffer, pos, fileIter) || !get(buffer, pos, count) || fileIter != iter) {
+    edm::LogError("Alignment") << "@SUB=HIPUserVariablesIOBinary::readHIPUserVariables"
+                               << filename << " is not a file of HIP user variables of iteration " << iter;
+    ierr=-1;
+    return result;
+  }
+
+  // the user variables of the file, by id and type of their Alignable
+  std::map<std::pair<unsigned int,int>, HIPUserVariables*> uvarmap;
+  std::vector<std::pair<std::pair<unsigned int,int>, HIPUserVariables*> > uvarvec;
+  uvarvec.reserve(count);
+  for (int i=0;i<count;i++) {
+    unsigned int id=0;
+    int objId=0, nhit=0, np=0, ndof=0;
+    bool ok = get(buffer, pos, id) && get(buffer, pos, objId) && get(buffer, pos, nhit) &&
+      get(buffer, pos, np) && get(buffer, pos, ndof) && np >= 0;
+    HIPUserVariables* uvar = ok ? new HIPUserVariables(np) : 0;
+    double value=0.;
+    for(int row=0;ok && row<np;row++)
+      for(int col=row;ok && col<np;col++) { ok=get(buffer, pos, value); uvar->jtvj[row][col]=value; }
+    for(int row=0;ok && row<np;row++) { ok=get(buffer, pos, value); uvar->jtve[row]=value; }
+    ok = ok && get(buffer, pos, uvar->alichi2);
+    for(int row=0;ok && row<np;row++) { ok=get(buffer, pos, value); uvar->alipar[row]=value; }
+    for(int row=0;ok && row<np;row++) { ok=get(buffer, pos, value); uvar->alierr[row]=value; }
+    if (!ok) {
+      delete uvar;
+      for (auto const& entry : uvarvec) delete entry.second;
+      edm::LogError("Alignment") << "@SUB=HIPUserVariablesIOBinary::readHIPUserVariables"
+                                 << filename << " is truncated";
+      ierr=-2;
+      return result;
+    }
+    uvar->nhit=nhit;
+    uvar->alindof=ndof;
+    uvarvec.push_back(std::make_pair(std::make_pair(id,objId), uvar));
+  }
+
+  // same Alignables as when written: take the records in order
+  bool inOrder = (uvarvec.size() == alivec.size());
+  for (unsigned int i=0;inOrder && i<alivec.size();i++) {
+    inOrder = (uvarvec[i].first == std::make_pair(static_cast<unsigned int>(alivec[i]->id()),
+                                                  static_cast<int>(alivec[i]->alignableObjectId())));
+  }
+  if (inOrder) {
+    for (auto const& entry : uvarvec) result.push_back(entry.second);
+  } else {
+    for (auto const& entry : uvarvec) {
+      if (!uvarmap.insert(entry).second) delete entry.second;
+    }
+    for (auto ali : alivec) {
+      auto found = uvarmap.find(std::make_pair(static_cast<unsigned int>(ali->id()),
+                                               static_cast<int>(ali->alignableObjectId())));
+      if (found == uvarmap.end()) {
+        result.push_back(0);
+      } else {
+        result.push_back(found->second);
+        uvarmap.erase(found);
+      }
+    }
+    for (auto const& entry : uvarmap) delete entry.second;
+  }
+
+  edm::LogInfo("Alignment") << "@SUB=HIPUserVariablesIOBinary::readHIPUserVariables"
+                            << "Read variables all,read: " << alivec.size() <<","<< count;
+  return result;
+}
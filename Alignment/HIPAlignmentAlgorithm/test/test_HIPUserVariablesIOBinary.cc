@@ -0,0 +1,134 @@
+#include "Alignment/CommonAlignment/interface/AlignableComposite.h"
+#include "Alignment/CommonAlignmentParametrization/interface/RigidBodyAlignmentParameters.h"
+#include "Alignment/HIPAlignmentAlgorithm/interface/HIPUserVariables.h"
+#include "Alignment/HIPAlignmentAlgorithm/interface/HIPUserVariablesIOBinary.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+  const char* const fileName = "test_HIPUserVariablesIOBinary.bin";
+
+  // distinct values for each Alignable and each field
+  HIPUserVariables* makeUserVariables(int i)
+  {
+    const int np = RigidBodyAlignmentParameters::N_PARAM;
+    HIPUserVariables* uvar = new HIPUserVariables(np);
+    for (int row=0;row<np;row++) {
+      for (int col=row;col<np;col++) uvar->jtvj[row][col] = 1000.*i + 10.*row + col + 0.5;
+      uvar->jtve[row] = -1000.*i - row - 0.25;
+      uvar->alipar[row] = 0.001*i + 1.e-5*row;
+      uvar->alierr[row] = 0.0001*i + 1.e-6*row;
+    }
+    uvar->alichi2 = 12.5*i;
+    uvar->alindof = 3*i;
+    uvar->nhit = 7*i + 1;
+    return uvar;
+  }
+
+  void checkEqual(const HIPUserVariables* a, const HIPUserVariables* b)
+  {
+    assert(a!=0 && b!=0);
+    const int np = a->jtve.num_row();
+    assert(b->jtve.num_row()==np);
+    for (int row=0;row<np;row++) {
+      for (int col=row;col<np;col++) assert(a->jtvj[row][col]==b->jtvj[row][col]);
+      assert(a->jtve[row]==b->jtve[row]);
+      assert(a->alipar[row]==b->alipar[row]);
+      assert(a->alierr[row]==b->alierr[row]);
+    }
+    assert(a->alichi2==b->alichi2);
+    assert(a->alindof==b->alindof);
+    assert(a->nhit==b->nhit);
+  }
+
+  const HIPUserVariables* userVariables(const Alignable* ali)
+  {
+    return dynamic_cast<const HIPUserVariables*>(ali->alignmentParameters()->userVariables());
+  }
+
+  void deleteAll(std::vector<AlignmentUserVariables*>& uvars)
+  {
+    for (auto uvar : uvars) delete uvar;
+    uvars.clear();
+  }
+}
+
+int main(int argc, char**argv)
+{
+  // Alignables of two types, with the same ids for some of them
+  HIPUserVariablesIOBinary::Alignables alignables;
+  for (int i=0;i<10;i++) {
+    Alignable* ali = new AlignableComposite(100+i%6, i<6 ? align::TPBModule : align::TIBModule);
+    AlignmentParameters* ap = new RigidBodyAlignmentParameters(ali, false);
+    ap->setUserVariables(makeUserVariables(i));
+    ali->setAlignmentParameters(ap);
+    alignables.push_back(ali);
+  }
+
+  HIPUserVariablesIOBinary io;
+  int ierr=1;
+  io.writeHIPUserVariables(alignables, fileName, 3, false, ierr);
+  assert(ierr==0);
+
+  // the same Alignables: the records are read in order
+  std::vector<AlignmentUserVariables*> read = io.readHIPUserVariables(alignables, fileName, 3, ierr);
+  assert(ierr==0);
+  assert(read.size()==alignables.size());
+  for (unsigned int i=0;i<alignables.size();i++) {
+    checkEqual(userVariables(alignables[i]), dynamic_cast<HIPUserVariables*>(read[i]));
+  }
+  deleteAll(read);
+
+  // other Alignables, in another order: the records are found by id and type
+  HIPUserVariablesIOBinary::Alignables others(alignables.rbegin(), alignables.rend());
+  Alignable* notWritten = new AlignableComposite(100, align::TOBModule);
+  others.insert(others.begin()+3, notWritten);
+  read = io.readHIPUserVariables(others, fileName, 3, ierr);
+  assert(ierr==0);
+  assert(read.size()==others.size());
+  for (unsigned int i=0;i<others.size();i++) {
+    if (others[i]==notWritten) assert(read[i]==0);
+    else checkEqual(userVariables(others[i]), dynamic_cast<HIPUserVariables*>(read[i]));
+  }
+  deleteAll(read);
+
+  // the invalid parameters are not written with validCheck
+  alignables[2]->alignmentParameters()->setValid(false);
+  io.writeHIPUserVariables(alignables, fileName, 4, true, ierr);
+  assert(ierr==0);
+  read = io.readHIPUserVariables(alignables, fileName, 4, ierr);
+  assert(ierr==0);
+  assert(read.size()==alignables.size());
+  for (unsigned int i=0;i<alignables.size();i++) {
+    if (i==2) assert(read[i]==0);
+    else checkEqual(userVariables(alignables[i]), dynamic_cast<HIPUserVariables*>(read[i]));
+  }
+  deleteAll(read);
+
+  // a file of another iteration is refused
+  read = io.readHIPUserVariables(alignables, fileName, 3, ierr);
+  assert(ierr==-1);
+  assert(read.empty());
+
+  // and so is a truncated file
+  std::vector<char> content;
+  {
+    std::ifstream file(fileName, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    file.write(&content[0], content.size()-1);
+  }
+  read = io.readHIPUserVariables(alignables, fileName, 4, ierr);
+  assert(ierr==-2);
+  assert(read.empty());
+
+  std::remove(fileName);
+  delete notWritten;
+  for (auto ali : alignables) delete ali;
+  return 0;
+}
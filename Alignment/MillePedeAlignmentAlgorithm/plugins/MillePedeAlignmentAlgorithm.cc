@@ -62,6 +62,8 @@
 
 #include <TMath.h>
 #include <TMatrixDSymEigen.h>
+
+#include "tbb/parallel_for.h"
 typedef TransientTrackingRecHit::ConstRecHitContainer ConstRecHitContainer;
 typedef TransientTrackingRecHit::ConstRecHitPointer   ConstRecHitPointer;
 typedef TrajectoryFactoryBase::ReferenceTrajectoryCollection RefTrajColl;
@@ -94,7 +96,8 @@ MillePedeAlignmentAlgorithm::MillePedeAlignmentAlgorithm(const edm::ParameterSet
   theLastWrittenIov(0),
   theGblDoubleBinary(cfg.getParameter<bool>("doubleBinary")),
   runAtPCL_(cfg.getParameter<bool>("runAtPCL")),
-  ignoreHitsWithoutGlobalDerivatives_(cfg.getParameter<bool>("ignoreHitsWithoutGlobalDerivatives"))
+  ignoreHitsWithoutGlobalDerivatives_(cfg.getParameter<bool>("ignoreHitsWithoutGlobalDerivatives")),
+  theParallelGbl(cfg.existsAs<bool>("parallelGbl") ? cfg.getParameter<bool>("parallelGbl") : false)
 {
   if (!theDir.empty() && theDir.find_last_of('/') != theDir.size()-1) theDir += '/';// may need '/'
   edm::LogInfo("Alignment") << "@SUB=MillePedeAlignmentAlgorithm" << "Start in mode '"
@@ -397,6 +400,8 @@ void MillePedeAlignmentAlgorithm::run(const edm::EventSetup &setup, const EventI
     }
 
   } // end of reference trajectory and track loop
+
+  if (!theGblTrajectories.empty()) this->writeGblTrajectories();
 }
 
 //____________________________________________________
@@ -425,25 +430,10 @@ MillePedeAlignmentAlgorithm::addReferenceTrajectory(const edm::EventSetup &setup
       hitResultXy.first = numPointsWithMeas;
       // check #hits criterion
       if (hitResultXy.first == 0 || hitResultXy.first < theMinNumHits) return hitResultXy;
-      // construct GBL trajectory
-      if (refTrajPtr->gblInput().size() == 1) {
-        // from single track
-        GblTrajectory aGblTrajectory( refTrajPtr->gblInput()[0].first, refTrajPtr->nominalField() != 0 );
-        // GBL fit trajectory
-        /*double Chi2;
-        int Ndf;
-        double lostWeight;
-        aGblTrajectory.fit(Chi2, Ndf, lostWeight);
-        std::cout << " GblFit: " << Chi2 << ", " << Ndf << ", " << lostWeight << std::endl; */
-        // write to MP binary file
-        if (aGblTrajectory.isValid() && aGblTrajectory.getNumPoints() >= theMinNumHits) aGblTrajectory.milleOut(*theBinary);
-      }
-      if (refTrajPtr->gblInput().size() == 2) {
-        // from TwoBodyDecay
-        GblTrajectory aGblTrajectory( refTrajPtr->gblInput(), refTrajPtr->gblExtDerivatives(), refTrajPtr->gblExtMeasurements(), refTrajPtr->gblExtPrecisions() );
-        // write to MP binary file
-        if (aGblTrajectory.isValid() && aGblTrajectory.getNumPoints() >= theMinNumHits) aGblTrajectory.milleOut(*theBinary);
-      }
+      // construct GBL trajectory and write it to MP binary file,
+      // at the end of run(..) if the GBL trajectories are built in parallel
+      if (theParallelGbl) theGblTrajectories.push_back(refTrajPtr);
+      else this->writeGblTrajectory(*refTrajPtr, *theBinary);
     } else {
       // to add hits if all fine:
       std::vector<AlignmentParameters*> parVec(refTrajPtr->recHits().size());
@@ -485,6 +475,51 @@ MillePedeAlignmentAlgorithm::addReferenceTrajectory(const edm::EventSetup &setup
   return hitResultXy;
 }
 
+//____________________________________________________
+void
+MillePedeAlignmentAlgorithm::writeGblTrajectory(ReferenceTrajectoryBase &refTraj, MilleBinary &binary) const
+{
+  if (refTraj.gblInput().size() == 1) {
+    // from single track
+    GblTrajectory aGblTrajectory( refTraj.gblInput()[0].first, refTraj.nominalField() != 0 );
+    // GBL fit trajectory
+    /*double Chi2;
+    int Ndf;
+    double lostWeight;
+    aGblTrajectory.fit(Chi2, Ndf, lostWeight);
+    std::cout << " GblFit: " << Chi2 << ", " << Ndf << ", " << lostWeight << std::endl; */
+    // write to MP binary file
+    if (aGblTrajectory.isValid() && aGblTrajectory.getNumPoints() >= theMinNumHits) aGblTrajectory.milleOut(binary);
+  }
+  if (refTraj.gblInput().size() == 2) {
+    // from TwoBodyDecay
+    GblTrajectory aGblTrajectory( refTraj.gblInput(), refTraj.gblExtDerivatives(), refTraj.gblExtMeasurements(), refTraj.gblExtPrecisions() );
+    // write to MP binary file
+    if (aGblTrajectory.isValid() && aGblTrajectory.getNumPoints() >= theMinNumHits) aGblTrajectory.milleOut(binary);
+  }
+}
+
+//____________________________________________________
+void
+MillePedeAlignmentAlgorithm::writeGblTrajectories()
+{
+  // The GBL trajectories only depend on their input: each group of them is
+  // built in parallel and written to its own buffer, and the buffers are
+  // written to the file in one block each, in the order of the trajectories.
+  const unsigned int groupSize = 4;
+  const unsigned int nGroups = (theGblTrajectories.size() + groupSize - 1) / groupSize;
+  std::vector<std::unique_ptr<MilleBinary> > buffers(nGroups);
+  tbb::parallel_for(0u, nGroups, [&](unsigned int iGroup) {
+      buffers[iGroup] = std::make_unique<MilleBinary>("", theGblDoubleBinary);
+      const unsigned int end = std::min<unsigned int>(theGblTrajectories.size(), (iGroup+1)*groupSize);
+      for (unsigned int i = iGroup*groupSize; i < end; ++i) {
+        this->writeGblTrajectory(*theGblTrajectories[i], *buffers[iGroup]);
+      }
+    });
+  for (auto &buffer : buffers) theBinary->writeRecords(*buffer);
+  theGblTrajectories.clear();
+}
+
 //____________________________________________________
 unsigned int
 MillePedeAlignmentAlgorithm::addHitCount(const std::vector<AlignmentParameters*> &parVec,
@@ -113,6 +113,11 @@ class MillePedeAlignmentAlgorithm : public AlignmentAlgorithmBase
     addReferenceTrajectory(const edm::EventSetup &setup, const EventInfo &eventInfo, 
 			   const ReferenceTrajectoryBase::ReferenceTrajectoryPtr &refTrajPtr);
 
+  /// build the GBL trajectory of a reference trajectory and write it to binary
+  void writeGblTrajectory(ReferenceTrajectoryBase &refTraj, gbl::MilleBinary &binary) const;
+  /// build in parallel the GBL trajectories collected in run(..) and write them to theBinary
+  void writeGblTrajectories();
+
   /// If hit is usable: callMille for x and (probably) y direction.
   /// If globalDerivatives fine: returns 2 if 2D-hit, 1 if 1D-hit, 0 if no Alignable for hit.
   /// Returns -1 if any problem (for params cf. globalDerivativesHierarchy)
@@ -264,6 +269,10 @@ class MillePedeAlignmentAlgorithm : public AlignmentAlgorithmBase
 
   const bool                runAtPCL_;
   const bool                ignoreHitsWithoutGlobalDerivatives_;
+
+  /// build the GBL trajectories of an event in parallel
+  const bool                theParallelGbl;
+  std::vector<ReferenceTrajectoryBase::ReferenceTrajectoryPtr> theGblTrajectories;
 };
 
 DEFINE_EDM_PLUGIN(AlignmentAlgorithmPluginFactory,
@@ -80,8 +80,8 @@ private:
 	VVector solveBand(const VVector &aRightHandSide) const;
 	VMatrix solveBand(const VMatrix &aRightHandSide) const;
 	VMatrix invertBand();
-	VMatrix bandOfAVAT(const VMatrix &anArray,
-			const VSymMatrix &aSymArray) const;
+	void addBandOfAVAT(const VMatrix &anArray, const VSymMatrix &aSymArray,
+			VMatrix &aBand) const;
 };
 }
 #endif /* BORDEREDBANDMATRIX_H_ */
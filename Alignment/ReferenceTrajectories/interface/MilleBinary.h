@@ -54,9 +54,12 @@ public:
 			const std::vector<int> &labGlobal,
 			const std::vector<double> &derGlobal);
 	void writeRecord();
+	void writeRecords(MilleBinary &aBuffer);
 
 private:
+	bool toFile; ///< Flag for records written to the file, else kept in recordBlock
 	std::ofstream binaryFile; ///< Binary File
+	std::vector<char> recordBlock; ///< Records kept in memory
 	std::vector<int> intBuffer; ///< Integer buffer
 	std::vector<float> floatBuffer; ///< Float buffer
 	std::vector<double> doubleBuffer; ///< Double buffer
@@ -132,22 +132,41 @@ void BorderedBandMatrix::solveAndInvertBorderedBand(
 	if (numBorder > 0) { // need to use block matrix decomposition to solve
 		// solve for mixed part
 		const VMatrix auxMat = solveBand(theMixed); // = Xt
-		const VMatrix auxMatT = auxMat.transpose(); // = X
-		// solve for border part
-		const VVector auxVec = aRightHandSide.getVec(numBorder)
-				- auxMat * aRightHandSide.getVec(numCol, numBorder); // = b1 - Xt*b2
-		VSymMatrix inverseBorder = theBorder - theMixed * auxMatT;
+		// solve for border part, X is used as the transpose of Xt
+		VVector auxVec = aRightHandSide.getVec(numBorder); // = b1 - Xt*b2
+		VSymMatrix inverseBorder(theBorder); // = A-Ct*X
+		for (unsigned int i = 0; i < numBorder; ++i) {
+			double sum = 0.0;
+			for (unsigned int k = 0; k < numCol; ++k) {
+				sum += auxMat(i, k) * aRightHandSide(k + numBorder);
+			}
+			auxVec(i) = auxVec(i) - sum;
+			for (unsigned int j = 0; j <= i; ++j) {
+				sum = 0.0;
+				for (unsigned int k = 0; k < numCol; ++k) {
+					sum += theMixed(i, k) * auxMat(j, k);
+				}
+				inverseBorder(i, j) = theBorder(i, j) - sum;
+			}
+		}
 		inverseBorder.invert(); // = E
 		const VVector borderSolution = inverseBorder * auxVec; // = x1
 		// solve for band part
 		const VVector bandSolution = solveBand(
 				aRightHandSide.getVec(numCol, numBorder)); // = x
 		aSolution.putVec(borderSolution);
-		aSolution.putVec(bandSolution - auxMatT * borderSolution, numBorder); // = x2
+		for (unsigned int k = 0; k < numCol; ++k) { // = x2
+			double sum = 0.0;
+			for (unsigned int l = 0; l < numBorder; ++l) {
+				sum += auxMat(l, k) * borderSolution(l);
+			}
+			aSolution(k + numBorder) = bandSolution(k) - sum;
+		}
 		// parts of inverse
 		theBorder = inverseBorder; // E
 		theMixed = inverseBorder * auxMat; // E*Xt (-mixed part of inverse) !!!
-		theBand = inverseBand + bandOfAVAT(auxMatT, inverseBorder); // band(D^-1 + X*E*Xt)
+		addBandOfAVAT(auxMat, inverseBorder, inverseBand); // band(D^-1 + X*E*Xt)
+		theBand = inverseBand;
 	} else {
 		aSolution.putVec(solveBand(aRightHandSide));
 		theBand = inverseBand;
@@ -211,7 +230,7 @@ void BorderedBandMatrix::decomposeBand() {
  */
 VVector BorderedBandMatrix::solveBand(const VVector &aRightHandSide) const {
 
-	int nRow = theBand.getNumRows();
+	int nRow = numBand + 1; // the rows beyond the band width are zero
 	int nCol = theBand.getNumCols();
 	VVector aSolution(aRightHandSide);
 	for (int i = 0; i < nCol; ++i) // forward substitution
@@ -240,7 +259,7 @@ VVector BorderedBandMatrix::solveBand(const VVector &aRightHandSide) const {
  */
 VMatrix BorderedBandMatrix::solveBand(const VMatrix &aRightHandSide) const {
 
-	int nRow = theBand.getNumRows();
+	int nRow = numBand + 1; // the rows beyond the band width are zero
 	int nCol = theBand.getNumCols();
 	VMatrix aSolution(aRightHandSide);
 	for (unsigned int iBorder = 0; iBorder < numBorder; iBorder++) {
@@ -287,31 +306,31 @@ VMatrix BorderedBandMatrix::invertBand() {
 	return inverseBand;
 }
 
-/// Calculate band part of: 'anArray * aSymArray * anArray.T'.
+/// Add band part of: 'anArray.T * aSymArray * anArray' to a band.
 /**
- * \return Band part of product
+ * \param [in] anArray Matrix with a row per border row and a column per band column
+ * \param [in] aSymArray Symmetric border matrix
+ * \param [in,out] aBand Band the product is added to
  */
-VMatrix BorderedBandMatrix::bandOfAVAT(const VMatrix &anArray,
-		const VSymMatrix &aSymArray) const {
+void BorderedBandMatrix::addBandOfAVAT(const VMatrix &anArray,
+		const VSymMatrix &aSymArray, VMatrix &aBand) const {
 	int nBand = numBand;
 	int nCol = numCol;
 	int nBorder = numBorder;
 	double sum;
-	VMatrix aBand((nBand + 1), nCol);
 	for (int i = 0; i < nCol; ++i) {
 		for (int j = std::max(0, i - nBand); j <= i; ++j) {
 			sum = 0.;
 			for (int l = 0; l < nBorder; ++l) { // diagonal
-				sum += anArray(i, l) * aSymArray(l, l) * anArray(j, l);
+				sum += anArray(l, i) * aSymArray(l, l) * anArray(l, j);
 				for (int k = 0; k < l; ++k) { // off diagonal
-					sum += anArray(i, l) * aSymArray(l, k) * anArray(j, k)
-							+ anArray(i, k) * aSymArray(l, k) * anArray(j, l);
+					sum += anArray(l, i) * aSymArray(l, k) * anArray(k, j)
+							+ anArray(k, i) * aSymArray(l, k) * anArray(l, j);
 				}
 			}
-			aBand(i - j, j) = sum;
+			aBand(i - j, j) += sum;
 		}
 	}
-	return aBand;
 }
 
 }
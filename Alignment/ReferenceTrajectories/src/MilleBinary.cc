@@ -12,14 +12,17 @@ namespace gbl {
 
 /// Create binary file.
 /**
- * \param [in] fileName File name
+ * \param [in] fileName File name, if empty the records are kept in memory
+ *  to be written by writeRecords(..) of another MilleBinary
  * \param [in] doublePrec Flag for storage as double values
  * \param [in] aSize Buffer size
  */
 MilleBinary::MilleBinary(const std::string fileName, bool doublePrec,
 		unsigned int aSize) :
-		binaryFile(fileName.c_str(), std::ios::binary | std::ios::out), intBuffer(), floatBuffer(), doubleBuffer(), doublePrecision(
+		toFile(!fileName.empty()), binaryFile(), recordBlock(), intBuffer(), floatBuffer(), doubleBuffer(), doublePrecision(
 				doublePrec) {
+	if (toFile)
+		binaryFile.open(fileName.c_str(), std::ios::binary | std::ios::out);
 	intBuffer.reserve(aSize);
 	intBuffer.push_back(0); // first word is error counter
 	if (doublePrecision) {
@@ -33,7 +36,8 @@ MilleBinary::MilleBinary(const std::string fileName, bool doublePrec,
 }
 
 MilleBinary::~MilleBinary() {
-	binaryFile.close();
+	if (toFile)
+		binaryFile.close();
 }
 
 /// Add data block to (end of) record.
@@ -90,16 +94,35 @@ void MilleBinary::writeRecord() {
 
 	const int recordLength =
 			(doublePrecision) ? -intBuffer.size() * 2 : intBuffer.size() * 2;
-	binaryFile.write(reinterpret_cast<const char*>(&recordLength),
-			sizeof(recordLength));
-	if (doublePrecision)
-		binaryFile.write(reinterpret_cast<char*>(&doubleBuffer[0]),
-				doubleBuffer.size() * sizeof(doubleBuffer[0]));
-	else
-		binaryFile.write(reinterpret_cast<char*>(&floatBuffer[0]),
-				floatBuffer.size() * sizeof(floatBuffer[0]));
-	binaryFile.write(reinterpret_cast<char*>(&intBuffer[0]),
-			intBuffer.size() * sizeof(intBuffer[0]));
+	if (toFile) {
+		binaryFile.write(reinterpret_cast<const char*>(&recordLength),
+				sizeof(recordLength));
+		if (doublePrecision)
+			binaryFile.write(reinterpret_cast<char*>(&doubleBuffer[0]),
+					doubleBuffer.size() * sizeof(doubleBuffer[0]));
+		else
+			binaryFile.write(reinterpret_cast<char*>(&floatBuffer[0]),
+					floatBuffer.size() * sizeof(floatBuffer[0]));
+		binaryFile.write(reinterpret_cast<char*>(&intBuffer[0]),
+				intBuffer.size() * sizeof(intBuffer[0]));
+	} else {
+		// same bytes as in the file
+		const char *length = reinterpret_cast<const char*>(&recordLength);
+		recordBlock.insert(recordBlock.end(), length,
+				length + sizeof(recordLength));
+		const char *values =
+				(doublePrecision) ?
+						reinterpret_cast<const char*>(&doubleBuffer[0]) :
+						reinterpret_cast<const char*>(&floatBuffer[0]);
+		const size_t valuesSize =
+				(doublePrecision) ?
+						doubleBuffer.size() * sizeof(doubleBuffer[0]) :
+						floatBuffer.size() * sizeof(floatBuffer[0]);
+		recordBlock.insert(recordBlock.end(), values, values + valuesSize);
+		const char *ints = reinterpret_cast<const char*>(&intBuffer[0]);
+		recordBlock.insert(recordBlock.end(), ints,
+				ints + intBuffer.size() * sizeof(intBuffer[0]));
+	}
 // start with new record
 	intBuffer.resize(1);
 	if (doublePrecision)
@@ -107,4 +130,19 @@ void MilleBinary::writeRecord() {
 	else
 		floatBuffer.resize(1);
 }
+
+/// Write the records kept in memory by another MilleBinary, in one block.
+/**
+ * \param [in,out] aBuffer MilleBinary without file, emptied
+ */
+void MilleBinary::writeRecords(MilleBinary &aBuffer) {
+	if (aBuffer.recordBlock.empty())
+		return;
+	if (toFile)
+		binaryFile.write(&aBuffer.recordBlock[0], aBuffer.recordBlock.size());
+	else
+		recordBlock.insert(recordBlock.end(), aBuffer.recordBlock.begin(),
+				aBuffer.recordBlock.end());
+	aBuffer.recordBlock.clear();
+}
 }
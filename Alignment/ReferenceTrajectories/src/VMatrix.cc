@@ -127,12 +127,7 @@ VMatrix &VMatrix::operator=(const VMatrix &aMatrix) {
 	if (this != &aMatrix) {   // Gracefully handle self assignment
 		numRows = aMatrix.getNumRows();
 		numCols = aMatrix.getNumCols();
-		theVec.resize(numRows * numCols);
-		for (unsigned int i = 0; i < numRows; ++i) {
-			for (unsigned int j = 0; j < numCols; ++j) {
-				theVec[numCols * i + j] = aMatrix(i, j);
-			}
-		}
+		theVec = aMatrix.theVec;
 	}
 	return *this;
 }
@@ -0,0 +1,48 @@
+#ifndef SiStripObjects_SiStripDenseNoises_h
+#define SiStripObjects_SiStripDenseNoises_h
+// -*- C++ -*-
+//
+// Package:     SiStripObjects
+// Class  :     SiStripDenseNoises
+//
+/**
+ * Noises of all the strips, decoded once per IOV from the 9 bit packed SiStripNoises
+ * into a single array of floats. <br>
+ * The modules keep the order of the SiStripNoises registry, so a module found by its
+ * position in SiStripNoises::getDetIds is found at the same position here and its
+ * noises are a contiguous array indexed by strip. The values are the ones returned
+ * by SiStripNoises::getNoise.
+ */
+
+#include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+
+#include <cstdint>
+#include <vector>
+
+class SiStripDenseNoises
+{
+ public:
+  SiStripDenseNoises() {}
+  explicit SiStripDenseNoises(const SiStripNoises& noises);
+
+  size_t size() const { return detIds_.size(); }
+  const std::vector<uint32_t>& detIds() const { return detIds_; }
+
+  // null for a position outside the registry
+  const float* noisesByPos(unsigned short pos) const {
+    return pos < detIds_.size() ? values_.data() + offsets_[pos] : nullptr;
+  }
+  uint16_t nStripsByPos(unsigned short pos) const {
+    return pos < detIds_.size() ? offsets_[pos+1] - offsets_[pos] : 0;
+  }
+  // null for a module without noises
+  const float* noises(uint32_t detId) const;
+
+ private:
+  std::vector<uint32_t> detIds_;
+  // offset of the first strip of each module, plus the total number of strips
+  std::vector<uint32_t> offsets_;
+  std::vector<float> values_;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#include "CalibFormats/SiStripObjects/interface/SiStripDenseNoises.h"
+
+#include <algorithm>
+
+SiStripDenseNoises::SiStripDenseNoises(const SiStripNoises& noises)
+{
+  size_t nDets = noises.getRegistryVectorEnd() - noises.getRegistryVectorBegin();
+  detIds_.reserve(nDets);
+  offsets_.reserve(nDets + 1);
+  offsets_.push_back(0);
+  for (auto p = noises.getRegistryVectorBegin(); p != noises.getRegistryVectorEnd(); ++p) {
+    detIds_.push_back(p->detid);
+    offsets_.push_back(offsets_.back() + ((p->iend - p->ibegin) * 8) / 9);
+  }
+
+  values_.resize(offsets_.back());
+  auto out = values_.begin();
+  for (auto p = noises.getRegistryVectorBegin(); p != noises.getRegistryVectorEnd(); ++p) {
+    SiStripNoises::Range range(noises.getDataVectorBegin() + p->ibegin, noises.getDataVectorBegin() + p->iend);
+    uint16_t nStrips = ((p->iend - p->ibegin) * 8) / 9;
+    // the same decoding as getNoise, so that the values are identical
+    for (uint16_t strip = 0; strip < nStrips; ++strip) *out++ = SiStripNoises::getNoiseFast(strip, range);
+  }
+}
+
+const float* SiStripDenseNoises::noises(uint32_t detId) const
+{
+  auto p = std::lower_bound(detIds_.begin(), detIds_.end(), detId);
+  if (p == detIds_.end() || *p != detId) return nullptr;
+  return noisesByPos(p - detIds_.begin());
+}
@@ -35,6 +35,8 @@ class SiStripHashedDetIdRcd : public edm::eventsetup::DependentRecordImplementat
 
 class SiStripNoisesDepRcd : public edm::eventsetup::DependentRecordImplementation<SiStripNoisesDepRcd, boost::mpl::vector<SiStripNoisesRcd,IdealGeometryRecord> > {};
 
+class SiStripDenseNoisesRcd : public edm::eventsetup::DependentRecordImplementation<SiStripDenseNoisesRcd, boost::mpl::vector<SiStripNoisesRcd> > {};
+
 class SiStripBadModuleDepRcd : public edm::eventsetup::DependentRecordImplementation<SiStripBadModuleDepRcd, boost::mpl::vector<SiStripBadModuleRcd,IdealGeometryRecord> > {};
 
 class SiStripBadModuleFedErrRcd : public edm::eventsetup::DependentRecordImplementation<SiStripBadModuleFedErrRcd, boost::mpl::vector<SiStripFedCablingRcd> > {};
@@ -15,5 +15,6 @@ EVENTSETUP_RECORD_REG(SiStripLorentzAngleDepRcd);
 EVENTSETUP_RECORD_REG(SiStripBackPlaneCorrectionDepRcd);
 EVENTSETUP_RECORD_REG(SiStripHashedDetIdRcd);
 EVENTSETUP_RECORD_REG(SiStripNoisesDepRcd);
+EVENTSETUP_RECORD_REG(SiStripDenseNoisesRcd);
 EVENTSETUP_RECORD_REG(SiStripBadModuleDepRcd);
 EVENTSETUP_RECORD_REG(SiStripBadModuleFedErrRcd);
@@ -76,6 +76,8 @@
 #include "TTree.h"
 #include "TChain.h"
 
+#include <algorithm>
+#include <cmath>
 #include <ext/hash_map>
 
 
@@ -988,7 +990,6 @@ void SiStripGainFromCalibTree::algoAnalyzeTheTree()
 
 void SiStripGainFromCalibTree::algoComputeMPVandGain() {
 	unsigned int I=0;
-	TH1F* Proj = NULL;
 	double FitResults[6];
 	double MPVmean = 300;
 
@@ -1004,6 +1005,19 @@ void SiStripGainFromCalibTree::algoComputeMPVandGain() {
 
         TH2S *chvsidx = (Charge_Vs_Index[elepos])->getTH2S();
 
+        // the charge spectra of the APVs are added up straight from the bins of
+        // chvsidx into one histogram, rather than through a ProjectionY
+        // allocated and named for each APV and each of its neighbours
+        const int NChargeBins = chvsidx->GetNbinsY();
+        const TAxis* ChargeAxis = chvsidx->GetYaxis();
+        TH1F Spectrum("APVChargeSpectrum", "APVChargeSpectrum", NChargeBins, ChargeAxis->GetXmin(), ChargeAxis->GetXmax());
+        Spectrum.SetDirectory(0);
+        TH1F* Proj = &Spectrum;
+        std::vector<double> SpectrumBins(NChargeBins+2);
+        auto addSpectrum = [&](int Bin) {
+                for(int y=0;y<=NChargeBins+1;y++) SpectrumBins[y] += chvsidx->GetArray()[chvsidx->GetBin(Bin,y)];
+        };
+
 
 	printf("Progressing Bar              :0%%       20%%       40%%       60%%       80%%       100%%\n");
 	printf("Fitting Charge Distribution  :");
@@ -1015,8 +1029,8 @@ void SiStripGainFromCalibTree::algoComputeMPVandGain() {
 
 		if(APV->isMasked){APV->Gain=APV->PreviousGain; MASKED++; continue;}
 
-		Proj = (TH1F*)(chvsidx->ProjectionY("",chvsidx->GetXaxis()->FindBin(APV->Index),chvsidx->GetXaxis()->FindBin(APV->Index),"e"));
-		if(!Proj)continue;
+		std::fill(SpectrumBins.begin(), SpectrumBins.end(), 0.);
+		addSpectrum(APV->Bin);
 
 		if(CalibrationLevel==0){
 		}else if(CalibrationLevel==1){
@@ -1024,8 +1038,7 @@ void SiStripGainFromCalibTree::algoComputeMPVandGain() {
 			if(SecondAPVId%2==0){    SecondAPVId = SecondAPVId+1; }else{ SecondAPVId = SecondAPVId-1; }
 			stAPVGain* APV2 = APVsColl[(APV->DetId<<4) | SecondAPVId];
 			if(APV2->Bin<0) APV2->Bin = chvsidx->GetXaxis()->FindBin(APV2->Index);
-			TH1F* Proj2 = (TH1F*)(chvsidx->ProjectionY("",APV2->Bin,APV2->Bin,"e"));
-			if(Proj2){Proj->Add(Proj2,1);delete Proj2;}
+			addSpectrum(APV2->Bin);
 		}else if(CalibrationLevel==2){
 			for(unsigned int i=0;i<16;i++){  //loop up to 6APV for Strip and up to 16 for Pixels
 				__gnu_cxx::hash_map<unsigned int, stAPVGain*,  __gnu_cxx::hash<unsigned int>, isEqual >::iterator tmpit;
@@ -1034,14 +1047,22 @@ void SiStripGainFromCalibTree::algoComputeMPVandGain() {
 				stAPVGain* APV2 = tmpit->second;
 				if(APV2->DetId != APV->DetId || APV2->APVId == APV->APVId)continue;            
 				if(APV2->Bin<0) APV2->Bin = chvsidx->GetXaxis()->FindBin(APV2->Index);
-				TH1F* Proj2 = (TH1F*)(chvsidx->ProjectionY("",APV2->Bin,APV2->Bin,"e"));
-				if(Proj2){Proj->Add(Proj2,1);delete Proj2;}
+				addSpectrum(APV2->Bin);
 			}          
 		}else{
 			CalibrationLevel = 0;
 			printf("Unknown Calibration Level, will assume %i\n",CalibrationLevel);
 		}
 
+		Proj->Reset();
+		double SpectrumEntries = 0;
+		for(int y=0;y<=NChargeBins+1;y++){
+			Proj->SetBinContent(y, SpectrumBins[y]);
+			Proj->SetBinError(y, sqrt(SpectrumBins[y]));
+			SpectrumEntries += SpectrumBins[y];
+		}
+		Proj->SetEntries(SpectrumEntries);
+
 		getPeakOfLandau(Proj,FitResults);
 		APV->FitMPV      = FitResults[0];
 		APV->FitMPVErr   = FitResults[1];
@@ -1061,7 +1082,6 @@ void SiStripGainFromCalibTree::algoComputeMPVandGain() {
 		if(APV->Gain<=0)           APV->Gain  = 1;
 
 		//printf("%5i/%5i:  %6i - %1i  %5E Entries --> MPV = %f +- %f\n",I,APVsColl.size(),APV->DetId, APV->APVId, Proj->GetEntries(), FitResults[0], FitResults[1]);fflush(stdout);
-		delete Proj;
 	}printf("\n");
 }
 
@@ -0,0 +1,37 @@
+// -*- C++ -*-
+//
+// Package:    SiStripDenseNoisesESProducer
+// Class:      SiStripDenseNoisesESProducer
+//
+/**\class SiStripDenseNoisesESProducer SiStripDenseNoisesESProducer.h CalibTracker/SiStripESProducers/plugins/real/SiStripDenseNoisesESProducer.cc
+
+ Description: decodes the SiStripNoises of each IOV into a SiStripDenseNoises, shared
+ by all the modules and streams reading the strip noises in the local reconstruction.
+
+ Implementation:
+     The payload is read with the label given by the "Label" parameter.
+*/
+//
+
+#include "CalibTracker/SiStripESProducers/plugins/real/SiStripDenseNoisesESProducer.h"
+
+
+SiStripDenseNoisesESProducer::SiStripDenseNoisesESProducer(const edm::ParameterSet& iConfig):
+  label_(iConfig.getUntrackedParameter<std::string>("Label", ""))
+{
+  setWhatProduced(this);
+
+  edm::LogInfo("SiStripDenseNoisesESProducer") << "ctor" << std::endl;
+}
+
+
+std::shared_ptr<SiStripDenseNoises> SiStripDenseNoisesESProducer::produce(const SiStripDenseNoisesRcd& iRecord)
+{
+  edm::ESHandle<SiStripNoises> noises;
+  iRecord.getRecord<SiStripNoisesRcd>().get(label_, noises);
+
+  auto dense = std::make_shared<SiStripDenseNoises>(*noises);
+  edm::LogInfo("SiStripDenseNoisesESProducer") << "[SiStripDenseNoisesESProducer::produce] decoded the noises of "
+					       << dense->size() << " modules" << std::endl;
+  return dense;
+}
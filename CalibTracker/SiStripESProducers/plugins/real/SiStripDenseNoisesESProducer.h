@@ -0,0 +1,31 @@
+#ifndef CalibTracker_SiStripESProducers_SiStripDenseNoisesESProducer
+#define CalibTracker_SiStripESProducers_SiStripDenseNoisesESProducer
+
+// system include files
+#include <memory>
+
+// user include files
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/Framework/interface/ESProducer.h"
+
+#include "FWCore/Framework/interface/ESHandle.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "CalibFormats/SiStripObjects/interface/SiStripDenseNoises.h"
+#include "CalibTracker/Records/interface/SiStripDependentRecords.h"
+
+class SiStripDenseNoisesESProducer : public edm::ESProducer {
+ public:
+  SiStripDenseNoisesESProducer(const edm::ParameterSet&);
+  ~SiStripDenseNoisesESProducer(){};
+
+  std::shared_ptr<SiStripDenseNoises> produce(const SiStripDenseNoisesRcd&);
+
+ private:
+
+  std::string label_;
+};
+
+#endif
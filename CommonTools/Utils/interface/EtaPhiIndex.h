@@ -0,0 +1,70 @@
+#ifndef CommonTools_Utils_EtaPhiIndex_h
+#define CommonTools_Utils_EtaPhiIndex_h
+/* Index of objects by their eta and phi, for cone queries.
+ *
+ * The objects are entered with a key, usually their position in their
+ * collection, and the index is sorted in eta.  A query visits only the
+ * objects in the eta band of the cone, and returns the keys of those
+ * which are also in its phi band: the caller then applies its own cone
+ * cut, e.g. with reco::deltaR2.  Every object inside the cone is in
+ * the box, also with the rounding of deltaR2, so that the result is the
+ * same as looping over all the objects.
+ *
+ * The coordinates are stored as arrays, so that the loop over the band
+ * can be vectorized.
+ *
+ *    EtaPhiIndex index;
+ *    for (unsigned int i = 0; i != cands.size(); ++i) index.add(cands[i].eta(), cands[i].phi(), i);
+ *    index.sort();
+ *    index.forEachInBox(eta, phi, 0.4, [&](unsigned int i) { if (reco::deltaR2(...) < 0.16) ... });
+ */
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+class EtaPhiIndex {
+public:
+  void clear() { eta_.clear(); phi_.clear(); key_.clear(); }
+  void reserve(unsigned int n) { eta_.reserve(n); phi_.reserve(n); key_.reserve(n); }
+  unsigned int size() const { return key_.size(); }
+  bool empty() const { return key_.empty(); }
+
+  // add an object; sort() must be called once all of them are added, before any query
+  void add(double eta, double phi, unsigned int key) {
+    eta_.push_back(eta); phi_.push_back(phi); key_.push_back(key);
+  }
+
+  void sort() {
+    std::vector<unsigned int> order(key_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](unsigned int i, unsigned int j) { return eta_[i] < eta_[j]; });
+    std::vector<double> eta(order.size()), phi(order.size());
+    std::vector<unsigned int> key(order.size());
+    for (unsigned int i = 0; i != order.size(); ++i) {
+      eta[i] = eta_[order[i]]; phi[i] = phi_[order[i]]; key[i] = key_[order[i]];
+    }
+    eta_.swap(eta); phi_.swap(phi); key_.swap(key);
+  }
+
+  // calls f(key) for each object within dR of (eta, phi) both in eta and in phi, in increasing eta
+  template<typename F>
+  void forEachInBox(double eta, double phi, double dR, F && f) const {
+    // the band is widened for the rounding of its edges, the box cut below decides
+    const double band = dR + 1.e-6;
+    unsigned int first = std::lower_bound(eta_.begin(), eta_.end(), eta - band) - eta_.begin();
+    unsigned int last = std::upper_bound(eta_.begin() + first, eta_.end(), eta + band) - eta_.begin();
+    for (unsigned int i = first; i != last; ++i) {
+      // as in reco::deltaR2
+      double dphi = std::abs(phi - phi_[i]); if (dphi > double(M_PI)) dphi -= double(2*M_PI);
+      if (std::abs(eta - eta_[i]) <= dR && std::abs(dphi) <= dR) f(key_[i]);
+    }
+  }
+
+private:
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+  std::vector<unsigned int> key_;
+};
+
+#endif
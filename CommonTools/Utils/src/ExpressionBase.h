@@ -18,6 +18,8 @@ namespace reco {
     struct ExpressionBase {
       virtual ~ExpressionBase() { }
       virtual double value( const edm::ObjectWithDict & ) const = 0;
+      /// true if the value does not depend on the object
+      virtual bool isConstant() const { return false; }
     };
     typedef boost::shared_ptr<ExpressionBase> ExpressionPtr;
   }
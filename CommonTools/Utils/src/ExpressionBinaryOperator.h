@@ -20,6 +20,7 @@ namespace reco {
       virtual double value(const edm::ObjectWithDict& o) const { 
 	return op_((*lhs_).value(o), (*rhs_).value(o));
       }
+      virtual bool isConstant() const { return lhs_->isConstant() && rhs_->isConstant(); }
       ExpressionBinaryOperator(ExpressionStack & expStack) { 
 	rhs_ = expStack.back(); expStack.pop_back();
 	lhs_ = expStack.back(); expStack.pop_back();
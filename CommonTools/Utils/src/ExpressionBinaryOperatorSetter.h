@@ -11,6 +11,7 @@
  *
  */
 #include "CommonTools/Utils/src/ExpressionBinaryOperator.h"
+#include "CommonTools/Utils/src/ExpressionNumber.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
 #include <cmath>
 
@@ -26,7 +27,7 @@ namespace reco {
     struct ExpressionBinaryOperatorSetter {
       ExpressionBinaryOperatorSetter(ExpressionStack & stack) : stack_(stack) { }
       void operator()(const char*, const char*) const {
-	stack_.push_back(ExpressionPtr(new ExpressionBinaryOperator<Op>(stack_)));
+	stack_.push_back(foldConstant(ExpressionPtr(new ExpressionBinaryOperator<Op>(stack_))));
       }
     private:
       ExpressionStack & stack_;
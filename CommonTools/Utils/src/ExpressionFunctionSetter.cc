@@ -2,6 +2,7 @@
 #include "CommonTools/Utils/src/ExpressionUnaryOperator.h"
 #include "CommonTools/Utils/src/ExpressionBinaryOperator.h"
 #include "CommonTools/Utils/src/ExpressionQuaterOperator.h"
+#include "CommonTools/Utils/src/ExpressionNumber.h"
 #include <cmath>
 #include <Math/ProbFuncMathCore.h>
 #include <DataFormats/Math/interface/deltaPhi.h>
@@ -65,5 +66,5 @@ void ExpressionFunctionSetter::operator()( const char *, const char * ) const {
   case( kTanh     ) : funExp.reset( new ExpressionUnaryOperator <tanh_f >   ( expStack_ ) ); break;
   case( kTestBit  ) : funExp.reset( new ExpressionBinaryOperator<test_bit_f>( expStack_ ) ); break;
   };
-  expStack_.push_back( funExp );
+  expStack_.push_back( foldConstant( funExp ) );
 }
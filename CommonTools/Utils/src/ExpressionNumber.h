@@ -11,15 +11,23 @@
  *
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
+#include "FWCore/Utilities/interface/ObjectWithDict.h"
 
 namespace reco {
   namespace parser {
     struct ExpressionNumber : public ExpressionBase {
       virtual double value( const edm::ObjectWithDict& ) const { return value_; }
+      virtual bool isConstant() const { return true; }
       ExpressionNumber( double value ) : value_( value ) { }
     private:
       double value_;
     };
+
+    /// replace a constant expression by its value, computed once at parse time
+    inline ExpressionPtr foldConstant( const ExpressionPtr & exp ) {
+      if ( !exp->isConstant() ) return exp;
+      return ExpressionPtr( new ExpressionNumber( exp->value( edm::ObjectWithDict() ) ) );
+    }
   }
 }
 
@@ -20,6 +20,9 @@ namespace reco {
       virtual double value(const edm::ObjectWithDict& o) const { 
 	return op_(args_[0]->value(o), args_[1]->value(o), args_[2]->value(o), args_[3]->value(o));
       }
+      virtual bool isConstant() const {
+	return args_[0]->isConstant() && args_[1]->isConstant() && args_[2]->isConstant() && args_[3]->isConstant();
+      }
       ExpressionQuaterOperator(ExpressionStack & expStack) { 
 	args_[3] = expStack.back(); expStack.pop_back();
 	args_[2] = expStack.back(); expStack.pop_back();
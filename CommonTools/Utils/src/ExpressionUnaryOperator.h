@@ -20,6 +20,7 @@ namespace reco {
       virtual double value(const edm::ObjectWithDict& o) const { 
 	return op_((*exp_).value(o));
       }
+      virtual bool isConstant() const { return exp_->isConstant(); }
       ExpressionUnaryOperator(ExpressionStack & expStack) { 
 	exp_ = expStack.back(); expStack.pop_back();
       }
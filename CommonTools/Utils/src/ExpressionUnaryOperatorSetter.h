@@ -11,6 +11,7 @@
  *
  */
 #include "CommonTools/Utils/src/ExpressionUnaryOperator.h"
+#include "CommonTools/Utils/src/ExpressionNumber.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
 #ifdef BOOST_SPIRIT_DEBUG 
 #include <string>
@@ -30,7 +31,7 @@ namespace reco {
 #ifdef BOOST_SPIRIT_DEBUG 
 	BOOST_SPIRIT_DEBUG_OUT << "pushing unary operator" << op1_out<Op>::value << std::endl;
 #endif	
-	stack_.push_back(ExpressionPtr(new ExpressionUnaryOperator<Op>(stack_)));
+	stack_.push_back(foldConstant(ExpressionPtr(new ExpressionUnaryOperator<Op>(stack_))));
       }
     private:
       ExpressionStack & stack_;
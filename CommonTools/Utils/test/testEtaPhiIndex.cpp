@@ -0,0 +1,51 @@
+#include "CommonTools/Utils/interface/EtaPhiIndex.h"
+#include "DataFormats/Math/interface/deltaR.h"
+
+#include<cassert>
+#include<iostream>
+#include<random>
+#include<vector>
+
+int main() {
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> etaDist(-3.,3.);
+  std::uniform_real_distribution<double> phiDist(-M_PI,M_PI);
+
+  unsigned int n = 500;
+  std::vector<double> eta(n), phi(n);
+  EtaPhiIndex index;
+  index.reserve(n);
+  for (unsigned int i=0; i!=n; ++i) {
+    eta[i] = etaDist(gen); phi[i] = phiDist(gen);
+    // a few objects on the phi boundary
+    if (i%50==0) phi[i] = (i%100==0) ? M_PI : -M_PI;
+    index.add(eta[i],phi[i],i);
+  }
+  index.sort();
+  assert(index.size()==n);
+
+  unsigned int found=0;
+  for (auto dR : {0.1,0.4,1.0}) {
+    for (unsigned int q=0; q!=200; ++q) {
+      double qeta = etaDist(gen), qphi = (q%20==0) ? M_PI-0.01 : phiDist(gen);
+      std::vector<bool> inCone(n,false);
+      index.forEachInBox(qeta,qphi,dR,[&](unsigned int i) {
+        if (reco::deltaR2(qeta,qphi,eta[i],phi[i]) < dR*dR) inCone[i] = true;
+      });
+      for (unsigned int i=0; i!=n; ++i) {
+        assert(inCone[i] == (reco::deltaR2(qeta,qphi,eta[i],phi[i]) < dR*dR));
+        if (inCone[i]) ++found;
+      }
+    }
+  }
+  assert(found>0);
+
+  index.clear();
+  assert(index.empty());
+  index.sort();
+  index.forEachInBox(0.,0.,0.4,[&](unsigned int) { assert(false); });
+
+  std::cout << "ok " << found << std::endl;
+  return 0;
+}
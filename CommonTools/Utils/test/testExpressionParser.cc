@@ -158,6 +158,10 @@ void testExpressionParser::checkAll() {
     checkTrack("hypot(px, py)", hypot(trk.px(), trk.py()));
     checkTrack("?ndof<0?1:0", trk.ndof()<0?1:0);
     checkTrack("?ndof=10?1:0", trk.ndof()==10?1:0);
+    // constant subexpressions are folded at parse time
+    checkTrack("pt*(2+3)", trk.pt()*5);
+    checkTrack("pt/sqrt(4)-min(1,-2)", trk.pt()/2+2);
+    checkTrack("deltaR(0,0,eta,0.5*atan2(1,1))", reco::deltaR(0.,0.,trk.eta(),0.5*atan2(1.,1.)));
   }
   reco::Candidate::LorentzVector p1(1, 2, 3, 4);
   reco::Candidate::LorentzVector p2(1.1, -2.5, 4.3, 13.7);
@@ -20,22 +20,35 @@ namespace cond {
 
     explicit Binary( const coral::Blob& data );
 
+    // refer to read-only data owned elsewhere (e.g. a memory mapped file), without copying it
+    Binary( const std::shared_ptr<const void>& data, size_t size );
+
     Binary( const Binary& rhs );
 
     Binary& operator=( const Binary& rhs );
 
+    // the data as a coral::Blob: external data has to be made owned first
     const coral::Blob& get() const;
 
+    // replace the external data with a private copy; no-op for the data already owned.
+    // Like the other non-const functions, it must not run concurrently with any other access to the object
+    void makeOwned();
+
+    bool isOwned() const { return !m_external; }
+
     void copy( const std::string& source );
 
     const void* data() const;
 
+    // write access: makes the data owned first
     void* data();
 
     size_t size() const;
 
   private:
     std::shared_ptr<coral::Blob> m_data;
+    std::shared_ptr<const void> m_external;
+    size_t m_externalSize;
   };
 
 }
@@ -2,6 +2,8 @@
 #define ConditionDatabase_ConnectionPool_h
 
 #include "CondCore/CondDB/interface/Session.h"
+#include "CondCore/CondDB/interface/PayloadCache.h"
+#include "CondCore/CondDB/interface/IOVCache.h"
 //
 #include <string>
 #include <memory>
@@ -38,6 +40,10 @@ namespace cond {
       void setAuthenticationSystem( int authSysCode );
       void setFrontierSecurity( const std::string& signature );
       void setLogging( bool flag );   
+      void setPayloadCacheDirectory( const std::string& directory );
+      void setPayloadCacheSize( int megaBytes );
+      void setPayloadObjectCacheSize( int megaBytes );
+      void setIOVCacheTimeToLive( int seconds );
       bool isLoggingEnabled() const;
       void setParameters( const edm::ParameterSet& connectionPset );
       void configure();
@@ -53,6 +59,7 @@ namespace cond {
                              const std::string& transactionId, 
                              bool writeCapable = false );
       void configure( coral::IConnectionServiceConfiguration& coralConfig );
+      void resetPayloadCache();
     private:
       std::string m_authPath = std::string( "" );
       int m_authSys = 0;
@@ -61,6 +68,17 @@ namespace cond {
       //The frontier security option is turned on for all sessions
       //usig this wrapper of the CORAL connection setup for configuring the server access
       std::string m_frontierSecurity = std::string( "" );
+      // if not empty, the payloads read are shared with other jobs through a node-local cache in this directory
+      std::string m_payloadCacheDirectory = std::string( "" );
+      // limit of the total size of the files in the payload cache directory; 0 does not limit it
+      int m_payloadCacheSize = 2048;
+      // if not 0, the deserialized payloads are shared by the sessions, up to this total serialized size
+      int m_payloadObjectCacheSize = 0;
+      std::shared_ptr<PayloadCache> m_payloadCache;
+      // if not negative, the iov sequences are read once and shared by the sessions; the sequences
+      // of the latest state of a tag are read again after this many seconds
+      int m_iovCacheTimeToLive = -1;
+      std::shared_ptr<IOVCache> m_iovCache;
       // this one has to be moved!
       cond::CoralServiceManager* m_pluginManager = nullptr; 
       std::map<std::string,int> m_dbTypes;
@@ -0,0 +1,74 @@
+#ifndef CondCore_CondDB_IOVCache_h
+#define CondCore_CondDB_IOVCache_h
+//
+// Package:     CondDB
+//
+/**IOVCache.h CondCore/CondDB/interface/IOVCache.h
+   Description: in-memory cache of the whole iov sequences of the tags, shared by all
+   the IOVProxy instances reading from the sessions of a ConnectionPool.
+
+   A tag is read once, with its full iov sequence; the later loads of the same tag from
+   the same database, and all the searches in it, are resolved in memory. The sequences
+   read for a snapshot time cannot change and are kept for the whole job. The ones
+   read for the latest state of the tag are kept for the configured time to live, after
+   which the database is queried again. Tags not found are remembered in the same way.
+*/
+//
+
+#include "CondCore/CondDB/interface/IOVProxy.h"
+#include "CondCore/CondDB/interface/Types.h"
+//
+#include <boost/date_time/posix_time/posix_time.hpp>
+//
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace cond {
+
+  namespace persistency {
+
+    class IOVCache {
+    public:
+      struct Entry {
+	// false for a tag not found in the database
+	bool found = false;
+	cond::TimeType timeType = cond::invalid;
+	std::string payloadType;
+	cond::SynchronizationType synchronizationType = cond::SYNCH_ANY;
+	cond::Time_t endOfValidity = cond::time::MAX_VAL;
+	cond::Time_t lastValidatedTime = cond::time::MIN_VAL;
+	IOVProxy::IOVContainer iovSequence;
+	std::chrono::steady_clock::time_point loadTime;
+      };
+
+      // time to live, in seconds, of the sequences read for the latest state of a tag; 0 does not keep them
+      explicit IOVCache( int timeToLive );
+
+      // returns null if the tag has not been read yet, or its entry has expired
+      std::shared_ptr<const Entry> find( const std::string& connectionString,
+					 const std::string& tag,
+					 const boost::posix_time::ptime& snapshotTime ) const;
+
+      void insert( const std::string& connectionString,
+		   const std::string& tag,
+		   const boost::posix_time::ptime& snapshotTime,
+		   const std::shared_ptr<const Entry>& entry );
+
+      int timeToLive() const { return m_timeToLive.count(); }
+
+    private:
+      bool isValid( const Entry& entry, const boost::posix_time::ptime& snapshotTime ) const;
+
+    private:
+      std::chrono::seconds m_timeToLive;
+      mutable std::mutex m_mutex;
+      std::map<std::string, std::shared_ptr<const Entry> > m_entries;
+    };
+
+  }
+}
+
+#endif // CondCore_CondDB_IOVCache_h
@@ -74,6 +74,7 @@ namespace cond {
       
       // loads in memory the tag information and the iov groups
       // full=true load the full iovSequence 
+      // with an IOVCache in the session, the full iovSequence is always taken from the cache
       void load( const std::string& tag, bool full=false );
       
       // loads in memory the tag information and the iov groups
@@ -143,6 +144,7 @@ namespace cond {
       
     private:
       void checkTransaction( const std::string& ctx ) const ;
+      void loadFromCache( const std::string& tag, const boost::posix_time::ptime& snapshottime );
       void fetchSequence( cond::Time_t lowerGroup, cond::Time_t higherGroup );
       
     private:
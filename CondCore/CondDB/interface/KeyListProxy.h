@@ -36,6 +36,14 @@ namespace cond {
       	m_keyList.init(getter.get(m_name));
       }
 
+      // the key list loads its objects through the IOVs of other tags:
+      // leave it to the lazy loading in make()
+      virtual void prefetch( Session ){
+      }
+
+      virtual void prefetchNext( Session ){
+      }
+
 
     protected:
       virtual void loadPayload() {
@@ -0,0 +1,100 @@
+#ifndef CondCore_CondDB_PayloadCache_h
+#define CondCore_CondDB_PayloadCache_h
+//
+// Package:     CondDB
+//
+/**PayloadCache.h CondCore/CondDB/interface/PayloadCache.h
+   Description: caches of the payloads read from the database, at two levels.
+
+   The node-local file cache holds the serialized payloads, shared by all the jobs
+   running on the same machine. Each payload is stored, once, in a file named after its
+   hash in the cache directory (typically on a tmpfs like /dev/shm). The files are written
+   to a temporary name and renamed, so they are never seen partially written, and are only
+   read through read-only memory mappings: the jobs reading the same payload share the same
+   pages, instead of each fetching and holding its own copy of the data. The modification
+   time of a file is updated each time it is read, and the least recently used files are
+   removed when the total size of the directory goes beyond the configured limit; the
+   mappings held by the jobs still reading a removed file stay valid.
+
+   The in-memory object cache holds the deserialized payloads of the job, shared by all
+   the proxies reading the same payload, so that going back to an IOV already read, or
+   reading the same payload through different tags, does not deserialize it again. It is
+   bounded by the serialized size of the objects, and the least recently used ones are
+   dropped first.
+*/
+//
+
+#include "CondCore/CondDB/interface/Binary.h"
+#include "CondCore/CondDB/interface/Types.h"
+//
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+
+namespace cond {
+
+  namespace persistency {
+
+    class PayloadCache {
+    public:
+      // an empty directory disables the file cache; a zero size does not limit the directory,
+      // and disables the object cache
+      PayloadCache( const std::string& directory, size_t maxDirectorySize, size_t maxObjectCacheSize );
+
+      // look up a payload; on success the Binary objects point directly to the mapped file
+      bool load( const cond::Hash& payloadHash,
+		 std::string& payloadType,
+		 cond::Binary& payloadData,
+		 cond::Binary& streamerInfoData ) const;
+
+      // add a payload to the cache, unless it is already there; failures are not fatal
+      bool store( const cond::Hash& payloadHash,
+		  const std::string& payloadType,
+		  const cond::Binary& payloadData,
+		  const cond::Binary& streamerInfoData ) const;
+
+      // returns null if the payload has not been deserialized with this type yet, or has been dropped
+      std::shared_ptr<const void> findObject( const cond::Hash& payloadHash, const std::type_info& type );
+
+      // size is the serialized size of the payload, used to bound the cache
+      void insertObject( const cond::Hash& payloadHash,
+			 const std::type_info& type,
+			 const std::shared_ptr<const void>& object,
+			 size_t size );
+
+      bool hasFileCache() const { return !m_directory.empty(); }
+
+      const std::string& directory() const { return m_directory; }
+
+    private:
+      std::string fileName( const cond::Hash& payloadHash ) const;
+
+      // remove the least recently used files, except the one just stored, until the directory fits in its limit
+      void evictFiles( const std::string& keep ) const;
+
+    private:
+      struct ObjectEntry {
+	std::type_index type;
+	std::shared_ptr<const void> object;
+	size_t size;
+	// position in the usage list, the most recently used first
+	std::list<cond::Hash>::iterator usage;
+      };
+
+      std::string m_directory;
+      size_t m_maxDirectorySize;
+      size_t m_maxObjectCacheSize;
+      std::mutex m_objectMutex;
+      std::map<cond::Hash, ObjectEntry> m_objects;
+      std::list<cond::Hash> m_objectUsage;
+      size_t m_objectCacheSize;
+    };
+
+  }
+}
+
+#endif // CondCore_CondDB_PayloadCache_h
@@ -57,14 +57,31 @@ namespace cond {
       const std::vector<Iov_t>& requests() const {
 	return m_requests;
       }
-    
+
+      // load the payload of the current IOV through the given session, rather than the
+      // one used by the proxy, unless it is already loaded.
+      // Different proxies can be loaded concurrently, each one with its own session.
+      virtual void prefetch( Session dbSession )=0;
+
+      // look up the IOV following the current one, using the session of the proxy;
+      // return true if its payload is not available yet and should be prefetched
+      bool prepareNext();
+
+      // load the payload of the IOV found by prepareNext() through the given session.
+      // It can run concurrently with the use of the current payload; the caller must
+      // wait for it to complete before calling setIntervalFor() again.
+      virtual void prefetchNext( Session dbSession )=0;
+
     private:
       virtual void loadPayload() = 0;   
+
+      virtual bool isNextLoaded() const = 0;
       
     
     protected:
       IOVProxy m_iovProxy;
       Iov_t m_currentIov;
+      Iov_t m_nextIov;
       Session m_session;
       std::vector<Iov_t> m_requests;
       
@@ -110,6 +127,25 @@ namespace cond {
 	m_currentPayloadId.clear();
 	m_currentIov.clear();
 	m_requests.clear();
+	m_nextData.reset();
+	m_nextIov.clear();
+      }
+
+      virtual void prefetch( Session dbSession ){
+	if( !isValid() || m_currentIov.payloadId == m_currentPayloadId ) return;
+	if( takeNext() ) return;
+	dbSession.transaction().start(true);
+	m_data = dbSession.fetchSharedPayload<DataT>( m_currentIov.payloadId );
+	dbSession.transaction().commit();
+	m_currentPayloadId = m_currentIov.payloadId;
+	m_requests.push_back( m_currentIov );
+      }
+
+      virtual void prefetchNext( Session dbSession ){
+	if( !m_nextIov.isValid() || m_nextData ) return;
+	dbSession.transaction().start(true);
+	m_nextData = dbSession.fetchSharedPayload<DataT>( m_nextIov.payloadId );
+	dbSession.transaction().commit();
       }
 
     protected:
@@ -117,14 +153,33 @@ namespace cond {
 	if( m_currentIov.payloadId.empty() ){
 	  throwException( "Can't load payload: no valid IOV found.","PayloadProxy::loadPayload" );
 	}
-	m_data = m_session.fetchPayload<DataT>( m_currentIov.payloadId );
+	if( takeNext() ) return;
+	m_data = m_session.fetchSharedPayload<DataT>( m_currentIov.payloadId );
 	m_currentPayloadId = m_currentIov.payloadId;	  
 	m_requests.push_back( m_currentIov );
       }
       
     private:
-      std::shared_ptr<DataT> m_data;
+      virtual bool isNextLoaded() const {
+	return (bool) m_nextData;
+      }
+
+      // use the payload prefetched for the next IOV, if it is the one now needed
+      bool takeNext() {
+	// check the IOV first: m_nextData may still be being written by prefetchNext()
+	// as long as the next IOV has not become the current one
+	if( m_nextIov.payloadId != m_currentIov.payloadId || !m_nextData ) return false;
+	m_data = std::move( m_nextData );
+	m_nextData.reset();
+	m_nextIov.clear();
+	m_currentPayloadId = m_currentIov.payloadId;
+	m_requests.push_back( m_currentIov );
+	return true;
+      }
+
+      std::shared_ptr<const DataT> m_data;
       Hash m_currentPayloadId;
+      std::shared_ptr<const DataT> m_nextData;
     };
     
   }
@@ -18,11 +18,14 @@
 //
 #include <sstream>
 #include <iostream>
+#include <iomanip>
 #include <memory>
+#include <cstdint>
 //
 // temporarely
 
 #include "CondFormats/Serialization/interface/Archive.h"
+#include "boost/serialization/version.hpp"
 
 namespace cond {
 
@@ -41,24 +44,93 @@ namespace cond {
     static constexpr char const* TECH_VERSION_LABEL = "tech_version";
     static constexpr char const* CMSSW_VERSION_LABEL = "CMSSW_version";
     static constexpr char const* ARCH_LABEL = "architecture";
+    static constexpr char const* TYPE_HASH_LABEL = "type_hash";
+    static constexpr char const* BINARY_ARCH_LABEL = "binary_architecture";
     //
     static constexpr char const* TECHNOLOGY = "boost/serialization" ;
+    static constexpr char const* BINARY_TECHNOLOGY = "boost/serialization/binary" ;
     static std::string techVersion();
     static std::string jsonString();
+    static std::string jsonString( const std::string& technology, const std::string& typeHash );
+    // the native representation of the numbers on this platform, as written by the binary archive:
+    // the byte order and the sizes of the fundamental types
+    static std::string binaryArchitecture();
+    // the value of a label in the json string, empty if not there
+    static std::string value( const std::string& streamerInfo, const std::string& label );
   };
 
   typedef cond::serialization::InputArchive  CondInputArchive;
   typedef cond::serialization::OutputArchive CondOutputArchive;
+  typedef cond::serialization::InputArchiveBinary  CondInputArchiveBinary;
+  typedef cond::serialization::OutputArchiveBinary CondOutputArchiveBinary;
+  typedef cond::serialization::OutputArchiveXML CondOutputArchiveXML;
 
-  // call for the serialization. 
-  template <typename T> std::pair<Binary,Binary> serialize( const T& payload ){
+  // layout of T as seen by the native binary archive, taken from a default constructed
+  // object: the class name, its size and its serialization version; the names, nesting
+  // and class versions of all the serialized members, which are the tags written by the
+  // xml archive, without their values; and the size of the binary blob, which changes
+  // with the types of the members. The members of the elements of the containers are
+  // not seen, since the containers are empty.
+  template <typename T> std::string typeLayout(){
+    T payload;
+    std::ostringstream xmlBuffer;
+    std::ostringstream binaryBuffer;
+    {
+      CondOutputArchiveXML oa( xmlBuffer, boost::archive::no_header );
+      oa << boost::serialization::make_nvp( "cmsCondPayload", payload );
+    }
+    {
+      CondOutputArchiveBinary oa( binaryBuffer, boost::archive::no_header );
+      oa << payload;
+    }
+    std::stringstream layout;
+    layout << demangledName( typeid(T) ) << ':' << sizeof(T) << ':' << boost::serialization::version<T>::value << ':'
+	   << binaryBuffer.str().size() << ':';
+    bool inTag = false;
+    for( char c : xmlBuffer.str() ){
+      if( c == '<' ) inTag = true;
+      if( inTag ) layout << c;
+      if( c == '>' ) inTag = false;
+    }
+    return layout.str();
+  }
+
+  // hash of typeLayout<T>(). The blobs written with the binary archive carry no
+  // per-member information, so this is how a change of the class after the upload
+  // is detected.
+  template <typename T> std::string typeHash(){
+    static const std::string ret = [](){
+      // FNV-1a
+      uint64_t hash = 14695981039346656037ULL;
+      for( unsigned char c : typeLayout<T>() ){
+	hash ^= c;
+	hash *= 1099511628211ULL;
+      }
+      std::stringstream ss;
+      ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+      return ss.str();
+    }();
+    return ret;
+  }
+
+  // call for the serialization. With nativeBinary, the payload is written with the
+  // native binary archive, which reads the large arrays of numbers back in single
+  // blocks; the blob can only be read on platforms with the same binaryArchitecture(),
+  // the others have to be given the payload stored again with the portable archive.
+  template <typename T> std::pair<Binary,Binary> serialize( const T& payload, bool nativeBinary=false ){
     std::pair<Binary,Binary> ret;
-    std::string streamerInfo( StreamerInfo::jsonString() );
+    std::string streamerInfo( nativeBinary ? StreamerInfo::jsonString( StreamerInfo::BINARY_TECHNOLOGY, typeHash<T>() ) :
+			      StreamerInfo::jsonString() );
     try{
       // save data to buffers
       std::ostringstream dataBuffer;
-      CondOutputArchive oa( dataBuffer );
-      oa << payload;
+      if( nativeBinary ){
+	CondOutputArchiveBinary oa( dataBuffer );
+	oa << payload;
+      } else {
+	CondOutputArchive oa( dataBuffer );
+	oa << payload;
+      }
       //TODO: avoid (2!!) copies
       ret.first.copy( dataBuffer.str() );
       ret.second.copy( streamerInfo );
@@ -81,9 +153,26 @@ namespace cond {
       std::stringbuf sdataBuf;
       sdataBuf.pubsetbuf( static_cast<char*>(const_cast<void*>(payloadData.data())), payloadData.size() );
       std::istream dataBuffer( &sdataBuf );
-      CondInputArchive ia( dataBuffer );
-      payload.reset( createPayload<T>(payloadType) );
-      ia >> (*payload);
+      if( StreamerInfo::value( streamerInfo, StreamerInfo::TECH_LABEL ) == StreamerInfo::BINARY_TECHNOLOGY ){
+	std::string storedArch = StreamerInfo::value( streamerInfo, StreamerInfo::BINARY_ARCH_LABEL );
+	if( storedArch != StreamerInfo::binaryArchitecture() )
+	  throwException( "the payload of type "+payloadType+" has been stored with the native binary archive on a platform"
+			  " with another representation of the numbers ("+storedArch+", here "+StreamerInfo::binaryArchitecture()+
+			  "). It has to be stored again with the portable archive to be read here.",
+			  "default_deserialize" );
+	std::string storedHash = StreamerInfo::value( streamerInfo, StreamerInfo::TYPE_HASH_LABEL );
+	if( storedHash != typeHash<T>() )
+	  throwException( "the layout of the class "+payloadType+" (type hash "+typeHash<T>()+
+			  ") differs from the one used in the upload (type hash "+storedHash+")",
+			  "default_deserialize" );
+	CondInputArchiveBinary ia( dataBuffer );
+	payload.reset( createPayload<T>(payloadType) );
+	ia >> (*payload);
+      } else {
+	CondInputArchive ia( dataBuffer );
+	payload.reset( createPayload<T>(payloadType) );
+	ia >> (*payload);
+      }
     } catch ( const std::exception& e ){
       std::string errorMsg("De-serialization failed: ");
       std::string em( e.what() );
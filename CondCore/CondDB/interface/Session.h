@@ -21,6 +21,7 @@
 #include "CondCore/CondDB/interface/Types.h"
 #include "CondCore/CondDB/interface/Utils.h"
 // 
+#include <typeinfo>
 // temporarely
 
 // TO BE REMOVED AFTER THE TRANSITION
@@ -126,10 +127,15 @@ namespace cond {
       IOVEditor editIov( const std::string& tag );
       
       // functions to store a payload in the database. return the identifier of the item in the db. 
+      // nativeBinary selects the native binary archive, faster to read for the large payloads
       template <typename T> cond::Hash storePayload( const T& payload, 
-						     const boost::posix_time::ptime& creationTime = boost::posix_time::microsec_clock::universal_time() );
+						     const boost::posix_time::ptime& creationTime = boost::posix_time::microsec_clock::universal_time(),
+						     bool nativeBinary = false );
 
       template <typename T> std::shared_ptr<T> fetchPayload( const cond::Hash& payloadHash );
+
+      // read-only payload, shared through the object cache of the ConnectionPool when it is enabled
+      template <typename T> std::shared_ptr<const T> fetchSharedPayload( const cond::Hash& payloadHash );
       
       cond::Hash storePayloadData( const std::string& payloadObjectType,
                                    const std::pair<Binary,Binary>& payloadAndStreamerInfoData,
@@ -142,6 +148,10 @@ namespace cond {
 
       // internal functions. creates proxies without loading a specific tag.  
       IOVProxy iovProxy();
+
+      std::shared_ptr<const void> findCachedPayload( const cond::Hash& payloadHash, const std::type_info& type );
+      void cachePayload( const cond::Hash& payloadHash, const std::type_info& type, 
+			 const std::shared_ptr<const void>& payload, size_t size );
       
       bool existsGlobalTag( const std::string& name );
 
@@ -162,6 +172,7 @@ namespace cond {
       coral::ISchema& nominalSchema();
       
     private:
+      template <typename T> std::shared_ptr<T> loadPayload( const cond::Hash& payloadHash, size_t& dataSize );
       
       std::shared_ptr<SessionImpl> m_session;
       Transaction m_transaction;
@@ -171,12 +182,12 @@ namespace cond {
       return createIov( cond::demangledName( typeid(T) ), tag, timeType, synchronizationType );
     }
     
-    template <typename T> inline cond::Hash Session::storePayload( const T& payload, const boost::posix_time::ptime& creationTime ){
+    template <typename T> inline cond::Hash Session::storePayload( const T& payload, const boost::posix_time::ptime& creationTime, bool nativeBinary ){
       
       std::string payloadObjectType = cond::demangledName(typeid(payload));
       cond::Hash ret; 
       try{
-	ret = storePayloadData( payloadObjectType, serialize( payload ), creationTime ); 
+	ret = storePayloadData( payloadObjectType, serialize( payload, nativeBinary ), creationTime ); 
       } catch ( const cond::persistency::Exception& e ){
 	std::string em(e.what());
 	throwException( "Payload of type "+payloadObjectType+" could not be stored. "+em,"Session::storePayload"); 	
@@ -184,13 +195,14 @@ namespace cond {
       return ret;
     }
     
-    template <typename T> inline std::shared_ptr<T> Session::fetchPayload( const cond::Hash& payloadHash ){
+    template <typename T> inline std::shared_ptr<T> Session::loadPayload( const cond::Hash& payloadHash, size_t& dataSize ){
       cond::Binary payloadData;
       cond::Binary streamerInfoData;
       std::string payloadType;
       if(! fetchPayloadData( payloadHash, payloadType, payloadData, streamerInfoData ) ) 
 	throwException( "Payload with id "+payloadHash+" has not been found in the database.",
 			"Session::fetchPayload" );
+      dataSize = payloadData.size();
       std::shared_ptr<T> ret;
       try{ 
 	ret = deserialize<T>(  payloadType, payloadData, streamerInfoData );
@@ -201,6 +213,20 @@ namespace cond {
       return ret;
     }
 
+    template <typename T> inline std::shared_ptr<T> Session::fetchPayload( const cond::Hash& payloadHash ){
+      size_t dataSize = 0;
+      return loadPayload<T>( payloadHash, dataSize );
+    }
+
+    template <typename T> inline std::shared_ptr<const T> Session::fetchSharedPayload( const cond::Hash& payloadHash ){
+      std::shared_ptr<const void> cached = findCachedPayload( payloadHash, typeid(T) );
+      if( cached ) return std::static_pointer_cast<const T>( cached );
+      size_t dataSize = 0;
+      std::shared_ptr<const T> ret = loadPayload<T>( payloadHash, dataSize );
+      cachePayload( payloadHash, typeid(T), ret, dataSize );
+      return ret;
+    }
+
     class TransactionScope {
     public:
       explicit TransactionScope( Transaction& transaction );   
@@ -9,49 +9,82 @@
 #include <cstring>
 
 cond::Binary::Binary():
-  m_data( new coral::Blob(0) ){
+  m_data( new coral::Blob(0) ),
+  m_external(),
+  m_externalSize( 0 ){
 }
 
 cond::Binary::Binary( const void* data, size_t size  ):
-  m_data( new coral::Blob( size ) ){
+  m_data( new coral::Blob( size ) ),
+  m_external(),
+  m_externalSize( 0 ){
   ::memcpy( m_data->startingAddress(), data, size );
 }
 
 cond::Binary::Binary( const coral::Blob& data ):
-  m_data( new coral::Blob(data.size()) ){
+  m_data( new coral::Blob(data.size()) ),
+  m_external(),
+  m_externalSize( 0 ){
   ::memcpy( m_data->startingAddress(), data.startingAddress(), data.size() );
 }
 
+cond::Binary::Binary( const std::shared_ptr<const void>& data, size_t size ):
+  m_data(),
+  m_external( data ),
+  m_externalSize( size ){
+}
+
 cond::Binary::Binary( const Binary& rhs ):
-  m_data( rhs.m_data ){
+  m_data( rhs.m_data ),
+  m_external( rhs.m_external ),
+  m_externalSize( rhs.m_externalSize ){
 }
 
 cond::Binary& cond::Binary::operator=( const Binary& rhs ){
   if( this != &rhs ) {
     m_data = rhs.m_data;
+    m_external = rhs.m_external;
+    m_externalSize = rhs.m_externalSize;
   }
   return *this;
 }
 
 const coral::Blob& cond::Binary::get() const {
+  // the external data is not owned, and can't be exposed as a coral::Blob without a copy
+  if( m_external ) throwException( "Binary data refers to external memory: it has to be made owned first.","Binary::get");
+  if(!m_data.get()) throwException( "Binary data can't be accessed.","Binary::get");
   return *m_data;
 }
 
+void cond::Binary::makeOwned(){
+  if( !m_external ) return;
+  m_data.reset( new coral::Blob( m_externalSize ) );
+  ::memcpy( m_data->startingAddress(), m_external.get(), m_externalSize );
+  m_external.reset();
+  m_externalSize = 0;
+}
+
 void cond::Binary::copy( const std::string& source ){
   m_data.reset( new coral::Blob( source.size() ) );
   ::memcpy( m_data->startingAddress(), source.c_str(), source.size() );
+  m_external.reset();
+  m_externalSize = 0;
 }
 
 const void* cond::Binary::data() const {
+  if( m_external ) return m_external.get();
   if(!m_data.get()) throwException( "Binary data can't be accessed.","Binary::data");
   return m_data->startingAddress();
 }
 void* cond::Binary::data(){
+  // the external data is read-only: make a private copy before giving write access to it
+  makeOwned();
   if(!m_data.get()) throwException( "Binary data can't be accessed.","Binary::data");
   return m_data->startingAddress();
 }
 
 size_t cond::Binary::size() const {
+  if( m_external ) return m_externalSize;
   if(!m_data.get()) throwException( "Binary data can't be accessed.","Binary::size");
   return m_data->size();
 }
@@ -46,6 +46,35 @@ namespace cond {
     void ConnectionPool::setLogging( bool flag ){
       m_loggingEnabled = flag;
     }
+
+    void ConnectionPool::setPayloadCacheDirectory( const std::string& directory ){
+      m_payloadCacheDirectory = directory;
+      resetPayloadCache();
+    }
+
+    void ConnectionPool::setPayloadCacheSize( int megaBytes ){
+      m_payloadCacheSize = megaBytes > 0 ? megaBytes : 0;
+      resetPayloadCache();
+    }
+
+    void ConnectionPool::setPayloadObjectCacheSize( int megaBytes ){
+      m_payloadObjectCacheSize = megaBytes > 0 ? megaBytes : 0;
+      resetPayloadCache();
+    }
+
+    void ConnectionPool::resetPayloadCache(){
+      m_payloadCache.reset();
+      if( m_payloadCacheDirectory.empty() && m_payloadObjectCacheSize == 0 ) return;
+      if( !m_payloadCacheDirectory.empty() ) boost::filesystem::create_directories( m_payloadCacheDirectory );
+      const size_t megaByte = 1024*1024;
+      m_payloadCache = std::make_shared<PayloadCache>( m_payloadCacheDirectory, m_payloadCacheSize*megaByte, m_payloadObjectCacheSize*megaByte );
+    }
+    
+    void ConnectionPool::setIOVCacheTimeToLive( int seconds ){
+      m_iovCacheTimeToLive = seconds;
+      m_iovCache.reset();
+      if( m_iovCacheTimeToLive >= 0 ) m_iovCache = std::make_shared<IOVCache>( m_iovCacheTimeToLive );
+    }
     
     void ConnectionPool::setParameters( const edm::ParameterSet& connectionPset ){
       //set the connection parameters from a ParameterSet
@@ -74,6 +103,10 @@ namespace cond {
       }
       setMessageVerbosity( level );
       setLogging( connectionPset.getUntrackedParameter<bool>( "logging", m_loggingEnabled ) );
+      setPayloadCacheDirectory( connectionPset.getUntrackedParameter<std::string>( "payloadCacheDirectory", m_payloadCacheDirectory ) );
+      setPayloadCacheSize( connectionPset.getUntrackedParameter<int>( "payloadCacheSize", m_payloadCacheSize ) );
+      setPayloadObjectCacheSize( connectionPset.getUntrackedParameter<int>( "payloadObjectCacheSize", m_payloadObjectCacheSize ) );
+      setIOVCacheTimeToLive( connectionPset.getUntrackedParameter<int>( "iovCacheTimeToLive", m_iovCacheTimeToLive ) );
     }
 
     bool ConnectionPool::isLoggingEnabled() const {
@@ -156,7 +189,13 @@ namespace cond {
                                            const std::string& transactionId, 
                                            bool writeCapable ){
       std::shared_ptr<coral::ISessionProxy> coralSession = createCoralSession( connectionString, transactionId, writeCapable );
-      return Session( std::make_shared<SessionImpl>( coralSession, connectionString ));
+      std::shared_ptr<SessionImpl> impl = std::make_shared<SessionImpl>( coralSession, connectionString );
+      // the cache is only used for reading
+      if( !writeCapable ) {
+	impl->payloadCache = m_payloadCache;
+	impl->iovCache = m_iovCache;
+      }
+      return Session( impl );
     }
 
     Session ConnectionPool::createSession( const std::string& connectionString, bool writeCapable ){
@@ -0,0 +1,48 @@
+#include "CondCore/CondDB/interface/IOVCache.h"
+
+namespace {
+
+  std::string cacheKey( const std::string& connectionString,
+			const std::string& tag,
+			const boost::posix_time::ptime& snapshotTime ){
+    return connectionString + '\n' + tag + '\n' + boost::posix_time::to_iso_string( snapshotTime );
+  }
+
+}
+
+namespace cond {
+
+  namespace persistency {
+
+    IOVCache::IOVCache( int timeToLive ):
+      m_timeToLive( timeToLive > 0 ? timeToLive : 0 ),
+      m_mutex(),
+      m_entries(){
+    }
+
+    bool IOVCache::isValid( const Entry& entry, const boost::posix_time::ptime& snapshotTime ) const {
+      // a snapshot of an existing tag is pinned
+      if( entry.found && !snapshotTime.is_not_a_date_time() ) return true;
+      return std::chrono::steady_clock::now() - entry.loadTime < m_timeToLive;
+    }
+
+    std::shared_ptr<const IOVCache::Entry> IOVCache::find( const std::string& connectionString,
+							   const std::string& tag,
+							   const boost::posix_time::ptime& snapshotTime ) const {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      auto iEntry = m_entries.find( cacheKey( connectionString, tag, snapshotTime ) );
+      if( iEntry == m_entries.end() || !isValid( *iEntry->second, snapshotTime ) ) return std::shared_ptr<const Entry>();
+      return iEntry->second;
+    }
+
+    void IOVCache::insert( const std::string& connectionString,
+			   const std::string& tag,
+			   const boost::posix_time::ptime& snapshotTime,
+			   const std::shared_ptr<const Entry>& entry ){
+      if( !isValid( *entry, snapshotTime ) ) return;
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_entries[ cacheKey( connectionString, tag, snapshotTime ) ] = entry;
+    }
+
+  }
+}
@@ -1,4 +1,5 @@
 #include "CondCore/CondDB/interface/IOVProxy.h"
+#include "CondCore/CondDB/interface/IOVCache.h"
 #include "SessionImpl.h"
 
 namespace cond {
@@ -27,7 +28,11 @@ namespace cond {
       cond::Time_t groupHigherIov = cond::time::MIN_VAL;
       std::vector<cond::Time_t> sinceGroups;
       IOVProxy::IOVContainer iovSequence;
+      // the full sequence, when it comes from the IOVCache
+      std::shared_ptr<const IOVProxy::IOVContainer> cachedSequence;
       size_t numberOfQueries = 0;
+
+      const IOVProxy::IOVContainer& sequence() const { return cachedSequence ? *cachedSequence : iovSequence; }
     };
     
     IOVProxy::Iterator::Iterator():
@@ -143,6 +148,11 @@ namespace cond {
       
       checkTransaction( "IOVProxy::load" );
 
+      if( m_session->iovCache ){
+	loadFromCache( tag, snapshotTime );
+	return;
+      }
+
       std::string dummy;
       if(!m_session->iovSchema().tagTable().select( tag, m_data->timeType, m_data->payloadType, m_data->synchronizationType,
 						    m_data->endOfValidity, dummy, m_data->lastValidatedTime ) ){
@@ -170,6 +180,43 @@ namespace cond {
       m_data->snapshotTime = snapshotTime;
     }
 
+    void IOVProxy::loadFromCache( const std::string& tag,
+				  const boost::posix_time::ptime& snapshotTime ){
+      auto entry = m_session->iovCache->find( m_session->connectionString, tag, snapshotTime );
+      if( !entry ){
+	// the tag and its whole sequence, read once for all the proxies
+	auto newEntry = std::make_shared<IOVCache::Entry>();
+	std::string dummy;
+	newEntry->found = m_session->iovSchema().tagTable().select( tag, newEntry->timeType, newEntry->payloadType, newEntry->synchronizationType,
+								    newEntry->endOfValidity, dummy, newEntry->lastValidatedTime );
+	if( newEntry->found ){
+	  if( snapshotTime.is_not_a_date_time() ){
+	    m_session->iovSchema().iovTable().selectLatest( tag, newEntry->iovSequence );
+	  } else {
+	    m_session->iovSchema().iovTable().selectSnapshot( tag, snapshotTime, newEntry->iovSequence );
+	  }
+	  m_data->numberOfQueries++;
+	}
+	newEntry->loadTime = std::chrono::steady_clock::now();
+	m_session->iovCache->insert( m_session->connectionString, tag, snapshotTime, newEntry );
+	entry = newEntry;
+      }
+      if( !entry->found ){
+	throwException( "Tag \""+tag+"\" has not been found in the database.","IOVProxy::load");
+      }
+
+      m_data->tag = tag;
+      m_data->timeType = entry->timeType;
+      m_data->payloadType = entry->payloadType;
+      m_data->synchronizationType = entry->synchronizationType;
+      m_data->endOfValidity = entry->endOfValidity;
+      m_data->lastValidatedTime = entry->lastValidatedTime;
+      m_data->cachedSequence = std::shared_ptr<const IOVContainer>( entry, &entry->iovSequence );
+      m_data->groupLowerIov = cond::time::MIN_VAL;
+      m_data->groupHigherIov = cond::time::MAX_VAL;
+      m_data->snapshotTime = snapshotTime;
+    }
+
     void IOVProxy::loadRange( const std::string& tag, 
 			      const cond::Time_t& begin, 
 			      const cond::Time_t& end ){
@@ -206,6 +253,7 @@ namespace cond {
 	m_data->groupHigherIov = cond::time::MIN_VAL;
 	m_data->sinceGroups.clear();
 	m_data->iovSequence.clear();
+	m_data->cachedSequence.reset();
 	m_data->numberOfQueries = 0;
       }
     }
@@ -245,7 +293,7 @@ namespace cond {
     }
 
     bool IOVProxy::isEmpty() const {
-      return m_data.get() ? ( m_data->sinceGroups.size()==0 && m_data->iovSequence.size()==0 ) : true; 
+      return m_data.get() ? ( m_data->sinceGroups.size()==0 && m_data->sequence().size()==0 ) : true; 
     }
     
     void IOVProxy::checkTransaction( const std::string& ctx ) const {
@@ -282,7 +330,7 @@ namespace cond {
     
     IOVProxy::Iterator IOVProxy::begin() const {
       if( m_data.get() ){
-	return Iterator( m_data->iovSequence.begin(), m_data->iovSequence.end(), 
+	return Iterator( m_data->sequence().begin(), m_data->sequence().end(), 
 			 m_data->timeType, m_data->groupHigherIov, m_data->endOfValidity );
       } 
       return Iterator();
@@ -290,7 +338,7 @@ namespace cond {
     
     IOVProxy::Iterator IOVProxy::end() const {
       if( m_data.get() ){
-	return Iterator( m_data->iovSequence.end(), m_data->iovSequence.end(), 
+	return Iterator( m_data->sequence().end(), m_data->sequence().end(), 
 			 m_data->timeType, m_data->groupHigherIov, m_data->endOfValidity );
       } 
       return Iterator();
@@ -336,8 +384,8 @@ namespace cond {
       }
       
       // the current iov set is a good one...
-      auto iIov = search( time, m_data->iovSequence );
-      return Iterator( iIov, m_data->iovSequence.end(), m_data->timeType, m_data->groupHigherIov, m_data->endOfValidity );
+      auto iIov = search( time, m_data->sequence() );
+      return Iterator( iIov, m_data->sequence().end(), m_data->timeType, m_data->groupHigherIov, m_data->endOfValidity );
     }
     
     cond::Iov_t IOVProxy::getInterval( cond::Time_t time ){
@@ -362,7 +410,7 @@ namespace cond {
     }
     
     int IOVProxy::loadedSize() const {
-      return m_data.get()? m_data->iovSequence.size() : 0;
+      return m_data.get()? m_data->sequence().size() : 0;
     }
     
     int IOVProxy::sequenceSize() const {
@@ -388,9 +388,13 @@ namespace cond {
 				 const cond::Binary& streamerInfoData,				      
     				 const boost::posix_time::ptime& insertionTime ){
       std::string version("dummy");
+      // the data read from the payload cache is bound to the query as a coral::Blob: it has to be owned
+      cond::Binary data( payloadData );
+      data.makeOwned();
       cond::Binary sinfoData( streamerInfoData );
+      sinfoData.makeOwned();
       if( !sinfoData.size() ) sinfoData.copy( std::string("0") );   
-      RowBuffer< HASH, OBJECT_TYPE, DATA, STREAMER_INFO, VERSION, INSERTION_TIME > dataToInsert( std::tie( payloadHash, objectType, payloadData, sinfoData, version, insertionTime ) ); 
+      RowBuffer< HASH, OBJECT_TYPE, DATA, STREAMER_INFO, VERSION, INSERTION_TIME > dataToInsert( std::tie( payloadHash, objectType, data, sinfoData, version, insertionTime ) ); 
       bool failOnDuplicate = false;
       return insertInTable( m_schema, tname, dataToInsert.get(), failOnDuplicate );
     }
@@ -0,0 +1,200 @@
+#include "CondCore/CondDB/interface/PayloadCache.h"
+//
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <tuple>
+#include <vector>
+//
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+  // layout of a cache file: the header, followed by the payload type name, the payload data and the streamer info
+  struct CacheFileHeader {
+    char magic[8];
+    uint64_t typeSize;
+    uint64_t dataSize;
+    uint64_t streamerInfoSize;
+  };
+
+  constexpr char s_magic[8] = { 'C','O','N','D','P','L','C','1' };
+
+  bool writeAll( int fd, const void* data, size_t size ){
+    const char* buffer = static_cast<const char*>( data );
+    while( size > 0 ){
+      ssize_t written = ::write( fd, buffer, size );
+      if( written < 0 ) return false;
+      buffer += written;
+      size -= written;
+    }
+    return true;
+  }
+
+  bool endsWith( const std::string& name, const std::string& suffix ){
+    return name.size() >= suffix.size() && name.compare( name.size() - suffix.size(), suffix.size(), suffix ) == 0;
+  }
+
+  const std::string s_suffix( ".payload" );
+
+}
+
+namespace cond {
+
+  namespace persistency {
+
+    PayloadCache::PayloadCache( const std::string& directory, size_t maxDirectorySize, size_t maxObjectCacheSize ):
+      m_directory( directory ),
+      m_maxDirectorySize( maxDirectorySize ),
+      m_maxObjectCacheSize( maxObjectCacheSize ),
+      m_objectMutex(),
+      m_objects(),
+      m_objectUsage(),
+      m_objectCacheSize( 0 ){
+    }
+
+    std::string PayloadCache::fileName( const cond::Hash& payloadHash ) const {
+      return m_directory + "/" + payloadHash + s_suffix;
+    }
+
+    bool PayloadCache::load( const cond::Hash& payloadHash,
+			     std::string& payloadType,
+			     cond::Binary& payloadData,
+			     cond::Binary& streamerInfoData ) const {
+      if( !hasFileCache() ) return false;
+      int fd = ::open( fileName( payloadHash ).c_str(), O_RDONLY );
+      if( fd < 0 ) return false;
+      struct stat st;
+      if( ::fstat( fd, &st ) != 0 || (size_t) st.st_size < sizeof(CacheFileHeader) ){
+	::close( fd );
+	return false;
+      }
+      size_t fileSize = st.st_size;
+      // mark the file as recently used; this only fails for the files of other users, which are then evicted earlier
+      if( m_maxDirectorySize ) ::futimens( fd, nullptr );
+      void* address = ::mmap( nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0 );
+      // the mapping stays valid after the file descriptor is closed
+      ::close( fd );
+      if( address == MAP_FAILED ) return false;
+      std::shared_ptr<const void> mapping( address, [fileSize]( const void* p ){ ::munmap( const_cast<void*>( p ), fileSize ); } );
+
+      CacheFileHeader header;
+      ::memcpy( &header, address, sizeof(CacheFileHeader) );
+      if( ::memcmp( header.magic, s_magic, sizeof(s_magic) ) != 0 ||
+	  sizeof(CacheFileHeader) + header.typeSize + header.dataSize + header.streamerInfoSize != fileSize )
+	return false;
+
+      const char* begin = static_cast<const char*>( address ) + sizeof(CacheFileHeader);
+      payloadType.assign( begin, header.typeSize );
+      begin += header.typeSize;
+      // the Binary objects share the ownership of the mapping
+      payloadData = cond::Binary( std::shared_ptr<const void>( mapping, begin ), header.dataSize );
+      begin += header.dataSize;
+      streamerInfoData = cond::Binary( std::shared_ptr<const void>( mapping, begin ), header.streamerInfoSize );
+      return true;
+    }
+
+    bool PayloadCache::store( const cond::Hash& payloadHash,
+			      const std::string& payloadType,
+			      const cond::Binary& payloadData,
+			      const cond::Binary& streamerInfoData ) const {
+      if( !hasFileCache() ) return false;
+      std::string target = fileName( payloadHash );
+      if( ::access( target.c_str(), F_OK ) == 0 ) return true;
+
+      // write to a name unique to this process and call, then rename: other jobs either see the whole file or none
+      static std::atomic<unsigned int> s_counter( 0 );
+      std::ostringstream temporary;
+      temporary << target << ".tmp." << ::getpid() << "." << s_counter++;
+      int fd = ::open( temporary.str().c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644 );
+      if( fd < 0 ) return false;
+
+      CacheFileHeader header;
+      ::memcpy( header.magic, s_magic, sizeof(s_magic) );
+      header.typeSize = payloadType.size();
+      header.dataSize = payloadData.size();
+      header.streamerInfoSize = streamerInfoData.size();
+      bool ok = writeAll( fd, &header, sizeof(CacheFileHeader) ) &&
+		writeAll( fd, payloadType.data(), payloadType.size() ) &&
+		writeAll( fd, payloadData.data(), payloadData.size() ) &&
+		writeAll( fd, streamerInfoData.data(), streamerInfoData.size() );
+      ok = ( ::close( fd ) == 0 ) && ok;
+      if( ok ) ok = ( ::rename( temporary.str().c_str(), target.c_str() ) == 0 );
+      if( !ok ) ::unlink( temporary.str().c_str() );
+      if( ok && m_maxDirectorySize ) evictFiles( target );
+      return ok;
+    }
+
+    void PayloadCache::evictFiles( const std::string& keep ) const {
+      DIR* dir = ::opendir( m_directory.c_str() );
+      if( dir == nullptr ) return;
+      // modification time, size and name of the cache files
+      std::vector<std::tuple<struct timespec, size_t, std::string> > files;
+      size_t totalSize = 0;
+      while( struct dirent* entry = ::readdir( dir ) ){
+	std::string name( entry->d_name );
+	if( !endsWith( name, s_suffix ) ) continue;
+	std::string path = m_directory + "/" + name;
+	struct stat st;
+	if( ::stat( path.c_str(), &st ) != 0 ) continue;
+	totalSize += st.st_size;
+	if( path != keep ) files.emplace_back( st.st_mtim, st.st_size, path );
+      }
+      ::closedir( dir );
+      if( totalSize <= m_maxDirectorySize ) return;
+
+      std::sort( files.begin(), files.end(),
+		 []( const std::tuple<struct timespec, size_t, std::string>& a, const std::tuple<struct timespec, size_t, std::string>& b ){
+		   const struct timespec& ta = std::get<0>( a );
+		   const struct timespec& tb = std::get<0>( b );
+		   return ta.tv_sec < tb.tv_sec || ( ta.tv_sec == tb.tv_sec && ta.tv_nsec < tb.tv_nsec );
+		 } );
+      // the files may be removed concurrently by other jobs: their size is not counted again
+      for( const auto& file : files ){
+	if( totalSize <= m_maxDirectorySize ) break;
+	if( ::unlink( std::get<2>( file ).c_str() ) == 0 || errno == ENOENT ) totalSize -= std::get<1>( file );
+      }
+    }
+
+    std::shared_ptr<const void> PayloadCache::findObject( const cond::Hash& payloadHash, const std::type_info& type ){
+      std::lock_guard<std::mutex> lock( m_objectMutex );
+      auto iObject = m_objects.find( payloadHash );
+      if( iObject == m_objects.end() || iObject->second.type != std::type_index( type ) ) return std::shared_ptr<const void>();
+      m_objectUsage.splice( m_objectUsage.begin(), m_objectUsage, iObject->second.usage );
+      return iObject->second.object;
+    }
+
+    void PayloadCache::insertObject( const cond::Hash& payloadHash,
+				     const std::type_info& type,
+				     const std::shared_ptr<const void>& object,
+				     size_t size ){
+      if( m_maxObjectCacheSize == 0 || size > m_maxObjectCacheSize ) return;
+      std::lock_guard<std::mutex> lock( m_objectMutex );
+      auto iObject = m_objects.find( payloadHash );
+      if( iObject != m_objects.end() ){
+	// the same payload read with another type replaces the previous one
+	m_objectCacheSize -= iObject->second.size;
+	m_objectUsage.erase( iObject->second.usage );
+	m_objects.erase( iObject );
+      }
+      while( m_objectCacheSize + size > m_maxObjectCacheSize ){
+	auto iOldest = m_objects.find( m_objectUsage.back() );
+	m_objectCacheSize -= iOldest->second.size;
+	m_objects.erase( iOldest );
+	m_objectUsage.pop_back();
+      }
+      m_objectUsage.push_front( payloadHash );
+      m_objects.emplace( payloadHash, ObjectEntry{ std::type_index( type ), object, size, m_objectUsage.begin() } );
+      m_objectCacheSize += size;
+    }
+
+  }
+}
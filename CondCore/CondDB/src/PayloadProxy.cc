@@ -48,6 +48,21 @@ namespace cond {
       return ValidityInterval( m_currentIov.since, m_currentIov.till );
     }
     
+    bool BasePayloadProxy::prepareNext(){
+      if( !m_currentIov.isValid() ) return false;
+      // the payload of the next IOV is already available or being loaded
+      if( m_nextIov.isValid() && m_nextIov.isValidFor( m_currentIov.till+1 ) ) return !isNextLoaded();
+      m_nextIov.clear();
+      if( m_currentIov.till >= cond::timeTypeSpecs[timeType()].endValue ) return false;
+      m_session.transaction().start(true);
+      auto it = m_iovProxy.find( m_currentIov.till+1 );
+      if( it != m_iovProxy.end() ) m_nextIov = *it;
+      m_session.transaction().commit();
+      // nothing to load if the next IOV points to the same payload
+      if( m_nextIov.isValid() && m_nextIov.payloadId == m_currentIov.payloadId ) m_nextIov.clear();
+      return m_nextIov.isValid();
+    }
+
     bool BasePayloadProxy::isValid() const {
       return m_currentIov.isValid();
     }
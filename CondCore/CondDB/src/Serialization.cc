@@ -8,13 +8,39 @@ std::string cond::StreamerInfo::techVersion(){
 }
 
 std::string cond::StreamerInfo::jsonString(){
+  return jsonString( TECHNOLOGY, "" );
+}
+
+std::string cond::StreamerInfo::jsonString( const std::string& technology, const std::string& typeHash ){
   std::stringstream ss;
   ss<<" {"<<std::endl;
   ss<<"\""<<CMSSW_VERSION_LABEL<<"\": \""<<currentCMSSWVersion()<<"\","<<std::endl;
   ss<<"\""<<ARCH_LABEL<<"\": \""<<currentArchitecture()<<"\","<<std::endl;
-  ss<<"\""<<TECH_LABEL<<"\": \""<<TECHNOLOGY<<"\","<<std::endl;
+  ss<<"\""<<TECH_LABEL<<"\": \""<<technology<<"\","<<std::endl;
+  if( !typeHash.empty() ) ss<<"\""<<TYPE_HASH_LABEL<<"\": \""<<typeHash<<"\","<<std::endl;
+  if( technology == BINARY_TECHNOLOGY ) ss<<"\""<<BINARY_ARCH_LABEL<<"\": \""<<binaryArchitecture()<<"\","<<std::endl;
   ss<<"\""<<TECH_VERSION_LABEL<<"\": \""<<techVersion()<<"\""<<std::endl;
   ss<<" }"<<std::endl;
   return ss.str();
 }
 
+std::string cond::StreamerInfo::binaryArchitecture(){
+  const uint16_t one = 1;
+  std::stringstream ss;
+  ss<<( *reinterpret_cast<const unsigned char*>( &one ) == 1 ? "little_endian" : "big_endian" )
+    <<"-short"<<sizeof(short)<<"-int"<<sizeof(int)<<"-long"<<sizeof(long)<<"-longlong"<<sizeof(long long)
+    <<"-float"<<sizeof(float)<<"-double"<<sizeof(double)<<"-longdouble"<<sizeof(long double)
+    <<"-wchar"<<sizeof(wchar_t)<<"-bool"<<sizeof(bool);
+  return ss.str();
+}
+
+std::string cond::StreamerInfo::value( const std::string& streamerInfo, const std::string& label ){
+  std::string key = "\""+label+"\": \"";
+  size_t begin = streamerInfo.find( key );
+  if( begin == std::string::npos ) return std::string("");
+  begin += key.size();
+  size_t end = streamerInfo.find( '"', begin );
+  if( end == std::string::npos ) return std::string("");
+  return streamerInfo.substr( begin, end-begin );
+}
+
@@ -196,8 +196,26 @@ namespace cond {
 				    std::string& payloadType, 
 				    cond::Binary& payloadData,
 				    cond::Binary& streamerInfoData ){
+      if( m_session->payloadCache && m_session->payloadCache->load( payloadHash, payloadType, payloadData, streamerInfoData ) )
+	return true;
       m_session->openIovDb();
-      return m_session->iovSchema().payloadTable().select( payloadHash, payloadType, payloadData, streamerInfoData );
+      bool found = m_session->iovSchema().payloadTable().select( payloadHash, payloadType, payloadData, streamerInfoData );
+      if( found && m_session->payloadCache ){
+	// publish the payload for the other jobs, and read it back from the shared pages, dropping the private copy
+	if( m_session->payloadCache->store( payloadHash, payloadType, payloadData, streamerInfoData ) )
+	  m_session->payloadCache->load( payloadHash, payloadType, payloadData, streamerInfoData );
+      }
+      return found;
+    }
+
+    std::shared_ptr<const void> Session::findCachedPayload( const cond::Hash& payloadHash, const std::type_info& type ){
+      if( !m_session->payloadCache ) return std::shared_ptr<const void>();
+      return m_session->payloadCache->findObject( payloadHash, type );
+    }
+
+    void Session::cachePayload( const cond::Hash& payloadHash, const std::type_info& type,
+				const std::shared_ptr<const void>& payload, size_t size ){
+      if( m_session->payloadCache ) m_session->payloadCache->insertObject( payloadHash, type, payload, size );
     }
 
     std::string Session::connectionString(){
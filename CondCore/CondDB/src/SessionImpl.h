@@ -2,6 +2,8 @@
 #define CondCore_CondDB_SessionImpl_h
 
 #include "CondCore/CondDB/interface/Types.h"
+#include "CondCore/CondDB/interface/PayloadCache.h"
+#include "CondCore/CondDB/interface/IOVCache.h"
 #include "IOVSchema.h"
 #include "GTSchema.h"
 //
@@ -67,6 +69,10 @@ namespace cond {
       std::unique_ptr<ITransaction> transaction;
       std::unique_ptr<IIOVSchema> iovSchemaHandle; 
       std::unique_ptr<IGTSchema> gtSchemaHandle; 
+      // optional node-local cache of the serialized payloads, shared by all the sessions of a ConnectionPool
+      std::shared_ptr<PayloadCache> payloadCache;
+      // optional in-memory cache of the iov sequences, shared by all the sessions of a ConnectionPool
+      std::shared_ptr<IOVCache> iovCache;
     };
 
   }
@@ -0,0 +1,108 @@
+//Module includes
+#include "CondCore/CondDB/interface/Serialization.h"
+//
+#include "MyTestData.h"
+//
+#include <iostream>
+#include <memory>
+#include <string>
+
+// two layouts of the same members, the second with another type for y and the members swapped in the third
+struct LayoutA {
+  int x = 1;
+  float y = 2;
+  template <class Archive> void serialize( Archive& ar, const unsigned int ){
+    ar & boost::serialization::make_nvp( "x", x );
+    ar & boost::serialization::make_nvp( "y", y );
+  }
+};
+struct LayoutB {
+  int x = 1;
+  double y = 2;
+  template <class Archive> void serialize( Archive& ar, const unsigned int ){
+    ar & boost::serialization::make_nvp( "x", x );
+    ar & boost::serialization::make_nvp( "y", y );
+  }
+};
+struct LayoutC {
+  float y = 2;
+  int x = 1;
+  template <class Archive> void serialize( Archive& ar, const unsigned int ){
+    ar & boost::serialization::make_nvp( "y", y );
+    ar & boost::serialization::make_nvp( "x", x );
+  }
+};
+
+// the layout without the class name, which differs anyway
+template <typename T> std::string memberLayout(){
+  std::string layout = cond::typeLayout<T>();
+  return layout.substr( cond::demangledName( typeid(T) ).size() );
+}
+
+int main (int argc, char** argv)
+{
+  int ret = 0;
+  try{
+    std::string payloadType = cond::demangledName( typeid(MyTestData) );
+    MyTestData data( 909 );
+
+    for( bool nativeBinary : { false, true } ){
+      std::pair<cond::Binary,cond::Binary> blob = cond::serialize( data, nativeBinary );
+      std::shared_ptr<MyTestData> readBack = cond::deserialize<MyTestData>( payloadType, blob.first, blob.second );
+      if( *readBack != data ){
+	std::cout << "ERROR: payload read back differs, nativeBinary=" << nativeBinary << std::endl;
+	ret = -1;
+      }
+    }
+
+    std::pair<cond::Binary,cond::Binary> blob = cond::serialize( data, true );
+    std::string streamerInfo( static_cast<const char*>( blob.second.data() ), blob.second.size() );
+    if( cond::StreamerInfo::value( streamerInfo, cond::StreamerInfo::TYPE_HASH_LABEL ) != cond::typeHash<MyTestData>() ){
+      std::cout << "ERROR: type hash missing from the streamer info: " << streamerInfo << std::endl;
+      ret = -1;
+    }
+
+    if( memberLayout<LayoutA>() == memberLayout<LayoutB>() || memberLayout<LayoutA>() == memberLayout<LayoutC>() ){
+      std::cout << "ERROR: the layout does not see the types or the order of the members: " << memberLayout<LayoutA>() << std::endl;
+      ret = -1;
+    }
+
+    // a blob uploaded from a platform with another representation of the numbers must be refused
+    std::string otherArch( streamerInfo );
+    std::string arch = cond::StreamerInfo::binaryArchitecture();
+    otherArch.replace( otherArch.find( arch ), arch.size(), "big_endian-other" );
+    cond::Binary otherArchInfo;
+    otherArchInfo.copy( otherArch );
+    bool archRefused = false;
+    try{
+      cond::deserialize<MyTestData>( payloadType, blob.first, otherArchInfo );
+    } catch ( const cond::Exception& e ){
+      std::cout << "Expected error: " << e.what() << std::endl;
+      archRefused = true;
+    }
+    if( !archRefused ){
+      std::cout << "ERROR: payload from another binary architecture has been read." << std::endl;
+      ret = -1;
+    }
+
+    // a blob uploaded with another layout of the class must be refused
+    cond::Binary otherLayout;
+    otherLayout.copy( cond::StreamerInfo::jsonString( cond::StreamerInfo::BINARY_TECHNOLOGY, "0000000000000000" ) );
+    bool refused = false;
+    try{
+      cond::deserialize<MyTestData>( payloadType, blob.first, otherLayout );
+    } catch ( const cond::Exception& e ){
+      std::cout << "Expected error: " << e.what() << std::endl;
+      refused = true;
+    }
+    if( !refused ){
+      std::cout << "ERROR: payload with a different type hash has been read." << std::endl;
+      ret = -1;
+    }
+  } catch ( const std::exception& e ){
+    std::cout << "ERROR: " << e.what() << std::endl;
+    ret = -1;
+  }
+  if( ret == 0 ) std::cout << "## Run successfully completed." << std::endl;
+  return ret;
+}
@@ -0,0 +1,75 @@
+//Module includes
+#include "CondCore/CondDB/interface/IOVCache.h"
+//
+#include <iostream>
+#include <memory>
+#include <string>
+//
+#include <unistd.h>
+
+using namespace cond::persistency;
+
+int main (int argc, char** argv)
+{
+  int ret = 0;
+  try{
+    std::string connectionString( "sqlite_file:cms_conditions.db" );
+    std::string tag( "MyNewIOV" );
+    boost::posix_time::ptime latest;
+    boost::posix_time::ptime snapshotTime = boost::posix_time::time_from_string( "2016-06-01 12:00:00" );
+
+    auto entry = std::make_shared<IOVCache::Entry>();
+    entry->found = true;
+    entry->timeType = cond::runnumber;
+    entry->payloadType = "RunInfo";
+    entry->iovSequence.push_back( std::make_tuple( 1, "cfd8987f899e99de69626e8a91b5c6b1506b82de" ) );
+    entry->iovSequence.push_back( std::make_tuple( 100, "a2b8e7a1f0e16bf50e03a0d9b8d4cd7e5e06b651" ) );
+    entry->loadTime = std::chrono::steady_clock::now();
+
+    IOVCache noTimeToLive( 0 );
+    noTimeToLive.insert( connectionString, tag, latest, entry );
+    noTimeToLive.insert( connectionString, tag, snapshotTime, entry );
+    if( noTimeToLive.find( connectionString, tag, latest ) ){
+      std::cout << "ERROR: latest sequence kept without a time to live." << std::endl;
+      ret = -1;
+    }
+    auto pinned = noTimeToLive.find( connectionString, tag, snapshotTime );
+    if( !pinned || pinned->iovSequence.size() != 2 || std::get<0>( pinned->iovSequence.back() ) != 100 ){
+      std::cout << "ERROR: snapshot sequence not found in the cache." << std::endl;
+      ret = -1;
+    }
+    if( noTimeToLive.find( "sqlite_file:other.db", tag, snapshotTime ) || noTimeToLive.find( connectionString, "Other", snapshotTime ) ){
+      std::cout << "ERROR: sequence found for another database or tag." << std::endl;
+      ret = -1;
+    }
+
+    // tags not found expire like the latest sequences
+    auto missing = std::make_shared<IOVCache::Entry>();
+    missing->loadTime = std::chrono::steady_clock::now();
+    IOVCache cache( 1 );
+    cache.insert( connectionString, tag, latest, entry );
+    cache.insert( connectionString, "Missing", snapshotTime, missing );
+    if( !cache.find( connectionString, tag, latest ) ){
+      std::cout << "ERROR: latest sequence not found in the cache." << std::endl;
+      ret = -1;
+    }
+    auto negative = cache.find( connectionString, "Missing", snapshotTime );
+    if( !negative || negative->found ){
+      std::cout << "ERROR: missing tag not remembered." << std::endl;
+      ret = -1;
+    }
+    ::sleep( 2 );
+    if( cache.find( connectionString, tag, latest ) || cache.find( connectionString, "Missing", snapshotTime ) ){
+      std::cout << "ERROR: entries found after their time to live." << std::endl;
+      ret = -1;
+    }
+  } catch (const std::exception& e){
+    std::cout << "ERROR: " << e.what() << std::endl;
+    ret = -1;
+  } catch (...){
+    std::cout << "UNEXPECTED FAILURE." << std::endl;
+    ret = -1;
+  }
+  if( ret == 0 ) std::cout << "## IOVCache test successful." << std::endl;
+  return ret;
+}
@@ -0,0 +1,138 @@
+//Module includes
+#include "CondCore/CondDB/interface/PayloadCache.h"
+#include "CondCore/CondDB/interface/Binary.h"
+#include "CondCore/CondDB/interface/Exception.h"
+//
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+//
+#include <unistd.h>
+
+using namespace cond::persistency;
+
+int main (int argc, char** argv)
+{
+  char directory[] = "/tmp/testPayloadCacheXXXXXX";
+  if( ::mkdtemp( directory ) == nullptr ){
+    std::cout << "ERROR: cannot create the cache directory." << std::endl;
+    return -1;
+  }
+  int ret = 0;
+  try{
+    // room for two of the payloads below
+    PayloadCache cache( directory, 250, 100 );
+    std::string hash( "cfd8987f899e99de69626e8a91b5c6b1506b82de" );
+    std::string type;
+    cond::Binary data;
+    cond::Binary streamerInfo;
+    if( cache.load( hash, type, data, streamerInfo ) ){
+      std::cout << "ERROR: payload found in an empty cache." << std::endl;
+      ret = -1;
+    }
+
+    std::string payload( "some serialized payload content" );
+    std::string info( "{\"technology\":\"boost/serialization\"}" );
+    cond::Binary inData;
+    inData.copy( payload );
+    cond::Binary inInfo;
+    inInfo.copy( info );
+    if( !cache.store( hash, "RunInfo", inData, inInfo ) ){
+      std::cout << "ERROR: cannot store the payload." << std::endl;
+      ret = -1;
+    }
+    // a second store of the same payload is a no-op
+    if( !cache.store( hash, "RunInfo", inData, inInfo ) ){
+      std::cout << "ERROR: cannot store the payload twice." << std::endl;
+      ret = -1;
+    }
+
+    if( !cache.load( hash, type, data, streamerInfo ) ){
+      std::cout << "ERROR: payload not found in the cache." << std::endl;
+      ret = -1;
+    } else {
+      // read through const references: the non-const data() would make a private copy
+      const cond::Binary& mapped = data;
+      const cond::Binary& mappedInfo = streamerInfo;
+      std::string outData( static_cast<const char*>( mapped.data() ), mapped.size() );
+      std::string outInfo( static_cast<const char*>( mappedInfo.data() ), mappedInfo.size() );
+      if( type != "RunInfo" || outData != payload || outInfo != info ){
+	std::cout << "ERROR: payload read back from the cache does not match." << std::endl;
+	ret = -1;
+      }
+      // the mapped data is not owned: it can't be bound as a coral::Blob before being copied
+      bool thrown = false;
+      try{
+	mapped.get();
+      } catch ( const cond::persistency::Exception& ){
+	thrown = true;
+      }
+      if( !thrown || data.isOwned() ){
+	std::cout << "ERROR: the mapped data was exposed without being made owned." << std::endl;
+	ret = -1;
+      }
+      // the mapped data is read-only: accessing it for writing makes a private copy
+      static_cast<char*>( data.data() )[0] = 'S';
+      std::string copied( static_cast<const char*>( data.data() ), data.size() );
+      cond::Binary again;
+      cache.load( hash, type, again, streamerInfo );
+      std::string shared( static_cast<const char*>( again.data() ), again.size() );
+      if( copied[0] != 'S' || shared != payload ){
+	std::cout << "ERROR: writing to a cached payload modified the cache." << std::endl;
+	ret = -1;
+      }
+    }
+
+    // the least recently used files are removed when the directory grows beyond its limit
+    std::vector<std::string> hashes = { "0000000000000000000000000000000000000001",
+					"0000000000000000000000000000000000000002",
+					"0000000000000000000000000000000000000003" };
+    ::unlink( (std::string( directory ) + "/" + hash + ".payload").c_str() );
+    cache.store( hashes[0], "RunInfo", inData, inInfo );
+    ::sleep( 1 );
+    cache.store( hashes[1], "RunInfo", inData, inInfo );
+    ::sleep( 1 );
+    // reading the first one makes the second one the least recently used
+    cache.load( hashes[0], type, data, streamerInfo );
+    cache.store( hashes[2], "RunInfo", inData, inInfo );
+    if( !cache.load( hashes[0], type, data, streamerInfo ) || cache.load( hashes[1], type, data, streamerInfo ) ||
+	!cache.load( hashes[2], type, data, streamerInfo ) ){
+      std::cout << "ERROR: the least recently used payload has not been evicted." << std::endl;
+      ret = -1;
+    }
+    for( const auto& h : hashes ) ::unlink( (std::string( directory ) + "/" + h + ".payload").c_str() );
+
+    // the deserialized objects are shared, and dropped from the least recently used
+    auto first = std::make_shared<const std::string>( "first" );
+    auto second = std::make_shared<const std::string>( "second" );
+    cache.insertObject( hashes[0], typeid(std::string), first, 40 );
+    cache.insertObject( hashes[1], typeid(std::string), second, 40 );
+    if( cache.findObject( hashes[0], typeid(std::string) ) != first || cache.findObject( hashes[0], typeid(int) ) ){
+      std::cout << "ERROR: cached object not found with its type." << std::endl;
+      ret = -1;
+    }
+    cache.insertObject( hashes[2], typeid(std::string), first, 40 );
+    if( !cache.findObject( hashes[0], typeid(std::string) ) || cache.findObject( hashes[1], typeid(std::string) ) ){
+      std::cout << "ERROR: the least recently used object has not been dropped." << std::endl;
+      ret = -1;
+    }
+    // objects larger than the cache are not kept
+    cache.insertObject( hashes[1], typeid(std::string), second, 101 );
+    if( cache.findObject( hashes[1], typeid(std::string) ) || !cache.findObject( hashes[2], typeid(std::string) ) ){
+      std::cout << "ERROR: an object larger than the cache has been kept." << std::endl;
+      ret = -1;
+    }
+  } catch (const std::exception& e){
+    std::cout << "ERROR: " << e.what() << std::endl;
+    ret = -1;
+  } catch (...){
+    std::cout << "UNEXPECTED FAILURE." << std::endl;
+    ret = -1;
+  }
+  ::rmdir( directory );
+  if( ret == 0 ) std::cout << "## PayloadCache test successful." << std::endl;
+  return ret;
+}
@@ -24,10 +24,13 @@
 #include "CondCore/CondDB/interface/PayloadProxy.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include <algorithm>
 #include <exception>
 
 #include <iomanip>
 
+#include "tbb/task_group.h"
+
 namespace {
   /* utility ot build the name of the plugin corresponding to a given record
      se ESSources
@@ -96,6 +99,8 @@ namespace {
  *  DBParameters: configuration set of the connection
  *  globaltag: The GlobalTag
  *  toGet: list of record label tag connection-string to add/overwrite the content of the global-tag
+ *  numberOfConcurrentPayloadLoads: if more than one, load at once all the payloads valid for a new IOV, with up to this number of sessions per connection
+ *  prefetchNextIOV: if true (and loading concurrently) load in the background the payloads of the following IOVs
  */
 CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
   m_connection(), 
@@ -103,7 +108,10 @@ CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
   m_lastRun(0),  // for the stat
   m_lastLumi(0),  // for the stat
   m_policy( NOREFRESH ),
-  m_doDump( iConfig.getUntrackedParameter<bool>( "DumpStat", false ) )
+  m_doDump( iConfig.getUntrackedParameter<bool>( "DumpStat", false ) ),
+  m_concurrentLoads( iConfig.getUntrackedParameter<unsigned int>( "numberOfConcurrentPayloadLoads", 1 ) ),
+  m_prefetchNextIOV( iConfig.getUntrackedParameter<bool>( "prefetchNextIOV", false ) ),
+  m_lastLoadTime( edm::IOVSyncValue::invalidIOVSyncValue() )
 {
   if( iConfig.getUntrackedParameter<bool>( "RefreshAlways", false ) ) {
     m_policy = REFRESH_ALWAYS;
@@ -118,6 +126,14 @@ CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
     m_policy = RECONNECT_EACH_RUN;
   }
 
+  // the refresh policies reload the IOV sequences record by record, which discards any payload loaded in advance
+  if( m_concurrentLoads > 1 && m_policy != NOREFRESH ) {
+    edm::LogWarning( "CondDBESSource" ) << "Concurrent loading of the payloads is not supported together with a refresh policy, "
+					<< "payloads will be loaded one at a time";
+    m_concurrentLoads = 1;
+  }
+  if( m_concurrentLoads <= 1 ) m_prefetchNextIOV = false;
+
   Stats s = {0,0,0,0,0,0,0,0};
   m_stats = s;	
 
@@ -293,6 +309,12 @@ void CondDBESSource::fillList(const std::string & stringList, std::vector<std::s
 }
 
 CondDBESSource::~CondDBESSource() {
+  // the errors of the payloads loaded in advance are reported when they are first accessed
+  try {
+    waitForPrefetch();
+  } catch( ... ) {
+  }
+
   //dump info FIXME: find a more suitable place...
   if (m_doDump) {
     std::cout << "CondDBESSource Statistics" << std::endl
@@ -334,6 +356,12 @@ CondDBESSource::setIntervalFor( const edm::eventsetup::EventSetupRecordKey& iKey
 				   << "; from CondDBESSource::setIntervalFor";
   
   m_stats.nSet++;
+
+  // the first record asked for a new time triggers the loading of the payloads of all records
+  if( m_concurrentLoads > 1 && !(iTime == m_lastLoadTime) ) {
+    m_lastLoadTime = iTime;
+    loadPayloads( iTime );
+  }
   //{
     // not really required, keep here for the time being
     if(iTime.eventID().run()!=m_lastRun) {
@@ -528,6 +556,86 @@ CondDBESSource::setIntervalFor( const edm::eventsetup::EventSetupRecordKey& iKey
 }
   
 
+std::vector<cond::persistency::Session> &
+CondDBESSource::loadSessions( const std::string & connectionString ) {
+  std::vector<cond::persistency::Session> & sessions = m_loadSessions[connectionString];
+  if( sessions.empty() ) {
+    for( unsigned int i = 0; i < m_concurrentLoads; ++i )
+      sessions.push_back( m_connection.createReadOnlySession( connectionString, "" ) );
+  }
+  return sessions;
+}
+
+void
+CondDBESSource::waitForPrefetch() {
+  // rethrows any exception which escaped a background task
+  m_prefetchTasks.wait();
+}
+
+//
+// load at once the payloads valid at iTime for all records, instead of one at a time when first accessed:
+// the proxies of each connection are split among up to m_concurrentLoads sessions, each one used by a single task.
+// Any error is left to be reported by the usual loading in the DataProxy.
+//
+void
+CondDBESSource::loadPayloads( const edm::IOVSyncValue& iTime ) {
+  // the background loading uses the same proxies and sessions
+  waitForPrefetch();
+
+  ProxiesByConnection proxies;
+  for( auto const & entry: m_proxies ) {
+    cond::persistency::BasePayloadProxy & proxy = * entry.second->proxy();
+    cond::Time_t abtime = cond::time::fromIOVSyncValue( iTime, proxy.timeType() );
+    if( 0 == abtime ) continue;
+    proxy.setIntervalFor( abtime );
+    if( proxy.isValid() )
+      proxies[entry.second->connString()].push_back( &proxy );
+  }
+
+  // run iFunc on each proxy, with the sessions of its connection shared out among the tasks
+  auto forEachProxy = [this]( ProxiesByConnection const & iProxies, auto iSpawn, auto iFunc ) {
+    for( auto const & entry: iProxies ) {
+      std::vector<cond::persistency::Session> & sessions = loadSessions( entry.first );
+      std::vector<cond::persistency::BasePayloadProxy*> const & list = entry.second;
+      unsigned int nTasks = std::min<unsigned int>( sessions.size(), list.size() );
+      for( unsigned int task = 0; task < nTasks; ++task ) {
+        cond::persistency::Session session = sessions[task];
+        iSpawn( [&list, session, task, nTasks, iFunc]() {
+          for( unsigned int i = task; i < list.size(); i += nTasks ) {
+            try {
+              iFunc( *list[i], session );
+            } catch( std::exception const & e ) {
+              edm::LogInfo( "CondDBESSource" ) << "Failed to load a payload in advance: " << e.what()
+                                               << "; it will be loaded when first accessed";
+            } catch( ... ) {
+              edm::LogInfo( "CondDBESSource" ) << "Failed to load a payload in advance; it will be loaded when first accessed";
+            }
+          }
+        } );
+      }
+    }
+  };
+
+  tbb::task_group group;
+  forEachProxy( proxies,
+                [&group]( auto iTask ) { group.run( iTask ); },
+                []( cond::persistency::BasePayloadProxy & iProxy, cond::persistency::Session iSession ) { iProxy.prefetch( iSession ); } );
+  group.wait();
+
+  if( !m_prefetchNextIOV ) return;
+
+  // the lists of proxies must outlive the background tasks, until the next call to waitForPrefetch()
+  m_nextProxies.clear();
+  for( auto const & entry: proxies ) {
+    for( auto proxy: entry.second )
+      if( proxy->prepareNext() )
+        m_nextProxies[entry.first].push_back( proxy );
+  }
+  forEachProxy( m_nextProxies,
+                [this]( auto iTask ) { m_prefetchTasks.run( iTask ); },
+                []( cond::persistency::BasePayloadProxy & iProxy, cond::persistency::Session iSession ) { iProxy.prefetchNext( iSession ); } );
+}
+
 //required by EventSetup System
 void 
 CondDBESSource::registerProxies(const edm::eventsetup::EventSetupRecordKey& iRecordKey , KeyedProxies& aProxyList) {
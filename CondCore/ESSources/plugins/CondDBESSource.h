@@ -15,11 +15,14 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
+#include "tbb/task_group.h"
 // user include files
 #include "CondCore/CondDB/interface/ConnectionPool.h"
 
 #include "FWCore/Framework/interface/DataProxyProvider.h"
 #include "FWCore/Framework/interface/EventSetupRecordIntervalFinder.h"
+#include "FWCore/Framework/interface/IOVSyncValue.h"
 //#include "CondCore/DBCommon/interface/Time.h"
 
 namespace edm{
@@ -28,6 +31,9 @@ namespace edm{
 
 namespace cond{
   class DataProxyWrapperBase;
+  namespace persistency {
+    class BasePayloadProxy;
+  }
 }
 
 class CondDBESSource : public edm::eventsetup::DataProxyProvider,
@@ -87,8 +93,30 @@ class CondDBESSource : public edm::eventsetup::DataProxyProvider,
   
   bool m_doDump;
 
+  // concurrent loading of the payloads: when more than one, all the payloads valid for a new
+  // IOV are loaded at once, using up to this number of sessions for each connection
+  unsigned int m_concurrentLoads;
+  // optionally load in the background the payloads of the following IOVs
+  bool m_prefetchNextIOV;
+  edm::IOVSyncValue m_lastLoadTime;
+  std::map<std::string, std::vector<cond::persistency::Session> > m_loadSessions;
+  // the background loading runs as tasks of the job, within its number of threads
+  tbb::task_group m_prefetchTasks;
+
+  typedef std::map<std::string, std::vector<cond::persistency::BasePayloadProxy*> > ProxiesByConnection;
+  ProxiesByConnection m_nextProxies;
+
  private:
 
+  // load the payloads of all records valid for iTime, and optionally start prefetching the next ones
+  void loadPayloads( const edm::IOVSyncValue& iTime );
+
+  // the sessions used to load concurrently the payloads from the given connection
+  std::vector<cond::persistency::Session> & loadSessions( const std::string & connectionString );
+
+  // wait for the background loading of the payloads of the next IOVs
+  void waitForPrefetch();
+
   void fillList(const std::string & pfn, std::vector<std::string> & pfnList, const unsigned int listSize, const std::string & type);
 
   void fillTagCollectionFromGT(const std::string & connectionString,
@@ -36,6 +36,8 @@
        virtual ~GBRForest();
        
        double GetResponse(const float* vector) const;
+       //responses to nvectors input vectors, stride floats apart, evaluated tree by tree
+       void GetResponses(const float* vectors, unsigned int nvectors, unsigned int stride, double* responses) const;
        double GetGradBoostClassifier(const float* vector) const;
        double GetAdaBoostClassifier(const float* vector) const { return GetResponse(vector); }
        
@@ -64,6 +66,18 @@ inline double GBRForest::GetResponse(const float* vector) const {
   return response;
 }
 
+//_______________________________________________________________________
+inline void GBRForest::GetResponses(const float* vectors, unsigned int nvectors, unsigned int stride, double* responses) const {
+  //each tree is applied to all the vectors in turn, while its nodes are in cache;
+  //the responses are summed in the same order as in GetResponse
+  for (unsigned int i=0; i<nvectors; ++i) responses[i] = fInitialResponse;
+  for (std::vector<GBRTree>::const_iterator it=fTrees.begin(); it!=fTrees.end(); ++it) {
+    for (unsigned int i=0; i<nvectors; ++i) {
+      responses[i] += it->GetResponse(vectors + i*stride);
+    }
+  }
+}
+
 //_______________________________________________________________________
 inline double GBRForest::GetGradBoostClassifier(const float* vector) const {
   double response = GetResponse(vector);
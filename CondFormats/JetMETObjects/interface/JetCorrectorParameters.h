@@ -89,6 +89,8 @@ class JetCorrectorParameters
     unsigned size()                                              const {return mRecords.size();}
     unsigned size(unsigned fVar)                                 const;
     int binIndex(const std::vector<float>& fX)                   const;
+    int binIndex(const std::vector<float>& fX, const std::vector<float>& fLowEdges) const;
+    std::vector<float> orderedBinLowEdges()                      const;
     int neighbourBin(unsigned fIndex, unsigned fVar, bool fNext) const;
     std::vector<float> binCenters(unsigned fVar)                 const;
     void printScreen()                                           const;
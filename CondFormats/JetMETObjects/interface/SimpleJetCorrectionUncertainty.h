@@ -24,6 +24,7 @@ class SimpleJetCorrectionUncertainty
   float uncertaintyBin(unsigned fBin, float fY, bool fDirection) const;
   float linearInterpolation (float fZ, const float fX[2], const float fY[2]) const;
   JetCorrectorParameters* mParameters;
+  std::vector<float> mBinLowEdges; // for the binary search of the bin
 };
 
 #endif
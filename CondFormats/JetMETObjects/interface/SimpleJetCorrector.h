@@ -36,6 +36,7 @@ class SimpleJetCorrector
   reco::FormulaEvaluator  mFunc;
   unsigned                mInvertVar; 
   bool                    mDoInterpolation;
+  std::vector<float>      mBinLowEdges; // for the binary search of the bin
 };
 
 #endif
@@ -183,6 +183,39 @@ int JetCorrectorParameters::binIndex(const std::vector<float>& fX) const
   return result;
 }
 //------------------------------------------------------------------------
+//--- same as binIndex(fX), with a binary search over the low edges ------
+//--- returned by orderedBinLowEdges() if there are some -----------------
+//------------------------------------------------------------------------
+int JetCorrectorParameters::binIndex(const std::vector<float>& fX, const std::vector<float>& fLowEdges) const
+{
+  if (fLowEdges.empty() || fX.size() != 1)
+    return binIndex(fX);
+  auto it = std::upper_bound(fLowEdges.begin(),fLowEdges.end(),fX[0]);
+  if (it == fLowEdges.begin())
+    return -1;
+  unsigned bin = (it - fLowEdges.begin()) - 1;
+  return (fX[0] < record(bin).xMax(0)) ? int(bin) : -1;
+}
+//------------------------------------------------------------------------
+//--- the low edges of the bins if there is one bin variable and the -----
+//--- bins are ordered and do not overlap, nothing otherwise -------------
+//------------------------------------------------------------------------
+std::vector<float> JetCorrectorParameters::orderedBinLowEdges() const
+{
+  std::vector<float> result;
+  if (mDefinitions.nBinVar() != 1)
+    return result;
+  for (unsigned i = 1; i < size(); ++i)
+    {
+      if (record(i).xMin(0) < record(i-1).xMin(0) || record(i).xMin(0) < record(i-1).xMax(0))
+        return result;
+    }
+  result.reserve(size());
+  for (unsigned i = 0; i < size(); ++i)
+    result.push_back(record(i).xMin(0));
+  return result;
+}
+//------------------------------------------------------------------------
 //--- returns the neighbouring bins of fIndex in the direction of fVar ---
 //------------------------------------------------------------------------
 int JetCorrectorParameters::neighbourBin(unsigned fIndex, unsigned fVar, bool fNext) const
@@ -360,14 +360,13 @@ namespace JME {
         const Record* good_record = nullptr;
         for (const auto& record: m_records) {
 
-            // Iterate over bins
+            // Iterate over bins, until one is not valid
             size_t valid_bins = 0;
-            size_t current_bin = 0;
             for (const auto& bin: record.getBinsRange()) {
-                if (bin.is_inside(bins[current_bin]))
-                    valid_bins++;
+                if (! bin.is_inside(bins[valid_bins]))
+                    break;
 
-                current_bin++;
+                valid_bins++;
             }
 
             if (valid_bins == m_definition.nBins()) {
@@ -13,11 +13,13 @@ SimpleJetCorrectionUncertainty::SimpleJetCorrectionUncertainty ()
 SimpleJetCorrectionUncertainty::SimpleJetCorrectionUncertainty(const std::string& fDataFile)  
 {
   mParameters = new JetCorrectorParameters(fDataFile);
+  mBinLowEdges = mParameters->orderedBinLowEdges();
 }
 /////////////////////////////////////////////////////////////////////////
 SimpleJetCorrectionUncertainty::SimpleJetCorrectionUncertainty(const JetCorrectorParameters& fParameters)  
 {
   mParameters = new JetCorrectorParameters(fParameters);
+  mBinLowEdges = mParameters->orderedBinLowEdges();
 }
 /////////////////////////////////////////////////////////////////////////
 SimpleJetCorrectionUncertainty::~SimpleJetCorrectionUncertainty () 
@@ -28,7 +30,7 @@ SimpleJetCorrectionUncertainty::~SimpleJetCorrectionUncertainty ()
 float SimpleJetCorrectionUncertainty::uncertainty(const std::vector<float>& fX, float fY, bool fDirection) const 
 {
   float result = 1.;
-  int bin = mParameters->binIndex(fX);
+  int bin = mParameters->binIndex(fX,mBinLowEdges);
   if (bin<0) {
     edm::LogError("SimpleJetCorrectionUncertainty")<<" bin variables out of range";
     result = -999.0;
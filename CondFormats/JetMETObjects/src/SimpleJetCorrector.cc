@@ -16,6 +16,7 @@ SimpleJetCorrector::SimpleJetCorrector(const std::string& fDataFile, const std::
   mDoInterpolation = false;
   if (mParameters.definitions().isResponse())
     mInvertVar = findInvertVar();
+  mBinLowEdges = mParameters.orderedBinLowEdges();
 }
 //------------------------------------------------------------------------
 //--- SimpleJetCorrector constructor -------------------------------------
@@ -28,6 +29,7 @@ SimpleJetCorrector::SimpleJetCorrector(const JetCorrectorParameters& fParameters
   mDoInterpolation = false;
   if (mParameters.definitions().isResponse())
     mInvertVar = findInvertVar();
+  mBinLowEdges = mParameters.orderedBinLowEdges();
 }
 
 //------------------------------------------------------------------------
@@ -38,7 +40,7 @@ float SimpleJetCorrector::correction(const std::vector<float>& fX,const std::vec
   float result = 1.;
   float tmp    = 0.0;
   float cor    = 0.0;
-  int bin = mParameters.binIndex(fX);
+  int bin = mParameters.binIndex(fX,mBinLowEdges);
   if (bin<0)
     return result;
   if (!mDoInterpolation)
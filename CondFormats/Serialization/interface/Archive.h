@@ -6,6 +6,8 @@
 #include "boost/archive/xml_iarchive.hpp"
 #include "boost/archive/xml_oarchive.hpp"
 #include "boost/archive/xml_oarchive.hpp"
+#include "boost/archive/binary_iarchive.hpp"
+#include "boost/archive/binary_oarchive.hpp"
 
 #include "CondFormats/Serialization/interface/eos/portable_iarchive.hpp"
 #include "CondFormats/Serialization/interface/eos/portable_oarchive.hpp"
@@ -19,6 +21,13 @@ namespace serialization {
   typedef boost::archive::xml_iarchive InputArchiveXML;
   typedef boost::archive::xml_oarchive OutputArchiveXML;
 
+  // Native binary archives: the arrays and vectors of arithmetic types are
+  // written as single blocks and read back with one copy from the blob.
+  // The data are readable only on platforms with the same endianness and
+  // type sizes, recorded with the payload (cond::StreamerInfo::binaryArchitecture).
+  typedef boost::archive::binary_iarchive InputArchiveBinary;
+  typedef boost::archive::binary_oarchive OutputArchiveBinary;
+
 }
 }
 
@@ -8,7 +8,9 @@
     template void __VA_ARGS__::serialize<cond::serialization::InputArchive    >(cond::serialization::InputArchive     & ar, const unsigned int); \
     template void __VA_ARGS__::serialize<cond::serialization::OutputArchive   >(cond::serialization::OutputArchive    & ar, const unsigned int); \
     template void __VA_ARGS__::serialize<cond::serialization::InputArchiveXML >(cond::serialization::InputArchiveXML  & ar, const unsigned int); \
-    template void __VA_ARGS__::serialize<cond::serialization::OutputArchiveXML>(cond::serialization::OutputArchiveXML & ar, const unsigned int);
+    template void __VA_ARGS__::serialize<cond::serialization::OutputArchiveXML>(cond::serialization::OutputArchiveXML & ar, const unsigned int); \
+    template void __VA_ARGS__::serialize<cond::serialization::InputArchiveBinary >(cond::serialization::InputArchiveBinary  & ar, const unsigned int); \
+    template void __VA_ARGS__::serialize<cond::serialization::OutputArchiveBinary>(cond::serialization::OutputArchiveBinary & ar, const unsigned int);
 
 // Polymorphic classes must be registered as such
 #define COND_SERIALIZATION_REGISTER_POLYMORPHIC(T) \
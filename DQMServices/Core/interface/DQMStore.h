@@ -581,6 +581,9 @@ class DQMStore
   // ---------------- Navigation -----------------------
   bool                          cdInto(const std::string &path) const;
 
+  // ---------------- Quality tests -----------------------
+  void                          runQTestsInParallel(void);
+
   // ------------------- Reference ME -------------------------------
   bool                          isCollateME(MonitorElement *me) const;
 
@@ -702,6 +705,7 @@ class DQMStore
   double                        scaleFlag_;
   bool                          collateHistograms_;
   bool                          enableMultiThread_;
+  bool                          parallelQTests_;
   bool                          LSbasedMode_;
   bool                          forceResetOnBeginLumi_;
   std::string                   readSelectedDirectory_;
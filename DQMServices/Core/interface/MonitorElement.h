@@ -333,6 +333,8 @@ private:
   void addQReport(const DQMNet::QValue &desc, QCriterion *qc);
   void addQReport(QCriterion *qc);
   void updateQReportStats(void);
+  bool runQTest(size_t i, bool dirty);
+  void flushBuffers(void);
 
 public:
   TObject *getRootObject(void) const;
@@ -673,9 +673,19 @@ DQMNet::onMessage(Bucket *msg, Peer *p, unsigned char *data, size_t len)
       if (! o)
 	o = makeObject(p, name);
 
-      o->flags = words[2] | DQM_PROP_NEW | DQM_PROP_RECEIVED;
+      // An object listed again at the version of the data we already
+      // have has not changed: keep the data, do not fetch it again and
+      // do not pass it on to our own peers as a new object.
+      uint64_t version = ((uint64_t) words[4] << 32 | words[3]);
+      bool unchanged = (o->version == version
+			&& ! (o->flags & DQM_PROP_STALE)
+			&& (! o->rawdata.empty()
+			    || (words[2] & DQM_PROP_TYPE_MASK) <= DQM_PROP_TYPE_SCALAR));
+
+      o->flags = words[2] | DQM_PROP_RECEIVED
+		 | (unchanged ? (o->flags & DQM_PROP_NEW) : DQM_PROP_NEW);
       o->tag = words[5];
-      o->version = ((uint64_t) words[4] << 32 | words[3]);
+      o->version = version;
       o->scalar.clear();
       o->qdata.clear();
       if ((o->flags & DQM_PROP_TYPE_MASK) <= DQM_PROP_TYPE_SCALAR)
@@ -688,7 +698,7 @@ DQMNet::onMessage(Bucket *msg, Peer *p, unsigned char *data, size_t len)
 	o->rawdata.clear();
         o->rawdata.insert(o->rawdata.end(), objdata, qdata);
       }
-      else if (! o->rawdata.empty())
+      else if (! unchanged && ! o->rawdata.empty())
 	o->flags |= DQM_PROP_STALE;
       o->qdata.insert(o->qdata.end(), qdata, enddata);
 
@@ -696,6 +706,7 @@ DQMNet::onMessage(Bucket *msg, Peer *p, unsigned char *data, size_t len)
       // update without data, issue an immediate data get request.
       if (o->lastreq
 	  && ! datalen
+	  && ! unchanged
 	  && (o->flags & DQM_PROP_TYPE_MASK) > DQM_PROP_TYPE_SCALAR)
 	requestObjectData(p, (namelen ? &name[0] : 0), namelen);
 
@@ -1467,6 +1478,20 @@ DQMBasicNet::updateLocalObject(Object &o)
     // need to change the non-key parts of the object. Erasing
     // and re-inserting would produce too much memory churn.
     Object &old = const_cast<Object &>(*info.first);
+
+    // An object updated to the same content as before keeps its version
+    // and is not advertised again, so the peers do not fetch it again.
+    const uint32_t keep = ~(DQM_PROP_NEW | DQM_PROP_DEAD);
+    if ((old.flags & keep) == (o.flags & keep)
+	&& old.tag == o.tag
+	&& old.rawdata == o.rawdata
+	&& old.scalar == o.scalar
+	&& old.qdata == o.qdata)
+    {
+      o.version = old.version;
+      o.flags = (o.flags & ~DQM_PROP_NEW) | (old.flags & DQM_PROP_NEW);
+    }
+
     std::swap(old.flags,     o.flags);
     std::swap(old.tag,       o.tag);
     std::swap(old.version,   o.version);
@@ -19,6 +19,9 @@
 #include <iterator>
 #include <cerrno>
 #include <boost/algorithm/string.hpp>
+#if !WITHOUT_CMS_FRAMEWORK
+#include "tbb/parallel_for.h"
+#endif
 
 #include <fstream>
 #include <sstream>
@@ -370,6 +373,12 @@ void DQMStore::mergeAndResetMEsRunSummaryCache(uint32_t run,
     return;
   }
 
+  // Both the scan of the local MEs and the merge into the global ones
+  // access the data, so the whole operation must be locked. Taking the
+  // lock once per module and stream, rather than once per ME, keeps the
+  // contention low when many modules end the run at the same time.
+  std::lock_guard<std::mutex> guard(book_mutex_);
+
   std::string null_str("");
   MonitorElement proto(&null_str, null_str, run, streamId, moduleId);
   std::set<MonitorElement>::const_iterator e = data_.end();
@@ -391,9 +400,6 @@ void DQMStore::mergeAndResetMEsRunSummaryCache(uint32_t run,
     MonitorElement global_me(*i, MonitorElementNoCloneTag());
     global_me.globalize();
 
-    // Since this accesses the data, the operation must be
-    // be locked.
-    std::lock_guard<std::mutex> guard(book_mutex_);
     std::set<MonitorElement>::const_iterator me = data_.find(global_me);
     if (me != data_.end()) {
       if (verbose_ > 1)
@@ -437,6 +443,11 @@ void DQMStore::mergeAndResetMEsLuminositySummaryCache(uint32_t run,
               << run << 	" lumi: " << lumi
               << ", stream: " << streamId
               << " module: " << moduleId << std::endl;
+
+  // See mergeAndResetMEsRunSummaryCache: lock once for the whole set
+  // of local MEs of this module and stream.
+  std::lock_guard<std::mutex> guard(book_mutex_);
+
   std::string null_str("");
   MonitorElement proto(&null_str, null_str, run, streamId, moduleId);
   std::set<MonitorElement>::const_iterator e = data_.end();
@@ -457,9 +468,6 @@ void DQMStore::mergeAndResetMEsLuminositySummaryCache(uint32_t run,
     MonitorElement global_me(*i, MonitorElementNoCloneTag());
     global_me.globalize();
     global_me.setLumi(lumi);
-    // Since this accesses the data, the operation must be
-    // be locked.
-    std::lock_guard<std::mutex> guard(book_mutex_);
     std::set<MonitorElement>::const_iterator me = data_.find(global_me);
     if (me != data_.end()) {
       if (verbose_ > 1)
@@ -503,6 +511,7 @@ DQMStore::DQMStore(const edm::ParameterSet &pset, edm::ActivityRegistry& ar)
     reset_ (false),
     collateHistograms_ (false),
     enableMultiThread_(false),
+    parallelQTests_(false),
     forceResetOnBeginLumi_(false),
     readSelectedDirectory_ (""),
     run_(0),
@@ -539,6 +548,7 @@ DQMStore::DQMStore(const edm::ParameterSet &pset)
     reset_ (false),
     collateHistograms_ (false),
     enableMultiThread_(false),
+    parallelQTests_(false),
     readSelectedDirectory_ (""),
     run_(0),
     streamId_(0),
@@ -590,6 +600,10 @@ DQMStore::initializeFrom(const edm::ParameterSet& pset) {
   if (enableMultiThread_)
     std::cout << "DQMStore: MultiThread option is enabled\n";
 
+  parallelQTests_ = pset.getUntrackedParameter<bool>("parallelQTests", false);
+  if (parallelQTests_)
+    std::cout << "DQMStore: quality tests run in parallel\n";
+
   LSbasedMode_ = pset.getUntrackedParameter<bool>("LSbasedMode", false);
    if (LSbasedMode_)
      std::cout << "DQMStore: LSbasedMode option is enabled\n";
@@ -3365,13 +3379,75 @@ DQMStore::runQTests(void)
   // Apply quality tests to each monitor element, skipping references.
   MEMap::iterator mi = data_.begin();
   MEMap::iterator me = data_.end();
-  for ( ; mi != me; ++mi)
-    if (! isSubdirectory(s_referenceDirName, *mi->data_.dirname))
-      const_cast<MonitorElement &>(*mi).runQTests();
+  if (parallelQTests_)
+    runQTestsInParallel();
+  else
+    for ( ; mi != me; ++mi)
+      if (! isSubdirectory(s_referenceDirName, *mi->data_.dirname))
+        const_cast<MonitorElement &>(*mi).runQTests();
 
   reset_ = false;
 }
 
+/// run the quality tests as runQTests, one task per quality test: a
+/// QCriterion keeps the outcome of its last run, so each one goes through
+/// its monitor elements in turn, in the order of the store, while the
+/// different quality tests run in parallel.  The histograms are filled
+/// from their buffers before, and the monitor elements are marked updated
+/// and their report statistics updated after, one after another.
+void
+DQMStore::runQTestsInParallel(void)
+{
+  struct QTestRun
+  {
+    MonitorElement *me;
+    size_t report;
+    bool changed;
+  };
+  std::map<QCriterion *, std::vector<QTestRun> > runs;
+  std::vector<MonitorElement *> elements;
+
+  MEMap::iterator mi = data_.begin();
+  MEMap::iterator me = data_.end();
+  for ( ; mi != me; ++mi)
+  {
+    if (isSubdirectory(s_referenceDirName, *mi->data_.dirname))
+      continue;
+    MonitorElement &element = const_cast<MonitorElement &>(*mi);
+    assert(element.qreports_.size() == element.data_.qreports.size());
+    elements.push_back(&element);
+    if (! element.qreports_.empty() && element.wasUpdated())
+      element.flushBuffers();
+    for (size_t i = 0, e = element.qreports_.size(); i < e; ++i)
+      runs[element.qreports_[i].qcriterion_].push_back(QTestRun { &element, i, false });
+  }
+
+  std::vector<std::vector<QTestRun> *> tests;
+  tests.reserve(runs.size());
+  for (auto &test : runs)
+    tests.push_back(&test.second);
+
+  auto runTest = [&tests](size_t t)
+  {
+    for (auto &run : *tests[t])
+      run.changed = run.me->runQTest(run.report, run.me->wasUpdated());
+  };
+#if !WITHOUT_CMS_FRAMEWORK
+  tbb::parallel_for(size_t(0), tests.size(), runTest);
+#else
+  for (size_t t = 0; t < tests.size(); ++t)
+    runTest(t);
+#endif
+
+  for (auto test : tests)
+    for (auto &run : *test)
+      if (run.changed)
+        run.me->update();
+
+  for (auto element : elements)
+    element->updateQReportStats();
+}
+
 /// get "global" folder <path> status (one of:STATUS_OK, WARNING, ERROR, OTHER);
 /// returns most sever error, where ERROR > WARNING > OTHER > STATUS_OK;
 /// see Core/interface/QTestStatus.h for details on "OTHER"
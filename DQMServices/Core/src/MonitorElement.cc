@@ -650,29 +650,52 @@ MonitorElement::runQTests(void)
 
   // Rerun quality tests where the ME or the quality algorithm was modified.
   bool dirty = wasUpdated();
+  if (dirty)
+    flushBuffers();
   for (size_t i = 0, e = data_.qreports.size(); i < e; ++i)
-  {
-    DQMNet::QValue &qv = data_.qreports[i];
-    QReport &qr = qreports_[i];
-    QCriterion *qc = qr.qcriterion_;
-    qr.qvalue_ = &qv;
+    if (runQTest(i, dirty))
+      update();
 
-    // if (qc && (dirty || qc->wasModified()))  // removed for new QTest (abm-090503)
-    if (qc && dirty)
-    {
-      assert(qc->getName() == qv.qtname);
-      std::string oldMessage = qv.message;
-      int oldStatus = qv.code;
+  // Update QReport statistics.
+  updateQReportStats();
+}
 
-      qc->runTest(this, qr, qv);
+/// fill the histogram and the reference from their buffers, if any: the
+/// quality tests read the bins directly, and must not modify the objects
+/// they share with the tests running at the same time.
+void
+MonitorElement::flushBuffers(void)
+{
+  if (object_ && object_->GetBuffer())
+    object_->BufferEmpty();
+  if (reference_ && reference_->GetBuffer())
+    reference_->BufferEmpty();
+}
 
-      if (oldStatus != qv.code || oldMessage != qv.message)
-        update();
-    }
-  }
+/// run quality test number i, if the ME was updated; returns true if the
+/// status or the message of the test changed.  Does not touch the ME
+/// itself: the tests of different MEs can run at the same time, as long
+/// as each quality test runs on one ME at a time.
+bool
+MonitorElement::runQTest(size_t i, bool dirty)
+{
+  DQMNet::QValue &qv = data_.qreports[i];
+  QReport &qr = qreports_[i];
+  QCriterion *qc = qr.qcriterion_;
+  qr.qvalue_ = &qv;
 
-  // Update QReport statistics.
-  updateQReportStats();
+  // if (qc && (dirty || qc->wasModified()))  // removed for new QTest (abm-090503)
+  if (qc && dirty)
+  {
+    assert(qc->getName() == qv.qtname);
+    std::string oldMessage = qv.message;
+    int oldStatus = qv.code;
+
+    qc->runTest(this, qr, qv);
+
+    return oldStatus != qv.code || oldMessage != qv.message;
+  }
+  return false;
 }
 
 void
@@ -3,12 +3,70 @@
 #include "DQMServices/Core/src/QStatisticalTests.h"
 #include "DQMServices/Core/src/DQMError.h"
 #include "TMath.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
 #include <iostream>
 #include <sstream>
 #include <math.h>
 
 using namespace std;
 
+namespace
+{
+  // Bins of a TH1F, TH1S, TH1D or of their 2D versions, read straight from
+  // their arrays: these histograms are also the TArrayF, TArrayS or TArrayD
+  // of their contents.  Errors as in TH1::GetBinError for normal errors.
+  template <class T>
+  class ArrayBins
+  {
+  public:
+    ArrayBins(const T *contents, const double *sumw2)
+      : contents_(contents), sumw2_(sumw2) {}
+    double content(int bin) const
+      { return contents_[bin]; }
+    double error(int bin) const
+      { return sumw2_ ? sqrt(sumw2_[bin]) : sqrt(fabs(double(contents_[bin]))); }
+  private:
+    const T *contents_;
+    const double *sumw2_;
+  };
+
+  // Bins of any other histogram, through TH1.
+  class HistoBins
+  {
+  public:
+    explicit HistoBins(const TH1 *h) : h_(h) {}
+    double content(int bin) const
+      { return h_->GetBinContent(bin); }
+    double error(int bin) const
+      { return h_->GetBinError(bin); }
+  private:
+    const TH1 *h_;
+  };
+
+  // Calls the test kernel f with the bins of h, read from the arrays when
+  // they hold the contents and the errors as they are.  The histogram must
+  // have been filled from its buffer beforehand, see
+  // MonitorElement::flushBuffers: the tests only read it.
+  template <class F>
+  float withBins(TH1 *h, F &&f)
+  {
+    if (h->GetBinErrorOption() == TH1::kNormal
+        && ! h->InheritsFrom(TProfile::Class())
+        && ! h->InheritsFrom(TProfile2D::Class()))
+    {
+      const double *sumw2 = h->GetSumw2N() ? h->GetSumw2()->GetArray() : 0;
+      if (const TArrayF *a = dynamic_cast<const TArrayF *>(h))
+        return f(ArrayBins<Float_t>(a->GetArray(), sumw2));
+      if (const TArrayS *a = dynamic_cast<const TArrayS *>(h))
+        return f(ArrayBins<Short_t>(a->GetArray(), sumw2));
+      if (const TArrayD *a = dynamic_cast<const TArrayD *>(h))
+        return f(ArrayBins<Double_t>(a->GetArray(), sumw2));
+    }
+    return f(HistoBins(h));
+  }
+}
+
 const float QCriterion::ERROR_PROB_THRESHOLD = 0.50;
 const float QCriterion::WARNING_PROB_THRESHOLD = 0.90;
 
@@ -231,59 +289,63 @@ float Comp2RefChi2::runTest(const MonitorElement *me)
   //  }
   ndof = i_end-i_start+1-constraint;
 
-  //Compute the normalisation factor
-  double sum1=0, sum2=0;
-  for (i=i_start; i<=i_end; i++)
-  {
-    sum1 += h->GetBinContent(i);
-    sum2 += ref_->GetBinContent(i);
-  }
+  return withBins(h, [&](const auto &bins) {
+    return withBins(ref_, [&](const auto &refBins) -> float {
+      //Compute the normalisation factor
+      double sum1=0, sum2=0;
+      for (i=i_start; i<=i_end; i++)
+      {
+        sum1 += bins.content(i);
+        sum2 += refBins.content(i);
+      }
 
-  //check that the histograms are not empty
-  if (sum1 == 0)
-  {
-    if (verbose_>0) 
-      std::cout << "QTest:Comp2RefChi2"
-                << " Test Histogram " << h->GetName() 
-		<< " is empty, exiting\n";
-    return -1;
-  }
-  if (sum2 == 0)
-  {
-    if (verbose_>0) 
-      std::cout << "QTest:Comp2RefChi2"
-                << " Ref Histogram " << ref_->GetName() 
-                << " is empty, exiting\n";
-    return -1;
-  }
+      //check that the histograms are not empty
+      if (sum1 == 0)
+      {
+        if (verbose_>0) 
+          std::cout << "QTest:Comp2RefChi2"
+                    << " Test Histogram " << h->GetName() 
+                    << " is empty, exiting\n";
+        return -1;
+      }
+      if (sum2 == 0)
+      {
+        if (verbose_>0) 
+          std::cout << "QTest:Comp2RefChi2"
+                    << " Ref Histogram " << ref_->GetName() 
+                    << " is empty, exiting\n";
+        return -1;
+      }
 
-  double bin1, bin2, err1, err2, temp;
-  for (i=i_start; i<=i_end; i++)
-  {
-    bin1 = h->GetBinContent(i)/sum1;
-    bin2 = ref_->GetBinContent(i)/sum2;
-    if (bin1 ==0 && bin2==0)
-    {
-      --ndof; //no data means one less degree of freedom
-    } 
-    else 
-    {
-      temp  = bin1-bin2;
-      err1=h->GetBinError(i); err2=ref_->GetBinError(i);
-      if (err1 == 0 && err2 == 0)
+      double bin1, bin2, err1, err2, temp;
+      for (i=i_start; i<=i_end; i++)
       {
-	if (verbose_>0) 
-	  std::cout << "QTest:Comp2RefChi2"
-	            << " bins with non-zero content and zero error, exiting\n";
-	return -1;
+        bin1 = bins.content(i)/sum1;
+        bin2 = refBins.content(i)/sum2;
+        if (bin1 ==0 && bin2==0)
+        {
+          --ndof; //no data means one less degree of freedom
+        } 
+        else 
+        {
+          temp  = bin1-bin2;
+          err1=bins.error(i); err2=refBins.error(i);
+          if (err1 == 0 && err2 == 0)
+          {
+            if (verbose_>0) 
+              std::cout << "QTest:Comp2RefChi2"
+                        << " bins with non-zero content and zero error, exiting\n";
+            return -1;
+          }
+          err1*=err1      ; err2*=err2;
+          err1/=sum1*sum1 ; err2/=sum2*sum2;
+          chi2 +=temp*temp/(err1+err2);
+        }
       }
-      err1*=err1      ; err2*=err2;
-      err1/=sum1*sum1 ; err2/=sum2*sum2;
-      chi2 +=temp*temp/(err1+err2);
-    }
-  }
-  chi2_ = chi2;  Ndof_ = ndof;
-  return TMath::Prob(0.5*chi2, int(0.5*ndof));
+      chi2_ = chi2;  Ndof_ = ndof;
+      return TMath::Prob(0.5*chi2, int(0.5*ndof));
+    });
+  });
 }
 
 //-------------------------------------------------------//
@@ -522,23 +584,25 @@ float ContentsXRange::runTest(const MonitorElement*me)
   int first = 0; // 1
   // use overflow bin
   int last  = ncx+1; // ncx
-  // all entries
-  double sum = 0;
-  // entries outside X-range
-  double fail = 0;
-  int bin;
-  for (bin = first; bin <= last; ++bin)
-  {
-    double contents = h->GetBinContent(bin);
-    double x = h->GetBinCenter(bin);
-    sum += contents;
-    if (x < xmin_ || x > xmax_)fail += contents;
-  }
-
-  if (sum==0) return 1;
-  // return fraction of entries within allowed X-range
-  return (sum - fail)/sum; 
+  const TAxis *axis = h->GetXaxis();
+  return withBins(h, [&](const auto &bins) -> float {
+    // all entries
+    double sum = 0;
+    // entries outside X-range
+    double fail = 0;
+    int bin;
+    for (bin = first; bin <= last; ++bin)
+    {
+      double contents = bins.content(bin);
+      double x = axis->GetBinCenter(bin);
+      sum += contents;
+      if (x < xmin_ || x > xmax_)fail += contents;
+    }
 
+    if (sum==0) return 1;
+    // return fraction of entries within allowed X-range
+    return (sum - fail)/sum; 
+  });
 }
 
 //-----------------------------------------------------//
@@ -687,21 +751,23 @@ float DeadChannel::runTest(const MonitorElement*me)
     int last  = ncx;
     int bin;
 
-    /// loop over all channels
-    for (bin = first; bin <= last; ++bin)
-    {
-      double contents = h1->GetBinContent(bin);
-      bool failure = false;
-      failure = contents <= ymin_; // dead channel: equal to or less than ymin_
-      if (failure)
-      { 
-        DQMChannel chan(bin, 0, 0, contents, h1->GetBinError(bin));
-        badChannels_.push_back(chan);
-        ++fail;
+    return withBins(h1, [&](const auto &bins) -> float {
+      /// loop over all channels
+      for (bin = first; bin <= last; ++bin)
+      {
+        double contents = bins.content(bin);
+        bool failure = false;
+        failure = contents <= ymin_; // dead channel: equal to or less than ymin_
+        if (failure)
+        { 
+          DQMChannel chan(bin, 0, 0, contents, bins.error(bin));
+          badChannels_.push_back(chan);
+          ++fail;
+        }
       }
-    }
-    //return fraction of alive channels
-    return 1.*(ncx - fail)/ncx;
+      //return fraction of alive channels
+      return 1.*(ncx - fail)/ncx;
+    });
   }
   //----------------------------------------------------------//
  
@@ -711,24 +777,27 @@ float DeadChannel::runTest(const MonitorElement*me)
     int ncx = h2->GetXaxis()->GetNbins(); // get X bins
     int ncy = h2->GetYaxis()->GetNbins(); // get Y bins
 
-    /// loop over all bins 
-    for (int cx = 1; cx <= ncx; ++cx)
-    {
-      for (int cy = 1; cy <= ncy; ++cy)
+    return withBins(h2, [&](const auto &bins) -> float {
+      /// loop over all bins 
+      for (int cx = 1; cx <= ncx; ++cx)
       {
-	double contents = h2->GetBinContent(h2->GetBin(cx, cy));
-	bool failure = false;
-	failure = contents <= ymin_; // dead channel: equal to or less than ymin_
-	if (failure)
-	{ 
-          DQMChannel chan(cx, cy, 0, contents, h2->GetBinError(h2->GetBin(cx, cy)));
-          badChannels_.push_back(chan);
-          ++fail;
-	}
+        for (int cy = 1; cy <= ncy; ++cy)
+        {
+          const int bin = cx + (ncx+2)*cy; // as TH2::GetBin
+          double contents = bins.content(bin);
+          bool failure = false;
+          failure = contents <= ymin_; // dead channel: equal to or less than ymin_
+          if (failure)
+          { 
+            DQMChannel chan(cx, cy, 0, contents, bins.error(bin));
+            badChannels_.push_back(chan);
+            ++fail;
+          }
+        }
       }
-    }
-    //return fraction of alive channels
-    return 1.*(ncx*ncy - fail) / (ncx*ncy);
+      //return fraction of alive channels
+      return 1.*(ncx*ncy - fail) / (ncx*ncy);
+    });
   }
   else 
   {
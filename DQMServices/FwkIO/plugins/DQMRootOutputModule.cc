@@ -22,9 +22,12 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TString.h"
+#include "TBufferFile.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TH3.h"
 #include "TProfile.h"
+#include "TProfile2D.h"
 
 // user include files
 #include "FWCore/Framework/interface/one/OutputModule.h"
@@ -36,6 +39,7 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/MessageLogger/interface/JobReport.h"
 #include "FWCore/Utilities/interface/Digest.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/GlobalIdentifier.h"
 
 #include "DataFormats/Provenance/interface/ProcessHistory.h"
@@ -50,6 +54,10 @@ namespace {
   public:
     TreeHelperBase(): m_wasFilled(false), m_firstIndex(0),m_lastIndex(0) {}
     virtual ~TreeHelperBase(){}
+    // elements are stored one per entry, unless the helper groups them
+    virtual void add(MonitorElement* iElement) { fill(iElement); }
+    // writes the elements added but not yet stored
+    virtual void flush() {}
     void fill(MonitorElement* iElement) {
       doFill(iElement);
       if(m_wasFilled) {++m_lastIndex;}
@@ -172,6 +180,142 @@ namespace {
     std::string* m_bufferPtr;
   };
 
+  //Used for file format version 2: each entry of the TTree is a chunk holding
+  // the elements of one directory, so the reader can merge a whole directory
+  // at a time. Histograms other than profiles are stored as their bin contents and
+  // statistics followed by an empty copy of the histogram, used only when the
+  // reader has no matching element to add the bins to.
+  class ChunkTreeHelper : public TreeHelperBase {
+  public:
+    ChunkTreeHelper(TTree* iTree, unsigned int iTypeIndex, unsigned int iMaxChunkSize):
+    m_tree(iTree), m_typeIndex(iTypeIndex), m_maxChunkSize(iMaxChunkSize),
+    m_directoryPtr(&m_directory), m_namesPtr(&m_names), m_flagsPtr(&m_flags), m_dataPtr(&m_data),
+    m_buffer(TBuffer::kWrite), m_objectBuffer(TBuffer::kWrite)
+    {setup();}
+
+    virtual void add(MonitorElement* iElement) override {
+      if(not m_names.empty() and
+         (iElement->getPathname() != m_directory or
+          static_cast<unsigned int>(m_buffer.Length()) >= m_maxChunkSize)) {
+        flush();
+      }
+      if(m_names.empty()) {
+        m_directory = iElement->getPathname();
+      }
+      m_names.push_back(iElement->getName());
+      m_flags.push_back(iElement->getTag());
+      serialize(iElement);
+    }
+
+    virtual void flush() override {
+      if(not m_names.empty()) {
+        fill(nullptr);
+      }
+    }
+
+  private:
+    void setup() {
+      m_tree->Branch(kChunkDirectoryBranch,&m_directoryPtr);
+      m_tree->Branch(kChunkNamesBranch,&m_namesPtr);
+      m_tree->Branch(kFlagBranch,&m_flagsPtr);
+      m_tree->Branch(kChunkDataBranch,&m_dataPtr,4*1024*1024);
+    }
+
+    virtual void doFill(MonitorElement*) override {
+      m_data.assign(m_buffer.Buffer(),m_buffer.Buffer()+m_buffer.Length());
+      m_tree->Fill();
+      m_names.clear();
+      m_flags.clear();
+      m_buffer.Reset();
+    }
+
+    void serialize(MonitorElement* iElement) {
+      switch(m_typeIndex) {
+        case kIntIndex: {
+          Long64_t value = iElement->getIntValue();
+          m_buffer << value;
+          break;
+        }
+        case kFloatIndex: {
+          Double_t value = iElement->getFloatValue();
+          m_buffer << value;
+          break;
+        }
+        case kStringIndex: {
+          std::string value = iElement->getStringValue();
+          m_buffer.WriteStdString(&value);
+          break;
+        }
+        case kTProfileIndex:
+        case kTProfile2DIndex:
+          writeObject(iElement->getRootObject());
+          break;
+        default:
+          writeHistogram(iElement->getTH1());
+      }
+    }
+
+    void writeObject(TObject* iObject) {
+      m_objectBuffer.Reset();
+      m_objectBuffer.WriteObjectAny(iObject,iObject->IsA());
+      Int_t length = m_objectBuffer.Length();
+      m_buffer << length;
+      m_buffer.WriteFastArray(m_objectBuffer.Buffer(),length);
+    }
+
+    void writeHistogram(TH1* iHist) {
+      TAxis* axes[3] = {iHist->GetXaxis(),iHist->GetYaxis(),iHist->GetZaxis()};
+      UChar_t mergeFlags = iHist->CanExtendAllAxes() ? kChunkCanExtend : 0;
+      for(TAxis* axis : axes) {
+        if(axis->GetLabels()) { mergeFlags |= kChunkHasLabels; }
+        if(axis->GetXbins()->GetSize()) { mergeFlags |= kChunkVariableBins; }
+      }
+      m_buffer << mergeFlags;
+      for(TAxis* axis : axes) {
+        Int_t nBins = axis->GetNbins();
+        m_buffer << nBins << axis->GetXmin() << axis->GetXmax();
+      }
+      Int_t nCells = iHist->GetNcells();
+      m_buffer << nCells;
+      m_values.resize(nCells);
+      for(Int_t i = 0; i < nCells; ++i) {
+        m_values[i] = iHist->GetBinContent(i);
+      }
+      m_buffer.WriteFastArray(&m_values[0],nCells);
+      Int_t nSumw2 = iHist->GetSumw2N();
+      m_buffer << nSumw2;
+      if(nSumw2) {
+        m_buffer.WriteFastArray(iHist->GetSumw2()->GetArray(),nSumw2);
+      }
+      Double_t stats[TH1::kNstat] = {0};
+      iHist->GetStats(stats);
+      m_buffer.WriteFastArray(stats,TH1::kNstat);
+      Double_t entries = iHist->GetEntries();
+      m_buffer << entries;
+
+      //the copy keeps the binning, labels, titles and options but no contents
+      std::unique_ptr<TH1> empty(static_cast<TH1*>(iHist->Clone()));
+      empty->SetDirectory(nullptr);
+      empty->Reset("ICES");
+      writeObject(empty.get());
+    }
+
+    TTree* m_tree;
+    unsigned int m_typeIndex;
+    unsigned int m_maxChunkSize;
+    std::string m_directory;
+    std::string* m_directoryPtr;
+    std::vector<std::string> m_names;
+    std::vector<std::string>* m_namesPtr;
+    std::vector<uint32_t> m_flags;
+    std::vector<uint32_t>* m_flagsPtr;
+    std::vector<char> m_data;
+    std::vector<char>* m_dataPtr;
+    std::vector<Double_t> m_values;
+    TBufferFile m_buffer;
+    TBufferFile m_objectBuffer;
+  };
+
 }
 
 namespace edm {
@@ -210,6 +354,8 @@ private:
   ULong64_t m_firstIndex;
   ULong64_t m_lastIndex;
   unsigned int m_filterOnRun;
+  unsigned int m_fileFormatVersion;
+  unsigned int m_maxChunkSize;
   bool m_enableMultiThread;
 
   std::string m_fullNameBuffer;
@@ -276,10 +422,16 @@ m_file(0),
 m_treeHelpers(kNIndicies,boost::shared_ptr<TreeHelperBase>()),
 m_presentHistoryIndex(0),
 m_filterOnRun(pset.getUntrackedParameter<unsigned int>("filterOnRun",0)),
+m_fileFormatVersion(pset.getUntrackedParameter<unsigned int>("fileFormatVersion",kFileFormatVersion1)),
+m_maxChunkSize(pset.getUntrackedParameter<unsigned int>("maxChunkSize",8*1024*1024)),
 m_enableMultiThread(false),
 m_fullNameBufferPtr(&m_fullNameBuffer),
 m_indicesTree(0)
 {
+  if(m_fileFormatVersion != kFileFormatVersion1 and m_fileFormatVersion != kFileFormatVersion2) {
+    throw cms::Exception("Configuration")<<"DQMRootOutputModule: unknown fileFormatVersion "<<m_fileFormatVersion
+                                         <<", allowed values are "<<kFileFormatVersion1<<" and "<<kFileFormatVersion2;
+  }
 }
 
 // DQMRootOutputModule::DQMRootOutputModule(const DQMRootOutputModule& rhs)
@@ -326,7 +478,7 @@ DQMRootOutputModule::openFile(edm::FileBlock const&)
   //NOTE: I need to also set the I/O performance settings
 
   m_file = std::auto_ptr<TFile>(new TFile(m_fileName.c_str(),"RECREATE",
-                                "1" //This is the file format version number
+                                std::to_string(m_fileFormatVersion).c_str() //This is the file format version number
                                 ));
 
   edm::Service<edm::JobReport> jr;
@@ -360,7 +512,11 @@ DQMRootOutputModule::openFile(edm::FileBlock const&)
   ++it,++i) {
     //std::cout <<"making "<<kTypeNames[i]<<std::endl;
     TTree* tree = new TTree(kTypeNames[i],kTypeNames[i]);
-    *it = boost::shared_ptr<TreeHelperBase>(makeHelper(i,tree,m_fullNameBufferPtr));
+    if(m_fileFormatVersion == kFileFormatVersion2) {
+      *it = boost::shared_ptr<TreeHelperBase>(new ChunkTreeHelper(tree,i,m_maxChunkSize));
+    } else {
+      *it = boost::shared_ptr<TreeHelperBase>(makeHelper(i,tree,m_fullNameBufferPtr));
+    }
     tree->SetDirectory(m_file.get()); //TFile takes ownership
   }
 
@@ -421,13 +577,18 @@ DQMRootOutputModule::writeLuminosityBlock(edm::LuminosityBlockForOutput const& i
   std::vector<MonitorElement *> items(dstore->getAllContents("",
                                                              m_enableMultiThread ? m_run : 0,
                                                              m_enableMultiThread ? m_lumi : 0));
+  if(m_fileFormatVersion == kFileFormatVersion2) {
+    //chunks hold one directory each
+    std::stable_sort(items.begin(),items.end(),[](MonitorElement* iLHS, MonitorElement* iRHS) {
+      return iLHS->getPathname() < iRHS->getPathname(); });
+  }
   for(std::vector<MonitorElement*>::iterator it = items.begin(), itEnd=items.end();
       it!=itEnd;
       ++it) {
     if((*it)->getLumiFlag()) {
       std::map<unsigned int,unsigned int>::iterator itFound = m_dqmKindToTypeIndex.find((*it)->kind());
       assert(itFound !=m_dqmKindToTypeIndex.end());
-      m_treeHelpers[itFound->second]->fill(*it);
+      m_treeHelpers[itFound->second]->add(*it);
     }
   }
 
@@ -447,6 +608,7 @@ DQMRootOutputModule::writeLuminosityBlock(edm::LuminosityBlockForOutput const& i
   for(std::vector<boost::shared_ptr<TreeHelperBase> >::iterator it = m_treeHelpers.begin(), itEnd = m_treeHelpers.end();
       it != itEnd;
       ++it,++typeIndex) {
+    (*it)->flush();
     if((*it)->wasFilled()) {
       m_type = typeIndex;
       (*it)->getRangeAndReset(m_firstIndex,m_lastIndex);
@@ -482,13 +644,18 @@ void DQMRootOutputModule::writeRun(edm::RunForOutput const& iRun){
 
   std::vector<MonitorElement*> items(dstore->getAllContents("",
                                                             m_enableMultiThread ? m_run : 0));
+  if(m_fileFormatVersion == kFileFormatVersion2) {
+    //chunks hold one directory each
+    std::stable_sort(items.begin(),items.end(),[](MonitorElement* iLHS, MonitorElement* iRHS) {
+      return iLHS->getPathname() < iRHS->getPathname(); });
+  }
   for(std::vector<MonitorElement*>::iterator it = items.begin(), itEnd=items.end();
       it!=itEnd;
       ++it) {
     if(not (*it)->getLumiFlag()) {
       std::map<unsigned int,unsigned int>::iterator itFound = m_dqmKindToTypeIndex.find((*it)->kind());
       assert  (itFound !=m_dqmKindToTypeIndex.end());
-      m_treeHelpers[itFound->second]->fill(*it);
+      m_treeHelpers[itFound->second]->add(*it);
     }
   }
 
@@ -507,6 +674,7 @@ void DQMRootOutputModule::writeRun(edm::RunForOutput const& iRun){
   for(std::vector<boost::shared_ptr<TreeHelperBase> >::iterator it = m_treeHelpers.begin(), itEnd = m_treeHelpers.end();
       it != itEnd;
       ++it,++typeIndex) {
+    (*it)->flush();
     if((*it)->wasFilled()) {
       m_type = typeIndex;
       (*it)->getRangeAndReset(m_firstIndex,m_lastIndex);
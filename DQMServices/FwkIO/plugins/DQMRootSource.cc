@@ -17,12 +17,16 @@
 #include <memory>
 #include <list>
 #include <set>
+#include <cstdlib>
 #include "TFile.h"
 #include "TTree.h"
 #include "TString.h"
+#include "TBufferFile.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TH3.h"
 #include "TProfile.h"
+#include "TProfile2D.h"
 
 // user include files
 #include "FWCore/Framework/interface/InputSource.h"
@@ -297,6 +301,207 @@ namespace {
         uint32_t m_tag;
     };
 
+  //Used for file format version 2: each entry of the TTree holds the elements of one directory
+  class TreeChunkReader : public TreeReaderBase {
+      public:
+        TreeChunkReader():m_tree(0),m_directory(0),m_names(0),m_tags(0),m_data(0){
+        }
+        virtual MonitorElement* doRead(ULong64_t iIndex, DQMStore& iStore, bool iIsLumi) override {
+          m_tree->GetEntry(iIndex);
+          TBufferFile buffer(TBuffer::kRead,m_data->size(),m_data->empty() ? nullptr : &(*m_data)[0],kFALSE);
+          iStore.setCurrentFolder(*m_directory);
+          std::string fullName;
+          MonitorElement* element = 0;
+          for(size_t i = 0, iEnd = m_names->size(); i != iEnd; ++i) {
+            const std::string& name = (*m_names)[i];
+            fullName = m_directory->empty() ? name : *m_directory + "/" + name;
+            element = readElement(buffer,iStore,fullName,name.c_str(),iIsLumi);
+            uint32_t tag = (*m_tags)[i];
+            if(0!= tag) {
+              iStore.tag(element,tag);
+            }
+          }
+          return element;
+        }
+        virtual void setTree(TTree* iTree) override  {
+          m_tree = iTree;
+          m_tree->SetBranchAddress(kChunkDirectoryBranch,&m_directory);
+          m_tree->SetBranchAddress(kChunkNamesBranch,&m_names);
+          m_tree->SetBranchAddress(kFlagBranch,&m_tags);
+          m_tree->SetBranchAddress(kChunkDataBranch,&m_data);
+        }
+      protected:
+        //the objects are stored with their length, so they can be skipped
+        template<class T>
+        static std::unique_ptr<T> readObject(TBufferFile& iBuffer) {
+          Int_t length;
+          iBuffer >> length;
+          TBufferFile objectBuffer(TBuffer::kRead,length,iBuffer.Buffer()+iBuffer.Length(),kFALSE);
+          std::unique_ptr<T> object(static_cast<T*>(objectBuffer.ReadObjectAny(T::Class())));
+          iBuffer.SetBufferOffset(iBuffer.Length()+length);
+          return object;
+        }
+        static void skipObject(TBufferFile& iBuffer) {
+          Int_t length;
+          iBuffer >> length;
+          iBuffer.SetBufferOffset(iBuffer.Length()+length);
+        }
+      private:
+        //the store is already in the directory of the chunk
+        virtual MonitorElement* readElement(TBufferFile& iBuffer, DQMStore& iStore,
+                                            const std::string& iFullName, const char* iName, bool iIsLumi) = 0;
+        TTree* m_tree;
+        std::string* m_directory;
+        std::vector<std::string>* m_names;
+        std::vector<uint32_t>* m_tags;
+        std::vector<char>* m_data;
+    };
+
+  template<class T>
+    class ChunkSimpleReader : public TreeChunkReader {
+      private:
+        virtual MonitorElement* readElement(TBufferFile& iBuffer, DQMStore& iStore,
+                                            const std::string& iFullName, const char* iName, bool iIsLumi) override {
+          T value;
+          iBuffer >> value;
+          MonitorElement* element = iStore.get(iFullName);
+          if(0 == element) {
+            element = createElement(iStore,iName,value);
+            if(iIsLumi) { element->setLumiFlag();}
+          } else {
+            mergeWithElement(element,value);
+          }
+          return element;
+        }
+    };
+
+  class ChunkStringReader : public TreeChunkReader {
+      private:
+        virtual MonitorElement* readElement(TBufferFile& iBuffer, DQMStore& iStore,
+                                            const std::string& iFullName, const char* iName, bool iIsLumi) override {
+          iBuffer.ReadStdString(&m_value);
+          MonitorElement* element = iStore.get(iFullName);
+          if(0 == element) {
+            element = createElement(iStore,iName,&m_value);
+            if(iIsLumi) { element->setLumiFlag();}
+          } else {
+            mergeWithElement(element,&m_value);
+          }
+          return element;
+        }
+        std::string m_value;
+    };
+
+  template<class T>
+    class ChunkObjectReader : public TreeChunkReader {
+      private:
+        virtual MonitorElement* readElement(TBufferFile& iBuffer, DQMStore& iStore,
+                                            const std::string& iFullName, const char* iName, bool iIsLumi) override {
+          std::unique_ptr<T> object = readObject<T>(iBuffer);
+          MonitorElement* element = iStore.get(iFullName);
+          if(0 == element) {
+            element = createElement(iStore,iName,object.get());
+            if(iIsLumi) { element->setLumiFlag();}
+          } else {
+            mergeWithElement(element,object.get());
+          }
+          return element;
+        }
+    };
+
+  //Histograms are stored as their bins and statistics, which are added directly to
+  // the existing element when the binning allows it, without reading the histogram itself.
+  template<class T>
+    class ChunkHistogramReader : public TreeChunkReader {
+      private:
+        virtual MonitorElement* readElement(TBufferFile& iBuffer, DQMStore& iStore,
+                                            const std::string& iFullName, const char* iName, bool iIsLumi) override {
+          UChar_t mergeFlags;
+          iBuffer >> mergeFlags;
+          for(unsigned int axis = 0; axis != 3; ++axis) {
+            iBuffer >> m_nBins[axis] >> m_min[axis] >> m_max[axis];
+          }
+          Int_t nCells;
+          iBuffer >> nCells;
+          m_values.resize(nCells);
+          iBuffer.ReadFastArray(&m_values[0],nCells);
+          Int_t nSumw2;
+          iBuffer >> nSumw2;
+          m_sumw2.resize(nSumw2);
+          if(nSumw2) {
+            iBuffer.ReadFastArray(&m_sumw2[0],nSumw2);
+          }
+          iBuffer.ReadFastArray(m_stats,TH1::kNstat);
+          iBuffer >> m_entries;
+
+          MonitorElement* element = iStore.get(iFullName);
+          if(element && 0 == mergeFlags && canAddBins(element->getTH1())) {
+            skipObject(iBuffer);
+            addBins(element->getTH1());
+            return element;
+          }
+          std::unique_ptr<T> hist = readObject<T>(iBuffer);
+          addBins(hist.get());
+          if(0 == element) {
+            element = createElement(iStore,iName,hist.get());
+            if(iIsLumi) { element->setLumiFlag();}
+          } else {
+            mergeWithElement(element,hist.get());
+          }
+          return element;
+        }
+
+        bool canAddBins(TH1* iHist) const {
+          if(iHist->GetNcells() != static_cast<Int_t>(m_values.size()) or iHist->CanExtendAllAxes()) {
+            return false;
+          }
+          TAxis* axes[3] = {iHist->GetXaxis(),iHist->GetYaxis(),iHist->GetZaxis()};
+          for(unsigned int axis = 0; axis != 3; ++axis) {
+            if(axes[axis]->GetNbins() != m_nBins[axis] or
+               axes[axis]->GetXmin() != m_min[axis] or
+               axes[axis]->GetXmax() != m_max[axis] or
+               axes[axis]->GetLabels() or
+               axes[axis]->GetXbins()->GetSize()) {
+              return false;
+            }
+          }
+          return true;
+        }
+
+        //same as TH1::Add for histograms with the same binning
+        void addBins(TH1* iHist) const {
+          Double_t stats[TH1::kNstat];
+          iHist->GetStats(stats);
+          for(unsigned int i = 0; i != TH1::kNstat; ++i) {
+            stats[i] += m_stats[i];
+          }
+          if(not m_sumw2.empty() and 0 == iHist->GetSumw2N()) {
+            iHist->Sumw2();
+          }
+          Double_t entries = iHist->GetEntries();
+          for(size_t i = 0, iEnd = m_values.size(); i != iEnd; ++i) {
+            iHist->AddBinContent(i,m_values[i]);
+          }
+          if(iHist->GetSumw2N()) {
+            TArrayD& sumw2 = *iHist->GetSumw2();
+            const std::vector<Double_t>& toAdd = m_sumw2.empty() ? m_values : m_sumw2;
+            for(size_t i = 0, iEnd = toAdd.size(); i != iEnd; ++i) {
+              sumw2[i] += toAdd[i];
+            }
+          }
+          iHist->PutStats(stats);
+          iHist->SetEntries(entries+m_entries);
+        }
+
+        Int_t m_nBins[3];
+        Double_t m_min[3];
+        Double_t m_max[3];
+        std::vector<Double_t> m_values;
+        std::vector<Double_t> m_sumw2;
+        Double_t m_stats[TH1::kNstat];
+        Double_t m_entries;
+    };
+
 }
 
 class DQMRootSource : public edm::InputSource
@@ -390,6 +595,8 @@ class DQMRootSource : public edm::InputSource
       std::auto_ptr<TFile> m_file;
       std::vector<TTree*> m_trees;
       std::vector<boost::shared_ptr<TreeReaderBase> > m_treeReaders;
+      std::vector<boost::shared_ptr<TreeReaderBase> > m_chunkReaders;
+      unsigned int m_fileFormatVersion;
       
       std::list<unsigned int> m_orderedIndices;
       edm::ProcessHistoryID m_lastSeenReducedPHID;
@@ -449,6 +656,8 @@ DQMRootSource::DQMRootSource(edm::ParameterSet const& iPSet, const edm::InputSou
   m_presentlyOpenFileIndex(0),
   m_trees(kNIndicies,static_cast<TTree*>(0)),
   m_treeReaders(kNIndicies,boost::shared_ptr<TreeReaderBase>()),
+  m_chunkReaders(kNIndicies,boost::shared_ptr<TreeReaderBase>()),
+  m_fileFormatVersion(kFileFormatVersion1),
   m_lastSeenReducedPHID(),
   m_lastSeenRun(0),
   m_lastSeenReducedPHID2(),
@@ -479,6 +688,19 @@ DQMRootSource::DQMRootSource(edm::ParameterSet const& iPSet, const edm::InputSou
     m_treeReaders[kTH3FIndex].reset(new TreeObjectReader<TH3F>());
     m_treeReaders[kTProfileIndex].reset(new TreeObjectReader<TProfile>());
     m_treeReaders[kTProfile2DIndex].reset(new TreeObjectReader<TProfile2D>());
+
+    m_chunkReaders[kIntIndex].reset(new ChunkSimpleReader<Long64_t>());
+    m_chunkReaders[kFloatIndex].reset(new ChunkSimpleReader<double>());
+    m_chunkReaders[kStringIndex].reset(new ChunkStringReader());
+    m_chunkReaders[kTH1FIndex].reset(new ChunkHistogramReader<TH1F>());
+    m_chunkReaders[kTH1SIndex].reset(new ChunkHistogramReader<TH1S>());
+    m_chunkReaders[kTH1DIndex].reset(new ChunkHistogramReader<TH1D>());
+    m_chunkReaders[kTH2FIndex].reset(new ChunkHistogramReader<TH2F>());
+    m_chunkReaders[kTH2SIndex].reset(new ChunkHistogramReader<TH2S>());
+    m_chunkReaders[kTH2DIndex].reset(new ChunkHistogramReader<TH2D>());
+    m_chunkReaders[kTH3FIndex].reset(new ChunkHistogramReader<TH3F>());
+    m_chunkReaders[kTProfileIndex].reset(new ChunkObjectReader<TProfile>());
+    m_chunkReaders[kTProfile2DIndex].reset(new ChunkObjectReader<TProfile2D>());
   }
 }
 
@@ -695,7 +917,8 @@ void DQMRootSource::readElements() {
       ++m_presentIndexItr;
 
     if(runLumiRange.m_type != kNoTypesStored) {
-      boost::shared_ptr<TreeReaderBase> reader = m_treeReaders[runLumiRange.m_type];
+      boost::shared_ptr<TreeReaderBase> reader = (m_fileFormatVersion == kFileFormatVersion2 ?
+                                                  m_chunkReaders : m_treeReaders)[runLumiRange.m_type];
       ULong64_t index = runLumiRange.m_firstIndex;
       ULong64_t endIndex = runLumiRange.m_lastIndex+1;
       for (; index != endIndex; ++index)
@@ -818,9 +1041,15 @@ DQMRootSource::setupFile(unsigned int iIndex)
     return 0;
   }
   //Check file format version, which is encoded in the Title of the TFile
-  if(0 != strcmp(newFile->GetTitle(),"1")) {
-    edm::Exception ex(edm::errors::FileReadError);
-    ex<<"Input file "<<m_catalog.fileNames()[iIndex].c_str() <<" does not appear to be a DQM Root file.\n";
+  unsigned int fileFormatVersion = std::strtoul(newFile->GetTitle(),nullptr,10);
+  if(fileFormatVersion != kFileFormatVersion1 and fileFormatVersion != kFileFormatVersion2) {
+    if(!m_skipBadFiles) {
+      edm::Exception ex(edm::errors::FileReadError);
+      ex<<"Input file "<<m_catalog.fileNames()[iIndex].c_str() <<" does not appear to be a DQM Root file.\n";
+      ex.addContext("Opening DQM Root file");
+      throw ex;
+    }
+    return 0;
   }
   
   //Get meta Data
@@ -836,6 +1065,7 @@ DQMRootSource::setupFile(unsigned int iIndex)
     else {return 0;}
   }
   m_file = newFile; //passed all tests so now we want to use this file
+  m_fileFormatVersion = fileFormatVersion;
   TTree* parameterSetTree = dynamic_cast<TTree*>(metaDir->Get(kParameterSetTree));
   assert(0!=parameterSetTree);
 
@@ -1016,7 +1246,7 @@ DQMRootSource::setupFile(unsigned int iIndex)
     for( size_t index = 0; index < kNIndicies; ++index) {
       m_trees[index] = dynamic_cast<TTree*>(m_file->Get(kTypeNames[index]));
       assert(0!=m_trees[index]);
-      m_treeReaders[index]->setTree(m_trees[index]);
+      (m_fileFormatVersion == kFileFormatVersion2 ? m_chunkReaders : m_treeReaders)[index]->setTree(m_trees[index]);
     }
   }
   //After a file open, the framework expects to see a new 'IsRun'
@@ -19,6 +19,12 @@
 //
 
 
+//The file format version is stored as the title of the TFile
+// 1: each entry of the type TTrees is one MonitorElement
+// 2: each entry of the type TTrees is a chunk of the MonitorElements of one directory
+static const unsigned int kFileFormatVersion1 = 1;
+static const unsigned int kFileFormatVersion2 = 2;
+
 //These are the different types where each type has its own TTree
 enum TypeIndex {kIntIndex, kFloatIndex, kStringIndex,
                 kTH1FIndex, kTH1SIndex, kTH1DIndex,
@@ -35,6 +41,16 @@ static const char* const kFullNameBranch = "FullName";
 static const char* const kFlagBranch = "Flags";
 static const char* const kValueBranch = "Value";
 
+//Branches for each TTree type in format version 2, the flags use kFlagBranch
+static const char* const kChunkDirectoryBranch = "Directory";
+static const char* const kChunkNamesBranch = "Names";
+static const char* const kChunkDataBranch = "Data";
+
+//What prevents adding the bins of a histogram of a chunk directly to an existing one
+static const unsigned char kChunkHasLabels = 1;
+static const unsigned char kChunkVariableBins = 2;
+static const unsigned char kChunkCanExtend = 4;
+
 
 //Storage of Run and Lumi information
 static const char* const kIndicesTree = "Indices";
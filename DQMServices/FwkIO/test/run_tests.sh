@@ -112,6 +112,16 @@ pushd ${LOCAL_TMP_DIR}
   echo ${testConfig} ------------------------------------------------------------
   cmsRun -p ${LOCAL_TEST_DIR}/${testConfig} || die "cmsRun ${testConfig}" $?
 
+  #merging to the chunked file format
+  testConfig=merge_file1_file2_chunked_cfg.py
+  rm -f dqm_merged_file1_file2_chunked.root
+  echo ${testConfig} ------------------------------------------------------------
+  cmsRun -p ${LOCAL_TEST_DIR}/${testConfig} || die "cmsRun ${testConfig}" $?
+
+  testConfig=read_merged_file1_file2_chunked_cfg.py
+  echo ${testConfig} ------------------------------------------------------------
+  cmsRun -p ${LOCAL_TEST_DIR}/${testConfig} || die "cmsRun ${testConfig}" $?
+
   testConfig=merge_file1_file3_file2_cfg.py
   rm -f dqm_merged_file1_file3_file2.root
   echo ${testConfig} ------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include "FWCore/Utilities/interface/RegexMatch.h"
 #include "DQMStreamerReader.h"
 
+#include <algorithm>
 #include <fstream>
 #include <queue>
 #include <cstdlib>
@@ -34,6 +35,8 @@ DQMStreamerReader::DQMStreamerReader(edm::ParameterSet const& pset,
       pset.getUntrackedParameter<std::vector<std::string> >("SelectEvents");
 
   minEventsPerLs_ = pset.getUntrackedParameter<int>("minEventsPerLumi");
+  lumiTimeBudget_ = pset.getUntrackedParameter<double>("lumiTimeBudget");
+  eventTime_ = 0.;
   flagSkipFirstLumis_ = pset.getUntrackedParameter<bool>("skipFirstLumis");
   flagEndOfRunKills_ = pset.getUntrackedParameter<bool>("endOfRunKills");
   flagDeleteDatFiles_ = pset.getUntrackedParameter<bool>("deleteDatFiles");
@@ -126,6 +129,10 @@ void DQMStreamerReader::openFile_(const DQMFileIterator::LumiEntry& entry) {
 
   // our initialization
   processedEventPerLs_ = 0;
+  readEventPerLs_ = 0;
+  selectedEventPerLs_ = 0;
+  sampleCredit_ = 0.;
+  lumiStart_ = std::chrono::steady_clock::now();
 
   if (flagDeleteDatFiles_) {
     // unlink the file
@@ -139,6 +146,32 @@ void DQMStreamerReader::closeFile_(const std::string& reason) {
     file_.streamFile_ = nullptr;
 
     fiterator_.logLumiState(file_.lumi_, "close: " + reason);
+
+    // events selected but not processed, and events never read,
+    // so that the histograms of the lumi can be normalised
+    unsigned int skipped = selectedEventPerLs_ - processedEventPerLs_;
+    unsigned int unread = file_.lumi_.n_events_accepted > readEventPerLs_
+                              ? file_.lumi_.n_events_accepted - readEventPerLs_
+                              : 0;
+
+    if (skipped || unread) {
+      edm::LogInfo("DQMStreamerReader")
+          << "Lumi " << file_.lumi_.file_ls << ": processed "
+          << processedEventPerLs_ << " of " << selectedEventPerLs_
+          << " selected events, " << unread << " events were not read.";
+    }
+
+    if (mon_.isAvailable()) {
+      ptree doc;
+      std::string key =
+          boost::str(boost::format("extra.lumi_events.lumi%06d") % file_.lumi_.file_ls);
+      doc.put(key + ".read", readEventPerLs_);
+      doc.put(key + ".selected", selectedEventPerLs_);
+      doc.put(key + ".processed", processedEventPerLs_);
+      doc.put(key + ".skipped", skipped);
+      doc.put(key + ".unread", unread);
+      mon_->outputUpdate(doc);
+    }
   }
 }
 
@@ -239,7 +272,8 @@ bool DQMStreamerReader::prepareNextFile() {
     }
 
     // or if there is a next file and enough eventshas been processed.
-    if (fiterator_.lumiReady() && (processedEventPerLs_ >= minEventsPerLs_)) {
+    if (fiterator_.lumiReady() && (processedEventPerLs_ >= minEventsPerLs_) &&
+        lumiBudgetSpent_()) {
       openNextFile_();
       // we might need to open once more (if .dat is missing)
       continue;
@@ -277,8 +311,16 @@ EventMsgView const* DQMStreamerReader::prepareNextEvent() {
         // this means end of file, so close the file
         closeFile_("eof");
       } else {
+        readEventPerLs_ += 1;
+
         if (!acceptEvent(eview)) {
           continue;
+        }
+
+        selectedEventPerLs_ += 1;
+
+        if (!sampleEvent_()) {
+          continue;
         } else {
           return eview;
         }
@@ -292,12 +334,26 @@ EventMsgView const* DQMStreamerReader::prepareNextEvent() {
  * This is the actual code for checking the new event and/or deserializing it.
  */
 bool DQMStreamerReader::checkNextEvent() {
+  // the time since the previous event of the same lumi is the cost of one
+  // event, as seen from the source
+  unsigned int lumi = file_.open() ? file_.lumi_.file_ls : 0;
+  unsigned int processed = processedEventPerLs_;
+
   try {
     EventMsgView const* eview = prepareNextEvent();
     if (eview == nullptr) {
       return false;
     }
 
+    if (lumiTimeBudget_ > 0.) {
+      auto now = std::chrono::steady_clock::now();
+      if (processed > 0 && file_.lumi_.file_ls == lumi) {
+        double t = std::chrono::duration<double>(now - lastEventTime_).count();
+        eventTime_ = eventTime_ > 0. ? 0.9 * eventTime_ + 0.1 * t : t;
+      }
+      lastEventTime_ = now;
+    }
+
     // this is reachable only if eview is set
     // and the file is openned
     if (file_.streamFile_->newHeader()) {
@@ -323,6 +379,53 @@ bool DQMStreamerReader::checkNextEvent() {
   return true;
 }
 
+/**
+ * With a time budget, the current file is only left for the next one once
+ * the budget has been used, so that the events are sampled across the whole
+ * lumi instead of taking the first ones.
+ */
+bool DQMStreamerReader::lumiBudgetSpent_() const {
+  if (lumiTimeBudget_ <= 0.) return true;
+
+  auto elapsed = std::chrono::steady_clock::now() - lumiStart_;
+  return std::chrono::duration<double>(elapsed).count() >= lumiTimeBudget_;
+}
+
+/**
+ * Decide whether a selected event is processed or skipped.
+ *
+ * The events left in the file (from the json, scaled by the trigger
+ * selection seen so far) are compared with the time left in the budget,
+ * at the measured cost per event, and a fraction of them is taken,
+ * spread evenly over the rest of the file.
+ * The skipped events are not deserialized.
+ */
+bool DQMStreamerReader::sampleEvent_() {
+  if (lumiTimeBudget_ <= 0.) return true;
+  if (processedEventPerLs_ < minEventsPerLs_) return true;
+  if (eventTime_ <= 0.) return true;
+
+  auto elapsed = std::chrono::steady_clock::now() - lumiStart_;
+  double timeLeft =
+      lumiTimeBudget_ - std::chrono::duration<double>(elapsed).count();
+
+  // the next lumi is not there yet, nothing is waiting for us
+  if (timeLeft <= 0.) return true;
+
+  double eventsLeft = file_.lumi_.n_events_accepted > readEventPerLs_
+                          ? file_.lumi_.n_events_accepted - readEventPerLs_
+                          : 0.;
+  eventsLeft = (eventsLeft + 1.) * selectedEventPerLs_ / readEventPerLs_;
+
+  sampleCredit_ += std::min(1., timeLeft / (eventsLeft * eventTime_));
+  if (sampleCredit_ >= 1.) {
+    sampleCredit_ -= 1.;
+    return true;
+  }
+
+  return false;
+}
+
 /**
  * If hlt trigger selection is '*', return a boolean variable to accept all
  * events
@@ -415,6 +518,15 @@ void DQMStreamerReader::fillDescriptions(
           "does not yet exist, "
           "the number of processed events will be bigger.");
 
+  desc.addUntracked<double>("lumiTimeBudget", 0.)
+      ->setComment(
+          "Wall-clock time, in seconds, to spend on each lumisection. "
+          "If set, the events of a lumisection are sampled evenly to fit "
+          "into it, at the measured processing time per event, and the "
+          "number of events skipped is reported to the monitoring. "
+          "The next file is not opened before the time is used. "
+          "0 disables the sampling.");
+
   desc.addUntracked<bool>("skipFirstLumis", false)
       ->setComment(
           "Skip (and ignore the minEventsPerLumi parameter) for the files "
@@ -12,6 +12,7 @@
 
 #include "boost/filesystem.hpp"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -52,6 +53,8 @@ class DQMStreamerReader : public edm::StreamerInputSource {
   EventMsgView const* prepareNextEvent();
   bool prepareNextFile();
   bool acceptEvent(const EventMsgView*);
+  bool sampleEvent_();
+  bool lumiBudgetSpent_() const;
 
   bool triggerSel();
   bool matchTriggerSel(Strings const& tnames);
@@ -66,6 +69,15 @@ class DQMStreamerReader : public edm::StreamerInputSource {
   unsigned int processedEventPerLs_;
   unsigned int minEventsPerLs_;
 
+  // adaptive sampling of the events of a lumi, to fit lumiTimeBudget_ seconds
+  double lumiTimeBudget_;
+  unsigned int readEventPerLs_;
+  unsigned int selectedEventPerLs_;
+  double sampleCredit_;
+  double eventTime_;
+  std::chrono::steady_clock::time_point lumiStart_;
+  std::chrono::steady_clock::time_point lastEventTime_;
+
   bool flagSkipFirstLumis_;
   bool flagEndOfRunKills_;
   bool flagDeleteDatFiles_;
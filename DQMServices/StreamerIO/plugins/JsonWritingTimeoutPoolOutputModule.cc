@@ -12,7 +12,7 @@ namespace dqmservices {
 
 JsonWritingTimeoutPoolOutputModule::JsonWritingTimeoutPoolOutputModule(
     edm::ParameterSet const& ps)
-    : edm::one::OutputModuleBase::OutputModuleBase(ps),
+    : edm::global::OutputModuleBase::OutputModuleBase(ps),
       edm::TimeoutPoolOutputModule(ps) {
   runNumber_ = ps.getUntrackedParameter<uint32_t>("runNumber");
   outputPath_ = ps.getUntrackedParameter<std::string>("outputPath");
@@ -0,0 +1,61 @@
+#ifndef DataFormats_Common_AssociationMapToMultiAssociation_h
+#define DataFormats_Common_AssociationMapToMultiAssociation_h
+/*
+ * Conversions between the one-to-many AssociationMap's and MultiAssociation
+ *
+ * A MultiAssociation keeps all the values in a single collection and, for
+ * each key, one offset into it: a key lookup is an index and iterating over
+ * the values of a key is iterating over a sub_range, with no map nodes, no
+ * per-key vectors and no transient map to build on read.  These functions
+ * let a module fill or consume the flat form while the AssociationMap stays
+ * the form others already use.
+ *
+ *   AssociationMap<OneToMany<CKey,CVal> >              <-> MultiAssociation<RefVector<CVal> >
+ *   AssociationMap<OneToManyWithQuality<CKey,CVal,Q> > <-> MultiAssociation<std::vector<std::pair<Ref<CVal>,Q> > >
+ *
+ * Both directions need the key collection, to know its size, so the
+ * RefProd to it must be usable.
+ */
+
+#include "DataFormats/Common/interface/AssociationMap.h"
+#include "DataFormats/Common/interface/MultiAssociation.h"
+
+namespace edm {
+
+  /// The values of each key of a one-to-many AssociationMap, in the same order
+  template<typename Tag>
+  MultiAssociation<typename Tag::val_type> toMultiAssociation(AssociationMap<Tag> const& map) {
+    MultiAssociation<typename Tag::val_type> result;
+    if(map.empty()) return result;
+    auto const& keys = map.refProd().key;
+    {
+      // the FastFiller completes the offsets of 'result' when it goes out of scope
+      typename MultiAssociation<typename Tag::val_type>::FastFiller filler(result, keys.id(), keys->size());
+      // the AssociationMap is ordered by key index, as the FastFiller needs
+      for(auto const& keyVal : map) {
+        filler.setValues(keyVal.key, keyVal.val);
+      }
+    }
+    return result;
+  }
+
+  /// Inserts the values of the MultiAssociation into 'map', which must have been
+  /// constructed with the key and value collections
+  template<typename Tag>
+  void fillAssociationMap(MultiAssociation<typename Tag::val_type> const& multi, AssociationMap<Tag>& map) {
+    auto const& keys = map.refProd().key;
+    if(keys.isNull()) {
+      Exception::throwThis(errors::LogicError,
+        "fillAssociationMap needs an AssociationMap constructed with the key and value collections");
+    }
+    if(!multi.contains(keys.id())) return;
+    for(unsigned int k = 0, size = keys->size(); k != size; ++k) {
+      typename AssociationMap<Tag>::key_type key(keys, k);
+      for(auto const& val : multi.get(keys.id(), k)) {
+        map.insert(key, val);
+      }
+    }
+  }
+}
+
+#endif
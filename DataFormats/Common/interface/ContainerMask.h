@@ -86,7 +86,8 @@ namespace edm {
    
    template<typename T>
    void ContainerMask<T>::copyMaskTo(std::vector<bool>& iTo) const {
-      iTo.assign(m_mask.begin(),m_mask.end());
+      // copy assignment copies the packed words rather than bit by bit
+      iTo = m_mask;
    }
    
    template<typename T>
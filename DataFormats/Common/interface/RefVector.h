@@ -137,6 +137,11 @@ namespace edm {
     /// in the Event. No type checking is done.
     bool isAvailable() const;
 
+    /// Pointers to all the referenced items, in order. The product is
+    /// retrieved once for the whole vector, instead of once per element
+    /// as when dereferencing each of them.
+    std::vector<T const*> itemPointers() const;
+
     /// Checks if product collection is tansient (i.e. non persistable)
     bool isTransient() const {return refVector_.refCore().isTransient();}
 
@@ -278,6 +283,35 @@ namespace edm {
     return true;
   }
 
+  template<typename C, typename T, typename F>
+  std::vector<T const*>
+  RefVector<C, T, F>::itemPointers() const {
+    std::vector<T const*> items(size(), nullptr);
+    RefCore const& core = refVector_.refCore();
+    C const* prod = nullptr;
+    bool triedProduct = false;
+    for(size_type i = 0; i < size(); ++i) {
+      void const* memberPointer = refVector_.cachedMemberPointer(i);
+      if(memberPointer) {
+        items[i] = static_cast<T const*>(memberPointer);
+        continue;
+      }
+      key_type const& key = refVector_.keys()[i];
+      if(!triedProduct && key != key_traits<key_type>::value && core.productGetter() != nullptr) {
+        triedProduct = true;
+        prod = tryToGetProductWithCoreFromRef<C>(core, core.productGetter());
+      }
+      // null, transient or thinned elements are resolved one by one
+      if(prod != nullptr && key != key_traits<key_type>::value) {
+        F func;
+        items[i] = func(*prod, key);
+      } else {
+        items[i] = (*this)[i].get();
+      }
+    }
+    return items;
+  }
+
   template<typename C, typename T, typename F>
   std::ostream&
   operator<<(std::ostream& os, RefVector<C,T,F> const& r) {
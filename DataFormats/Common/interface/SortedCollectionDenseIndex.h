@@ -0,0 +1,81 @@
+#ifndef DataFormats_Common_SortedCollectionDenseIndex_h
+#define DataFormats_Common_SortedCollectionDenseIndex_h
+// -*- C++ -*-
+//
+// Package:     Common
+// Class  :     SortedCollectionDenseIndex
+//
+/**\class SortedCollectionDenseIndex SortedCollectionDenseIndex.h DataFormats/Common/interface/SortedCollectionDenseIndex.h
+
+ Description: Constant time lookup of the elements of a SortedCollection by a dense index of their keys
+
+ Usage:
+    The index is a transient side table built once for a SortedCollection, for
+    consumers which look up many elements by key.  The dense index function maps
+    a key to an integer below the size of the table, e.g. the hashedIndex() of
+    an EBDetId:
+
+       auto index = edm::makeSortedCollectionDenseIndex(*ebRecHits, EBDetId::kSizeForDenseIndexing,
+                                                        [](DetId id) { return EBDetId(id).hashedIndex(); });
+       EcalRecHitCollection::const_iterator it = index.find(id);
+
+    find() returns the same element as SortedCollection::find(), and the end of
+    the collection for a key which is not in it, or whose dense index is out of
+    range.  The keys of the collection must have distinct dense indices.  The
+    index refers to the collection, which must outlive it and must not be
+    modified.
+*/
+//
+
+// system include files
+#include <vector>
+
+// user include files
+#include "DataFormats/Common/interface/SortedCollection.h"
+
+namespace edm {
+
+  template<typename T, typename DenseIndex, typename SORT = StrictWeakOrdering<T> >
+  class SortedCollectionDenseIndex {
+  public:
+    typedef SortedCollection<T, SORT> collection_type;
+    typedef typename collection_type::key_type key_type;
+    typedef typename collection_type::const_iterator const_iterator;
+
+    SortedCollectionDenseIndex(collection_type const& iColl, unsigned int iSize, DenseIndex iDenseIndex = DenseIndex()) :
+      m_coll(&iColl), m_denseIndex(iDenseIndex), m_positions(iSize, 0) {
+      // fill backwards, so that the first of duplicated keys is kept, as with SortedCollection::find
+      for(unsigned int i = iColl.size(); i != 0; --i) {
+        unsigned int index = m_denseIndex((iColl.begin() + (i - 1))->id());
+        if(index < iSize) {
+          m_positions[index] = i;
+        }
+      }
+    }
+
+    const_iterator find(key_type k) const {
+      unsigned int index = m_denseIndex(k);
+      if(index >= m_positions.size() || m_positions[index] == 0) {
+        return m_coll->end();
+      }
+      const_iterator it = m_coll->begin() + (m_positions[index] - 1);
+      return it->id() == k ? it : m_coll->end();
+    }
+
+    const_iterator end() const { return m_coll->end(); }
+
+  private:
+    collection_type const* m_coll;
+    DenseIndex m_denseIndex;
+    // position in the collection plus one of the element of each dense index, zero if none
+    std::vector<unsigned int> m_positions;
+  };
+
+  template<typename T, typename SORT, typename DenseIndex>
+  SortedCollectionDenseIndex<T, DenseIndex, SORT>
+  makeSortedCollectionDenseIndex(SortedCollection<T, SORT> const& iColl, unsigned int iSize, DenseIndex iDenseIndex) {
+    return SortedCollectionDenseIndex<T, DenseIndex, SORT>(iColl, iSize, iDenseIndex);
+  }
+}
+
+#endif
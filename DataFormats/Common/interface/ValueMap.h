@@ -206,6 +206,8 @@ namespace edm {
 
     const_iterator begin() const { return const_iterator(ids_.begin(), ids_.end(), &values_); }
     const_iterator end() const { return const_iterator(ids_.end(), ids_.end(), &values_); }
+    /// the values of the product id, to be accessed by key without a search for each of them; end() if there are none
+    const_iterator find(ProductID id) const { return const_iterator(getIdOffset(id), ids_.end(), &values_); }
 
     /// meant to be used in AssociativeIterator, not by the ordinary user
     const id_offset_vector & ids() const { return ids_; }
@@ -220,6 +222,8 @@ namespace edm {
     id_offset_vector ids_;
 
     typename id_offset_vector::const_iterator getIdOffset(ProductID id) const {
+      // most maps are for a single product
+      if(ids_.size()==1) return ids_.front().first == id ? ids_.begin() : ids_.end();
       typename id_offset_vector::const_iterator i = std::lower_bound(ids_.begin(), ids_.end(), id, IDComparator());
       if(i==ids_.end()) return i;
       return i->first == id ? i : ids_.end();
@@ -5,11 +5,13 @@
 
 #include "DataFormats/Common/interface/Ref.h"
 #include "DataFormats/Common/interface/RefVector.h"
+#include "DataFormats/Common/test/SimpleEDProductGetter.h"
 
 class TestRefVector: public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestRefVector);
   CPPUNIT_TEST(testIteration);
+  CPPUNIT_TEST(testItemPointers);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -19,6 +21,7 @@ class TestRefVector: public CppUnit::TestFixture
   void tearDown() {}
 
   void testIteration();
+  void testItemPointers();
 
  private:
 };
@@ -63,3 +66,45 @@ void TestRefVector::testIteration()
 
   CPPUNIT_ASSERT(iter == refvec.end());
 }
+
+namespace {
+  class CountingGetter : public SimpleEDProductGetter {
+  public:
+    CountingGetter() : calls(0) {}
+    virtual edm::WrapperBase const* getIt(edm::ProductID const& id) const override {
+      ++calls;
+      return SimpleEDProductGetter::getIt(id);
+    }
+    mutable unsigned int calls;
+  };
+}
+
+void TestRefVector::testItemPointers()
+{
+  typedef std::vector<double> product_t;
+  typedef edm::Ref<product_t> ref_t;
+  typedef edm::RefVector<product_t> refvec_t;
+
+  CountingGetter getter;
+  edm::ProductID const id(1, 1);
+  std::unique_ptr<product_t> product(new product_t);
+  product->push_back(1.0);
+  product->push_back(100.0);
+  product->push_back(0.5);
+  product->push_back(2.0);
+  getter.addProduct(id, std::move(product));
+
+  refvec_t refvec;
+  CPPUNIT_ASSERT(refvec.itemPointers().empty());
+  refvec.push_back(ref_t(id, 0, &getter));
+  refvec.push_back(ref_t(id, 2, &getter));
+  refvec.push_back(ref_t(id, 3, &getter));
+
+  std::vector<double const*> items = refvec.itemPointers();
+  CPPUNIT_ASSERT(getter.calls == 1);
+  CPPUNIT_ASSERT(items.size() == 3);
+  CPPUNIT_ASSERT(*items[0] == 1.0 && *items[1] == 0.5 && *items[2] == 2.0);
+  for(refvec_t::size_type i = 0; i < refvec.size(); ++i) {
+    CPPUNIT_ASSERT(refvec[i].get() == items[i]);
+  }
+}
@@ -17,6 +17,7 @@
 #include <memory>
 
 #include "DataFormats/Common/interface/MultiAssociation.h"
+#include "DataFormats/Common/interface/AssociationMapToMultiAssociation.h"
 
 namespace {
     struct DummyBase {
@@ -42,6 +43,7 @@ class testMultiAssociation : public CppUnit::TestFixture {
   CPPUNIT_TEST(checkWithPtr);
   CPPUNIT_TEST(checkWithOwn);
   CPPUNIT_TEST(checkWritableMap);
+  CPPUNIT_TEST(checkAssociationMap);
   CPPUNIT_TEST_SUITE_END();
   typedef std::vector<double> CVal;  // Values
   typedef std::vector<int>    CKey1; // Keys 1
@@ -75,6 +77,7 @@ public:
   void checkWithPtr();
   void checkWithOwn();
   void checkWritableMap();
+  void checkAssociationMap();
   void test(MultiRef const&);
   void test(MultiVal const&);
   void test2(MultiRef const&);
@@ -734,3 +737,60 @@ void testMultiAssociation::checkWithOwn() {
     }
 
 }
+
+void testMultiAssociation::checkAssociationMap() {
+    typedef AssociationMap<OneToMany<CKey1, CVal> > OneToManyMap;
+    typedef AssociationMap<OneToManyWithQuality<CKey1, CVal, float> > QualityMap;
+    // each key is associated to the values greater than it plus one, none for the last key
+    OneToManyMap map(handleK1, handleV);
+    QualityMap qmap(handleK1, handleV);
+    for(size_t i = 0; i < handleK1->size(); ++i) {
+      for(size_t j = 0; j < handleV->size(); ++j) {
+        if((*handleV)[j] > (*handleK1)[i] + 1) {
+          map.insert(Ref<CKey1>(handleK1, i), Ref<CVal>(handleV, j));
+          qmap.insert(Ref<CKey1>(handleK1, i), std::make_pair(Ref<CVal>(handleV, j), float(i+j)));
+        }
+      }
+    }
+
+    MultiRef multi = toMultiAssociation(map);
+    CPPUNIT_ASSERT(multi.size() == handleK1->size());
+    CPPUNIT_ASSERT(multi.dataSize() == 6);
+    auto quality = toMultiAssociation(qmap);
+    CPPUNIT_ASSERT(quality.dataSize() == 6);
+    for(size_t i = 0; i < handleK1->size(); ++i) {
+      Ref<CKey1> key(handleK1, i);
+      MultiRef::const_range r = multi[key];
+      CPPUNIT_ASSERT(static_cast<size_t>(r.size()) == map.numberOfAssociations(key));
+      auto q = quality[key];
+      CPPUNIT_ASSERT(static_cast<size_t>(q.size()) == qmap.numberOfAssociations(key));
+      if(r.empty()) continue;
+      RefVector<CVal> const& vals = map[key];
+      for(size_t j = 0; j < vals.size(); ++j) {
+        CPPUNIT_ASSERT(r[j] == vals[j]);
+        CPPUNIT_ASSERT(q[j].first == vals[j]);
+        CPPUNIT_ASSERT(q[j].second == float(i + vals[j].key()));
+      }
+    }
+
+    OneToManyMap back(handleK1, handleV);
+    fillAssociationMap(multi, back);
+    CPPUNIT_ASSERT(back.size() == map.size());
+    for(auto const& keyVal : map) {
+      CPPUNIT_ASSERT(back[keyVal.key] == keyVal.val);
+    }
+    QualityMap qback(handleK1, handleV);
+    fillAssociationMap(quality, qback);
+    CPPUNIT_ASSERT(qback.size() == qmap.size());
+    for(auto const& keyVal : qmap) {
+      CPPUNIT_ASSERT(qback[keyVal.key] == keyVal.val);
+    }
+
+    // an empty map converts to an empty MultiAssociation and back
+    OneToManyMap empty(handleK1, handleV);
+    MultiRef none = toMultiAssociation(empty);
+    CPPUNIT_ASSERT(none.empty());
+    OneToManyMap emptyBack(handleK1, handleV);
+    fillAssociationMap(none, emptyBack);
+    CPPUNIT_ASSERT(emptyBack.empty());
+}
@@ -15,6 +15,7 @@ typedef int DetId;
 
 #include "cppunit/extensions/HelperMacros.h"
 #include "DataFormats/Common/interface/SortedCollection.h"
+#include "DataFormats/Common/interface/SortedCollectionDenseIndex.h"
 
 using namespace edm;
 
@@ -89,6 +90,7 @@ class testSortedCollection: public CppUnit::TestFixture
   CPPUNIT_TEST(swapTest);
   CPPUNIT_TEST(frontbackTest);
   CPPUNIT_TEST(squarebracketTest);
+  CPPUNIT_TEST(denseIndexTest);
   CPPUNIT_TEST_SUITE_END();
 
 
@@ -102,6 +104,7 @@ class testSortedCollection: public CppUnit::TestFixture
   void swapTest();
   void frontbackTest();
   void squarebracketTest();
+  void denseIndexTest();
 };
 
 ///registration of the test so that the runner can find it
@@ -273,5 +276,28 @@ void testSortedCollection::squarebracketTest()
   CPPUNIT_ASSERT(cr[4] == Value(4.5, 1001));
 }
 
+void testSortedCollection::denseIndexTest()
+{
+  scoll_type c;
+  std::vector<Value> vec;
+  append_to_both(c, vec, Value(1.5, 3));
+  append_to_both(c, vec, Value(2.5, 200));
+  append_to_both(c, vec, Value(3.5, 1));
+  append_to_both(c, vec, Value(4.5, 1001));
+  append_to_both(c, vec, Value(5.5, 2));
+  c.sort();
 
+  // the ids below 1000 are densely indexed
+  auto index = edm::makeSortedCollectionDenseIndex(c, 1000, [](DetId id) { return (unsigned int)id; });
 
+  for(DetId id = 0; id != 1010; ++id) {
+    scoll_type::const_iterator loc = index.find(id);
+    if(id < 1000) {
+      CPPUNIT_ASSERT(loc == static_cast<scoll_type const&>(c).find(id));
+    } else {
+      CPPUNIT_ASSERT(loc == c.end());
+    }
+  }
+  CPPUNIT_ASSERT(*index.find(200) == Value(2.5, 200));
+  CPPUNIT_ASSERT(index.find(100) == index.end());
+}
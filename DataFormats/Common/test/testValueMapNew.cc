@@ -80,6 +80,24 @@ void testValueMapNew::checkAll() {
     filler2.fill();
     edm::ValueMap<int> values = values1 + values2;
     test(values);
+  } {
+    edm::ValueMap<int> values;
+    edm::ValueMap<int>::Filler filler(values);
+    filler.insert(handleK2, w2.begin(), w2.end());
+    filler.fill();
+    CPPUNIT_ASSERT(values.idSize()==1);
+    CPPUNIT_ASSERT(!values.contains(ProductID(1, 2)));
+    CPPUNIT_ASSERT(values.contains(ProductID(1, 3)));
+    CPPUNIT_ASSERT(!values.contains(ProductID(1, 4)));
+    for(size_t k = 0; k != w2.size(); ++k) {
+      CPPUNIT_ASSERT(values[edm::Ref<CKey2>(handleK2, k)] == w2[k]);
+    }
+    CPPUNIT_ASSERT_THROW(values[edm::Ref<CKey1>(handleK1, 0)], edm::Exception);
+    edm::ValueMap<int>::const_iterator i = values.find(ProductID(1, 3));
+    CPPUNIT_ASSERT(i != values.end());
+    CPPUNIT_ASSERT(i.size() == w2.size());
+    CPPUNIT_ASSERT(std::equal(i.begin(), i.end(), w2.begin()));
+    CPPUNIT_ASSERT(values.find(ProductID(1, 2)) == values.end());
   }
 }
 
@@ -128,7 +146,10 @@ void testValueMapNew::test(const edm::ValueMap<int> & values) {
 	CPPUNIT_ASSERT(i[jdx] == (*w[idx])[jdx]);
       }
     }
+    CPPUNIT_ASSERT(values.find(pids[idx]) == i);
   }
+  CPPUNIT_ASSERT(values.find(ProductID(1, 1)) == e);
+  CPPUNIT_ASSERT(values.find(ProductID(1, 4)) == e);
 }
 
 
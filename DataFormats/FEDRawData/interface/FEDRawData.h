@@ -7,6 +7,10 @@
  *  The raw data is owned as a binary buffer. It is required that the 
  *  lenght of the data is a multiple of the S-Link64 word lenght (8 byte).
  *  The FED data should include the standard FED header and trailer.
+ *  The data can also point, without copying them, into a buffer owned by
+ *  someone else (e.g. the input buffer of a source), which is then kept
+ *  alive through a shared owner. Such data are copied into an owned buffer
+ *  at the first non-const access, and when written out.
  *
  *  \author G. Bruno - CERN, EP Division
  *  \author S. Argiro - CERN and INFN - 
@@ -16,6 +20,7 @@
 
 #include <vector>
 #include <cstddef>
+#include <memory>
 
 class FEDRawData {
 
@@ -31,9 +36,18 @@ class FEDRawData {
   /// word (8 bytes)
   FEDRawData(size_t newsize);
 
+  /// Ctor pointing to size bytes of external data, which are not copied.
+  /// The data must stay valid as long as any copy of owner exists.
+  /// It is required that the size is a multiple of the size of a FED
+  /// word (8 bytes)
+  FEDRawData(const unsigned char * data, size_t size, std::shared_ptr<const void> owner);
+
   /// Copy constructor
   FEDRawData(const FEDRawData &);
 
+  /// Assignment, external data stay shared
+  FEDRawData& operator=(const FEDRawData &) = default;
+
   /// Dtor
   ~FEDRawData();
 
@@ -41,20 +55,30 @@ class FEDRawData {
   const unsigned char * data() const;
 
   /// Return a pointer to the beginning of the data buffer
+  /// (external data are copied first)
   unsigned char * data();
 
   /// Lenght of the data buffer in bytes
-  size_t size() const {return data_.size();}
+  size_t size() const {return external_ ? externalSize_ : data_.size();}
     
   /// Resize to the specified size in bytes. It is required that 
   /// the size is a multiple of the size of a FED word (8 bytes)
   void resize(size_t newsize);
 
+  /// True if the data point into a buffer not owned by this object
+  bool isExternal() const {return external_ != nullptr;}
+
  private:
 
+  void copyExternalData();
 
   Data data_;
 
+  // transient, used only for external data
+  const unsigned char * external_;
+  size_t externalSize_;
+  std::shared_ptr<const void> owner_;
+
 };
 
 #endif
@@ -0,0 +1,31 @@
+#ifndef FEDRawData_FEDRawDataStreamer_h
+#define FEDRawData_FEDRawDataStreamer_h
+
+/** \class FEDRawDataStreamer
+ *
+ *  ROOT streamer for FEDRawData: data pointing into an external buffer
+ *  are written as if they were owned, so that the stored format does not
+ *  depend on how the object was filled.
+ */
+
+#include "TClassStreamer.h"
+#include "TClassRef.h"
+
+class TBuffer;
+
+class FEDRawDataStreamer : public TClassStreamer {
+ public:
+  explicit FEDRawDataStreamer() : cl_("FEDRawData") {}
+
+  void operator() (TBuffer &R__b, void *objp);
+
+  TClassStreamer* Generate() const;
+
+ private:
+  TClassRef cl_;
+};
+
+/// Installs the streamer, must be called before writing FEDRawData with external data
+void setFEDRawDataStreamer();
+
+#endif
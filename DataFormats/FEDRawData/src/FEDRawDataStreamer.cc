@@ -0,0 +1,32 @@
+#include "DataFormats/FEDRawData/interface/FEDRawDataStreamer.h"
+#include "DataFormats/FEDRawData/interface/FEDRawData.h"
+#include "TClass.h"
+
+#include <cstring>
+
+void FEDRawDataStreamer::operator()(TBuffer &R__b, void *objp) {
+  if (R__b.IsReading()) {
+    cl_->ReadBuffer(R__b, objp);
+  } else {
+    FEDRawData* obj = static_cast<FEDRawData*>(objp);
+    if (obj->isExternal()) {
+      // write an owned copy, leaving the object itself untouched
+      FEDRawData owned(obj->size());
+      if (obj->size()) std::memcpy(owned.data(), static_cast<const FEDRawData*>(obj)->data(), obj->size());
+      cl_->WriteBuffer(R__b, &owned);
+    } else {
+      cl_->WriteBuffer(R__b, objp);
+    }
+  }
+}
+
+TClassStreamer* FEDRawDataStreamer::Generate() const {
+  return new FEDRawDataStreamer(*this);
+}
+
+void setFEDRawDataStreamer() {
+  TClass *cl = TClass::GetClass("FEDRawData");
+  if (dynamic_cast<FEDRawDataStreamer*>(cl->GetStreamer()) == nullptr) {
+    cl->AdoptStreamer(new FEDRawDataStreamer());
+  }
+}
@@ -10,6 +10,8 @@
 #include <DataFormats/FEDRawData/interface/FEDRawData.h>
 
 #include <iostream>
+#include <memory>
+#include <vector>
 
 class testFEDRawData: public CppUnit::TestFixture {
 
@@ -17,6 +19,7 @@ class testFEDRawData: public CppUnit::TestFixture {
 
   CPPUNIT_TEST(testCtor);
   CPPUNIT_TEST(testdata);
+  CPPUNIT_TEST(testExternalData);
  
   CPPUNIT_TEST_SUITE_END();
 
@@ -27,6 +30,7 @@ public:
   void tearDown(){}  
   void testCtor();
   void testdata(); 
+  void testExternalData();
  
 }; 
 
@@ -56,5 +60,33 @@ void testFEDRawData::testdata(){
   CPPUNIT_ASSERT(buf[47] == 'c');
 }
 
+void testFEDRawData::testExternalData(){
+  auto buffer = std::make_shared<std::vector<unsigned char> >(16, 'x');
+  std::weak_ptr<std::vector<unsigned char> > watcher(buffer);
+
+  FEDRawData f(buffer->data(), buffer->size(), buffer);
+  buffer.reset();
+  CPPUNIT_ASSERT(f.isExternal());
+  CPPUNIT_ASSERT(f.size()==size_t(16));
+  CPPUNIT_ASSERT(!watcher.expired());
+
+  const FEDRawData& cf = f;
+  CPPUNIT_ASSERT(cf.data()==watcher.lock()->data());
+
+  FEDRawData copy(f);
+  CPPUNIT_ASSERT(copy.isExternal());
+
+  // a non-const access copies the data
+  f.data()[0]='a';
+  CPPUNIT_ASSERT(!f.isExternal());
+  CPPUNIT_ASSERT(f.size()==size_t(16));
+  CPPUNIT_ASSERT(cf.data()[0]=='a' && cf.data()[1]=='x');
+  CPPUNIT_ASSERT(static_cast<const FEDRawData&>(copy).data()[0]=='x');
+  CPPUNIT_ASSERT(!watcher.expired());
+
+  copy.resize(24);
+  CPPUNIT_ASSERT(!copy.isExternal());
+  CPPUNIT_ASSERT(watcher.expired());
+}
 
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
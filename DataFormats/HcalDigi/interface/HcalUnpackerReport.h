@@ -65,6 +65,8 @@ public:
   void countBadQualityDigi(const DetId& did);
   void setUnsuppressed(bool isSup);
   void setReportInfo(const std::string& name, const std::string& value);
+  /// adds the content of a report made on other FEDs
+  void merge(const HcalUnpackerReport& other);
 private:
   std::vector<int> FEDsUnpacked_;
   std::vector<int> FEDsError_;
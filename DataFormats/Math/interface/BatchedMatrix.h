@@ -0,0 +1,184 @@
+#ifndef DataFormat_Math_BatchedMatrix_H
+#define DataFormat_Math_BatchedMatrix_H
+
+/*
+ * Batches of S small matrices stored as a structure of arrays: element k of
+ * every matrix of the batch is contiguous, so the kernels below loop over the
+ * matrices in the innermost loop and the compiler vectorizes them to the
+ * width of the target (SSE, AVX2 or AVX-512 depending on -march) with no
+ * intrinsics and no change of the results between the targets.
+ *
+ * The symmetric matrices use the packed lower triangle of ROOT::Math::MatRepSym,
+ * the general ones are row major, so a lane can be filled from and copied back
+ * to an SMatrix (or anything with operator()(i,j)) with setLane and getLane.
+ *
+ * S should be a multiple of the vector width, 8 or 16 are good choices.
+ * The batches are not over-aligned, so they can be held in standard containers.
+ */
+
+#include <cmath>
+
+template<typename T, unsigned int D, unsigned int S>
+struct SymMatrixBatch {
+  static constexpr unsigned int kRows = D;
+  static constexpr unsigned int kSize = D*(D+1)/2;
+  static constexpr unsigned int kLanes = S;
+
+  static constexpr unsigned int index(unsigned int i, unsigned int j) {
+    return i>=j ? i*(i+1)/2+j : j*(j+1)/2+i;
+  }
+
+  T * operator()(unsigned int i, unsigned int j) { return fRep[index(i,j)]; }
+  T const * operator()(unsigned int i, unsigned int j) const { return fRep[index(i,j)]; }
+
+  template<typename M> void setLane(unsigned int l, M const & m) {
+    for (unsigned int i=0; i<D; ++i)
+      for (unsigned int j=0; j<=i; ++j)
+	fRep[index(i,j)][l] = m(i,j);
+  }
+  template<typename M> void getLane(unsigned int l, M & m) const {
+    for (unsigned int i=0; i<D; ++i)
+      for (unsigned int j=0; j<=i; ++j)
+	m(i,j) = fRep[index(i,j)][l];
+  }
+
+  T fRep[kSize][S];
+};
+
+template<typename T, unsigned int D1, unsigned int D2, unsigned int S>
+struct MatrixBatch {
+  static constexpr unsigned int kRows = D1;
+  static constexpr unsigned int kCols = D2;
+  static constexpr unsigned int kSize = D1*D2;
+  static constexpr unsigned int kLanes = S;
+
+  T * operator()(unsigned int i, unsigned int j) { return fRep[i*D2+j]; }
+  T const * operator()(unsigned int i, unsigned int j) const { return fRep[i*D2+j]; }
+
+  template<typename M> void setLane(unsigned int l, M const & m) {
+    for (unsigned int i=0; i<D1; ++i)
+      for (unsigned int j=0; j<D2; ++j)
+	fRep[i*D2+j][l] = m(i,j);
+  }
+  template<typename M> void getLane(unsigned int l, M & m) const {
+    for (unsigned int i=0; i<D1; ++i)
+      for (unsigned int j=0; j<D2; ++j)
+	m(i,j) = fRep[i*D2+j][l];
+  }
+
+  T fRep[D1*D2][S];
+};
+
+
+/*
+ * Inverts in place the positive definite matrices of the batch through their
+ * Cholesky decomposition, as invertPosDefMatrix does with one matrix.
+ * ok[l] is set to false for the matrices that are not positive definite: they
+ * are left unchanged, for the caller to fall back to invertPosDefMatrix on them.
+ * Returns true if all the matrices were inverted.
+ */
+template<typename T, unsigned int D, unsigned int S>
+inline bool invertPosDefMatrix(SymMatrixBatch<T,D,S> & m, bool (&ok)[S]) {
+  typedef SymMatrixBatch<T,D,S> Batch;
+  // the lower triangle L of m = L L^T, with the inverse of its diagonal
+  alignas(64) T l[Batch::kSize][S];
+  alignas(64) T s[S];
+  alignas(64) T good[S];
+  for (unsigned int k=0; k<S; ++k) good[k] = T(1);
+
+  for (unsigned int j=0; j<D; ++j) {
+    for (unsigned int k=0; k<S; ++k) s[k] = m(j,j)[k];
+    for (unsigned int p=0; p<j; ++p)
+      for (unsigned int k=0; k<S; ++k) s[k] -= l[Batch::index(j,p)][k]*l[Batch::index(j,p)][k];
+    T * ljj = l[Batch::index(j,j)];
+    for (unsigned int k=0; k<S; ++k) {
+      // keep the failed lanes finite, they are thrown away at the end
+      good[k] = s[k] > T(0) ? good[k] : T(0);
+      ljj[k] = T(1)/std::sqrt(s[k] > T(0) ? s[k] : T(1));
+    }
+    for (unsigned int i=j+1; i<D; ++i) {
+      for (unsigned int k=0; k<S; ++k) s[k] = m(i,j)[k];
+      for (unsigned int p=0; p<j; ++p)
+	for (unsigned int k=0; k<S; ++k) s[k] -= l[Batch::index(i,p)][k]*l[Batch::index(j,p)][k];
+      T * lij = l[Batch::index(i,j)];
+      for (unsigned int k=0; k<S; ++k) lij[k] = s[k]*ljj[k];
+    }
+  }
+
+  // the inverse of L in place: it is lower triangular, its diagonal is already inverted
+  for (unsigned int j=0; j<D; ++j) {
+    for (unsigned int i=j+1; i<D; ++i) {
+      for (unsigned int k=0; k<S; ++k) s[k] = T(0);
+      for (unsigned int p=j; p<i; ++p)
+	for (unsigned int k=0; k<S; ++k) s[k] -= l[Batch::index(i,p)][k]*l[Batch::index(p,j)][k];
+      T * lij = l[Batch::index(i,j)];
+      T const * lii = l[Batch::index(i,i)];
+      for (unsigned int k=0; k<S; ++k) lij[k] = s[k]*lii[k];
+    }
+  }
+
+  // m^-1 = L^-T L^-1
+  for (unsigned int i=0; i<D; ++i) {
+    for (unsigned int j=0; j<=i; ++j) {
+      for (unsigned int k=0; k<S; ++k) s[k] = T(0);
+      for (unsigned int p=i; p<D; ++p)
+	for (unsigned int k=0; k<S; ++k) s[k] += l[Batch::index(p,i)][k]*l[Batch::index(p,j)][k];
+      T * mij = m(i,j);
+      for (unsigned int k=0; k<S; ++k) mij[k] = good[k] != T(0) ? s[k] : mij[k];
+    }
+  }
+
+  bool all = true;
+  for (unsigned int k=0; k<S; ++k) {
+    ok[k] = good[k] != T(0);
+    all = all && ok[k];
+  }
+  return all;
+}
+
+
+/*
+ * out = a * b for each matrix of the batches, as for the product of two
+ * Jacobians.
+ */
+template<typename T, unsigned int D1, unsigned int D2, unsigned int D3, unsigned int S>
+inline void multiply(MatrixBatch<T,D1,D2,S> const & a, MatrixBatch<T,D2,D3,S> const & b,
+		     MatrixBatch<T,D1,D3,S> & out) {
+  for (unsigned int i=0; i<D1; ++i)
+    for (unsigned int j=0; j<D3; ++j) {
+      alignas(64) T s[S];
+      for (unsigned int k=0; k<S; ++k) s[k] = a(i,0)[k]*b(0,j)[k];
+      for (unsigned int p=1; p<D2; ++p)
+	for (unsigned int k=0; k<S; ++k) s[k] += a(i,p)[k]*b(p,j)[k];
+      T * oij = out(i,j);
+      for (unsigned int k=0; k<S; ++k) oij[k] = s[k];
+    }
+}
+
+
+/*
+ * out = j * c * j^T for each matrix of the batches, as ROOT::Math::Similarity(j,c).
+ */
+template<typename T, unsigned int D1, unsigned int D2, unsigned int S>
+inline void similarity(MatrixBatch<T,D1,D2,S> const & j, SymMatrixBatch<T,D2,S> const & c,
+		       SymMatrixBatch<T,D1,S> & out) {
+  MatrixBatch<T,D1,D2,S> jc;
+  for (unsigned int r=0; r<D1; ++r)
+    for (unsigned int q=0; q<D2; ++q) {
+      T * t = jc(r,q);
+      for (unsigned int k=0; k<S; ++k) t[k] = j(r,0)[k]*c(0,q)[k];
+      for (unsigned int p=1; p<D2; ++p)
+	for (unsigned int k=0; k<S; ++k) t[k] += j(r,p)[k]*c(p,q)[k];
+    }
+  for (unsigned int r=0; r<D1; ++r)
+    for (unsigned int q=0; q<=r; ++q) {
+      alignas(64) T s[S];
+      for (unsigned int k=0; k<S; ++k) s[k] = jc(r,0)[k]*j(q,0)[k];
+      for (unsigned int p=1; p<D2; ++p)
+	for (unsigned int k=0; k<S; ++k) s[k] += jc(r,p)[k]*j(q,p)[k];
+      T * o = out(r,q);
+      for (unsigned int k=0; k<S; ++k) o[k] = s[k];
+    }
+}
+
+#endif
@@ -0,0 +1,153 @@
+// Checks the batched kernels of BatchedMatrix.h against invertPosDefMatrix and
+// ROOT::Math::Similarity on the same matrices, and times both.
+#include "DataFormats/Math/interface/invertPosDefMatrix.h"
+#include "DataFormats/Math/interface/BatchedMatrix.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+  constexpr unsigned int kLanes = 16;
+  constexpr unsigned int kBatches = 1024;
+  constexpr unsigned int kRepetitions = 20;
+
+  template<typename T>
+  double since(T start) {
+    return std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now()-start).count();
+  }
+
+  template<typename T, unsigned int D>
+  bool test(std::mt19937& engine) {
+    typedef ROOT::Math::SMatrix<T,D,D,ROOT::Math::MatRepSym<T,D> > Sym;
+    typedef ROOT::Math::SMatrix<T,D,D> Jacobian;
+    typedef SymMatrixBatch<T,D,kLanes> SymBatch;
+    typedef MatrixBatch<T,D,D,kLanes> JacobianBatch;
+    std::uniform_real_distribution<T> flat(-1,1);
+
+    // covariances made positive definite as A A^T + 1/2
+    std::vector<Sym> covariances(kBatches*kLanes);
+    std::vector<Jacobian> jacobians(kBatches*kLanes);
+    Sym const identity = ROOT::Math::SMatrixIdentity();
+    for (unsigned int n=0; n<covariances.size(); ++n) {
+      Jacobian a;
+      for (unsigned int i=0; i<D; ++i)
+	for (unsigned int j=0; j<D; ++j) {
+	  a(i,j) = flat(engine);
+	  jacobians[n](i,j) = flat(engine);
+	}
+      covariances[n] = ROOT::Math::Similarity(a, identity);
+      for (unsigned int i=0; i<D; ++i) covariances[n](i,i) += T(0.5);
+    }
+    std::vector<SymBatch> covarianceBatches(kBatches);
+    std::vector<JacobianBatch> jacobianBatches(kBatches);
+    for (unsigned int n=0; n<covariances.size(); ++n) {
+      covarianceBatches[n/kLanes].setLane(n%kLanes, covariances[n]);
+      jacobianBatches[n/kLanes].setLane(n%kLanes, jacobians[n]);
+    }
+
+    // similarity
+    std::vector<Sym> similarities(covariances.size());
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int r=0; r<kRepetitions; ++r)
+      for (unsigned int n=0; n<covariances.size(); ++n)
+	similarities[n] = ROOT::Math::Similarity(jacobians[n], covariances[n]);
+    double scalarSimilarity = since(start);
+
+    std::vector<SymBatch> similarityBatches(kBatches);
+    start = std::chrono::steady_clock::now();
+    for (unsigned int r=0; r<kRepetitions; ++r)
+      for (unsigned int b=0; b<kBatches; ++b)
+	similarity(jacobianBatches[b], covarianceBatches[b], similarityBatches[b]);
+    double batchedSimilarity = since(start);
+
+    // Jacobian products, each lane with the same lane of the next batch
+    std::vector<Jacobian> products(covariances.size());
+    start = std::chrono::steady_clock::now();
+    for (unsigned int r=0; r<kRepetitions; ++r)
+      for (unsigned int n=0; n<covariances.size(); ++n)
+	products[n] = jacobians[n]*jacobians[(n+kLanes)%jacobians.size()];
+    double scalarProduct = since(start);
+
+    std::vector<JacobianBatch> productBatches(kBatches);
+    start = std::chrono::steady_clock::now();
+    for (unsigned int r=0; r<kRepetitions; ++r)
+      for (unsigned int b=0; b<kBatches; ++b)
+	multiply(jacobianBatches[b], jacobianBatches[(b+1)%kBatches], productBatches[b]);
+    double batchedProduct = since(start);
+
+    // inversion, of fresh copies at each repetition
+    std::vector<Sym> inverses;
+    double scalarInversion = 0;
+    for (unsigned int r=0; r<kRepetitions; ++r) {
+      inverses = covariances;
+      start = std::chrono::steady_clock::now();
+      for (auto& m : inverses) invertPosDefMatrix(m);
+      scalarInversion += since(start);
+    }
+
+    std::vector<SymBatch> inverseBatches;
+    double batchedInversion = 0;
+    bool allInverted = true;
+    for (unsigned int r=0; r<kRepetitions; ++r) {
+      inverseBatches = covarianceBatches;
+      start = std::chrono::steady_clock::now();
+      for (auto& m : inverseBatches) {
+	bool ok[kLanes];
+	allInverted &= invertPosDefMatrix(m, ok);
+      }
+      batchedInversion += since(start);
+    }
+
+    // the results must agree to the rounding
+    T const tolerance = std::is_same<T,float>::value ? 1.e-3 : 1.e-9;
+    auto differ = [&](T a, T b) { return std::abs(a-b) > tolerance*(T(1)+std::abs(a)); };
+    unsigned int failures = allInverted ? 0 : 1;
+    for (unsigned int n=0; n<covariances.size(); ++n) {
+      Sym similarityLane, inverseLane;
+      Jacobian productLane;
+      similarityBatches[n/kLanes].getLane(n%kLanes, similarityLane);
+      inverseBatches[n/kLanes].getLane(n%kLanes, inverseLane);
+      productBatches[n/kLanes].getLane(n%kLanes, productLane);
+      for (unsigned int i=0; i<D; ++i)
+	for (unsigned int j=0; j<D; ++j) {
+	  if (differ(similarities[n](i,j), similarityLane(i,j))) ++failures;
+	  if (differ(inverses[n](i,j), inverseLane(i,j))) ++failures;
+	  if (differ(products[n](i,j), productLane(i,j))) ++failures;
+	}
+    }
+
+    double matrices = double(kRepetitions)*covariances.size();
+    std::cout << (std::is_same<T,float>::value ? "float  " : "double ") << D << "x" << D
+	      << "  ns per matrix, scalar/batched:"
+	      << "  inversion " << scalarInversion/matrices << "/" << batchedInversion/matrices
+	      << "  similarity " << scalarSimilarity/matrices << "/" << batchedSimilarity/matrices
+	      << "  product " << scalarProduct/matrices << "/" << batchedProduct/matrices
+	      << (failures ? "  FAILED" : "") << std::endl;
+    return failures == 0;
+  }
+}
+
+int main() {
+#ifdef __AVX2__
+  if (!__builtin_cpu_supports("avx2")) {
+    std::cout << "no AVX2 on this machine, skipping" << std::endl;
+    return 0;
+  }
+#endif
+  std::mt19937 engine(42);
+  bool ok = true;
+  ok &= test<float,2>(engine);
+  ok &= test<float,3>(engine);
+  ok &= test<float,4>(engine);
+  ok &= test<float,5>(engine);
+  ok &= test<double,2>(engine);
+  ok &= test<double,3>(engine);
+  ok &= test<double,4>(engine);
+  ok &= test<double,5>(engine);
+  return ok ? 0 : 1;
+}
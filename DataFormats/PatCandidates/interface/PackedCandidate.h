@@ -111,9 +111,8 @@ namespace pat {
       packedPuppiweight_(iOther.packedPuppiweight_), 
       packedPuppiweightNoLepDiff_(iOther.packedPuppiweightNoLepDiff_),
       hcalFraction_(iOther.hcalFraction_),
-      //Need to trigger unpacking in iOther
-      p4_( new PolarLorentzVector(iOther.polarP4() ) ),
-      p4c_( new LorentzVector(iOther.p4())), vertex_( new Point(iOther.vertex())),
+      //Only what iOther has already unpacked is copied, the rest is unpacked on demand
+      p4_(nullptr), p4c_(nullptr), vertex_(nullptr),
       dxy_(iOther.dxy_), dz_(iOther.dz_),dphi_(iOther.dphi_), 
       track_( iOther.track_ ? new reco::Track(*iOther.track_) : nullptr),
       pdgId_(iOther.pdgId_), qualityFlags_(iOther.qualityFlags_), 
@@ -121,6 +120,7 @@ namespace pat {
       dxydxy_(iOther.dxydxy_),dzdz_(iOther.dzdz_),dxydz_(iOther.dxydz_), dlambdadz_(iOther.dlambdadz_),
       dphidxy_(iOther.dphidxy_),dptdpt_(iOther.dptdpt_), detadeta_(iOther.detadeta_),
       dphidphi_(iOther.dphidphi_), packedHits_(iOther.packedHits_), normalizedChi2_(iOther.normalizedChi2_) {
+      copyUnpacked(iOther);
       }
 
     PackedCandidate( PackedCandidate&& iOther) :
@@ -171,25 +171,10 @@ namespace pat {
       packedPuppiweight_=iOther.packedPuppiweight_; 
       packedPuppiweightNoLepDiff_=iOther.packedPuppiweightNoLepDiff_;
       hcalFraction_=iOther.hcalFraction_;
-      //Need to trigger unpacking in iOther
-      if(p4_) {
-        *p4_ = iOther.polarP4();
-      } else {
-        p4_.store( new PolarLorentzVector(iOther.polarP4() ) ) ;
-      }
-      if(p4c_) {
-        *p4c_ = iOther.p4();
-      } else {
-        p4c_.store( new LorentzVector(iOther.p4()));
-      }
-      if(vertex_) {
-        *vertex_ = iOther.vertex();
-      } else {
-        vertex_.store( new Point(iOther.vertex()));
-      }
       dxy_=iOther.dxy_;
       dz_ = iOther.dz_;
       dphi_=iOther.dphi_; 
+      copyUnpacked(iOther);
       
       if(!iOther.track_) {
         delete track_.exchange(nullptr);
@@ -320,9 +305,9 @@ namespace pat {
     /// energy                                                                            
     virtual double energy() const { if (!p4c_) unpack(); return p4c_.load()->E(); }
    /// transverse energy 
-    double et() const { return (pt()<=0) ? 0 : p4c_.load()->Et(); }  
+    double et() const { if (!p4c_) unpack(); return (pt()<=0) ? 0 : p4c_.load()->Et(); }  
     /// transverse energy squared (use this for cuts)!
-    double et2() const { return (pt()<=0) ? 0 : p4c_.load()->Et2(); }   
+    double et2() const { if (!p4c_) unpack(); return (pt()<=0) ? 0 : p4c_.load()->Et2(); }   
     /// mass                                                                              
     virtual double mass() const { if (!p4c_) unpack(); return p4_.load()->M(); }
     /// mass squared                                                                      
@@ -339,7 +324,7 @@ namespace pat {
     /// z coordinate of momentum vector                                                   
     virtual double pz() const { if (!p4c_) unpack(); return p4c_.load()->Pz(); }
     /// transverse momentum                                                               
-    virtual double pt() const { if (!p4c_) unpack(); return p4_.load()->Pt();}
+    virtual double pt() const { if (!p4c_) return unpackPt(); return p4_.load()->Pt();}
     /// momentum azimuthal angle                                                          
     virtual double phi() const { if (!p4c_) unpack(); return p4_.load()->Phi(); }
     /// momentum azimuthal angle from the track (normally identical to phi())
@@ -353,7 +338,7 @@ namespace pat {
     /// momentum polar angle                                                              
     virtual double theta() const { if (!p4c_) unpack(); return p4_.load()->Theta(); }
     /// momentum pseudorapidity                                                           
-    virtual double eta() const { if (!p4c_) unpack(); return p4_.load()->Eta(); }
+    virtual double eta() const { if (!p4c_) return unpackEta(); return p4_.load()->Eta(); }
     /// rapidity                                                                          
     virtual double rapidity() const { if (!p4c_) unpack(); return p4_.load()->Rapidity(); }
     /// rapidity                                                                          
@@ -592,11 +577,16 @@ namespace pat {
     int8_t packedCovarianceDptDpt_,packedCovarianceDetaDeta_,packedCovarianceDphiDphi_;
     void pack(bool unpackAfterwards=true) ;
     void unpack() const ;
+    /// pt and eta as unpack() decodes them, without building the four-momenta
+    float unpackPt() const ;
+    float unpackEta() const ;
     void packVtx(bool unpackAfterwards=true) ;
     void unpackVtx() const ;
     void maybeUnpackBoth() const { if (!p4c_) unpack(); if (!vertex_) unpackVtx(); }
     void packBoth() { pack(false); packVtx(false); delete p4_.exchange(nullptr); delete p4c_.exchange(nullptr); delete vertex_.exchange(nullptr); unpack(); unpackVtx(); } // do it this way, so that we don't loose precision on the angles before computing dxy,dz
     void unpackTrk() const ;
+    /// copy the four vectors and the vertex if iOther has unpacked them, otherwise clear them so that they are unpacked on demand
+    void copyUnpacked(const PackedCandidate& iOther) ;
 
     int8_t packedPuppiweight_;
     int8_t packedPuppiweightNoLepDiff_; // storing the DIFFERENCE of (all - "no lep") for compression optimization
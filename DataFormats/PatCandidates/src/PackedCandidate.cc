@@ -68,13 +68,21 @@ void pat::PackedCandidate::packVtx(bool unpackAfterwards) {
     }
 }
 
+float pat::PackedCandidate::unpackPt() const {
+    return MiniFloatConverter::float16to32(packedPt_);
+}
+
+float pat::PackedCandidate::unpackEta() const {
+    return int16_t(packedEta_)*6.0f/std::numeric_limits<int16_t>::max();
+}
+
 void pat::PackedCandidate::unpack() const {
-    float pt = MiniFloatConverter::float16to32(packedPt_);
+    float pt = unpackPt();
     double shift = (pt<1. ? 0.1*pt : 0.1/pt); // shift particle phi to break degeneracies in angular separations
     double sign = ( ( int(pt*10) % 2 == 0 ) ? 1 : -1 ); // introduce a pseudo-random sign of the shift
     double phi = int16_t(packedPhi_)*3.2f/std::numeric_limits<int16_t>::max() + sign*shift*3.2/std::numeric_limits<int16_t>::max();
     auto p4 = std::make_unique<PolarLorentzVector>(pt,
-                             int16_t(packedEta_)*6.0f/std::numeric_limits<int16_t>::max(),
+                             unpackEta(),
                              phi,
                              MiniFloatConverter::float16to32(packedM_));
     auto p4c = std::make_unique<LorentzVector>( *p4 );
@@ -134,6 +142,28 @@ void pat::PackedCandidate::unpackVtx() const {
     }
 }
 
+void pat::PackedCandidate::copyUnpacked(const PackedCandidate& iOther) {
+    // p4c_ and vertex_ are set last by the unpacking, so they are read first
+    LorentzVector* p4c = iOther.p4c_.load();
+    if (p4c) {
+      PolarLorentzVector* p4 = iOther.p4_.load();
+      if (p4_) *p4_ = *p4; else p4_.store(new PolarLorentzVector(*p4));
+      if (p4c_) *p4c_ = *p4c; else p4c_.store(new LorentzVector(*p4c));
+    } else {
+      delete p4c_.exchange(nullptr);
+      delete p4_.exchange(nullptr);
+    }
+    Point* vertex = iOther.vertex_.load();
+    if (vertex) {
+      if (vertex_) *vertex_ = *vertex; else vertex_.store(new Point(*vertex));
+      dxy_ = iOther.dxy_; dz_ = iOther.dz_; dphi_ = iOther.dphi_;
+      dxydxy_ = iOther.dxydxy_; dzdz_ = iOther.dzdz_; dxydz_ = iOther.dxydz_; dlambdadz_ = iOther.dlambdadz_;
+      dphidxy_ = iOther.dphidxy_; dptdpt_ = iOther.dptdpt_; detadeta_ = iOther.detadeta_; dphidphi_ = iOther.dphidphi_;
+    } else {
+      delete vertex_.exchange(nullptr);
+    }
+}
+
 pat::PackedCandidate::~PackedCandidate() { 
   delete p4_.load();
   delete p4c_.load();
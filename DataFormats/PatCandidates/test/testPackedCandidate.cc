@@ -13,6 +13,7 @@ class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST(testCopyConstructor);
   CPPUNIT_TEST(testPackUnpack);
   CPPUNIT_TEST(testSimulateReadFromRoot);
+  CPPUNIT_TEST(testCopyPacked);
 
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -23,6 +24,7 @@ public:
   void testCopyConstructor();
   void testPackUnpack();
   void testSimulateReadFromRoot();
+  void testCopyPacked();
 
 
 private:
@@ -134,3 +136,44 @@ void testPackedCandidate::testSimulateReadFromRoot() {
   
 }
 
+void testPackedCandidate::testCopyPacked() {
+
+  pat::PackedCandidate::LorentzVector lv(1.,1.,0., std::sqrt(2. +0.120*0.120));
+  pat::PackedCandidate::Point v(-0.005,0.005,0.1);
+
+  pat::PackedCandidate pc(lv, v, -3./4.*3.1416, 11, reco::VertexRefProd(), reco::VertexRef().key());
+  pat::PackedCandidate unpacked(pc);
+
+  //as read back from ROOT
+  delete pc.p4_.exchange(nullptr);
+  delete pc.p4c_.exchange(nullptr);
+  delete pc.vertex_.exchange(nullptr);
+
+  //copying does not unpack, neither the original nor the copy
+  pat::PackedCandidate copy_pc(pc);
+  CPPUNIT_ASSERT(pc.p4c_.load() == nullptr);
+  CPPUNIT_ASSERT(copy_pc.p4c_.load() == nullptr);
+  CPPUNIT_ASSERT(copy_pc.vertex_.load() == nullptr);
+
+  //pt and eta are decoded without unpacking
+  CPPUNIT_ASSERT(copy_pc.pt() == unpacked.pt());
+  CPPUNIT_ASSERT(copy_pc.eta() == unpacked.eta());
+  CPPUNIT_ASSERT(copy_pc.p4c_.load() == nullptr);
+
+  CPPUNIT_ASSERT(copy_pc.polarP4() == unpacked.polarP4());
+  CPPUNIT_ASSERT(copy_pc.p4() == unpacked.p4());
+  CPPUNIT_ASSERT(copy_pc.vertex() == unpacked.vertex());
+
+  //assigning an unpacked candidate copies its unpacked state
+  pat::PackedCandidate assigned;
+  assigned = copy_pc;
+  CPPUNIT_ASSERT(assigned.p4c_.load() != nullptr);
+  CPPUNIT_ASSERT(assigned.p4() == unpacked.p4());
+  CPPUNIT_ASSERT(assigned.dxy() == unpacked.dxy());
+
+  //assigning a packed one clears it
+  assigned = pc;
+  CPPUNIT_ASSERT(assigned.p4c_.load() == nullptr);
+  CPPUNIT_ASSERT(assigned.vertex_.load() == nullptr);
+  CPPUNIT_ASSERT(assigned.p4() == unpacked.p4());
+}
@@ -13,7 +13,6 @@ ProductProvenanceRetriever: Manages the per event/lumi/run per product provenanc
 
 #include "tbb/concurrent_unordered_set.h"
 #include <memory>
-#include <set>
 #include <atomic>
 
 /*
@@ -63,7 +62,8 @@ namespace edm {
     }
 
     mutable tbb::concurrent_unordered_set<ProductProvenance, ProductProvenanceHasher, ProductProvenanceEqual> entryInfoSet_;
-    mutable std::atomic<const std::set<ProductProvenance>*> readEntryInfoSet_;
+    // the provenance read from the file, sorted by BranchID
+    mutable std::atomic<const ProductProvenanceVector*> readEntryInfo_;
     edm::propagate_const<std::shared_ptr<ProductProvenanceRetriever>> nextRetriever_;
     std::shared_ptr<const ProvenanceReaderBase> provenanceReader_;
     unsigned int transitionIndex_;
@@ -73,7 +73,9 @@ namespace edm {
   public:
     ProvenanceReaderBase() {}
     virtual ~ProvenanceReaderBase();
-    virtual std::set<ProductProvenance> readProvenance(unsigned int transitionIndex) const = 0;
+    // The entries may come in any order; if a BranchID appears more than
+    // once, the first entry is kept.
+    virtual ProductProvenanceVector readProvenance(unsigned int transitionIndex) const = 0;
   };
   
 }
@@ -60,6 +60,8 @@ ProductRegistry is frozen.
 #include <memory>
 #include <set>
 #include <string>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 namespace edm {
@@ -268,6 +270,13 @@ namespace edm {
     // in the ranges_ vector below.
     std::vector<TypeID> sortedTypeIDs_;
 
+    // Hash tables from the type to its position in sortedTypeIDs_,
+    // one for the product entries and one for the element entries,
+    // filled when the helper is frozen. indexToType uses them
+    // instead of a binary search comparing the type_info's.
+    std::unordered_map<std::type_index, unsigned int> productTypeToIndex_;
+    std::unordered_map<std::type_index, unsigned int> elementTypeToIndex_;
+
     // There is a one to one correspondence between this vector
     // and sortedTypeIDs_ and the corresponding elements appear
     // in the same order. Each Range object holds the beginning and
@@ -3,7 +3,8 @@
 #include "FWCore/Utilities/interface/Digest.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 
-#include <functional>
+#include <cstdint>
+#include <cstring>
 
 namespace edm {
   namespace detail {
@@ -55,12 +56,15 @@ namespace edm {
     
     size_t
     smallHash_(value_type const& hash) {
-      //NOTE: In future we could try to xor the first 8bytes into the second 8bytes of the string to make the hash
-      std::hash<std::string> h;
-      if (hash.size()==16) {
-        return h(hash);
+      //The digest is already evenly distributed, so its two halves are folded
+      // instead of hashing its bytes again
+      if (hash.size() != 16) {
+        return smallHash_(compactForm_(hash));
       }
-      return h(compactForm_(hash));
+      std::uint64_t first, second;
+      std::memcpy(&first, hash.data(), sizeof(first));
+      std::memcpy(&second, hash.data() + sizeof(first), sizeof(second));
+      return static_cast<size_t>(first ^ second);
     }
 
     bool
@@ -448,8 +448,12 @@ namespace edm {
       }
       assert(beginOfLumi->endEventNumbers() >= 0);
       assert(beginOfLumi->endEventNumbers() <= static_cast<long long>(eventNumbers().size()));
-      std::sort(eventNumbers().begin() + beginOfLumi->beginEventNumbers(),
-                eventNumbers().begin() + beginOfLumi->endEventNumbers());
+      auto const beginEvents = eventNumbers().begin() + beginOfLumi->beginEventNumbers();
+      auto const endEvents = eventNumbers().begin() + beginOfLumi->endEventNumbers();
+      // The events of a lumi are usually written in order already
+      if(!std::is_sorted(beginEvents, endEvents)) {
+        std::sort(beginEvents, endEvents);
+      }
       beginOfLumi = endOfLumi;
     }
   }
@@ -474,8 +478,11 @@ namespace edm {
       }
       assert(beginOfLumi->endEventNumbers() >= 0);
       assert(beginOfLumi->endEventNumbers() <=  static_cast<long long>(eventEntries().size()));
-      std::sort(eventEntries().begin() + beginOfLumi->beginEventNumbers(),
-                eventEntries().begin() + beginOfLumi->endEventNumbers());
+      auto const beginEvents = eventEntries().begin() + beginOfLumi->beginEventNumbers();
+      auto const endEvents = eventEntries().begin() + beginOfLumi->endEventNumbers();
+      if(!std::is_sorted(beginEvents, endEvents)) {
+        std::sort(beginEvents, endEvents);
+      }
       beginOfLumi = endOfLumi;
     }
   }
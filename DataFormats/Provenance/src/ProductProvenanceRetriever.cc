@@ -1,6 +1,7 @@
 #include "DataFormats/Provenance/interface/ProductProvenanceRetriever.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -12,7 +13,7 @@
 namespace edm {
   ProductProvenanceRetriever::ProductProvenanceRetriever(unsigned int iTransitionIndex) :
       entryInfoSet_(),
-      readEntryInfoSet_(),
+      readEntryInfo_(),
       nextRetriever_(),
       provenanceReader_(),
       transitionIndex_(iTransitionIndex){
@@ -20,7 +21,7 @@ namespace edm {
 
   ProductProvenanceRetriever::ProductProvenanceRetriever(std::unique_ptr<ProvenanceReaderBase> reader) :
       entryInfoSet_(),
-      readEntryInfoSet_(),
+      readEntryInfo_(),
       nextRetriever_(),
       provenanceReader_(reader.release()),
       transitionIndex_(std::numeric_limits<unsigned int>::max())
@@ -29,15 +30,23 @@ namespace edm {
   }
 
   ProductProvenanceRetriever::~ProductProvenanceRetriever() {
-    delete readEntryInfoSet_.load();
+    delete readEntryInfo_.load();
   }
 
   void
   ProductProvenanceRetriever::readProvenance() const {
-    if(nullptr == readEntryInfoSet_.load() && provenanceReader_) {
-      auto temp = std::make_unique<std::set<ProductProvenance> const>(provenanceReader_->readProvenance(transitionIndex_));
-      std::set<ProductProvenance> const* expected = nullptr;
-      if(readEntryInfoSet_.compare_exchange_strong(expected, temp.get())) {
+    if(nullptr == readEntryInfo_.load() && provenanceReader_) {
+      auto read = std::make_unique<ProductProvenanceVector>(provenanceReader_->readProvenance(transitionIndex_));
+      // the readers mostly return the entries already sorted, as they were written
+      if(!std::is_sorted(read->begin(), read->end())) {
+        std::stable_sort(read->begin(), read->end());
+      }
+      read->erase(std::unique(read->begin(), read->end(),
+                              [](ProductProvenance const& a, ProductProvenance const& b) { return a.branchID() == b.branchID(); }),
+                  read->end());
+      std::unique_ptr<ProductProvenanceVector const> temp(read.release());
+      ProductProvenanceVector const* expected = nullptr;
+      if(readEntryInfo_.compare_exchange_strong(expected, temp.get())) {
         temp.release();
       }
     }
@@ -45,15 +54,15 @@ namespace edm {
 
   void ProductProvenanceRetriever::deepCopy(ProductProvenanceRetriever const& iFrom)
   {
-    if(iFrom.readEntryInfoSet_) {
-      if (readEntryInfoSet_) {
-        delete readEntryInfoSet_.exchange(nullptr);
+    if(iFrom.readEntryInfo_) {
+      if (readEntryInfo_) {
+        delete readEntryInfo_.exchange(nullptr);
       }
-      readEntryInfoSet_ = new std::set<ProductProvenance>(*iFrom.readEntryInfoSet_);
+      readEntryInfo_ = new ProductProvenanceVector(*iFrom.readEntryInfo_);
     } else {
-      if(readEntryInfoSet_) {
-        delete readEntryInfoSet_.load();
-        readEntryInfoSet_ = nullptr;
+      if(readEntryInfo_) {
+        delete readEntryInfo_.load();
+        readEntryInfo_ = nullptr;
       }
     }
     entryInfoSet_ = iFrom.entryInfoSet_;
@@ -69,8 +78,8 @@ namespace edm {
 
   void
   ProductProvenanceRetriever::reset() {
-    delete readEntryInfoSet_.load();
-    readEntryInfoSet_ = nullptr;
+    delete readEntryInfo_.load();
+    readEntryInfo_ = nullptr;
     entryInfoSet_.clear();
     if(nextRetriever_) {
       nextRetriever_->reset();
@@ -98,10 +107,10 @@ namespace edm {
     if(it == entryInfoSet_.end()) {
       //check in source
       readProvenance();
-      auto ptr =readEntryInfoSet_.load();
+      auto ptr =readEntryInfo_.load();
       if(ptr) {
-        auto it = ptr->find(ei);
-        if(it!= ptr->end()) {
+        auto it = std::lower_bound(ptr->begin(), ptr->end(), ei);
+        if(it!= ptr->end() && it->branchID() == bid) {
           return &*it;
         }
       }
@@ -429,6 +429,13 @@ namespace edm {
       ranges_.push_back(Range(iBeginning, iCount));
     }
 
+    productTypeToIndex_.reserve(beginElements_);
+    elementTypeToIndex_.reserve(sortedTypeIDs_.size() - beginElements_);
+    for (unsigned int iType = 0; iType < sortedTypeIDs_.size(); ++iType) {
+      auto& typeToIndex = iType < beginElements_ ? productTypeToIndex_ : elementTypeToIndex_;
+      typeToIndex.emplace(std::type_index(sortedTypeIDs_[iType].typeInfo()), iType);
+    }
+
     // Some sanity checks to protect against out of bounds vector accesses
     // These should only fail if there is a bug. If profiling ever shows
     // them to be expensive one might delete them.
@@ -536,23 +543,10 @@ namespace edm {
   ProductResolverIndexHelper::indexToType(KindOfType kindOfType,
                                         TypeID const& typeID) const {
 
-    unsigned int beginType = 0;
-    unsigned int endType = beginElements_;
-    if (kindOfType == ELEMENT_TYPE) {
-      beginType = beginElements_;
-      endType = sortedTypeIDs_.size();
-    }
-
-    while (beginType < endType) {
-      unsigned int midpointType = beginType + ((endType - beginType) / 2);
-      if (sortedTypeIDs_[midpointType] == typeID) {
-        return midpointType;  // Found it
-      } else if (sortedTypeIDs_[midpointType] < typeID) {
-        if (beginType == midpointType) break;
-        beginType = midpointType;
-      } else {
-        endType = midpointType;
-      }
+    auto const& typeToIndex = kindOfType == ELEMENT_TYPE ? elementTypeToIndex_ : productTypeToIndex_;
+    auto itFound = typeToIndex.find(std::type_index(typeID.typeInfo()));
+    if (itFound != typeToIndex.end()) {
+      return itFound->second;  // Found it
     }
     return std::numeric_limits<unsigned int>::max(); // Failed to find it
   }
@@ -8,14 +8,18 @@
 #include "CalibFormats/HcalObjects/interface/HcalDbRecord.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include <iostream>
+#include <memory>
 #include <unordered_set>
 
+#include "tbb/parallel_for.h"
+
 HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf):
   unpacker_(conf.getUntrackedParameter<int>("HcalFirstFED",int(FEDNumbering::MINHCALFEDID)),conf.getParameter<int>("firstSample"),conf.getParameter<int>("lastSample")),
   filter_(conf.getParameter<bool>("FilterDataQuality"),conf.getParameter<bool>("FilterDataQuality"),
 	  false,
 	  0, 0, 
 	  -1),
+  unpackers_([this]() { return unpacker_; }),
   fedUnpackList_(conf.getUntrackedParameter<std::vector<int> >("FEDs", std::vector<int>())),
   firstFED_(conf.getUntrackedParameter<int>("HcalFirstFED",FEDNumbering::MINHCALFEDID)),
   unpackCalib_(conf.getUntrackedParameter<bool>("UnpackCalib",false)),
@@ -24,7 +28,8 @@ HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf):
   silent_(conf.getUntrackedParameter<bool>("silent",true)),
   complainEmptyData_(conf.getUntrackedParameter<bool>("ComplainEmptyData",false)),
   unpackerMode_(conf.getUntrackedParameter<int>("UnpackerMode",0)),
-  expectedOrbitMessageTime_(conf.getUntrackedParameter<int>("ExpectedOrbitMessageTime",-1))
+  expectedOrbitMessageTime_(conf.getUntrackedParameter<int>("ExpectedOrbitMessageTime",-1)),
+  unpackInParallel_(conf.getUntrackedParameter<bool>("UnpackInParallel",false))
 {
   electronicsMapLabel_ = conf.getParameter<std::string>("ElectronicsMap");
   tok_data_ = consumes<FEDRawDataCollection>(conf.getParameter<edm::InputTag>("InputLabel"));
@@ -69,6 +74,108 @@ HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf):
 // Virtual destructor needed.
 HcalRawToDigi::~HcalRawToDigi() { }  
 
+void HcalRawToDigi::unpackFED(HcalUnpacker& unpacker, int fedId, const FEDRawDataCollection& rawraw, const HcalElectronicsMap& readoutMap,
+                              HcalUnpacker::Collections& colls, HcalUnpackerReport& report) const {
+  const FEDRawData& fed = rawraw.FEDData(fedId);
+  if (fed.size()==0) {
+    if (complainEmptyData_) {
+      if (!silent_) edm::LogWarning("EmptyData") << "No data for FED " << fedId;
+      report.addError(fedId);
+    }
+  } else if (fed.size()<8*3) {
+    if (!silent_) edm::LogWarning("EmptyData") << "Tiny data " << fed.size() << " for FED " << fedId;
+    report.addError(fedId);
+  } else {
+    try {
+      unpacker.unpack(fed,readoutMap,colls, report,silent_);
+      report.addUnpacked(fedId);
+    } catch (cms::Exception& e) {
+      if (!silent_) edm::LogWarning("Unpacking error") << e.what();
+      report.addError(fedId);
+    } catch (...) {
+      if (!silent_) edm::LogWarning("Unpacking exception");
+      report.addError(fedId);
+    }
+  }
+}
+
+namespace {
+  // the digis of one FED, unpacked concurrently with the others
+  struct FEDDigis {
+    std::vector<HBHEDataFrame> hbhe;
+    std::vector<HODataFrame> ho;
+    std::vector<HFDataFrame> hf;
+    std::vector<HcalTriggerPrimitiveDigi> htp;
+    std::vector<HcalCalibDataFrame> hc;
+    std::vector<ZDCDataFrame> zdc;
+    std::vector<HcalTTPDigi> ttp;
+    std::vector<HOTriggerPrimitiveDigi> hotp;
+    std::unique_ptr<QIE10DigiCollection> qie10;
+    std::unique_ptr<QIE11DigiCollection> qie11;
+    HcalUnpackerReport report;
+  };
+
+  template<typename T>
+  void append(std::vector<T>* to, std::vector<FEDDigis> const & feds, std::vector<T> FEDDigis::* from) {
+    if (!to) return;
+    size_t n = to->size();
+    for (auto const & fed : feds) n += (fed.*from).size();
+    to->reserve(n);
+    for (auto const & fed : feds) to->insert(to->end(), (fed.*from).begin(), (fed.*from).end());
+  }
+
+  template<typename C>
+  void append(C*& to, std::vector<FEDDigis> const & feds, std::unique_ptr<C> FEDDigis::* from) {
+    size_t n = 0;
+    for (auto const & fed : feds) if (fed.*from) n += (fed.*from)->size();
+    for (auto const & fed : feds) {
+      C const * coll = (fed.*from).get();
+      if (!coll) continue;
+      if (!to) {
+        to = new C(coll->samples());
+        to->reserve(n);
+      } else if (to->samples() != coll->samples()) {
+        edm::LogError("Invalid Data") << "Collection has " << to->samples() << " samples per digi, raw data has " << coll->samples() << "!";
+        continue;
+      }
+      for (size_t i = 0; i != coll->size(); ++i) to->push_back(coll->id(i), coll->frame(i));
+    }
+  }
+}
+
+void HcalRawToDigi::unpackInParallel(const FEDRawDataCollection& rawraw, const HcalElectronicsMap& readoutMap,
+                                     HcalUnpacker::Collections& colls, HcalUnpackerReport& report) {
+  std::vector<FEDDigis> feds(fedUnpackList_.size());
+  tbb::parallel_for(size_t(0), fedUnpackList_.size(), [&](size_t i) {
+      FEDDigis & fed = feds[i];
+      HcalUnpacker::Collections fedColls;
+      fedColls.hbheCont=&fed.hbhe;
+      fedColls.hoCont=&fed.ho;
+      fedColls.hfCont=&fed.hf;
+      fedColls.tpCont=&fed.htp;
+      fedColls.tphoCont=&fed.hotp;
+      fedColls.calibCont=&fed.hc;
+      fedColls.zdcCont=&fed.zdc;
+      if (colls.ttp) fedColls.ttp=&fed.ttp;
+      unpackFED(unpackers_.local(), fedUnpackList_[i], rawraw, readoutMap, fedColls, fed.report);
+      fed.qie10.reset(fedColls.qie10);
+      fed.qie11.reset(fedColls.qie11);
+    });
+
+  // gather the FEDs in order, as if unpacked one after the other
+  append(colls.hbheCont, feds, &FEDDigis::hbhe);
+  append(colls.hoCont, feds, &FEDDigis::ho);
+  append(colls.hfCont, feds, &FEDDigis::hf);
+  append(colls.tpCont, feds, &FEDDigis::htp);
+  append(colls.tphoCont, feds, &FEDDigis::hotp);
+  append(colls.calibCont, feds, &FEDDigis::hc);
+  append(colls.zdcCont, feds, &FEDDigis::zdc);
+  append(colls.ttp, feds, &FEDDigis::ttp);
+  append(colls.qie10, feds, &FEDDigis::qie10);
+  append(colls.qie11, feds, &FEDDigis::qie11);
+  for (auto const & fed : feds) report.merge(fed.report);
+}
+
 void HcalRawToDigi::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   desc.addUntracked<int>("HcalFirstFED",int(FEDNumbering::MINHCALFEDID));
@@ -83,6 +190,7 @@ void HcalRawToDigi::fillDescriptions(edm::ConfigurationDescriptions& description
   desc.addUntracked<bool>("ComplainEmptyData",false);
   desc.addUntracked<int>("UnpackerMode",0);
   desc.addUntracked<int>("ExpectedOrbitMessageTime",-1);
+  desc.addUntracked<bool>("UnpackInParallel",false);
   desc.add<edm::InputTag>("InputLabel",edm::InputTag("rawDataCollector"));
   desc.add<std::string>("ElectronicsMap","");
   descriptions.add("hcalRawToDigi",desc);
@@ -135,28 +243,11 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es)
   if (unpackTTP_) colls.ttp=&ttp;
  
   // Step C: unpack all requested FEDs
-  for (std::vector<int>::const_iterator i=fedUnpackList_.begin(); i!=fedUnpackList_.end(); i++) {
-    const FEDRawData& fed = rawraw->FEDData(*i);
-    if (fed.size()==0) {
-      if (complainEmptyData_) {
-	if (!silent_) edm::LogWarning("EmptyData") << "No data for FED " << *i;
-	report->addError(*i);
-      }
-    } else if (fed.size()<8*3) {
-      if (!silent_) edm::LogWarning("EmptyData") << "Tiny data " << fed.size() << " for FED " << *i;
-      report->addError(*i);
-    } else {
-      try {
-	unpacker_.unpack(fed,*readoutMap,colls, *report,silent_);
-	report->addUnpacked(*i);
-      } catch (cms::Exception& e) {
-	if (!silent_) edm::LogWarning("Unpacking error") << e.what();
-	report->addError(*i);
-      } catch (...) {
-	if (!silent_) edm::LogWarning("Unpacking exception");
-	report->addError(*i);
-      }
-    }
+  if (unpackInParallel_) {
+    unpackInParallel(*rawraw, *readoutMap, colls, *report);
+  } else {
+    for (std::vector<int>::const_iterator i=fedUnpackList_.begin(); i!=fedUnpackList_.end(); i++)
+      unpackFED(unpacker_, *i, *rawraw, *readoutMap, colls, *report);
   }
 
 
@@ -26,6 +26,8 @@
 
 #include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
 
+#include "tbb/enumerable_thread_specific.h"
+
 class HcalRawToDigi : public edm::stream::EDProducer <>
 {
 public:
@@ -34,14 +36,22 @@ public:
   static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
   virtual void produce(edm::Event& , const edm::EventSetup&) override;
 private:
+  void unpackFED(HcalUnpacker& unpacker, int fed, const FEDRawDataCollection& rawraw, const HcalElectronicsMap& readoutMap,
+                 HcalUnpacker::Collections& colls, HcalUnpackerReport& report) const;
+  void unpackInParallel(const FEDRawDataCollection& rawraw, const HcalElectronicsMap& readoutMap,
+                        HcalUnpacker::Collections& colls, HcalUnpackerReport& report);
+
   edm::EDGetTokenT<FEDRawDataCollection> tok_data_;
   HcalUnpacker unpacker_;
   HcalDataFrameFilter filter_;
+  // copies of unpacker_ for the FEDs unpacked concurrently
+  tbb::enumerable_thread_specific<HcalUnpacker> unpackers_;
   std::vector<int> fedUnpackList_;
   const int firstFED_;
   const bool unpackCalib_, unpackZDC_, unpackTTP_;
   const bool silent_, complainEmptyData_;
   const int unpackerMode_, expectedOrbitMessageTime_;
+  const bool unpackInParallel_;
   std::string electronicsMapLabel_;
 
   struct Statistics {
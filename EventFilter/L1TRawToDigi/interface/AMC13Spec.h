@@ -77,7 +77,7 @@ namespace amc13 {
          bool parse(const uint64_t *start, const uint64_t *data, unsigned int size, unsigned int lv1, unsigned int bx, bool legacy_mc=false, bool mtf7_mode=false);
          bool write(const edm::Event& ev, unsigned char * ptr, unsigned int skip, unsigned int size) const;
 
-         inline std::vector<amc::Packet> payload() const { return payload_; };
+         inline const std::vector<amc::Packet>& payload() const { return payload_; };
 
       private:
          Header header_;
@@ -134,6 +134,9 @@ namespace amc {
 
          std::vector<uint64_t> block(unsigned int id) const;
          std::unique_ptr<uint64_t[]> data();
+         // Same payload as data(), without copying it: valid as long as
+         // the packet is, with size() words
+         inline const uint64_t * payloadData() const { return payload_.data() + 2; };
          BlockHeader blockHeader(unsigned int block=0) const { return block_header_; };
          Header header() const { return header_; };
          Trailer trailer() const { return trailer_; };
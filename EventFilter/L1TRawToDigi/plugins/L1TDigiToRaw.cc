@@ -136,7 +136,7 @@ namespace l1t {
          load32.push_back(fwId_);
          for (const auto& block: block_load) {
             LogDebug("L1T") << "Adding block " << block.header().getID() << " with size " << block.payload().size();
-            auto load = block.payload();
+            const auto& load = block.payload();
 
 #ifdef EDM_ML_DEBUG
             std::stringstream s("");
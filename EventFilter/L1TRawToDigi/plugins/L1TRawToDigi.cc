@@ -205,12 +205,11 @@ namespace l1t {
             return;
          }
 
-         for (auto& amc: packet.payload()) {
+         for (const auto& amc: packet.payload()) {
 	   if (amc.size() == 0)
 	     continue;
 
-            auto payload64 = amc.data();
-            const uint32_t * start = (const uint32_t*) payload64.get();
+            const uint32_t * start = (const uint32_t*) amc.payloadData();
             // Want to have payload size in 32 bit words, but AMC measures
             // it in 64 bit words → factor 2.
             const uint32_t * end = start + (amc.size() * 2);
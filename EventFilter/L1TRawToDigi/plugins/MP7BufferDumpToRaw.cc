@@ -399,7 +399,7 @@ MP7BufferDumpToRaw::formatAMC(amc13::Packet& amc13, const std::vector<Block>& bl
 
   for (const auto& block: blocks) {
     LogDebug("L1T") << "Adding block " << block.header().getID() << " with size " << block.payload().size();
-    auto load = block.payload();
+    const auto& load = block.payload();
     
 #ifdef EDM_ML_DEBUG
     std::stringstream s("");
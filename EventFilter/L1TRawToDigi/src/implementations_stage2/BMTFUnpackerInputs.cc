@@ -40,7 +40,7 @@ namespace l1t
 
 			unsigned int blockId = block.header().getID();
 			LogDebug("L1T") << "Block ID: " << blockId << " size: " << block.header().getSize();
-			auto payload = block.payload();
+			const auto& payload = block.payload();
 			int nBX, firstBX, lastBX;
 		
 			nBX = int(ceil(block.header().getSize()/6));
@@ -11,7 +11,7 @@ namespace l1t
 			unsigned int blockId = block.header().getID();
 			LogDebug("L1T") << "Block ID: " << blockId << " size: " << block.header().getSize();
 			
-			auto payload = block.payload();
+			const auto& payload = block.payload();
 			
 			//int nwords(2); //two words per muon
 			int nBX, firstBX, lastBX;
@@ -24,7 +24,7 @@ namespace l1t {
       {
          LogDebug("L1T") << "Block ID  = " << block.header().getID() << " size = " << block.header().getSize();
 
-         auto payload = block.payload();
+         const auto& payload = block.payload();
 
          unsigned int nWords = 6; // every link transmits 6 words (3 muons) per bx
          int nBX, firstBX, lastBX;
@@ -23,7 +23,7 @@ namespace l1t {
          unsigned int blockId = block.header().getID();
          LogDebug("L1T") << "Block ID  = " << blockId << " size = " << block.header().getSize();
 
-         auto payload = block.payload();
+         const auto& payload = block.payload();
 
          unsigned int nWords = 6; // every link transmits 6 words (3 muons) per bx
          int nBX, firstBX, lastBX;
@@ -103,6 +103,8 @@ namespace evf{
       void removeFile(std::string );
 
       FileStatus updateFuLock(unsigned int& ls, std::string& nextFile, uint32_t& fsize, uint64_t& lockWaitTime);
+      //wait up to timeoutUs for files to appear in the BU run directory (returns early on inotify events if enabled)
+      void waitForBUFiles(unsigned int timeoutUs);
       void tryInitializeFuLockFile();
       unsigned int getRunNumber() const { return run_; }
       FILE * maybeCreateAndLockFileHeadForStream(unsigned int ls, std::string &stream);
@@ -154,6 +156,7 @@ namespace evf{
       std::string selectedTransferMode_;
       std::string hltSourceDirectory_;
       unsigned int fuLockPollInterval_;
+      bool useInotify_;
       bool emptyLumisectionMode_;
       bool microMergeDisabled_;
       std::string mergeTypePset_;
@@ -170,6 +173,7 @@ namespace evf{
       int data_readwrite_fd_;
       int fulocal_rwlock_fd_;
       int fulocal_rwlock_fd2_;
+      int bu_inotify_fd_;
 
       FILE * bu_w_lock_stream;
       FILE * bu_r_lock_stream;
@@ -178,6 +178,20 @@ namespace evf{
 
       void doSnapshot(const unsigned int ls, const bool isGlobalEOL);
 
+      //the stream states are only sampled by the monitoring thread, relaxed ordering is enough
+      void setStreamMinistate(unsigned int sid, const void* state) {
+        fmt_.m_data.streamStates_[sid].ministate_.store(state,std::memory_order_relaxed);
+      }
+      void setStreamMicrostate(unsigned int sid, const void* state) {
+        fmt_.m_data.streamStates_[sid].microstate_.store(state,std::memory_order_relaxed);
+      }
+      const void* streamMinistate(unsigned int sid) const {
+        return fmt_.m_data.streamStates_[sid].ministate_.load(std::memory_order_relaxed);
+      }
+      const void* streamMicrostate(unsigned int sid) const {
+        return fmt_.m_data.streamStates_[sid].microstate_.load(std::memory_order_relaxed);
+      }
+
       void doStreamEOLSnapshot(const unsigned int ls, const unsigned int streamID) {
 	//pick up only event count here
 	fmt_.jsonMonitor_->snapStreamAtomic(ls,streamID);
@@ -187,8 +201,8 @@ namespace evf{
         monInit_.exchange(true,std::memory_order_acquire);
 	while (!fmt_.m_stoprequest) {
 	  edm::LogInfo("FastMonitoringService") << "Current states: Ms=" << fmt_.m_data.fastMacrostateJ_.value()
-	            << " ms=" << encPath_[0].encode(ministate_[0])
-	            << " us=" << encModule_.encode(microstate_[0])
+	            << " ms=" << encPath_[0].encode(streamMinistate(0))
+	            << " us=" << encModule_.encode(streamMicrostate(0))
 	            << " is=" << inputStateNames[inputState_]
 	            << " iss="<< inputStateNames[inputSupervisorState_]
                     << std::endl;
@@ -256,9 +270,7 @@ namespace evf{
       //global state
       FastMonitoringThread::Macrostate macrostate_;
 
-      //per stream
-      std::vector<const void*> ministate_;
-      std::vector<const void*> microstate_;
+      //per stream mini/microstates are in fmt_.m_data.streamStates_
       std::vector<const void*> threadMicrostate_;
 
       //variables measuring source statistics (global)
@@ -286,8 +298,6 @@ namespace evf{
 
       bool threadIDAvailable_ = false;
 
-      std::atomic<unsigned long> totalEventsProcessed_;
-
       std::string moduleLegendFile_;
       std::string moduleLegendFileJson_;
       std::string pathLegendFile_;
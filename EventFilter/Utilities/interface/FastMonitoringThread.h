@@ -3,6 +3,9 @@
 
 #include "EventFilter/Utilities/interface/FastMonitor.h"
 
+#include "tbb/cache_aligned_allocator.h"
+
+#include <atomic>
 #include <iostream>
 #include <vector>
 #include <thread>
@@ -38,6 +41,22 @@ namespace evf{
                       inWaitChunk_newFileWaitChunkCopying,inWaitChunk_newFileWaitChunk,
                       inCOUNT}; 
 
+    //state written by a stream at each of its transitions and sampled by the monitoring thread.
+    //Each stream has its own cache line, so that streams do not invalidate each other's lines
+    //on every module transition.
+    struct alignas(64) StreamState
+    {
+      std::atomic<const void*> ministate_{nullptr};
+      std::atomic<const void*> microstate_{nullptr};
+      //events processed in the current lumi, tracked by the FastMonitor
+      jsoncollector::AtomicMonUInt processed_;
+      //events processed since the start of the job, only written by the stream
+      std::atomic<unsigned long> totalProcessed_{0};
+
+      StreamState() : processed_(0) {}
+    };
+    typedef std::vector<StreamState, tbb::cache_aligned_allocator<StreamState>> StreamStates;
+
     struct MonitorData
     {
       //fastpath global monitorables
@@ -52,6 +71,7 @@ namespace evf{
       unsigned int varIndexThrougput_;
 
       //per stream
+      StreamStates streamStates_;
       std::vector<unsigned int> microstateEncoded_;
       std::vector<unsigned int> ministateEncoded_;
       std::vector<jsoncollector::AtomicMonUInt*> processed_;
@@ -99,10 +119,9 @@ namespace evf{
         fm->registerGlobalMonitorable(&fastLockWaitJ_,false);
         fm->registerGlobalMonitorable(&fastLockCountJ_,false);
 
+	StreamStates(nStreams).swap(streamStates_);
 	for (unsigned int i=0;i<nStreams;i++) {
-	 jsoncollector::AtomicMonUInt * p  = new jsoncollector::AtomicMonUInt;
-	 *p=0;
-   	  processed_.push_back(p);
+   	  processed_.push_back(&streamStates_[i].processed_);
           streamLumi_.push_back(0);
 	}
 	
@@ -65,6 +65,8 @@ private:
   evf::EvFDaqDirector::FileStatus nextEvent();
   evf::EvFDaqDirector::FileStatus getNextEvent();
   edm::Timestamp fillFEDRawDataCollection(FEDRawDataCollection&);
+  std::shared_ptr<const void> const& chunkOwner(InputChunk*);
+  void releaseChunk(InputChunk*);
   void deleteFile(std::string const&);
   int grabNextJsonFile(boost::filesystem::path const&);
 
@@ -93,6 +95,7 @@ private:
   unsigned int readBlocks_;
   unsigned int numBuffers_;
   unsigned int maxBufferedFiles_;
+  const bool prefetchFiles_;
   unsigned int numConcurrentReads_;
   std::atomic<unsigned int> readingFilesCount_;
 
@@ -107,6 +110,11 @@ private:
   const bool fileListMode_;
   unsigned int fileListIndex_ = 0;
 
+  // FEDRawData point into the input chunks instead of copying the data
+  bool zeroCopyFEDRawData_;
+  // keeps alive the buffer holding the current event, in zero copy mode
+  std::shared_ptr<const void> eventDataOwner_;
+
   edm::RunNumber_t runNumber_;
   std::string fuOutputDir_;
 
@@ -192,6 +200,8 @@ struct InputChunk {
   unsigned int offset_;
   unsigned int fileIndex_;
   std::atomic<bool> readComplete_;
+  //shared by the events pointing into the chunk, which is freed when the last copy goes away
+  std::shared_ptr<const void> owner_;
 
   InputChunk(unsigned int index, uint32_t size): size_(size),index_(index) {
     buf_ = new unsigned char[size_];
@@ -246,6 +256,7 @@ struct InputFile {
     return chunks_[chunkid]!=nullptr && chunks_[chunkid]->readComplete_;
   }
   bool advance(unsigned char* & dataPosition, const size_t size);
+  bool advanceCopying(unsigned char* buffer, const size_t size);
   void moveToPreviousChunk(const size_t size, const size_t offset);
   void rewindChunk(const size_t size);
 };
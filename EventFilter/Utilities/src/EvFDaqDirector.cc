@@ -20,6 +20,8 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <sys/file.h>
+#include <sys/inotify.h>
+#include <poll.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/filesystem/fstream.hpp>
 
@@ -55,6 +57,7 @@ namespace evf {
     selectedTransferMode_(pset.getUntrackedParameter<std::string>("selectedTransferMode","")),
     hltSourceDirectory_(pset.getUntrackedParameter<std::string>("hltSourceDirectory","")),
     fuLockPollInterval_(pset.getUntrackedParameter<unsigned int>("fuLockPollInterval",2000)),
+    useInotify_(pset.getUntrackedParameter<bool>("useInotify",false)),
     emptyLumisectionMode_(pset.getUntrackedParameter<bool>("emptyLumisectionMode",true)),
     microMergeDisabled_(pset.getUntrackedParameter<bool>("microMergeDisabled",true)),
     mergeTypePset_(pset.getUntrackedParameter<std::string>("mergeTypePset","")),
@@ -65,6 +68,7 @@ namespace evf {
     data_readwrite_fd_(-1),
     fulocal_rwlock_fd_(-1),
     fulocal_rwlock_fd2_(-1),
+    bu_inotify_fd_(-1),
 
     bu_w_lock_stream(0),
     bu_r_lock_stream(0),
@@ -247,6 +251,17 @@ namespace evf {
 	bu_run_dir_ = bu_base_dir_ + "/" + run_string_;
 	std::string fulockfile = bu_run_dir_ + "/fu.lock";
 	openFULockfileStream(fulockfile, false);
+
+	//watch for index and EoLS files written (or moved) into the BU run directory
+	if (useInotify_) {
+	  bu_inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	  if (bu_inotify_fd_==-1 || inotify_add_watch(bu_inotify_fd_, bu_run_dir_.c_str(), IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE)==-1) {
+	    edm::LogWarning("EvFDaqDirector") << "Unable to watch the BU run directory with inotify, falling back to polling -: "
+	                                      << bu_run_dir_ << " : " << strerror(errno);
+	    if (bu_inotify_fd_!=-1) close(bu_inotify_fd_);
+	    bu_inotify_fd_=-1;
+	  }
+	}
       }
 
     pthread_mutex_init(&init_lock_,NULL);
@@ -266,6 +281,8 @@ namespace evf {
       close(fulocal_rwlock_fd2_);
     }
 
+    if (bu_inotify_fd_!=-1) close(bu_inotify_fd_);
+
   }
 
 
@@ -291,6 +308,7 @@ namespace evf {
     desc.addUntracked<bool>("requireTransfersPSet",false)->setComment("Require complete transferSystem PSet in the process configuration");
     desc.addUntracked<std::string>("selectedTransferMode","")->setComment("Selected transfer mode (choice in Lvl0 propagated as Python parameter");
     desc.addUntracked<unsigned int>("fuLockPollInterval",2000)->setComment("Lock polling interval in microseconds for the input directory file lock");
+    desc.addUntracked<bool>("useInotify",false)->setComment("Wake up on inotify events of the BU run directory instead of sleeping the whole interval between checks for new files");
     desc.addUntracked<bool>("emptyLumisectionMode",true)->setComment("Enables writing stream output metadata even when no events are processed in a lumisection");
     desc.addUntracked<bool>("microMergeDisabled",true)->setComment("Disabled micro-merging by the Output Module, so it is later done by hltd service");
     desc.addUntracked<std::string>("mergingPset","")->setComment("Name of merging PSet to look for merging type definitions for streams");
@@ -654,6 +672,24 @@ namespace evf {
     return fileStatus;
   }
 
+  void EvFDaqDirector::waitForBUFiles(unsigned int timeoutUs) {
+    if (bu_inotify_fd_==-1) {
+      usleep(timeoutUs);
+      return;
+    }
+    //a file written by a remote BU on a network mount produces no event here, so the timeout
+    //still bounds the wait to the polling interval
+    struct pollfd pfd;
+    pfd.fd = bu_inotify_fd_;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, timeoutUs/1000)>0) {
+      //drain the queued events, the caller rechecks the directory anyway
+      char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+      while (read(bu_inotify_fd_, buf, sizeof(buf))>0) {}
+    }
+  }
+
   int EvFDaqDirector::getNFilesFromEoLS(std::string BUEoLSFile) {
 
     boost::filesystem::ifstream ij(BUEoLSFile);
@@ -67,7 +67,6 @@ namespace evf{
     ,fastName_("fastmoni")
     ,slowName_("slowmoni")
     ,filePerFwkStream_(iPS.getUntrackedParameter<bool>("filePerFwkStream", false))
-    ,totalEventsProcessed_(0)
   {
     reg.watchPreallocate(this, &FastMonitoringService::preallocate);//receiving information on number of threads
     reg.watchJobFailure(this,&FastMonitoringService::jobFailure);//global
@@ -256,9 +255,6 @@ namespace evf{
     encModule_.completeReservedWithDummies();
 
     for (unsigned int i=0;i<nStreams_;i++) {
-       ministate_.push_back(&nopath_);
-       microstate_.push_back(&reservedMicroStateNames[mInvalid]);
-
        //for synchronization
        streamCounterUpdating_.push_back(new std::atomic<bool>(0));
 
@@ -287,6 +283,10 @@ namespace evf{
     fmt_.resetFastMonitor(microstateDefPath_,fastMicrostateDefPath_);
     fmt_.jsonMonitor_->setNStreams(nStreams_);
     fmt_.m_data.registerVariables(fmt_.jsonMonitor_.get(), nStreams_, threadIDAvailable_ ? nThreads_:0);
+    for (unsigned int i=0;i<nStreams_;i++) {
+      setStreamMinistate(i,&nopath_);
+      setStreamMicrostate(i,&reservedMicroStateNames[mInvalid]);
+    }
     monInit_.store(false,std::memory_order_release);
     fmt_.start(&FastMonitoringService::dowork,this);
 
@@ -517,13 +517,13 @@ namespace evf{
     //reset collected values for this stream
     *(fmt_.m_data.processed_[sid])=0;
 
-    ministate_[sid]=&nopath_;
-    microstate_[sid]=&reservedMicroStateNames[mBoL];
+    setStreamMinistate(sid,&nopath_);
+    setStreamMicrostate(sid,&reservedMicroStateNames[mBoL]);
   }
 
   void FastMonitoringService::postStreamBeginLumi(edm::StreamContext const& sc)
   {
-    microstate_[sc.streamID().value()]=&reservedMicroStateNames[mIdle];
+    setStreamMicrostate(sc.streamID().value(),&reservedMicroStateNames[mIdle]);
   }
 
   void FastMonitoringService::preStreamEndLumi(edm::StreamContext const& sc)
@@ -539,12 +539,12 @@ namespace evf{
     //update processed count to be complete at this time
     doStreamEOLSnapshot(sc.eventID().luminosityBlock(),sid);
     //reset this in case stream does not get notified of next lumi (we keep processed events only)
-    ministate_[sid]=&nopath_;
-    microstate_[sid]=&reservedMicroStateNames[mEoL];
+    setStreamMinistate(sid,&nopath_);
+    setStreamMicrostate(sid,&reservedMicroStateNames[mEoL]);
   }
   void FastMonitoringService::postStreamEndLumi(edm::StreamContext const& sc)
   {
-    microstate_[sc.streamID().value()]=&reservedMicroStateNames[mFwkEoL];
+    setStreamMicrostate(sc.streamID().value(),&reservedMicroStateNames[mFwkEoL]);
   }
 
 
@@ -576,7 +576,7 @@ namespace evf{
       }
     }
     else {
-      ministate_[sc.streamID()] = &(pc.pathName());
+      setStreamMinistate(sc.streamID(),&(pc.pathName()));
     }
   }
 
@@ -587,9 +587,9 @@ namespace evf{
 
   void FastMonitoringService::postEvent(edm::StreamContext const& sc)
   {
-    microstate_[sc.streamID()] = &reservedMicroStateNames[mIdle];
+    setStreamMicrostate(sc.streamID(),&reservedMicroStateNames[mIdle]);
 
-    ministate_[sc.streamID()] = &nopath_;
+    setStreamMinistate(sc.streamID(),&nopath_);
 
     #if ATOMIC_LEVEL>=2
     //use atomic flag to make sure end of lumi sees this
@@ -606,31 +606,31 @@ namespace evf{
     #endif
     eventCountForPathInit_[sc.streamID()]++;
 
-    //fast path counter (events accumulated in a run)
-    unsigned long res = totalEventsProcessed_.fetch_add(1,std::memory_order_relaxed);
-    fmt_.m_data.fastPathProcessedJ_ = res+1; 
-    //fmt_.m_data.fastPathProcessedJ_ = totalEventsProcessed_.load(std::memory_order_relaxed);
+    //fast path counter (events accumulated in a run), summed over the streams in doSnapshot.
+    //Only this stream writes its counter, so no read-modify-write is needed
+    auto& totalProcessed = fmt_.m_data.streamStates_[sc.streamID()].totalProcessed_;
+    totalProcessed.store(totalProcessed.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
   }
 
   void FastMonitoringService::preSourceEvent(edm::StreamID sid)
   {
-    microstate_[sid.value()] = &reservedMicroStateNames[mInput];
+    setStreamMicrostate(sid.value(),&reservedMicroStateNames[mInput]);
   }
 
   void FastMonitoringService::postSourceEvent(edm::StreamID sid)
   {
-    microstate_[sid.value()] = &reservedMicroStateNames[mFwkOvhSrc];
+    setStreamMicrostate(sid.value(),&reservedMicroStateNames[mFwkOvhSrc]);
   }
 
   void FastMonitoringService::preModuleEvent(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc)
   {
-    microstate_[sc.streamID().value()] = (void*)(mcc.moduleDescription());
+    setStreamMicrostate(sc.streamID().value(),mcc.moduleDescription());
   }
 
   void FastMonitoringService::postModuleEvent(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc)
   {
     //microstate_[sc.streamID().value()] = (void*)(mcc.moduleDescription());
-    microstate_[sc.streamID().value()] = &reservedMicroStateNames[mFwkOvhMod];
+    setStreamMicrostate(sc.streamID().value(),&reservedMicroStateNames[mFwkOvhMod]);
   }
 
   //FUNCTIONS CALLED FROM OUTSIDE
@@ -640,13 +640,13 @@ namespace evf{
   void FastMonitoringService::setMicroState(MicroStateService::Microstate m)
   {
     for (unsigned int i=0;i<nStreams_;i++)
-      microstate_[i] = &reservedMicroStateNames[m];
+      setStreamMicrostate(i,&reservedMicroStateNames[m]);
   }
 
   //this is for services that are multithreading-enabled or rarely blocks other streams
   void FastMonitoringService::setMicroState(edm::StreamID sid, MicroStateService::Microstate m)
   {
-    microstate_[sid] = &reservedMicroStateNames[m];
+    setStreamMicrostate(sid,&reservedMicroStateNames[m]);
   }
 
   //from source
@@ -763,7 +763,7 @@ namespace evf{
     }
     else {
       for (unsigned int i=0;i<nStreams_;i++) {
-        microstate_[i]=&reservedMicroStateNames[mGlobEoL];
+        setStreamMicrostate(i,&reservedMicroStateNames[mGlobEoL]);
       }
     }
     //else return;
@@ -771,13 +771,17 @@ namespace evf{
     bool anyThreadsIdle=false;
     bool anyThreadsEoL=false;
     bool allThreadsEoL=true;
+    unsigned long totalProcessed=0;
     for (unsigned int i=0;i<nStreams_;i++) {
-      fmt_.m_data.ministateEncoded_[i] = encPath_[i].encode(ministate_[i]);
-      fmt_.m_data.microstateEncoded_[i] = encModule_.encode(microstate_[i]);
-      if (microstate_[i]==&reservedMicroStateNames[mIdle]) anyThreadsIdle=true;
-      if (microstate_[i]==&reservedMicroStateNames[mEoL]) anyThreadsEoL=true;
+      const void* microstate = streamMicrostate(i);
+      fmt_.m_data.ministateEncoded_[i] = encPath_[i].encode(streamMinistate(i));
+      fmt_.m_data.microstateEncoded_[i] = encModule_.encode(microstate);
+      if (microstate==&reservedMicroStateNames[mIdle]) anyThreadsIdle=true;
+      if (microstate==&reservedMicroStateNames[mEoL]) anyThreadsEoL=true;
       else allThreadsEoL=false;
+      totalProcessed += fmt_.m_data.streamStates_[i].totalProcessed_.load(std::memory_order_relaxed);
     }
+    fmt_.m_data.fastPathProcessedJ_ = totalProcessed;
 
     if (inputState_==FastMonitoringThread::inWaitInput) {
       switch (inputSupervisorState_) {
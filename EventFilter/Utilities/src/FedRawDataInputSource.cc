@@ -19,6 +19,7 @@
 
 #include "DataFormats/FEDRawData/interface/FEDNumbering.h"
 #include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataStreamer.h"
 
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/InputSourceDescription.h"
@@ -59,12 +60,14 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
   eventChunkBlock_(pset.getUntrackedParameter<unsigned int> ("eventChunkBlock",32)*1048576),
   numBuffers_(pset.getUntrackedParameter<unsigned int> ("numBuffers",2)),
   maxBufferedFiles_(pset.getUntrackedParameter<unsigned int> ("maxBufferedFiles",2)),
+  prefetchFiles_(pset.getUntrackedParameter<bool> ("prefetchFiles", false)),
   getLSFromFilename_(pset.getUntrackedParameter<bool> ("getLSFromFilename", true)),
   verifyAdler32_(pset.getUntrackedParameter<bool> ("verifyAdler32", true)),
   verifyChecksum_(pset.getUntrackedParameter<bool> ("verifyChecksum", true)),
   useL1EventID_(pset.getUntrackedParameter<bool> ("useL1EventID", false)),
   fileNames_(pset.getUntrackedParameter<std::vector<std::string>> ("fileNames",std::vector<std::string>())),
   fileListMode_(pset.getUntrackedParameter<bool> ("fileListMode", false)),
+  zeroCopyFEDRawData_(pset.getUntrackedParameter<bool> ("zeroCopyFEDRawData", false)),
   runNumber_(edm::Service<evf::EvFDaqDirector>()->getRunNumber()),
   fuOutputDir_(std::string()),
   daqProvenanceHelper_(edm::TypeID(typeid(FEDRawDataCollection))),
@@ -125,6 +128,18 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
   singleBufferMode_ = !(numBuffers_>1);
   readingFilesCount_=0;
 
+  if (zeroCopyFEDRawData_) {
+    if (singleBufferMode_) {
+      //the single buffer is overwritten by the next event
+      edm::LogWarning("FedRawDataInputSource") << "zeroCopyFEDRawData requires numBuffers > 1, FED data will be copied";
+      zeroCopyFEDRawData_ = false;
+    }
+    else {
+      //external FED data are written out as if they were owned
+      setFEDRawDataStreamer();
+    }
+  }
+
   if (!crc32c_hw_test())
     edm::LogError("FedRawDataInputSource::FedRawDataInputSource") << "Intel crc32c checksum computation unavailable";
 
@@ -219,10 +234,12 @@ void FedRawDataInputSource::fillDescriptions(edm::ConfigurationDescriptions& des
   desc.addUntracked<unsigned int> ("eventChunkBlock",32)->setComment("Block size used in a single file read call (must be smaller or equal to buffer size)");
   desc.addUntracked<unsigned int> ("numBuffers",2)->setComment("Number of buffers used for reading input");
   desc.addUntracked<unsigned int> ("maxBufferedFiles",2)->setComment("Maximum number of simultaneously buffered raw files");
+  desc.addUntracked<bool> ("prefetchFiles", false)->setComment("Ask the kernel to read ahead each raw file as soon as it is assigned, before its chunks are read");
   desc.addUntracked<bool> ("verifyAdler32", true)->setComment("Verify event Adler32 checksum with FRDv3 or v4");
   desc.addUntracked<bool> ("verifyChecksum", true)->setComment("Verify event CRC-32C checksum of FRDv5 or higher");
   desc.addUntracked<bool> ("useL1EventID", false)->setComment("Use L1 event ID from FED header if true or from TCDS FED if false");
   desc.addUntracked<bool> ("fileListMode", false)->setComment("Use fileNames parameter to directly specify raw files to open");
+  desc.addUntracked<bool> ("zeroCopyFEDRawData", false)->setComment("FEDRawData point into the input buffers, which are kept until their events are done, instead of copying the data. Requires numBuffers > 1, and more buffers than in copy mode to keep reading ahead");
   desc.addUntracked<std::vector<std::string>> ("fileNames", std::vector<std::string>())->setComment("file list used when fileListMode is enabled");
   desc.setAllowAnything();
   descriptions.add("source", desc);
@@ -446,7 +463,7 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
   if (currentFile_->bufferPosition_==currentFile_->fileSize_) {
     readingFilesCount_--;
     //release last chunk (it is never released elsewhere)
-    freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_]);
+    releaseChunk(currentFile_->chunks_[currentFile_->currentChunk_]);
     if (currentFile_->nEvents_>=0 && currentFile_->nEvents_!=int(currentFile_->nProcessed_))
     {
       throw cms::Exception("FedRawDataInputSource::getNextEvent")
@@ -554,51 +571,96 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
     }
     if (fms_) fms_->setInState(evf::FastMonitoringThread::inChunkReceived);
 
-    //check if header is at the boundary of two chunks
     chunkIsFree_ = false;
-    unsigned char *dataPosition;
+    if (zeroCopyFEDRawData_) {
+      //the events in flight may point anywhere in the chunks, so the data are never moved inside them:
+      //an event crossing the chunk boundary is copied to its own buffer instead
+      const uint32_t headerSize = FRDHeaderVersionSize[detectedFRDversion_];
+      InputChunk* chunk = currentFile_->chunks_[currentFile_->currentChunk_];
+      unsigned char *dataPosition = chunk->buf_ + currentFile_->chunkPosition_;
+      const uint32_t currentLeft = eventChunkSize_ - currentFile_->chunkPosition_;
+      if (currentLeft >= headerSize && FRDEventMsgView(dataPosition).size() <= currentLeft) {
+        event_.reset( new FRDEventMsgView(dataPosition) );
+        if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < event_->size())
+        {
+          throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+            "Premature end of input file while reading event data";
+        }
+        bool chunkEnd = currentFile_->advance(dataPosition,event_->size());
+        assert(!chunkEnd);
+        eventDataOwner_ = chunkOwner(chunk);
+      }
+      else {
+        auto eventBuffer = std::make_shared<std::vector<unsigned char>>(headerSize);
+        currentFile_->advanceCopying(eventBuffer->data(),headerSize);
+        const uint32_t eventSize = FRDEventMsgView(eventBuffer->data()).size();
+        if (eventSize>eventChunkSize_) {
+          FRDEventMsgView header(eventBuffer->data());
+          throw cms::Exception("FedRawDataInputSource::getNextEvent")
+	          << " event id:"<< header.event()<< " lumi:" << header.lumi()
+	          << " run:" << header.run() << " of size:" << eventSize
+	          << " bytes does not fit into a chunk of size:" << eventChunkSize_ << " bytes";
+        }
+        const uint32_t msgSize = eventSize-headerSize;
+        if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < msgSize)
+        {
+          throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+            "Premature end of input file while reading event data";
+        }
+        eventBuffer->resize(eventSize);
+        currentFile_->advanceCopying(eventBuffer->data()+headerSize,msgSize);
+        event_.reset( new FRDEventMsgView(eventBuffer->data()) );
+        eventDataOwner_ = eventBuffer;
+        //the previous chunk is no longer needed by the source
+        chunkIsFree_ = true;
+      }
+    }
+    else {
+      //check if header is at the boundary of two chunks
+      unsigned char *dataPosition;
 
-    //read header, copy it to a single chunk if necessary
-    bool chunkEnd = currentFile_->advance(dataPosition,FRDHeaderVersionSize[detectedFRDversion_]);
+      //read header, copy it to a single chunk if necessary
+      bool chunkEnd = currentFile_->advance(dataPosition,FRDHeaderVersionSize[detectedFRDversion_]);
 
-    event_.reset( new FRDEventMsgView(dataPosition) );
-    if (event_->size()>eventChunkSize_) {
-      throw cms::Exception("FedRawDataInputSource::getNextEvent")
-	      << " event id:"<< event_->event()<< " lumi:" << event_->lumi()
-	      << " run:" << event_->run() << " of size:" << event_->size()
-	      << " bytes does not fit into a chunk of size:" << eventChunkSize_ << " bytes";
-    }
+      event_.reset( new FRDEventMsgView(dataPosition) );
+      if (event_->size()>eventChunkSize_) {
+        throw cms::Exception("FedRawDataInputSource::getNextEvent")
+	        << " event id:"<< event_->event()<< " lumi:" << event_->lumi()
+	        << " run:" << event_->run() << " of size:" << event_->size()
+	        << " bytes does not fit into a chunk of size:" << eventChunkSize_ << " bytes";
+      }
 
-    const uint32_t msgSize = event_->size()-FRDHeaderVersionSize[detectedFRDversion_];
+      const uint32_t msgSize = event_->size()-FRDHeaderVersionSize[detectedFRDversion_];
 
-    if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < msgSize)
-    {
-      throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
-	"Premature end of input file while reading event data";
-    }
+      if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < msgSize)
+      {
+        throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+	  "Premature end of input file while reading event data";
+      }
 
-    if (chunkEnd) {
-      //header was at the chunk boundary, we will have to move payload as well
-      currentFile_->moveToPreviousChunk(msgSize,FRDHeaderVersionSize[detectedFRDversion_]);
-      chunkIsFree_ = true;
-    }
-    else {
-      //header was contiguous, but check if payload fits the chunk
-      if (eventChunkSize_ - currentFile_->chunkPosition_ < msgSize) {
-	//rewind to header start position
-	currentFile_->rewindChunk(FRDHeaderVersionSize[detectedFRDversion_]);
-	//copy event to a chunk start and move pointers
-	chunkEnd = currentFile_->advance(dataPosition,FRDHeaderVersionSize[detectedFRDversion_]+msgSize);
-	assert(chunkEnd);
-	chunkIsFree_=true;
-	//header is moved
-	event_.reset( new FRDEventMsgView(dataPosition) );
+      if (chunkEnd) {
+        //header was at the chunk boundary, we will have to move payload as well
+        currentFile_->moveToPreviousChunk(msgSize,FRDHeaderVersionSize[detectedFRDversion_]);
+        chunkIsFree_ = true;
       }
       else {
-	//everything is in a single chunk, only move pointers forward
-	chunkEnd = currentFile_->advance(dataPosition,msgSize);
-	assert(!chunkEnd);
-	chunkIsFree_=false;
+        //header was contiguous, but check if payload fits the chunk
+        if (eventChunkSize_ - currentFile_->chunkPosition_ < msgSize) {
+	  //rewind to header start position
+	  currentFile_->rewindChunk(FRDHeaderVersionSize[detectedFRDversion_]);
+	  //copy event to a chunk start and move pointers
+	  chunkEnd = currentFile_->advance(dataPosition,FRDHeaderVersionSize[detectedFRDversion_]+msgSize);
+	  assert(chunkEnd);
+	  chunkIsFree_=true;
+	  //header is moved
+	  event_.reset( new FRDEventMsgView(dataPosition) );
+        }
+        else {
+	  //everything is in a single chunk, only move pointers forward
+	  chunkEnd = currentFile_->advance(dataPosition,msgSize);
+	  assert(!chunkEnd);
+	  chunkIsFree_=false;
+        }
       }
     }
   }//end multibuffer mode
@@ -733,7 +795,7 @@ void FedRawDataInputSource::read(edm::EventPrincipal& eventPrincipal)
     }
 
   }
-  if (chunkIsFree_) freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_-1]);
+  if (chunkIsFree_) releaseChunk(currentFile_->chunks_[currentFile_->currentChunk_-1]);
   chunkIsFree_=false;
   if (fms_) fms_->setInState(evf::FastMonitoringThread::inNoRequest);
   return;
@@ -785,14 +847,36 @@ edm::Timestamp FedRawDataInputSource::fillFEDRawDataCollection(FEDRawDataCollect
       }
     }
     FEDRawData& fedData = rawData.FEDData(fedId);
-    fedData.resize(fedSize);
-    memcpy(fedData.data(), event + eventSize, fedSize);
+    if (zeroCopyFEDRawData_) {
+      fedData = FEDRawData((const unsigned char*)(event + eventSize), fedSize, eventDataOwner_);
+    }
+    else {
+      fedData.resize(fedSize);
+      memcpy(fedData.data(), event + eventSize, fedSize);
+    }
   }
   assert(eventSize == 0);
+  //the FED data now share the ownership of the buffer
+  eventDataOwner_.reset();
 
   return tstamp;
 }
 
+std::shared_ptr<const void> const& FedRawDataInputSource::chunkOwner(InputChunk* chunk)
+{
+  if (!chunk->owner_) {
+    //return the chunk to the readers once neither the source nor any event points into it
+    chunk->owner_ = std::shared_ptr<const void>(chunk->buf_, [this,chunk](const void*) { freeChunks_.push(chunk); });
+  }
+  return chunk->owner_;
+}
+
+void FedRawDataInputSource::releaseChunk(InputChunk* chunk)
+{
+  if (chunk->owner_) chunk->owner_.reset();
+  else freeChunks_.push(chunk);
+}
+
 int FedRawDataInputSource::grabNextJsonFile(boost::filesystem::path const& jsonSourcePath)
 {
   std::string data;
@@ -1039,7 +1123,8 @@ void FedRawDataInputSource::readSupervisor()
         if (fms_) fms_->setInStateSup(evf::FastMonitoringThread::inSupNoFile);
 	dbgcount++;
 	if (!(dbgcount%20)) LogDebug("FedRawDataInputSource") << "No file for me... sleep and try again...";
-	usleep(100000);
+	if (fileListMode_) usleep(100000);
+	else daqDirector_->waitForBUFiles(100000);
       }
     }
     if ( status == evf::EvFDaqDirector::newFile ) {
@@ -1059,6 +1144,15 @@ void FedRawDataInputSource::readSupervisor()
       }
       fileSize=st.st_size;
 
+      //let the kernel start reading the whole file while the reader threads may still be busy with the previous ones
+      if (prefetchFiles_ && fileSize) {
+        int prefetchFd = open(rawFile.c_str(), O_RDONLY);
+        if (prefetchFd>=0) {
+          posix_fadvise(prefetchFd, 0, fileSize, POSIX_FADV_WILLNEED);
+          close(prefetchFd);
+        }
+      }
+
       if (fms_) {
         fms_->setInStateSup(evf::FastMonitoringThread::inSupBusy);
         fms_->stoppedLookingForFile(ls);
@@ -1308,6 +1402,39 @@ inline bool InputFile::advance(unsigned char* & dataPosition, const size_t size)
   }
 }
 
+//copy to a separate buffer, leaving the chunks untouched
+inline bool InputFile::advanceCopying(unsigned char* buffer, const size_t size)
+{
+  //wait for chunk
+  while (!waitForChunk(currentChunk_)) {
+    usleep(100000);
+    if (parent_->exceptionState()) parent_->threadError();
+  }
+
+  size_t currentLeft = chunks_[currentChunk_]->size_ - chunkPosition_;
+
+  if (currentLeft < size) {
+
+    //we need next chunk
+    while (!waitForChunk(currentChunk_+1)) {
+      usleep(100000);
+      if (parent_->exceptionState()) parent_->threadError();
+    }
+    memcpy(buffer, chunks_[currentChunk_]->buf_+chunkPosition_, currentLeft);
+    memcpy(buffer + currentLeft, chunks_[currentChunk_+1]->buf_, size - currentLeft);
+    bufferPosition_+=size;
+    chunkPosition_=size-currentLeft;
+    currentChunk_++;
+    return true;
+  }
+  else {
+    memcpy(buffer, chunks_[currentChunk_]->buf_+chunkPosition_, size);
+    chunkPosition_+=size;
+    bufferPosition_+=size;
+    return false;
+  }
+}
+
 inline void InputFile::moveToPreviousChunk(const size_t size, const size_t offset)
 {
   //this will fail in case of events that are too large
@@ -45,6 +45,17 @@
    });
  }
 \endcode
+
+    Tasks can be given a priority: the waiting task with the lowest priority value runs next,
+ and tasks with the same priority run in the order they were pushed. A resource used by
+ several streams can for instance be given to the oldest event first, by using an increasing
+ event index as the priority
+ \code
+ queue.push([&values,i]{ values.push_back(i);}, i);
+ \endcode
+ so that the events already far along are not held back by newer ones. Tasks pushed without a
+ priority get kLowestPriority: they wait in a plain FIFO queue, run after all the tasks given a
+ priority, and pay nothing for the priority ordering.
 */
 //
 // Original Author:  Chris Jones
@@ -54,9 +65,11 @@
 
 // system include files
 #include <atomic>
+#include <limits>
 
 #include "tbb/task.h"
 #include "tbb/concurrent_queue.h"
+#include "tbb/concurrent_priority_queue.h"
 
 // user include files
 
@@ -65,9 +78,14 @@ namespace edm {
    class SerialTaskQueue
    {
    public:
+      /// lower values run first
+      typedef unsigned long long Priority;
+      static constexpr Priority kLowestPriority = std::numeric_limits<Priority>::max();
+
       SerialTaskQueue():
       m_taskChosen{ATOMIC_FLAG_INIT},
-      m_pauseCount{0}
+      m_pauseCount{0},
+      m_pushCount{0}
       {  }
       
       // ---------- const member functions ---------------------
@@ -107,9 +125,10 @@ namespace edm {
        * process concurrently with the calling thread or wait until the
        * protected resource becomes available or until a CPU becomes available.
        * \param[in] iAction Must be a functor that takes no arguments and return no values.
+       * \param[in] iPriority Tasks with lower values are run first.
        */
       template<typename T>
-      void push(const T& iAction);
+      void push(const T& iAction, Priority iPriority = kLowestPriority);
       
       /// synchronously pushes functor iAction into queue
       /**
@@ -118,9 +137,10 @@ namespace edm {
        * to find another TBB task to execute while waiting for the iAction to finish.
        * In that way the core is not idled while waiting.
        * \param[in] iAction Must be a functor that takes no arguments and return no values.
+       * \param[in] iPriority Tasks with lower values are run first.
        */
       template<typename T>
-      void pushAndWait(const T& iAction);
+      void pushAndWait(const T& iAction, Priority iPriority = kLowestPriority);
       
       /// asynchronously pushes functor iAction into queue and finds next task to execute
       /**
@@ -129,10 +149,11 @@ namespace edm {
        * In that case you can take the return value and return it directly from your execute() method.
        * The function will return immediately and not wait for iAction to run.
        * \param[in] iAction Must be a functor that takes no arguments and return no values.
+       * \param[in] iPriority Tasks with lower values are run first.
        * \return Returns either the next task that the user must schedule with TBB or a nullptr.
        */
       template<typename T>
-      tbb::task* pushAndGetNextTaskToRun(const T& iAction);
+      tbb::task* pushAndGetNextTaskToRun(const T& iAction, Priority iPriority = kLowestPriority);
       
    private:
       SerialTaskQueue(const SerialTaskQueue&) = delete;
@@ -165,42 +186,61 @@ namespace edm {
       
       friend class TaskBase;
       
-      void pushTask(TaskBase*);
-      tbb::task* pushAndGetNextTask(TaskBase*);
+      /** A waiting task, the push count keeps the FIFO order within a priority */
+      struct QueuedEntry {
+         Priority m_priority;
+         unsigned long long m_pushCount;
+         TaskBase* m_task;
+      };
+      /** The entry compared as 'greater' is popped first */
+      struct RunsLater {
+         bool operator()(QueuedEntry const& iLHS, QueuedEntry const& iRHS) const {
+            return iLHS.m_priority > iRHS.m_priority or
+              (iLHS.m_priority == iRHS.m_priority and iLHS.m_pushCount > iRHS.m_pushCount);
+         }
+      };
+      
+      void pushTask(TaskBase*, Priority);
+      tbb::task* pushAndGetNextTask(TaskBase*, Priority);
       tbb::task* finishedTask();
       //returns nullptr if a task is already being processed
       TaskBase* pickNextTask();
+      //the tasks given a priority first, then the FIFO ones
+      bool tryPop(TaskBase*&);
+      bool empty() const { return m_prioritizedTasks.empty() and m_tasks.empty(); }
       
-      void pushAndWait(tbb::empty_task* iWait,TaskBase*);
+      void pushAndWait(tbb::empty_task* iWait,TaskBase*, Priority);
       
       
       // ---------- member data --------------------------------
       tbb::concurrent_queue<TaskBase*> m_tasks;
+      tbb::concurrent_priority_queue<QueuedEntry, RunsLater> m_prioritizedTasks;
       std::atomic_flag m_taskChosen;
       std::atomic<unsigned long> m_pauseCount;
+      std::atomic<unsigned long long> m_pushCount;
    };
    
    template<typename T>
-   void SerialTaskQueue::push(const T& iAction) {
+   void SerialTaskQueue::push(const T& iAction, Priority iPriority) {
       QueuedTask<T>* pTask{ new (tbb::task::allocate_root()) QueuedTask<T>{iAction} };
       pTask->setQueue(this);
-      pushTask(pTask);
+      pushTask(pTask, iPriority);
    }
    
    template<typename T>
-   void SerialTaskQueue::pushAndWait(const T& iAction) {
+   void SerialTaskQueue::pushAndWait(const T& iAction, Priority iPriority) {
       tbb::empty_task* waitTask = new (tbb::task::allocate_root()) tbb::empty_task;
       waitTask->set_ref_count(2);
       QueuedTask<T>* pTask{ new (waitTask->allocate_child()) QueuedTask<T>{iAction} };
       pTask->setQueue(this);
-      pushAndWait(waitTask,pTask);
+      pushAndWait(waitTask,pTask,iPriority);
    }
    
    template<typename T>
-   tbb::task* SerialTaskQueue::pushAndGetNextTaskToRun(const T& iAction) {
+   tbb::task* SerialTaskQueue::pushAndGetNextTaskToRun(const T& iAction, Priority iPriority) {
       QueuedTask<T>* pTask{ new (tbb::task::allocate_root()) QueuedTask<T>{iAction} };
       pTask->setQueue(this);
-      return pushAndGetNextTask(pTask);
+      return pushAndGetNextTask(pTask, iPriority);
    }
    
    inline
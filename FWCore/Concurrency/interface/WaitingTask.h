@@ -30,11 +30,13 @@
 
 namespace edm {
   class WaitingTaskList;
+  class WaitingTaskWithArenaHolder;
   
   class WaitingTask : public tbb::task {
       
    public:
     friend class WaitingTaskList;
+    friend class WaitingTaskWithArenaHolder;
     
     ///Constructor
     WaitingTask() : m_ptr{nullptr} {}
@@ -55,7 +57,7 @@ namespace edm {
     ///Called if waited for task failed
     /**Allows transfer of the exception caused by the dependent task to be
      * moved to another thread.
-     * This method should only be called by WaitingTaskList
+     * This method should only be called by WaitingTaskList or WaitingTaskWithArenaHolder
      */
     void dependentTaskFailed(std::exception_ptr iPtr) {
       if (iPtr and not m_ptr) {
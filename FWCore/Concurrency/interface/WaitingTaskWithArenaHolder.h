@@ -0,0 +1,82 @@
+#ifndef FWCore_Concurrency_WaitingTaskWithArenaHolder_h
+#define FWCore_Concurrency_WaitingTaskWithArenaHolder_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Concurrency
+// Class  :     WaitingTaskWithArenaHolder
+//
+/**\class edm::WaitingTaskWithArenaHolder
+
+ Description: Holds a WaitingTask together with the tbb::task_arena
+ of the thread which created the holder.
+
+ Usage:
+    The holder is passed to code which will finish its work on a thread
+ not controlled by TBB (e.g. a callback from a remote service). When that
+ work is done, doneWaiting() must be called. The WaitingTask is then
+ spawned inside the original task_arena so it runs on one of the framework's
+ threads. The holder is copyable; the task is only released once the last
+ copy has been destroyed or had doneWaiting() called.
+*/
+//
+
+// system include files
+#include <exception>
+#include <memory>
+
+#include "tbb/task_arena.h"
+
+// user include files
+
+// forward declarations
+
+namespace edm {
+
+  class WaitingTask;
+
+  class WaitingTaskWithArenaHolder {
+  public:
+
+    WaitingTaskWithArenaHolder();
+
+    // Note that the arena will be the one containing the thread
+    // that runs this constructor. This is the arena where you
+    // eventually intend for the task to be spawned.
+    explicit WaitingTaskWithArenaHolder(WaitingTask* iTask);
+
+    ~WaitingTaskWithArenaHolder();
+
+    WaitingTaskWithArenaHolder(WaitingTaskWithArenaHolder const& iHolder);
+
+    WaitingTaskWithArenaHolder(WaitingTaskWithArenaHolder&& iOther);
+
+    WaitingTaskWithArenaHolder& operator=(WaitingTaskWithArenaHolder const& iRHS);
+
+    WaitingTaskWithArenaHolder& operator=(WaitingTaskWithArenaHolder&& iRHS);
+
+    // ---------- const member functions ---------------------------
+    bool hasTask() const { return m_task != nullptr; }
+
+    // ---------- member functions ---------------------------
+
+    /** Use in the case where you need to inform the parent task of a
+     * failure before some other child task which may be run later reports
+     * a different, but related failure. You must later call doneWaiting
+     * with same exception later in the same thread.
+     */
+    void presetTaskAsFailed(std::exception_ptr iExcept);
+
+    /** Spawns the task in the arena held by this object once the reference
+     * count reaches zero. Can safely be called from any thread. If called
+     * with a non-null exception_ptr the task is told it failed.
+     */
+    void doneWaiting(std::exception_ptr iExcept);
+
+  private:
+
+    // ---------- member data --------------------------------
+    WaitingTask* m_task;
+    std::shared_ptr<tbb::task_arena> m_arena;
+  };
+}
+#endif
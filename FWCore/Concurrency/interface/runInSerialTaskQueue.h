@@ -0,0 +1,45 @@
+#ifndef FWCore_Concurrency_runInSerialTaskQueue_h
+#define FWCore_Concurrency_runInSerialTaskQueue_h
+// -*- C++ -*-
+//
+// Package:     Concurrency
+// Function:    runInSerialTaskQueue
+// 
+/**\function runInSerialTaskQueue runInSerialTaskQueue.h FWCore/Concurrency/interface/runInSerialTaskQueue.h
+
+ Description: runs a functor in a SerialTaskQueue and waits for it, forwarding its exceptions
+
+ Usage:
+    The tasks of a SerialTaskQueue swallow the exceptions of their functors. This function
+ runs iAction through pushAndWait, and rethrows in the calling thread any exception it threw.
+ While waiting, the calling thread is free to execute other tasks.
+ \code
+ edm::runInSerialTaskQueue(queue, [this, &e]() { write(e); });
+ \endcode
+*/
+//
+
+// system include files
+#include <exception>
+
+// user include files
+#include "FWCore/Concurrency/interface/SerialTaskQueue.h"
+
+namespace edm {
+  template <typename F>
+  void runInSerialTaskQueue(SerialTaskQueue& iQueue, F const& iAction) {
+    std::exception_ptr exception;
+    iQueue.pushAndWait([&iAction, &exception]() {
+      try {
+        iAction();
+      } catch(...) {
+        exception = std::current_exception();
+      }
+    });
+    if(exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+#endif
@@ -20,6 +20,8 @@
 
 using namespace edm;
 
+constexpr SerialTaskQueue::Priority SerialTaskQueue::kLowestPriority;
+
 //
 // member functions
 //
@@ -36,18 +38,22 @@ SerialTaskQueue::resume() {
 }
 
 void
-SerialTaskQueue::pushTask(TaskBase* iTask) {
-  tbb::task* t = pushAndGetNextTask(iTask);
+SerialTaskQueue::pushTask(TaskBase* iTask, Priority iPriority) {
+  tbb::task* t = pushAndGetNextTask(iTask, iPriority);
   if(0!=t) {
     tbb::task::spawn(*t);      
   }
 }
 
 tbb::task* 
-SerialTaskQueue::pushAndGetNextTask(TaskBase* iTask) {
+SerialTaskQueue::pushAndGetNextTask(TaskBase* iTask, Priority iPriority) {
   tbb::task* returnValue{0};
   if likely(0!=iTask) {
-    m_tasks.push(iTask);
+    if likely(iPriority == kLowestPriority) {
+      m_tasks.push(iTask);
+    } else {
+      m_prioritizedTasks.push(QueuedEntry{iPriority, m_pushCount++, iTask});
+    }
     returnValue = pickNextTask();
   }
   return returnValue;
@@ -65,16 +71,16 @@ SerialTaskQueue::pickNextTask() {
   
   if likely(0 == m_pauseCount and not m_taskChosen.test_and_set()) {
     TaskBase* t=0;
-    if likely(m_tasks.try_pop(t)) {
+    if likely(tryPop(t)) {
       return t;
     }
     //no task was actually pulled
     m_taskChosen.clear();
     
     //was a new entry added after we called 'try_pop' but before we did the clear?
-    if(not m_tasks.empty() and not m_taskChosen.test_and_set()) {
+    if(not empty() and not m_taskChosen.test_and_set()) {
       TaskBase* t=0;
-      if(m_tasks.try_pop(t)) {
+      if(tryPop(t)) {
         return t;
       }
       //no task was still pulled since a different thread beat us to it
@@ -85,8 +91,20 @@ SerialTaskQueue::pickNextTask() {
   return 0;
 }
 
-void SerialTaskQueue::pushAndWait(tbb::empty_task* iWait, TaskBase* iTask) {
-   auto nextTask = pushAndGetNextTask(iTask);
+bool
+SerialTaskQueue::tryPop(TaskBase*& oTask) {
+  if unlikely(not m_prioritizedTasks.empty()) {
+    QueuedEntry entry;
+    if(m_prioritizedTasks.try_pop(entry)) {
+      oTask = entry.m_task;
+      return true;
+    }
+  }
+  return m_tasks.try_pop(oTask);
+}
+
+void SerialTaskQueue::pushAndWait(tbb::empty_task* iWait, TaskBase* iTask, Priority iPriority) {
+   auto nextTask = pushAndGetNextTask(iTask, iPriority);
    if likely(nullptr != nextTask) {
      if likely(nextTask == iTask) {
         //spawn and wait for all requires the task to have its parent set
@@ -0,0 +1,90 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Concurrency
+// Class  :     WaitingTaskWithArenaHolder
+//
+// Implementation:
+//     The holder owns one reference count of the task. When the reference
+//  count reaches zero the task is spawned in the arena of the thread which
+//  originally created the holder.
+//
+
+// system include files
+
+// user include files
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
+#include "FWCore/Concurrency/interface/WaitingTask.h"
+
+namespace edm {
+
+  WaitingTaskWithArenaHolder::WaitingTaskWithArenaHolder() :
+    m_task(nullptr) {
+  }
+
+  WaitingTaskWithArenaHolder::WaitingTaskWithArenaHolder(WaitingTask* iTask) :
+    m_task(iTask),
+    m_arena(std::make_shared<tbb::task_arena>(tbb::task_arena::attach())) {
+    m_task->increment_ref_count();
+  }
+
+  WaitingTaskWithArenaHolder::~WaitingTaskWithArenaHolder() {
+    if(m_task) {
+      doneWaiting(std::exception_ptr{});
+    }
+  }
+
+  WaitingTaskWithArenaHolder::WaitingTaskWithArenaHolder(WaitingTaskWithArenaHolder const& iHolder) :
+    m_task(iHolder.m_task),
+    m_arena(iHolder.m_arena) {
+    if(m_task) {
+      m_task->increment_ref_count();
+    }
+  }
+
+  WaitingTaskWithArenaHolder::WaitingTaskWithArenaHolder(WaitingTaskWithArenaHolder&& iOther) :
+    m_task(iOther.m_task),
+    m_arena(std::move(iOther.m_arena)) {
+    iOther.m_task = nullptr;
+  }
+
+  WaitingTaskWithArenaHolder&
+  WaitingTaskWithArenaHolder::operator=(WaitingTaskWithArenaHolder const& iRHS) {
+    WaitingTaskWithArenaHolder tmp(iRHS);
+    std::swap(m_task, tmp.m_task);
+    std::swap(m_arena, tmp.m_arena);
+    return *this;
+  }
+
+  WaitingTaskWithArenaHolder&
+  WaitingTaskWithArenaHolder::operator=(WaitingTaskWithArenaHolder&& iRHS) {
+    WaitingTaskWithArenaHolder tmp(std::move(iRHS));
+    std::swap(m_task, tmp.m_task);
+    std::swap(m_arena, tmp.m_arena);
+    return *this;
+  }
+
+  void
+  WaitingTaskWithArenaHolder::presetTaskAsFailed(std::exception_ptr iExcept) {
+    if(iExcept) {
+      m_task->dependentTaskFailed(iExcept);
+    }
+  }
+
+  void
+  WaitingTaskWithArenaHolder::doneWaiting(std::exception_ptr iExcept) {
+    if(iExcept) {
+      m_task->dependentTaskFailed(iExcept);
+    }
+    //enqueue can run the task before we finish
+    // doneWaiting and some other thread might
+    // try to reuse this object. Resetting
+    // before enqueue avoids problems
+    auto task = m_task;
+    m_task = nullptr;
+    if(0 == task->decrement_ref_count()) {
+      // The enqueue call will cause a worker thread to be created in
+      // the arena if there is not one already.
+      m_arena->enqueue( [task]() { tbb::task::spawn(*task); });
+    }
+  }
+}
@@ -12,6 +12,7 @@
 #include <memory>
 #include <atomic>
 #include <thread>
+#include <vector>
 #include "tbb/task.h"
 #include "FWCore/Concurrency/interface/SerialTaskQueue.h"
 
@@ -20,6 +21,7 @@ class SerialTaskQueue_test : public CppUnit::TestFixture {
   CPPUNIT_TEST(testPush);
   CPPUNIT_TEST(testPushAndWait);
   CPPUNIT_TEST(testPause);
+  CPPUNIT_TEST(testPriority);
   CPPUNIT_TEST(stressTest);
   CPPUNIT_TEST_SUITE_END();
   
@@ -27,6 +29,7 @@ public:
   void testPush();
   void testPushAndWait();
   void testPause();
+  void testPriority();
   void stressTest();
   void setUp(){}
   void tearDown(){}
@@ -154,6 +157,34 @@ namespace {
    }
 }
 
+void SerialTaskQueue_test::testPriority()
+{
+   std::vector<unsigned int> order;
+
+   edm::SerialTaskQueue queue;
+   {
+      queue.pause();
+      std::shared_ptr<tbb::task> waitTask{new (tbb::task::allocate_root()) tbb::empty_task{},
+                                          [](tbb::task* iTask){tbb::task::destroy(*iTask);} };
+      waitTask->set_ref_count(1+6);
+      tbb::task* pWaitTask = waitTask.get();
+
+      //pushed while paused so that they are all waiting when the queue picks the next one
+      queue.push([&order,pWaitTask]{ order.push_back(4); pWaitTask->decrement_ref_count(); });
+      queue.push([&order,pWaitTask]{ order.push_back(2); pWaitTask->decrement_ref_count(); }, 7);
+      queue.push([&order,pWaitTask]{ order.push_back(0); pWaitTask->decrement_ref_count(); }, 3);
+      queue.push([&order,pWaitTask]{ order.push_back(3); pWaitTask->decrement_ref_count(); }, 7);
+      queue.push([&order,pWaitTask]{ order.push_back(1); pWaitTask->decrement_ref_count(); }, 3);
+      queue.push([&order,pWaitTask]{ order.push_back(5); pWaitTask->decrement_ref_count(); });
+      queue.resume();
+      waitTask->wait_for_all();
+   }
+   CPPUNIT_ASSERT(order.size() == 6);
+   for(unsigned int i = 0; i < order.size(); ++i) {
+      CPPUNIT_ASSERT(order[i] == i);
+   }
+}
+
 void SerialTaskQueue_test::stressTest()
 {
    edm::SerialTaskQueue queue;
@@ -116,8 +116,10 @@ namespace fwlite {
     std::vector<edm::BranchDescription> const&
     Strategy::getBranchDescriptions() {
       if(bDesc_.empty()) {
+        bDesc_.reserve(branchDescriptionMap_.size());
         for(auto const& item : branchDescriptionMap_) {
           bDesc_.push_back(item.second);
+          bDesc_.back().initFromDictionary();
         }
       }
       return bDesc_;
@@ -188,8 +190,9 @@ namespace fwlite {
         for(auto& item : prodList) {
           edm::BranchDescription& prod = item.second;
           if(edm::InEvent == prod.branchType()) {
-            // call to regenerate branchName
-            prod.init();
+            // call to regenerate branchName; the dictionaries are only
+            // looked up for the descriptions handed out by getBranchDescriptions
+            prod.initBranchName();
             branchDescriptionMap_.insert(bidToDesc::value_type(prod.branchID(), prod));
           }
         }
@@ -288,7 +291,7 @@ namespace fwlite {
           edm::BranchDescription& prod = item.second;
           if(edm::InEvent == prod.branchType()) {
             // call to regenerate branchName
-            prod.init();
+            prod.initBranchName();
             branchDescriptionMap_.insert(bidToDesc::value_type(prod.branchID(), prod));
           }
         }
@@ -398,7 +401,7 @@ namespace fwlite {
           edm::BranchDescription& prod = item.second;
           if(edm::InEvent == prod.branchType()) {
             // call to regenerate branchName
-            prod.init();
+            prod.initBranchName();
             branchDescriptionMap_.insert(bidToDesc::value_type(prod.branchID(), prod));
 //             std::cout << "v11 updatefile " << prod.branchID() << std::endl;
                 }
@@ -522,7 +525,7 @@ namespace fwlite {
           edm::BranchDescription& prod = item.second;
           if(edm::InEvent == prod.branchType()) {
             // call to regenerate branchName
-            prod.init();
+            prod.initBranchName();
             branchDescriptionMap_.insert(bidToDesc::value_type(prod.branchID(), prod));
 //             std::cout << "v11 updatefile " << prod.branchID() << std::endl;
                 }
@@ -9,6 +9,7 @@ PSet script.   See notes in EventProcessor.cpp for details about it.
 #include "FWCore/MessageLogger/interface/MessageDrop.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetFile.h"
 #include "FWCore/ParameterSet/interface/ProcessDesc.h"
 #include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/PluginManager/interface/PresenceFactory.h"
@@ -53,6 +54,7 @@ static char const* const kSizeOfStackForThreadOpt = "sizeOfStackForThreadsInKB";
 static char const* const kHelpOpt = "help";
 static char const* const kHelpCommandOpt = "help,h";
 static char const* const kStrictOpt = "strict";
+static char const* const kWriteParameterSetOpt = "writeParameterSet";
 
 constexpr unsigned int kDefaultSizeOfStackForThreadsInKB = 10*1024; //10MB
 // -----------------------------------------------
@@ -203,7 +205,9 @@ int main(int argc, char* argv[]) {
    	        "Size of stack in KB to use for extra threads (0 is use system default size)")
         (kMultiThreadMessageLoggerOpt,
                 "MessageLogger handles multiple threads - default is single-thread")
-        (kStrictOpt, "strict parsing");
+        (kStrictOpt, "strict parsing")
+        (kWriteParameterSetOpt, boost::program_options::value<std::string>(),
+                "write the processed configuration to a file which cmsRun can then run without python, and exit");
 
       // anything at the end will be ignored, and sent to python
       boost::program_options::positional_options_description p;
@@ -285,11 +289,25 @@ int main(int argc, char* argv[]) {
       edm::ServiceToken jobReportToken =
         edm::ServiceRegistry::createContaining(jobRep);
 
-      context = "Processing the python configuration file named ";
-      context += fileName;
       std::shared_ptr<edm::ProcessDesc> processDesc;
       try {
-        std::shared_ptr<edm::ParameterSet> parameterSet = edm::readConfig(fileName, argc, argv);
+        std::shared_ptr<edm::ParameterSet> parameterSet;
+        if(edm::isParameterSetFile(fileName)) {
+          context = "Reading the ParameterSet file named ";
+          context += fileName;
+          if(vm.count(kPythonOpt)) {
+            edm::LogSystem("CommandLineProcessing") << "The options after a ParameterSet file are ignored, the configuration was processed when the file was written";
+          }
+          parameterSet = edm::readParameterSetFile(fileName);
+        } else {
+          context = "Processing the python configuration file named ";
+          context += fileName;
+          parameterSet = edm::readConfig(fileName, argc, argv);
+        }
+        if(vm.count(kWriteParameterSetOpt)) {
+          edm::writeParameterSetFile(*parameterSet, vm[kWriteParameterSetOpt].as<std::string>());
+          return 0;
+        }
         processDesc.reset(new edm::ProcessDesc(parameterSet));
       }
       catch(cms::Exception& iException) {
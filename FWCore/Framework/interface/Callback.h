@@ -19,6 +19,7 @@
 //
 
 // system include files
+#include <memory>
 #include <vector>
 // user include files
 #include "FWCore/Framework/interface/produce_helpers.h"
@@ -103,6 +104,23 @@ namespace edm {
          void newRecordComing() {
             wasCalledForThisRecord_ = false;
          }
+
+         /**returns the Callback used by the Proxies of the IOV slot iovIndex. Since the Callback
+          holds the data of its Proxies, each slot after the first gets its own copy calling the same producer method.
+          */
+         std::shared_ptr<Callback>& callbackForIOV(std::shared_ptr<Callback>& iThis, unsigned int iovIndex) {
+            if(0 == iovIndex) {
+               return iThis;
+            }
+            if(iovCallbacks_.size() < iovIndex) {
+               iovCallbacks_.resize(iovIndex);
+            }
+            std::shared_ptr<Callback>& callback = iovCallbacks_[iovIndex-1];
+            if(!callback) {
+               callback = std::make_shared<Callback>(get_underlying(producer_), method_, decorator_);
+            }
+            return callback;
+         }
          
      private:
          Callback(const Callback&); // stop default
@@ -114,7 +132,15 @@ namespace edm {
          method_type method_;
          bool wasCalledForThisRecord_;
          TDecorator decorator_;
+         std::vector<std::shared_ptr<Callback>> iovCallbacks_;
       };
+
+      //used by ProxyArgumentFactoryTemplate so the Proxies of each IOV slot share a Callback of their own
+      template<typename T, typename TReturn, typename TRecord, typename TDecorator>
+      inline std::shared_ptr<Callback<T, TReturn, TRecord, TDecorator>>&
+      argumentForIOV(std::shared_ptr<Callback<T, TReturn, TRecord, TDecorator>>& iCallback, unsigned int iovIndex) {
+         return iCallback->callbackForIOV(iCallback, iovIndex);
+      }
    }
 }
 
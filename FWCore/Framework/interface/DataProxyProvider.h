@@ -46,7 +46,9 @@ class DataProxyProvider
    public:   
       typedef std::vector< EventSetupRecordKey> Keys;
       typedef std::vector<std::pair<DataKey, edm::propagate_const<std::shared_ptr<DataProxy>>>> KeyedProxies;
-      typedef std::map<EventSetupRecordKey, KeyedProxies> RecordProxies;
+      ///one set of Proxies for each IOV of the Record which can be in flight at the same time
+      typedef std::vector<KeyedProxies> KeyedProxiesVector;
+      typedef std::map<EventSetupRecordKey, KeyedProxiesVector> RecordProxies;
       
       DataProxyProvider();
       virtual ~DataProxyProvider() noexcept(false);
@@ -56,7 +58,10 @@ class DataProxyProvider
       
       std::set<EventSetupRecordKey> usingRecords() const;
       
-      const KeyedProxies& keyedProxies(const EventSetupRecordKey& iRecordKey) const ;
+      const KeyedProxies& keyedProxies(const EventSetupRecordKey& iRecordKey, unsigned int iovIndex = 0) const ;
+
+      ///returns true if the Proxies made for each IOV slot are independent of each other
+      virtual bool concurrentIOVsSupported() const { return false; }
       
       const ComponentDescription& description() const { return description_;}
       // ---------- static member functions --------------------
@@ -69,6 +74,13 @@ class DataProxyProvider
       ///called when a new interval of validity occurs for iRecordType
       virtual void newInterval(const EventSetupRecordKey& iRecordType,
                                 const ValidityInterval& iInterval) = 0;
+
+      /**called when a new interval of validity occurs for iRecordType and its data will be held
+        by the Proxies of the IOV slot iovIndex. The default calls newInterval.
+      */
+      virtual void newIntervalForIOV(const EventSetupRecordKey& iRecordType,
+                                     const ValidityInterval& iInterval,
+                                     unsigned int iovIndex);
       
       void setDescription(const ComponentDescription& iDescription) {
          description_ = iDescription;
@@ -79,8 +91,12 @@ class DataProxyProvider
       **/
       void setAppendToDataLabel(const edm::ParameterSet&);
       
+      ///makes room for the Proxies of iNumberOfIOVs IOV slots, the number of slots is never reduced
+      void resizeKeyedProxiesVector(const EventSetupRecordKey& iRecordType, unsigned int iNumberOfIOVs);
+
       void resetProxies(const EventSetupRecordKey& iRecordType);
       void resetProxiesIfTransient(const EventSetupRecordKey& iRecordType);
+      void resetProxiesIfTransient(const EventSetupRecordKey& iRecordType, unsigned int iovIndex);
 
    protected:
       template< class T>
@@ -91,9 +107,17 @@ class DataProxyProvider
       void usingRecordWithKey(const EventSetupRecordKey&);
 
       void invalidateProxies(const EventSetupRecordKey& iRecordKey) ;
+      void invalidateProxies(const EventSetupRecordKey& iRecordKey, unsigned int iovIndex) ;
 
       virtual void registerProxies(const EventSetupRecordKey& iRecordKey ,
                                     KeyedProxies& aProxyList) = 0 ;
+
+      /**registers the Proxies of the IOV slot iovIndex. The default calls registerProxies,
+        which is only correct if the inheriting class does not support concurrent IOVs.
+      */
+      virtual void registerProxiesForIOV(const EventSetupRecordKey& iRecordKey,
+                                         KeyedProxies& aProxyList,
+                                         unsigned int iovIndex);
       
       ///deletes all the Proxies in aStream
       void eraseAll(const EventSetupRecordKey& iRecordKey) ;
@@ -84,6 +84,8 @@ class ESProxyFactoryProducer : public eventsetup::DataProxyProvider
       virtual ~ESProxyFactoryProducer() noexcept(false);
 
       // ---------- const member functions ---------------------
+      ///the factories make a new set of Proxies for each IOV slot
+      virtual bool concurrentIOVsSupported() const { return true; }
 
       // ---------- static member functions --------------------
 
@@ -92,11 +94,21 @@ class ESProxyFactoryProducer : public eventsetup::DataProxyProvider
       virtual void newInterval(const eventsetup::EventSetupRecordKey& iRecordType,
                                 const ValidityInterval& iInterval) ;
 
+      ///overrides DataProxyProvider method, only the Proxies of the slot iovIndex are invalidated
+      virtual void newIntervalForIOV(const eventsetup::EventSetupRecordKey& iRecordType,
+                                     const ValidityInterval& iInterval,
+                                     unsigned int iovIndex);
+
    protected:
       ///override DataProxyProvider method
       virtual void registerProxies(const eventsetup::EventSetupRecordKey& iRecord ,
                                     KeyedProxies& aProxyList) ;
 
+      ///override DataProxyProvider method
+      virtual void registerProxiesForIOV(const eventsetup::EventSetupRecordKey& iRecord,
+                                         KeyedProxies& aProxyList,
+                                         unsigned int iovIndex);
+
       /** \param iFactory unique_ptr holding a new instance of a Factory
          \param iLabel extra string label used to get data (optional)
          Producer takes ownership of the Factory and uses it create the appropriate
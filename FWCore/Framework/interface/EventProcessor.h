@@ -51,6 +51,7 @@ namespace edm {
   class ThinnedAssociationsHelper;
   class EDLooperBase;
   class HistoryAppender;
+  class NumaStreamArenas;
   class ProcessDesc;
   class SubProcess;
   namespace eventsetup {
@@ -281,6 +282,8 @@ namespace edm {
     edm::propagate_const<std::unique_ptr<Schedule>> schedule_;
     edm::propagate_const<std::unique_ptr<std::vector<SubProcess>>> subProcesses_;
     edm::propagate_const<std::unique_ptr<HistoryAppender>> historyAppender_;
+    //when set, each Stream processes its events in the arena of a NUMA node
+    edm::propagate_const<std::unique_ptr<NumaStreamArenas>> numaStreamArenas_;
 
     edm::propagate_const<std::unique_ptr<FileBlock>> fb_;
     edm::propagate_const<std::shared_ptr<EDLooperBase>> looper_;
@@ -303,6 +306,7 @@ namespace edm {
     bool                                          forceLooperToEnd_;
     bool                                          looperBeginJobRun_;
     bool                                          forceESCacheClearOnNewRun_;
+    bool                                          concurrentSubProcesses_;
 
     int                                           numberOfForkedChildren_;
     unsigned int                                  numberOfSequentialEventsPerChild_;
@@ -68,7 +68,13 @@ class EventSetupProvider {
       // ---------- member functions ---------------------------
       EventSetup const& eventSetupForInstance(IOVSyncValue const&);
 
-      EventSetup const& eventSetup() const {return eventSetup_;}
+      EventSetup const& eventSetup() const {return *eventSetups_[currentEventSetup_];}
+
+      /**Sets how many IOVs of each Record can be in use at the same time. When a Record moves to
+         a new IOV, eventSetupForInstance fills another EventSetup so the one still used by the
+         transitions of the previous IOV keeps its Records. Must be called before finishConfiguration.*/
+      void setNumberOfConcurrentIOVs(unsigned int iNumberOfIOVs);
+      unsigned int numberOfConcurrentIOVs() const { return eventSetups_.size(); }
 
       //called by specializations of EventSetupRecordProviders
       void addRecordToEventSetup(EventSetupRecord& iRecord);
@@ -124,7 +130,8 @@ class EventSetupProvider {
       void insert(EventSetupRecordKey const&, std::unique_ptr<EventSetupRecordProvider>);
 
       // ---------- member data --------------------------------
-      EventSetup eventSetup_;
+      std::vector<std::unique_ptr<EventSetup>> eventSetups_;
+      unsigned int currentEventSetup_;
       typedef std::map<EventSetupRecordKey, std::shared_ptr<EventSetupRecordProvider> > Providers;
       Providers providers_;
       std::unique_ptr<EventSetupKnownRecordsSupplier> knownRecordsSupplier_;
@@ -186,6 +186,8 @@ namespace edm {
                   DataProxy const* iProxy) ;
          void clearProxies();
          void cacheReset() ;
+         /// used when moving to another IOV slot, the cacheIdentifier continues from the one of the Record of the previous IOV
+         void cacheResetFollowing(EventSetupRecord const& iPreviousIOVRecord) ;
          /// returns 'true' if a transient request has occurred since the last call to transientReset.
          bool transientReset() ;
 
@@ -57,6 +57,12 @@ class EventSetupRecordProvider {
       }
       EventSetupRecordKey const& key() const { return key_; }      
 
+      ///number of IOVs of the Record which can be in use at the same time, each has its own Record and Proxies
+      unsigned int numberOfConcurrentIOVs() const { return numberOfConcurrentIOVs_; }
+
+      ///the IOV slot holding the current validityInterval
+      unsigned int iovIndex() const { return iovIndex_; }
+
       ///Returns the list of Records the provided Record depends on (usually none)
       virtual std::set<EventSetupRecordKey> dependentRecords() const;
       
@@ -83,6 +89,11 @@ class EventSetupRecordProvider {
       ///For now, only use one finder
       void addFinder(std::shared_ptr<EventSetupRecordIntervalFinder>);
       void setValidityInterval(ValidityInterval const&);
+
+      /**Sets how many IOVs can be in use at the same time. Must be called after all providers have
+         been added and before usePreferred. Only one is used unless all the DataProxyProviders of the
+         Record make separate Proxies for each IOV.*/
+      void setNumberOfConcurrentIOVs(unsigned int iNumberOfIOVs);
       
       ///sets interval to this time and returns true if have a valid interval for time
       bool setValidityIntervalFor(IOVSyncValue const&);
@@ -113,7 +124,12 @@ class EventSetupRecordProvider {
                               DataToPreferredProviderMap const&);
       void cacheReset();
    
-      virtual EventSetupRecord& record() = 0;
+      EventSetupRecord& record() { return recordForIOV(iovIndex_); }
+
+      virtual EventSetupRecord& recordForIOV(unsigned int iovIndex) = 0;
+
+      ///ensures there are at least iNumberOfIOVs Records
+      virtual void resizeRecords(unsigned int iNumberOfIOVs) = 0;
       
       std::shared_ptr<EventSetupRecordIntervalFinder> swapFinder(std::shared_ptr<EventSetupRecordIntervalFinder> iNew) {
         std::swap(iNew, finder());
@@ -134,6 +150,8 @@ class EventSetupRecordProvider {
       std::vector<edm::propagate_const<std::shared_ptr<DataProxyProvider>>> providers_;
       std::unique_ptr<std::vector<edm::propagate_const<std::shared_ptr<EventSetupRecordIntervalFinder>>>> multipleFinders_;
       bool lastSyncWasBeginOfRun_;
+      unsigned int numberOfConcurrentIOVs_;
+      unsigned int iovIndex_;
 };
    }
 }
@@ -20,6 +20,8 @@
 //
 
 // system include files
+#include <memory>
+#include <vector>
 #include "boost/type_traits/is_base_and_derived.hpp"
 #include "boost/mpl/begin_end.hpp"
 #include "boost/mpl/deref.hpp"
@@ -86,11 +88,13 @@ namespace edm {
          typedef T RecordType;
          typedef EventSetupRecordProvider    BaseType;
          
-         EventSetupRecordProviderTemplate() : BaseType(EventSetupRecordKey::makeKey<T>()), record_() {}
+         EventSetupRecordProviderTemplate() : BaseType(EventSetupRecordKey::makeKey<T>()), records_() {
+            resizeRecords(1);
+         }
          //virtual ~EventSetupRecordProviderTemplate();
          
          // ---------- const member functions ---------------------
-         EventSetupRecord const& record() const {return record_;}
+         EventSetupRecord const& record() const {return *records_[this->iovIndex()];}
          
          // ---------- static member functions --------------------
          
@@ -99,7 +103,13 @@ namespace edm {
             return findDependentRecordsFor<T>();
          }
       protected:
-         EventSetupRecord& record() { return record_; }
+         EventSetupRecord& recordForIOV(unsigned int iovIndex) { return *records_[iovIndex]; }
+
+         void resizeRecords(unsigned int iNumberOfIOVs) {
+            while(records_.size() < iNumberOfIOVs) {
+               records_.push_back(std::make_unique<T>());
+            }
+         }
          
       private:
          EventSetupRecordProviderTemplate(EventSetupRecordProviderTemplate const&); // stop default
@@ -107,7 +117,7 @@ namespace edm {
          EventSetupRecordProviderTemplate const& operator=(EventSetupRecordProviderTemplate const&); // stop default
          
          // ---------- member data --------------------------------
-         T record_;
+         std::vector<std::unique_ptr<T>> records_;
       };
       
    }
@@ -34,6 +34,7 @@ pointer to a ProductResolver, when queried.
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -175,6 +176,11 @@ namespace edm {
 
     DelayedReader* reader() const {return reader_;}
 
+    // Set while several SubProcesses read this Principal at the same time: the
+    // products they read or produce on demand are then resolved one at a time.
+    std::recursive_mutex* sharedReadMutex() const {return sharedReadMutex_;}
+    void setSharedReadMutex(std::recursive_mutex* mutex) {sharedReadMutex_ = mutex;}
+
     ConstProductResolverPtr getProductResolver(BranchID const& oid) const;
 
     ProductData const* findProductByTag(TypeID const& typeID, InputTag const& tag, ModuleCallingContext const* mcc) const;
@@ -295,6 +301,9 @@ namespace edm {
     
     CacheIdentifier_t cacheIdentifier_;
 
+    // Not owned, null unless the SubProcesses are run concurrently
+    std::recursive_mutex* sharedReadMutex_;
+
   };
 
   template <typename PROD>
@@ -29,7 +29,14 @@
 // forward declarations
 namespace edm {
    namespace eventsetup {
-      
+
+//By default the Proxies of all the IOV slots are constructed from the same argument.
+// Arguments holding per IOV state (e.g. the Callback of an ESProducer) provide an overload
+template <class ArgT>
+inline ArgT& argumentForIOV(ArgT& iArg, unsigned int /*iovIndex*/) {
+   return iArg;
+}
+
 template <class T, class ArgT>
 class ProxyArgumentFactoryTemplate : public ProxyFactoryBase
 {
@@ -41,8 +48,8 @@ class ProxyArgumentFactoryTemplate : public ProxyFactoryBase
       //virtual ~ProxyArgumentFactoryTemplate()
 
       // ---------- const member functions ---------------------
-      virtual std::unique_ptr<DataProxy> makeProxy() const {
-         return std::make_unique<T>(arg_);
+      virtual std::unique_ptr<DataProxy> makeProxy(unsigned int iovIndex) const {
+         return std::make_unique<T>(argumentForIOV(arg_, iovIndex));
       }
             
       virtual DataKey makeKey(const std::string& iName) const {
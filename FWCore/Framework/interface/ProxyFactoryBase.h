@@ -37,7 +37,8 @@ class ProxyFactoryBase
       virtual ~ProxyFactoryBase() {}
 
       // ---------- const member functions ---------------------
-      virtual std::unique_ptr<DataProxy> makeProxy() const = 0;
+      ///makes the Proxy used by the IOV slot iovIndex of its Record, each slot gets its own Proxy
+      virtual std::unique_ptr<DataProxy> makeProxy(unsigned int iovIndex) const = 0;
       
       virtual DataKey makeKey(const std::string& iName) const = 0;
       // ---------- static member functions --------------------
@@ -41,7 +41,7 @@ class ProxyFactoryTemplate : public ProxyFactoryBase
       //virtual ~ProxyFactoryTemplate();
 
       // ---------- const member functions ---------------------
-      virtual std::unique_ptr<DataProxy> makeProxy() const {
+      virtual std::unique_ptr<DataProxy> makeProxy(unsigned int /*iovIndex*/) const {
          return std::make_unique<T>();
       }
       
@@ -70,6 +70,12 @@ namespace edm {
 
     void doEvent(EventPrincipal const& principal);
 
+    // Runs the event in each of the SubProcesses, all at the same time if concurrently
+    // is set. It returns once all of them are done, throwing the first exception seen.
+    static void doEventInSubProcesses(std::vector<SubProcess>& subProcesses,
+                                      EventPrincipal& principal,
+                                      bool concurrently);
+
     void doBeginRun(RunPrincipal const& principal, IOVSyncValue const& ts);
 
     void doEndRun(RunPrincipal const& principal, IOVSyncValue const& ts, bool cleaningUpAfterException);
@@ -326,6 +332,7 @@ namespace edm {
 
     //EventSelection
     bool wantAllEvents_;
+    bool concurrentSubProcesses_;
     ParameterSetID selector_config_id_;
     mutable detail::TriggerResultsBasedEventSelector selectors_;
 
@@ -22,6 +22,7 @@
 #include <memory>
 
 // user include files
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/RunIndex.h"
@@ -115,20 +116,23 @@ namespace edm {
         LuminosityBlockCacheHolder( LuminosityBlockCacheHolder<T,C> const&) = delete;
         LuminosityBlockCacheHolder<T,C>& operator=(LuminosityBlockCacheHolder<T,C> const&) = delete;
       protected:
-        C const* luminosityBlockCache(edm::LuminosityBlockIndex iID) const { return cache_.get(); }
+        C const* luminosityBlockCache(edm::LuminosityBlockIndex iID) const { return caches_[iID].get(); }
       private:
-        void doBeginLuminosityBlock_(LuminosityBlock const& rp, EventSetup const& c) override final {
-          cache_ = globalBeginLuminosityBlock(rp,c);
+        void preallocLumis(unsigned int iNLumis) override final {
+          caches_.reset(new std::shared_ptr<C>[iNLumis]);
         }
-        void doEndLuminosityBlock_(LuminosityBlock const& rp, EventSetup const& c) override final {
-          globalEndLuminosityBlock(rp,c);
-          cache_.reset();
+        void doBeginLuminosityBlock_(LuminosityBlock const& lp, EventSetup const& c) override final {
+          caches_[lp.index()] = globalBeginLuminosityBlock(lp,c);
+        }
+        void doEndLuminosityBlock_(LuminosityBlock const& lp, EventSetup const& c) override final {
+          globalEndLuminosityBlock(lp,c);
+          caches_[lp.index()].reset();
         }
         
         virtual std::shared_ptr<C> globalBeginLuminosityBlock(edm::LuminosityBlock const&, edm::EventSetup const&) const = 0;
         virtual void globalEndLuminosityBlock(edm::LuminosityBlock const&, edm::EventSetup const&) const = 0;
-        //When threaded we will have a container for N items whre N is # of simultaneous runs
-        std::shared_ptr<C> cache_;
+        //One entry per simultaneous LuminosityBlock, indexed by LuminosityBlockIndex
+        std::unique_ptr<std::shared_ptr<C>[]> caches_;
       };
       
       template<typename T, typename C> class EndRunSummaryProducer;
@@ -172,17 +176,22 @@ namespace edm {
         LuminosityBlockSummaryCacheHolder<T,C>& operator=(LuminosityBlockSummaryCacheHolder<T,C> const&) = delete;
       private:
         friend class EndLuminosityBlockSummaryProducer<T,C>;
-        
+
+        void preallocLumisSummary(unsigned int iNLumis) override final {
+          caches_.reset(new std::shared_ptr<C>[iNLumis]);
+        }
+
         void doBeginLuminosityBlockSummary_(edm::LuminosityBlock const& lb, EventSetup const& c) override final {
-          cache_ = globalBeginLuminosityBlockSummary(lb,c);
+          caches_[lb.index()] = globalBeginLuminosityBlockSummary(lb,c);
         }
 
         virtual void doStreamEndLuminosityBlockSummary_(StreamID id, LuminosityBlock const& lb, EventSetup const& c) override final
         {
-          streamEndLuminosityBlockSummary(id,lb,c,cache_.get());
+          //NOTE: in future this will need to be serialized
+          streamEndLuminosityBlockSummary(id,lb,c,caches_[lb.index()].get());
         }
         void doEndLuminosityBlockSummary_(LuminosityBlock const& lb, EventSetup const& c) override final {
-          globalEndLuminosityBlockSummary(lb,c,cache_.get());
+          globalEndLuminosityBlockSummary(lb,c,caches_[lb.index()].get());
         }
 
         virtual std::shared_ptr<C> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&, edm::EventSetup const&) const = 0;
@@ -190,8 +199,8 @@ namespace edm {
         
         virtual void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&, edm::EventSetup const&, C*) const = 0;
         
-        //When threaded we will have a container for N items where N is # of simultaneous Lumis
-        std::shared_ptr<C> cache_;
+        //One entry per simultaneous LuminosityBlock, indexed by LuminosityBlockIndex
+        std::unique_ptr<std::shared_ptr<C>[]> caches_;
       };
 
       
@@ -271,11 +280,30 @@ namespace edm {
         
       private:
         void doEndLuminosityBlockProduce_(LuminosityBlock& lb, EventSetup const& c) override final {
-          globalEndLuminosityBlockProduce(lb,c,LuminosityBlockSummaryCacheHolder<T,S>::cache_.get());
+          globalEndLuminosityBlockProduce(lb,c,LuminosityBlockSummaryCacheHolder<T,S>::caches_[lb.index()].get());
         }
         
         virtual void globalEndLuminosityBlockProduce(edm::LuminosityBlock&, edm::EventSetup const&, S const*) const = 0;
       };
+
+      template <typename T>
+      class ExternalWork : public virtual T {
+      public:
+        ExternalWork() = default;
+        ExternalWork( ExternalWork const&) = delete;
+        ExternalWork& operator=(ExternalWork const&) = delete;
+
+      private:
+        bool hasAcquire() const override final { return true; }
+
+        void doAcquire_(StreamID id, Event const& ev, EventSetup const& es,
+                        WaitingTaskWithArenaHolder& holder) override final {
+          acquire(id, ev, es, holder);
+        }
+
+        ///Called before produce. The holder must be notified, possibly from another thread, once the work is done
+        virtual void acquire(StreamID, Event const&, edm::EventSetup const&, WaitingTaskWithArenaHolder) const = 0;
+      };
     }
   }
 }
@@ -77,6 +77,11 @@ namespace edm {
         static constexpr bool kEndLuminosityBlockProducer = true;
       };
       
+      template<typename... U>
+      struct HasAbility<edm::ExternalWork, U...> :public HasAbility<U...> {
+        static constexpr bool kExternalWork = true;
+      };
+
       template<>
       struct HasAbility<LastCheck> {
         static constexpr bool kGlobalCache = false;
@@ -88,6 +93,7 @@ namespace edm {
         static constexpr bool kEndRunProducer = false;
         static constexpr bool kBeginLuminosityBlockProducer = false;
         static constexpr bool kEndLuminosityBlockProducer = false;
+        static constexpr bool kExternalWork = false;
       };
     }
     template<typename... T>
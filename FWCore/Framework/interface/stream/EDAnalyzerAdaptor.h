@@ -85,6 +85,11 @@ namespace edm {
         m_pset= nullptr;
       }
 
+      void preallocLumis(unsigned int iNLumis) override final {
+        m_lumis.resize(iNLumis);
+        m_lumiSummaries.resize(iNLumis);
+      }
+
       void doEndJob() override final {
         MyGlobal::endJob(m_global.get());
       }
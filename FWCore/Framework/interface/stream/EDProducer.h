@@ -29,6 +29,14 @@
 // forward declarations
 namespace edm {
   namespace stream {
+    namespace impl {
+      inline void doAcquireIfNeeded(ExternalWork* base, Event const& ev, EventSetup const& es,
+                                    WaitingTaskWithArenaHolder& holder) {
+        base->acquire(ev, es, holder);
+      }
+      inline void doAcquireIfNeeded(void*, Event const&, EventSetup const&, WaitingTaskWithArenaHolder&) {}
+    }
+
     template< typename... T>
     class EDProducer : public AbilityToImplementor<T>::Type...,
                        public EDProducerBase
@@ -63,6 +71,12 @@ namespace edm {
       EDProducer(const EDProducer&) = delete; // stop default
       
       const EDProducer& operator=(const EDProducer&) = delete; // stop default
+
+      bool hasAcquire() const override final { return HasAbility::kExternalWork; }
+
+      void doAcquire_(Event const& ev, EventSetup const& es, WaitingTaskWithArenaHolder& holder) override final {
+        impl::doAcquireIfNeeded(this, ev, es, holder);
+      }
       
       // ---------- member data --------------------------------
       
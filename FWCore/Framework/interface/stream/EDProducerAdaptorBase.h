@@ -36,6 +36,7 @@ namespace edm {
 
   class ModuleCallingContext;
   class ActivityRegistry;
+  class WaitingTaskWithArenaHolder;
   
   namespace maker {
     template<typename T> class ModuleHolderT;
@@ -70,6 +71,11 @@ namespace edm {
       bool doEvent(EventPrincipal const& ep, EventSetup const& c,
                    ActivityRegistry*,
                    ModuleCallingContext const*) ;
+      void doAcquire(EventPrincipal const& ep, EventSetup const& c,
+                     ActivityRegistry*,
+                     ModuleCallingContext const*,
+                     WaitingTaskWithArenaHolder&);
+      bool hasAcquire() const;
     };
   }
 }
@@ -33,6 +33,7 @@ namespace edm {
   template<typename T> class WorkerT;
   class ProductRegistry;
   class ThinnedAssociationsHelper;
+  class WaitingTaskWithArenaHolder;
 
   namespace stream {
     class EDProducerAdaptorBase;
@@ -67,6 +68,8 @@ namespace edm {
       virtual void beginRun(edm::Run const&, edm::EventSetup const&) {}
       virtual void beginLuminosityBlock(edm::LuminosityBlock const&, edm::EventSetup const&) {}
       virtual void produce(Event&, EventSetup const&) = 0;
+      virtual bool hasAcquire() const { return false; }
+      virtual void doAcquire_(Event const&, EventSetup const&, WaitingTaskWithArenaHolder&) {}
       virtual void endLuminosityBlock(edm::LuminosityBlock const&, edm::EventSetup const&) {}
       virtual void endRun(edm::Run const&, edm::EventSetup const&) {}
       virtual void endStream(){}
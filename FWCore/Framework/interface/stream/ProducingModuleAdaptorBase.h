@@ -123,6 +123,7 @@ namespace edm {
 
       void doPreallocate(PreallocationConfiguration const&);
       virtual void setupStreamModules() = 0;
+      virtual void preallocLumis(unsigned int) {}
       void doBeginJob();
       virtual void doEndJob() = 0;
       
@@ -22,6 +22,7 @@
 #include <memory>
 
 // user include files
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/RunIndex.h"
@@ -142,6 +143,17 @@ namespace edm {
         ///requires the following be defined in the inheriting class
         ///static void globalEndLuminosityBlockProduce(edm::LuminosityBlock&, edm::EventSetup const&, LuminosityBlockContext const*)
       };
+
+      class ExternalWork {
+      public:
+        ExternalWork() = default;
+        ExternalWork( ExternalWork const&) = delete;
+        ExternalWork& operator=(ExternalWork const&) = delete;
+        virtual ~ExternalWork() {}
+
+        ///Called before produce. The holder must be notified, possibly from another thread, once the work is done
+        virtual void acquire(Event const&, edm::EventSetup const&, WaitingTaskWithArenaHolder) = 0;
+      };
     }
   }
 }
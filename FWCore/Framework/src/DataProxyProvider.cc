@@ -64,14 +64,37 @@ DataProxyProvider::~DataProxyProvider() noexcept(false)
 void 
 DataProxyProvider::usingRecordWithKey(const EventSetupRecordKey& iKey)
 {
-   recordProxies_[iKey];
+   //always provide the Proxies for at least one IOV
+   KeyedProxiesVector& proxiesVector = recordProxies_[iKey];
+   if(proxiesVector.empty()) {
+      proxiesVector.resize(1);
+   }
    //keys_.push_back(iKey);
 }
 
+void
+DataProxyProvider::resizeKeyedProxiesVector(const EventSetupRecordKey& iKey, unsigned int iNumberOfIOVs)
+{
+   RecordProxies::iterator itFind = recordProxies_.find(iKey);
+   assert(itFind != recordProxies_.end());
+   if(itFind->second.size() < iNumberOfIOVs) {
+      itFind->second.resize(iNumberOfIOVs);
+   }
+}
+
 void 
 DataProxyProvider::invalidateProxies(const EventSetupRecordKey& iRecordKey) 
 {
-   KeyedProxies& proxyList((*(recordProxies_.find(iRecordKey))).second) ;
+   KeyedProxiesVector& proxiesVector((*(recordProxies_.find(iRecordKey))).second) ;
+   for(unsigned int iovIndex = 0; iovIndex < proxiesVector.size(); ++iovIndex) {
+      invalidateProxies(iRecordKey, iovIndex);
+   }
+}
+
+void 
+DataProxyProvider::invalidateProxies(const EventSetupRecordKey& iRecordKey, unsigned int iovIndex) 
+{
+   KeyedProxies& proxyList((*(recordProxies_.find(iRecordKey))).second.at(iovIndex)) ;
    KeyedProxies::iterator finished(proxyList.end()) ;
    for (KeyedProxies::iterator keyedProxy(proxyList.begin()) ;
          keyedProxy != finished ;
@@ -90,7 +113,16 @@ DataProxyProvider::resetProxies(const EventSetupRecordKey& iRecordKey)
 void 
 DataProxyProvider::resetProxiesIfTransient(const EventSetupRecordKey& iRecordKey) 
 {
-   KeyedProxies& proxyList((*(recordProxies_.find(iRecordKey))).second) ;
+   KeyedProxiesVector& proxiesVector((*(recordProxies_.find(iRecordKey))).second) ;
+   for(unsigned int iovIndex = 0; iovIndex < proxiesVector.size(); ++iovIndex) {
+      resetProxiesIfTransient(iRecordKey, iovIndex);
+   }
+}
+
+void 
+DataProxyProvider::resetProxiesIfTransient(const EventSetupRecordKey& iRecordKey, unsigned int iovIndex) 
+{
+   KeyedProxies& proxyList((*(recordProxies_.find(iRecordKey))).second.at(iovIndex)) ;
    KeyedProxies::iterator finished(proxyList.end()) ;
    for (KeyedProxies::iterator keyedProxy(proxyList.begin()) ;
         keyedProxy != finished ;
@@ -100,6 +132,22 @@ DataProxyProvider::resetProxiesIfTransient(const EventSetupRecordKey& iRecordKey
    
 }
       
+void
+DataProxyProvider::newIntervalForIOV(const EventSetupRecordKey& iRecordType,
+                                     const ValidityInterval& iInterval,
+                                     unsigned int /*iovIndex*/)
+{
+   newInterval(iRecordType, iInterval);
+}
+
+void
+DataProxyProvider::registerProxiesForIOV(const EventSetupRecordKey& iRecordKey,
+                                         KeyedProxies& aProxyList,
+                                         unsigned int /*iovIndex*/)
+{
+   registerProxies(iRecordKey, aProxyList);
+}
+
 void
 DataProxyProvider::setAppendToDataLabel(const edm::ParameterSet& iToAppend)
 {
@@ -136,16 +184,18 @@ DataProxyProvider::usingRecords() const
 }   
 
 const DataProxyProvider::KeyedProxies& 
-DataProxyProvider::keyedProxies(const EventSetupRecordKey& iRecordKey) const
+DataProxyProvider::keyedProxies(const EventSetupRecordKey& iRecordKey, unsigned int iovIndex) const
 {
    RecordProxies::const_iterator itFind = recordProxies_.find(iRecordKey);
    assert(itFind != recordProxies_.end());
+   assert(iovIndex < itFind->second.size());
    
-   if(itFind->second.empty()) {
+   if(itFind->second[iovIndex].empty()) {
       //delayed registration
-      KeyedProxies& proxies = const_cast<KeyedProxies&>(itFind->second);
-      const_cast<DataProxyProvider*>(this)->registerProxies(iRecordKey,
-                                                            proxies);
+      KeyedProxies& proxies = const_cast<KeyedProxies&>(itFind->second[iovIndex]);
+      const_cast<DataProxyProvider*>(this)->registerProxiesForIOV(iRecordKey,
+                                                                  proxies,
+                                                                  iovIndex);
 
       bool mustChangeLabels = (0 != appendToDataLabel_.size());
       for(KeyedProxies::iterator itProxy = proxies.begin(), itProxyEnd = proxies.end();
@@ -164,7 +214,7 @@ DataProxyProvider::keyedProxies(const EventSetupRecordKey& iRecordKey) const
       }
    }
    
-   return itFind->second;
+   return itFind->second[iovIndex];
 }
 
 //
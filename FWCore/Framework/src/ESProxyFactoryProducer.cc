@@ -67,12 +67,20 @@ ESProxyFactoryProducer::~ESProxyFactoryProducer()
 void
 ESProxyFactoryProducer::registerProxies(const EventSetupRecordKey& iRecord,
                                        KeyedProxies& iProxies)
+{
+   registerProxiesForIOV(iRecord, iProxies, 0);
+}
+
+void
+ESProxyFactoryProducer::registerProxiesForIOV(const EventSetupRecordKey& iRecord,
+                                             KeyedProxies& iProxies,
+                                             unsigned int iovIndex)
 {
    typedef Record2Factories::iterator Iterator;
    std::pair< Iterator, Iterator > range = record2Factories_.equal_range(iRecord);
    for(Iterator it = range.first; it != range.second; ++it) {
       
-      std::shared_ptr<DataProxy> proxy(it->second.factory_->makeProxy().release());
+      std::shared_ptr<DataProxy> proxy(it->second.factory_->makeProxy(iovIndex).release());
       if(nullptr != proxy.get()) {
          iProxies.push_back(KeyedProxies::value_type((*it).second.key_,
                                          proxy));
@@ -121,6 +129,15 @@ ESProxyFactoryProducer::newInterval(const EventSetupRecordKey& iRecordType,
    invalidateProxies(iRecordType);
 }
 
+void
+ESProxyFactoryProducer::newIntervalForIOV(const EventSetupRecordKey& iRecordType,
+                                         const ValidityInterval& /*iInterval*/,
+                                         unsigned int iovIndex)
+{
+   //the Proxies of the other slots may still be in use by the previous IOVs
+   invalidateProxies(iRecordType, iovIndex);
+}
+
 //
 // const member functions
 //
@@ -0,0 +1,46 @@
+#ifndef FWCore_Framework_EventAcquireSignalsSentry_h
+#define FWCore_Framework_EventAcquireSignalsSentry_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     EventAcquireSignalsSentry
+// 
+/**\class edm::EventAcquireSignalsSentry EventAcquireSignalsSentry.h "EventAcquireSignalsSentry.h"
+
+ Description: Guarantees that the pre/post module Event acquire signals are sent
+
+ Usage:
+    <usage>
+
+*/
+//
+
+// system include files
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+
+// user include files
+
+// forward declarations
+namespace edm {
+  class EventAcquireSignalsSentry {
+
+  public:
+    EventAcquireSignalsSentry(ActivityRegistry* iReg,
+                              ModuleCallingContext const * iContext) :
+      m_reg(iReg),
+      m_context(iContext)
+    { iReg->preModuleEventAcquireSignal_( *(iContext->getStreamContext()), *iContext);}
+    
+    ~EventAcquireSignalsSentry() {
+      m_reg->postModuleEventAcquireSignal_( *(m_context->getStreamContext()), *m_context);
+    }
+    
+  private:
+    // ---------- member data --------------------------------
+    ActivityRegistry* m_reg; // We do not use propagate_const because the registry itself is mutable.
+    ModuleCallingContext const* m_context;
+  };
+}
+
+#endif
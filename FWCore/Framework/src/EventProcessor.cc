@@ -31,6 +31,7 @@
 #include "FWCore/Framework/src/EPStates.h"
 #include "FWCore/Framework/src/EventSetupsController.h"
 #include "FWCore/Framework/src/InputSourceFactory.h"
+#include "FWCore/Framework/src/NumaStreamArenas.h"
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
@@ -40,6 +41,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescriptionFillerPluginFactory.h"
 #include "FWCore/ParameterSet/interface/ProcessDesc.h"
 #include "FWCore/ParameterSet/interface/Registry.h"
+#include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/PythonParameterSet/interface/PythonProcessDesc.h"
 
 #include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
@@ -109,6 +111,36 @@ namespace {
 
     
   };
+
+  //Reads the plugin files of the services and of the modules of the configuration in parallel,
+  // before they are loaded one at a time while the components are made
+  void prefetchPlugins(edm::ParameterSet const& iPSet, std::vector<edm::ParameterSet> const& iServices) {
+    if(not edmplugin::PluginManager::isAvailable()) {
+      return;
+    }
+    auto const* pm = edmplugin::PluginManager::get();
+    auto typesOf = [&iPSet](char const* iLabels) {
+      std::vector<std::string> types;
+      if(iPSet.existsAs<std::vector<std::string> >(iLabels)) {
+        for(auto const& label : iPSet.getParameter<std::vector<std::string> >(iLabels)) {
+          types.push_back(iPSet.getParameterSet(label).getParameter<std::string>("@module_type"));
+        }
+      }
+      return types;
+    };
+    pm->prefetch("CMS EDM Framework Module", typesOf("@all_modules"));
+    pm->prefetch("CMS EDM Framework ESModule", typesOf("@all_esmodules"));
+    pm->prefetch("CMS EDM Framework ESSource", typesOf("@all_essources"));
+    if(iPSet.existsAs<edm::ParameterSet>("@main_input")) {
+      pm->prefetch("CMS EDM Framework InputSource",
+                   std::vector<std::string>(1, iPSet.getParameterSet("@main_input").getParameter<std::string>("@module_type")));
+    }
+    std::vector<std::string> services;
+    for(auto const& service : iServices) {
+      services.push_back(service.getParameter<std::string>("@service_type"));
+    }
+    pm->prefetch("CMS EDM Framework Service", services);
+  }
 }
 
 namespace edm {
@@ -248,6 +280,7 @@ namespace edm {
     forceLooperToEnd_(false),
     looperBeginJobRun_(false),
     forceESCacheClearOnNewRun_(false),
+    concurrentSubProcesses_(false),
     numberOfForkedChildren_(0),
     numberOfSequentialEventsPerChild_(1),
     setCpuAffinity_(false),
@@ -289,6 +322,7 @@ namespace edm {
     forceLooperToEnd_(false),
     looperBeginJobRun_(false),
     forceESCacheClearOnNewRun_(false),
+    concurrentSubProcesses_(false),
     numberOfForkedChildren_(0),
     numberOfSequentialEventsPerChild_(1),
     setCpuAffinity_(false),
@@ -333,6 +367,7 @@ namespace edm {
     forceLooperToEnd_(false),
     looperBeginJobRun_(false),
     forceESCacheClearOnNewRun_(false),
+    concurrentSubProcesses_(false),
     numberOfForkedChildren_(0),
     numberOfSequentialEventsPerChild_(1),
     setCpuAffinity_(false),
@@ -373,6 +408,7 @@ namespace edm {
     forceLooperToEnd_(false),
     looperBeginJobRun_(false),
     forceESCacheClearOnNewRun_(false),
+    concurrentSubProcesses_(false),
     numberOfForkedChildren_(0),
     numberOfSequentialEventsPerChild_(1),
     setCpuAffinity_(false),
@@ -415,6 +451,7 @@ namespace edm {
     fileMode_ = optionsPset.getUntrackedParameter<std::string>("fileMode", "");
     emptyRunLumiMode_ = optionsPset.getUntrackedParameter<std::string>("emptyRunLumiMode", "");
     forceESCacheClearOnNewRun_ = optionsPset.getUntrackedParameter<bool>("forceEventSetupCacheClearOnNewRun", false);
+    concurrentSubProcesses_ = optionsPset.getUntrackedParameter<bool>("concurrentSubProcesses", false);
     //threading
     unsigned int nThreads=1;
     if(optionsPset.existsAs<unsigned int>("numberOfThreads",false)) {
@@ -442,6 +479,9 @@ namespace edm {
     nConcurrentRuns = optionsPset.getUntrackedParameter<unsigned int>("numberOfConcurrentRuns");
     }
      */
+    //NOTE: the lumi caches and the PrincipalCache are indexed by LuminosityBlockIndex
+    // but the global lumi transitions are still run one after the other, so the
+    // option is not read until the state machine can overlap them
     unsigned int nConcurrentLumis =1;
     /*
     if(optionsPset.existsAs<unsigned int>("numberOfConcurrentLuminosityBlocks",false)) {
@@ -462,6 +502,14 @@ namespace edm {
       //bad
     }
      */
+    //the number of IOVs of each EventSetup Record which can be in use at the same time
+    unsigned int nConcurrentIOVs =1;
+    if(optionsPset.existsAs<unsigned int>("numberOfConcurrentIOVs",false)) {
+      nConcurrentIOVs = optionsPset.getUntrackedParameter<unsigned int>("numberOfConcurrentIOVs");
+      if(nConcurrentIOVs==0) {
+        nConcurrentIOVs = nConcurrentLumis;
+      }
+    }
     //forking
     ParameterSet const& forking = optionsPset.getUntrackedParameterSet("multiProcesses", ParameterSet());
     numberOfForkedChildren_ = forking.getUntrackedParameter<int>("maxChildProcesses", 0);
@@ -476,6 +524,10 @@ namespace edm {
                                                 std::make_pair(itPS->getUntrackedParameter<std::string>("type", "*"),
                                                                itPS->getUntrackedParameter<std::string>("label", "")));
     }
+    if(numberOfForkedChildren_ > 0) {
+      //each forked child processes its own luminosity blocks one at a time
+      nConcurrentIOVs = 1;
+    }
     IllegalParameters::setThrowAnException(optionsPset.getUntrackedParameter<bool>("throwIfIllegalParameter", true));
 
     // Now do general initialization
@@ -483,6 +535,9 @@ namespace edm {
 
     //initialize the services
     std::shared_ptr<std::vector<ParameterSet> > pServiceSets = processDesc->getServicesPSets();
+    if(optionsPset.getUntrackedParameter<bool>("prefetchPlugins", false)) {
+      prefetchPlugins(*parameterSet, *pServiceSets);
+    }
     ServiceToken token = items.initServices(*pServiceSets, *parameterSet, iToken, iLegacy, true);
     serviceToken_ = items.addCPRandTNS(*parameterSet, token);
 
@@ -498,6 +553,7 @@ namespace edm {
     std::shared_ptr<CommonParams> common(items.initMisc(*parameterSet));
 
     // intialize the event setup provider
+    espController_->setNumberOfConcurrentIOVs(nConcurrentIOVs);
     esp_ = espController_->makeProvider(*parameterSet);
 
     // initialize the looper, if any
@@ -514,6 +570,17 @@ namespace edm {
     
     preallocations_ = PreallocationConfiguration{nThreads,nStreams,nConcurrentLumis,nConcurrentRuns};
 
+    if(optionsPset.getUntrackedParameter<bool>("numaAwareStreams", false) and nStreams>1) {
+      numaStreamArenas_ = std::make_unique<NumaStreamArenas>(nThreads,nStreams);
+      if(numaStreamArenas_->empty()) {
+        LogInfo("NumaAwareStreams") << "Only one NUMA node is available, the streams are not bound to nodes";
+        numaStreamArenas_ = nullptr;
+      } else {
+        LogInfo("NumaAwareStreams") << "The " << nStreams << " streams are shared out over "
+                                    << numaStreamArenas_->numberOfNodes() << " NUMA nodes";
+      }
+    }
+
     // initialize the input source
     input_ = makeInput(*parameterSet,
                        *common,
@@ -940,41 +1007,46 @@ namespace edm {
       IOVSyncValue ts(EventID(input_->runAuxiliary()->run(), 0, 0),
                       input_->runAuxiliary()->beginTime());
       espController_->eventSetupForInstance(ts);
-      EventSetup const& es = esp_->eventSetup();
-
-      //now get all the data available in the EventSetup
-      std::vector<eventsetup::EventSetupRecordKey> recordKeys;
-      es.fillAvailableRecordKeys(recordKeys);
-      std::vector<eventsetup::DataKey> dataKeys;
-      for(std::vector<eventsetup::EventSetupRecordKey>::const_iterator itKey = recordKeys.begin(), itEnd = recordKeys.end();
-          itKey != itEnd;
-          ++itKey) {
-        eventsetup::EventSetupRecord const* recordPtr = es.find(*itKey);
-        //see if this is on our exclusion list
-        ExcludedDataMap::const_iterator itExcludeRec = eventSetupDataToExcludeFromPrefetching_.find(itKey->type().name());
-        ExcludedData const* excludedData(nullptr);
-        if(itExcludeRec != eventSetupDataToExcludeFromPrefetching_.end()) {
-          excludedData = &(itExcludeRec->second);
-          if(excludedData->size() == 0 || excludedData->begin()->first == "*") {
-            //skip all items in this record
-            continue;
-          }
-        }
-        if(0 != recordPtr) {
-          dataKeys.clear();
-          recordPtr->fillRegisteredDataKeys(dataKeys);
-          for(std::vector<eventsetup::DataKey>::const_iterator itDataKey = dataKeys.begin(), itDataKeyEnd = dataKeys.end();
-              itDataKey != itDataKeyEnd;
-              ++itDataKey) {
-            //std::cout << "  " << itDataKey->type().name() << " " << itDataKey->name().value() << std::endl;
-            if(0 != excludedData && excludedData->find(std::make_pair(itDataKey->type().name(), itDataKey->name().value())) != excludedData->end()) {
-              LogInfo("ForkingEventSetupPreFetching") << "   excluding:" << itDataKey->type().name() << " " << itDataKey->name().value() << std::endl;
+
+      //now get all the data available in the EventSetup of this process and of
+      // its SubProcesses, so that the children share it with the parent. The
+      // components shared between the providers are only fetched once.
+      for(auto const& provider : espController_->providers()) {
+        EventSetup const& es = provider->eventSetup();
+
+        std::vector<eventsetup::EventSetupRecordKey> recordKeys;
+        es.fillAvailableRecordKeys(recordKeys);
+        std::vector<eventsetup::DataKey> dataKeys;
+        for(std::vector<eventsetup::EventSetupRecordKey>::const_iterator itKey = recordKeys.begin(), itEnd = recordKeys.end();
+            itKey != itEnd;
+            ++itKey) {
+          eventsetup::EventSetupRecord const* recordPtr = es.find(*itKey);
+          //see if this is on our exclusion list
+          ExcludedDataMap::const_iterator itExcludeRec = eventSetupDataToExcludeFromPrefetching_.find(itKey->type().name());
+          ExcludedData const* excludedData(nullptr);
+          if(itExcludeRec != eventSetupDataToExcludeFromPrefetching_.end()) {
+            excludedData = &(itExcludeRec->second);
+            if(excludedData->size() == 0 || excludedData->begin()->first == "*") {
+              //skip all items in this record
               continue;
             }
-            try {
-              recordPtr->doGet(*itDataKey);
-            } catch(cms::Exception& e) {
-             LogWarning("ForkingEventSetupPreFetching") << e.what();
+          }
+          if(0 != recordPtr) {
+            dataKeys.clear();
+            recordPtr->fillRegisteredDataKeys(dataKeys);
+            for(std::vector<eventsetup::DataKey>::const_iterator itDataKey = dataKeys.begin(), itDataKeyEnd = dataKeys.end();
+                itDataKey != itDataKeyEnd;
+                ++itDataKey) {
+              //std::cout << "  " << itDataKey->type().name() << " " << itDataKey->name().value() << std::endl;
+              if(0 != excludedData && excludedData->find(std::make_pair(itDataKey->type().name(), itDataKey->name().value())) != excludedData->end()) {
+                LogInfo("ForkingEventSetupPreFetching") << "   excluding:" << itDataKey->type().name() << " " << itDataKey->name().value() << std::endl;
+                continue;
+              }
+              try {
+                recordPtr->doGet(*itDataKey);
+              } catch(cms::Exception& e) {
+               LogWarning("ForkingEventSetupPreFetching") << e.what();
+              }
             }
           }
         }
@@ -1882,7 +1954,7 @@ namespace edm {
         << "Run is invalid\n"
         << "Contact a Framework Developer\n";
     }
-    auto lbp = std::make_shared<LuminosityBlockPrincipal>(input_->luminosityBlockAuxiliary(), preg(), *processConfiguration_, historyAppender_.get(), 0);
+    auto lbp = std::make_shared<LuminosityBlockPrincipal>(input_->luminosityBlockAuxiliary(), preg(), *processConfiguration_, historyAppender_.get(), principalCache_.availableLumiIndex());
     {
       SendSourceTerminationSignalIfException sentry(actReg_.get());
       input_->readLuminosityBlock(*lbp, *historyAppender_);
@@ -2059,13 +2131,29 @@ namespace edm {
     
     const unsigned int kNumStreams = preallocations_.numberOfStreams();
     unsigned int iStreamIndex = 0;
-    for(; iStreamIndex<kNumStreams-1; ++iStreamIndex) {
-      eventLoopWaitTask->increment_ref_count();
-      tbb::task::enqueue( *(new (tbb::task::allocate_root()) StreamProcessingTask{this,iStreamIndex, &finishedProcessingEvents, eventLoopWaitTask}));
+    if(numaStreamArenas_) {
+      //the tasks of a Stream stay in the arena of its node, this thread
+      // processes the last Stream in its arena and then waits for the others
+      for(; iStreamIndex<kNumStreams-1; ++iStreamIndex) {
+        eventLoopWaitTask->increment_ref_count();
+        numaStreamArenas_->arenaOfStream(iStreamIndex).enqueue([this,iStreamIndex,&finishedProcessingEvents,eventLoopWaitTask]() {
+            processEventsForStreamAsync(iStreamIndex,&finishedProcessingEvents);
+            eventLoopWaitTask->decrement_ref_count();
+          });
+      }
+      numaStreamArenas_->arenaOfStream(iStreamIndex).execute([this,iStreamIndex,&finishedProcessingEvents]() {
+          processEventsForStreamAsync(iStreamIndex,&finishedProcessingEvents);
+        });
+      eventLoopWaitTask->wait_for_all();
+    } else {
+      for(; iStreamIndex<kNumStreams-1; ++iStreamIndex) {
+        eventLoopWaitTask->increment_ref_count();
+        tbb::task::enqueue( *(new (tbb::task::allocate_root()) StreamProcessingTask{this,iStreamIndex, &finishedProcessingEvents, eventLoopWaitTask}));
 
+      }
+      eventLoopWaitTask->increment_ref_count();
+      eventLoopWaitTask->spawn_and_wait_for_all(*(new (tbb::task::allocate_root()) StreamProcessingTask{this,iStreamIndex,&finishedProcessingEvents,eventLoopWaitTask}));
     }
-    eventLoopWaitTask->increment_ref_count();
-    eventLoopWaitTask->spawn_and_wait_for_all(*(new (tbb::task::allocate_root()) StreamProcessingTask{this,iStreamIndex,&finishedProcessingEvents,eventLoopWaitTask}));
     tbb::task::destroy(*eventLoopWaitTask);
     
     //One of the processing threads saw an exception
@@ -2104,9 +2192,7 @@ namespace edm {
       typedef OccurrenceTraits<EventPrincipal, BranchActionStreamBegin> Traits;
       schedule_->processOneEvent<Traits>(iStreamIndex,*pep, es);
       if(hasSubProcesses()) {
-        for(auto& subProcess : *subProcesses_) {
-          subProcess.doEvent(*pep);
-        }
+        SubProcess::doEventInSubProcesses(*subProcesses_, *pep, concurrentSubProcesses_);
       }
     }
 
@@ -63,7 +63,8 @@ namespace edm {
 // constructors and destructor
 //
 EventSetupProvider::EventSetupProvider(unsigned subProcessIndex, const PreferredProviderInfo* iInfo) :
-eventSetup_(),
+eventSetups_(),
+currentEventSetup_(0),
 providers_(),
 knownRecordsSupplier_( std::make_unique<KnownRecordsSupplierImpl>(providers_)),
 mustFinishConfiguration_(true),
@@ -77,7 +78,7 @@ psetIDToRecordKey_(new std::map<ParameterSetIDHolder, std::set<EventSetupRecordK
 recordToPreferred_(new std::map<EventSetupRecordKey, std::map<DataKey, ComponentDescription> >),
 recordsWithALooperProxy_(new std::set<EventSetupRecordKey>)
 {
-  eventSetup_.setKnownRecordsSupplier(knownRecordsSupplier_.get());
+  setNumberOfConcurrentIOVs(1);
 }
 
 // EventSetupProvider::EventSetupProvider(const EventSetupProvider& rhs)
@@ -112,6 +113,22 @@ EventSetupProvider::insert(const EventSetupRecordKey& iKey, std::unique_ptr<Even
    //temp->addRecordTo(*this);
 }
 
+void
+EventSetupProvider::setNumberOfConcurrentIOVs(unsigned int iNumberOfIOVs)
+{
+   assert(mustFinishConfiguration_);
+   if(0 == iNumberOfIOVs) {
+      iNumberOfIOVs = 1;
+   }
+   //EventSetup's constructor is only available to us so we can not use make_unique
+   while(eventSetups_.size() < iNumberOfIOVs) {
+      eventSetups_.emplace_back(new EventSetup());
+      eventSetups_.back()->setKnownRecordsSupplier(knownRecordsSupplier_.get());
+   }
+   eventSetups_.resize(iNumberOfIOVs);
+   currentEventSetup_ = 0;
+}
+
 void 
 EventSetupProvider::add(std::shared_ptr<DataProxyProvider> iProvider)
 {
@@ -355,6 +372,8 @@ EventSetupProvider::finishConfiguration()
       if(itRecordFound != recordToPreferred_->end()) {
          preferredInfo = &(itRecordFound->second);
       }
+      //the Records of each IOV slot get their Proxies in usePreferred
+      itProvider->second->setNumberOfConcurrentIOVs(eventSetups_.size());
       //Give it our list of preferred 
       itProvider->second->usePreferred(*preferredInfo);
       
@@ -734,8 +753,9 @@ EventSetupProvider::clearInitializationData() {
 
 void
 EventSetupProvider::addRecordToEventSetup(EventSetupRecord& iRecord) {
-   iRecord.setEventSetup(&eventSetup_);
-   eventSetup_.add(iRecord);
+   EventSetup& eventSetup = *eventSetups_[currentEventSetup_];
+   iRecord.setEventSetup(&eventSetup);
+   eventSetup.add(iRecord);
 }
       
 //
@@ -744,10 +764,6 @@ EventSetupProvider::addRecordToEventSetup(EventSetupRecord& iRecord) {
 EventSetup const&
 EventSetupProvider::eventSetupForInstance(const IOVSyncValue& iValue)
 {
-   eventSetup_.setIOVSyncValue(iValue);
-
-   eventSetup_.clear();
-
    // In a cmsRun job this does nothing because the EventSetupsController
    // will have already called finishConfiguration, but some tests will
    // call finishConfiguration here.
@@ -755,12 +771,41 @@ EventSetupProvider::eventSetupForInstance(const IOVSyncValue& iValue)
       finishConfiguration();
    }
 
+   //If any Record moved to a new IOV (or appeared or disappeared) the next EventSetup is filled,
+   // the current one stays as it is for the transitions of the previous IOVs still using it
+   EventSetup const& previousEventSetup = *eventSetups_[currentEventSetup_];
+   std::vector<bool> validRecords;
+   validRecords.reserve(providers_.size());
+   bool recordsChanged = false;
    for(Providers::iterator itProvider = providers_.begin(), itProviderEnd = providers_.end();
         itProvider != itProviderEnd;
         ++itProvider) {
-      itProvider->second->addRecordToIfValid(*this, iValue);
+      bool valid = itProvider->second->setValidityIntervalFor(iValue);
+      validRecords.push_back(valid);
+      EventSetupRecord const* previousRecord = previousEventSetup.find(itProvider->first);
+      if(valid != (nullptr != previousRecord) ||
+         (valid && previousRecord->validityInterval().first() != itProvider->second->validityInterval().first())) {
+         recordsChanged = true;
+      }
+   }
+   if(recordsChanged) {
+      currentEventSetup_ = (currentEventSetup_ + 1) % eventSetups_.size();
+   }
+
+   EventSetup& eventSetup = *eventSetups_[currentEventSetup_];
+   eventSetup.setIOVSyncValue(iValue);
+
+   eventSetup.clear();
+
+   std::vector<bool>::const_iterator itValid = validRecords.begin();
+   for(Providers::iterator itProvider = providers_.begin(), itProviderEnd = providers_.end();
+        itProvider != itProviderEnd;
+        ++itProvider, ++itValid) {
+      if(*itValid) {
+         itProvider->second->addRecordTo(*this);
+      }
    }   
-   return eventSetup_;
+   return eventSetup;
 }
 
 namespace {
@@ -155,6 +155,13 @@ EventSetupRecord::cacheReset()
    ++cacheIdentifier_;
 }
 
+void
+EventSetupRecord::cacheResetFollowing(const EventSetupRecord& iPreviousIOVRecord)
+{
+   transientAccessRequested_ = false;
+   cacheIdentifier_ = iPreviousIOVRecord.cacheIdentifier_ + 1;
+}
+
 bool
 EventSetupRecord::transientReset()
 {
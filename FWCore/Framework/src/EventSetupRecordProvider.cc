@@ -45,7 +45,9 @@ namespace edm {
 EventSetupRecordProvider::EventSetupRecordProvider(const EventSetupRecordKey& iKey) : key_(iKey),
     validityInterval_(), finder_(), providers_(),
     multipleFinders_(new std::vector<edm::propagate_const<std::shared_ptr<EventSetupRecordIntervalFinder>>>()),
-    lastSyncWasBeginOfRun_(true)
+    lastSyncWasBeginOfRun_(true),
+    numberOfConcurrentIOVs_(1),
+    iovIndex_(0)
 {
 }
 
@@ -105,6 +107,26 @@ EventSetupRecordProvider::setValidityInterval(const ValidityInterval& iInterval)
    validityInterval_ = iInterval;
 }
 
+void
+EventSetupRecordProvider::setNumberOfConcurrentIOVs(unsigned int iNumberOfIOVs)
+{
+   //Proxies shared between IOV slots would lose the data of the older IOVs
+   for(auto const& provider : providers_) {
+      if(!provider->concurrentIOVsSupported()) {
+         iNumberOfIOVs = 1;
+         break;
+      }
+   }
+   if(0 == iNumberOfIOVs) {
+      iNumberOfIOVs = 1;
+   }
+   numberOfConcurrentIOVs_ = iNumberOfIOVs;
+   resizeRecords(numberOfConcurrentIOVs_);
+   for(auto& provider : providers_) {
+      provider->resizeKeyedProxiesVector(key_, numberOfConcurrentIOVs_);
+   }
+}
+
 void 
 EventSetupRecordProvider::setDependentProviders(const std::vector< std::shared_ptr<EventSetupRecordProvider> >& iProviders)
 {
@@ -140,21 +162,24 @@ EventSetupRecordProvider::addProxiesToRecord(std::shared_ptr<DataProxyProvider>
    typedef DataProxyProvider::KeyedProxies ProxyList ;
    typedef EventSetupRecordProvider::DataToPreferredProviderMap PreferredMap;
    
-   EventSetupRecord& rec = record();
-   const ProxyList& keyedProxies(iProvider->keyedProxies(this->key())) ;
-   ProxyList::const_iterator finishedProxyList(keyedProxies.end()) ;
-   for (ProxyList::const_iterator keyedProxy(keyedProxies.begin()) ;
-        keyedProxy != finishedProxyList ;
-        ++keyedProxy) {
-      PreferredMap::const_iterator itFound = iMap.find(keyedProxy->first);
-      if(iMap.end() != itFound) {
-         if( itFound->second.type_ != keyedProxy->second->providerDescription()->type_ ||
-            itFound->second.label_ != keyedProxy->second->providerDescription()->label_ ) {
-            //this is not the preferred provider
-            continue;
+   //each IOV slot has its own Record using the Proxies made for that slot
+   for(unsigned int iovIndex = 0; iovIndex < numberOfConcurrentIOVs_; ++iovIndex) {
+      EventSetupRecord& rec = recordForIOV(iovIndex);
+      const ProxyList& keyedProxies(iProvider->keyedProxies(this->key(), iovIndex)) ;
+      ProxyList::const_iterator finishedProxyList(keyedProxies.end()) ;
+      for (ProxyList::const_iterator keyedProxy(keyedProxies.begin()) ;
+           keyedProxy != finishedProxyList ;
+           ++keyedProxy) {
+         PreferredMap::const_iterator itFound = iMap.find(keyedProxy->first);
+         if(iMap.end() != itFound) {
+            if( itFound->second.type_ != keyedProxy->second->providerDescription()->type_ ||
+               itFound->second.label_ != keyedProxy->second->providerDescription()->label_ ) {
+               //this is not the preferred provider
+               continue;
+            }
          }
+         rec.add((*keyedProxy).first , (*keyedProxy).second.get()) ;
       }
-      rec.add((*keyedProxy).first , (*keyedProxy).second.get()) ;
    }
 }
       
@@ -172,9 +197,10 @@ void
 EventSetupRecordProvider::resetTransients()
 {
 
-   using std::placeholders::_1;
    if(checkResetTransients())  {
-      for_all(providers_, std::bind(&DataProxyProvider::resetProxiesIfTransient,_1,key_)); 
+      for(auto& provider : providers_) {
+         provider->resetProxiesIfTransient(key_, iovIndex_);
+      }
    }
 }
 
@@ -213,11 +239,19 @@ EventSetupRecordProvider::setValidityIntervalFor(const IOVSyncValue& iTime)
          returnValue = true;
          //did we actually change?
          if(oldFirst != validityInterval_.first()) {
+            //the new IOV goes to the next slot, leaving the Record and Proxies
+            // of the previous IOV untouched for the transitions still using them
+            EventSetupRecord const& previousRecord = record();
+            iovIndex_ = (iovIndex_ + 1) % numberOfConcurrentIOVs_;
             //tell all Providers to update
             for(auto& provider : providers_) {
-               provider->newInterval(key_, validityInterval_);
+               provider->newIntervalForIOV(key_, validityInterval_, iovIndex_);
+            }
+            if(&previousRecord == &record()) {
+               cacheReset();
+            } else {
+               record().cacheResetFollowing(previousRecord);
             }
-            cacheReset();
          }
       }
    }
@@ -233,7 +267,9 @@ EventSetupRecordProvider::resetProxies()
    //some proxies only clear if they were accessed transiently,
    // since resetProxies resets that flag, calling resetTransients
    // will force a clear
-   for_all(providers_, std::bind(&DataProxyProvider::resetProxiesIfTransient,_1,key_)); 
+   for(auto& provider : providers_) {
+      provider->resetProxiesIfTransient(key_);
+   }
 
 }
 
@@ -250,7 +286,9 @@ EventSetupRecordProvider::fillReferencedDataKeys(std::map<DataKey, ComponentDesc
 void
 EventSetupRecordProvider::resetRecordToProxyPointers(DataToPreferredProviderMap const& iMap) {
    using std::placeholders::_1;
-   record().clearProxies();
+   for(unsigned int iovIndex = 0; iovIndex < numberOfConcurrentIOVs_; ++iovIndex) {
+      recordForIOV(iovIndex).clearProxies();
+   }
    for_all(providers_, std::bind(&EventSetupRecordProvider::addProxiesToRecordHelper, this, _1, iMap));
 }
 
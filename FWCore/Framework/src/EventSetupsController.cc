@@ -25,7 +25,7 @@
 namespace edm {
   namespace eventsetup {
 
-    EventSetupsController::EventSetupsController() : mustFinishConfiguration_(true) {
+    EventSetupsController::EventSetupsController() : mustFinishConfiguration_(true), numberOfConcurrentIOVs_(1) {
     }
 
     std::shared_ptr<EventSetupProvider>
@@ -35,6 +35,7 @@ namespace edm {
       // Also parses the prefer information from ParameterSets and puts
       // it in a map that is stored in the EventSetupProvider
       std::shared_ptr<EventSetupProvider> returnValue(makeEventSetupProvider(iPSet, providers_.size()) );
+      returnValue->setNumberOfConcurrentIOVs(numberOfConcurrentIOVs_);
 
       // Construct the ESProducers and ESSources
       // shared_ptrs to them are temporarily stored in this
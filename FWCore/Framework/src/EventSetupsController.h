@@ -76,6 +76,9 @@ namespace edm {
 
          std::shared_ptr<EventSetupProvider> makeProvider(ParameterSet&);
 
+         ///applies to the EventSetupProviders made after the call
+         void setNumberOfConcurrentIOVs(unsigned int iNumberOfIOVs) { numberOfConcurrentIOVs_ = iNumberOfIOVs; }
+
          void eventSetupForInstance(IOVSyncValue const& syncValue);
 
          void forceCacheClear() const;
@@ -147,6 +150,7 @@ namespace edm {
          std::multimap<ParameterSetID, ESSourceInfo> essources_;
 
          bool mustFinishConfiguration_;
+         unsigned int numberOfConcurrentIOVs_;
       };
    }
 }
@@ -0,0 +1,169 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     NumaStreamArenas
+//
+
+#include "FWCore/Framework/src/NumaStreamArenas.h"
+
+#include "tbb/task_scheduler_observer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <dirent.h>
+
+#ifdef __linux
+#include <sched.h>
+#endif
+
+namespace edm {
+
+#ifdef __linux
+  namespace {
+    // the CPUs of a node, from its cpulist
+    bool readCpuList(std::string const& iFileName, cpu_set_t& oCpus) {
+      std::ifstream file(iFileName.c_str());
+      std::string list;
+      if(!std::getline(file, list)) {
+        return false;
+      }
+      CPU_ZERO(&oCpus);
+      for(unsigned int cpu : NumaStreamArenas::parseRangeList(list)) {
+        if(cpu < CPU_SETSIZE) {
+          CPU_SET(cpu, &oCpus);
+        }
+      }
+      return CPU_COUNT(&oCpus) > 0;
+    }
+  }
+
+  namespace {
+    // binds the threads to the CPUs of the node while they are in its arena
+    class NodeObserver : public tbb::task_scheduler_observer {
+    public:
+      NodeObserver(tbb::task_arena& iArena, cpu_set_t const& iCpus, cpu_set_t const& iProcessCpus) :
+        tbb::task_scheduler_observer(iArena),
+        m_cpus(iCpus),
+        m_processCpus(iProcessCpus) {
+        observe(true);
+      }
+      ~NodeObserver() {
+        observe(false);
+      }
+
+      void on_scheduler_entry(bool) override {
+        sched_setaffinity(0, sizeof(cpu_set_t), &m_cpus);
+      }
+      void on_scheduler_exit(bool) override {
+        sched_setaffinity(0, sizeof(cpu_set_t), &m_processCpus);
+      }
+
+    private:
+      cpu_set_t m_cpus;
+      cpu_set_t m_processCpus;
+    };
+  }
+
+  struct NumaStreamArenas::Node {
+    Node(cpu_set_t const& iCpus, cpu_set_t const& iProcessCpus, int iConcurrency) :
+      //no slot is kept for the main thread, it only joins the arena of one node
+      m_arena(iConcurrency, 0),
+      m_observer(m_arena, iCpus, iProcessCpus) {}
+
+    tbb::task_arena m_arena;
+    NodeObserver m_observer;
+  };
+#else
+  struct NumaStreamArenas::Node {
+    tbb::task_arena m_arena;
+  };
+#endif
+
+  NumaStreamArenas::NumaStreamArenas(unsigned int iNThreads, unsigned int iNStreams) {
+#ifdef __linux
+    cpu_set_t processCpus;
+    if(sched_getaffinity(0, sizeof(cpu_set_t), &processCpus) != 0) {
+      return;
+    }
+    //only the nodes with CPUs this process may run on
+    std::string const nodeDirectory("/sys/devices/system/node");
+    std::vector<cpu_set_t> nodeCpus;
+    for(unsigned int node : onlineNodes(nodeDirectory)) {
+      cpu_set_t cpus;
+      if(!readCpuList(nodeDirectory + "/node" + std::to_string(node) + "/cpulist", cpus)) {
+        continue;
+      }
+      CPU_AND(&cpus, &cpus, &processCpus);
+      if(CPU_COUNT(&cpus) > 0) {
+        nodeCpus.push_back(cpus);
+      }
+    }
+    unsigned int const nNodes = std::min<std::size_t>(nodeCpus.size(), iNStreams);
+    if(nNodes < 2) {
+      return;
+    }
+    //the threads are shared out as the Streams are
+    m_nodes.reserve(nNodes);
+    for(unsigned int node = 0; node < nNodes; ++node) {
+      int concurrency = std::max(1u, iNThreads / nNodes + (node < iNThreads % nNodes ? 1 : 0));
+      m_nodes.push_back(std::make_unique<Node>(nodeCpus[node], processCpus, concurrency));
+    }
+#endif
+  }
+
+  NumaStreamArenas::~NumaStreamArenas() = default;
+
+  std::vector<unsigned int>
+  NumaStreamArenas::parseRangeList(std::string const& iList) {
+    std::vector<unsigned int> numbers;
+    std::istringstream ranges(iList);
+    std::string range;
+    while(std::getline(ranges, range, ',')) {
+      range.erase(std::remove_if(range.begin(), range.end(), [](char c) { return std::isspace(c); }), range.end());
+      if(range.empty() or !std::isdigit(range[0])) {
+        continue;
+      }
+      auto dash = range.find('-');
+      unsigned long first = std::stoul(range.substr(0, dash));
+      unsigned long last = first;
+      if(dash != std::string::npos and dash + 1 < range.size() and std::isdigit(range[dash + 1])) {
+        last = std::stoul(range.substr(dash + 1));
+      }
+      for(unsigned long number = first; number <= last; ++number) {
+        numbers.push_back(number);
+      }
+    }
+    return numbers;
+  }
+
+  std::vector<unsigned int>
+  NumaStreamArenas::onlineNodes(std::string const& iNodeDirectory) {
+    std::vector<unsigned int> nodes;
+    std::ifstream online((iNodeDirectory + "/online").c_str());
+    std::string list;
+    if(std::getline(online, list)) {
+      nodes = parseRangeList(list);
+    } else if(DIR* directory = opendir(iNodeDirectory.c_str())) {
+      while(dirent* entry = readdir(directory)) {
+        std::string const name(entry->d_name);
+        if(name.size() > 4 and name.compare(0, 4, "node") == 0 and
+           std::all_of(name.begin() + 4, name.end(), [](char c) { return std::isdigit(c); })) {
+          nodes.push_back(std::stoul(name.substr(4)));
+        }
+      }
+      closedir(directory);
+    }
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    return nodes;
+  }
+
+  tbb::task_arena&
+  NumaStreamArenas::arenaOfStream(unsigned int iStream) {
+    return m_nodes[nodeOfStream(iStream)]->m_arena;
+  }
+}
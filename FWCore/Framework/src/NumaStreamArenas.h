@@ -0,0 +1,67 @@
+#ifndef FWCore_Framework_NumaStreamArenas_h
+#define FWCore_Framework_NumaStreamArenas_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     NumaStreamArenas
+//
+/**\class edm::NumaStreamArenas NumaStreamArenas.h "NumaStreamArenas.h"
+
+ Description: One tbb::task_arena per NUMA node of the machine, with the
+ Streams shared out between them.
+
+ Usage:
+    The threads working in the arena of a node are bound to the CPUs of
+ that node while they are in it, so what a Stream allocates while it
+ processes its events lands, by the first touch policy of the kernel, in
+ the memory local to the CPUs that use it.  The threads get back the
+ affinity of the process when they leave the arena.
+    When the machine has a single node, or the nodes cannot be read from
+ /sys, there are no arenas and empty() is true.  The node numbers need not
+ be contiguous, and the nodes without CPUs are skipped.
+
+*/
+//
+
+// system include files
+#include <memory>
+#include <string>
+#include <vector>
+
+// user include files
+#include "tbb/task_arena.h"
+
+// forward declarations
+namespace edm {
+  class NumaStreamArenas
+  {
+
+  public:
+    NumaStreamArenas(unsigned int iNThreads, unsigned int iNStreams);
+    ~NumaStreamArenas();
+
+    NumaStreamArenas(NumaStreamArenas const&) = delete;
+    NumaStreamArenas& operator=(NumaStreamArenas const&) = delete;
+
+    bool empty() const { return m_nodes.empty(); }
+    unsigned int numberOfNodes() const { return m_nodes.size(); }
+
+    ///the Streams go round robin over the nodes
+    unsigned int nodeOfStream(unsigned int iStream) const { return iStream % m_nodes.size(); }
+    tbb::task_arena& arenaOfStream(unsigned int iStream);
+
+    ///the sorted numbers of the nodes of a directory such as
+    ///"/sys/devices/system/node": the ones of its "online" file, or of its
+    ///nodeN subdirectories when there is none
+    static std::vector<unsigned int> onlineNodes(std::string const& iNodeDirectory);
+
+    ///the numbers in a list of ranges such as "0-7,16-23", or 0,2 for "0,2"
+    static std::vector<unsigned int> parseRangeList(std::string const& iList);
+
+  private:
+    struct Node;
+    std::vector<std::unique_ptr<Node>> m_nodes;
+  };
+}
+
+#endif
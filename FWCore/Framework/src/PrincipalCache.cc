@@ -20,6 +20,18 @@ namespace edm {
   void PrincipalCache::setNumberOfConcurrentPrincipals(PreallocationConfiguration const& iConfig)
   {
     eventPrincipals_.resize(iConfig.numberOfStreams());
+    lumiPrincipals_.resize(iConfig.numberOfLuminosityBlocks());
+  }
+
+  unsigned int
+  PrincipalCache::availableLumiIndex() const {
+    for(unsigned int index = 0; index < lumiPrincipals_.size(); ++index) {
+      if(not lumiPrincipals_[index]) {
+        return index;
+      }
+    }
+    throwNoAvailableLumiIndex();
+    return 0;
   }
 
   RunPrincipal&
@@ -203,7 +215,16 @@ namespace edm {
         << "luminosity block inconsistent with run number of run in cache\n"
         << "Contact a Framework Developer\n";
     }
+    unsigned int index = lbp->index();
+    if (index >= lumiPrincipals_.size() || lumiPrincipals_[index].get() != 0) {
+      throw edm::Exception(edm::errors::LogicError)
+        << "PrincipalCache::insert\n"
+        << "Illegal attempt to insert lumi into cache\n"
+        << "LuminosityBlockIndex " << index << " is invalid or already in use\n"
+        << "Contact a Framework Developer\n";
+    }
     lumi_ = lbp->luminosityBlock();
+    lumiPrincipals_[index] = lbp;
     lumiPrincipal_ = lbp; 
   }
 
@@ -249,6 +270,7 @@ namespace edm {
         << "Run number, lumi numbers, or reduced ProcessHistoryID inconsistent with those in cache\n"
         << "Contact a Framework Developer\n";
     }
+    lumiPrincipals_[lumiPrincipal_->index()].reset();
     lumiPrincipal_.reset();
   }
 
@@ -266,8 +288,10 @@ namespace edm {
     if (runPrincipal_) {
       runPrincipal_->adjustIndexesAfterProductRegistryAddition();
     }
-    if (lumiPrincipal_) {
-      lumiPrincipal_->adjustIndexesAfterProductRegistryAddition();
+    for(auto& lumiPrincipal : lumiPrincipals_) {
+      if (lumiPrincipal) {
+        lumiPrincipal->adjustIndexesAfterProductRegistryAddition();
+      }
     }
   }
 
@@ -286,4 +310,12 @@ namespace edm {
       << "Requested a luminosity block that is not in the cache (should never happen)\n"
       << "Contact a Framework Developer\n";
   }
+
+  void
+  PrincipalCache::throwNoAvailableLumiIndex() const {
+    throw edm::Exception(edm::errors::LogicError)
+      << "PrincipalCache::availableLumiIndex\n"
+      << "All " << lumiPrincipals_.size() << " luminosity block slots are in use (should never happen)\n"
+      << "Contact a Framework Developer\n";
+  }
 }
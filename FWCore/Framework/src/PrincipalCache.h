@@ -17,6 +17,11 @@ The RunPrincipal and LuminosityBlockPrincipal is
 created by the InputSource each time a different
 run or luminosity block is encountered.
 
+Up to the number of luminosity blocks of the
+PreallocationConfiguration can be held at once. Each
+one occupies the slot given by its LuminosityBlockIndex
+and availableLumiIndex() hands out a free slot.
+
 Performs checks that process history IDs or runs and
 lumis, run numbers, and luminosity numbers are consistent.
 
@@ -60,6 +65,11 @@ namespace edm {
     std::shared_ptr<LuminosityBlockPrincipal> const& lumiPrincipalPtr() const;
     bool hasLumiPrincipal() const {return bool(lumiPrincipal_);}
 
+    // Index of a slot which is not used by any LuminosityBlockPrincipal
+    // in the cache. Throws if all slots are in use.
+    unsigned int availableLumiIndex() const;
+    unsigned int numberOfConcurrentLumis() const {return lumiPrincipals_.size();}
+
     EventPrincipal& eventPrincipal(unsigned int iStreamIndex) const { return *(eventPrincipals_[iStreamIndex]); }
 
     void merge(std::shared_ptr<RunAuxiliary> aux, std::shared_ptr<ProductRegistry const> reg);
@@ -83,11 +93,14 @@ namespace edm {
 
     void throwRunMissing() const;
     void throwLumiMissing() const;
+    void throwNoAvailableLumiIndex() const;
 
     // These are explicitly cleared when finished with the run,
     // lumi, or event
     std::shared_ptr<RunPrincipal> runPrincipal_;
     std::shared_ptr<LuminosityBlockPrincipal> lumiPrincipal_;
+    // One slot per concurrent luminosity block, indexed by LuminosityBlockIndex
+    std::vector<std::shared_ptr<LuminosityBlockPrincipal>> lumiPrincipals_;
     std::vector<std::shared_ptr<EventPrincipal>> eventPrincipals_;
 
     // This is just an accessor to the registry owned by the input source. 
@@ -109,9 +109,16 @@ namespace edm {
                                       bool,
                                       SharedResourcesAcquirer* ,
                                       ModuleCallingContext const* mcc) const {
-    return resolveProductImpl<true>([this,&principal,mcc]() {
-                                return principal.readFromSource(*this, mcc); }
-                              ,resolveStatus);
+    auto read = [this,&principal,mcc]() {
+                  return principal.readFromSource(*this, mcc); };
+    //Set while another thread may read this product at the same time,
+    // as the source prefetch of the stream or the concurrent SubProcesses do
+    std::recursive_mutex* mutex = principal.sharedReadMutex();
+    if(mutex and status() == ProductStatus::ResolveNotRun) {
+      std::lock_guard<std::recursive_mutex> guard(*mutex);
+      return resolveProductImpl<true>(read, resolveStatus);
+    }
+    return resolveProductImpl<true>(read, resolveStatus);
                               
   }
 
@@ -378,6 +385,32 @@ namespace edm {
     return true;
   }
 
+  ProductData const*
+  ParentProcessProductResolver::resolveProduct_(ResolveStatus& resolveStatus,
+                                                Principal const&,
+                                                bool skipCurrentProcess,
+                                                SharedResourcesAcquirer* sra,
+                                                ModuleCallingContext const* mcc) const {
+    std::recursive_mutex* mutex = parentPrincipal_->sharedReadMutex();
+    if(not mutex) {
+      return realProduct_->resolveProduct(resolveStatus, *parentPrincipal_, skipCurrentProcess, sra, mcc);
+    }
+    //Another SubProcess may be running a module of the parent at the same time.
+    // The resources of the caller are released while waiting, else a parent module
+    // needing them could never finish.
+    ProductData const* ret = nullptr;
+    auto resolve = [&]() {
+      std::lock_guard<std::recursive_mutex> guard(*mutex);
+      ret = realProduct_->resolveProduct(resolveStatus, *parentPrincipal_, skipCurrentProcess, nullptr, mcc);
+    };
+    if(sra) {
+      sra->temporaryUnlock(resolve);
+    } else {
+      resolve();
+    }
+    return ret;
+  }
+
   void ParentProcessProductResolver::putProduct_(std::unique_ptr<WrapperBase> ) const {
     throw Exception(errors::LogicError)
     << "ParentProcessProductResolver::putProduct_() not implemented and should never be called.\n"
@@ -198,7 +198,7 @@ namespace edm {
                                                Principal const& principal,
                                                bool skipCurrentProcess,
                                                SharedResourcesAcquirer* sra,
-                                               ModuleCallingContext const* mcc) const override {return realProduct_->resolveProduct(resolveStatus, *parentPrincipal_, skipCurrentProcess, sra, mcc);}
+                                               ModuleCallingContext const* mcc) const override;
     virtual bool unscheduledWasNotRun_() const override {return realProduct_->unscheduledWasNotRun();}
     virtual bool productUnavailable_() const override {return realProduct_->productUnavailable();}
     virtual bool productResolved_() const override final { return realProduct_->productResolved(); }
@@ -519,6 +519,10 @@ namespace edm {
       c->setEventSelectionInfo(outputModulePathPositions, preg.anyProductProduced());
     }
 
+    for(auto& s : streamSchedules_) {
+      s->initializeSourcePrefetch(preg);
+    }
+
     if(wantSummary_) {
       std::vector<const ModuleDescription*> modDesc;
       const auto& workers = allWorkers();
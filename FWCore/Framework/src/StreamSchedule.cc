@@ -3,6 +3,7 @@
 #include "DataFormats/Provenance/interface/BranchIDListHelper.h"
 #include "DataFormats/Provenance/interface/ProcessConfiguration.h"
 #include "DataFormats/Provenance/interface/ProductRegistry.h"
+#include "FWCore/Framework/interface/DelayedReader.h"
 #include "FWCore/Framework/interface/OutputModuleDescription.h"
 #include "FWCore/Framework/interface/TriggerNamesService.h"
 #include "FWCore/Framework/interface/TriggerReport.h"
@@ -19,6 +20,8 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ParameterSet/interface/Registry.h"
 #include "FWCore/ServiceRegistry/interface/PathContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
+#include "FWCore/Utilities/interface/RootHandlers.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/ConvertException.h"
 #include "FWCore/Utilities/interface/ExceptionCollector.h"
@@ -30,6 +33,7 @@
 #include <iomanip>
 #include <list>
 #include <map>
+#include <set>
 #include <exception>
 
 namespace edm {
@@ -158,6 +162,7 @@ namespace edm {
     endpathsAreActive_(true) {
 
     ParameterSet const& opts = proc_pset.getUntrackedParameterSet("options", ParameterSet());
+    prefetchSourceProducts_ = opts.getUntrackedParameter<bool>("prefetchSourceProducts", false);
     bool hasPath = false;
 
     int trig_bitpos = 0;
@@ -289,27 +294,64 @@ namespace edm {
       return;
     }
     
+    //the descriptions of the products we want to delete early, to compare them
+    // with what the modules consume
+    std::vector<std::pair<std::string, BranchDescription const*>> branchesToDelete;
+    for(auto const& product : preg.productList()) {
+      BranchDescription const& desc = product.second;
+      if(desc.branchType() != InEvent) continue;
+      std::string branch = desc.branchName();
+      branch.resize(branch.size()-1);
+      if(branchToReadingWorker.find(branch) != branchToReadingWorker.end()) {
+        branchesToDelete.emplace_back(branch, &desc);
+      }
+    }
+    auto mightConsume = [](BranchDescription const& desc, ConsumesInfo const& info) {
+      //a consumesMany may get any product of its type. For a View the type of the
+      // elements is not compared, so the module is taken to read the product
+      if(info.label().empty()) {
+        return info.kindOfType() != PRODUCT_TYPE || desc.unwrappedTypeID() == info.type();
+      }
+      return (info.kindOfType() != PRODUCT_TYPE || desc.unwrappedTypeID() == info.type()) &&
+        desc.moduleLabel() == info.label() &&
+        desc.productInstanceName() == info.instance() &&
+        (info.process().empty() || desc.processName() == info.process());
+    };
+
     for (auto w :allWorkers()) {
-      //determine if this module could read a branch we want to delete early
+      //determine if this module could read a branch we want to delete early,
+      // either from its 'mightGet' list or from what it consumes
+      std::set<std::string> branches;
       auto pset = pset::Registry::instance()->getMapped(w->description().parameterSetID());
       if(0!=pset) {
-        auto branches = pset->getUntrackedParameter<std::vector<std::string>>("mightGet",kEmpty);
-        if(not branches.empty()) {
-          ++upperLimitOnReadingWorker;
+        auto mightGet = pset->getUntrackedParameter<std::vector<std::string>>("mightGet",kEmpty);
+        branches.insert(mightGet.begin(), mightGet.end());
+      }
+      for(auto const& info : w->consumesInfo()) {
+        if(info.branchType() != InEvent) continue;
+        for(auto const& branchAndDesc : branchesToDelete) {
+          if(mightConsume(*branchAndDesc.second, info)) {
+            branches.insert(branchAndDesc.first);
+          }
         }
-        for(auto const& branch:branches){
-          auto found = branchToReadingWorker.equal_range(branch);
-          if(found.first != found.second) {
-            ++upperLimitOnIndicies;
-            ++reserveSizeForWorker[w];
-            if(nullptr == found.first->second) {
-              found.first->second = w;
-            } else {
-              branchToReadingWorker.insert(make_pair(found.first->first,w));
-            }
+      }
+      bool readsABranch = false;
+      for(auto const& branch:branches){
+        auto found = branchToReadingWorker.equal_range(branch);
+        if(found.first != found.second) {
+          readsABranch = true;
+          ++upperLimitOnIndicies;
+          ++reserveSizeForWorker[w];
+          if(nullptr == found.first->second) {
+            found.first->second = w;
+          } else {
+            branchToReadingWorker.insert(make_pair(found.first->first,w));
           }
         }
       }
+      if(readsABranch) {
+        ++upperLimitOnReadingWorker;
+      }
     }
     {
       auto it = branchToReadingWorker.begin();
@@ -726,6 +768,135 @@ namespace edm {
     workerManager_.addToAllWorkers(w);
   }
 
+  void
+  StreamSchedule::initializeSourcePrefetch(ProductRegistry const& preg) {
+    if(not prefetchSourceProducts_) {
+      return;
+    }
+    auto const& lookup = *preg.productLookup(InEvent);
+    auto matches = [](BranchDescription const& desc, ConsumesInfo const& info) {
+      return desc.branchType() == InEvent &&
+        desc.unwrappedTypeID() == info.type() &&
+        desc.moduleLabel() == info.label() &&
+        desc.productInstanceName() == info.instance() &&
+        (info.process().empty() || desc.processName() == info.process());
+    };
+
+    //Only the modules which are sure to run: those of the paths which come
+    // before the first filter, since a filter may stop the rest of its path.
+    // OutputModules are skipped as they may select events.
+    std::set<Worker const*> sureToRun;
+    auto addSureToRun = [&sureToRun](TrigPaths const& paths) {
+      for(auto const& path : paths) {
+        for(Path::size_type i = 0; i < path.size(); ++i) {
+          Worker const* worker = path.getWorker(i);
+          if(worker->moduleType() == Worker::kFilter) {
+            break;
+          }
+          if(worker->moduleType() != Worker::kOutputModule) {
+            sureToRun.insert(worker);
+          }
+        }
+      }
+    };
+    addSureToRun(trig_paths_);
+    addSureToRun(end_paths_);
+
+    std::set<ProductResolverIndex> indexes;
+    for(auto const& worker : sureToRun) {
+      for(auto const& info : worker->consumesInfo()) {
+        //only products which are always gotten and fully specified by label
+        if(info.branchType() != InEvent || info.kindOfType() != PRODUCT_TYPE ||
+           not info.alwaysGets() || info.label().empty()) {
+          continue;
+        }
+        BranchDescription const* fromSource = nullptr;
+        unsigned int nMatchesFromSource = 0;
+        bool producedInThisProcess = false;
+        for(auto const& product : preg.productList()) {
+          BranchDescription const& desc = product.second;
+          if(not matches(desc, info)) {
+            continue;
+          }
+          if(desc.produced()) {
+            producedInThisProcess = true;
+          } else if(desc.present()) {
+            fromSource = &desc;
+            ++nMatchesFromSource;
+          }
+        }
+        //Only prefetch when the get can not be satisfied by a module of this process
+        // (which could cause it to run unscheduled) and there is no ambiguity
+        // about which earlier process provides the product
+        if(producedInThisProcess && not info.skipCurrentProcess()) {
+          continue;
+        }
+        if(nMatchesFromSource != 1) {
+          continue;
+        }
+        ProductResolverIndex index = lookup.index(PRODUCT_TYPE,
+                                                  fromSource->unwrappedTypeID(),
+                                                  fromSource->moduleLabel().c_str(),
+                                                  fromSource->productInstanceName().c_str(),
+                                                  fromSource->processName().c_str());
+        if(index != ProductResolverIndexInvalid) {
+          indexes.insert(index);
+        }
+      }
+    }
+    sourceProductsToPrefetch_.assign(indexes.begin(), indexes.end());
+  }
+
+  void
+  StreamSchedule::prefetchSourceProducts(EventPrincipal const& ep) const {
+    for(auto index : sourceProductsToPrefetch_) {
+      ep.prefetch(index, false, nullptr);
+    }
+  }
+
+  std::shared_ptr<void>
+  StreamSchedule::startSourcePrefetch(EventPrincipal& ep) {
+    if(sourceProductsToPrefetch_.empty()) {
+      return std::shared_ptr<void>();
+    }
+    //The modules of the stream and the prefetch task may then read the same
+    // product at the same time, which is only safe if the reader serializes
+    // the reads and nobody else is sharing the principal
+    if(ep.reader() == nullptr or ep.reader()->sharedResources() == nullptr or ep.sharedReadMutex() != nullptr) {
+      prefetchSourceProducts(ep);
+      return std::shared_ptr<void>();
+    }
+    ep.setSharedReadMutex(&sourcePrefetchMutex_);
+    sourcePrefetchException_ = std::exception_ptr();
+    ServiceToken token = ServiceRegistry::instance().presentToken();
+    EventPrincipal const* principal = &ep;
+    sourcePrefetchTasks_.run([this, principal, token]() {
+      ServiceRegistry::Operate operate(token);
+      Service<RootHandlers> handler;
+      if(handler.isAvailable()) {
+        handler->initializeThisThreadForUse();
+      }
+      try {
+        prefetchSourceProducts(*principal);
+      } catch(...) {
+        sourcePrefetchException_ = std::current_exception();
+      }
+    });
+    //The task must be over before the event is cleared, also on exceptions
+    return std::shared_ptr<void>(nullptr, [this, &ep](void*) {
+      sourcePrefetchTasks_.wait();
+      ep.setSharedReadMutex(nullptr);
+    });
+  }
+
+  void
+  StreamSchedule::finishSourcePrefetch() {
+    sourcePrefetchTasks_.wait();
+    if(sourcePrefetchException_) {
+      std::rethrow_exception(sourcePrefetchException_);
+    }
+  }
+
   void 
   StreamSchedule::resetEarlyDelete() {
     //must be sure we have cleared the count first
@@ -21,10 +21,17 @@
   If the high-level pset contains an "options" pset, then the
   following optional parameter can be present:
   bool wantSummary = true/false   # default false
+  bool prefetchSourceProducts = true/false   # default false
 
   wantSummary indicates whether or not the pass/fail/error stats
   for modules and paths should be printed at the end-of-job.
 
+  prefetchSourceProducts indicates whether the products read from the
+  source which are declared as consumed by the modules sure to run
+  (those before the first filter of each path) should be read by a
+  task started with the event, while the paths run, instead of on the
+  first get by a module.
+
   A TriggerResults object will always be inserted into the event
   for any schedule.  The producer of the TriggerResults EDProduct
   is always the first module in the endpath.  The TriggerResultInserter
@@ -83,13 +90,17 @@
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
 
+#include "tbb/task_group.h"
+
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 #include <sstream>
 #include <atomic>
+#include <exception>
 
 namespace edm {
 
@@ -180,6 +191,10 @@ namespace edm {
     void beginStream();
     void endStream();
 
+    /// Finds the source products consumed by the modules of this stream.
+    /// Must be called after the ProductRegistry has been frozen.
+    void initializeSourcePrefetch(ProductRegistry const& preg);
+
     StreamID streamID() const { return streamID_; }
     
     /// Return a vector allowing const access to all the
@@ -319,6 +334,9 @@ namespace edm {
     void addToAllWorkers(Worker* w);
     
     void resetEarlyDelete();
+    void prefetchSourceProducts(EventPrincipal const& ep) const;
+    std::shared_ptr<void> startSourcePrefetch(EventPrincipal& ep);
+    void finishSourcePrefetch();
     void initializeEarlyDelete(ModuleRegistry & modReg,
                                edm::ParameterSet const& opts,
                                edm::ProductRegistry const& preg, 
@@ -356,6 +374,15 @@ namespace edm {
     // has been marked for early deletion
     std::vector<EarlyDeleteHelper> earlyDeleteHelpers_;
 
+    //Products from the source, consumed by modules of this stream,
+    // which are read at the start of each event
+    std::vector<ProductResolverIndex> sourceProductsToPrefetch_;
+    bool prefetchSourceProducts_;
+    //The prefetch runs as a task while the paths run
+    tbb::task_group sourcePrefetchTasks_;
+    std::recursive_mutex sourcePrefetchMutex_;
+    std::exception_ptr sourcePrefetchException_;
+
     int                            total_events_;
     int                            total_passed_;
     unsigned int                   number_of_unscheduled_modules_;
@@ -391,6 +418,7 @@ namespace edm {
     ++total_events_;
     try {
       convertException::wrap([&]() {
+        auto prefetchSentry = startSourcePrefetch(ep);
         try {
           if (runTriggerPaths<T>(ep, es, &streamContext_)) {
             ++total_passed_;
@@ -422,6 +450,7 @@ namespace edm {
         }
 
         if (endpathsAreActive_) runEndPaths<T>(ep, es, &streamContext_);
+        finishSourcePrefetch();
         resetEarlyDelete();
       });
     }
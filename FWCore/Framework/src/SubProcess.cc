@@ -26,9 +26,15 @@
 #include "FWCore/ParameterSet/interface/IllegalParameters.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Utilities/interface/ExceptionCollector.h"
+#include "FWCore/Utilities/interface/RootHandlers.h"
+
+#include "tbb/task_group.h"
 
 #include <cassert>
+#include <exception>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -64,7 +70,8 @@ namespace edm {
       processParameterSet_(),
       productSelectorRules_(parameterSet, "outputCommands", "OutputModule"),
       productSelector_(),
-      wantAllEvents_(true) {
+      wantAllEvents_(true),
+      concurrentSubProcesses_(false) {
   
     //Setup the event selection
     Service<service::TriggerNamesService> tns;
@@ -118,6 +125,7 @@ namespace edm {
 
     ParameterSet const& optionsPset(processParameterSet_->getUntrackedParameterSet("options", ParameterSet()));
     IllegalParameters::setThrowAnException(optionsPset.getUntrackedParameter<bool>("throwIfIllegalParameter", true));
+    concurrentSubProcesses_ = optionsPset.getUntrackedParameter<bool>("concurrentSubProcesses", false);
 
     //initialize the services
     ServiceToken iToken;
@@ -373,13 +381,56 @@ namespace edm {
     typedef OccurrenceTraits<EventPrincipal, BranchActionStreamBegin> Traits;
     schedule_->processOneEvent<Traits>(ep.streamID().value(),ep, esp_->eventSetup());
     if(hasSubProcesses()) {
-      for(auto& subProcess : *subProcesses_) {
-        subProcess.doEvent(ep);
-      }
+      doEventInSubProcesses(*subProcesses_, ep, concurrentSubProcesses_);
     }
     ep.clearEventPrincipal();
   }
 
+  void
+  SubProcess::doEventInSubProcesses(std::vector<SubProcess>& subProcesses,
+                                    EventPrincipal& principal,
+                                    bool concurrently) {
+    if(not concurrently or subProcesses.size() < 2) {
+      for(auto& subProcess : subProcesses) {
+        subProcess.doEvent(principal);
+      }
+      return;
+    }
+    //Each SubProcess has its own EventPrincipal and schedule for the stream and only
+    // reads the parent principal, which outlives them all since we wait here.
+    std::recursive_mutex sharedReadMutex;
+    principal.setSharedReadMutex(&sharedReadMutex);
+    std::shared_ptr<void> resetMutex(nullptr, [&principal](void*) { principal.setSharedReadMutex(nullptr); });
+
+    ServiceToken token = ServiceRegistry::instance().presentToken();
+    std::vector<std::exception_ptr> exceptions(subProcesses.size());
+    auto runOne = [&subProcesses, &principal, &exceptions](unsigned int i) {
+      try {
+        subProcesses[i].doEvent(principal);
+      } catch(...) {
+        exceptions[i] = std::current_exception();
+      }
+    };
+    tbb::task_group group;
+    for(unsigned int i = 1; i < subProcesses.size(); ++i) {
+      group.run([&runOne, &token, i]() {
+        ServiceRegistry::Operate operate(token);
+        Service<RootHandlers> handler;
+        if(handler.isAvailable()) {
+          handler->initializeThisThreadForUse();
+        }
+        runOne(i);
+      });
+    }
+    runOne(0);
+    group.wait();
+    for(auto const& exception : exceptions) {
+      if(exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+  }
+
   void
   SubProcess::doBeginRun(RunPrincipal const& principal, IOVSyncValue const& ts) {
     ServiceRegistry::Operate operate(serviceToken_);
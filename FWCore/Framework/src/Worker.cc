@@ -66,6 +66,20 @@ private:
       ModuleCallingContext const& mcc_;
     };
 
+    //Run when all copies of the WaitingTaskWithArenaHolder handed to acquire have been released
+    class AcquireDoneTask : public WaitingTask {
+    public:
+      explicit AcquireDoneTask(std::exception_ptr& iExcept) : except_(iExcept) {}
+
+      tbb::task* execute() override {
+        if(auto ptr = exceptionPtr()) {
+          except_ = *ptr;
+        }
+        return nullptr;
+      }
+    private:
+      std::exception_ptr& except_;
+    };
   }
 
   Worker::Worker(ModuleDescription const& iMD, 
@@ -181,6 +195,30 @@ private:
     }
   }
 
+  void Worker::runAcquire(EventPrincipal const& ep, EventSetup const& es) {
+    std::exception_ptr acquireException;
+    std::shared_ptr<WaitingTask> waitTask{new (tbb::task::allocate_root()) EmptyWaitingTask{},
+                                          [](WaitingTask* iTask){tbb::task::destroy(*iTask);} };
+    waitTask->set_ref_count(2);
+    //NOTE: allocate_child does NOT increment the ref_count of waitTask!
+    auto doneTask = new (waitTask->allocate_child()) AcquireDoneTask{acquireException};
+    moduleCallingContext_.setState(ModuleCallingContext::State::kRunning);
+    {
+      WaitingTaskWithArenaHolder holder(doneTask);
+      try {
+        implDoAcquire(ep, es, &moduleCallingContext_, holder);
+      } catch(...) {
+        holder.doneWaiting(std::current_exception());
+      }
+    }
+    //While the external work is in flight this thread keeps running other
+    // tasks (e.g. other streams) from the TBB pool instead of idling
+    waitTask->wait_for_all();
+    if(acquireException) {
+      std::rethrow_exception(acquireException);
+    }
+  }
+
   void Worker::pathFinished(EventPrincipal const& iEvent) {
     if(earlyDeleteHelper_) {
       earlyDeleteHelper_->pathFinished(iEvent);
@@ -22,6 +22,8 @@ the worker is reset().
 ----------------------------------------------------------------------*/
 
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/Concurrency/interface/WaitingTask.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/MessageLogger/interface/ExceptionMessages.h"
 #include "FWCore/Framework/src/WorkerParams.h"
 #include "FWCore/Framework/interface/ExceptionActions.h"
@@ -45,6 +47,7 @@ the worker is reset().
 
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 
+#include <exception>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -140,6 +143,10 @@ namespace edm {
     virtual bool implDoPrePrefetchSelection(StreamID id,
                                             EventPrincipal const& ep,
                                             ModuleCallingContext const* mcc) = 0;
+    virtual void implDoAcquire(EventPrincipal const&, EventSetup const& c,
+                               ModuleCallingContext const* mcc,
+                               WaitingTaskWithArenaHolder& holder) = 0;
+    virtual bool implNeedToRunAcquire() const = 0;
     virtual bool implDoBegin(RunPrincipal const& rp, EventSetup const& c,
                              ModuleCallingContext const* mcc) = 0;
     virtual bool implDoStreamBegin(StreamID id, RunPrincipal const& rp, EventSetup const& c,
@@ -167,6 +174,8 @@ namespace edm {
 
   private:
 
+    void runAcquire(EventPrincipal const& ep, EventSetup const& es);
+
     virtual void itemsToGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const = 0;
     virtual void itemsMayGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const = 0;
 
@@ -485,6 +494,7 @@ namespace edm {
             return;
           }
           // Prefetch products the module declares it consumes (not including the products it maybe consumes)
+          actReg_->preModuleEventPrefetchingSignal_(*moduleCallingContext_.getStreamContext(), moduleCallingContext_);
           std::vector<ProductResolverIndexAndSkipBit> const& items = itemsToGetFromEvent();
           for(auto const& item : items) {
             ProductResolverIndex productResolverIndex = item.productResolverIndex();
@@ -493,6 +503,10 @@ namespace edm {
               ep.prefetch(productResolverIndex, skipCurrentProcess, &moduleCallingContext_);
             }
           }
+          actReg_->postModuleEventPrefetchingSignal_(*moduleCallingContext_.getStreamContext(), moduleCallingContext_);
+          if(implNeedToRunAcquire()) {
+            runAcquire(ep, es);
+          }
         }
 
         moduleCallingContext_.setState(ModuleCallingContext::State::kRunning);
@@ -151,6 +151,53 @@ namespace edm{
     return module_->prePrefetchSelection(id,ep,mcc);
   }
   
+  template<typename T>
+  inline
+  void
+  WorkerT<T>::implDoAcquire(EventPrincipal const& ep, EventSetup const& c,
+                            ModuleCallingContext const* mcc,
+                            WaitingTaskWithArenaHolder& holder) {
+  }
+
+  template<>
+  inline
+  void
+  WorkerT<global::EDProducerBase>::implDoAcquire(EventPrincipal const& ep, EventSetup const& c,
+                                                 ModuleCallingContext const* mcc,
+                                                 WaitingTaskWithArenaHolder& holder) {
+    module_->doAcquire(ep, c, activityRegistry(), mcc, holder);
+  }
+
+  template<>
+  inline
+  void
+  WorkerT<stream::EDProducerAdaptorBase>::implDoAcquire(EventPrincipal const& ep, EventSetup const& c,
+                                                        ModuleCallingContext const* mcc,
+                                                        WaitingTaskWithArenaHolder& holder) {
+    module_->doAcquire(ep, c, activityRegistry(), mcc, holder);
+  }
+
+  template<typename T>
+  inline
+  bool
+  WorkerT<T>::implNeedToRunAcquire() const {
+    return false;
+  }
+
+  template<>
+  inline
+  bool
+  WorkerT<global::EDProducerBase>::implNeedToRunAcquire() const {
+    return module_->hasAcquire();
+  }
+
+  template<>
+  inline
+  bool
+  WorkerT<stream::EDProducerAdaptorBase>::implNeedToRunAcquire() const {
+    return module_->hasAcquire();
+  }
+
   template<typename T>
   inline
   bool
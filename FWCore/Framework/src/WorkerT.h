@@ -79,6 +79,10 @@ namespace edm {
     virtual bool implDoPrePrefetchSelection(StreamID id,
                                             EventPrincipal const& ep,
                                             ModuleCallingContext const* mcc) override;
+    virtual void implDoAcquire(EventPrincipal const& ep, EventSetup const& c,
+                               ModuleCallingContext const* mcc,
+                               WaitingTaskWithArenaHolder& holder) override;
+    virtual bool implNeedToRunAcquire() const override;
     virtual bool implDoBegin(RunPrincipal const& rp, EventSetup const& c,
                              ModuleCallingContext const* mcc) override;
     virtual bool implDoStreamBegin(StreamID id, RunPrincipal const& rp, EventSetup const& c,
@@ -33,6 +33,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Utilities/interface/DebugMacros.h"
+#include "FWCore/Utilities/interface/DictionaryTools.h"
 
 
 namespace edm {
@@ -140,6 +141,12 @@ namespace edm {
       ProductSelector::checkForDuplicateKeptBranch(desc,
                                                    trueBranchIDToKeptBranchDesc);
 
+      std::vector<std::string> missingDictionaries;
+      if (!checkDictionary(missingDictionaries, desc.className(), desc.unwrappedType())) {
+        std::string context("Calling OutputModuleBase::keepThisBranch, checking dictionaries for kept types");
+        throwMissingDictionariesException(missingDictionaries, context);
+      }
+
       EDGetToken token;
       switch (desc.branchType()) {
       case InEvent:
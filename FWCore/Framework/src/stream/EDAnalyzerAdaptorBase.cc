@@ -74,6 +74,7 @@ EDAnalyzerAdaptorBase::doPreallocate(PreallocationConfiguration const& iPrealloc
   m_streamModules.resize(iPrealloc.numberOfStreams(),
                          static_cast<stream::EDAnalyzerBase*>(nullptr));
   setupStreamModules();
+  preallocLumis(iPrealloc.numberOfLuminosityBlocks());
 }
 
 void
@@ -22,6 +22,8 @@
 #include "FWCore/Framework/interface/LuminosityBlockPrincipal.h"
 #include "FWCore/Framework/interface/RunPrincipal.h"
 #include "FWCore/Framework/src/EventSignalsSentry.h"
+#include "FWCore/Framework/src/EventAcquireSignalsSentry.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/Framework/src/stream/ProducingModuleAdaptorBase.cc"
 
 
@@ -58,6 +60,25 @@ namespace edm {
       commit(e,&mod->previousParentage_, &mod->previousParentageId_);
       return true;
     }
+
+    void
+    EDProducerAdaptorBase::doAcquire(EventPrincipal const& ep, EventSetup const& c,
+                                     ActivityRegistry* act,
+                                     ModuleCallingContext const* mcc,
+                                     WaitingTaskWithArenaHolder& holder) {
+      assert(ep.streamID()<m_streamModules.size());
+      auto mod = m_streamModules[ep.streamID()];
+      Event e(ep, moduleDescription(), mcc);
+      e.setConsumer(mod);
+      EventAcquireSignalsSentry sentry(act,mcc);
+      mod->doAcquire_(e, c, holder);
+    }
+
+    bool
+    EDProducerAdaptorBase::hasAcquire() const {
+      //all stream module instances are of the same type
+      return not m_streamModules.empty() and m_streamModules[0]->hasAcquire();
+    }
     
     template class edm::stream::ProducingModuleAdaptorBase<edm::stream::EDProducerBase>;
   }
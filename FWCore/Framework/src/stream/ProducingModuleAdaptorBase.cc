@@ -57,6 +57,7 @@ namespace edm {
       m_streamModules.resize(iPrealloc.numberOfStreams(),
                              static_cast<T*>(nullptr));
       setupStreamModules();
+      preallocLumis(iPrealloc.numberOfLuminosityBlocks());
     }
 
     template< typename T>
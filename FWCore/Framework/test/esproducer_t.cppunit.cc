@@ -35,6 +35,7 @@ CPPUNIT_TEST(dependsOnTest);
 CPPUNIT_TEST(labelTest);
 CPPUNIT_TEST_EXCEPTION(failMultipleRegistration,cms::Exception);
 CPPUNIT_TEST(forceCacheClearTest);
+CPPUNIT_TEST(concurrentIOVsTest);
    
 CPPUNIT_TEST_SUITE_END();
 public:
@@ -50,6 +51,7 @@ public:
   void labelTest();
   void failMultipleRegistration();
   void forceCacheClearTest();
+  void concurrentIOVsTest();
 
 private:
 class Test1Producer : public ESProducer {
@@ -388,3 +390,54 @@ void testEsproducer::forceCacheClearTest()
    }
 }
 
+
+void testEsproducer::concurrentIOVsTest()
+{
+   EventSetupProvider provider;
+   provider.setNumberOfConcurrentIOVs(2);
+   
+   std::shared_ptr<DataProxyProvider> pProxyProv = std::make_shared<UniqueProducer>();
+   provider.add(pProxyProv);
+   
+   std::shared_ptr<DummyFinder> pFinder = std::make_shared<DummyFinder>();
+   provider.add(std::shared_ptr<EventSetupRecordIntervalFinder>(pFinder));
+   
+   const edm::Timestamp time1(1);
+   pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time1) , edm::IOVSyncValue(time1)));
+   const edm::EventSetup& eventSetup1 = provider.eventSetupForInstance(edm::IOVSyncValue(time1));
+   edm::ESHandle<DummyData> pDummy1;
+   eventSetup1.get<DummyRecord>().get(pDummy1);
+   CPPUNIT_ASSERT(1 == pDummy1->value_);
+   unsigned long long cacheID1 = eventSetup1.get<DummyRecord>().cacheIdentifier();
+
+   //the second IOV is produced while the first one is still in use
+   const edm::Timestamp time2(2);
+   pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time2) , edm::IOVSyncValue(time2)));
+   const edm::EventSetup& eventSetup2 = provider.eventSetupForInstance(edm::IOVSyncValue(time2));
+   CPPUNIT_ASSERT(&eventSetup1 != &eventSetup2);
+   edm::ESHandle<DummyData> pDummy2;
+   eventSetup2.get<DummyRecord>().get(pDummy2);
+   CPPUNIT_ASSERT(2 == pDummy2->value_);
+   CPPUNIT_ASSERT(cacheID1 < eventSetup2.get<DummyRecord>().cacheIdentifier());
+
+   //the data of the first IOV is untouched
+   CPPUNIT_ASSERT(1 == pDummy1->value_);
+   edm::ESHandle<DummyData> pDummy1Again;
+   eventSetup1.get<DummyRecord>().get(pDummy1Again);
+   CPPUNIT_ASSERT(pDummy1.product() == pDummy1Again.product());
+   CPPUNIT_ASSERT(cacheID1 == eventSetup1.get<DummyRecord>().cacheIdentifier());
+
+   //an unchanged IOV keeps using the same EventSetup
+   const edm::EventSetup& eventSetup2Again = provider.eventSetupForInstance(edm::IOVSyncValue(time2));
+   CPPUNIT_ASSERT(&eventSetup2 == &eventSetup2Again);
+
+   //the third IOV reuses the slot of the first one
+   const edm::Timestamp time3(3);
+   pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time3) , edm::IOVSyncValue(time3)));
+   const edm::EventSetup& eventSetup3 = provider.eventSetupForInstance(edm::IOVSyncValue(time3));
+   CPPUNIT_ASSERT(&eventSetup1 == &eventSetup3);
+   edm::ESHandle<DummyData> pDummy3;
+   eventSetup3.get<DummyRecord>().get(pDummy3);
+   CPPUNIT_ASSERT(3 == pDummy3->value_);
+   CPPUNIT_ASSERT(2 == pDummy2->value_);
+}
@@ -10,6 +10,9 @@
 #include <vector>
 #include <map>
 #include <functional>
+#include <thread>
+#include <chrono>
+#include <atomic>
 #include "FWCore/Framework/interface/global/EDProducer.h"
 #include "FWCore/Framework/src/WorkerT.h"
 #include "FWCore/Framework/src/ModuleHolder.h"
@@ -46,6 +49,7 @@ class testGlobalModule: public CppUnit::TestFixture
   CPPUNIT_TEST(endLumiProdTest);
   CPPUNIT_TEST(endRunSummaryProdTest);
   CPPUNIT_TEST(endLumiSummaryProdTest);
+  CPPUNIT_TEST(externalWorkProdTest);
   
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -66,6 +70,7 @@ public:
   void endLumiProdTest();
   void endRunSummaryProdTest();
   void endLumiSummaryProdTest();
+  void externalWorkProdTest();
 
   enum class Trans {
     kBeginJob,
@@ -219,6 +224,28 @@ private:
     }
   };
 
+  class ExternalWorkProd : public edm::global::EDProducer<edm::ExternalWork> {
+  public:
+    mutable unsigned int m_count = 0;
+    mutable std::atomic<bool> m_workDone{false};
+    void acquire(edm::StreamID, edm::Event const&, edm::EventSetup const&, edm::WaitingTaskWithArenaHolder holder) const override {
+      ++m_count;
+      m_workDone = false;
+      //signal completion from a thread which is not part of the TBB pool
+      std::thread([this, holder]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        m_workDone = true;
+        holder.doneWaiting(std::exception_ptr{});
+      }).detach();
+    }
+
+    void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override {
+      //produce must not start before the external work is done
+      CPPUNIT_ASSERT(m_workDone);
+      ++m_count;
+    }
+  };
+
   class BeginRunProd : public edm::global::EDProducer<edm::BeginRunProducer> {
   public:
     mutable unsigned int m_count = 0;
@@ -553,3 +580,10 @@ void testGlobalModule::endLumiSummaryProdTest()
   testTransitions(testProd, {Trans::kGlobalEndLuminosityBlock, Trans::kEvent, Trans::kGlobalBeginLuminosityBlock, Trans::kStreamEndLuminosityBlock, Trans::kGlobalEndLuminosityBlock}); 
 }
 
+void testGlobalModule::externalWorkProdTest()
+{
+  auto testProd = std::make_shared<ExternalWorkProd>();
+  
+  CPPUNIT_ASSERT(0 == testProd->m_count);
+  testTransitions(testProd, {Trans::kEvent, Trans::kEvent});
+}
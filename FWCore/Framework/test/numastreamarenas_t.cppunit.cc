@@ -0,0 +1,116 @@
+/*
+ *  numastreamarenas_t.cppunit.cc
+ *  CMSSW
+ *
+ */
+
+#include "cppunit/extensions/HelperMacros.h"
+
+#include "FWCore/Framework/src/NumaStreamArenas.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace edm;
+
+class testNumaStreamArenas: public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(testNumaStreamArenas);
+
+   CPPUNIT_TEST(rangeListTest);
+   CPPUNIT_TEST(onlineFileTest);
+   CPPUNIT_TEST(directoryScanTest);
+   CPPUNIT_TEST(missingDirectoryTest);
+
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void setUp();
+   void tearDown();
+
+   void rangeListTest();
+   void onlineFileTest();
+   void directoryScanTest();
+   void missingDirectoryTest();
+
+private:
+   void write(std::string const& iFile, std::string const& iContent);
+   void makeNodes(std::vector<unsigned int> const& iNodes);
+
+   std::string m_directory;
+   std::vector<std::string> m_created;
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testNumaStreamArenas);
+
+void testNumaStreamArenas::setUp()
+{
+   char name[] = "/tmp/numastreamarenas_tXXXXXX";
+   char* directory = mkdtemp(name);
+   CPPUNIT_ASSERT(directory != nullptr);
+   m_directory = directory;
+}
+
+void testNumaStreamArenas::tearDown()
+{
+   for(auto it = m_created.rbegin(); it != m_created.rend(); ++it) {
+      std::remove(it->c_str());
+   }
+   m_created.clear();
+   rmdir(m_directory.c_str());
+}
+
+void testNumaStreamArenas::write(std::string const& iFile, std::string const& iContent)
+{
+   std::ofstream file((m_directory + "/" + iFile).c_str());
+   file << iContent << "\n";
+   m_created.push_back(m_directory + "/" + iFile);
+}
+
+// nodeN directories with a cpulist, and a file that is not a node
+void testNumaStreamArenas::makeNodes(std::vector<unsigned int> const& iNodes)
+{
+   for(unsigned int node : iNodes) {
+      std::string const name = "node" + std::to_string(node);
+      CPPUNIT_ASSERT(mkdir((m_directory + "/" + name).c_str(), 0700) == 0);
+      m_created.push_back(m_directory + "/" + name);
+      write(name + "/cpulist", std::to_string(2 * node) + "-" + std::to_string(2 * node + 1));
+   }
+   write("possible", "0-7");
+}
+
+void testNumaStreamArenas::rangeListTest()
+{
+   CPPUNIT_ASSERT((NumaStreamArenas::parseRangeList("0") == std::vector<unsigned int>{0}));
+   CPPUNIT_ASSERT((NumaStreamArenas::parseRangeList("0-3") == std::vector<unsigned int>{0, 1, 2, 3}));
+   CPPUNIT_ASSERT((NumaStreamArenas::parseRangeList("0,2-3,8\n") == std::vector<unsigned int>{0, 2, 3, 8}));
+   CPPUNIT_ASSERT((NumaStreamArenas::parseRangeList("0-1,16-17") == std::vector<unsigned int>{0, 1, 16, 17}));
+   CPPUNIT_ASSERT(NumaStreamArenas::parseRangeList("").empty());
+   CPPUNIT_ASSERT(NumaStreamArenas::parseRangeList("\n").empty());
+}
+
+// the online file is used, even when nodes are missing in its list
+void testNumaStreamArenas::onlineFileTest()
+{
+   makeNodes({0, 1, 2, 3});
+   write("online", "0,2-3");
+   CPPUNIT_ASSERT((NumaStreamArenas::onlineNodes(m_directory) == std::vector<unsigned int>{0, 2, 3}));
+}
+
+// without an online file, a gap in the numbers of the nodes does not stop the scan
+void testNumaStreamArenas::directoryScanTest()
+{
+   makeNodes({0, 2, 10});
+   CPPUNIT_ASSERT((NumaStreamArenas::onlineNodes(m_directory) == std::vector<unsigned int>{0, 2, 10}));
+}
+
+void testNumaStreamArenas::missingDirectoryTest()
+{
+   CPPUNIT_ASSERT(NumaStreamArenas::onlineNodes(m_directory + "/missing").empty());
+}
@@ -9,6 +9,8 @@
 #include <vector>
 #include <map>
 #include <functional>
+#include <thread>
+#include <chrono>
 #include "FWCore/Framework/src/Worker.h"
 #include "FWCore/Framework/src/WorkerT.h"
 #include "FWCore/Framework/src/ModuleHolder.h"
@@ -46,6 +48,7 @@ class testStreamModule: public CppUnit::TestFixture
   CPPUNIT_TEST(endLumiProdTest);
   CPPUNIT_TEST(endRunSummaryProdTest);
   CPPUNIT_TEST(endLumiSummaryProdTest);
+  CPPUNIT_TEST(externalWorkProdTest);
   
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -66,6 +69,7 @@ public:
   void endLumiProdTest();
   void endRunSummaryProdTest();
   void endLumiSummaryProdTest();
+  void externalWorkProdTest();
 
   enum class Trans {
     kBeginJob, //0
@@ -328,6 +332,30 @@ private:
       ++m_count;
     }
   };
+
+  class ExternalWorkProd : public edm::stream::EDProducer<edm::ExternalWork> {
+  public:
+    static unsigned int m_count;
+    static std::atomic<bool> m_workDone;
+    ExternalWorkProd(edm::ParameterSet const&) {}
+
+    void acquire(edm::Event const&, edm::EventSetup const&, edm::WaitingTaskWithArenaHolder holder) override {
+      ++m_count;
+      m_workDone = false;
+      //signal completion from a thread which is not part of the TBB pool
+      std::thread([holder]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        m_workDone = true;
+        holder.doneWaiting(std::exception_ptr{});
+      }).detach();
+    }
+
+    void produce(edm::Event&, edm::EventSetup const&) override {
+      //produce must not start before the external work is done
+      CPPUNIT_ASSERT(m_workDone);
+      ++m_count;
+    }
+  };
    
 };
 unsigned int testStreamModule::BasicProd::m_count = 0;
@@ -342,6 +370,8 @@ unsigned int testStreamModule::BeginLumiProd::m_count = 0;
 unsigned int testStreamModule::EndLumiProd::m_count = 0;
 unsigned int testStreamModule::EndRunSummaryProd::m_count = 0;
 unsigned int testStreamModule::EndLumiSummaryProd::m_count = 0;
+unsigned int testStreamModule::ExternalWorkProd::m_count = 0;
+std::atomic<bool> testStreamModule::ExternalWorkProd::m_workDone{false};
 ///registration of the test so that the runner can find it
 CPPUNIT_TEST_SUITE_REGISTRATION(testStreamModule);
 
@@ -557,3 +587,8 @@ void testStreamModule::endLumiSummaryProdTest()
   runTest<EndLumiSummaryProd>({Trans::kGlobalEndLuminosityBlock, Trans::kEvent, Trans::kGlobalBeginLuminosityBlock, Trans::kStreamEndLuminosityBlock, Trans::kGlobalEndLuminosityBlock} );
 }
 
+void testStreamModule::externalWorkProdTest()
+{
+  runTest<ExternalWorkProd>({Trans::kEvent, Trans::kEvent} );
+}
+
@@ -19,6 +19,9 @@ pushd ${LOCAL_TMP_DIR}
   echo cmsRun readSubProcessOutput_cfg.py
   cmsRun -p ${LOCAL_TEST_DIR}/readSubProcessOutput_cfg.py || die "cmsRun readSubProcessOutput_cfg.py" $?
 
+  echo cmsRun testConcurrentSubProcess_cfg.py
+  cmsRun -p ${LOCAL_TEST_DIR}/testConcurrentSubProcess_cfg.py > testConcurrentSubProcess.log 2>&1 || die "cmsRun testConcurrentSubProcess_cfg.py" $?
+
 
   echo cmsRun testSubProcessEventSetup_cfg.py
   cmsRun -p ${LOCAL_TEST_DIR}/testSubProcessEventSetup_cfg.py > testSubProcessEventSetup.log 2>&1 || die "cmsRun testSubProcessEventSetup_cfg.py" $?
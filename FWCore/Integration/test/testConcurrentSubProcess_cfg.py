@@ -0,0 +1,15 @@
+# Same jobs as testSubProcess_cfg.py, with the two SubProcesses
+# of COPY2 processing each event at the same time
+import os
+
+exec(open(os.path.join(os.environ["LOCAL_TEST_DIR"], "testSubProcess_cfg.py")).read())
+
+# the order of the Tracer printouts is not reproducible any more
+del process.Tracer
+
+copy2Process.options = cms.untracked.PSet(
+    concurrentSubProcesses = cms.untracked.bool(True)
+)
+
+prod2Process.out.fileName = 'testConcurrentSubProcess.root'
+prod2ProcessAlt.out.fileName = 'testConcurrentSubProcessAlt.root'
@@ -119,6 +119,9 @@
 // 26 wmtan 7/22/11 Fix clang compilation errors for LogDebug and LogTrace
 //                  by making MessageSender copyable, and holding
 //                  the ErrorObj in a shared pointer with a custom deleter.
+//
+// 27               Constructors from a C string id, so that a suppressed
+//                  message does not build a std::string for its category.
 // =================================================
 
 // system include files
@@ -143,6 +146,9 @@ public:
   explicit LogWarning( std::string const & id ) 
     : ap ( ELwarning,id,false,(MessageDrop::warningAlwaysSuppressed || !MessageDrop::instance()->warningEnabled)) // Change log 21
   { }
+  explicit LogWarning( char const * id )
+    : ap ( ELwarning,id,false,(MessageDrop::warningAlwaysSuppressed || !MessageDrop::instance()->warningEnabled)) // Change log 21
+  { }
   ~LogWarning();						// Change log 13
 
   template< class T >
@@ -167,6 +173,9 @@ public:
   explicit LogError( std::string const & id ) 
     : ap ( ELerror,id,false,!MessageDrop::instance()->errorEnabled )        // Change log 24
   { }
+  explicit LogError( char const * id )
+    : ap ( ELerror,id,false,!MessageDrop::instance()->errorEnabled )        // Change log 24
+  { }
   ~LogError();							// Change log 13
 
   template< class T >
@@ -217,6 +226,9 @@ public:
   explicit LogInfo( std::string const & id ) 
     : ap ( ELinfo,id,false,(MessageDrop::infoAlwaysSuppressed || !MessageDrop::instance()->infoEnabled) ) // Change log 21
   { }
+  explicit LogInfo( char const * id )
+    : ap ( ELinfo,id,false,(MessageDrop::infoAlwaysSuppressed || !MessageDrop::instance()->infoEnabled) ) // Change log 21
+  { }
   ~LogInfo();							// Change log 13
 
   template< class T >
@@ -243,6 +255,9 @@ public:
   explicit LogVerbatim( std::string const & id ) 
     : ap ( ELinfo,id,true,(MessageDrop::infoAlwaysSuppressed || !MessageDrop::instance()->infoEnabled) ) // Change log 21
   { }
+  explicit LogVerbatim( char const * id )
+    : ap ( ELinfo,id,true,(MessageDrop::infoAlwaysSuppressed || !MessageDrop::instance()->infoEnabled) ) // Change log 21
+  { }
   ~LogVerbatim();						// Change log 13
 
   template< class T >
@@ -270,6 +285,9 @@ public:
   explicit LogPrint( std::string const & id ) 
     : ap ( ELwarning,id,true,(MessageDrop::warningAlwaysSuppressed || !MessageDrop::instance()->warningEnabled)) // Change log 21
   { }
+  explicit LogPrint( char const * id )
+    : ap ( ELwarning,id,true,(MessageDrop::warningAlwaysSuppressed || !MessageDrop::instance()->warningEnabled)) // Change log 21
+  { }
   ~LogPrint();							// Change log 13
 
   template< class T >
@@ -298,6 +316,9 @@ public:
  explicit LogProblem ( std::string const & id )
     : ap ( ELerror,id,true,!MessageDrop::instance()->errorEnabled )        // Change log 24
   { }
+ explicit LogProblem ( char const * id )
+    : ap ( ELerror,id,true,!MessageDrop::instance()->errorEnabled )        // Change log 24
+  { }
   ~LogProblem();						// Change log 13
 
   template< class T >
@@ -324,6 +345,9 @@ public:
   explicit LogImportant( std::string const & id ) 
     : ap ( ELerror,id,true,!MessageDrop::instance()->errorEnabled )        // Change log 24
   { }
+  explicit LogImportant( char const * id )
+    : ap ( ELerror,id,true,!MessageDrop::instance()->errorEnabled )        // Change log 24
+  { }
   ~LogImportant();						 // Change log 13
 
   template< class T >
@@ -19,6 +19,9 @@
 //  3 wmtan 6/22/11     Hold the ErrorObj with a shared pointer with a custom deleter.
 //                      The custom deleter takes over the function of the message sending from the MessageSender destructor.
 //                      This allows MessageSender to be copyable, which fixes the clang compilation errors.
+//
+//  4                   A suppressed MessageSender holds no ErrorObj and no shared pointer control block,
+//                      and the id given as a C string is only copied when the message is not suppressed.
          
 
 namespace edm
@@ -37,6 +40,9 @@ public:
   MessageSender( ELseverityLevel const & sev, 
   		 ELstring const & id,
 		 bool verbatim = false, bool suppressed = false );
+  MessageSender( ELseverityLevel const & sev, 
+  		 char const * id,
+		 bool verbatim = false, bool suppressed = false );
   ~MessageSender();
 
   // ---  stream out the next part of a message:
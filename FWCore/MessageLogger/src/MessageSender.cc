@@ -84,14 +84,25 @@ namespace  {
 //Each item in the vector is reserved for a different Stream
 [[cms::thread_safe]] static std::vector<tbb::concurrent_unordered_map<ErrorSummaryMapKey, AtomicUnsignedInt,ErrorSummaryMapKey::key_hash>> errorSummaryMaps;
 
+// A suppressed message must not cost an allocation: a shared_ptr given a
+// null pointer with a deleter still allocates its control block.
 MessageSender::MessageSender( ELseverityLevel const & sev, 
 			      ELstring const & id,
 			      bool verbatim, bool suppressed )
-: errorobj_p( suppressed ? nullptr : new ErrorObj(sev,id,verbatim), ErrorObjDeleter())
+: errorobj_p( suppressed ? std::shared_ptr<ErrorObj>()
+			 : std::shared_ptr<ErrorObj>(new ErrorObj(sev,id,verbatim), ErrorObjDeleter()) )
 {
   //std::cout << "MessageSender ctor; new ErrorObj at: " << errorobj_p << '\n';
 }
 
+MessageSender::MessageSender( ELseverityLevel const & sev, 
+			      char const * id,
+			      bool verbatim, bool suppressed )
+: errorobj_p( suppressed ? std::shared_ptr<ErrorObj>()
+			 : std::shared_ptr<ErrorObj>(new ErrorObj(sev,id,verbatim), ErrorObjDeleter()) )
+{
+}
+
 
 // This destructor must not be permitted to throw. A
 // boost::thread_resoruce_error is thrown at static destruction time,
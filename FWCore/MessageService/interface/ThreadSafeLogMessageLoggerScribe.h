@@ -19,6 +19,10 @@
 
 #include <iostream>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include "tbb/concurrent_queue.h"
 
 namespace edm {
@@ -59,6 +63,15 @@ private:
 
   // --- log one consumed message
   void log(ErrorObj * errorobj_p);
+  void logCatchingExceptions(ErrorObj * errorobj_p);
+
+  // --- asynchronous routing: the messages are logged by a thread of
+  //     their own, the other commands wait for the messages before them
+  void startRoutingThread();
+  void runRoutingThread();
+  void routeQueuedMessages();
+  void pushRoutedMessage(ErrorObj* errorobj_p);
+  bool popRoutedMessage(ErrorObj*& errorobj_p);
 
   // --- cause statistics destinations to output
   void triggerStatisticsSummaries();
@@ -111,6 +124,14 @@ private:
   std::atomic<int>  count;			// changeLog 9
   std::atomic<bool> m_messageBeingSent;
   tbb::concurrent_queue<ErrorObj*> m_waitingMessages;
+  std::atomic<bool> m_asynchronous;
+  std::mutex m_routingMutex;
+  std::thread m_routingThread;
+  // the messages to route, a null one stops the routing thread; they are
+  // only popped with m_routingMutex held, see runRoutingThread
+  std::mutex m_routedMessagesMutex;
+  std::condition_variable m_routedMessagesCondition;
+  std::deque<ErrorObj*> m_routedMessages;
   
 };  // ThreadSafeLogMessageLoggerScribe
 
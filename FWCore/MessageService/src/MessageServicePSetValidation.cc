@@ -61,6 +61,8 @@ messageLoggerPSet (ParameterSet const & pset)
   
   check<bool> 
   	( pset, "MessageLogger", "messageSummaryToJobReport" );
+  check<bool> 
+  	( pset, "MessageLogger", "asynchronousRouting" );
   std::string dumps = check<std::string> 
   	( pset, "MessageLogger", "generate_preconfiguration_message" );
   std::string thresh = check<std::string> 
@@ -83,7 +85,10 @@ messageLoggerPSet (ParameterSet const & pset)
 
   noneExcept <int> (pset, "MessageLogger", "int");
   noneExcept <unsigned int> (pset, "MessageLogger", "unsigned int");
-  noneExcept <bool> (pset, "MessageLogger","bool","messageSummaryToJobReport");
+  vString okbools;
+  okbools.push_back("messageSummaryToJobReport");
+  okbools.push_back("asynchronousRouting");
+  noneExcept <bool> (pset, "MessageLogger","bool",okbools);
   	// Note - at this, the upper MessageLogger PSet level, the use of 
 	// optionalPSet makes no sense, so we are OK letting that be a flaw
   noneExcept <float> (pset, "MessageLogger","float");
@@ -24,6 +24,7 @@
 
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
+#include "FWCore/Utilities/interface/UnixSignalHandlers.h"
 
 #include <algorithm>
 #include <cassert>
@@ -48,11 +49,18 @@ namespace edm {
     , purge_mode (false)						// changeLog 32
     , count (false)							// changeLog 32
     , m_messageBeingSent(false)
+    , m_asynchronous(false)
     {
     }
     
     ThreadSafeLogMessageLoggerScribe::~ThreadSafeLogMessageLoggerScribe()
     {
+      //the routing thread logs the messages queued before it stops
+      if(m_routingThread.joinable()) {
+        pushRoutedMessage(nullptr);
+        m_routingThread.join();
+      }
+
       //if there are any waiting message, finish them off
       ErrorObj* errorobj_p=nullptr;
       std::vector<std::string> categories;
@@ -77,6 +85,14 @@ namespace edm {
                                                  MessageLoggerQ::OpCode  opcode,
                                                  void * operand)
     {
+      // with asynchronous routing, the messages logged before a command
+      // are routed before it is run, and no message is routed meanwhile
+      std::unique_lock<std::mutex> routing;
+      if(m_asynchronous and opcode != MessageLoggerQ::LOG_A_MESSAGE) {
+        routing = std::unique_lock<std::mutex>(m_routingMutex);
+        routeQueuedMessages();
+      }
+
       switch(opcode)  {  // interpret the work item
         default:  {
           assert(false);  // can't happen (we certainly hope!)
@@ -87,32 +103,13 @@ namespace edm {
         }
         case MessageLoggerQ::LOG_A_MESSAGE:  {
           ErrorObj *  errorobj_p = static_cast<ErrorObj *>(operand);
-          try {
-            if(active && !purge_mode){
-              log (errorobj_p);
-            }
-          }
-          catch(cms::Exception& e)
-          {
-            ++count;
-            std::cerr << "ThreadSafeLogMessageLoggerScribe caught " << count
-            << " cms::Exceptions, text = \n"
-            << e.what() << "\n";
-            
-            if(count > 25)
-            {
-              cerr << "MessageLogger will no longer be processing "
-              << "messages due to errors (entering purge mode).\n";
-              purge_mode = true;
+          if(active && !purge_mode){
+            if(m_asynchronous) {
+              pushRoutedMessage(errorobj_p);
+            } else {
+              logCatchingExceptions(errorobj_p);
             }
           }
-          catch(...)
-          {
-            std::cerr << "ThreadSafeLogMessageLoggerScribe caught an unknown exception and "
-            << "will no longer be processing "
-            << "messages. (entering purge mode)\n";
-            purge_mode = true;
-          }
           break;
         }
         case MessageLoggerQ::CONFIGURE:  {			// changelog 17
@@ -200,6 +197,103 @@ namespace edm {
       
     }  // ThreadSafeLogMessageLoggerScribe::runCommand(opcode, operand)
     
+    void ThreadSafeLogMessageLoggerScribe::logCatchingExceptions ( ErrorObj *  errorobj_p ) {
+      try {
+        log (errorobj_p);
+      }
+      catch(cms::Exception& e)
+      {
+        ++count;
+        std::cerr << "ThreadSafeLogMessageLoggerScribe caught " << count
+        << " cms::Exceptions, text = \n"
+        << e.what() << "\n";
+        
+        if(count > 25)
+        {
+          cerr << "MessageLogger will no longer be processing "
+          << "messages due to errors (entering purge mode).\n";
+          purge_mode = true;
+        }
+      }
+      catch(...)
+      {
+        std::cerr << "ThreadSafeLogMessageLoggerScribe caught an unknown exception and "
+        << "will no longer be processing "
+        << "messages. (entering purge mode)\n";
+        purge_mode = true;
+      }
+    }
+    
+    // With asynchronous routing, the threads that log a message only
+    // queue it: the formatting, the limits and the output to the
+    // destinations are done here, on a thread of their own, in the order
+    // of the queue.
+    void ThreadSafeLogMessageLoggerScribe::startRoutingThread() {
+      if(m_routingThread.joinable()) return;
+      m_routingThread = std::thread(&ThreadSafeLogMessageLoggerScribe::runRoutingThread, this);
+      m_asynchronous = true;
+    }
+    
+    // The messages are popped with m_routingMutex held, so a command,
+    // which takes it, finds every message queued before it either routed
+    // or still in the queue, never popped and not yet routed.  The queue
+    // has a mutex of its own, so that a message logged while a command
+    // runs, even on the thread of the command, is queued without waiting.
+    void ThreadSafeLogMessageLoggerScribe::runRoutingThread() {
+      sigset_t oldset;
+      edm::disableAllSigs(&oldset);
+      while(true) {
+        {
+          std::unique_lock<std::mutex> queue(m_routedMessagesMutex);
+          m_routedMessagesCondition.wait(queue, [this]() { return not m_routedMessages.empty(); });
+        }
+        std::lock_guard<std::mutex> guard(m_routingMutex);
+        ErrorObj* errorobj_p=nullptr;
+        if(not popRoutedMessage(errorobj_p)) continue;  // routed by a command meanwhile
+        if(errorobj_p == nullptr) break;  // end of the job
+        if(purge_mode) {
+          delete errorobj_p;
+        } else {
+          logCatchingExceptions(errorobj_p);
+        }
+      }
+    }
+    
+    void ThreadSafeLogMessageLoggerScribe::pushRoutedMessage(ErrorObj* errorobj_p) {
+      {
+        std::lock_guard<std::mutex> queue(m_routedMessagesMutex);
+        m_routedMessages.push_back(errorobj_p);
+      }
+      m_routedMessagesCondition.notify_one();
+    }
+    
+    // called with m_routingMutex held
+    bool ThreadSafeLogMessageLoggerScribe::popRoutedMessage(ErrorObj*& errorobj_p) {
+      std::lock_guard<std::mutex> queue(m_routedMessagesMutex);
+      if(m_routedMessages.empty()) return false;
+      errorobj_p = m_routedMessages.front();
+      m_routedMessages.pop_front();
+      return true;
+    }
+    
+    // route the queued messages from the thread of a command, which holds
+    // m_routingMutex; the null message of the end of the job is left for
+    // the routing thread
+    void ThreadSafeLogMessageLoggerScribe::routeQueuedMessages() {
+      ErrorObj* errorobj_p=nullptr;
+      while(popRoutedMessage(errorobj_p)) {
+        if(errorobj_p == nullptr) {
+          pushRoutedMessage(nullptr);
+          break;
+        }
+        if(purge_mode) {
+          delete errorobj_p;
+        } else {
+          logCatchingExceptions(errorobj_p);
+        }
+      }
+    }
+    
     void ThreadSafeLogMessageLoggerScribe::log ( ErrorObj *  errorobj_p ) {
       bool expected = false;
       std::unique_ptr<ErrorObj> obj(errorobj_p);
@@ -258,6 +352,11 @@ namespace edm {
       
       configure_external_dests();
       
+      // once configured, the messages can be routed asynchronously
+      if(getAparameter<bool>(*job_pset_p, "asynchronousRouting", false)) {
+        startRoutingThread();
+      }
+      
     }  // ThreadSafeLogMessageLoggerScribe::configure_errorlog()
     
     
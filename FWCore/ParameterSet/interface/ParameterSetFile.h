@@ -0,0 +1,32 @@
+#ifndef FWCore_ParameterSet_ParameterSetFile_h
+#define FWCore_ParameterSet_ParameterSetFile_h
+
+//----------------------------------------------------------------------
+// Write a complete process ParameterSet, tracked and untracked, to a
+// file, and read it back without processing the configuration again.
+//
+// The file has a header line, the ParameterSetID of the ParameterSet,
+// the MD5 digest of the encoded ParameterSet and then the encoded
+// ParameterSet itself, with the nested ParameterSets written in place
+// instead of by their ID.  Reading the file checks both the digest and
+// the ParameterSetID.
+//----------------------------------------------------------------------
+
+#include <memory>
+#include <string>
+
+namespace edm {
+  class ParameterSet;
+
+  void
+  writeParameterSetFile(ParameterSet const& pset, std::string const& fileName);
+
+  /// true if the file starts with the header written by writeParameterSetFile
+  bool
+  isParameterSetFile(std::string const& fileName);
+
+  std::shared_ptr<ParameterSet>
+  readParameterSetFile(std::string const& fileName);
+}
+
+#endif
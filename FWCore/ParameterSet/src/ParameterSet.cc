@@ -202,7 +202,7 @@ namespace edm {
 //    id_ = ParameterSetID(md5alg.digest().toString());
     cms::Digest newDigest;
     toDigest(newDigest);
-    id_ = ParameterSetID(newDigest.digest().toString());
+    id_ = ParameterSetID(newDigest.digest().compactForm());
 //    assert(md5alg.digest().toString() == newDigest.digest().toString());
     assert(isRegistered());
   }
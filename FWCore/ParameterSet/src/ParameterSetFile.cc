@@ -0,0 +1,115 @@
+/*----------------------------------------------------------------------
+
+ParameterSetFile.cc
+
+----------------------------------------------------------------------*/
+
+#include "FWCore/ParameterSet/interface/ParameterSetFile.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Digest.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <fstream>
+#include <iterator>
+
+namespace edm {
+
+  namespace {
+    char const* const kHeader = "CMSSW ParameterSet file 1";
+
+    // like ParameterSet::allToString, but with the nested ParameterSets
+    // encoded in place, with all their parameters, rather than by their
+    // ID: ParameterSet::fromString reads them back as it does for the
+    // parameter sets by value of the old files
+    void
+    encodeInPlace(ParameterSet const& pset, std::string& rep) {
+      if(pset.empty()) {
+        rep += "<>";
+        return;
+      }
+      rep += '<';
+      char const* between = "";
+      for(auto const& item : pset.tbl()) {
+        rep += between;
+        rep += item.first;
+        rep += '=';
+        item.second.toString(rep);
+        between = ";";
+      }
+      for(auto const& item : pset.psetTable()) {
+        rep += between;
+        rep += item.first;
+        rep += item.second.isTracked() ? "=+P(" : "=-P(";
+        encodeInPlace(item.second.pset(), rep);
+        rep += ')';
+        between = ";";
+      }
+      for(auto const& item : pset.vpsetTable()) {
+        rep += between;
+        rep += item.first;
+        rep += item.second.isTracked() ? "=+p({" : "=-p({";
+        char const* comma = "";
+        for(auto const& element : item.second.vpset()) {
+          rep += comma;
+          encodeInPlace(element, rep);
+          comma = ",";
+        }
+        rep += "})";
+        between = ";";
+      }
+      rep += '>';
+    }
+  }
+
+  void
+  writeParameterSetFile(ParameterSet const& pset, std::string const& fileName) {
+    std::string rep;
+    encodeInPlace(pset, rep);
+
+    ParameterSet tracked(pset);
+    tracked.registerIt();
+
+    std::ofstream file(fileName.c_str(), std::ios::binary);
+    file << kHeader << '\n'
+         << tracked.id() << '\n'
+         << cms::Digest(rep).digest().toString() << '\n'
+         << rep;
+    file.close();
+    if(!file) {
+      throw Exception(errors::Configuration, "WriteFailed")
+        << "Could not write the ParameterSet file " << fileName << "\n";
+    }
+  }
+
+  bool
+  isParameterSetFile(std::string const& fileName) {
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    std::string header;
+    return std::getline(file, header) && header == kHeader;
+  }
+
+  std::shared_ptr<ParameterSet>
+  readParameterSetFile(std::string const& fileName) {
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    std::string header, id, digest;
+    if(!std::getline(file, header) || header != kHeader || !std::getline(file, id) || !std::getline(file, digest)) {
+      throw Exception(errors::Configuration, "InvalidInput")
+        << "The file " << fileName << " is not a ParameterSet file\n";
+    }
+    std::string rep((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if(cms::Digest(rep).digest().toString() != digest) {
+      throw Exception(errors::Configuration, "InvalidInput")
+        << "The ParameterSet file " << fileName << " is corrupted: the digest of its content does not match\n";
+    }
+    auto pset = std::make_shared<ParameterSet>(rep);
+    ParameterSet tracked(*pset);
+    tracked.registerIt();
+    if(tracked.id() != ParameterSetID(id)) {
+      throw Exception(errors::Configuration, "InvalidInput")
+        << "The ParameterSet read from " << fileName << " has ID " << tracked.id()
+        << " instead of the ID " << id << " it was written with\n";
+    }
+    return pset;
+  }
+}
@@ -33,6 +33,10 @@ namespace edm {
   
     bool
     Registry::insertMapped(value_type const& v) {
+      //the same ParameterSet is often registered many times, do not copy it for nothing
+      if(m_map.find(v.id()) != m_map.end()) {
+        return false;
+      }
       return m_map.insert(std::make_pair(v.id(),v)).second;
     }
     
@@ -10,6 +10,7 @@
 #include <cassert>
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetFile.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/Digest.h"
@@ -39,6 +40,7 @@ class testps: public CppUnit::TestFixture
   CPPUNIT_TEST(testCopyFrom);
   CPPUNIT_TEST(testGetParameterAsString);
   CPPUNIT_TEST(calculateIDTest);
+  CPPUNIT_TEST(testParameterSetFile);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -65,6 +67,7 @@ public:
   void testCopyFrom();
   void testGetParameterAsString();
   void calculateIDTest();
+  void testParameterSetFile();
   // Still more to do...
 private:
 };
@@ -631,4 +634,36 @@ void testps::testGetParameterAsString()
   CPPUNIT_ASSERT(vpsetStr == vpsetStr2);
 }
 
+void testps::testParameterSetFile()
+{
+  // two nested sets which differ only in their untracked parameters
+  edm::ParameterSet a, b, top;
+  a.addParameter<std::string>("s", "a;b<c>,d");
+  a.addUntrackedParameter<int>("u", 1);
+  b.addParameter<std::string>("s", "a;b<c>,d");
+  b.addUntrackedParameter<int>("u", 2);
+  top.addParameter<edm::ParameterSet>("a", a);
+  top.addUntrackedParameter<edm::ParameterSet>("b", b);
+  top.addParameter<std::vector<edm::ParameterSet> >("vps", std::vector<edm::ParameterSet>{a, b});
+  top.addUntrackedParameter<std::vector<edm::ParameterSet> >("empty", std::vector<edm::ParameterSet>());
+  top.addParameter<double>("d", 1.5);
+
+  std::string const fileName("testParameterSetFile.pset");
+  edm::writeParameterSetFile(top, fileName);
+  CPPUNIT_ASSERT(edm::isParameterSetFile(fileName));
+  std::shared_ptr<edm::ParameterSet> read = edm::readParameterSetFile(fileName);
+  CPPUNIT_ASSERT(read->getParameterSet("a").getUntrackedParameter<int>("u") == 1);
+  CPPUNIT_ASSERT(read->getUntrackedParameterSet("b").getUntrackedParameter<int>("u") == 2);
+  std::vector<edm::ParameterSet> vps = read->getParameter<std::vector<edm::ParameterSet> >("vps");
+  CPPUNIT_ASSERT(vps.size() == 2);
+  CPPUNIT_ASSERT(vps[1].getUntrackedParameter<int>("u") == 2);
+  CPPUNIT_ASSERT(vps[1].getParameter<std::string>("s") == "a;b<c>,d");
+
+  std::string written, readBack;
+  top.registerIt().allToString(written);
+  read->registerIt().allToString(readBack);
+  CPPUNIT_ASSERT(written == readBack);
+  CPPUNIT_ASSERT(top.id() == read->id());
+}
+
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
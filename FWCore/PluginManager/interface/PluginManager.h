@@ -86,6 +86,13 @@ class PluginManager
       //If can not find iPlugin in category iCategory return null pointer, any other failure will cause a throw
       const SharedLibrary* tryToLoad(const std::string& iCategory,
                                      const std::string& iPlugin);
+
+      /**Reads the files of the plugins, which are not loaded yet, in parallel so that they are in the
+        page cache, or the local cache of a network file system, when they are loaded. Unknown plugins
+        are ignored: they are reported when they are loaded.
+        */
+      void prefetch(const std::string& iCategory,
+                    const std::vector<std::string>& iPlugins) const;
       
       // ---------- static member functions --------------------
       ///file name of the shared object being loaded
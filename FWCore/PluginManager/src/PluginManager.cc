@@ -16,6 +16,7 @@
 #include <fstream>
 #include <functional>
 #include <set>
+#include "tbb/parallel_for.h"
 
 // TEMPORARY
 #include "TInterpreter.h"
@@ -318,6 +319,33 @@ PluginManager::tryToLoad(const std::string& iCategory,
   return (itLoaded->second).get();
 }
 
+void
+PluginManager::prefetch(const std::string& iCategory,
+                        const std::vector<std::string>& iPlugins) const
+{
+  CategoryToInfos::const_iterator itFound = categoryToInfos_.find(iCategory);
+  if(itFound == categoryToInfos_.end()) {
+    return;
+  }
+  std::set<boost::filesystem::path> paths;
+  for(auto const& plugin : iPlugins) {
+    PluginInfo i;
+    i.name_ = plugin;
+    auto range = std::equal_range(itFound->second.begin(), itFound->second.end(), i, PICompare());
+    //the first match is the one which load uses
+    if(range.first != range.second && loadables_.find(range.first->loadable_) == loadables_.end()) {
+      paths.insert(range.first->loadable_);
+    }
+  }
+  std::vector<boost::filesystem::path> toRead(paths.begin(), paths.end());
+  tbb::parallel_for(std::size_t(0), toRead.size(), [&toRead](std::size_t iIndex) {
+      std::ifstream file(toRead[iIndex].string().c_str(), std::ios::binary);
+      std::vector<char> buffer(1 << 20);
+      //the content is not needed, only the reading of it
+      while(file.read(&buffer[0], buffer.size())) {}
+    });
+}
+
 //
 // static member functions
 //
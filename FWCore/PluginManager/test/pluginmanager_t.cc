@@ -98,6 +98,13 @@ TestPluginManager::test()
   unsigned int nTimesLoaded=0;
   edmplugin::PluginManager::get()->justLoaded_.connect([&nTimesLoaded](const edmplugin::SharedLibrary&){++nTimesLoaded;});
   
+  //prefetching only reads the files
+  db.prefetch("Test Dummy", std::vector<std::string>{"DummyOne", "DummyThree", "DoesNotExist"});
+  db.prefetch("Not A Category", std::vector<std::string>{"DummyOne"});
+  CPPUNIT_ASSERT(nTimesAsked == 0);
+  CPPUNIT_ASSERT(nTimesGoingToLoad==0);
+  CPPUNIT_ASSERT(nTimesLoaded==0);
+
   toLoadPlugin="DummyOne";
   std::unique_ptr<DummyBase> ptr(DummyFactory::get()->create("DummyOne"));
   CPPUNIT_ASSERT(1==ptr->value());
@@ -684,6 +684,38 @@ namespace edm {
       }
       AR_WATCH_USING_METHOD_2(watchPostModuleEvent)
 
+      /// signal is emitted before the module starts prefetching the products it consumes for the Event
+      typedef signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> PreModuleEventPrefetching;
+      PreModuleEventPrefetching preModuleEventPrefetchingSignal_;
+      void watchPreModuleEventPrefetching(PreModuleEventPrefetching::slot_type const& iSlot) {
+         preModuleEventPrefetchingSignal_.connect(iSlot);
+      }
+      AR_WATCH_USING_METHOD_2(watchPreModuleEventPrefetching)
+
+      /// signal is emitted after the module finished prefetching the products it consumes for the Event
+      typedef signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> PostModuleEventPrefetching;
+      PostModuleEventPrefetching postModuleEventPrefetchingSignal_;
+      void watchPostModuleEventPrefetching(PostModuleEventPrefetching::slot_type const& iSlot) {
+         postModuleEventPrefetchingSignal_.connect_front(iSlot);
+      }
+      AR_WATCH_USING_METHOD_2(watchPostModuleEventPrefetching)
+
+      /// signal is emitted before the module starts the acquire method for the Event
+      typedef signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> PreModuleEventAcquire;
+      PreModuleEventAcquire preModuleEventAcquireSignal_;
+      void watchPreModuleEventAcquire(PreModuleEventAcquire::slot_type const& iSlot) {
+         preModuleEventAcquireSignal_.connect(iSlot);
+      }
+      AR_WATCH_USING_METHOD_2(watchPreModuleEventAcquire)
+
+      /// signal is emitted after the module finishes the acquire method for the Event
+      typedef signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> PostModuleEventAcquire;
+      PostModuleEventAcquire postModuleEventAcquireSignal_;
+      void watchPostModuleEventAcquire(PostModuleEventAcquire::slot_type const& iSlot) {
+         postModuleEventAcquireSignal_.connect_front(iSlot);
+      }
+      AR_WATCH_USING_METHOD_2(watchPostModuleEventAcquire)
+
       /// signal is emitted after the module starts processing the Event and before a delayed get has started
       typedef signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> PreModuleEventDelayedGet;
       PreModuleEventDelayedGet preModuleEventDelayedGetSignal_;
@@ -39,6 +39,8 @@
 
 #include "TThread.h"
 #include "TClassTable.h"
+#include "RConfigure.h"
+#include "RVersion.h"
 
 #include <memory>
 
@@ -80,6 +82,7 @@ namespace edm {
       bool resetErrHandler_;
       bool loadAllDictionaries_;
       bool autoLibraryLoader_;
+      bool enableIMT_;
       std::shared_ptr<const void> sigBusHandler_;
       std::shared_ptr<const void> sigSegvHandler_;
       std::shared_ptr<const void> sigIllHandler_;
@@ -561,7 +564,8 @@ namespace edm {
         unloadSigHandler_(pset.getUntrackedParameter<bool> ("UnloadRootSigHandler")),
         resetErrHandler_(pset.getUntrackedParameter<bool> ("ResetRootErrHandler")),
         loadAllDictionaries_(pset.getUntrackedParameter<bool>("LoadAllDictionaries")),
-        autoLibraryLoader_(loadAllDictionaries_ or pset.getUntrackedParameter<bool> ("AutoLibraryLoader"))
+        autoLibraryLoader_(loadAllDictionaries_ or pset.getUntrackedParameter<bool> ("AutoLibraryLoader")),
+        enableIMT_(pset.getUntrackedParameter<bool>("EnableIMT"))
     {
       
       if(unloadSigHandler_) {
@@ -656,6 +660,17 @@ namespace edm {
       
       //Have to avoid having Streamers modify themselves after they have been used
       TVirtualStreamerInfo::Optimize(false);
+
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+      //ROOT's tasks run in the TBB scheduler already set up with the job's number of threads
+      if(enableIMT_) {
+        ROOT::EnableImplicitMT();
+      }
+#else
+      if(enableIMT_) {
+        LogWarning("InitRootHandlers") << "EnableIMT is ignored: this version of ROOT does not support implicit multi-threading.";
+      }
+#endif
     }
     
     void InitRootHandlers::initializeThisThreadForUse() {
@@ -677,6 +692,8 @@ namespace edm {
       ->setComment("If True, do an abort when a signal occurs that causes a crash. If False, ROOT will do an exit which attempts to do a clean shutdown.");
       desc.addUntracked<int>("DebugLevel",0)
  	  ->setComment("Sets ROOT's gDebug value.");
+      desc.addUntracked<bool>("EnableIMT",false)
+      ->setComment("If True, and the job uses more than one stream, calls ROOT::EnableImplicitMT() so ROOT can run internal work (e.g. PoolOutputModule's concurrentBasketCompression) in TBB tasks.");
       descriptions.add("InitRootHandlers", desc);
     }
 
@@ -0,0 +1,330 @@
+// -*- C++ -*-
+//
+// Package:     Services
+// Class  :     PerformanceStreamService
+//
+// Implementation:
+//     Writes, while the job runs, one JSON object per line to a file: a record
+//     at the end of each luminosity block with the throughput since the
+//     previous record, the memory and the I/O statistics, and at a fixed
+//     interval the same with the CPU time spent in each module so far.
+//     Monitoring can follow the file with 'tail -f' and spot stalled or slow
+//     jobs without waiting for the job report.
+//
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/GlobalContext.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/SystemBounds.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "Utilities/StorageFactory/interface/StorageAccount.h"
+
+#include <time.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace edm {
+
+  namespace service {
+
+    class PerformanceStreamService {
+
+    public:
+
+      explicit PerformanceStreamService(ParameterSet const& pset, ActivityRegistry& ar);
+      PerformanceStreamService(PerformanceStreamService const&) = delete;
+      PerformanceStreamService& operator=(PerformanceStreamService const&) = delete;
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+
+      void preallocate(SystemBounds const&);
+      void postModuleConstruction(ModuleDescription const&);
+      void postBeginJob();
+      void postEndJob();
+      void postEvent(StreamContext const&);
+      void postGlobalEndLumi(GlobalContext const&);
+      void preModuleEvent(StreamContext const&, ModuleCallingContext const&);
+      void postModuleEvent(StreamContext const&, ModuleCallingContext const&);
+
+      void writeRecord(char const* type, GlobalContext const* lumi, bool withModules);
+      void addMemory(std::ostream& os) const;
+      void addStorage(std::ostream& os) const;
+      void addModules(std::ostream& os) const;
+
+      std::ofstream m_file;
+      std::mutex m_fileMutex;
+      bool m_moduleCPU;
+      std::chrono::seconds m_updateInterval;
+      unsigned int m_streams = 0;
+
+      std::chrono::steady_clock::time_point m_beginJob;
+      std::atomic<std::chrono::steady_clock::rep> m_lastUpdate;
+      std::atomic_flag m_updating;
+      std::atomic<std::uint_least64_t> m_events;
+      // the state of the previous record, guarded by m_fileMutex
+      std::chrono::steady_clock::time_point m_lastRecordTime;
+      std::uint_least64_t m_lastRecordEvents = 0;
+
+      // per module id, the label and the thread CPU time in nanoseconds
+      std::vector<std::string> m_moduleLabels;
+      std::unique_ptr<std::atomic<std::uint_least64_t>[]> m_moduleCPUTime;
+      std::atomic<bool> m_running;
+    };
+  }
+}
+
+using namespace edm::service;
+
+namespace {
+  constexpr unsigned int kDefaultUpdateInterval = 60;
+
+  std::uint_least64_t threadCPU() {
+    timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return static_cast<std::uint_least64_t>(t.tv_sec)*1000000000ull + t.tv_nsec;
+  }
+
+  //NOTE: as in the Timing service, a per thread stack of start times since
+  // unscheduled execution or tbb task spawning can cause a module to run on
+  // the same thread as an already running module
+  std::vector<std::uint_least64_t>& moduleCPUStack() {
+    static thread_local std::vector<std::uint_least64_t> s_stack;
+    return s_stack;
+  }
+
+  void writeString(std::ostream& os, std::string const& s) {
+    os << '"';
+    for(char c : s) {
+      if(c == '"' || c == '\\') os << '\\';
+      os << c;
+    }
+    os << '"';
+  }
+}
+
+PerformanceStreamService::PerformanceStreamService(ParameterSet const& pset, ActivityRegistry& ar) :
+  m_moduleCPU(pset.getUntrackedParameter<bool>("moduleCPU")),
+  m_updateInterval(pset.getUntrackedParameter<unsigned int>("updateIntervalSeconds")),
+  m_lastUpdate(0),
+  m_events(0),
+  m_running(false)
+{
+  m_updating.clear();
+  std::string const fileName = pset.getUntrackedParameter<std::string>("fileName");
+  m_file.open(fileName.c_str(), std::ios::out | std::ios::trunc);
+  if(!m_file) {
+    throw cms::Exception("Configuration") << "PerformanceStreamService cannot open '" << fileName << "' for writing";
+  }
+
+  ar.preallocateSignal_.connect([this](SystemBounds const& iBounds) { preallocate(iBounds); });
+  ar.watchPostModuleConstruction(this, &PerformanceStreamService::postModuleConstruction);
+  ar.watchPostBeginJob(this, &PerformanceStreamService::postBeginJob);
+  ar.watchPostEndJob(this, &PerformanceStreamService::postEndJob);
+  ar.watchPostEvent(this, &PerformanceStreamService::postEvent);
+  ar.watchPostGlobalEndLumi(this, &PerformanceStreamService::postGlobalEndLumi);
+  if(m_moduleCPU) {
+    ar.watchPreModuleEvent(this, &PerformanceStreamService::preModuleEvent);
+    ar.watchPostModuleEvent(this, &PerformanceStreamService::postModuleEvent);
+  }
+}
+
+void
+PerformanceStreamService::preallocate(SystemBounds const& iBounds) {
+  m_streams = iBounds.maxNumberOfStreams();
+}
+
+void
+PerformanceStreamService::postModuleConstruction(ModuleDescription const& md) {
+  if(md.id() >= m_moduleLabels.size()) {
+    m_moduleLabels.resize(md.id()+1);
+  }
+  m_moduleLabels[md.id()] = md.moduleLabel();
+}
+
+void
+PerformanceStreamService::postBeginJob() {
+  // the modules are all constructed by now
+  m_moduleCPUTime.reset(new std::atomic<std::uint_least64_t>[m_moduleLabels.size()]);
+  for(unsigned int i = 0; i != m_moduleLabels.size(); ++i) {
+    m_moduleCPUTime[i] = 0;
+  }
+  m_beginJob = std::chrono::steady_clock::now();
+  m_lastUpdate = m_beginJob.time_since_epoch().count();
+  m_lastRecordTime = m_beginJob;
+  m_running = true;
+  writeRecord("begin", nullptr, false);
+}
+
+void
+PerformanceStreamService::postEndJob() {
+  writeRecord("end", nullptr, true);
+  m_running = false;
+}
+
+void
+PerformanceStreamService::postEvent(StreamContext const&) {
+  ++m_events;
+  // a periodic record, written by the first thread that sees it is due
+  auto now = std::chrono::steady_clock::now();
+  auto last = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(m_lastUpdate.load(std::memory_order_relaxed)));
+  if(now - last < m_updateInterval) return;
+  if(m_updating.test_and_set(std::memory_order_acquire)) return;
+  m_lastUpdate = now.time_since_epoch().count();
+  try {
+    writeRecord("status", nullptr, m_moduleCPU);
+  } catch(...) {
+    m_updating.clear(std::memory_order_release);
+    throw;
+  }
+  m_updating.clear(std::memory_order_release);
+}
+
+void
+PerformanceStreamService::postGlobalEndLumi(GlobalContext const& gc) {
+  writeRecord("lumi", &gc, false);
+}
+
+void
+PerformanceStreamService::preModuleEvent(StreamContext const&, ModuleCallingContext const&) {
+  moduleCPUStack().push_back(threadCPU());
+}
+
+void
+PerformanceStreamService::postModuleEvent(StreamContext const&, ModuleCallingContext const& mcc) {
+  auto& stack = moduleCPUStack();
+  if(stack.empty()) return;
+  std::uint_least64_t t = threadCPU() - stack.back();
+  stack.pop_back();
+  //move waiting module start times forward to account
+  // for the fact that they were paused while this module ran
+  for(auto& waitingModuleStart : stack) {
+    waitingModuleStart += t;
+  }
+  unsigned int id = mcc.moduleDescription()->id();
+  if(m_running && id < m_moduleLabels.size()) {
+    m_moduleCPUTime[id] += t;
+  }
+}
+
+void
+PerformanceStreamService::writeRecord(char const* type, GlobalContext const* lumi, bool withModules) {
+  std::lock_guard<std::mutex> guard(m_fileMutex);
+  auto now = std::chrono::steady_clock::now();
+  std::uint_least64_t events = m_events;
+  double elapsed = std::chrono::duration<double>(now - m_beginJob).count();
+  double sinceLast = std::chrono::duration<double>(now - m_lastRecordTime).count();
+
+  std::ostringstream os;
+  os << "{\"type\":\"" << type << "\""
+     << ",\"time\":" << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count()
+     << ",\"elapsed\":" << elapsed
+     << ",\"streams\":" << m_streams;
+  if(lumi) {
+    os << ",\"run\":" << lumi->luminosityBlockID().run()
+       << ",\"lumi\":" << lumi->luminosityBlockID().luminosityBlock();
+  }
+  os << ",\"events\":" << events
+     << ",\"rate\":" << (sinceLast > 0 ? (events - m_lastRecordEvents)/sinceLast : 0.);
+  addMemory(os);
+  addStorage(os);
+  if(withModules) {
+    addModules(os);
+  }
+  os << "}\n";
+
+  m_lastRecordTime = now;
+  m_lastRecordEvents = events;
+  m_file << os.str() << std::flush;
+}
+
+void
+PerformanceStreamService::addMemory(std::ostream& os) const {
+  // sizes in kB, VmHWM being the high-water mark of the resident size
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while(std::getline(status, line)) {
+    char const* key = nullptr;
+    if(line.compare(0, 7, "VmSize:") == 0) key = "vsizeKB";
+    else if(line.compare(0, 6, "VmRSS:") == 0) key = "rssKB";
+    else if(line.compare(0, 6, "VmHWM:") == 0) key = "rssPeakKB";
+    else continue;
+    std::istringstream value(line.substr(line.find(':')+1));
+    unsigned long kB = 0;
+    value >> kB;
+    os << ",\"" << key << "\":" << kB;
+  }
+}
+
+void
+PerformanceStreamService::addStorage(std::ostream& os) const {
+  // the StorageFactory layer only, as in the CondorStatusService
+  std::uint_least64_t readOps = 0, readBytes = 0, writeBytes = 0;
+  double readTime = 0, writeTime = 0;
+  auto const token = StorageAccount::tokenForStorageClassName("tstoragefile");
+  for(auto const& storage : StorageAccount::summary()) {
+    if(storage.first == token.value()) continue;
+    for(auto const& counter : storage.second) {
+      if(counter.first == static_cast<int>(StorageAccount::Operation::read) ||
+         counter.first == static_cast<int>(StorageAccount::Operation::readv)) {
+        readOps += counter.second.successes;
+        readBytes += counter.second.amount;
+        readTime += counter.second.timeTotal;
+      } else if(counter.first == static_cast<int>(StorageAccount::Operation::write) ||
+                counter.first == static_cast<int>(StorageAccount::Operation::writev)) {
+        writeBytes += counter.second.amount;
+        writeTime += counter.second.timeTotal;
+      }
+    }
+  }
+  os << ",\"readOps\":" << readOps
+     << ",\"readBytes\":" << readBytes
+     << ",\"readTimeMsecs\":" << static_cast<std::uint_least64_t>(readTime/(1000*1000))
+     << ",\"writeBytes\":" << writeBytes
+     << ",\"writeTimeMsecs\":" << static_cast<std::uint_least64_t>(writeTime/(1000*1000));
+}
+
+void
+PerformanceStreamService::addModules(std::ostream& os) const {
+  if(!m_moduleCPUTime) return;
+  os << ",\"moduleCPU\":{";
+  bool first = true;
+  for(unsigned int i = 0; i != m_moduleLabels.size(); ++i) {
+    if(m_moduleLabels[i].empty()) continue;
+    if(!first) os << ',';
+    first = false;
+    writeString(os, m_moduleLabels[i]);
+    os << ':' << m_moduleCPUTime[i]*1e-9;
+  }
+  os << '}';
+}
+
+void
+PerformanceStreamService::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.setComment("Service writing, while the job runs, its throughput, memory, I/O and per module CPU time as one JSON object per line.");
+  desc.addUntracked<std::string>("fileName", "performance.jsonl")
+    ->setComment("File receiving the records");
+  desc.addUntracked<unsigned int>("updateIntervalSeconds", kDefaultUpdateInterval)
+    ->setComment("Interval, in seconds, between the periodic records, which come in addition to one at the end of each luminosity block");
+  desc.addUntracked<bool>("moduleCPU", true)
+    ->setComment("Measure the CPU time of the thread running each module for each event, reported in the periodic records. The work a module hands over to other threads is not counted.");
+  descriptions.add("PerformanceStreamService", desc);
+}
+
+typedef edm::serviceregistry::AllArgsMaker<edm::service::PerformanceStreamService> PerformanceStreamServiceMaker;
+DEFINE_FWK_SERVICE_MAKER(PerformanceStreamService, PerformanceStreamServiceMaker);
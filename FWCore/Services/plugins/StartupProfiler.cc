@@ -0,0 +1,168 @@
+// -*- C++ -*-
+//
+// Package:     Services
+// Class  :     StartupProfiler
+//
+// Implementation:
+//     Times the phases of the start of the job, and the construction and
+//     the beginJob of each module, with the signals of the ActivityRegistry.
+//     The report is printed once beginJob is done.
+//
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/resource.h>
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+
+namespace edm {
+  namespace service {
+    class StartupProfiler {
+    public:
+      StartupProfiler(ParameterSet const&, ActivityRegistry&);
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      typedef std::chrono::steady_clock Clock;
+
+      struct ModuleTimes {
+        std::string label;
+        std::string type;
+        double construction = 0.;   // seconds
+        double beginJob = 0.;       // seconds
+      };
+
+      ModuleTimes& module(ModuleDescription const&);
+      static double seconds(Clock::time_point iFrom, Clock::time_point iTo) {
+        return std::chrono::duration<double>(iTo - iFrom).count();
+      }
+      void report();
+
+      unsigned int const m_maxModules;
+      double const m_cpuBeforeServices;
+      Clock::time_point const m_start;
+      Clock::time_point m_preSource;
+      Clock::time_point m_postSource;
+      Clock::time_point m_preBeginJob;
+      Clock::time_point m_postBeginJob;
+      Clock::time_point m_moduleStart;
+      std::vector<ModuleTimes> m_modules;
+      std::unordered_map<unsigned int, unsigned int> m_moduleIndex;
+    };
+  }
+}
+
+using namespace edm::service;
+
+namespace {
+  double cpuTime() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec*1E-6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec*1E-6;
+  }
+}
+
+StartupProfiler::StartupProfiler(ParameterSet const& iPS, ActivityRegistry& iRegistry) :
+  m_maxModules(iPS.getUntrackedParameter<unsigned int>("maxModules")),
+  m_cpuBeforeServices(cpuTime()),
+  m_start(Clock::now()),
+  m_preSource(m_start),
+  m_postSource(m_start),
+  m_preBeginJob(m_start),
+  m_postBeginJob(m_start),
+  m_moduleStart(m_start)
+{
+  iRegistry.watchPreSourceConstruction([this](ModuleDescription const&) { m_preSource = Clock::now(); });
+  iRegistry.watchPostSourceConstruction([this](ModuleDescription const&) { m_postSource = Clock::now(); });
+
+  // the modules are constructed, and their beginJob run, one after the other
+  iRegistry.watchPreModuleConstruction([this](ModuleDescription const&) { m_moduleStart = Clock::now(); });
+  iRegistry.watchPostModuleConstruction([this](ModuleDescription const& iDesc) {
+      module(iDesc).construction += seconds(m_moduleStart, Clock::now());
+    });
+  iRegistry.watchPreModuleBeginJob([this](ModuleDescription const&) { m_moduleStart = Clock::now(); });
+  iRegistry.watchPostModuleBeginJob([this](ModuleDescription const& iDesc) {
+      module(iDesc).beginJob += seconds(m_moduleStart, Clock::now());
+    });
+
+  iRegistry.watchPreBeginJob([this](PathsAndConsumesOfModulesBase const&, ProcessContext const&) {
+      m_preBeginJob = Clock::now();
+    });
+  iRegistry.watchPostBeginJob([this]() {
+      m_postBeginJob = Clock::now();
+      report();
+    });
+}
+
+void
+StartupProfiler::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.addUntracked<unsigned int>("maxModules", 20)->setComment("Number of modules listed, the slowest to construct and to run beginJob first.");
+  descriptions.add("StartupProfiler", desc);
+  descriptions.setComment("This service reports the time spent in each phase of the start of the job, up to the end of beginJob, and in the construction and the beginJob of each module.");
+}
+
+StartupProfiler::ModuleTimes&
+StartupProfiler::module(ModuleDescription const& iDesc) {
+  auto itFound = m_moduleIndex.find(iDesc.id());
+  if(itFound == m_moduleIndex.end()) {
+    itFound = m_moduleIndex.emplace(iDesc.id(), m_modules.size()).first;
+    m_modules.emplace_back();
+    m_modules.back().label = iDesc.moduleLabel();
+    m_modules.back().type = iDesc.moduleName();
+  }
+  return m_modules[itFound->second];
+}
+
+void
+StartupProfiler::report() {
+  double construction = 0.;
+  double beginJob = 0.;
+  for(auto const& times : m_modules) {
+    construction += times.construction;
+    beginJob += times.beginJob;
+  }
+  // the source is made after the EventSetup modules and before the other modules
+  double const schedule = seconds(m_postSource, m_preBeginJob);
+
+  LogVerbatim out("StartupProfiler");
+  out << "StartupProfiler> Time since the start of the services " << seconds(m_start, m_postBeginJob) << " s\n"
+      << " - CPU time before the services (configuration, plugin loading): " << m_cpuBeforeServices << " s\n"
+      << " - services, EventSetup modules and looper: " << seconds(m_start, m_preSource) << " s\n"
+      << " - source: " << seconds(m_preSource, m_postSource) << " s\n"
+      << " - schedule: " << schedule << " s, of which module construction " << construction << " s\n"
+      << " - beginJob: " << seconds(m_preBeginJob, m_postBeginJob) << " s, of which modules " << beginJob << " s\n";
+
+  // sort pointers, m_moduleIndex refers to the positions in m_modules
+  std::vector<ModuleTimes const*> sorted;
+  sorted.reserve(m_modules.size());
+  for(auto const& times : m_modules) {
+    sorted.push_back(&times);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](ModuleTimes const* a, ModuleTimes const* b) {
+      return a->construction + a->beginJob > b->construction + b->beginJob;
+    });
+  out << "StartupProfiler> The " << std::min<std::size_t>(m_maxModules, m_modules.size()) << " slowest of "
+      << m_modules.size() << " modules\n"
+      << std::setw(40) << "label" << std::setw(40) << "type"
+      << std::setw(16) << "construction" << std::setw(12) << "beginJob" << "\n";
+  unsigned int nPrinted = 0;
+  for(auto const* ptimes : sorted) {
+    if(nPrinted++ == m_maxModules) break;
+    auto const& times = *ptimes;
+    out << std::setw(40) << times.label << std::setw(40) << times.type
+        << std::setw(16) << times.construction << std::setw(12) << times.beginJob << "\n";
+  }
+}
+
+DEFINE_FWK_SERVICE(StartupProfiler);
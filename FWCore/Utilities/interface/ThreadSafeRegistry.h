@@ -4,7 +4,7 @@
 #include <map>
 #include <vector>
 #include <ostream>
-#include <mutex>
+#include "tbb/concurrent_unordered_map.h"
 
 // ----------------------------------------------------------------------
 
@@ -14,6 +14,11 @@
 /// value_type object, and which must uniquely identify the
 /// value_type's value.
 ///
+/// The objects are held in a tbb::concurrent_unordered_map, as in the
+/// ParameterSet and Parentage registries, so lookups take no lock and
+/// may run concurrently with insertions. An inserted object is never
+/// moved or removed, so the pointers returned by getMapped stay valid.
+///
 /// This class is sufficiently thread-safe to be usable in a
 /// thread-safe manner. Don't let  the name mislead you  into thinking
 /// it provides more guarantee than that!
@@ -24,19 +29,30 @@
 ///
 ///  must be legal, and must return the unique key associated with
 ///  the value of 'm'.
+///
+/// By default the key is hashed with its smallHash() member, which the
+/// edm::Hash based IDs provide.
 // ----------------------------------------------------------------------
 
 #pragma GCC visibility push(default)
 namespace edm {
   namespace detail {
 
+    template <typename KEY>
+    struct SmallHash {
+      std::size_t operator()(KEY const& iKey) const {
+        return iKey.smallHash();
+      }
+    };
+
     template <typename KEY, typename T>
     class ThreadSafeRegistry {
     public:
       typedef KEY   key_type;
       typedef T     value_type;
       typedef typename std::map<key_type, value_type> collection_type;
-      typedef typename collection_type::size_type      size_type;
+      typedef tbb::concurrent_unordered_map<key_type, value_type, SmallHash<key_type> > map_type;
+      typedef typename map_type::size_type             size_type;
 
       typedef typename std::vector<value_type> vector_type;
 
@@ -90,8 +106,7 @@ namespace edm {
       ThreadSafeRegistry<KEY,T>& 
       operator= (ThreadSafeRegistry<KEY,T> const&);
 
-      mutable std::mutex mutex_;
-      collection_type data_;
+      map_type data_;
     };
 
     template <typename KEY, typename T, typename E>
@@ -122,7 +137,6 @@ namespace edm {
     inline
     bool
     ThreadSafeRegistry<KEY,T>::empty() const {
-      std::lock_guard<std::mutex> guard(mutex_);
       return data_.empty();
     }
     
@@ -137,14 +151,12 @@ namespace edm {
     inline
     typename ThreadSafeRegistry<KEY,T>::size_type
     ThreadSafeRegistry<KEY,T>::size() const {
-      std::lock_guard<std::mutex> guard(mutex_);
       return data_.size();
     }
 
     template <typename KEY, typename T>
     void
     ThreadSafeRegistry<KEY,T>::print(std::ostream& os) const {
-      std::lock_guard<std::mutex> guard(mutex_);
       os << "Registry with " << size() << " entries\n";
       for (auto const& item: data_) {
 	  os << item.first << " " << item.second << '\n';
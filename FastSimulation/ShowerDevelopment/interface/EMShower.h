@@ -105,6 +105,7 @@ class EMShower
   std::vector<double> TSpot;
   std::vector<double> aSpot; 
   std::vector<double> bSpot;
+  std::vector<double> tgammaSpot;
 
   // F.B : Use the maximum of the shower rather the center of gravity 
   //  std::vector<double> meanDepth;  
@@ -110,6 +110,8 @@ EMShower::EMShower(const RandomEngineAndDistribution* engine,
     TSpot.push_back(theParam->meanTSpot(theMeanT));
     aSpot.push_back(theParam->meanAlphaSpot(theMeanAlpha));
     bSpot.push_back((aSpot[i]-1.)/TSpot[i]);
+    // the normalization of the spot profile, constant along the shower
+    tgammaSpot.push_back(tgamma(aSpot[i]));
     //    myHistos->fill("h7000",a[i]);
     //    myHistos->fill("h7002",E[i],a[i]);
   }
@@ -436,7 +438,7 @@ EMShower::compute() {
 	// Expected spot number
 	nS = ( theNumberOfSpots[i] * gam(bSpot[i]*tt,aSpot[i]) 
 	                           * bSpot[i] * dt 
-		                   / tgamma(aSpot[i]) );
+		                   / tgammaSpot[i] );
 	
       // Preshower : Expected number of mips + fluctuation
       }
@@ -444,7 +446,7 @@ EMShower::compute() {
 
 	nS = ( theNumberOfSpots[i] * gam(bSpot[i]*tt,aSpot[i]) 
 	       * bSpot[i] * dt 
-	       / tgamma(aSpot[i]))* theHCAL->spotFraction();
+	       / tgammaSpot[i])* theHCAL->spotFraction();
 	double nSo = nS ;
 	nS = random->poissonShoot(nS);
 	// 'Quick and dirty' fix (but this line should be better removed):
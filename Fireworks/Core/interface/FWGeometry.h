@@ -18,6 +18,8 @@ class TObjArray;
 
 #include "Fireworks/Core/interface/FWRecoGeom.h"
 
+#include <array>
+#include <list>
 #include <map>
 #include <vector>
 
@@ -64,6 +66,9 @@ public:
    static TFile* findFile( const char* fileName );
 
    // extract locally positioned shape for stand alone use
+   // the shapes are shared between the ids with the same dimensions and
+   // reference counted in their unique id, as TEveGeoShape does: give them
+   // to a TEveGeoShape, do not delete or modify them
    TGeoShape* getShape( unsigned int id ) const;
   
    // extract globally positioned shape for stand alone use
@@ -113,7 +118,7 @@ public:
 
    IdToInfoItr mapEnd() const {return m_idToInfo.end();}
 
-   void clear( void ) { m_idToInfo.clear(); m_idToMatrix.clear(); }
+   void clear( void ) { m_idToInfo.clear(); m_idToMatrix.clear(); clearShapes(); }
    IdToInfoItr find( unsigned int ) const;
    void localToGlobal( const GeomDetInfo& info, const float* local, float* global, bool translatep=true ) const;
 
@@ -123,8 +128,21 @@ public:
 
 
 private:
+   typedef std::array<float, 5> ShapeKey;
+   typedef std::list<std::pair<ShapeKey, TGeoShape*> > ShapeList;
+
+   // most of the detectors share a few dimensions: the shapes built are kept,
+   // the most recently used first, up to kMaxShapes of them
+   static const unsigned int kMaxShapes = 4096;
+
+   void releaseShape( TGeoShape* ) const;
+   void clearShapes( void );
+
    mutable std::map<unsigned int, TGeoMatrix*> m_idToMatrix;
 
+   mutable ShapeList m_shapes;
+   mutable std::map<ShapeKey, ShapeList::iterator> m_shapeIndex;
+
    IdToInfo m_idToInfo;
 
    std::string m_prodTag;
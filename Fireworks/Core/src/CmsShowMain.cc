@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include "TSystem.h"
+#include "TEnv.h"
 #include "TGLWidget.h"
 #include "TTimer.h"
 #include "TROOT.h"
@@ -112,6 +113,7 @@ static const char* const kSyncAllViews     = "sync-all-views";
 static const char* const kEnableFPE        = "enable-fpe";
 static const char* const kZeroWinOffsets   = "zero-window-offsets";
 static const char* const kNoVersionCheck   = "no-version-check";
+static const char* const kAsyncPrefetch    = "async-prefetch";
 
 
 //
@@ -161,6 +163,7 @@ CmsShowMain::CmsShowMain(int argc, char *argv[])
       (kConfigFileCommandOpt, po::value<std::string>(),   "Include configuration file")
       (kNoConfigFileCommandOpt,                           "Empty configuration")
       (kNoVersionCheck,                                   "No file version check")
+      (kAsyncPrefetch,                                    "Read the data of the next events in a background thread while the current one is shown. Useful with remote files")
       (kGeomFileCommandOpt,   po::value<std::string>(),   "Reco geometry file. Default is cmsGeom10.root")
       (kSimGeomFileCommandOpt,po::value<std::string>(),   "Geometry file for browsing in table view. Default is CmsSimGeom-14.root. Can be simulation or reco geometry in TGeo format")
      (kFieldCommandOpt, po::value<double>(),             "Set magnetic field value explicitly. Default is auto-field estimation")
@@ -314,6 +317,13 @@ CmsShowMain::CmsShowMain(int argc, char *argv[])
       m_context->setHidePFBuilders(true);
    }
 
+   if (vm.count(kAsyncPrefetch))
+   {
+      // the TTreeCache set up by fwlite then fills its next blocks in a thread of TFilePrefetch
+      gEnv->SetValue("TFile.AsyncPrefetching", 1);
+      fwLog(fwlog::kInfo) << "Asynchronous prefetching of the events enabled.\n";
+   }
+
    setup(m_navigator.get(), m_context.get(), m_metadataManager.get());
 
    if (vm.count(kZeroWinOffsets))
@@ -20,7 +20,9 @@ FWGeometry::FWGeometry( void )
 {}
 
 FWGeometry::~FWGeometry( void )
-{}
+{
+   clearShapes();
+}
 
 TFile*
 FWGeometry::findFile( const char* fileName )
@@ -226,6 +228,14 @@ FWGeometry::getShape( unsigned int id ) const
 TGeoShape*
 FWGeometry::getShape( const GeomDetInfo& info ) const 
 {
+   ShapeKey key = {{ info.shape[0], info.shape[1], info.shape[2], info.shape[3], info.shape[4] }};
+   std::map<ShapeKey, ShapeList::iterator>::iterator cached = m_shapeIndex.find( key );
+   if( cached != m_shapeIndex.end())
+   {
+      m_shapes.splice( m_shapes.begin(), m_shapes, cached->second );
+      return cached->second->second;
+   }
+
    TEveGeoManagerHolder gmgr( TEveGeoShape::GetGeoMangeur());
    TGeoShape* geoShape = 0;
    if( info.shape[0] == 1 ) 
@@ -245,10 +255,40 @@ FWGeometry::getShape( const GeomDetInfo& info ) const
    }
    else
       geoShape = new TGeoBBox( info.shape[1], info.shape[2], info.shape[3] );
+
+   // the reference of the cache
+   geoShape->SetUniqueID( geoShape->GetUniqueID() + 1 );
+   m_shapes.push_front( std::make_pair( key, geoShape ));
+   m_shapeIndex[key] = m_shapes.begin();
+   if( m_shapes.size() > kMaxShapes )
+   {
+      m_shapeIndex.erase( m_shapes.back().first );
+      releaseShape( m_shapes.back().second );
+      m_shapes.pop_back();
+   }
       
    return geoShape;
 }
 
+void
+FWGeometry::releaseShape( TGeoShape* shape ) const
+{
+   // the shapes still shown by a TEveGeoShape are deleted by the last of them
+   TEveGeoManagerHolder gmgr( TEveGeoShape::GetGeoMangeur());
+   shape->SetUniqueID( shape->GetUniqueID() - 1 );
+   if( shape->GetUniqueID() == 0 )
+      delete shape;
+}
+
+void
+FWGeometry::clearShapes( void )
+{
+   for( ShapeList::iterator it = m_shapes.begin(), itEnd = m_shapes.end(); it != itEnd; ++it )
+      releaseShape( it->second );
+   m_shapes.clear();
+   m_shapeIndex.clear();
+}
+
 TEveGeoShape*
 FWGeometry::getEveShape( unsigned int id  ) const
 {
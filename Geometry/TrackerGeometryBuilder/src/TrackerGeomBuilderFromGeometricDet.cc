@@ -19,6 +19,7 @@
 
 #include <cfloat>
 #include <cassert>
+#include <unordered_map>
 using std::vector;
 using std::string;
 
@@ -229,24 +230,28 @@ void TrackerGeomBuilderFromGeometricDet::buildGeomDet(TrackerGeometry* tracker){
   auto const & gdu = tracker->detUnits();
   auto const & gduId = tracker->detUnitIds();
 
+  //position of each det unit, to find the partners without looping over all of them
+  std::unordered_map<unsigned int, u_int32_t> gduPosition;
+  gduPosition.reserve(gduId.size());
+  for(u_int32_t jj=0;jj<gduId.size();jj++){
+    gduPosition.emplace(gduId[jj].rawId(),jj);
+  }
+
   for(u_int32_t i=0;i<gdu.size();i++){
 
     tracker->addDet(gdu[i]);
     tracker->addDetId(gduId[i]);
     string gduTypeName = gdu[i]->type().name();
 
-    //this step is time consuming >> TO FIX with a MAP?
     if( (gduTypeName.find("Ster")!=std::string::npos || 
          gduTypeName.find("Lower")!=std::string::npos) && 
         (theTopo->glued(gduId[i])!=0 || theTopo->stack(gduId[i])!=0 )) {
     
 
       int partner_pos=-1;
-      for(u_int32_t jj=0;jj<gduId.size();jj++){
-  	  if(theTopo->partnerDetId(gduId[i]) == gduId[jj]) {
-  	    partner_pos=jj;
-  	    break;
-  	  }
+      auto partner = gduPosition.find(theTopo->partnerDetId(gduId[i]).rawId());
+      if(partner != gduPosition.end()) {
+        partner_pos=partner->second;
       }
       if(partner_pos==-1){
 	  throw cms::Exception("Configuration") <<"Module Type is Stereo or Lower but no partner detector found \n"
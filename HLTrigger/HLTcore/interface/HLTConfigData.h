@@ -16,6 +16,7 @@
 
 #include<map>
 #include<string>
+#include<unordered_map>
 #include<vector>
 
 //
@@ -162,8 +163,8 @@ class HLTConfigData {
   std::vector<std::vector<std::string> > moduleLabels_;
   std::vector<std::vector<std::string> > saveTagsModules_;
 
-  std::map<std::string,unsigned int> triggerIndex_;
-  std::vector<std::map<std::string,unsigned int> > moduleIndex_;
+  std::unordered_map<std::string,unsigned int> triggerIndex_;
+  std::vector<std::unordered_map<std::string,unsigned int> > moduleIndex_;
 
   unsigned int l1tType_;
   std::vector<std::vector<std::pair<bool,std::string> > > hltL1GTSeeds_;
@@ -119,11 +119,13 @@ void HLTConfigData::extract()
    }
 
    // Fill index maps for fast lookup
+   triggerIndex_.reserve(n);
    moduleIndex_.resize(n);
    for (unsigned int i=0; i!=n; ++i) {
      triggerIndex_[triggerNames_[i]]=i;
      moduleIndex_[i].clear();
      const unsigned int m(size(i));
+     moduleIndex_[i].reserve(m);
      for (unsigned int j=0; j!=m; ++j) {
        moduleIndex_[i][moduleLabels_[i][j]]=j;
      }
@@ -435,7 +437,7 @@ const std::string& HLTConfigData::triggerName(unsigned int trigger) const {
   return triggerNames_.at(trigger);
 }
 unsigned int HLTConfigData::triggerIndex(const std::string& trigger) const {
-  const std::map<std::string,unsigned int>::const_iterator index(triggerIndex_.find(trigger));
+  const auto index(triggerIndex_.find(trigger));
   if (index==triggerIndex_.end()) {
     return size();
   } else {
@@ -465,7 +467,7 @@ const std::string& HLTConfigData::moduleLabel(const std::string& trigger, unsign
 }
 
 unsigned int HLTConfigData::moduleIndex(unsigned int trigger, const std::string& module) const {
-  const std::map<std::string,unsigned int>::const_iterator index(moduleIndex_.at(trigger).find(module));
+  const auto index(moduleIndex_.at(trigger).find(module));
   if (index==moduleIndex_.at(trigger).end()) {
     return size(trigger);
   } else {
@@ -24,6 +24,7 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/Common/interface/HLTPathStatus.h"
 #include "DataFormats/Provenance/interface/EventID.h"
+#include "DataFormats/Provenance/interface/LuminosityBlockID.h"
 #include "DataFormats/Provenance/interface/Timestamp.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "DQMServices/Core/interface/DQMStore.h"
@@ -146,6 +147,8 @@ private:
   void postEvent(edm::StreamContext const &);
   void prePathEvent(edm::StreamContext const &, edm::PathContext const &);
   void postPathEvent(edm::StreamContext const &, edm::PathContext const &,edm:: HLTPathStatus const &);
+  void postModuleEventPrefetching(edm::StreamContext const &, edm::ModuleCallingContext const &);
+  void preModuleEventAcquire(edm::StreamContext const &, edm::ModuleCallingContext const &);
   void preModuleEvent(edm::StreamContext const &, edm::ModuleCallingContext const &);
   void postModuleEvent(edm::StreamContext const &, edm::ModuleCallingContext const &);
   void preModuleEventDelayedGet(edm::StreamContext const &, edm::ModuleCallingContext const &);
@@ -183,20 +186,65 @@ private:
 
   struct PathInfo;
 
+  // real, cpu and waiting time accumulated by a module over several events
+  struct ModuleSummary {
+    uint64_t                    events;             // number of events in which the module has run
+    double                      time_active;        // real time spent in the module
+    double                      time_cpu;           // cpu time spent in the module by the thread running it
+    double                      time_wait;          // time spent waiting for the module's locks and shared resources
+
+  public:
+    ModuleSummary() :
+      events(0),
+      time_active(0.),
+      time_cpu(0.),
+      time_wait(0.)
+    { }
+
+    void reset() {
+      events      = 0;
+      time_active = 0.;
+      time_cpu    = 0.;
+      time_wait   = 0.;
+    }
+
+    ModuleSummary & operator+=(ModuleSummary const & other) {
+      events      += other.events;
+      time_active += other.time_active;
+      time_cpu    += other.time_cpu;
+      time_wait   += other.time_wait;
+      return *this;
+    }
+  };
+
   struct ModuleInfo {
     FastTimer                   timer;              // per-event timer
+    FastTimer::Clock::time_point time_ready;        // when the module finished prefetching, and started waiting for its locks
+    double                      cpu_start;          // thread cpu time when the module started (or resumed) running
     double                      time_active;        // time actually spent in this module
+    double                      time_cpu;           // cpu time spent in this module
+    double                      time_wait;          // time spent waiting to acquire the module's locks and shared resources
     double                      summary_active;
+    ModuleSummary               summary_lumi;       // accounting for the current luminosity section, merged at postStreamEndLumi
     TH1F *                      dqm_active;
+    TH1F *                      dqm_cpu;
+    TH1F *                      dqm_wait;
     PathInfo *                  run_in_path;        // the path inside which the module was atually active
     uint32_t                    counter;            // count how many times the module was scheduled to run
 
   public:
     ModuleInfo() :
       timer(),
+      time_ready(),
+      cpu_start(0.),
       time_active(0.),
+      time_cpu(0.),
+      time_wait(0.),
       summary_active(0.),
+      summary_lumi(),
       dqm_active(nullptr),
+      dqm_cpu(nullptr),
+      dqm_wait(nullptr),
       run_in_path(nullptr),
       counter(0)
     { }
@@ -208,10 +256,17 @@ private:
     // reset the timers and DQM plots
     void reset() {
       timer.reset();
+      time_ready = FastTimer::Clock::time_point();
+      cpu_start = 0.;
       time_active = 0.;
+      time_cpu = 0.;
+      time_wait = 0.;
       summary_active = 0.;
+      summary_lumi.reset();
       // the DQM plots are owned by the DQMStore
       dqm_active = nullptr;
+      dqm_cpu = nullptr;
+      dqm_wait = nullptr;
       run_in_path = nullptr;
       counter = 0;
     }
@@ -362,6 +417,9 @@ private:
   const double                                  m_dqm_moduletime_resolution;
   std::string                                   m_dqm_path;
 
+  // json configuration
+  const std::string                             m_json_filename;                // if not empty, write the per-module and per-lumisection summaries to this file
+
   struct ProcessDescription {
     std::string         name;
     std::string         first_path;             // the framework does not provide a pre/postPaths or pre/postEndPaths signal,
@@ -659,6 +717,7 @@ private:
     std::unordered_map<std::string, ModuleInfo>     moduletypes;
     ModuleMap<ModuleInfo *>                         fast_modules;               // these assume that module ids are constant throughout the whole job,
     ModuleMap<ModuleInfo *>                         fast_moduletypes;
+    uint64_t                                        lumi_events;                // events processed in the current lumisection, merged at postStreamEndLumi
 
     StreamData() :
       // timers
@@ -688,7 +747,8 @@ private:
       modules(),
       moduletypes(),
       fast_modules(),
-      fast_moduletypes()
+      fast_moduletypes(),
+      lumi_events(0)
     { }
 
     // called in FastTimerService::postStreamEndRun()
@@ -730,6 +790,7 @@ private:
         keyval.second.reset();
       for (auto & keyval: moduletypes)
         keyval.second.reset();
+      lumi_events = 0;
     }
 
   };
@@ -750,12 +811,24 @@ private:
   std::vector<TimingPerProcess>                 m_job_summary_perprocess;       // per-process time accounting per-job
   std::mutex                                    m_summary_mutex;                // synchronise access to the summary objects across different threads
 
+  // per-module real, cpu and waiting time summaries
+  std::unordered_map<std::string, ModuleSummary>  m_job_summary_modules;                    // per-module accounting for the whole job
+  std::map<edm::LuminosityBlockID, std::unordered_map<std::string, ModuleSummary>> m_lumi_summary_modules;  // per-module accounting for each lumisection, only kept if a JSON report is requested
+  std::map<edm::LuminosityBlockID, uint64_t>      m_lumi_summary_events;                    // number of events processed in each lumisection
+
   static
   double delta(FastTimer::Clock::time_point const & first, FastTimer::Clock::time_point const & second)
   {
     return std::chrono::duration_cast<std::chrono::duration<double>>(second - first).count();
   }
 
+  // cpu time used so far by the calling thread, in seconds
+  static
+  double threadCpuTime();
+
+  // merge the per-lumisection module accounting of a stream into the job (and per-lumisection) summaries
+  void mergeModuleSummaries(StreamData & stream, edm::LuminosityBlockID const & lumi);
+
   // associate to a path all the modules it contains
   void fillPathMap(unsigned int pid, std::string const & name, std::vector<std::string> const & modules);
 
@@ -765,6 +838,10 @@ private:
   // print a timing summary for the run or job
   void printSummary(Timing const & summary, std::string const & label) const;
   void printProcessSummary(Timing const & total, TimingPerProcess const & summary, std::string const & label, std::string const & process) const;
+  void printModuleSummary(std::string const & label) const;
+
+  // write the per-module and per-lumisection timing summaries as JSON
+  void writeJSONSummary(std::string const & filename) const;
 
   // assign a "process id" to a process, given its ProcessContext
   static
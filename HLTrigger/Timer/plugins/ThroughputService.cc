@@ -1,6 +1,8 @@
 // C++ headers
 #include <algorithm>
 #include <chrono>
+#include <fstream>
+#include <iomanip>
 
 // boost headers
 #include <boost/format.hpp>
@@ -10,12 +12,48 @@
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "ThroughputService.h"
 
+namespace {
+  // the kinds of timeline entries, also the categories of the trace events
+  enum timeline_kind {
+    kModuleEvent,
+    kModuleStreamBeginRun,
+    kModuleStreamEndRun,
+    kModuleStreamBeginLumi,
+    kModuleStreamEndLumi,
+    kModuleGlobalBeginRun,
+    kModuleGlobalEndRun,
+    kModuleGlobalBeginLumi,
+    kModuleGlobalEndLumi,
+    kSourceEvent,
+    kSourceLumi,
+    kSourceRun
+  };
+
+  char const * const timeline_kind_names[] = {
+    "event",
+    "stream begin run",
+    "stream end run",
+    "stream begin lumi",
+    "stream end lumi",
+    "global begin run",
+    "global end run",
+    "global begin lumi",
+    "global end lumi",
+    "source event",
+    "source lumi",
+    "source run"
+  };
+}
+
+constexpr unsigned int ThroughputService::thread_timeline::invalid_thread;
+
 // describe the module's configuration
 void ThroughputService::fillDescriptions(edm::ConfigurationDescriptions & descriptions) {
   edm::ParameterSetDescription desc;
   desc.addUntracked<double>(        "timeRange",       60000.0 );
   desc.addUntracked<double>(        "timeResolution",     10.0 );
   desc.addUntracked<std::string>(   "dqmPath",           "HLT/Throughput" );
+  desc.addUntracked<std::string>(   "timelineFile",      "" )->setComment("if not empty, write the timeline of the modules and of the source, per stream and per thread, to this file in the Chrome trace event format");
   descriptions.add("ThroughputService", desc);
 }
 
@@ -24,14 +62,65 @@ ThroughputService::ThroughputService(const edm::ParameterSet & config, edm::Acti
   // configuration
   m_time_range(      config.getUntrackedParameter<double>("timeRange") ),
   m_time_resolution( config.getUntrackedParameter<double>("timeResolution") ),
+  m_timeline_file(   config.getUntrackedParameter<std::string>("timelineFile") ),
   m_dqm_path(        config.getUntrackedParameter<std::string>("dqmPath" ) )
 {
+  m_timeline_threads = 0;
+  m_source_id = 0;
+
   registry.watchPreallocate(        this, & ThroughputService::preallocate );
   registry.watchPreStreamBeginRun(  this, & ThroughputService::preStreamBeginRun );
   registry.watchPostStreamEndLumi(  this, & ThroughputService::postStreamEndLumi );
   registry.watchPostStreamEndRun(   this, & ThroughputService::postStreamEndRun );
   registry.watchPreSourceEvent(     this, & ThroughputService::preSourceEvent );
   registry.watchPostEvent(          this, & ThroughputService::postEvent );
+
+  if (m_timeline_file.empty())
+    return;
+
+  // the pre and post signals of a module, or of the source, come on the same thread
+  auto preStream  = [this](edm::StreamContext const &, edm::ModuleCallingContext const &) { timelineBegin(); };
+  auto preGlobal  = [this](edm::GlobalContext const &, edm::ModuleCallingContext const &) { timelineBegin(); };
+  auto postStream = [this](unsigned int kind) {
+    return [this, kind](edm::StreamContext const & sc, edm::ModuleCallingContext const & mcc) {
+      timelineEnd(kind, mcc.moduleDescription()->id(), sc.streamID().value());
+    };
+  };
+  auto postGlobal = [this](unsigned int kind) {
+    return [this, kind](edm::GlobalContext const &, edm::ModuleCallingContext const & mcc) {
+      timelineEnd(kind, mcc.moduleDescription()->id(), -1);
+    };
+  };
+
+  registry.watchPreModuleConstruction(      this, & ThroughputService::preModuleConstruction );
+  registry.watchPreSourceConstruction(      this, & ThroughputService::preModuleConstruction );
+  registry.watchPostEndJob(                 this, & ThroughputService::postEndJob );
+
+  registry.watchPreModuleEvent(             preStream );
+  registry.watchPostModuleEvent(            postStream(kModuleEvent) );
+  registry.watchPreModuleStreamBeginRun(    preStream );
+  registry.watchPostModuleStreamBeginRun(   postStream(kModuleStreamBeginRun) );
+  registry.watchPreModuleStreamEndRun(      preStream );
+  registry.watchPostModuleStreamEndRun(     postStream(kModuleStreamEndRun) );
+  registry.watchPreModuleStreamBeginLumi(   preStream );
+  registry.watchPostModuleStreamBeginLumi(  postStream(kModuleStreamBeginLumi) );
+  registry.watchPreModuleStreamEndLumi(     preStream );
+  registry.watchPostModuleStreamEndLumi(    postStream(kModuleStreamEndLumi) );
+  registry.watchPreModuleGlobalBeginRun(    preGlobal );
+  registry.watchPostModuleGlobalBeginRun(   postGlobal(kModuleGlobalBeginRun) );
+  registry.watchPreModuleGlobalEndRun(      preGlobal );
+  registry.watchPostModuleGlobalEndRun(     postGlobal(kModuleGlobalEndRun) );
+  registry.watchPreModuleGlobalBeginLumi(   preGlobal );
+  registry.watchPostModuleGlobalBeginLumi(  postGlobal(kModuleGlobalBeginLumi) );
+  registry.watchPreModuleGlobalEndLumi(     preGlobal );
+  registry.watchPostModuleGlobalEndLumi(    postGlobal(kModuleGlobalEndLumi) );
+
+  registry.watchPreSourceEvent(  [this](edm::StreamID) { timelineBegin(); } );
+  registry.watchPostSourceEvent( [this](edm::StreamID sid) { timelineEnd(kSourceEvent, m_source_id, sid.value()); } );
+  registry.watchPreSourceLumi(   [this]() { timelineBegin(); } );
+  registry.watchPostSourceLumi(  [this]() { timelineEnd(kSourceLumi, m_source_id, -1); } );
+  registry.watchPreSourceRun(    [this]() { timelineBegin(); } );
+  registry.watchPostSourceRun(   [this]() { timelineEnd(kSourceRun, m_source_id, -1); } );
 }
 
 ThroughputService::~ThroughputService()
@@ -106,6 +195,86 @@ ThroughputService::postEvent(edm::StreamContext const & sc)
   m_stream_histograms[sid].retired_events->Fill( std::chrono::duration_cast<std::chrono::duration<double>>(timestamp - m_startup).count() );
 }
 
+void
+ThroughputService::preModuleConstruction(edm::ModuleDescription const & md)
+{
+  // the source is constructed first, its id is the lowest one
+  if (m_module_labels.empty())
+    m_source_id = md.id();
+  if (md.id() >= m_module_labels.size())
+    m_module_labels.resize(md.id() + 1);
+  m_module_labels[md.id()] = md.moduleLabel();
+}
+
+void
+ThroughputService::postEndJob()
+{
+  writeTimeline();
+}
+
+void
+ThroughputService::timelineBegin()
+{
+  m_timelines.local().started.push_back(std::chrono::steady_clock::now());
+}
+
+void
+ThroughputService::timelineEnd(unsigned int kind, unsigned int module, int stream)
+{
+  auto timestamp = std::chrono::steady_clock::now();
+  auto & timeline = m_timelines.local();
+  if (timeline.started.empty())
+    return;
+  if (timeline.thread == thread_timeline::invalid_thread)
+    timeline.thread = m_timeline_threads++;
+  timeline.entries.push_back(timeline_entry{ kind, module, stream, timeline.started.back(), timestamp });
+  timeline.started.pop_back();
+}
+
+void
+ThroughputService::writeTimeline() const
+{
+  std::ofstream out(m_timeline_file);
+  if (not out) {
+    edm::LogError("ThroughputService") << "ThroughputService::writeTimeline: cannot open file " << m_timeline_file;
+    return;
+  }
+
+  // every entry is shown twice, in the "threads" process on the thread that
+  // ran it, and in the "streams" process on its stream
+  int const streams = m_stream_histograms.size();
+  auto microseconds = [this](std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(t - m_startup).count();
+  };
+
+  out << std::fixed << std::setprecision(3);
+  out << "{ \"traceEvents\": [\n";
+  out << "  { \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, \"args\": { \"name\": \"threads\" } },\n";
+  out << "  { \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": { \"name\": \"streams\" } },\n";
+  for (int sid = 0; sid < streams; ++sid)
+    out << "  { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << sid << ", \"args\": { \"name\": \"stream " << sid << "\" } },\n";
+  out << "  { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << streams << ", \"args\": { \"name\": \"global\" } }";
+  for (auto const & timeline: m_timelines) {
+    for (auto const & entry: timeline.entries) {
+      char const * label = entry.module < m_module_labels.size() ? m_module_labels[entry.module].c_str() : "";
+      double begin = microseconds(entry.begin);
+      double duration = microseconds(entry.end) - begin;
+      int stream = entry.stream < 0 ? streams : entry.stream;
+      for (int pid = 0; pid < 2; ++pid)
+        out << ",\n  { \"name\": \"" << label << "\""
+            << ", \"cat\": \"" << timeline_kind_names[entry.kind] << "\""
+            << ", \"ph\": \"X\""
+            << ", \"ts\": " << begin
+            << ", \"dur\": " << duration
+            << ", \"pid\": " << pid
+            << ", \"tid\": " << (pid == 0 ? (int) timeline.thread : stream)
+            << ", \"args\": { \"stream\": " << entry.stream << ", \"thread\": " << timeline.thread << " } }";
+    }
+  }
+  out << " ]\n";
+  out << "}\n";
+}
+
 
 // declare ThroughputService as a framework Service
 #include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
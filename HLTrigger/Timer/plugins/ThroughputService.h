@@ -5,10 +5,13 @@
 #include <string>
 #include <chrono>
 #include <functional>
+#include <atomic>
+#include <vector>
 
 // TBB headers
 #include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_unordered_set.h>
+#include <tbb/enumerable_thread_specific.h>
 
 // ROOT headers
 #include <TH1F.h>
@@ -18,6 +21,8 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/ServiceRegistry/interface/SystemBounds.h"
 #include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/ServiceRegistry/interface/GlobalContext.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
@@ -39,6 +44,13 @@ private:
   void preSourceEvent(edm::StreamID sid);
   void postEvent(edm::StreamContext const & sc);
 
+  // timeline of the modules and of the source, per stream and per thread
+  void preModuleConstruction(edm::ModuleDescription const & md);
+  void postEndJob();
+  void timelineBegin();
+  void timelineEnd(unsigned int kind, unsigned int module, int stream);
+  void writeTimeline() const;
+
 public:
   static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
 
@@ -56,6 +68,34 @@ private:
   };
 
   std::vector<stream_histograms>        m_stream_histograms;
+
+  // what a thread has done, in the Chrome trace event format once written out
+  struct timeline_entry
+  {
+    unsigned int kind;
+    unsigned int module;
+    int          stream;                                            // -1 for the global transitions
+    std::chrono::steady_clock::time_point begin;
+    std::chrono::steady_clock::time_point end;
+  };
+
+  struct thread_timeline
+  {
+    thread_timeline() :
+      thread(invalid_thread)
+    { }
+
+    static constexpr unsigned int invalid_thread = ~0u;
+
+    unsigned int                                       thread;      // assigned the first time the thread records an entry
+    std::vector<std::chrono::steady_clock::time_point> started;     // the nested transitions running on the thread
+    std::vector<timeline_entry>                        entries;
+  };
+
+  tbb::enumerable_thread_specific<thread_timeline> m_timelines;
+  std::atomic<unsigned int>             m_timeline_threads;
+  std::vector<std::string>              m_module_labels;            // indexed by the module id
+  unsigned int                          m_source_id;
   
   std::chrono::steady_clock::time_point m_startup;
 
@@ -63,6 +103,9 @@ private:
   double                                m_time_range;
   double                                m_time_resolution;
 
+  // timeline-related data members
+  std::string                           m_timeline_file;            // no timeline is recorded if empty
+
   // DQM service-related data members
   unsigned int                          m_module_id;                // pseudo module id for the FastTimerService, needed by the thread-safe DQMStore 
   std::string                           m_dqm_path;
@@ -3,15 +3,18 @@
 
 
 // C++ headers
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <mutex>
 #include <string>
 #include <sstream>
 #include <unordered_set>
 #include <unordered_map>
+#include <time.h>
 
 // boost headers
 #include <boost/format.hpp>
@@ -72,6 +75,8 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   m_dqm_moduletime_range(        config.getUntrackedParameter<double>(   "dqmModuleTimeRange"       ) ),            // ms
   m_dqm_moduletime_resolution(   config.getUntrackedParameter<double>(   "dqmModuleTimeResolution"  ) ),            // ms
   m_dqm_path(                    config.getUntrackedParameter<std::string>("dqmPath" ) ),
+  // json configuration
+  m_json_filename(               config.getUntrackedParameter<std::string>("jsonFileName" ) ),
   // description of the process(es)
   m_process(),
   // description of the luminosity axes
@@ -82,7 +87,10 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   m_run_summary(),
   m_job_summary(),
   m_run_summary_perprocess(),
-  m_job_summary_perprocess()
+  m_job_summary_perprocess(),
+  m_job_summary_modules(),
+  m_lumi_summary_modules(),
+  m_lumi_summary_events()
 {
   // enable timers if required by DQM plots
   m_enable_timing_paths     = m_enable_timing_paths         or
@@ -94,6 +102,7 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
                               m_enable_dqm_bypath_exclusive;
 
   m_enable_timing_modules   = m_enable_timing_modules       or
+                              not m_json_filename.empty()   or
                               m_enable_dqm_bymodule         or
                               m_enable_dqm_bymoduletype     or
                               m_enable_dqm_bypath_total     or
@@ -125,6 +134,8 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   registry.watchPostPathEvent(      this, & FastTimerService::postPathEvent );
   // watch per-module events if enabled
   if (m_enable_timing_modules) {
+    registry.watchPostModuleEventPrefetching(this, & FastTimerService::postModuleEventPrefetching );
+    registry.watchPreModuleEventAcquire(     this, & FastTimerService::preModuleEventAcquire );
     registry.watchPreModuleEvent(            this, & FastTimerService::preModuleEvent );
     registry.watchPostModuleEvent(           this, & FastTimerService::postModuleEvent );
     registry.watchPreModuleEventDelayedGet(  this, & FastTimerService::preModuleEventDelayedGet );
@@ -513,6 +524,12 @@ void FastTimerService::preStreamBeginRun(edm::StreamContext const & sc)
         module.dqm_active = booker.book1D(label, label, modulebins, 0., m_dqm_moduletime_range)->getTH1F();
         module.dqm_active->StatOverflows(true);
         module.dqm_active->SetXTitle("processing time [ms]");
+        module.dqm_cpu    = booker.book1D(label + "_cpu",  label + " cpu time",     modulebins, 0., m_dqm_moduletime_range)->getTH1F();
+        module.dqm_cpu   ->StatOverflows(true);
+        module.dqm_cpu   ->SetXTitle("cpu time [ms]");
+        module.dqm_wait   = booker.book1D(label + "_wait", label + " waiting time", modulebins, 0., m_dqm_moduletime_range)->getTH1F();
+        module.dqm_wait  ->StatOverflows(true);
+        module.dqm_wait  ->SetXTitle("waiting time [ms]");
       }
     }
 
@@ -596,6 +613,10 @@ FastTimerService::postStreamEndLumi(edm::StreamContext const & sc) {
   unsigned int sid = sc.streamID().value();
   auto & stream = m_stream[sid];
 
+  // merge the per-module accounting for this lumisection into the job summary
+  if (m_enable_timing_modules)
+    mergeModuleSummaries(stream, sc.eventID().luminosityBlockID());
+
   if (m_enable_dqm) {
     DQMStore * store = edm::Service<DQMStore>().operator->();
     assert(store);
@@ -630,7 +651,117 @@ FastTimerService::postEndJob()
       printProcessSummary(m_job_summary, m_job_summary_perprocess[pid], label, m_process[pid].name);
 
     printSummary(m_job_summary, label);
+
+    if (m_enable_timing_modules)
+      printModuleSummary(label);
+  }
+
+  if (not m_json_filename.empty())
+    writeJSONSummary(m_json_filename);
+}
+
+void
+FastTimerService::mergeModuleSummaries(StreamData & stream, edm::LuminosityBlockID const & lumi)
+{
+  // the per-lumisection accounting is kept only if it is going to be written out
+  bool keep_lumi = not m_json_filename.empty();
+
+  // prevent different threads from updating the summary information at the same time
+  std::lock_guard<std::mutex> lock_summary(m_summary_mutex);
+
+  if (keep_lumi)
+    m_lumi_summary_events[lumi] += stream.lumi_events;
+  stream.lumi_events = 0;
+
+  for (auto & keyval: stream.modules) {
+    ModuleSummary & summary = keyval.second.summary_lumi;
+    if (summary.events == 0)
+      continue;
+    m_job_summary_modules[keyval.first] += summary;
+    if (keep_lumi)
+      m_lumi_summary_modules[lumi][keyval.first] += summary;
+    summary.reset();
+  }
+}
+
+void
+FastTimerService::printModuleSummary(std::string const & label) const
+{
+  // print the per-module real, cpu and waiting time, averaged over the events in which each module has run
+  std::vector<std::string> labels;
+  labels.reserve(m_job_summary_modules.size());
+  for (auto const & keyval: m_job_summary_modules)
+    labels.push_back(keyval.first);
+  std::sort(labels.begin(), labels.end());
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(6);
+  out << "FastReport for " << label << ", per module" << '\n';
+  out << "FastReport      Events   Real time    CPU time   Wait time  Module" << '\n';
+  for (auto const & name: labels) {
+    ModuleSummary const & summary = m_job_summary_modules.at(name);
+    out << "FastReport  "
+        << std::right << std::setw(10) << summary.events << "  "
+        << std::right << std::setw(10) << summary.time_active / (double) summary.events << "  "
+        << std::right << std::setw(10) << summary.time_cpu    / (double) summary.events << "  "
+        << std::right << std::setw(10) << summary.time_wait   / (double) summary.events << "  "
+        << name << '\n';
   }
+  edm::LogVerbatim("FastReport") << out.str();
+}
+
+void
+FastTimerService::writeJSONSummary(std::string const & filename) const
+{
+  // all times are reported in milliseconds, summed over the events in which each module has run
+  auto writeModules = [](std::ostream & out, std::unordered_map<std::string, ModuleSummary> const & modules, const char * indent) {
+    std::vector<std::string> labels;
+    labels.reserve(modules.size());
+    for (auto const & keyval: modules)
+      labels.push_back(keyval.first);
+    std::sort(labels.begin(), labels.end());
+
+    out << "[";
+    bool first = true;
+    for (auto const & name: labels) {
+      ModuleSummary const & summary = modules.at(name);
+      out << (first ? "\n" : ",\n") << indent
+          << "{ \"label\": \"" << name << "\""
+          << ", \"events\": "    << summary.events
+          << ", \"time_real\": " << summary.time_active * 1000.
+          << ", \"time_cpu\": "  << summary.time_cpu    * 1000.
+          << ", \"time_wait\": " << summary.time_wait   * 1000.
+          << " }";
+      first = false;
+    }
+    out << " ]";
+  };
+
+  std::ofstream out(filename);
+  if (not out) {
+    edm::LogError("FastTimerService") << "FastTimerService::writeJSONSummary: cannot open file " << filename;
+    return;
+  }
+  out << std::fixed << std::setprecision(3);
+  out << "{\n";
+  out << "  \"modules\": ";
+  writeModules(out, m_job_summary_modules, "    ");
+  out << ",\n";
+  out << "  \"lumisections\": [";
+  bool first = true;
+  for (auto const & keyval: m_lumi_summary_modules) {
+    auto events = m_lumi_summary_events.find(keyval.first);
+    out << (first ? "\n" : ",\n")
+        << "    { \"run\": " << keyval.first.run()
+        << ", \"lumi\": " << keyval.first.luminosityBlock()
+        << ", \"events\": " << (events == m_lumi_summary_events.end() ? 0 : events->second)
+        << ", \"modules\": ";
+    writeModules(out, keyval.second, "      ");
+    out << " }";
+    first = false;
+  }
+  out << " ]\n";
+  out << "}\n";
 }
 
 void
@@ -818,6 +949,10 @@ void FastTimerService::postEvent(edm::StreamContext const & sc) {
     }
   }
 
+  // count the events in this lumisection, for the per-module summaries
+  if (pid+1 == m_process.size())
+    ++stream.lumi_events;
+
   // elaborate "exclusive" modules
   if (m_enable_timing_exclusive) {
     for (auto & keyval: stream.paths[pid]) {
@@ -913,6 +1048,8 @@ void FastTimerService::postEvent(edm::StreamContext const & sc) {
     for (auto & keyval : stream.modules) {
       ModuleInfo & module = keyval.second;
       module.dqm_active->Fill(module.time_active * 1000.);
+      module.dqm_cpu   ->Fill(module.time_cpu    * 1000.);
+      module.dqm_wait  ->Fill(module.time_wait   * 1000.);
     }
   }
 
@@ -958,6 +1095,8 @@ void FastTimerService::preSourceEvent(edm::StreamID sid) {
   for (auto & keyval : stream.modules) {
     keyval.second.timer.reset();
     keyval.second.time_active       = 0.;
+    keyval.second.time_cpu          = 0.;
+    keyval.second.time_wait         = 0.;
     keyval.second.run_in_path       = nullptr;
     keyval.second.counter           = 0;
   }
@@ -1125,6 +1264,57 @@ void FastTimerService::postPathEvent(edm::StreamContext const & sc, edm::PathCon
 
 }
 
+void FastTimerService::postModuleEventPrefetching(edm::StreamContext const & sc, edm::ModuleCallingContext const & mcc) {
+  // this is ever called only if m_enable_timing_modules = true
+  assert(m_enable_timing_modules);
+
+  if (mcc.moduleDescription() == nullptr) {
+    edm::LogError("FastTimerService") << "FastTimerService::postModuleEventPrefetching: invalid module";
+    return;
+  }
+
+  edm::ModuleDescription const & md = * mcc.moduleDescription();
+  unsigned int sid = sc.streamID().value();
+  auto & stream = m_stream[sid];
+
+  // the module has all its inputs; the time until preModuleEvent (or preModuleEventAcquire) is
+  // spent waiting to acquire the module's own lock and its SharedResourcesAcquirer
+  if (md.id() < stream.fast_modules.size()) {
+    ModuleInfo & module = * stream.fast_modules[md.id()];
+    module.time_ready = FastTimer::Clock::now();
+  } else {
+    // should never get here
+    edm::LogError("FastTimerService") << "FastTimerService::postModuleEventPrefetching: unexpected module " << md.moduleLabel();
+  }
+}
+
+void FastTimerService::preModuleEventAcquire(edm::StreamContext const & sc, edm::ModuleCallingContext const & mcc) {
+  // this is ever called only if m_enable_timing_modules = true
+  assert(m_enable_timing_modules);
+
+  if (mcc.moduleDescription() == nullptr) {
+    edm::LogError("FastTimerService") << "FastTimerService::preModuleEventAcquire: invalid module";
+    return;
+  }
+
+  edm::ModuleDescription const & md = * mcc.moduleDescription();
+  unsigned int sid = sc.streamID().value();
+  auto & stream = m_stream[sid];
+
+  // the waiting time ends when acquire() starts: the time spent in acquire() and in the
+  // external work, up to preModuleEvent, is not accounted as waiting time
+  if (md.id() < stream.fast_modules.size()) {
+    ModuleInfo & module = * stream.fast_modules[md.id()];
+    if (module.time_ready != FastTimer::Clock::time_point()) {
+      module.time_wait  = delta(module.time_ready, FastTimer::Clock::now());
+      module.time_ready = FastTimer::Clock::time_point();
+    }
+  } else {
+    // should never get here
+    edm::LogError("FastTimerService") << "FastTimerService::preModuleEventAcquire: unexpected module " << md.moduleLabel();
+  }
+}
+
 void FastTimerService::preModuleEvent(edm::StreamContext const & sc, edm::ModuleCallingContext const & mcc) {
   // this is ever called only if m_enable_timing_modules = true
   assert(m_enable_timing_modules);
@@ -1143,6 +1333,13 @@ void FastTimerService::preModuleEvent(edm::StreamContext const & sc, edm::Module
     ModuleInfo & module = * stream.fast_modules[md.id()];
     module.run_in_path = stream.current_path;
     module.timer.start();
+    // account the time spent waiting for the module's locks since the end of prefetching
+    if (module.time_ready != FastTimer::Clock::time_point()) {
+      module.time_wait  = delta(module.time_ready, module.timer.getStartTime());
+      module.time_ready = FastTimer::Clock::time_point();
+    }
+    module.time_cpu   = 0.;
+    module.cpu_start  = threadCpuTime();
     stream.current_module = & module;
     // used to measure the time spent between the beginning of the path and the execution of the first module
     if (stream.current_path->first_module == nullptr)
@@ -1174,7 +1371,12 @@ void FastTimerService::postModuleEvent(edm::StreamContext const & sc, edm::Modul
     module.timer.stop();
     active = module.timer.seconds();
     module.time_active     = active;
+    module.time_cpu       += threadCpuTime() - module.cpu_start;
     module.summary_active += active;
+    module.summary_lumi.events      += 1;
+    module.summary_lumi.time_active += active;
+    module.summary_lumi.time_cpu    += module.time_cpu;
+    module.summary_lumi.time_wait   += module.time_wait;
     // plots are filled post event processing
   } else {
     // should never get here
@@ -1209,6 +1411,8 @@ void FastTimerService::preModuleEventDelayedGet(edm::StreamContext const & sc, e
     if (md.id() < stream.fast_modules.size()) {
       ModuleInfo & module = * stream.fast_modules[md.id()];
       module.timer.pause();
+      // the delayed get may run other modules on this thread, do not account their cpu time
+      module.time_cpu += threadCpuTime() - module.cpu_start;
     } else {
       // should never get here
       edm::LogError("FastTimerService") << "FastTimerService::preModuleEventDelayedGet: unexpected module " << md.moduleLabel();
@@ -1235,6 +1439,7 @@ void FastTimerService::postModuleEventDelayedGet(edm::StreamContext const & sc,
     if (md.id() < stream.fast_modules.size()) {
       ModuleInfo & module = * stream.fast_modules[md.id()];
       module.timer.resume();
+      module.cpu_start = threadCpuTime();
     } else {
       // should never get here
       edm::LogError("FastTimerService") << "FastTimerService::postModuleEventDelayedGet: unexpected module " << md.moduleLabel();
@@ -1443,9 +1648,19 @@ void FastTimerService::fillDescriptions(edm::ConfigurationDescriptions & descrip
   desc.addUntracked<double>( "dqmModuleTimeResolution",     0.2);   // ms
   desc.addUntracked<uint32_t>( "dqmLumiSectionsRange",   2500  );   // ~ 16 hours
   desc.addUntracked<std::string>(   "dqmPath",           "HLT/TimerService");
+  desc.addUntracked<std::string>(   "jsonFileName",      "");      // if not empty, write the per-module and per-lumisection summaries in JSON format
   descriptions.add("FastTimerService", desc);
 }
 
+// cpu time used so far by the calling thread
+double FastTimerService::threadCpuTime()
+{
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, & ts) != 0)
+    return 0.;
+  return (double) ts.tv_sec + (double) ts.tv_nsec * 1.e-9;
+}
+
 // assign a "process id" to a process, given its ProcessContext
 unsigned int FastTimerService::processID(edm::ProcessContext const * context)
 {
@@ -0,0 +1,232 @@
+#include "IOMC/RandomEngine/src/PhiloxEngine.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include "CLHEP/Random/engineIDulong.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace {
+  const std::uint32_t kMultiplier0 = 0xD2511F53U;
+  const std::uint32_t kMultiplier1 = 0xCD9E8D57U;
+  const std::uint32_t kWeyl0 = 0x9E3779B9U;
+  const std::uint32_t kWeyl1 = 0xBB67AE85U;
+
+  inline void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo) {
+    std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(product >> 32);
+    lo = static_cast<std::uint32_t>(product);
+  }
+
+  // 52 random bits, shifted by half a step so neither 0 nor 1 can come out
+  inline double toDouble(std::uint32_t high, std::uint32_t low) {
+    std::uint64_t bits = (static_cast<std::uint64_t>(high >> 6) << 26) | (low >> 6);
+    return (static_cast<double>(bits) + 0.5) * (1.0 / 4503599627370496.0);
+  }
+}
+
+namespace edm {
+
+PhiloxEngine::PhiloxEngine() : PhiloxEngine(0L) {
+}
+
+PhiloxEngine::PhiloxEngine(long seed) : key_(), counter_(), block_(), index_(4) {
+  setSeed(seed, 0);
+}
+
+PhiloxEngine::PhiloxEngine(std::istream& is) : key_(), counter_(), block_(), index_(4) {
+  get(is);
+}
+
+PhiloxEngine::PhiloxEngine(PhiloxEngine const& parent, std::uint32_t substream) :
+  CLHEP::HepRandomEngine(),
+  key_(parent.key_),
+  counter_{{0U, substream, parent.counter_[2], parent.counter_[3]}},
+  block_(),
+  index_(4) {
+  theSeed = parent.theSeed;
+}
+
+PhiloxEngine::~PhiloxEngine() {
+}
+
+PhiloxEngine::Counter PhiloxEngine::philox(Counter counter, Key key) {
+  for(unsigned int round = 0; round < 10; ++round) {
+    if(round != 0) {
+      key[0] += kWeyl0;
+      key[1] += kWeyl1;
+    }
+    std::uint32_t hi0, lo0, hi1, lo1;
+    mulhilo(kMultiplier0, counter[0], hi0, lo0);
+    mulhilo(kMultiplier1, counter[2], hi1, lo1);
+    counter = Counter{{hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0}};
+  }
+  return counter;
+}
+
+void PhiloxEngine::refill() {
+  block_ = philox(counter_, key_);
+  ++counter_[0];
+  index_ = 0;
+}
+
+double PhiloxEngine::flat() {
+  std::uint32_t high = nextWord();
+  return toDouble(high, nextWord());
+}
+
+PhiloxEngine::operator float() {
+  // 23 bits, so that the half step does not round up to 1
+  return (static_cast<float>(nextWord() >> 9) + 0.5f) * (1.0f / 8388608.0f);
+}
+
+void PhiloxEngine::flatArray(int const size, double* vect) {
+  int i = 0;
+  while(i < size && index_ != 4) {
+    vect[i++] = flat();
+  }
+  // Whole blocks do not depend on each other and need no buffering.
+  Counter counter = counter_;
+  for(; i + 1 < size; i += 2) {
+    Counter block = philox(counter, key_);
+    ++counter[0];
+    vect[i] = toDouble(block[0], block[1]);
+    vect[i + 1] = toDouble(block[2], block[3]);
+  }
+  counter_ = counter;
+  if(i < size) {
+    vect[i] = flat();
+  }
+}
+
+void PhiloxEngine::fillWords(std::size_t size, std::uint32_t* words) {
+  std::size_t i = 0;
+  while(i < size && index_ != 4) {
+    words[i++] = nextWord();
+  }
+  Counter counter = counter_;
+  for(; i + 4 <= size; i += 4) {
+    Counter block = philox(counter, key_);
+    ++counter[0];
+    for(unsigned int j = 0; j < 4; ++j) {
+      words[i + j] = block[j];
+    }
+  }
+  counter_ = counter;
+  while(i < size) {
+    words[i++] = nextWord();
+  }
+}
+
+void PhiloxEngine::setSeed(long seed, int) {
+  theSeed = seed;
+  key_ = Key{{static_cast<std::uint32_t>(seed), 0U}};
+  counter_ = Counter();
+  index_ = 4;
+}
+
+void PhiloxEngine::setSeeds(long const* seeds, int) {
+  setSeed(seeds[0], 0);
+}
+
+void PhiloxEngine::startEvent(std::uint32_t run, std::uint64_t event) {
+  key_[1] = run;
+  counter_ = Counter{{0U, 0U, static_cast<std::uint32_t>(event), static_cast<std::uint32_t>(event >> 32)}};
+  index_ = 4;
+}
+
+void PhiloxEngine::saveStatus(char const filename[]) const {
+  std::ofstream file(filename, std::ios::out);
+  if(!file) {
+    throw edm::Exception(edm::errors::FileOpenError)
+      << "PhiloxEngine::saveStatus could not open the file \"" << filename << "\"\n";
+  }
+  put(file);
+}
+
+void PhiloxEngine::restoreStatus(char const filename[]) {
+  std::ifstream file(filename, std::ios::in);
+  if(!file) {
+    throw edm::Exception(edm::errors::FileOpenError)
+      << "PhiloxEngine::restoreStatus could not open the file \"" << filename << "\"\n";
+  }
+  get(file);
+}
+
+void PhiloxEngine::showStatus() const {
+  std::cout << "--------- Philox engine status ---------\n"
+            << " Key     = " << key_[0] << " " << key_[1] << "\n"
+            << " Counter = " << counter_[0] << " " << counter_[1] << " "
+            << counter_[2] << " " << counter_[3] << "\n"
+            << " Used words of the current block = " << index_ << "\n"
+            << "----------------------------------------" << std::endl;
+}
+
+std::ostream& PhiloxEngine::put(std::ostream& os) const {
+  os << beginTag();
+  for(auto value : put()) {
+    os << " " << value;
+  }
+  os << "\n";
+  return os;
+}
+
+std::vector<unsigned long> PhiloxEngine::put() const {
+  std::vector<unsigned long> v;
+  v.reserve(stateSize);
+  v.push_back(CLHEP::engineIDulong<PhiloxEngine>());
+  v.push_back(key_[0]);
+  v.push_back(key_[1]);
+  for(auto value : counter_) {
+    v.push_back(value);
+  }
+  v.push_back(index_);
+  return v;
+}
+
+std::istream& PhiloxEngine::get(std::istream& is) {
+  std::string tag;
+  is >> tag;
+  if(tag != beginTag()) {
+    throw edm::Exception(edm::errors::FileReadError)
+      << "PhiloxEngine::get found \"" << tag << "\" instead of \"" << beginTag() << "\"\n";
+  }
+  return getState(is);
+}
+
+std::istream& PhiloxEngine::getState(std::istream& is) {
+  std::vector<unsigned long> v(stateSize);
+  for(auto& value : v) {
+    is >> value;
+  }
+  if(!is || !get(v)) {
+    throw edm::Exception(edm::errors::FileReadError)
+      << "PhiloxEngine::getState could not read the state of the engine\n";
+  }
+  return is;
+}
+
+bool PhiloxEngine::get(std::vector<unsigned long> const& v) {
+  if(v.size() != stateSize) return false;
+  if(v[0] != CLHEP::engineIDulong<PhiloxEngine>()) return false;
+  if(v[7] > 4) return false;
+  key_ = Key{{static_cast<std::uint32_t>(v[1]), static_cast<std::uint32_t>(v[2])}};
+  for(unsigned int i = 0; i < 4; ++i) {
+    counter_[i] = static_cast<std::uint32_t>(v[3 + i]);
+  }
+  index_ = v[7];
+  // The current block comes back from the counter that produced it.
+  if(index_ != 4) {
+    Counter previous = counter_;
+    --previous[0];
+    block_ = philox(previous, key_);
+  }
+  theSeed = key_[0];
+  return true;
+}
+
+bool PhiloxEngine::getState(std::vector<unsigned long> const& v) {
+  return get(v);
+}
+
+}  // namespace edm
@@ -0,0 +1,123 @@
+#ifndef IOMC_RandomEngine_PhiloxEngine_h
+#define IOMC_RandomEngine_PhiloxEngine_h
+
+/** \class edm::PhiloxEngine
+
+ Description: Counter based random engine, Philox4x32-10 of Salmon et al.
+
+ Each block of four 32 bit random words is a pure function of a 64 bit
+ key and a 128 bit counter, so the whole state of the engine is the key,
+ the counter and the position in the current block.  The key is the seed
+ and the run number, the counter is the block within the event, a
+ substream number and the 64 bit event number:
+
+   key     = (seed, run)
+   counter = (block, substream, event low word, event high word)
+
+ The RandomNumberGeneratorService calls startEvent before each event, so
+ the sequence of an event depends only on the seed and the EventID and
+ the saved state of an engine is a handful of words.  A module wanting
+ several independent and reproducible sequences within an event, for
+ example one per task, can build substreams from its engine.  Each
+ substream holds 2^32 blocks, 2^33 doubles, before it wraps.
+
+*/
+
+#include "CLHEP/Random/RandomEngine.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace edm {
+
+  class PhiloxEngine : public CLHEP::HepRandomEngine {
+
+  public:
+    typedef std::array<std::uint32_t, 2> Key;
+    typedef std::array<std::uint32_t, 4> Counter;
+
+    // Constructors and destructor.
+    PhiloxEngine();
+    PhiloxEngine(long seed);
+    PhiloxEngine(std::istream& is);
+    // Same key and event as the parent, but an independent sequence.
+    PhiloxEngine(PhiloxEngine const& parent, std::uint32_t substream);
+    virtual ~PhiloxEngine();
+
+    // Returns a pseudo random number in ]0,1[ (i. e., excluding the end points).
+    double flat() override;
+
+    // Fills an array "vect" of specified size with flat random values.
+    void flatArray(int const size, double* vect) override;
+
+    // Fills an array with 32 bit random words, four per block at a time.
+    void fillWords(std::size_t size, std::uint32_t* words);
+
+    // Sets the state of the algorithm according to seed.
+    void setSeed(long seed, int) override;
+
+    // Sets the state of the algorithm according to the zero terminated
+    // array of seeds. Only the first seed is used.
+    void setSeeds(long const* seeds, int) override;
+
+    // Moves to the start of the sequence of an event.
+    void startEvent(std::uint32_t run, std::uint64_t event);
+
+    // Saves the current engine status in the named file
+    void saveStatus(char const filename[] = "Philox.conf") const override;
+
+    // Reads from named file the the last saved engine status and restores it.
+    void restoreStatus(char const filename[] = "Philox.conf") override;
+
+    // Dumps the current engine status on the screen.
+    void showStatus() const override;
+
+    // Returns a float flat ]0,1[
+    operator float() override;
+
+    // Returns an unsigned int (32-bit) flat
+    operator unsigned int() override { return nextWord(); }
+
+    virtual std::ostream& put(std::ostream& os) const override;
+    virtual std::istream& get(std::istream& is) override;
+    static std::string beginTag() { return engineName() + std::string("-begin"); }
+    virtual std::istream& getState(std::istream& is) override;
+
+    // Returns the engine name as a string
+    std::string name() const override { return engineName(); }
+    static std::string engineName() { return std::string("Philox"); }
+
+    virtual std::vector<unsigned long> put() const override;
+    bool get(std::vector<unsigned long> const& v) override;
+    bool getState(std::vector<unsigned long> const& v) override;
+
+    Key const& key() const { return key_; }
+    Counter const& counter() const { return counter_; }
+
+    // The Philox4x32-10 bijection itself
+    static Counter philox(Counter counter, Key key);
+
+  private:
+    static const unsigned int stateSize = 8;
+
+    std::uint32_t nextWord() {
+      if(index_ == 4) {
+        refill();
+      }
+      return block_[index_++];
+    }
+    void refill();
+
+    Key key_;
+    // counter of the next block to generate
+    Counter counter_;
+    // the current block and the position of its next unused word
+    Counter block_;
+    unsigned int index_;
+  }; // PhiloxEngine
+
+}  // namespace edm
+
+#endif // IOMC_RandomEngine_PhiloxEngine_h
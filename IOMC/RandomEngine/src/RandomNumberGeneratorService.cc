@@ -34,6 +34,7 @@
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/LuminosityBlockIndex.h"
 #include "FWCore/Utilities/interface/StreamID.h"
+#include "IOMC/RandomEngine/src/PhiloxEngine.h"
 #include "IOMC/RandomEngine/src/TRandomAdaptor.h"
 #include "SimDataFormats/RandomEngine/interface/RandomEngineState.h"
 #include "SimDataFormats/RandomEngine/interface/RandomEngineStates.h"
@@ -151,7 +152,7 @@ namespace edm {
         else {
           if(initialSeedSet.size() != 1U) {
             throw Exception(errors::Configuration)
-              << "Random engines of type \"HepJamesRandom\" and \"TRandom3\n"
+              << "Random engines of type \"HepJamesRandom\", \"TRandom3\" and \"Philox\"\n"
               << "require exactly 1 seed be specified in the configuration.\n"
               << "There were " << initialSeedSet.size() << " seeds set for the\n"
               << "module with label \"" << label << "\".\n" ;
@@ -164,7 +165,7 @@ namespace edm {
                    "configuration file was " << initialSeedSet[0] << ".  This was for \n"
                 << "the module with label " << label << ".\n";
             }
-          } else if(engineName != "TRandom3") {
+          } else if(engineName != "TRandom3" && engineName != "Philox") {
             throw Exception(errors::Configuration)
               << "The random engine name, \"" << engineName
               << "\", does not correspond to a supported engine.\n"
@@ -488,6 +489,12 @@ namespace edm {
         restoreFromCache(eventCache_[event.streamID()], streamEngines_[event.streamID()]);
 
       } else {
+        // The counter based engines start each event from the EventID
+        for(auto& labelAndEngine : streamEngines_[event.streamID()]) {
+          if(PhiloxEngine* philox = dynamic_cast<PhiloxEngine*>(labelAndEngine.engine().get())) {
+            philox->startEvent(event.id().run(), event.id().event());
+          }
+        }
         // copy from engines to event cache
         snapShot(streamEngines_[event.streamID()], eventCache_[event.streamID()]);
       }
@@ -817,6 +824,14 @@ namespace edm {
           engine->setSeed(engineSeedsL[0], 0);
           engine->get(engineStateL);
 
+          labelAndEngine->setSeed(engineSeeds[0], 0);
+        } else if(engineStateL[0] == CLHEP::engineIDulong<PhiloxEngine>()) {
+
+          checkEngineType(engine->name(), std::string("Philox"), engineLabel);
+
+          // This line actually restores the engine state, the key holds the seed.
+          engine->get(engineStateL);
+
           labelAndEngine->setSeed(engineSeeds[0], 0);
         } else {
           // This should not be possible because this code should be able to restore
@@ -1175,6 +1190,12 @@ namespace edm {
               if(seedOffset != 0 || eventSeedOffset != 0) {
                 resetEngineSeeds(engines.back(), name, seeds, seedOffset, eventSeedOffset);
               }
+            } else if(name == "Philox") {
+              std::shared_ptr<CLHEP::HepRandomEngine> engine = std::make_shared<PhiloxEngine>(seedL);
+              engines.emplace_back(label, seeds, engine);
+              if(seedOffset != 0 || eventSeedOffset != 0) {
+                resetEngineSeeds(engines.back(), name, seeds, seedOffset, eventSeedOffset);
+              }
             } else { // TRandom3, currently the only other possibility
 
               // There is a dangerous conversion from std::uint32_t to long
@@ -1236,10 +1257,10 @@ namespace edm {
           long int seedL = static_cast<long int>(seed0);
           labelAndEngine.engine()->setSeed(seedL, 0);
         } else {
-          assert(engineName == "TRandom3");
+          assert(engineName == "TRandom3" || engineName == "Philox");
           // Wrap around if the offsets push the seed over the maximum allowed value
           // We have to be extra careful with this one because it may also go beyond
-          // the values 32 bits can hold
+          // the values 32 bits can hold. Philox takes any 32 bit seed as well.
           std::uint32_t max32 = maxSeedTRandom3;
           std::uint32_t seed0 = seeds[0];
           if((max32 - seed0) >= offset1) {
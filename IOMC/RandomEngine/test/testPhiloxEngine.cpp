@@ -0,0 +1,82 @@
+// Checks the Philox4x32-10 bijection of PhiloxEngine against the known
+// answer vectors of Random123 (kat_vectors, philox4x32 10), and the words
+// the engine generates against the bijection.
+
+#include "IOMC/RandomEngine/src/PhiloxEngine.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+  struct KnownAnswer {
+    edm::PhiloxEngine::Counter counter;
+    edm::PhiloxEngine::Key key;
+    edm::PhiloxEngine::Counter expected;
+  };
+
+  KnownAnswer const knownAnswers[] = {
+    {{{0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U}}, {{0x00000000U, 0x00000000U}},
+     {{0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U}}},
+    {{{0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU}}, {{0xffffffffU, 0xffffffffU}},
+     {{0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU}}},
+    {{{0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U}}, {{0xa4093822U, 0x299f31d0U}},
+     {{0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U}}}
+  };
+
+  bool checkWords(char const* what, std::vector<std::uint32_t> const& words,
+                  std::uint32_t seed, std::uint32_t run, std::uint32_t substream, std::uint64_t event) {
+    edm::PhiloxEngine::Key const key{{seed, run}};
+    for(std::size_t i = 0; i < words.size(); ++i) {
+      edm::PhiloxEngine::Counter const counter{{static_cast<std::uint32_t>(i / 4), substream,
+                                                static_cast<std::uint32_t>(event), static_cast<std::uint32_t>(event >> 32)}};
+      if(words[i] != edm::PhiloxEngine::philox(counter, key)[i % 4]) {
+        std::cerr << what << ": word " << i << " is not the one of its block" << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main() {
+  bool ok = true;
+
+  for(auto const& answer : knownAnswers) {
+    edm::PhiloxEngine::Counter const result = edm::PhiloxEngine::philox(answer.counter, answer.key);
+    if(result != answer.expected) {
+      std::cerr << "philox(" << std::hex;
+      for(auto word : answer.counter) std::cerr << std::setw(8) << std::setfill('0') << word << " ";
+      for(auto word : answer.key) std::cerr << std::setw(8) << std::setfill('0') << word << " ";
+      std::cerr << ") gives";
+      for(auto word : result) std::cerr << " " << std::setw(8) << std::setfill('0') << word;
+      std::cerr << std::dec << std::endl;
+      ok = false;
+    }
+  }
+
+  // the words of an event, one at a time and in bulk, not aligned on a block
+  std::uint32_t const seed = 12345U;
+  std::uint32_t const run = 7U;
+  std::uint64_t const event = 0x100000002ULL;
+  edm::PhiloxEngine engine(seed);
+  engine.startEvent(run, event);
+  std::vector<std::uint32_t> words(41);
+  words[0] = static_cast<unsigned int>(engine);
+  words[1] = static_cast<unsigned int>(engine);
+  engine.fillWords(words.size() - 3, &words[2]);
+  words.back() = static_cast<unsigned int>(engine);
+  ok = checkWords("event", words, seed, run, 0U, event) && ok;
+
+  // a substream of the same event
+  edm::PhiloxEngine substream(engine, 3U);
+  std::vector<std::uint32_t> substreamWords(10);
+  substream.fillWords(substreamWords.size(), &substreamWords[0]);
+  ok = checkWords("substream", substreamWords, seed, run, 3U, event) && ok;
+
+  if(ok) {
+    std::cout << "PhiloxEngine passed the known answer tests" << std::endl;
+  }
+  return ok ? 0 : 1;
+}
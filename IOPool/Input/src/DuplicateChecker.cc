@@ -13,6 +13,7 @@ namespace edm {
   DuplicateChecker::DuplicateChecker(ParameterSet const& pset) :
     dataType_(unknown),
     itIsKnownTheFileHasNoDuplicates_(false),
+    itIsKnownTheFileHasNoInternalDuplicates_(false),
     disabled_(false)
   {
     // The default value provided as the second argument to the getUntrackedParameter function call
@@ -42,6 +43,7 @@ namespace edm {
     dataType_ = unknown;
     relevantPreviousEvents_.clear();
     itIsKnownTheFileHasNoDuplicates_ = false;
+    itIsKnownTheFileHasNoInternalDuplicates_ = false;
   }
 
   void DuplicateChecker::inputFileOpened(
@@ -55,6 +57,7 @@ namespace edm {
 
     relevantPreviousEvents_.clear();
     itIsKnownTheFileHasNoDuplicates_ = false;
+    itIsKnownTheFileHasNoInternalDuplicates_ = false;
 
     if (duplicateCheckMode_ == checkAllFilesOpened) {
 
@@ -67,8 +70,9 @@ namespace edm {
         }
       }
     }
-    if (relevantPreviousEvents_.empty()) {
-      if(!indexIntoFile.containsDuplicateEvents()) {
+    if(!indexIntoFile.containsDuplicateEvents()) {
+      itIsKnownTheFileHasNoInternalDuplicates_ = true;
+      if (relevantPreviousEvents_.empty()) {
         itIsKnownTheFileHasNoDuplicates_ = true;
       }
     }
@@ -79,6 +83,7 @@ namespace edm {
     dataType_ = unknown;
     relevantPreviousEvents_.clear();
     itIsKnownTheFileHasNoDuplicates_ = false;
+    itIsKnownTheFileHasNoInternalDuplicates_ = false;
   }
 
   bool DuplicateChecker::isDuplicateAndCheckActive(int index,
@@ -90,7 +95,9 @@ namespace edm {
     if (checkDisabled()) return false;
 
     IndexIntoFile::IndexRunLumiEventKey newEvent(index, run, lumi, event);
-    bool duplicate = !relevantPreviousEvents_.insert(newEvent).second;
+    bool duplicate = itIsKnownTheFileHasNoInternalDuplicates_ ?
+      relevantPreviousEvents_.find(newEvent) != relevantPreviousEvents_.end() :
+      !relevantPreviousEvents_.insert(newEvent).second;
 
     if (duplicate) {
       if (duplicateCheckMode_ == checkAllFilesOpened) {
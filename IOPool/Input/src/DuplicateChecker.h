@@ -83,6 +83,11 @@ namespace edm {
 
     bool itIsKnownTheFileHasNoDuplicates_;
 
+    // True if the current file has no duplicates within itself.  Then
+    // an event can only duplicate one of relevantPreviousEvents_ and
+    // the events processed in the file need not be added to the set.
+    bool itIsKnownTheFileHasNoInternalDuplicates_;
+
     bool disabled_;
   };
 }
@@ -27,7 +27,9 @@ namespace edm {
    tree_(tree),
    filePtr_(filePtr),
    nextReader_(),
-   resourceAcquirer_(inputType == InputType::Primary ? new SharedResourcesAcquirer(SharedResourcesRegistry::instance()->createAcquirerForSourceDelayedReader()) : static_cast<SharedResourcesAcquirer*>(nullptr)),
+   //Run and lumi products are all read by the source itself, between the
+   // event loops, so only the event reads of the streams need serializing
+   resourceAcquirer_(inputType == InputType::Primary and tree.branchType() == InEvent ? new SharedResourcesAcquirer(SharedResourcesRegistry::instance()->createAcquirerForSourceDelayedReader()) : static_cast<SharedResourcesAcquirer*>(nullptr)),
    inputType_(inputType),
    wrapperBaseTClass_(TClass::GetClass("edm::WrapperBase")) {
   }
@@ -42,8 +44,8 @@ namespace edm {
 
   std::unique_ptr<WrapperBase>
   RootDelayedReader::getProduct_(BranchKey const& k, EDProductGetter const* ep) {
-    if (lastException_) {
-      std::rethrow_exception(lastException_);
+    if (auto except = tree_.lastException()) {
+      std::rethrow_exception(except);
     }
     iterator iter = branchIter(k);
     if (!found(iter)) {
@@ -80,12 +82,12 @@ namespace edm {
       tree_.getEntry(br, tree_.entryNumberForIndex(ep->transitionIndex()));
     } catch(edm::Exception& exception) {
       exception.addContext("Rethrowing an exception that happened on a different thread.");
-      lastException_ = std::current_exception();
+      tree_.setLastException(std::current_exception());
     } catch(...) {
-      lastException_ = std::current_exception();
+      tree_.setLastException(std::current_exception());
     }
-    if(lastException_) {
-      std::rethrow_exception(lastException_);
+    if(auto except = tree_.lastException()) {
+      std::rethrow_exception(except);
     }
     if(tree_.branchType() == InEvent) {
       // CMS-THREADING For the primary input source calls to this function need to be serialized
@@ -63,10 +63,9 @@ namespace edm {
     std::unique_ptr<SharedResourcesAcquirer> resourceAcquirer_; // We do not use propagate_const because the acquirer is itself mutable.
     InputType inputType_;
     edm::propagate_const<TClass*> wrapperBaseTClass_;
-    //If a fatal exception happens we need to make a copy so we can
+    //If a fatal exception happens the RootTree keeps a copy so we can
     // rethrow that exception on other threads. This avoids TTree
     // non-exception safety problems on later calls to TTree.
-    mutable std::exception_ptr lastException_;
   }; // class RootDelayedReader
   //------------------------------------------------------------
 }
@@ -1434,7 +1434,7 @@ namespace edm {
                                  std::move(eventSelectionIDs_),
                                  std::move(branchListIndexes_),
                                  *(makeProductProvenanceRetriever(principal.streamID().value())),
-                                 eventTree_.rootDelayedReader());
+                                 eventTree_.rootDelayedReader(principal.transitionIndex()));
 
     // report event read from file
     filePtr_->eventReadFromFile();
@@ -1525,7 +1525,7 @@ namespace edm {
     }
     // End code for backward compatibility before the existence of run trees.
     runTree_.insertEntryForIndex(runPrincipal.transitionIndex());
-    runPrincipal.fillRunPrincipal(*processHistoryRegistry_, runTree_.rootDelayedReader());
+    runPrincipal.fillRunPrincipal(*processHistoryRegistry_, runTree_.rootDelayedReader(0));
     // Read in all the products now.
     runPrincipal.readAllFromSourceAndMergeImmediately();
   }
@@ -1581,7 +1581,7 @@ namespace edm {
     // End code for backward compatibility before the existence of lumi trees.
     lumiTree_.setEntryNumber(indexIntoFileIter_.entry());
     lumiTree_.insertEntryForIndex(lumiPrincipal.transitionIndex());
-    lumiPrincipal.fillLuminosityBlockPrincipal(*processHistoryRegistry_, lumiTree_.rootDelayedReader());
+    lumiPrincipal.fillLuminosityBlockPrincipal(*processHistoryRegistry_, lumiTree_.rootDelayedReader(0));
     // Read in all the products now.
     lumiPrincipal.readAllFromSourceAndMergeImmediately();
     ++indexIntoFileIter_;
@@ -1811,7 +1811,7 @@ namespace edm {
   public:
     ReducedProvenanceReader(RootTree* iRootTree, std::vector<ParentageID> const& iParentageIDLookup, DaqProvenanceHelper const* daqProvenanceHelper);
   private:
-    virtual std::set<ProductProvenance> readProvenance(unsigned int) const override;
+    virtual ProductProvenanceVector readProvenance(unsigned int) const override;
     edm::propagate_const<RootTree*> rootTree_;
     edm::propagate_const<TBranch*> provBranch_;
     StoredProductProvenanceVector provVector_;
@@ -1835,7 +1835,7 @@ namespace edm {
     provBranch_ = rootTree_->tree()->GetBranch(BranchTypeToProductProvenanceBranchName(rootTree_->branchType()).c_str());
   }
 
-  std::set<ProductProvenance>
+  ProductProvenanceVector
   ReducedProvenanceReader::readProvenance(unsigned int transitionIndex) const {
     {
       std::lock_guard<SharedResourcesAcquirer> guard(resourceAcquirer_);
@@ -1843,12 +1843,13 @@ namespace edm {
       me->rootTree_->fillBranchEntry(me->provBranch_, me->rootTree_->entryNumberForIndex(transitionIndex), me->pProvVector_);
       setRefCoreStreamer(true);
     }
-    std::set<ProductProvenance> retValue;
+    ProductProvenanceVector retValue;
+    retValue.reserve(provVector_.size());
     if(daqProvenanceHelper_) {
       for(auto const& prov : provVector_) {
         BranchID bid(prov.branchID_);
-        retValue.emplace(daqProvenanceHelper_->mapBranchID(BranchID(prov.branchID_)),
-                         daqProvenanceHelper_->mapParentageID(parentageIDLookup_[prov.parentageIDIndex_]));
+        retValue.emplace_back(daqProvenanceHelper_->mapBranchID(BranchID(prov.branchID_)),
+                              daqProvenanceHelper_->mapParentageID(parentageIDLookup_[prov.parentageIDIndex_]));
       }
     } else {
       for(auto const& prov : provVector_) {
@@ -1859,7 +1860,7 @@ namespace edm {
             << "This should never happen.\n"
             << "Please report this to the framework hypernews forum 'hn-cms-edmFramework@cern.ch'.\n";
         }
-        retValue.emplace(BranchID(prov.branchID_), parentageIDLookup_[prov.parentageIDIndex_]);
+        retValue.emplace_back(BranchID(prov.branchID_), parentageIDLookup_[prov.parentageIDIndex_]);
       }
     }
     return retValue;
@@ -1870,7 +1871,7 @@ namespace edm {
     explicit FullProvenanceReader(RootTree* rootTree, DaqProvenanceHelper const* daqProvenanceHelper);
     virtual ~FullProvenanceReader() {}
   private:
-    virtual std::set<ProductProvenance> readProvenance(unsigned int transitionIndex) const override;
+    virtual ProductProvenanceVector readProvenance(unsigned int transitionIndex) const override;
     RootTree* rootTree_;
     ProductProvenanceVector infoVector_;
     mutable ProductProvenanceVector* pInfoVector_;
@@ -1887,23 +1888,22 @@ namespace edm {
          resourceAcquirer_(SharedResourcesRegistry::instance()->createAcquirerForSourceDelayedReader()) {
   }
 
-  std::set<ProductProvenance>
+  ProductProvenanceVector
   FullProvenanceReader::readProvenance(unsigned int transitionIndex) const {
     {
       std::lock_guard<SharedResourcesAcquirer> guard(resourceAcquirer_);
       rootTree_->fillBranchEntryMeta(rootTree_->branchEntryInfoBranch(), rootTree_->entryNumberForIndex(transitionIndex), pInfoVector_);
       setRefCoreStreamer(true);
     }
-    std::set<ProductProvenance> retValue;
+    ProductProvenanceVector retValue;
+    retValue.reserve(infoVector_.size());
     if(daqProvenanceHelper_) {
       for(auto const& info : infoVector_) {
-        retValue.emplace(daqProvenanceHelper_->mapBranchID(info.branchID()),
-                         daqProvenanceHelper_->mapParentageID(info.parentageID()));
+        retValue.emplace_back(daqProvenanceHelper_->mapBranchID(info.branchID()),
+                              daqProvenanceHelper_->mapParentageID(info.parentageID()));
       }
     } else {
-      for(auto const& info : infoVector_) {
-        retValue.emplace(info);
-      }
+      retValue = infoVector_;
     }
     return retValue;
   }
@@ -1913,7 +1913,7 @@ namespace edm {
     explicit OldProvenanceReader(RootTree* rootTree, EntryDescriptionMap const& theMap, DaqProvenanceHelper const* daqProvenanceHelper);
     virtual ~OldProvenanceReader() {}
   private:
-    virtual std::set<ProductProvenance> readProvenance(unsigned int transitionIndex) const override;
+    virtual ProductProvenanceVector readProvenance(unsigned int transitionIndex) const override;
     edm::propagate_const<RootTree*> rootTree_;
     std::vector<EventEntryInfo> infoVector_;
     mutable std::vector<EventEntryInfo> *pInfoVector_;
@@ -1932,7 +1932,7 @@ namespace edm {
          resourceAcquirer_(SharedResourcesRegistry::instance()->createAcquirerForSourceDelayedReader()) {
   }
 
-  std::set<ProductProvenance>
+  ProductProvenanceVector
   OldProvenanceReader::readProvenance(unsigned int transitionIndex) const {
     {
       std::lock_guard<SharedResourcesAcquirer> guard(resourceAcquirer_);
@@ -1940,16 +1940,17 @@ namespace edm {
       roottree::getEntry(rootTree_->branchEntryInfoBranch(), rootTree_->entryNumberForIndex(transitionIndex));
       setRefCoreStreamer(true);
     }
-    std::set<ProductProvenance> retValue;
+    ProductProvenanceVector retValue;
+    retValue.reserve(infoVector_.size());
     for(auto const& info : infoVector_) {
       EntryDescriptionMap::const_iterator iter = entryDescriptionMap_.find(info.entryDescriptionID());
       assert(iter != entryDescriptionMap_.end());
       Parentage parentage(iter->second.parents());
       if(daqProvenanceHelper_) {
-        retValue.emplace(daqProvenanceHelper_->mapBranchID(info.branchID()),
-                                daqProvenanceHelper_->mapParentageID(parentage.id()));
+        retValue.emplace_back(daqProvenanceHelper_->mapBranchID(info.branchID()),
+                              daqProvenanceHelper_->mapParentageID(parentage.id()));
       } else {
-        retValue.emplace(info.branchID(), parentage.id());
+        retValue.emplace_back(info.branchID(), parentage.id());
       }
     }
     return retValue;
@@ -1960,17 +1961,17 @@ namespace edm {
     DummyProvenanceReader();
     virtual ~DummyProvenanceReader() {}
   private:
-    virtual std::set<ProductProvenance> readProvenance(unsigned int) const override;
+    virtual ProductProvenanceVector readProvenance(unsigned int) const override;
   };
 
   DummyProvenanceReader::DummyProvenanceReader() :
       ProvenanceReaderBase() {
   }
 
-  std::set<ProductProvenance>
+  ProductProvenanceVector
   DummyProvenanceReader::readProvenance(unsigned int) const {
     // Not providing parentage!!!
-    return std::set<ProductProvenance>{};
+    return ProductProvenanceVector{};
   }
 
   std::unique_ptr<ProvenanceReaderBase>
@@ -58,7 +58,8 @@ namespace edm {
     enablePrefetching_(enablePrefetching),
     //enableTriggerCache_(branchType_ == InEvent),
     enableTriggerCache_(false), // Disable, for now. Using the trigger cache in the multithreaded environment causes the assert on line 331 to fire occasionally.
-    rootDelayedReader_(new RootDelayedReader(*this, filePtr, inputType)),
+    rootDelayedReaders_(),
+    lastException_(),
     branchEntryInfoBranch_(metaTree_ ? getProductProvenanceBranch(metaTree_, branchType_) : (tree_ ? getProductProvenanceBranch(tree_, branchType_) : 0)),
     infoTree_(dynamic_cast<TTree*>(filePtr_.get() != nullptr ? filePtr->Get(BranchTypeToInfoTreeName(branchType).c_str()) : nullptr)) // backward compatibility
     {
@@ -76,6 +77,10 @@ namespace edm {
       if (treeAutoFlush_ < learningEntries_) {
         learningEntries_ = treeAutoFlush_;
       }
+      rootDelayedReaders_.reserve(nIndexes);
+      for(unsigned int index = 0; index < nIndexes; ++index) {
+        rootDelayedReaders_.emplace_back(new RootDelayedReader(*this, filePtr, inputType));
+      }
       setTreeMaxVirtualSize(maxVirtualSize);
       setCacheSize(cacheSize);
       if (tree_) {
@@ -113,9 +118,11 @@ namespace edm {
   }
 
   DelayedReader*
-  RootTree::rootDelayedReader() const {
-    rootDelayedReader_->reset();
-    return rootDelayedReader_.get();
+  RootTree::rootDelayedReader(unsigned int index) const {
+    assert(index < rootDelayedReaders_.size());
+    auto& reader = rootDelayedReaders_[index];
+    reader->reset();
+    return reader.get();
   }  
 
   void
@@ -16,8 +16,10 @@ RootTree.h // used by ROOT input sources
 #include "Rtypes.h"
 #include "TBranch.h"
 
+#include <exception>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -97,7 +99,7 @@ namespace edm {
     void setEntryNumber(EntryNumber theEntryNumber);
     void insertEntryForIndex(unsigned int index);
     std::vector<std::string> const& branchNames() const {return branchNames_;}
-    DelayedReader* rootDelayedReader() const;
+    DelayedReader* rootDelayedReader(unsigned int index) const;
     template <typename T>
     void fillAux(T*& pAux) {
       auxBranch_->SetAddress(&pAux);
@@ -152,6 +154,17 @@ namespace edm {
     void resetTraining() {trainNow_ = true;}
 
     BranchType branchType() const {return branchType_;}
+
+    //A fatal exception while reading one index leaves the TTree in an unknown state
+    // so it has to be seen by the delayed readers of all the other indexes as well.
+    std::exception_ptr lastException() const {
+      std::lock_guard<std::mutex> guard(lastExceptionMutex_);
+      return lastException_;
+    }
+    void setLastException(std::exception_ptr iException) const {
+      std::lock_guard<std::mutex> guard(lastExceptionMutex_);
+      lastException_ = iException;
+    }
   private:
     void setCacheSize(unsigned int cacheSize);
     void setTreeMaxVirtualSize(int treeMaxVirtualSize);
@@ -191,7 +204,10 @@ namespace edm {
 // effect on the primary treeCache_; all other caches have this explicitly disabled.
     bool enablePrefetching_;
     bool enableTriggerCache_;
-    std::unique_ptr<DelayedReader> rootDelayedReader_;
+    //One reader per index so that concurrent streams do not share reader state
+    std::vector<std::unique_ptr<DelayedReader>> rootDelayedReaders_;
+    mutable std::exception_ptr lastException_;
+    mutable std::mutex lastExceptionMutex_;
 
     TBranch* branchEntryInfoBranch_; //backwards compatibility
     // below for backward compatibility
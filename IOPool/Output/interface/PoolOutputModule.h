@@ -16,7 +16,8 @@
 
 #include "IOPool/Common/interface/RootServiceChecker.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
-#include "FWCore/Framework/interface/one/OutputModule.h"
+#include "FWCore/Concurrency/interface/SerialTaskQueue.h"
+#include "FWCore/Framework/interface/global/OutputModule.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 #include "DataFormats/Provenance/interface/BranchChildren.h"
 #include "DataFormats/Provenance/interface/ParentageID.h"
@@ -30,7 +31,7 @@ namespace edm {
   class RootOutputFile;
   class ConfigurationDescriptions;
 
-  class PoolOutputModule : public one::OutputModule<WatchInputFiles> {
+  class PoolOutputModule : public global::OutputModule<WatchInputFiles> {
   public:
     enum DropMetaData { DropNone, DropDroppedPrior, DropPrior, DropAll };
     explicit PoolOutputModule(ParameterSet const& ps);
@@ -46,6 +47,10 @@ namespace edm {
     int const& splitLevel() const {return splitLevel_;}
     std::string const& basketOrder() const {return basketOrder_;}
     int const& treeMaxVirtualSize() const {return treeMaxVirtualSize_;}
+    bool const& concurrentBasketCompression() const {return concurrentBasketCompression_;}
+    unsigned int const& adaptiveClusteringEvents() const {return adaptiveClusteringEvents_;}
+    int const& targetClusterSize() const {return targetClusterSize_;}
+    bool const& sizeAccounting() const {return sizeAccounting_;}
     bool const& overrideInputFileSplitLevels() const {return overrideInputFileSplitLevels_;}
     DropMetaData const& dropMetaData() const {return dropMetaData_;}
     std::string const& catalog() const {return catalog_;}
@@ -159,6 +164,10 @@ namespace edm {
     int const splitLevel_;
     std::string basketOrder_;
     int const treeMaxVirtualSize_;
+    bool concurrentBasketCompression_;
+    unsigned int const adaptiveClusteringEvents_;
+    int const targetClusterSize_;
+    bool const sizeAccounting_;
     int whyNotFastClonable_;
     DropMetaData dropMetaData_;
     std::string const moduleLabel_;
@@ -172,6 +181,8 @@ namespace edm {
     bool overrideInputFileSplitLevels_;
     edm::propagate_const<std::unique_ptr<RootOutputFile>> rootOutputFile_;
     std::string statusFileName_;
+    // serializes the writes of the events from the different streams, and of the runs and lumis
+    SerialTaskQueue writeQueue_;
   };
 }
 
@@ -15,6 +15,9 @@
 
 #include "IOPool/Output/interface/PoolOutputModule.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace edm {
   class ModuleCallingContext;
   class ParameterSet;
@@ -30,8 +33,11 @@ namespace edm {
     virtual void write(EventForOutput const& e) override;
 
   private:
+    // guards m_lastEvent and m_timeout, and the decision to close the file
+    mutable std::mutex m_mutex;
     mutable time_t m_lastEvent;
-    mutable unsigned int eventsWrittenInCurrentFile;
+    // incremented concurrently by the streams
+    mutable std::atomic<unsigned int> eventsWrittenInCurrentFile;
     mutable int    m_timeout;
   };
 }
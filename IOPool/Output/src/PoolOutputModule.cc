@@ -6,6 +6,8 @@
 #include "FWCore/Framework/interface/LuminosityBlockForOutput.h"
 #include "FWCore/Framework/interface/RunForOutput.h"
 #include "FWCore/Framework/interface/FileBlock.h"
+#include "FWCore/Concurrency/interface/runInSerialTaskQueue.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
@@ -28,8 +30,8 @@
 
 namespace edm {
   PoolOutputModule::PoolOutputModule(ParameterSet const& pset) :
-  edm::one::OutputModuleBase::OutputModuleBase(pset),
-  one::OutputModule<WatchInputFiles>(pset),
+  edm::global::OutputModuleBase::OutputModuleBase(pset),
+  global::OutputModule<WatchInputFiles>(pset),
     rootServiceChecker_(),
     auxItems_(),
     selectedOutputItemList_(),
@@ -44,6 +46,10 @@ namespace edm {
     splitLevel_(std::min<int>(pset.getUntrackedParameter<int>("splitLevel") + 1, 99)),
     basketOrder_(pset.getUntrackedParameter<std::string>("sortBaskets")),
     treeMaxVirtualSize_(pset.getUntrackedParameter<int>("treeMaxVirtualSize")),
+    concurrentBasketCompression_(pset.getUntrackedParameter<bool>("concurrentBasketCompression")),
+    adaptiveClusteringEvents_(pset.getUntrackedParameter<unsigned int>("adaptiveClusteringEvents")),
+    targetClusterSize_(pset.getUntrackedParameter<int>("targetClusterSize")),
+    sizeAccounting_(pset.getUntrackedParameter<bool>("sizeAccounting")),
     whyNotFastClonable_(pset.getUntrackedParameter<bool>("fastCloning") ? FileBlock::CanFastClone : FileBlock::DisabledInConfigFile),
     dropMetaData_(DropNone),
     moduleLabel_(pset.getParameter<std::string>("@module_label")),
@@ -80,6 +86,12 @@ namespace edm {
       whyNotFastClonable_+= FileBlock::EventSelectionUsed;
     }
 
+    if (concurrentBasketCompression_ && !RootOutputTree::concurrentFillAvailable()) {
+      LogWarning("PoolOutputModule") << "concurrentBasketCompression is ignored for module " << moduleLabel_
+                                     << ": it requires ROOT implicit multi-threading (InitRootHandlers.EnableIMT = True).";
+      concurrentBasketCompression_ = false;
+    }
+
     // We don't use this next parameter, but we read it anyway because it is part
     // of the configuration of this module.  An external parser creates the
     // configuration by reading this source code.
@@ -231,21 +243,26 @@ namespace edm {
   }
 
   void PoolOutputModule::write(EventForOutput const& e) {
-    updateBranchParents(e);
-    rootOutputFile_->writeOne(e);
+    // Called concurrently from all the streams: the file is only touched from the queue,
+    // so the other output modules and the streams waiting here keep making progress.
+    runInSerialTaskQueue(writeQueue_, [this, &e]() {
+      updateBranchParents(e);
+      rootOutputFile_->writeOne(e);
       if (!statusFileName_.empty()) {
         std::ofstream statusFile(statusFileName_.c_str());
         statusFile << e.id() << " time: " << std::setprecision(3) << TimeOfDay() << '\n';
         statusFile.close();
       }
+    });
   }
 
   void PoolOutputModule::writeLuminosityBlock(LuminosityBlockForOutput const& lb) {
-    rootOutputFile_->writeLuminosityBlock(lb);
+    // events of the next luminosity blocks may still be in flight
+    runInSerialTaskQueue(writeQueue_, [this, &lb]() { rootOutputFile_->writeLuminosityBlock(lb); });
   }
 
   void PoolOutputModule::writeRun(RunForOutput const& r) {
-    rootOutputFile_->writeRun(r);
+    runInSerialTaskQueue(writeQueue_, [this, &r]() { rootOutputFile_->writeRun(r); });
   }
 
   void PoolOutputModule::reallyCloseFile() {
@@ -389,6 +406,24 @@ namespace edm {
                      "Used by ROOT when fast copying. Affects performance.");
     desc.addUntracked<int>("treeMaxVirtualSize", -1)
         ->setComment("Size of ROOT TTree TBasket cache.  Affects performance.");
+    desc.addUntracked<bool>("concurrentBasketCompression", false)
+        ->setComment("True:  Fill the branches of a tree, and compress their baskets, concurrently in TBB tasks.\n"
+                     "       The order of the runs, lumis and events in the file is unchanged.\n"
+                     "       Requires ROOT implicit multi-threading (InitRootHandlers.EnableIMT).\n"
+                     "False: Fill the branches one after the other.");
+    desc.addUntracked<unsigned int>("adaptiveClusteringEvents", 0U)
+        ->setComment("If not zero, the serialized sizes of the event branches are measured over this many events.\n"
+                     "The basket sizes of the branches and the auto flush interval of the event TTree are then\n"
+                     "chosen so that each cluster of events is about 'targetClusterSize' bytes on disk,\n"
+                     "with one basket per branch and cluster. The choices are recorded in the UserInfo of the TTree.\n"
+                     "If zero, the basket sizes and 'eventAutoFlushCompressedSize' are used as given.");
+    desc.addUntracked<int>("targetClusterSize", 20*1024*1024)
+        ->setComment("Compressed size (in bytes) of an event cluster, used when 'adaptiveClusteringEvents' is not zero.");
+    desc.addUntracked<bool>("sizeAccounting", false)
+        ->setComment("True:  Account for the uncompressed and compressed bytes of the event branches while writing.\n"
+                     "       The sizes of each luminosity block, and the largest branches, are logged to 'RootOutputSizes',\n"
+                     "       the sizes of the file and of each of its branches are written to the job report when it is closed.\n"
+                     "False: Do not account for the sizes.");
     desc.addUntracked<bool>("fastCloning", true)
         ->setComment("True:  Allow fast copying, if possible.\n"
                      "False: Disable fast copying.");
@@ -100,9 +100,9 @@ namespace edm {
       pEventEntryInfoVector_(&eventEntryInfoVector_),
       pBranchListIndexes_(nullptr),
       pEventSelectionIDs_(nullptr),
-      eventTree_(filePtr(), InEvent, om_->splitLevel(), om_->treeMaxVirtualSize()),
-      lumiTree_(filePtr(), InLumi, om_->splitLevel(), om_->treeMaxVirtualSize()),
-      runTree_(filePtr(), InRun, om_->splitLevel(), om_->treeMaxVirtualSize()),
+      eventTree_(filePtr(), InEvent, om_->splitLevel(), om_->treeMaxVirtualSize(), om_->concurrentBasketCompression()),
+      lumiTree_(filePtr(), InLumi, om_->splitLevel(), om_->treeMaxVirtualSize(), om_->concurrentBasketCompression()),
+      runTree_(filePtr(), InRun, om_->splitLevel(), om_->treeMaxVirtualSize(), om_->concurrentBasketCompression()),
       treePointers_(),
       dataTypeReported_(false),
       processHistoryRegistry_(),
@@ -120,6 +120,12 @@ namespace edm {
     if (-1 != om->eventAutoFlushSize()) {
       eventTree_.setAutoFlush(-1*om->eventAutoFlushSize());
     }
+    if (om_->adaptiveClusteringEvents() != 0U) {
+      eventTree_.enableAdaptiveClustering(om_->adaptiveClusteringEvents(), om_->targetClusterSize());
+    }
+    if (om_->sizeAccounting()) {
+      eventTree_.enableSizeAccounting();
+    }
     eventTree_.addAuxiliary<EventAuxiliary>(BranchTypeToAuxiliaryBranchName(InEvent),
                                             pEventAux_, om_->auxItems()[InEvent].basketSize_);
     eventTree_.addAuxiliary<StoredProductProvenanceVector>(BranchTypeToProductProvenanceBranchName(InEvent),
@@ -450,10 +456,77 @@ namespace edm {
     fillBranches(InLumi, lb);
     lumiTree_.optimizeBaskets(10ULL*1024*1024);
 
+    if(om_->sizeAccounting()) {
+      reportLumiSizes(lb.id());
+    }
+
     Service<JobReport> reportSvc;
     reportSvc->reportLumiSection(reportToken_, lb.id().run(), lb.id().luminosityBlock());
   }
 
+  void RootOutputFile::reportLumiSizes(LuminosityBlockID const& id) {
+    // the events of the luminosity block were all written before it
+    RootOutputTree::EntrySizes const entries = eventTree_.takeEntrySizes();
+    std::vector<RootOutputTree::BranchSize> sizes = eventTree_.branchSizes();
+    std::vector<RootOutputTree::BranchSize> growth(sizes);
+    if(lumiStartSizes_.size() == sizes.size()) {
+      for(std::size_t i = 0; i < sizes.size(); ++i) {
+        growth[i].totBytes_ -= lumiStartSizes_[i].totBytes_;
+        growth[i].zipBytes_ -= lumiStartSizes_[i].zipBytes_;
+      }
+    }
+    lumiStartSizes_ = std::move(sizes);
+
+    Long64_t zipBytes = 0;
+    for(auto const& branch : growth) {
+      zipBytes += branch.zipBytes_;
+    }
+    std::sort(growth.begin(), growth.end(),
+              [](RootOutputTree::BranchSize const& a, RootOutputTree::BranchSize const& b) { return a.totBytes_ > b.totBytes_; });
+
+    // the compressed bytes are those of the baskets written during the luminosity block
+    LogInfo info("RootOutputSizes");
+    info << om_->moduleLabel() << " run " << id.run() << " lumi " << id.luminosityBlock() << ": "
+         << entries.entries_ << " events, " << entries.bytes_ << " bytes uncompressed (largest event " << entries.maxBytes_
+         << "), " << zipBytes << " bytes compressed\n";
+    for(std::size_t i = 0; i < growth.size() && i < 10U; ++i) {
+      info << "  " << growth[i].name_ << ": " << growth[i].totBytes_ << " uncompressed, " << growth[i].zipBytes_ << " compressed\n";
+    }
+
+    fileEntrySizes_.add(entries);
+  }
+
+  void RootOutputFile::reportFileSizes() {
+    // all the baskets are written, the compressed sizes are complete
+    fileEntrySizes_.add(eventTree_.takeEntrySizes());
+    Long64_t const nEvents = eventTree_.tree()->GetEntries();
+    std::vector<RootOutputTree::BranchSize> const sizes = eventTree_.branchSizes();
+    Long64_t totBytes = 0;
+    Long64_t zipBytes = 0;
+    for(auto const& branch : sizes) {
+      totBytes += branch.totBytes_;
+      zipBytes += branch.zipBytes_;
+    }
+
+    // one summary for the file, whatever its number of luminosity blocks
+    std::map<std::string, std::string> metrics;
+    metrics["Events"] = std::to_string(fileEntrySizes_.entries_);
+    metrics["UncompressedBytes"] = std::to_string(totBytes);
+    metrics["CompressedBytes"] = std::to_string(zipBytes);
+    metrics["MaxUncompressedBytesPerEvent"] = std::to_string(fileEntrySizes_.maxBytes_);
+    Service<JobReport> reportSvc;
+    reportSvc->reportPerformanceSummary("RootOutputSizes_" + om_->moduleLabel() + "_" + file_, metrics);
+
+    for(auto const& branch : sizes) {
+      std::map<std::string, std::string> metrics;
+      metrics["UncompressedBytes"] = std::to_string(branch.totBytes_);
+      metrics["CompressedBytes"] = std::to_string(branch.zipBytes_);
+      metrics["CompressionRatio"] = std::to_string(branch.zipBytes_ > 0 ? static_cast<double>(branch.totBytes_) / branch.zipBytes_ : 0.);
+      metrics["UncompressedBytesPerEvent"] = std::to_string(nEvents > 0 ? static_cast<double>(branch.totBytes_) / nEvents : 0.);
+      reportSvc->reportPerformanceForModule("RootOutputBranchSize", branch.name_, metrics);
+    }
+  }
+
   void RootOutputFile::writeRun(RunForOutput const& r) {
     // Auxiliary branch
     // NOTE: runAux_ must be filled before calling fillBranches since it gets written out in that routine.
@@ -622,6 +695,9 @@ namespace edm {
       setBranchAliases(treePointers_[branchType]->tree(), om_->keptProducts()[branchType]);
       treePointers_[branchType]->writeTree();
     }
+    if(om_->sizeAccounting()) {
+      reportFileSizes();
+    }
 
     // close the file -- mfp
     // Just to play it safe, zero all pointers to objects in the TFile to be closed.
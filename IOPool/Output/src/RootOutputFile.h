@@ -82,6 +82,9 @@ namespace edm {
 
     void setBranchAliases(TTree* tree, SelectedProducts const& branches) const;
 
+    void reportLumiSizes(LuminosityBlockID const& id);
+    void reportFileSizes();
+
     void fillBranches(BranchType const& branchType,
                       OccurrenceForOutput const& occurrence,
                       StoredProductProvenanceVector* productProvenanceVecPtr = nullptr,
@@ -132,6 +135,8 @@ namespace edm {
     RootOutputTree lumiTree_;
     RootOutputTree runTree_;
     RootOutputTreePtrArray treePointers_;
+    std::vector<RootOutputTree::BranchSize> lumiStartSizes_;
+    RootOutputTree::EntrySizes fileEntrySizes_;
     bool dataTypeReported_;
     ProcessHistoryRegistry processHistoryRegistry_;
     std::map<ParentageID,unsigned int> parentageIDs_;
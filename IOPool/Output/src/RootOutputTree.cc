@@ -16,10 +16,21 @@
 #include "TBranchElement.h"
 #include "TCollection.h"
 #include "TFile.h"
+#include "TList.h"
+#include "TParameter.h"
 #include "TTreeCloner.h"
 #include "Rtypes.h"
 #include "RVersion.h"
+#include "RConfigure.h"
+#if defined(R__USE_IMT) && ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#define ROOT_OUTPUT_TREE_IMT
+#include "TROOT.h"
+#endif
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
 #include <limits>
 
 namespace edm {
@@ -88,7 +99,8 @@ namespace edm {
                    std::shared_ptr<TFile> filePtr,
                    BranchType const& branchType,
                    int splitLevel,
-                   int treeMaxVirtualSize) :
+                   int treeMaxVirtualSize,
+                   bool concurrentFill) :
       filePtr_(filePtr),
       tree_(makeTTree(filePtr.get(), BranchTypeToProductTreeName(branchType), splitLevel)),
       producedBranches_(),
@@ -97,9 +109,28 @@ namespace edm {
       unclonedReadBranches_(),
       clonedReadBranchNames_(),
       currentlyFastCloning_(),
-      fastCloneAuxBranches_(false) {
+      fastCloneAuxBranches_(false),
+      concurrentFill_(concurrentFill && concurrentFillAvailable()),
+      adaptiveClusteringEvents_(0U),
+      targetClusterSize_(0),
+      sizeAccounting_(false),
+      entrySizes_(),
+      clonedBytesPerEntry_(0) {
 
     if(treeMaxVirtualSize >= 0) tree_->SetMaxVirtualSize(treeMaxVirtualSize);
+#ifdef ROOT_OUTPUT_TREE_IMT
+    // TTree::Fill then fills the top level branches, and compresses their baskets, in TBB tasks
+    tree_->SetImplicitMT(concurrentFill_);
+#endif
+  }
+
+  bool
+  RootOutputTree::concurrentFillAvailable() {
+#ifdef ROOT_OUTPUT_TREE_IMT
+    return ROOT::IsImplicitMTEnabled();
+#else
+    return false;
+#endif
   }
 
   TTree*
@@ -207,6 +238,7 @@ namespace edm {
   void
   RootOutputTree::fastCloneTTree(TTree* in, std::string const& option) {
     if(in->GetEntries() != 0) {
+      Long64_t const totBytesBefore = sizeAccounting_ ? branchTotBytes() : 0;
       TObjArray* branches = tree_->GetListOfBranches();
       // If any products were produced (not just event products), the EventAuxiliary will be modified.
       // In that case, don't fast copy auxiliary branches. Remove them, and add back after fast copying.
@@ -267,6 +299,10 @@ namespace edm {
           }
         }
       }
+      if(sizeAccounting_) {
+        // the baskets are copied as they are, not entry by entry
+        clonedBytesPerEntry_ = (branchTotBytes() - totBytesBefore) / in->GetEntries();
+      }
     }
   }
 
@@ -279,9 +315,23 @@ namespace edm {
     tree->AutoSave("FlushBaskets");
   }
 
-  void
+  Long64_t
   RootOutputTree::fillTTree(std::vector<TBranch*> const& branches) {
-    for_all(branches, std::bind(&TBranch::Fill, std::placeholders::_1));
+    Long64_t bytes = 0;
+    for(auto branch : branches) {
+      bytes += branch->Fill();
+    }
+    return bytes;
+  }
+
+  Long64_t
+  RootOutputTree::fillTTreeConcurrently(std::vector<TBranch*> const& branches) {
+    // each branch gets its entries in the same order, only the placement of the baskets in the file changes
+    std::atomic<Long64_t> bytes{0};
+    tbb::parallel_for(std::size_t(0), branches.size(), [&branches, &bytes](std::size_t i) {
+      bytes += branches[i]->Fill();
+    });
+    return bytes;
   }
 
   void
@@ -294,6 +344,7 @@ namespace edm {
     unclonedReadBranches_.clear();
     clonedReadBranchNames_.clear();
     currentlyFastCloning_ = canFastClone && !readBranches_.empty();
+    clonedBytesPerEntry_ = 0;
     if(currentlyFastCloning_) {
       fastCloneAuxBranches_ = canFastCloneAux;
       fastCloneTTree(tree, option);
@@ -311,14 +362,93 @@ namespace edm {
 
   void
   RootOutputTree::fillTree() {
-    if(currentlyFastCloning_) {
-      if(!fastCloneAuxBranches_)fillTTree(auxBranches_);
-      fillTTree(unclonedAuxBranches_);
-      fillTTree(producedBranches_);
-      fillTTree(unclonedReadBranches_);
+    Long64_t bytes = 0;
+    if(currentlyFastCloning_ && concurrentFill_) {
+      std::vector<TBranch*> branches;
+      branches.reserve(auxBranches_.size() + unclonedAuxBranches_.size() + producedBranches_.size() + unclonedReadBranches_.size());
+      if(!fastCloneAuxBranches_) branches.insert(branches.end(), auxBranches_.begin(), auxBranches_.end());
+      branches.insert(branches.end(), unclonedAuxBranches_.begin(), unclonedAuxBranches_.end());
+      branches.insert(branches.end(), producedBranches_.begin(), producedBranches_.end());
+      branches.insert(branches.end(), unclonedReadBranches_.begin(), unclonedReadBranches_.end());
+      bytes = fillTTreeConcurrently(branches);
+    } else if(currentlyFastCloning_) {
+      if(!fastCloneAuxBranches_) bytes += fillTTree(auxBranches_);
+      bytes += fillTTree(unclonedAuxBranches_);
+      bytes += fillTTree(producedBranches_);
+      bytes += fillTTree(unclonedReadBranches_);
     } else {
-      tree_->Fill();
+      bytes = tree_->Fill();
+    }
+    if(sizeAccounting_) {
+      entrySizes_.add(currentlyFastCloning_ ? bytes + clonedBytesPerEntry_ : bytes);
+    }
+    if(adaptiveClusteringEvents_ != 0U && tree_->GetEntries() >= adaptiveClusteringEvents_) {
+      adaptClustering();
+    }
+  }
+
+  namespace {
+    // sets the basket size of the branch, and of its sub-branches, to hold nEntries entries of its measured size
+    void setBasketSizes(TBranch* branch, Long64_t nMeasured, Long64_t nEntries, Int_t minSize, Int_t maxSize) {
+      Long64_t size = branch->GetTotBytes() * nEntries / nMeasured;
+      branch->SetBasketSize(static_cast<Int_t>(std::min<Long64_t>(std::max<Long64_t>(size, minSize), maxSize)));
+      TObjArray* subBranches = branch->GetListOfBranches();
+      for(int i = 0, n = subBranches->GetEntriesFast(); i < n; ++i) {
+        setBasketSizes(static_cast<TBranch*>(subBranches->At(i)), nMeasured, nEntries, minSize, maxSize);
+      }
+    }
+  }
+
+  void
+  RootOutputTree::adaptClustering() {
+    adaptiveClusteringEvents_ = 0U;
+    if(currentlyFastCloning_) {
+      // the clusters of the cloned baskets are inherited from the input file
+      return;
+    }
+    // write out the baskets of the measured events, so that their compressed size is known
+    tree_->FlushBaskets();
+    Long64_t const nMeasured = tree_->GetEntries();
+    Long64_t const zipBytes = tree_->GetZipBytes();
+    if(nMeasured == 0 || zipBytes <= 0) return;
+
+    Long64_t const autoFlush = std::max<Long64_t>(1LL, targetClusterSize_ * nMeasured / zipBytes);
+    Int_t const minBasketSize = 16 * 1024;
+    Int_t const maxBasketSize = static_cast<Int_t>(std::min<Long64_t>(std::max<Long64_t>(targetClusterSize_, minBasketSize),
+                                                                     std::numeric_limits<Int_t>::max()));
+    TObjArray* branches = tree_->GetListOfBranches();
+    for(int i = 0, n = branches->GetEntriesFast(); i < n; ++i) {
+      setBasketSizes(static_cast<TBranch*>(branches->At(i)), nMeasured, autoFlush, minBasketSize, maxBasketSize);
+    }
+    tree_->SetAutoFlush(autoFlush);
+
+    // the basket sizes are stored with the branches, the interval and its target are stored here
+    tree_->GetUserInfo()->Add(new TParameter<Long64_t>("AdaptiveClusteringAutoFlush", autoFlush));
+    tree_->GetUserInfo()->Add(new TParameter<Long64_t>("AdaptiveClusteringTargetSize", targetClusterSize_));
+    LogInfo("RootOutputTree") << "Tree " << tree_->GetName() << ": " << zipBytes << " compressed bytes in the first "
+                              << nMeasured << " entries, flushing every " << autoFlush << " entries.";
+  }
+
+  Long64_t
+  RootOutputTree::branchTotBytes() const {
+    Long64_t bytes = 0;
+    TObjArray* branches = tree_->GetListOfBranches();
+    for(int i = 0, n = branches->GetEntriesFast(); i < n; ++i) {
+      bytes += static_cast<TBranch*>(branches->At(i))->GetTotBytes("*");
+    }
+    return bytes;
+  }
+
+  std::vector<RootOutputTree::BranchSize>
+  RootOutputTree::branchSizes() const {
+    std::vector<BranchSize> sizes;
+    TObjArray* branches = tree_->GetListOfBranches();
+    sizes.reserve(branches->GetEntriesFast());
+    for(int i = 0, n = branches->GetEntriesFast(); i < n; ++i) {
+      TBranch* branch = static_cast<TBranch*>(branches->At(i));
+      sizes.push_back(BranchSize{branch->GetName(), branch->GetTotBytes("*"), branch->GetZipBytes("*")});
     }
+    return sizes;
   }
 
   void
@@ -7,6 +7,7 @@ RootOutputTree.h // used by ROOT output modules
 
 ----------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -23,10 +24,37 @@ class TBranch;
 namespace edm {
   class RootOutputTree {
   public:
+    // the bytes of a top level branch, with its sub-branches
+    struct BranchSize {
+      std::string name_;
+      Long64_t totBytes_; // uncompressed
+      Long64_t zipBytes_; // compressed, of the baskets written so far
+    };
+
+    // the uncompressed bytes of the entries filled; with fast cloning, the
+    // bytes of the cloned branches are shared evenly by the cloned entries
+    struct EntrySizes {
+      EntrySizes() : entries_(0), bytes_(0), maxBytes_(0) {}
+      void add(Long64_t bytes) {
+        ++entries_;
+        bytes_ += bytes;
+        maxBytes_ = std::max(maxBytes_, bytes);
+      }
+      void add(EntrySizes const& sizes) {
+        entries_ += sizes.entries_;
+        bytes_ += sizes.bytes_;
+        maxBytes_ = std::max(maxBytes_, sizes.maxBytes_);
+      }
+      Long64_t entries_;
+      Long64_t bytes_;
+      Long64_t maxBytes_;
+    };
+
     RootOutputTree(std::shared_ptr<TFile> filePtr,
                    BranchType const& branchType,
                    int splitLevel,
-                   int treeMaxVirtualSize);
+                   int treeMaxVirtualSize,
+                   bool concurrentFill = false);
 
     ~RootOutputTree() {}
 
@@ -61,6 +89,9 @@ namespace edm {
 
     static void writeTTree(TTree* tree);
 
+    // true if ROOT implicit multi-threading is enabled, which makes concurrent filling of branches safe
+    static bool concurrentFillAvailable();
+
     bool isValid() const;
 
     void addBranch(std::string const& branchName,
@@ -108,8 +139,32 @@ namespace edm {
     void setAutoFlush(Long64_t size) {
       tree_->SetAutoFlush(size);
     }
+
+    // after nEvents entries, choose the basket sizes and the auto flush interval from the measured
+    // branch sizes, so that the clusters have about targetClusterSize compressed bytes
+    void enableAdaptiveClustering(unsigned int nEvents, Long64_t targetClusterSize) {
+      adaptiveClusteringEvents_ = nEvents;
+      targetClusterSize_ = targetClusterSize;
+    }
+
+    // keep the sizes of the entries filled, for takeEntrySizes()
+    void enableSizeAccounting() {
+      sizeAccounting_ = true;
+    }
+
+    // the sizes of the entries filled since the last call
+    EntrySizes takeEntrySizes() {
+      EntrySizes sizes = entrySizes_;
+      entrySizes_ = EntrySizes();
+      return sizes;
+    }
+
+    std::vector<BranchSize> branchSizes() const;
   private:
-    static void fillTTree(std::vector<TBranch*> const& branches);
+    void adaptClustering();
+    Long64_t branchTotBytes() const;
+    static Long64_t fillTTree(std::vector<TBranch*> const& branches);
+    static Long64_t fillTTreeConcurrently(std::vector<TBranch*> const& branches);
 // We use bare pointers for pointers to some ROOT entities.
 // Root owns them and uses bare pointers internally.
 // Therefore, using smart pointers here will do no good.
@@ -125,6 +180,12 @@ namespace edm {
     std::set<std::string> clonedReadBranchNames_;
     bool currentlyFastCloning_;
     bool fastCloneAuxBranches_;
+    bool concurrentFill_;
+    unsigned int adaptiveClusteringEvents_;
+    Long64_t targetClusterSize_;
+    bool sizeAccounting_;
+    EntrySizes entrySizes_;
+    Long64_t clonedBytesPerEntry_;
   };
 }
 #endif
@@ -9,18 +9,19 @@ namespace edm {
   }
   
   TimeoutPoolOutputModule::TimeoutPoolOutputModule(ParameterSet const& ps):
-      edm::one::OutputModuleBase::OutputModuleBase(ps),
+      edm::global::OutputModuleBase::OutputModuleBase(ps),
       PoolOutputModule(ps), 
+      m_mutex(),
       m_lastEvent(time(NULL)),
       eventsWrittenInCurrentFile(0),
       m_timeout(-1) // we want the first event right away
   {  }
 
   bool TimeoutPoolOutputModule::shouldWeCloseFile() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
     time_t now(time(NULL));
     if ( PoolOutputModule::shouldWeCloseFile() ) {
-      edm::LogVerbatim("TimeoutPoolOutputModule")  <<" Closing file "<< currentFileName()<< " with "<< eventsWrittenInCurrentFile  <<" events.";
-      eventsWrittenInCurrentFile = 0;
+      edm::LogVerbatim("TimeoutPoolOutputModule")  <<" Closing file "<< currentFileName()<< " with "<< eventsWrittenInCurrentFile.exchange(0)  <<" events.";
       m_lastEvent = now;
       return true;
     }
@@ -33,8 +34,7 @@ namespace edm {
     if (m_timeout == 15) m_timeout = 30;
     if (m_timeout == -1) m_timeout = 15;
     
-    edm::LogVerbatim("TimeoutPoolOutputModule")  <<" Closing file "<< currentFileName()<< " with "<< eventsWrittenInCurrentFile  <<" events.";
-    eventsWrittenInCurrentFile = 0;
+    edm::LogVerbatim("TimeoutPoolOutputModule")  <<" Closing file "<< currentFileName()<< " with "<< eventsWrittenInCurrentFile.exchange(0)  <<" events.";
     return true;
   }
 }
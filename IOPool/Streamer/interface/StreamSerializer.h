@@ -65,6 +65,15 @@ namespace edm
   class ModuleCallingContext;
   class ThinnedAssociationsHelper;
 
+  // Compression of the event data. The readers recognise the algorithm from the
+  // frame header of the data, so the message format is the same for all of them.
+  enum StreamerCompressionAlgo {
+    UNCOMPRESSED,
+    ZLIB,
+    LZ4,
+    ZSTD
+  };
+
   class StreamSerializer
   {
 
@@ -77,8 +86,8 @@ namespace edm
                           ThinnedAssociationsHelper const& thinnedAssociationsHelper);
 
     int serializeEvent(EventForOutput const& event, ParameterSetID const& selectorConfig,
-                       bool use_compression, int compression_level,
-                       SerializeDataBuffer &data_buffer);
+                       StreamerCompressionAlgo compression_algo, int compression_level,
+                       SerializeDataBuffer &data_buffer) const;
 
     /**
      * Compresses the data in the specified input buffer into the
@@ -90,6 +99,16 @@ namespace edm
                                        std::vector<unsigned char> &outputBuffer,
                                        int compressionLevel);
 
+    static unsigned int compressBufferLZ4(unsigned char *inputBuffer,
+                                          unsigned int inputSize,
+                                          std::vector<unsigned char> &outputBuffer,
+                                          int compressionLevel);
+
+    static unsigned int compressBufferZSTD(unsigned char *inputBuffer,
+                                           unsigned int inputSize,
+                                           std::vector<unsigned char> &outputBuffer,
+                                           int compressionLevel);
+
   private:
 
     SelectedProducts const* selections_;
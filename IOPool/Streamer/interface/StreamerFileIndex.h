@@ -0,0 +1,68 @@
+#ifndef IOPool_Streamer_StreamerFileIndex_h
+#define IOPool_Streamer_StreamerFileIndex_h
+
+/**
+StreamerFileIndex: index of the events of a streamer file.
+
+The index is written next to the streamer file, in a sidecar file named after
+it with an ".idx" suffix, and holds the run, lumi and event numbers and the
+position of each event message.  Readers use it to go directly to the events
+they want instead of scanning the whole file.  The index records the size of
+the streamer file it describes, and is ignored when the file size differs.
+*/
+
+#include "IOPool/Streamer/interface/MsgTools.h"
+
+#include <string>
+#include <vector>
+
+// as it is in the index file
+struct StreamerIndexHeader
+{
+  char magic_[8];
+  char_uint64 dataSize_; // of the streamer file
+  char_uint64 entries_;
+};
+
+struct StreamerIndexRecord
+{
+  char_uint32 run_;
+  char_uint32 lumi_;
+  char_uint64 event_;
+  char_uint64 offset_; // of the event message in the streamer file
+  char_uint32 size_;   // of the event message
+};
+
+struct StreamerIndexEntry
+{
+  uint32 run;
+  uint32 lumi;
+  uint64 event;
+  uint64 offset;
+  uint32 size;
+};
+
+class StreamerFileIndex
+{
+public:
+  typedef std::vector<StreamerIndexEntry> Entries;
+
+  /// Name of the index of the streamer file @a fileName.
+  static std::string indexFileName(std::string const& fileName) { return fileName + ".idx"; }
+
+  void add(uint32 run, uint32 lumi, uint64 event, uint64 offset, uint32 size);
+  void clear() { entries_.clear(); }
+  Entries const& entries() const { return entries_; }
+
+  /// Writes the index for a streamer file of @a dataSize bytes; throws on failure.
+  void write(std::string const& indexName, uint64 dataSize) const;
+
+  /// Reads the index of the streamer file @a fileName, of @a dataSize bytes.
+  /// Returns false, leaving the index empty, if there is no valid index for it.
+  bool read(std::string const& fileName, uint64 dataSize);
+
+private:
+  Entries entries_;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include "IOPool/Streamer/interface/InitMessage.h"
 #include "IOPool/Streamer/interface/EventMessage.h"
 #include "IOPool/Streamer/interface/MsgTools.h"
+#include "IOPool/Streamer/interface/StreamerFileIndex.h"
 #include "Utilities/StorageFactory/interface/IOTypes.h"
 #include "Utilities/StorageFactory/interface/Storage.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
@@ -20,11 +21,13 @@ namespace edm {
 
     /**Reads a Streamer file */
     explicit StreamerInputFile(std::string const& name,
-      std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>());
+      std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>(),
+      bool useIndex = false);
 
     /** Multiple Streamer files */
     explicit StreamerInputFile(std::vector<std::string> const& names,
-      std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>());
+      std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>(),
+      bool useIndex = false);
 
     ~StreamerInputFile();
 
@@ -38,6 +41,13 @@ namespace edm {
 
     bool newHeader() { bool tmp = newHeader_; newHeader_ = false; return tmp;}  /** Test bit if a new header is encountered */
 
+    StreamerFileIndex const* index() const { return indexed_ ? &index_ : nullptr; }
+    /** Index of the current file, if it has one and useIndex was requested */
+
+    bool skipWithIndex();
+    /** Skips the next event of the current file without reading it, if the file is indexed.
+        Returns false if it could not, e.g. at the end of the file */
+
     /// Needs to be public because of forking.
     void closeStreamerFile();
 
@@ -46,6 +56,8 @@ namespace edm {
     void openStreamerFile(std::string const& name);
     IOSize readBytes(char* buf, IOSize nBytes);
     IOOffset skipBytes(IOSize nBytes);
+    void seekToEntry(StreamerIndexEntry const& entry);
+    bool nextIndexEntry();
 
     void readStartMessage();
     int readEventMessage();
@@ -79,6 +91,11 @@ namespace edm {
     edm::propagate_const<std::unique_ptr<Storage>> storage_;
 
     bool endOfFile_;
+
+    bool useIndex_;
+    bool indexed_;
+    StreamerFileIndex index_;
+    size_t indexPos_; /** next entry of the index to read */
   };
 }
 
@@ -61,6 +61,19 @@ namespace edm {
                                          unsigned int inputSize,
                                          std::vector<unsigned char>& outputBuffer,
                                          unsigned int expectedFullSize);
+
+    // The compressed data is a LZ4 or ZSTD frame, as opposed to a zlib stream.
+    static bool isBufferLZ4(unsigned char const* inputBuffer, unsigned int inputSize);
+    static bool isBufferZSTD(unsigned char const* inputBuffer, unsigned int inputSize);
+
+    static unsigned int uncompressBufferLZ4(unsigned char* inputBuffer,
+                                            unsigned int inputSize,
+                                            std::vector<unsigned char>& outputBuffer,
+                                            unsigned int expectedFullSize);
+    static unsigned int uncompressBufferZSTD(unsigned char* inputBuffer,
+                                             unsigned int inputSize,
+                                             std::vector<unsigned char>& outputBuffer,
+                                             unsigned int expectedFullSize);
   protected:
     static void declareStreamers(SendDescs const& descs);
     static void buildClassCache(SendDescs const& descs);
@@ -36,7 +36,7 @@ namespace edm {
 
   template<typename Consumer>
   StreamerOutputModule<Consumer>::StreamerOutputModule(ParameterSet const& ps) :
-    edm::one::OutputModuleBase::OutputModuleBase(ps),
+    edm::global::OutputModuleBase::OutputModuleBase(ps),
     StreamerOutputModuleBase(ps),
     c_(new Consumer(ps))
     {
@@ -1,11 +1,13 @@
 #ifndef IOPool_Streamer_StreamerOutputModuleBase_h
 #define IOPool_Streamer_StreamerOutputModuleBase_h
 
-#include "FWCore/Framework/interface/one/OutputModule.h"
+#include "FWCore/Framework/interface/global/OutputModule.h"
+#include "FWCore/Concurrency/interface/SerialTaskQueue.h"
 #include "FWCore/Utilities/interface/EDGetToken.h"
 #include "IOPool/Streamer/interface/MsgTools.h"
 #include "IOPool/Streamer/interface/StreamSerializer.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 class InitMsgBuilder;
@@ -15,15 +17,25 @@ namespace edm {
 
   typedef detail::TriggerResultsBasedEventSelector::handle_t Trig;
 
-  class StreamerOutputModuleBase : public one::OutputModule<one::WatchRuns, one::WatchLuminosityBlocks> {
+  // Events are serialized and compressed concurrently by the streams, each into
+  // its own buffer; only the output of the messages, the runs and the luminosity
+  // blocks is done one at a time, from a serial queue.
+  class StreamerOutputModuleBase : public global::OutputModule<> {
   public:
     explicit StreamerOutputModuleBase(ParameterSet const& ps);
     virtual ~StreamerOutputModuleBase();
     static void fillDescription(ParameterSetDescription & desc);
 
   private:
-    virtual void beginRun(RunForOutput const&) override;
-    virtual void endRun(RunForOutput const&) override;
+    virtual void preallocStreams(unsigned int nStreams) override;
+    virtual void doBeginRun_(RunForOutput const&) override;
+    virtual void doEndRun_(RunForOutput const&) override;
+    virtual void doBeginLuminosityBlock_(LuminosityBlockForOutput const&) override;
+    virtual void doEndLuminosityBlock_(LuminosityBlockForOutput const&) override;
+    virtual void beginRun(RunForOutput const&);
+    virtual void endRun(RunForOutput const&);
+    virtual void beginLuminosityBlock(LuminosityBlockForOutput const&) {}
+    virtual void endLuminosityBlock(LuminosityBlockForOutput const&) {}
     virtual void beginJob() override;
     virtual void endJob() override;
     virtual void writeRun(RunForOutput const&) override;
@@ -36,10 +48,10 @@ namespace edm {
     virtual void doOutputEvent(EventMsgBuilder const& msg) = 0;
 
     std::unique_ptr<InitMsgBuilder> serializeRegistry();
-    std::unique_ptr<EventMsgBuilder> serializeEvent(EventForOutput const& e); 
+    std::unique_ptr<EventMsgBuilder> serializeEvent(EventForOutput const& e, SerializeDataBuffer& sbuf) const;
     Trig getTriggerResults(EDGetTokenT<TriggerResults> const& token, EventForOutput const& e) const;
-    void setHltMask(EventForOutput const& e);
-    void setLumiSection();
+    void setHltMask(EventForOutput const& e, std::vector<unsigned char>& hltbits) const;
+    uint32 lumiSection() const;
 
   private:
     SelectedProducts const* selections_;
@@ -47,6 +59,7 @@ namespace edm {
     int maxEventSize_;
     bool useCompression_;
     int compressionLevel_;
+    StreamerCompressionAlgo compressionAlgo_;
 
     // test luminosity sections
     int lumiSectionInterval_;  
@@ -54,13 +67,15 @@ namespace edm {
 
     StreamSerializer serializer_;
 
+    // used for the INIT message
     SerializeDataBuffer serializeDataBuffer_;
+    // one per stream, re-used for all its events
+    std::vector<std::unique_ptr<SerializeDataBuffer>> streamDataBuffers_;
+
+    // serializes the output of the messages, runs and luminosity blocks
+    SerialTaskQueue outputQueue_;
 
-    //Event variables, made class memebers to avoid re instatiation for each event.
     unsigned int hltsize_;
-    uint32 lumi_;
-    std::vector<bool> l1bit_;
-    std::vector<unsigned char> hltbits_;
     uint32 origSize_;
     char host_name_[255];
 
@@ -22,8 +22,11 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
 #include "zlib.h"
+#include "lz4frame.h"
+#include "zstd.h"
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -127,8 +130,8 @@ namespace edm {
    */
   int StreamSerializer::serializeEvent(EventForOutput const& event,
                                        ParameterSetID const& selectorConfig,
-                                       bool use_compression, int compression_level,
-                                       SerializeDataBuffer& data_buffer) {
+                                       StreamerCompressionAlgo compression_algo, int compression_level,
+                                       SerializeDataBuffer& data_buffer) const {
     Parentage parentage;
 
     EventSelectionIDVector selectionIDs = event.eventSelectionIDs();
@@ -204,9 +207,21 @@ namespace edm {
     // compress before return if we need to
     // should test if compressed already - should never be?
     //   as double compression can have problems
-    if(use_compression) {
-      unsigned int dest_size =
-        compressBuffer(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+    if(compression_algo != UNCOMPRESSED) {
+      unsigned int dest_size = 0;
+      switch(compression_algo) {
+        case ZLIB:
+          dest_size = compressBuffer(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+          break;
+        case LZ4:
+          dest_size = compressBufferLZ4(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+          break;
+        case ZSTD:
+          dest_size = compressBufferZSTD(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+          break;
+        default:
+          break;
+      }
       if(dest_size != 0) {
         data_buffer.ptr_ = &data_buffer.comp_buf_[0]; // reset to point at compressed area
         data_buffer.curr_space_used_ = dest_size;
@@ -260,4 +275,63 @@ namespace edm {
 
     return resultSize;
   }
+
+  /**
+   * Compresses the data in the specified input buffer into the
+   * specified output buffer as a LZ4 frame.  Returns the size of the
+   * compressed data or zero if compression failed.
+   */
+  unsigned int
+  StreamSerializer::compressBufferLZ4(unsigned char *inputBuffer,
+                                      unsigned int inputSize,
+                                      std::vector<unsigned char> &outputBuffer,
+                                      int compressionLevel) {
+    LZ4F_preferences_t preferences;
+    memset(&preferences, 0, sizeof(preferences));
+    // levels above 2 select the slower, high compression, mode
+    preferences.compressionLevel = compressionLevel;
+    preferences.frameInfo.contentSize = inputSize;
+
+    size_t dest_size = LZ4F_compressFrameBound(inputSize, &preferences);
+    if(outputBuffer.size() < dest_size) outputBuffer.resize(dest_size);
+
+    size_t ret = LZ4F_compressFrame(&outputBuffer[0], dest_size, inputBuffer, inputSize, &preferences);
+    if(LZ4F_isError(ret)) {
+      FDEBUG(9) << "LZ4 compression error: " << LZ4F_getErrorName(ret) << std::endl;
+      std::cerr << "LZ4 compression error: " << LZ4F_getErrorName(ret) << std::endl;
+      return 0;
+    }
+    FDEBUG(1) << " original size = " << inputSize
+              << " final size = " << ret
+              << " ratio = " << double(ret)/double(inputSize)
+              << std::endl;
+    return ret;
+  }
+
+  /**
+   * Compresses the data in the specified input buffer into the
+   * specified output buffer as a ZSTD frame.  Returns the size of the
+   * compressed data or zero if compression failed.
+   */
+  unsigned int
+  StreamSerializer::compressBufferZSTD(unsigned char *inputBuffer,
+                                       unsigned int inputSize,
+                                       std::vector<unsigned char> &outputBuffer,
+                                       int compressionLevel) {
+    size_t dest_size = ZSTD_compressBound(inputSize);
+    if(outputBuffer.size() < dest_size) outputBuffer.resize(dest_size);
+
+    // the frame records the original size, which the readers check
+    size_t ret = ZSTD_compress(&outputBuffer[0], dest_size, inputBuffer, inputSize, compressionLevel);
+    if(ZSTD_isError(ret)) {
+      FDEBUG(9) << "ZSTD compression error: " << ZSTD_getErrorName(ret) << std::endl;
+      std::cerr << "ZSTD compression error: " << ZSTD_getErrorName(ret) << std::endl;
+      return 0;
+    }
+    FDEBUG(1) << " original size = " << inputSize
+              << " final size = " << ret
+              << " ratio = " << double(ret)/double(inputSize)
+              << std::endl;
+    return ret;
+  }
 }
@@ -0,0 +1,80 @@
+#include "IOPool/Streamer/interface/StreamerFileIndex.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "Utilities/StorageFactory/interface/IOFlags.h"
+#include "Utilities/StorageFactory/interface/Storage.h"
+#include "Utilities/StorageFactory/interface/StorageFactory.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+namespace {
+  const char s_magic[8] = { 'C','M','S','S','T','I','X','1' };
+}
+
+void StreamerFileIndex::add(uint32 run, uint32 lumi, uint64 event, uint64 offset, uint32 size)
+{
+  StreamerIndexEntry entry = { run, lumi, event, offset, size };
+  entries_.push_back(entry);
+}
+
+void StreamerFileIndex::write(std::string const& indexName, uint64 dataSize) const
+{
+  std::vector<StreamerIndexRecord> records(entries_.size());
+  for (size_t i = 0; i != entries_.size(); ++i) {
+    convert(entries_[i].run, records[i].run_);
+    convert(entries_[i].lumi, records[i].lumi_);
+    convert(entries_[i].event, records[i].event_);
+    convert(entries_[i].offset, records[i].offset_);
+    convert(entries_[i].size, records[i].size_);
+  }
+  StreamerIndexHeader header;
+  memcpy(header.magic_, s_magic, sizeof(s_magic));
+  convert(dataSize, header.dataSize_);
+  convert((uint64) entries_.size(), header.entries_);
+
+  // write to a temporary name and rename, so that readers never see a partial index
+  std::string tmpName = indexName + ".tmp";
+  std::ofstream ost(tmpName.c_str(), std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+  ost.write((const char*) &header, sizeof(header));
+  if (!records.empty())
+    ost.write((const char*) &records[0], records.size() * sizeof(StreamerIndexRecord));
+  ost.close();
+  if (ost.fail() || ::rename(tmpName.c_str(), indexName.c_str()) != 0) {
+    throw cms::Exception("OutputFile", "StreamerFileIndex::write")
+      << "Error writing streamer index file " << indexName << ".  Possibly the output disk "
+      << "is full?" << std::endl;
+  }
+}
+
+bool StreamerFileIndex::read(std::string const& fileName, uint64 dataSize)
+{
+  entries_.clear();
+  std::string indexName = indexFileName(fileName);
+  IOOffset size = -1;
+  if (!StorageFactory::get()->check(indexName, &size) || size < (IOOffset) sizeof(StreamerIndexHeader))
+    return false;
+
+  std::unique_ptr<Storage> storage = StorageFactory::get()->open(indexName, IOFlags::OpenRead);
+  std::vector<char> buf(size);
+  IOSize nGot = storage->read(&buf[0], size, 0);
+  storage->close();
+  if (nGot != (IOSize) size)
+    return false;
+
+  StreamerIndexHeader* header = (StreamerIndexHeader*) &buf[0];
+  uint64 entries = convert64(header->entries_);
+  if (memcmp(header->magic_, s_magic, sizeof(s_magic)) != 0
+      || convert64(header->dataSize_) != dataSize
+      || sizeof(StreamerIndexHeader) + entries * sizeof(StreamerIndexRecord) != (uint64) size)
+    return false;
+
+  StreamerIndexRecord* records = (StreamerIndexRecord*) &buf[sizeof(StreamerIndexHeader)];
+  entries_.reserve(entries);
+  for (uint64 i = 0; i != entries; ++i) {
+    add(convert32(records[i].run_), convert32(records[i].lumi_), convert64(records[i].event_),
+        convert64(records[i].offset_), convert32(records[i].size_));
+  }
+  return true;
+}
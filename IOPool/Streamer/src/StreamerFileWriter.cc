@@ -4,12 +4,18 @@
 namespace edm {
   StreamerFileWriter::StreamerFileWriter(edm::ParameterSet const& ps) :
     stream_writer_(new StreamerOutputFile(
-                      ps.getUntrackedParameter<std::string>("fileName")))
+                      ps.getUntrackedParameter<std::string>("fileName"))),
+    fileName_(ps.getUntrackedParameter<std::string>("fileName")),
+    writeIndex_(ps.getUntrackedParameter<bool>("writeIndex")),
+    index_()
   {
   }
 
   StreamerFileWriter::StreamerFileWriter(std::string const& fileName) :
-    stream_writer_(new StreamerOutputFile(fileName))
+    stream_writer_(new StreamerOutputFile(fileName)),
+    fileName_(fileName),
+    writeIndex_(false),
+    index_()
   {
   }
 
@@ -29,7 +35,15 @@ namespace edm {
 
   void StreamerFileWriter::doOutputEvent(EventMsgView const& msg) {
     //Write the Event Message to Streamer file
-    stream_writer_->write(msg);
+    uint64 offset = stream_writer_->write(msg);
+    // the offsets of the output file start at 1
+    if(writeIndex_) index_.add(msg.run(), msg.lumi(), msg.event(), offset - 1, msg.size());
+  }
+
+  void StreamerFileWriter::stop() {
+    // called at the end of each run and of the job: the index always covers
+    // all the events written so far
+    if(writeIndex_) index_.write(StreamerFileIndex::indexFileName(fileName_), stream_writer_->currentOffset() - 1);
   }
 
   void StreamerFileWriter::doOutputEvent(EventMsgBuilder const& msg) {
@@ -40,5 +54,8 @@ namespace edm {
   void StreamerFileWriter::fillDescription(ParameterSetDescription& desc) {
     desc.setComment("Writes events into a streamer output file.");
     desc.addUntracked<std::string>("fileName", "teststreamfile.dat")->setComment("Name of output file.");
+    desc.addUntracked<bool>("writeIndex", false)
+        ->setComment("If True, write next to the output file an index of its events, named after it with an '.idx' suffix.\n"
+                     "Readers use it to seek directly to the events they process.");
   }
 } //namespace edm
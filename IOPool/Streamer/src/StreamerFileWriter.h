@@ -4,6 +4,7 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
 #include "IOPool/Streamer/interface/StreamerOutputFile.h"
+#include "IOPool/Streamer/interface/StreamerFileIndex.h"
 #include "IOPool/Streamer/interface/InitMsgBuilder.h"
 #include "IOPool/Streamer/interface/EventMsgBuilder.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
@@ -36,13 +37,16 @@ namespace edm
     void doOutputEvent(EventMsgView const& msg);
 
     void start(){}
-    void stop(){};
+    void stop();
 
     uint32 get_adler32() const { return stream_writer_->adler32();}
 
   private:
 
     edm::propagate_const<std::unique_ptr<StreamerOutputFile>> stream_writer_;
+    std::string fileName_;
+    bool writeIndex_;
+    StreamerFileIndex index_;
 
   };
 }
@@ -20,7 +20,8 @@ namespace edm {
   }
 
   StreamerInputFile::StreamerInputFile(std::string const& name,
-                                       std::shared_ptr<EventSkipperByID> eventSkipperByID) :
+                                       std::shared_ptr<EventSkipperByID> eventSkipperByID,
+                                       bool useIndex) :
     startMsg_(),
     currentEvMsg_(),
     headerBuf_(1000*1000),
@@ -35,13 +36,18 @@ namespace edm {
     currProto_(0),
     newHeader_(false),
     storage_(),
-    endOfFile_(false) {
+    endOfFile_(false),
+    useIndex_(useIndex),
+    indexed_(false),
+    index_(),
+    indexPos_(0) {
     openStreamerFile(name);
     readStartMessage();
   }
 
   StreamerInputFile::StreamerInputFile(std::vector<std::string> const& names,
-                                       std::shared_ptr<EventSkipperByID> eventSkipperByID) :
+                                       std::shared_ptr<EventSkipperByID> eventSkipperByID,
+                                       bool useIndex) :
     startMsg_(),
     currentEvMsg_(),
     headerBuf_(1000*1000),
@@ -55,7 +61,11 @@ namespace edm {
     currRun_(0),
     currProto_(0),
     newHeader_(false),
-    endOfFile_(false) {
+    endOfFile_(false),
+    useIndex_(useIndex),
+    indexed_(false),
+    index_(),
+    indexPos_(0) {
     openStreamerFile(names.at(0));
     ++currentFile_;
     readStartMessage();
@@ -91,6 +101,19 @@ namespace edm {
     }
     currentFileOpen_ = true;
     logFileAction("  Successfully opened file ");
+
+    indexed_ = false;
+    indexPos_ = 0;
+    if(useIndex_) {
+      try {
+        indexed_ = index_.read(name, size);
+      }
+      catch(cms::Exception& e) {
+        // the index is an optimisation: fall back to reading the file sequentially
+        LogWarning("StreamerInputFile") << "Could not read the index of " << name << ":\n" << e.what();
+      }
+      if(indexed_) logFileAction("  Using the index of file ");
+    }
   }
 
   void
@@ -130,6 +153,35 @@ namespace edm {
     return n;
   }
 
+  void StreamerInputFile::seekToEntry(StreamerIndexEntry const& entry) {
+    try {
+      storage_->position(entry.offset);
+    }
+    catch(cms::Exception& ce) {
+      Exception ex(errors::FileReadError, "", ce);
+      ex.addContext("Calling StreamerInputFile::seekToEntry()");
+      throw ex;
+    }
+  }
+
+  // Moves to the next entry of the index that is not skipped, and seeks to its event.
+  bool StreamerInputFile::nextIndexEntry() {
+    StreamerFileIndex::Entries const& entries = index_.entries();
+    while(indexPos_ < entries.size() && eventSkipperByID_ &&
+          eventSkipperByID_->skipIt(entries[indexPos_].run, entries[indexPos_].lumi, entries[indexPos_].event)) {
+      ++indexPos_;
+    }
+    if(indexPos_ == entries.size()) return false;
+    seekToEntry(entries[indexPos_]);
+    return true;
+  }
+
+  bool StreamerInputFile::skipWithIndex() {
+    if(!indexed_ || endOfFile_ || !nextIndexEntry()) return false;
+    ++indexPos_;
+    return true;
+  }
+
   void StreamerInputFile::readStartMessage() {
     IOSize nWant = sizeof(HeaderView);
     IOSize nGot = readBytes(&headerBuf_[0], nWant);
@@ -224,6 +276,15 @@ namespace edm {
   int StreamerInputFile::readEventMessage() {
     if(endOfFile_) return 0;
 
+    if(indexed_) {
+      // go directly to the next event to read
+      if(!nextIndexEntry()) {
+        endOfFile_ = true;
+        return 0;
+      }
+      ++indexPos_;
+    }
+
     bool eventRead = false;
     while(!eventRead) {
 
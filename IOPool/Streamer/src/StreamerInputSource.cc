@@ -17,6 +17,8 @@
 #include "DataFormats/Provenance/interface/ThinnedAssociationsHelper.h"
 
 #include "zlib.h"
+#include "lz4frame.h"
+#include "zstd.h"
 
 #include "DataFormats/Common/interface/RefCoreStreamer.h"
 #include "FWCore/Utilities/interface/WrappedClassName.h"
@@ -31,6 +33,7 @@
 #include "DataFormats/Provenance/interface/ProcessHistoryRegistry.h"
 #include "FWCore/Utilities/interface/DebugMacros.h"
 
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <set>
@@ -38,6 +41,13 @@
 namespace edm {
   namespace {
     int const init_size = 1024*1024;
+
+    // little-endian magic numbers starting the frames; a zlib stream starts with 0x78
+    bool hasMagic(unsigned char const* inputBuffer, unsigned int inputSize, uint32_t magic) {
+      if(inputSize < 4) return false;
+      uint32_t value = inputBuffer[0] | (inputBuffer[1] << 8) | (inputBuffer[2] << 16) | ((uint32_t)inputBuffer[3] << 24);
+      return value == magic;
+    }
   }
 
   StreamerInputSource::StreamerInputSource(
@@ -229,8 +239,14 @@ namespace edm {
     }
     if(origsize != 78 && origsize != 0) {
       // compressed
-      dest_size = uncompressBuffer(const_cast<unsigned char*>((unsigned char const*)eventView.eventData()),
-                                   eventView.eventLength(), dest_, origsize);
+      unsigned char* compressed = const_cast<unsigned char*>((unsigned char const*)eventView.eventData());
+      if(isBufferZSTD(compressed, eventView.eventLength())) {
+        dest_size = uncompressBufferZSTD(compressed, eventView.eventLength(), dest_, origsize);
+      } else if(isBufferLZ4(compressed, eventView.eventLength())) {
+        dest_size = uncompressBufferLZ4(compressed, eventView.eventLength(), dest_, origsize);
+      } else {
+        dest_size = uncompressBuffer(compressed, eventView.eventLength(), dest_, origsize);
+      }
     } else { // not compressed
       // we need to copy anyway the buffer as we are using dest in xbuf
       dest_size = eventView.eventLength();
@@ -372,6 +388,79 @@ namespace edm {
     return (unsigned int) uncompressedSize;
   }
 
+  bool
+  StreamerInputSource::isBufferLZ4(unsigned char const* inputBuffer, unsigned int inputSize) {
+    return hasMagic(inputBuffer, inputSize, 0x184D2204U);
+  }
+
+  bool
+  StreamerInputSource::isBufferZSTD(unsigned char const* inputBuffer, unsigned int inputSize) {
+    return hasMagic(inputBuffer, inputSize, 0xFD2FB528U);
+  }
+
+  /**
+   * Uncompresses the LZ4 frame in the specified input buffer into the
+   * specified output buffer, like uncompressBuffer.
+   */
+  unsigned int
+  StreamerInputSource::uncompressBufferLZ4(unsigned char* inputBuffer,
+                                           unsigned int inputSize,
+                                           std::vector<unsigned char>& outputBuffer,
+                                           unsigned int expectedFullSize) {
+    outputBuffer.resize(expectedFullSize);
+    LZ4F_decompressionContext_t context;
+    size_t ret = LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+    if(LZ4F_isError(ret)) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+          << "LZ4 error: " << LZ4F_getErrorName(ret) << "\n ";
+    }
+    size_t uncompressedSize = 0;
+    size_t consumed = 0;
+    do {
+      size_t srcSize = inputSize - consumed;
+      size_t dstSize = outputBuffer.size() - uncompressedSize;
+      ret = LZ4F_decompress(context, &outputBuffer[0] + uncompressedSize, &dstSize,
+                            inputBuffer + consumed, &srcSize, nullptr);
+      uncompressedSize += dstSize;
+      consumed += srcSize;
+      // a hint of zero marks the end of the frame
+    } while(!LZ4F_isError(ret) && ret != 0 && consumed < inputSize && uncompressedSize < outputBuffer.size());
+    LZ4F_freeDecompressionContext(context);
+    if(LZ4F_isError(ret)) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+          << "LZ4 error: " << LZ4F_getErrorName(ret) << "\n ";
+    }
+    if(ret != 0 || uncompressedSize != expectedFullSize) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+        << "mismatch event lengths should be" << expectedFullSize << " got "
+        << uncompressedSize << "\n";
+    }
+    return (unsigned int) uncompressedSize;
+  }
+
+  /**
+   * Uncompresses the ZSTD frame in the specified input buffer into the
+   * specified output buffer, like uncompressBuffer.
+   */
+  unsigned int
+  StreamerInputSource::uncompressBufferZSTD(unsigned char* inputBuffer,
+                                            unsigned int inputSize,
+                                            std::vector<unsigned char>& outputBuffer,
+                                            unsigned int expectedFullSize) {
+    outputBuffer.resize(expectedFullSize);
+    size_t uncompressedSize = ZSTD_decompress(&outputBuffer[0], expectedFullSize, inputBuffer, inputSize);
+    if(ZSTD_isError(uncompressedSize)) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+          << "ZSTD error: " << ZSTD_getErrorName(uncompressedSize) << "\n ";
+    }
+    if(uncompressedSize != expectedFullSize) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+        << "mismatch event lengths should be" << expectedFullSize << " got "
+        << uncompressedSize << "\n";
+    }
+    return (unsigned int) uncompressedSize;
+  }
+
   void StreamerInputSource::resetAfterEndRun() {
      // called from an online streamer source to reset after a stop command
      // so an enable command will work
@@ -5,9 +5,11 @@
 #include "IOPool/Streamer/interface/EventMsgBuilder.h"
 #include "FWCore/Framework/interface/EventForOutput.h"
 #include "FWCore/Framework/interface/EventSelector.h"
+#include "FWCore/Concurrency/interface/runInSerialTaskQueue.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/DebugMacros.h"
+#include "FWCore/Utilities/interface/EDMException.h"
 //#include "FWCore/Utilities/interface/Digest.h"
 #include "FWCore/Version/interface/GetReleaseVersion.h"
 #include "DataFormats/Common/interface/TriggerResults.h"
@@ -51,23 +53,32 @@ namespace {
     // std::cout << std::endl;
 
   }
+
+  edm::StreamerCompressionAlgo compressionAlgo(std::string const& name) {
+    if(name == "ZLIB") return edm::ZLIB;
+    if(name == "LZ4") return edm::LZ4;
+    if(name == "ZSTD") return edm::ZSTD;
+    throw edm::Exception(edm::errors::Configuration)
+      << "StreamerOutputModuleBase: unknown compression_algorithm '" << name << "'.\n"
+      << "Allowed values are ZLIB, LZ4 and ZSTD.\n";
+  }
 }
 
 namespace edm {
   StreamerOutputModuleBase::StreamerOutputModuleBase(ParameterSet const& ps) :
-    one::OutputModuleBase::OutputModuleBase(ps),
-    one::OutputModule<one::WatchRuns, one::WatchLuminosityBlocks>(ps),
+    global::OutputModuleBase::OutputModuleBase(ps),
+    global::OutputModule<>(ps),
     selections_(&keptProducts()[InEvent]),
     maxEventSize_(ps.getUntrackedParameter<int>("max_event_size")),
     useCompression_(ps.getUntrackedParameter<bool>("use_compression")),
     compressionLevel_(ps.getUntrackedParameter<int>("compression_level")),
+    compressionAlgo_(compressionAlgo(ps.getUntrackedParameter<std::string>("compression_algorithm"))),
     lumiSectionInterval_(ps.getUntrackedParameter<int>("lumiSection_interval")),
     serializer_(selections_),
     serializeDataBuffer_(),
+    streamDataBuffers_(),
+    outputQueue_(),
     hltsize_(0),
-    lumi_(0),
-    l1bit_(0),
-    hltbits_(0),
     origSize_(0),
     host_name_(),
     trToken_(consumes<edm::TriggerResults>(edm::InputTag("TriggerResults"))),
@@ -82,18 +93,20 @@ namespace edm {
     timeInSecSinceUTC = static_cast<double>(now.tv_sec) + (static_cast<double>(now.tv_usec)/1000000.0);
 
     if(useCompression_ == true) {
+      // zlib goes up to 9, LZ4 to 12 and ZSTD to 22
+      int const maxLevel = compressionAlgo_ == ZSTD ? 22 : (compressionAlgo_ == LZ4 ? 12 : 9);
       if(compressionLevel_ <= 0) {
         FDEBUG(9) << "Compression Level = " << compressionLevel_
                   << " no compression" << std::endl;
         compressionLevel_ = 0;
         useCompression_ = false;
-      } else if(compressionLevel_ > 9) {
+      } else if(compressionLevel_ > maxLevel) {
         FDEBUG(9) << "Compression Level = " << compressionLevel_
-                  << " using max compression level 9" << std::endl;
-        compressionLevel_ = 9;
+                  << " using max compression level " << maxLevel << std::endl;
+        compressionLevel_ = maxLevel;
       }
     }
-    serializeDataBuffer_.bufs_.resize(maxEventSize_);
+    if(!useCompression_) compressionAlgo_ = UNCOMPRESSED;
     int got_host = gethostname(host_name_, 255);
     if(got_host != 0) strncpy(host_name_, "noHostNameFoundOrTooLong", sizeof(host_name_));
     //loadExtraClasses();
@@ -105,6 +118,36 @@ namespace edm {
 
   StreamerOutputModuleBase::~StreamerOutputModuleBase() {}
 
+  void
+  StreamerOutputModuleBase::preallocStreams(unsigned int nStreams) {
+    streamDataBuffers_.reserve(nStreams);
+    for(unsigned int i = 0; i < nStreams; ++i) {
+      streamDataBuffers_.push_back(std::make_unique<SerializeDataBuffer>());
+      streamDataBuffers_.back()->bufs_.resize(maxEventSize_);
+    }
+  }
+
+  void
+  StreamerOutputModuleBase::doBeginRun_(RunForOutput const& r) {
+    runInSerialTaskQueue(outputQueue_, [this, &r]() { beginRun(r); });
+  }
+
+  void
+  StreamerOutputModuleBase::doEndRun_(RunForOutput const& r) {
+    runInSerialTaskQueue(outputQueue_, [this, &r]() { endRun(r); });
+  }
+
+  void
+  StreamerOutputModuleBase::doBeginLuminosityBlock_(LuminosityBlockForOutput const& lb) {
+    // events of the previous luminosity blocks may still be in flight
+    runInSerialTaskQueue(outputQueue_, [this, &lb]() { beginLuminosityBlock(lb); });
+  }
+
+  void
+  StreamerOutputModuleBase::doEndLuminosityBlock_(LuminosityBlockForOutput const& lb) {
+    runInSerialTaskQueue(outputQueue_, [this, &lb]() { endLuminosityBlock(lb); });
+  }
+
   void
   StreamerOutputModuleBase::beginRun(RunForOutput const&) {
     start();
@@ -124,7 +167,7 @@ namespace edm {
 
   void
   StreamerOutputModuleBase::endJob() {
-    stop();  // for closing of files, notify storage manager, etc.
+    runInSerialTaskQueue(outputQueue_, [this]() { stop(); });  // for closing of files, notify storage manager, etc.
   }
 
   void
@@ -135,8 +178,13 @@ namespace edm {
 
   void
   StreamerOutputModuleBase::write(EventForOutput const& e) {
-    std::unique_ptr<EventMsgBuilder> msg = serializeEvent(e);
-    doOutputEvent(*msg); // You can't use msg in StreamerOutputModuleBase after this point
+    // Called concurrently from all the streams: serialize and compress in the
+    // stream's own buffer, and only queue the output of the message.
+    SerializeDataBuffer& sbuf = *streamDataBuffers_[e.streamID().value()];
+    std::unique_ptr<EventMsgBuilder> msg = serializeEvent(e, sbuf);
+    runInSerialTaskQueue(outputQueue_, [this, &msg]() {
+      doOutputEvent(*msg); // You can't use msg in StreamerOutputModuleBase after this point
+    });
   }
 
   std::unique_ptr<InitMsgBuilder>
@@ -205,9 +253,7 @@ namespace edm {
   }
 
   void
-  StreamerOutputModuleBase::setHltMask(EventForOutput const& e) {
-
-    hltbits_.clear();  // If there was something left over from last event
+  StreamerOutputModuleBase::setHltMask(EventForOutput const& e, std::vector<unsigned char>& hltbits) const {
 
     Handle<TriggerResults> const& prod = getTriggerResults(trToken_, e);
     //Trig const& prod = getTrigMask(e);
@@ -223,60 +269,61 @@ namespace edm {
            vHltState.push_back(hlt::Pass);
       }
     }
-    //Pack into member hltbits_
-    packIntoString(vHltState, hltbits_);
+    //Pack into hltbits
+    packIntoString(vHltState, hltbits);
 
     //This is Just a printing code.
-    //std::cout << "Size of hltbits:" << hltbits_.size() << std::endl;
-    //for(unsigned int i=0; i != hltbits_.size() ; ++i) {
-    //  printBits(hltbits_[i]);
+    //std::cout << "Size of hltbits:" << hltbits.size() << std::endl;
+    //for(unsigned int i=0; i != hltbits.size() ; ++i) {
+    //  printBits(hltbits[i]);
     //}
     //std::cout << "\n";
   }
 
 // test luminosity sections
-  void
-  StreamerOutputModuleBase::setLumiSection() {
+  uint32
+  StreamerOutputModuleBase::lumiSection() const {
+    if(lumiSectionInterval_ <= 0) return 0;
     struct timeval now;
     struct timezone dummyTZ;
     gettimeofday(&now, &dummyTZ);
     double timeInSec = static_cast<double>(now.tv_sec) + (static_cast<double>(now.tv_usec)/1000000.0) - timeInSecSinceUTC;
     // what about overflows?
-    if(lumiSectionInterval_ > 0) lumi_ = static_cast<uint32>(timeInSec/lumiSectionInterval_) + 1;
+    return static_cast<uint32>(timeInSec/lumiSectionInterval_) + 1;
   }
 
   std::unique_ptr<EventMsgBuilder>
-  StreamerOutputModuleBase::serializeEvent(EventForOutput const& e) {
+  StreamerOutputModuleBase::serializeEvent(EventForOutput const& e, SerializeDataBuffer& sbuf) const {
     //Lets Build the Event Message first
 
     //Following is strictly DUMMY Data for L! Trig and will be replaced with actual
     // once figured out, there is no logic involved here.
-    l1bit_.push_back(true);
-    l1bit_.push_back(true);
-    l1bit_.push_back(false);
+    std::vector<bool> l1bit = {true, true, false};
     //End of dummy data
 
-    setHltMask(e);
+    std::vector<unsigned char> hltbits;
+    setHltMask(e, hltbits);
 
+    uint32 lumi;
     if (lumiSectionInterval_ == 0) {
-      lumi_ = e.luminosityBlock();
+      lumi = e.luminosityBlock();
     } else {
-      setLumiSection();
+      lumi = lumiSection();
     }
 
-    serializer_.serializeEvent(e, selectorConfig(), useCompression_, compressionLevel_, serializeDataBuffer_);
+    serializer_.serializeEvent(e, selectorConfig(), compressionAlgo_, compressionLevel_, sbuf);
 
     // resize bufs_ to reflect space used in serializer_ + header
     // I just added an overhead for header of 50000 for now
-    unsigned int src_size = serializeDataBuffer_.currentSpaceUsed();
+    unsigned int src_size = sbuf.currentSpaceUsed();
     unsigned int new_size = src_size + 50000;
-    if(serializeDataBuffer_.bufs_.size() < new_size) serializeDataBuffer_.bufs_.resize(new_size);
+    if(sbuf.bufs_.size() < new_size) sbuf.bufs_.resize(new_size);
 
     auto msg = std::make_unique<EventMsgBuilder>(
-                              &serializeDataBuffer_.bufs_[0], serializeDataBuffer_.bufs_.size(), e.id().run(),
-                              e.id().event(), lumi_, outputModuleId_, 0,
-                              l1bit_, (uint8*)&hltbits_[0], hltsize_,
-                              (uint32)serializeDataBuffer_.adler32_chksum(), host_name_);
+                              &sbuf.bufs_[0], sbuf.bufs_.size(), e.id().run(),
+                              e.id().event(), lumi, outputModuleId_, 0,
+                              l1bit, hltbits.data(), hltsize_,
+                              (uint32)sbuf.adler32_chksum(), host_name_);
     msg->setOrigDataSize(origSize_); // we need this set to zero
 
     // copy data into the destination message
@@ -288,12 +335,11 @@ namespace edm {
     // size + overhead for header because we will not know the actual
     // compressed size.
 
-    unsigned char* src = serializeDataBuffer_.bufferPointer();
+    unsigned char const* src = sbuf.bufferPointer();
     std::copy(src,src + src_size, msg->eventAddr());
     msg->setEventLength(src_size);
-    if(useCompression_) msg->setOrigDataSize(serializeDataBuffer_.currentEventSize());
+    if(useCompression_) msg->setOrigDataSize(sbuf.currentEventSize());
 
-    l1bit_.clear();  //Clear up for the next event to come.
     return msg;
   }
 
@@ -304,7 +350,10 @@ namespace edm {
     desc.addUntracked<bool>("use_compression", true)
         ->setComment("If True, compression will be used to write streamer file.");
     desc.addUntracked<int>("compression_level", 1)
-        ->setComment("ROOT compression level to use.");
+        ->setComment("Compression level to use: 1 to 9 for ZLIB, 1 to 12 for LZ4, 1 to 22 for ZSTD.");
+    desc.addUntracked<std::string>("compression_algorithm", "ZLIB")
+        ->setComment("Compression algorithm for the event data: ZLIB, LZ4 or ZSTD.\n"
+                     "Readers recognise the algorithm from the data itself.");
     desc.addUntracked<int>("lumiSection_interval", 0)
         ->setComment("If 0, use lumi section number from event.\n"
                      "If not 0, the interval in seconds between fake lumi sections.");
@@ -82,6 +82,7 @@ process.test = cms.EDAnalyzer('RunLumiEventAnalyzer',
 
 process.out = cms.OutputModule("EventStreamFileWriter",
     fileName = cms.untracked.string('teststreamfile_copy.dat'),
+    compression_algorithm = cms.untracked.string('ZSTD'),
     compression_level = cms.untracked.int32(1),
     use_compression = cms.untracked.bool(True),
     max_event_size = cms.untracked.int32(7000000)
@@ -9,7 +9,8 @@ process.load("FWCore.MessageLogger.MessageLogger_cfi")
 
 process.source = cms.Source("NewEventStreamFileReader",
     fileNames = cms.untracked.vstring('file:teststreamfile.dat'),
-    inputFileTransitionsEachEvent = cms.untracked.bool(True)
+    inputFileTransitionsEachEvent = cms.untracked.bool(True),
+    useIndex = cms.untracked.bool(True)
     #firstEvent = cms.untracked.uint64(10123456835)
 )
 
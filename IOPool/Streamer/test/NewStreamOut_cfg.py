@@ -28,6 +28,7 @@ process.a1 = cms.EDAnalyzer("StreamThingAnalyzer",
 
 process.out = cms.OutputModule("EventStreamFileWriter",
     fileName = cms.untracked.string('teststreamfile.dat'),
+    writeIndex = cms.untracked.bool(True),
     compression_level = cms.untracked.int32(1),
     use_compression = cms.untracked.bool(True),
     max_event_size = cms.untracked.int32(7000000)
@@ -21,6 +21,7 @@ cmsRun --parameter-set NewStreamIn_cfg.py  > in  2>&1 || die "cmsRun NewStreamIn
 cmsRun --parameter-set NewStreamIn2_cfg.py  > in2  2>&1 || die "cmsRun NewStreamIn2_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy_cfg.py  > copy  2>&1 || die "cmsRun NewStreamCopy_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy2_cfg.py  > copy2  2>&1 || die "cmsRun NewStreamCopy2_cfg.py" $?
+cmsRun --parameter-set NewStreamInZSTD_cfg.py  > inzstd  2>&1 || die "cmsRun NewStreamInZSTD_cfg.py" $?
 
 # echo "CHECKSUM = 1" > out
 # echo "CHECKSUM = 1" > in
@@ -30,6 +31,7 @@ ANS_OUT=`grep CHECKSUM out`
 ANS_IN=`grep CHECKSUM in`
 ANS_IN2=`grep CHECKSUM in2`
 ANS_COPY=`grep CHECKSUM copy`
+ANS_INZSTD=`grep CHECKSUM inzstd`
 
 if [ "${ANS_OUT_SIZE}" == "0" ]
 then
@@ -55,5 +57,11 @@ then
     RC=1
 fi
 
+if [ "${ANS_OUT}" != "${ANS_INZSTD}" ]
+then
+    echo "New Stream Test Failed (out!=inzstd)"
+    RC=1
+fi
+
 #rm -rf ${OUTDIR}
 exit ${RC}
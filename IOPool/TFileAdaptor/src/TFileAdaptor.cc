@@ -87,6 +87,10 @@
       minFree_(0),
       timeout_(0U),
       debugLevel_(0U),
+      asyncReadDepth_(0U),
+      blockCacheDir_(),
+      blockCacheBlockSize_(1024*1024),
+      blockCacheMaxSize_(10.),
       native_() {
     if (!(enabled_ = pset.getUntrackedParameter<bool> ("enable", enabled_)))
       return;
@@ -103,6 +107,10 @@
     tempDir_ = pset.getUntrackedParameter<std::string> ("tempDir", f->tempPath());
     minFree_ = pset.getUntrackedParameter<double> ("tempMinFree", f->tempMinFree());
     native_ = pset.getUntrackedParameter<std::vector<std::string> >("native", native_);
+    asyncReadDepth_ = pset.getUntrackedParameter<unsigned int>("asyncReadDepth", asyncReadDepth_);
+    blockCacheDir_ = pset.getUntrackedParameter<std::string>("blockCacheDir", blockCacheDir_);
+    blockCacheBlockSize_ = pset.getUntrackedParameter<unsigned int>("blockCacheBlockSize", blockCacheBlockSize_);
+    blockCacheMaxSize_ = pset.getUntrackedParameter<double>("blockCacheMaxSize", blockCacheMaxSize_);
 
     ar.watchPostEndJob(this, &TFileAdaptor::termination);
 
@@ -165,6 +173,8 @@
 
     f->setTimeout(timeout_);
     f->setDebugLevel(debugLevel_);
+    f->setAsyncReadDepth(asyncReadDepth_);
+    f->setBlockCache(blockCacheDir_, blockCacheBlockSize_, blockCacheMaxSize_);
 
     // enable file access stats accounting if requested
     f->enableAccounting(doStats_);
@@ -207,6 +217,15 @@
     desc.addOptionalUntracked<std::string>("tempDir");
     desc.addOptionalUntracked<double>("tempMinFree");
     desc.addOptionalUntracked<std::vector<std::string> >("native");
+    desc.addOptionalUntracked<unsigned int>("asyncReadDepth")
+      ->setComment("If larger than 1, the vector reads of local files are done with up to this many concurrent reads.");
+    desc.addOptionalUntracked<std::string>("blockCacheDir")
+      ->setComment("If not empty, directory on a node-local disk where the blocks read from remote files are cached,"
+                   " shared by all the jobs of the node.");
+    desc.addOptionalUntracked<unsigned int>("blockCacheBlockSize")
+      ->setComment("Size in bytes of the blocks of the remote files cached in 'blockCacheDir'.");
+    desc.addOptionalUntracked<double>("blockCacheMaxSize")
+      ->setComment("Size in GB above which the least recently used blocks are removed from 'blockCacheDir'.");
     descriptions.add("AdaptorConfig", desc);
   }
 
@@ -232,6 +251,8 @@
       << " Prefetching:" << (enablePrefetching_ ? "true" : "false") << '\n'
       << " Cache hint:" << cacheHint_ << '\n'
       << " Read hint:" << readHint_ << '\n'
+      << " Async read depth:" << asyncReadDepth_ << '\n'
+      << " Block cache:" << (blockCacheDir_.empty() ? "none" : blockCacheDir_) << '\n'
       << "Storage statistics: "
       << StorageAccount::summaryText()
       << "; tfile/read=?/?/" << (TFile::GetFileBytesRead() / oneMeg) << "MB/?ms/?ms/?ms"
@@ -249,6 +270,8 @@
     data.insert(std::make_pair("Parameter-untracked-bool-prefetching", (enablePrefetching_ ? "true" : "false")));
     data.insert(std::make_pair("Parameter-untracked-string-cacheHint", cacheHint_));
     data.insert(std::make_pair("Parameter-untracked-string-readHint", readHint_));
+    data.insert(std::make_pair("Parameter-untracked-uint32-asyncReadDepth", std::to_string(asyncReadDepth_)));
+    data.insert(std::make_pair("Parameter-untracked-string-blockCacheDir", blockCacheDir_));
     StorageAccount::fillSummary(data);
     std::ostringstream r;
     std::ostringstream w;
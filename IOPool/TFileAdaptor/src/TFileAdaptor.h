@@ -45,6 +45,10 @@ private:
   double minFree_;
   unsigned int timeout_;
   unsigned int debugLevel_;
+  unsigned int asyncReadDepth_;
+  std::string blockCacheDir_;
+  unsigned int blockCacheBlockSize_;
+  double blockCacheMaxSize_;
   std::vector<std::string> native_;
 
 };
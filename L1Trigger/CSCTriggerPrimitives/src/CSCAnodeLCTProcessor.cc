@@ -811,7 +811,6 @@ bool CSCAnodeLCTProcessor::preTrigger(const int key_wire, const int start_bx) {
      true and the PatternDetection process will start. */
 
   unsigned int layers_hit;
-  bool hit_layer[CSCConstants::NUM_LAYERS];
   int this_layer, this_wire;
   // If nplanes_hit_accel_pretrig is 0, the firmware uses the value
   // of nplanes_hit_pretrig instead.
@@ -822,6 +821,20 @@ bool CSCAnodeLCTProcessor::preTrigger(const int key_wire, const int start_bx) {
     nplanes_hit_pretrig_acc, nplanes_hit_pretrig, nplanes_hit_pretrig
   };
 
+  // OR of the pulses of the wire groups of each pattern in each layer: a
+  // layer of the pattern is hit at bx_time if bit bx_time is set.
+  unsigned int layer_pulse[CSCConstants::NUM_ALCT_PATTERNS][CSCConstants::NUM_LAYERS] = {};
+  for (int i_pattern = 0; i_pattern < CSCConstants::NUM_ALCT_PATTERNS; i_pattern++) {
+    for (int i_wire = 0; i_wire < NUM_PATTERN_WIRES; i_wire++){
+      if (pattern_mask[i_pattern][i_wire] != 0){
+        this_layer = pattern_envelope[0][i_wire];
+        this_wire  = pattern_envelope[1+MESelection][i_wire]+key_wire;
+        if ((this_wire >= 0) && (this_wire < numWireGroups))
+          layer_pulse[i_pattern][this_layer] |= pulse[this_layer][this_wire];
+      }
+    }
+  }
+
   // Loop over bx times, accelerator and collision patterns to 
   // look for pretrigger.
   // Stop drift_delay bx's short of fifo_tbins since at later bx's we will
@@ -829,38 +842,22 @@ bool CSCAnodeLCTProcessor::preTrigger(const int key_wire, const int start_bx) {
   unsigned int stop_bx = fifo_tbins - drift_delay;
   for (unsigned int bx_time = start_bx; bx_time < stop_bx; bx_time++) {
     for (int i_pattern = 0; i_pattern < CSCConstants::NUM_ALCT_PATTERNS; i_pattern++) {
+      unsigned int hit_layers = 0;
       for (int i_layer = 0; i_layer < CSCConstants::NUM_LAYERS; i_layer++)
-        hit_layer[i_layer] = false;
-      layers_hit = 0;
-
-      for (int i_wire = 0; i_wire < NUM_PATTERN_WIRES; i_wire++){
-        if (pattern_mask[i_pattern][i_wire] != 0){
-          this_layer = pattern_envelope[0][i_wire];
-          this_wire  = pattern_envelope[1+MESelection][i_wire]+key_wire;
-          if ((this_wire >= 0) && (this_wire < numWireGroups)){
-            // Perform bit operation to see if pulse is 1 at a certain bx_time.
-            if (((pulse[this_layer][this_wire] >> bx_time) & 1) == 1) {
-              // Store number of layers hit.
-              if (hit_layer[this_layer] == false){
-                hit_layer[this_layer] = true;
-                layers_hit++;
-              }
-
-              // See if number of layers hit is greater than or equal to
-              // pretrig_thresh.
-              if (layers_hit >= pretrig_thresh[i_pattern]) {
-                first_bx[key_wire] = bx_time;
-                if (infoV > 1) {
-                  LogTrace("CSCAnodeLCTProcessor")
-                    << "Pretrigger was satisfied for wire: " << key_wire
-                    << " pattern: " << i_pattern
-                    << " bx_time: " << bx_time;
-                }
-                return true;
-              }
-            }
-          }
+        hit_layers |= ((layer_pulse[i_pattern][i_layer] >> bx_time) & 1) << i_layer;
+      layers_hit = __builtin_popcount(hit_layers);
+
+      // See if number of layers hit is greater than or equal to
+      // pretrig_thresh.
+      if (hit_layers != 0 && layers_hit >= pretrig_thresh[i_pattern]) {
+        first_bx[key_wire] = bx_time;
+        if (infoV > 1) {
+          LogTrace("CSCAnodeLCTProcessor")
+            << "Pretrigger was satisfied for wire: " << key_wire
+            << " pattern: " << i_pattern
+            << " bx_time: " << bx_time;
         }
+        return true;
       }
     }
   }
@@ -30,10 +30,52 @@
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <set>
 
+namespace {
+  // The halfstrips of the 2007 patterns are within +-5 of the key halfstrip.
+  const int pattern2007_half_width = 5;
+  const unsigned int pattern2007_window = (1u << (2*pattern2007_half_width + 1)) - 1;
+
+  // One 64 bit word per 64 halfstrips of a layer, padded by the half width
+  // of the patterns on both sides.
+  const int hit_words = (CSCConstants::NUM_HALF_STRIPS_7CFEBS + 2*pattern2007_half_width + 63)/64;
+
+  typedef std::array<std::array<unsigned int, CSCConstants::NUM_LAYERS>,
+                     CSCConstants::NUM_CLCT_PATTERNS> PatternLayerMasks;
+
+  // For each 2007 pattern and layer, the halfstrips in the pattern, as bits
+  // of the offsets -5..5 from the key halfstrip.
+  const PatternLayerMasks& pattern2007LayerMasks() {
+    static const PatternLayerMasks masks = [] {
+      PatternLayerMasks m{};
+      for (int pid = 0; pid < CSCConstants::NUM_CLCT_PATTERNS; pid++) {
+        for (int strip_num = 0; strip_num < CSCCathodeLCTProcessor::NUM_PATTERN_HALFSTRIPS; strip_num++) {
+          int this_layer = CSCCathodeLCTProcessor::pattern2007[pid][strip_num];
+          if (this_layer >= 0 && this_layer < CSCConstants::NUM_LAYERS)
+            m[pid][this_layer] |=
+              1u << (CSCCathodeLCTProcessor::pattern2007_offset[strip_num] + pattern2007_half_width);
+        }
+      }
+      return m;
+    }();
+    return masks;
+  }
+
+  // The 11 halfstrips around key_hstrip out of the padded bits of a layer.
+  inline unsigned int hitWindow(const uint64_t bits[hit_words], const int key_hstrip) {
+    const int word = key_hstrip / 64, shift = key_hstrip % 64;
+    uint64_t window = bits[word] >> shift;
+    if (shift > 64 - (2*pattern2007_half_width + 1))
+      window |= bits[word + 1] << (64 - shift);
+    return static_cast<unsigned int>(window) & pattern2007_window;
+  }
+}
+
 //-----------------
 // Static variables
 //-----------------
@@ -2359,23 +2401,30 @@ bool CSCCathodeLCTProcessor::ptnFinding(
 {
   if (bx_time >= fifo_tbins) return false;
 
-  // This loop is a quick check of a number of layers hit at bx_time: since
-  // most of the time it is 0, this check helps to speed-up the execution
-  // substantially.
+  // Halfstrips with the "one shot" high at bx_time, one bit per halfstrip,
+  // so that the layers hit in a pattern are found with a few bitwise ANDs.
+  // Counting the layers hit at bx_time is a quick check: since most of the
+  // time it is 0, this check helps to speed-up the execution substantially.
+  uint64_t hit_bits[CSCConstants::NUM_LAYERS][hit_words] = {};
   unsigned int layers_hit = 0;
   for (int i_layer = 0; i_layer < CSCConstants::NUM_LAYERS; i_layer++)
   {
+    bool layer_hit = false;
     for (int i_hstrip = 0; i_hstrip < nStrips; i_hstrip++)
     {
       if (((pulse[i_layer][i_hstrip] >> bx_time) & 1) == 1)
       {
-	layers_hit++;
-	break;
+	const int bit = i_hstrip + pattern2007_half_width;
+	hit_bits[i_layer][bit / 64] |= uint64_t(1) << (bit % 64);
+	layer_hit = true;
       }
     }
+    if (layer_hit) layers_hit++;
   }
   if (layers_hit < nplanes_hit_pretrig) return false;
 
+  const PatternLayerMasks& layer_masks = pattern2007LayerMasks();
+
   for (int key_hstrip = 0; key_hstrip < nStrips; key_hstrip++)
   {
     best_pid[key_hstrip] = 0;
@@ -2384,15 +2433,28 @@ bool CSCCathodeLCTProcessor::ptnFinding(
   }
 
   // Loop over candidate key strips.
-  bool hit_layer[CSCConstants::NUM_LAYERS];
   for (int key_hstrip = stagger[CSCConstants::KEY_CLCT_LAYER - 1]; key_hstrip < nStrips; key_hstrip++)
   {
+    // Hits around the key halfstrip in each layer.
+    unsigned int window[CSCConstants::NUM_LAYERS];
+    unsigned int any_hit = 0;
+    for (int ilayer = 0; ilayer < CSCConstants::NUM_LAYERS; ilayer++)
+    {
+      window[ilayer] = hitWindow(hit_bits[ilayer], key_hstrip);
+      any_hit |= window[ilayer];
+    }
+    if (any_hit == 0) continue;
+
     // Loop over patterns and look for hits matching each pattern.
     for (unsigned int pid = CSCConstants::NUM_CLCT_PATTERNS - 1; pid >= pid_thresh_pretrig; pid--)
     {
-      layers_hit = 0;
+      unsigned int hit_layers = 0;
       for (int ilayer = 0; ilayer < CSCConstants::NUM_LAYERS; ilayer++)
-	hit_layer[ilayer] = false;
+	if ((window[ilayer] & layer_masks[pid][ilayer]) != 0) hit_layers |= 1u << ilayer;
+      layers_hit = __builtin_popcount(hit_layers);
+
+      // The bx of the hits is only needed for a better pattern.
+      if (layers_hit <= nhits[key_hstrip]) continue;
 
       double num_pattern_hits=0., times_sum=0.;
       std::multiset<int> mset_for_median;
@@ -2414,12 +2476,6 @@ bool CSCCathodeLCTProcessor::ptnFinding(
 	    // Determine if "one shot" is high at this bx_time
             if (((pulse[this_layer][this_strip] >> bx_time) & 1) == 1)
             {
-              if (hit_layer[this_layer] == false)
-              {
-		hit_layer[this_layer] = true;
-		layers_hit++;     // determines number of layers hit
-	      }
-
               // find at what bx did pulse on this halsfstrip&layer have started
               // use hit_pesrist constraint on how far back we can go
               int first_bx_layer = bx_time;
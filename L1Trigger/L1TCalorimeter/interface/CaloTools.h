@@ -109,6 +109,7 @@ namespace l1t {
     // trigger tower eta boundaries
     static std::pair<float,float> towerEtaBounds(int ieta);
 
+    friend class CaloTowerGrid; //returns nullTower_ for the missing towers as getTower does
     static const l1t::CaloTower nullTower_; //to return when we need to return a tower which was not found/invalid rather than throwing an exception
     static const l1t::CaloCluster nullCluster_; //to return when we need to return a cluster which was not found/invalid rather than throwing an exception
 
@@ -0,0 +1,44 @@
+///
+/// \class l1t::CaloTowerGrid
+///
+/// Description: Constant time lookup of the towers of an event by their iEta, iPhi
+///
+/// Implementation:
+///   The towers are indexed once by CaloTools::caloTowerHash, after which getTower
+///   returns the same tower as CaloTools::getTower on the vector. The latter is only
+///   fast when the tower is at the position of its hash, and otherwise searches the
+///   whole vector, which is the case for every tower missing from the event when
+///   the towers are stored by hash as in the layer 2 producer.
+///   The vector of towers must outlive the grid and must not be modified.
+///
+
+//
+
+#ifndef L1Trigger_L1TCalorimeter_CaloTowerGrid_h
+#define L1Trigger_L1TCalorimeter_CaloTowerGrid_h
+
+#include <vector>
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTools.h"
+
+namespace l1t {
+
+  class CaloTowerGrid {
+  public:
+    explicit CaloTowerGrid(const std::vector<l1t::CaloTower>& towers);
+
+    const l1t::CaloTower& getTower(int iEta,int iPhi) const {
+      size_t towerIndex = CaloTools::caloTowerHash(iEta,iPhi);
+      if(towerIndex<grid_.size()) return *grid_[towerIndex];
+      else return CaloTools::getTower(towers_,iEta,iPhi); //the positions without a hash of their own
+    }
+
+  private:
+    const std::vector<l1t::CaloTower>& towers_;
+    std::vector<const l1t::CaloTower*> grid_; //indexed by hash, pointing to nullTower_ for missing towers
+  };
+
+}
+
+#endif
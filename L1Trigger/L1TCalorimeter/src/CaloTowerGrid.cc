@@ -0,0 +1,18 @@
+#include "L1Trigger/L1TCalorimeter/interface/CaloTowerGrid.h"
+
+l1t::CaloTowerGrid::CaloTowerGrid(const std::vector<l1t::CaloTower>& towers) :
+  towers_(towers),
+  grid_(CaloTools::caloTowerHashMax(),&CaloTools::nullTower_)
+{
+  //as CaloTools::getTower, the first tower at a position is found by the search...
+  for(size_t towerNr=towers.size();towerNr!=0;towerNr--){
+    const l1t::CaloTower& tower = towers[towerNr-1];
+    size_t towerIndex = CaloTools::caloTowerHash(tower.hwEta(),tower.hwPhi());
+    if(towerIndex<grid_.size()) grid_[towerIndex] = &tower;
+  }
+  //...unless there is one at the position of its hash
+  for(size_t towerIndex=0;towerIndex<grid_.size() && towerIndex<towers.size();towerIndex++){
+    const l1t::CaloTower& tower = towers[towerIndex];
+    if(CaloTools::caloTowerHash(tower.hwEta(),tower.hwPhi())==towerIndex) grid_[towerIndex] = &tower;
+  }
+}
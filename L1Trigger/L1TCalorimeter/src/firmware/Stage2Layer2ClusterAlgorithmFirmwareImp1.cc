@@ -11,6 +11,7 @@
 
 #include "L1Trigger/L1TCalorimeter/interface/CaloTools.h"
 #include "L1Trigger/L1TCalorimeter/interface/CaloStage2Nav.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTowerGrid.h"
 
 #include "L1Trigger/L1TCalorimeter/interface/CaloParamsHelper.h"
 
@@ -69,6 +70,8 @@ void l1t::Stage2Layer2ClusterAlgorithmFirmwareImp1::clustering(const std::vector
 {
   // navigator
   l1t::CaloStage2Nav caloNav;
+  // constant time lookup of the neighbour towers
+  const l1t::CaloTowerGrid grid(towers);
 
   // Build clusters passing seed threshold
   for(const auto& tower : towers)
@@ -114,16 +117,16 @@ void l1t::Stage2Layer2ClusterAlgorithmFirmwareImp1::clustering(const std::vector
       int iPhiP2 = caloNav.offsetIPhi(iPhi,  2);
       int iPhiM  = caloNav.offsetIPhi(iPhi, -1);
       int iPhiM2 = caloNav.offsetIPhi(iPhi, -2);
-      const l1t::CaloTower& towerNW = l1t::CaloTools::getTower(towers, iEtaM, iPhiM);
-      const l1t::CaloTower& towerN  = l1t::CaloTools::getTower(towers, iEta , iPhiM);
-      const l1t::CaloTower& towerNE = l1t::CaloTools::getTower(towers, iEtaP, iPhiM);
-      const l1t::CaloTower& towerE  = l1t::CaloTools::getTower(towers, iEtaP, iPhi );
-      const l1t::CaloTower& towerSE = l1t::CaloTools::getTower(towers, iEtaP, iPhiP);
-      const l1t::CaloTower& towerS  = l1t::CaloTools::getTower(towers, iEta , iPhiP);
-      const l1t::CaloTower& towerSW = l1t::CaloTools::getTower(towers, iEtaM, iPhiP);
-      const l1t::CaloTower& towerW  = l1t::CaloTools::getTower(towers, iEtaM, iPhi );
-      const l1t::CaloTower& towerNN = l1t::CaloTools::getTower(towers, iEta , iPhiM2);
-      const l1t::CaloTower& towerSS = l1t::CaloTools::getTower(towers, iEta , iPhiP2);
+      const l1t::CaloTower& towerNW = grid.getTower(iEtaM, iPhiM);
+      const l1t::CaloTower& towerN  = grid.getTower(iEta , iPhiM);
+      const l1t::CaloTower& towerNE = grid.getTower(iEtaP, iPhiM);
+      const l1t::CaloTower& towerE  = grid.getTower(iEtaP, iPhi );
+      const l1t::CaloTower& towerSE = grid.getTower(iEtaP, iPhiP);
+      const l1t::CaloTower& towerS  = grid.getTower(iEta , iPhiP);
+      const l1t::CaloTower& towerSW = grid.getTower(iEtaM, iPhiP);
+      const l1t::CaloTower& towerW  = grid.getTower(iEtaM, iPhi );
+      const l1t::CaloTower& towerNN = grid.getTower(iEta , iPhiM2);
+      const l1t::CaloTower& towerSS = grid.getTower(iEta , iPhiP2);
       int towerEtNW = 0;
       int towerEtN  = 0;
       int towerEtNE = 0;
@@ -264,6 +267,8 @@ void l1t::Stage2Layer2ClusterAlgorithmFirmwareImp1::refining(const std::vector<l
 {
   // navigator
   l1t::CaloStage2Nav caloNav;
+  // constant time lookup of the neighbour towers
+  const l1t::CaloTowerGrid grid(towers);
 
   // trim cluster
   for(auto& cluster : clusters)
@@ -278,16 +283,16 @@ void l1t::Stage2Layer2ClusterAlgorithmFirmwareImp1::refining(const std::vector<l
       int iPhiP2 = caloNav.offsetIPhi(iPhi, 2);
       int iPhiM  = caloNav.offsetIPhi(iPhi, -1);
       int iPhiM2 = caloNav.offsetIPhi(iPhi, -2);
-      const l1t::CaloTower& towerNW = l1t::CaloTools::getTower(towers, iEtaM, iPhiM);
-      const l1t::CaloTower& towerN  = l1t::CaloTools::getTower(towers, iEta , iPhiM);
-      const l1t::CaloTower& towerNE = l1t::CaloTools::getTower(towers, iEtaP, iPhiM);
-      const l1t::CaloTower& towerE  = l1t::CaloTools::getTower(towers, iEtaP, iPhi );
-      const l1t::CaloTower& towerSE = l1t::CaloTools::getTower(towers, iEtaP, iPhiP);
-      const l1t::CaloTower& towerS  = l1t::CaloTools::getTower(towers, iEta , iPhiP);
-      const l1t::CaloTower& towerSW = l1t::CaloTools::getTower(towers, iEtaM, iPhiP);
-      const l1t::CaloTower& towerW  = l1t::CaloTools::getTower(towers, iEtaM, iPhi );
-      const l1t::CaloTower& towerNN = l1t::CaloTools::getTower(towers, iEta , iPhiM2);
-      const l1t::CaloTower& towerSS = l1t::CaloTools::getTower(towers, iEta , iPhiP2);
+      const l1t::CaloTower& towerNW = grid.getTower(iEtaM, iPhiM);
+      const l1t::CaloTower& towerN  = grid.getTower(iEta , iPhiM);
+      const l1t::CaloTower& towerNE = grid.getTower(iEtaP, iPhiM);
+      const l1t::CaloTower& towerE  = grid.getTower(iEtaP, iPhi );
+      const l1t::CaloTower& towerSE = grid.getTower(iEtaP, iPhiP);
+      const l1t::CaloTower& towerS  = grid.getTower(iEta , iPhiP);
+      const l1t::CaloTower& towerSW = grid.getTower(iEtaM, iPhiP);
+      const l1t::CaloTower& towerW  = grid.getTower(iEtaM, iPhi );
+      const l1t::CaloTower& towerNN = grid.getTower(iEta , iPhiM2);
+      const l1t::CaloTower& towerSS = grid.getTower(iEta , iPhiP2);
 
       int towerEtNW = 0;
       int towerEtN  = 0;
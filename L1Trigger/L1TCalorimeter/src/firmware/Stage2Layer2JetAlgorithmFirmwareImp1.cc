@@ -9,6 +9,7 @@
 #include "L1Trigger/L1TCalorimeter/interface/Stage2Layer2JetAlgorithmFirmware.h"
 #include "DataFormats/Math/interface/LorentzVector.h"
 #include "L1Trigger/L1TCalorimeter/interface/CaloTools.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTowerGrid.h"
 #include "L1Trigger/L1TCalorimeter/interface/BitonicSort.h"
 #include "CondFormats/L1TObjects/interface/CaloParams.h"
 
@@ -71,6 +72,11 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 						       std::vector<l1t::Jet> & alljets, 
 						       std::string PUSubMethod) {
   
+  // the towers are looked up by position many times for each seed
+  const CaloTowerGrid grid(towers);
+
+  const double seedThreshold = floor(params_->jetSeedThreshold()/params_->towerLsbSum());
+
   // etaSide=1 is positive eta, etaSide=-1 is negative eta
   for (int etaSide=1; etaSide>=-1; etaSide-=2) {
     
@@ -108,14 +114,14 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 	  if (jetsRing.size()==18) break;
 	  
 	  // seed tower
-	  const CaloTower& tow = CaloTools::getTower(towers, ieta, iphi); 
+	  const CaloTower& tow = grid.getTower(ieta, iphi); 
 	  
 	  int seedEt = tow.hwPt();
 	  int iEt = seedEt;
 	  bool vetoCandidate = false;
 	  
 	  // check it passes the seed threshold
-	  if(iEt < floor(params_->jetSeedThreshold()/params_->towerLsbSum())) continue;
+	  if(iEt < seedThreshold) continue;
 	  
 	  // loop over towers in this jet
 	  for( int deta = -4; deta < 5; ++deta ) {
@@ -134,7 +140,7 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 	      if (ieta < 0 && ietaTest >=0) ietaTest += 1;
 	   
 	      // check jet mask and sum tower et
-	      const CaloTower& towTest = CaloTools::getTower(towers, ietaTest, iphiTest);
+	      const CaloTower& towTest = grid.getTower(ietaTest, iphiTest);
 	      towEt = towTest.hwPt();
 	      
               if      (mask_[8-(dphi+4)][deta+4] == 0) continue;
@@ -151,8 +157,8 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 	  // add the jet to the list
 	  if (!vetoCandidate) {
 	
-	    if (PUSubMethod == "Donut")       iEt -= donutPUEstimate(ieta, iphi, 5, towers);	    
-	    if (PUSubMethod == "ChunkyDonut") iEt -= chunkyDonutPUEstimate(ieta, iphi, 5, towers);
+	    if (PUSubMethod == "Donut")       iEt -= donutPUEstimate(ieta, iphi, 5, grid);	    
+	    if (PUSubMethod == "ChunkyDonut") iEt -= chunkyDonutPUEstimate(ieta, iphi, 5, grid);
 	    	   
             if (iEt<=0) continue;
  
@@ -213,7 +219,7 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate(int jetEta, 
 							       int jetPhi, 
 							       int size, 
-							       const std::vector<l1t::CaloTower> & towers){
+							       const CaloTowerGrid & grid){
 
   //ring is a vector with 4 ring strips, one for each side of the ring
   std::vector<int> ring(4,0);
@@ -240,11 +246,11 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate(int jetEta,
       towerEta=ieta;
     }
     
-    const CaloTower& tow = CaloTools::getTower(towers, towerEta, iphiUp);
+    const CaloTower& tow = grid.getTower(towerEta, iphiUp);
     int towEt = tow.hwPt();
     ring[0]+=towEt;
     
-    const CaloTower& tow2 = CaloTools::getTower(towers, towerEta, iphiDown);
+    const CaloTower& tow2 = grid.getTower(towerEta, iphiDown);
     towEt = tow2.hwPt();
     ring[1]+=towEt;
     
@@ -257,11 +263,11 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate(int jetEta,
     while ( towerPhi > CaloTools::kHBHENrPhi ) towerPhi -= CaloTools::kHBHENrPhi;
     while ( towerPhi < 1 ) towerPhi += CaloTools::kHBHENrPhi;
     
-    const CaloTower& tow = CaloTools::getTower(towers, ietaUp, towerPhi);
+    const CaloTower& tow = grid.getTower(ietaUp, towerPhi);
     int towEt = tow.hwPt();
     ring[2]+=towEt;
     
-    const CaloTower& tow2 = CaloTools::getTower(towers, ietaDown, towerPhi);
+    const CaloTower& tow2 = grid.getTower(ietaDown, towerPhi);
     towEt = tow2.hwPt();
     ring[3]+=towEt;
   } 
@@ -275,7 +281,7 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate(int jetEta,
 int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate(int jetEta, 
 								     int jetPhi, 
 								     int size, 
-								     const std::vector<l1t::CaloTower> & towers){
+								     const CaloTowerGrid & grid){
  
    // ring is a vector with 4 ring strips, one for each side of the ring
   // order is PhiUp, PhiDown, EtaUp, EtaDown
@@ -306,11 +312,11 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate(int jetEta,
       if (jetEta>0 && towEta<=0) towEta-=1;
       if (jetEta<0 && towEta>=0) towEta+=1;
             
-      const CaloTower& towPhiUp = CaloTools::getTower(towers, towEta, iphiUp);
+      const CaloTower& towPhiUp = grid.getTower(towEta, iphiUp);
       int towEt = towPhiUp.hwPt();
       ring[0] += towEt;
             
-      const CaloTower& towPhiDown = CaloTools::getTower(towers, towEta, iphiDown);
+      const CaloTower& towPhiDown = grid.getTower(towEta, iphiDown);
       towEt = towPhiDown.hwPt();
       ring[1] += towEt;
             
@@ -324,7 +330,7 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate(int jetEta,
         while ( towPhi > CaloTools::kHBHENrPhi ) towPhi -= CaloTools::kHBHENrPhi;
         while ( towPhi < 1 ) towPhi += CaloTools::kHBHENrPhi;
 
-        const CaloTower& towEtaUp = CaloTools::getTower(towers, ietaUp, towPhi);
+        const CaloTower& towEtaUp = grid.getTower(ietaUp, towPhi);
         int towEt = towEtaUp.hwPt();
         ring[2] += towEt;
       }else{
@@ -342,7 +348,7 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate(int jetEta,
         while ( towPhi > CaloTools::kHBHENrPhi ) towPhi -= CaloTools::kHBHENrPhi;
         while ( towPhi < 1 ) towPhi += CaloTools::kHBHENrPhi;
 	
-        const CaloTower& towEtaDown = CaloTools::getTower(towers, ietaDown, towPhi);
+        const CaloTower& towEtaDown = grid.getTower(ietaDown, towPhi);
         int towEt = towEtaDown.hwPt();
         ring[3] += towEt;
       }else{
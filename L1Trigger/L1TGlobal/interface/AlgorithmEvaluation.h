@@ -105,9 +105,11 @@ public:
         m_algoResult = algoResult;
     }
 
-    /// evaluate an algorithm
+    /// evaluate an algorithm; the operand tokens and the object combinations
+    /// are only filled if fillOperands is true, as they are only needed for
+    /// the object maps and the printout
     void evaluateAlgorithm(const int chipNumber, const std::vector<
-            ConditionEvaluationMap>&);
+            ConditionEvaluationMap>&, const bool fillOperands = true);
 
     /// get all the object combinations evaluated to true in the conditions
     /// from the algorithm 
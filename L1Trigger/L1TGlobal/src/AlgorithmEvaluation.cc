@@ -55,7 +55,7 @@ l1t::AlgorithmEvaluation::AlgorithmEvaluation(const GlobalAlgorithm& alg) :
 
 /// evaluate an algorithm
 void l1t::AlgorithmEvaluation::evaluateAlgorithm(const int chipNumber,
-    const std::vector<ConditionEvaluationMap>& conditionResultMaps) {
+    const std::vector<ConditionEvaluationMap>& conditionResultMaps, const bool fillOperands) {
 
     // set result to false if there is no expression 
     if (m_rpnVector.empty() ) {
@@ -72,8 +72,10 @@ void l1t::AlgorithmEvaluation::evaluateAlgorithm(const int chipNumber,
     // reserve memory
     int rpnVectorSize = m_rpnVector.size();
     
-    m_algoCombinationVector.reserve(rpnVectorSize);
-    m_operandTokenVector.reserve(rpnVectorSize);
+    if (fillOperands) {
+        m_algoCombinationVector.reserve(rpnVectorSize);
+        m_operandTokenVector.reserve(rpnVectorSize);
+    }
 
     // stack containing temporary results
     std::stack<bool, std::vector<bool> > resultStack;
@@ -108,19 +110,21 @@ void l1t::AlgorithmEvaluation::evaluateAlgorithm(const int chipNumber,
 
                     resultStack.push(condResult);
 
-                    // only conditions are added to /counted in m_operandTokenVector 
-                    // opNumber is the index of the condition in the logical expression
-                    OperandToken opToken;
-                    opToken.tokenName = it->operand;
-                    opToken.tokenNumber = opNumber;
-                    opToken.tokenResult = condResult;
+                    if (fillOperands) {
+                        // only conditions are added to /counted in m_operandTokenVector 
+                        // opNumber is the index of the condition in the logical expression
+                        OperandToken opToken;
+                        opToken.tokenName = it->operand;
+                        opToken.tokenNumber = opNumber;
+                        opToken.tokenResult = condResult;
                     
-                    m_operandTokenVector.push_back(opToken);
-                    opNumber++;
+                        m_operandTokenVector.push_back(opToken);
+                        opNumber++;
                     
-                    //
-                    CombinationsInCond const & combInCondition = (itCond->second)->getCombinationsInCond();
-                    m_algoCombinationVector.push_back(combInCondition);
+                        //
+                        CombinationsInCond const & combInCondition = (itCond->second)->getCombinationsInCond();
+                        m_algoCombinationVector.push_back(combInCondition);
+                    }
 
                 }
                 else {
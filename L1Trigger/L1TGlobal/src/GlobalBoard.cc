@@ -678,7 +678,9 @@ void l1t::GlobalBoard::runGTL(
 
     for (CItAlgo itAlgo = algorithmMap.begin(); itAlgo != algorithmMap.end(); itAlgo++) {
         AlgorithmEvaluation gtAlg(itAlgo->second);
-        gtAlg.evaluateAlgorithm((itAlgo->second).algoChipNumber(), m_conditionResultMaps);
+        // the operands and their object combinations are copied only if they are used
+        gtAlg.evaluateAlgorithm((itAlgo->second).algoChipNumber(), m_conditionResultMaps,
+                (produceL1GtObjectMapRecord && (iBxInEvent == 0)) || (m_verbosity && m_isDebugEnabled));
 
         int algBitNumber = (itAlgo->second).algoBitNumber();
         bool algResult = gtAlg.gtAlgoResult();
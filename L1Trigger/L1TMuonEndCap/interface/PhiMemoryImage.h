@@ -34,8 +34,8 @@ class PhiMemoryImage{
   
   void printbuff();
 
- // const PhiMemoryImage::value_type & operator [] (int index) const 
-//  {return _buffer[index];}
+  const PhiMemoryImage::value_type & operator [] (int index) const 
+  {return _buffer[index];}
   
   PhiMemoryImage::value_type & operator [] (int index) 
   {return _buffer[index];}
@@ -19,6 +19,34 @@ const PhiMemoryImage pattern7 (0xf00,0,0,0x8000,0,0,0x7f8000,0,0,0x7f8000,0,0);
 const PhiMemoryImage pattern8 (0x7f800000,0,0,0x8000,0,0,0xff00,0,0,0xff00,0,0);//
 const PhiMemoryImage pattern9 (0xff,0,0,0x8000,0,0,0x7f8000,0,0,0x7f8000,0,0);
 const PhiMemoryImage patterns[PATTERN_SIZE] = {pattern8, pattern9, pattern6, pattern7, pattern4, pattern5, pattern2, pattern3, pattern1};
+
+//the patterns shifted to each of the 192 key strips, the same for every zone and every event
+struct ShiftedPatterns{
+
+	PhiMemoryImage patt[192][PATTERN_SIZE];
+
+	ShiftedPatterns(){
+		for(int b=0;b<192;b++){
+			for(int y=0;y != PATTERN_SIZE;y++){
+				patt[b][y] = patterns[y];
+				if((b-15) < 63){ 														//////Due to bug in BitShift function. 
+					patt[b][y].BitShift(b-15);			 								//////Can try and fix later before uploading to CMSSW.
+				}																		//////
+				else if((b-15) < 127){													//////
+					patt[b][y].BitShift(63);patt[b][y].BitShift(b-78);					//////
+				}																		//////
+				else{																	//////
+					patt[b][y].BitShift(63);patt[b][y].BitShift(63);patt[b][y].BitShift(b-141);  //////
+				}																		//////
+			}
+		}
+	}
+};
+
+static const ShiftedPatterns& shiftedPatterns(){
+	static const ShiftedPatterns table;
+	return table;
+}
  
  
  PatternOutput DetectPatterns(ZonesOutput Eout){
@@ -27,7 +55,8 @@ const PhiMemoryImage patterns[PATTERN_SIZE] = {pattern8, pattern9, pattern6, pat
 	//bool verbose = false;
  	std::vector<int> tmp (192, 0);//was 128
 	std::vector<std::vector<int>> lya (4, tmp), stra (4, tmp), ranka_t (4, tmp), ranka (4, tmp);
-  	std::vector<PhiMemoryImage> Merged = Eout.zone;
+  	const std::vector<PhiMemoryImage>& Merged = Eout.zone;
+	const ShiftedPatterns& shifted = shiftedPatterns();
 	////////////////////////////
 	
 	
@@ -38,23 +67,11 @@ const PhiMemoryImage patterns[PATTERN_SIZE] = {pattern8, pattern9, pattern6, pat
   		for(int b=0;b<192;b++){//loop over stips of detector zones//was 128 now 192 to accomodate 
   							   //larger phi scale used in neighboring sectors algorithm
   			int ly[PATTERN_SIZE] = {0}, srt[PATTERN_SIZE] = {0}, qu[PATTERN_SIZE] = {0};
-			PhiMemoryImage patt[PATTERN_SIZE];
-			for (int i=0; i<PATTERN_SIZE; i++) patt[i] = patterns[i];
+			const PhiMemoryImage* patt = shifted.patt[b];
   			for(int y=0;y != PATTERN_SIZE;y++){//loop over patterns
 	
 				bool zona[12] = {false}; //Clear out station presence
 		
-				if((b-15) < 63){ 														//////Due to bug in BitShift function. 
-					patt[y].BitShift(b-15);			 									//////Can try and fix later before uploading to CMSSW.
-				}																		//////
-				else if((b-15) < 127){													//////
-					patt[y].BitShift(63);patt[y].BitShift(b-78);						//////
-				}																		//////
-				else{																	//////
-					patt[y].BitShift(63);patt[y].BitShift(63);patt[y].BitShift(b-141);  //////
-				}																		//////
-			
-			
 				for(int yy=0;yy != 12;yy++){//loop over 8 long integers of each pattern
 				
 					zona[yy] = patt[y][yy] & Merged[zone][yy];
@@ -25,6 +25,7 @@
 #include "L1Trigger/TrackTrigger/interface/TTStubAlgorithmRecord.h"
 
 #include "DataFormats/GeometryCommonDetAlgo/interface/MeasurementPoint.h"
+#include "DataFormats/SiStripDetId/interface/StripSubdetector.h"
 #include "Geometry/CommonTopologies/interface/Topology.h"
 #include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetUnit.h"
 #include "Geometry/CommonTopologies/interface/PixelTopology.h"
@@ -32,6 +33,7 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <typeinfo>
 
 template< typename T >
@@ -46,6 +48,22 @@ class TTStubAlgorithm_official : public TTStubAlgorithm< T >
     std::vector< double >                barrelCut;
     std::vector< std::vector< double > > ringCut;
 
+    /// The geometry of a stack used by PatternHitCorrelation,
+    /// computed once per stack instead of for each pair of Clusters
+    struct StackGeometry
+    {
+      bool   isPS;
+      int    ratio;      /// columns of the lower over the upper member
+      bool   hasWindow;  /// false if the cuts do not cover the stack
+      int    window;     /// In HALF-STRIP units!
+      float  pitchRatio; /// row pitch of the lower over the upper member
+      double rowCenter0; /// row coordinate of the center of the lower member
+      double R0, Z0, DR, DZ;
+    };
+    std::unordered_map< unsigned int, StackGeometry > theStackGeometry;
+
+    StackGeometry makeStackGeometry( const DetId& stDetId ) const;
+
   public:
     /// Constructor
     TTStubAlgorithm_official( const TrackerGeometry* const theTrackerGeom, const TrackerTopology* const theTrackerTopo,
@@ -58,6 +76,19 @@ class TTStubAlgorithm_official : public TTStubAlgorithm< T >
       ringCut = setRingCut;
       mPerformZMatchingPS = aPerformZMatchingPS;
       mPerformZMatching2S = aPerformZMatching2S;
+
+      /// Loop on the stacks of the outer tracker, through their lower member
+      for ( auto det : theTrackerGeom->dets() )
+      {
+        DetId detid = det->geographicalId();
+        if ( detid.subdetId() != StripSubdetector::TOB && detid.subdetId() != StripSubdetector::TID ) continue;
+        if ( !theTrackerTopo->isLower(detid) ) continue;
+        DetId stDetId = theTrackerTopo->stack(detid);
+        if ( dynamic_cast< const PixelGeomDetUnit* >( theTrackerGeom->idToDetUnit( stDetId+1 ) ) == nullptr ||
+             dynamic_cast< const PixelGeomDetUnit* >( theTrackerGeom->idToDetUnit( stDetId+2 ) ) == nullptr )
+          continue;
+        theStackGeometry.emplace( stDetId.rawId(), makeStackGeometry( stDetId ) );
+      }
     }
 
     /// Destructor
@@ -78,6 +109,57 @@ class TTStubAlgorithm_official : public TTStubAlgorithm< T >
  *           in the source file.
  */
 
+/// Geometry of a stack
+template< typename T >
+typename TTStubAlgorithm_official< T >::StackGeometry
+TTStubAlgorithm_official< T >::makeStackGeometry( const DetId& stDetId ) const
+{
+  StackGeometry sg;
+  sg.isPS = (this->theTrackerGeom_->getDetectorType(stDetId)==TrackerGeometry::ModuleType::Ph2PSP);
+  // TODO temporary: should use a method from the topology
+  const GeomDetUnit* det0 = this->theTrackerGeom_->idToDetUnit( stDetId+1 );
+  const GeomDetUnit* det1 = this->theTrackerGeom_->idToDetUnit( stDetId+2 );
+
+  /// Find pixel pitch and topology related information
+  const PixelGeomDetUnit* pix0 = dynamic_cast< const PixelGeomDetUnit* >( det0 );
+  const PixelGeomDetUnit* pix1 = dynamic_cast< const PixelGeomDetUnit* >( det1 );
+  const PixelTopology* top0 = dynamic_cast< const PixelTopology* >( &(pix0->specificTopology()) );
+  const PixelTopology* top1 = dynamic_cast< const PixelTopology* >( &(pix1->specificTopology()) );
+  sg.pitchRatio = top0->pitch().first / top1->pitch().first;
+  sg.ratio = top0->ncolumns()/top1->ncolumns(); /// This assumes the ratio is integer!
+  sg.rowCenter0 = top0->nrows()/2 - 0.5;
+
+  /// Get the Stack radius and z and displacements
+  sg.R0 = det0->position().perp();
+  sg.Z0 = det0->position().z();
+  sg.DR = det1->position().perp() - sg.R0;
+  sg.DZ = det1->position().z() - sg.Z0;
+
+  /// The window is taken from the cuts at each correlation if they do not cover the stack
+  sg.hasWindow = false;
+  sg.window = 0;
+  if ( stDetId.subdetId() == StripSubdetector::TOB )
+  {
+    unsigned int layer = this->theTrackerTopo_->layer(stDetId);
+    if ( layer < barrelCut.size() )
+    {
+      sg.hasWindow = true;
+      sg.window = 2*barrelCut[layer];
+    }
+  }
+  else if ( stDetId.subdetId() == StripSubdetector::TID )
+  {
+    unsigned int wheel = this->theTrackerTopo_->tidWheel(stDetId);
+    unsigned int ring = this->theTrackerTopo_->tidRing(stDetId);
+    if ( wheel < ringCut.size() && ring < ringCut[wheel].size() )
+    {
+      sg.hasWindow = true;
+      sg.window = 2*ringCut[wheel][ring];
+    }
+  }
+  return sg;
+}
+
 /// Matching operations
 template< >
 void TTStubAlgorithm_official< Ref_Phase2TrackerDigi_ >::PatternHitCorrelation( bool &aConfirmation,
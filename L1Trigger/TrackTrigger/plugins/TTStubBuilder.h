@@ -36,6 +36,9 @@
 #include <map>
 #include <vector>
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "DataFormats/TrackerCommon/interface/TrackerTopology.h"
 #include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
 
@@ -53,6 +56,23 @@ class TTStubBuilder : public edm::EDProducer
     /// Data members
     edm::ESHandle< TTStubAlgorithm< T > > theStubFindingAlgoHandle;
     edm::EDGetTokenT< TTCluster< T > > clustersToken;
+    /// Find the stubs of the stacks in parallel
+    bool parallelStubs;
+
+    /// The stubs of a stack, with their Clusters, before they are put in the output
+    struct StackStubs
+    {
+      DetId lowerDetid;
+      DetId upperDetid;
+      DetId stackDetid;
+      std::vector< TTCluster< T > > tempInner;
+      std::vector< TTCluster< T > > tempOuter;
+      std::vector< TTStub< T > >    tempOutput;
+    };
+    void findStackStubs( StackStubs& aStack,
+                         const edm::Handle< edmNew::DetSetVector< TTCluster< T > > >& clusterHandle,
+                         const TrackerGeometry* const theTrackerGeom,
+                         unsigned maxStubs ) const;
     
     /// Mandatory methods
     virtual void beginRun( const edm::Run& run, const edm::EventSetup& iSetup );
@@ -77,6 +97,7 @@ template< typename T >
 TTStubBuilder< T >::TTStubBuilder( const edm::ParameterSet& iConfig )
 {
   clustersToken = consumes< TTCluster< T > >(iConfig.getParameter< edm::InputTag >( "TTClusters" ));
+  parallelStubs = iConfig.existsAs< bool >( "parallelStubs" ) ? iConfig.getParameter< bool >( "parallelStubs" ) : false;
   produces< edmNew::DetSetVector< TTCluster< T > > >( "ClusterAccepted" );
   produces< edmNew::DetSetVector< TTStub< T > > >( "StubAccepted" );
   produces< edmNew::DetSetVector< TTStub< T > > >( "StubRejected" );
@@ -130,6 +151,8 @@ void TTStubBuilder< T >::produce( edm::Event& iEvent, const edm::EventSetup& iSe
   //  unsigned maxStubs = theStackedTracker->getCBC3MaxStubs();
   unsigned maxStubs = 3;
 
+  /// The stacks with Clusters in both members
+  std::vector< StackStubs > stacks;
   for (auto gd=theTrackerGeom->dets().begin(); gd != theTrackerGeom->dets().end(); gd++) {
       DetId detid = (*gd)->geographicalId();
       if(detid.subdetId()!=StripSubdetector::TOB && detid.subdetId()!=StripSubdetector::TID ) continue; // only run on OT
@@ -143,127 +166,42 @@ void TTStubBuilder< T >::produce( edm::Event& iEvent, const edm::EventSetup& iSe
          clusterHandle->find( upperDetid ) == clusterHandle->end() )
       continue;
 
-    /// Get the DetSets of the Clusters
-    edmNew::DetSet< TTCluster< T > > lowerClusters = (*clusterHandle)[ lowerDetid ];
-    edmNew::DetSet< TTCluster< T > > upperClusters = (*clusterHandle)[ upperDetid ];
-
     /// If there are Clusters in both sensors
     /// you can try and make a Stub
     /// This is ~redundant
-    if ( lowerClusters.size() == 0 || upperClusters.size() == 0 )
+    if ( (*clusterHandle)[ lowerDetid ].size() == 0 || (*clusterHandle)[ upperDetid ].size() == 0 )
       continue;
 
-    /// Create the vectors of objects to be passed to the FastFillers
-    std::vector< TTCluster< T > > tempInner; 
-    std::vector< TTCluster< T > > tempOuter; 
-    std::vector< TTStub< T > >   tempOutput; 
-    tempInner.clear();
-    tempOuter.clear();
-    tempOutput.clear();
-
-    /// Get chip size information
-    const GeomDetUnit* det0 = theTrackerGeom->idToDetUnit( lowerDetid );
-    const PixelGeomDetUnit* pix0 = dynamic_cast< const PixelGeomDetUnit* >( det0 );
-    const PixelTopology* top0 = dynamic_cast< const PixelTopology* >( &(pix0->specificTopology()) );
-    const int chipSize = 2 * top0->rowsperroc(); /// Need to find ASIC size in half-strip units
-
-    std::map< int, std::vector< TTStub< T > > > moduleStubs; /// Temporary storage for stubs before max check
-
-    /// Loop over pairs of Clusters
-    for ( auto lowerClusterIter = lowerClusters.begin();
-               lowerClusterIter != lowerClusters.end();
-               ++lowerClusterIter ) {
-      for ( auto upperClusterIter = upperClusters.begin();
-                 upperClusterIter != upperClusters.end();
-                 ++upperClusterIter ) {
-
-        /// Build a temporary Stub
-        TTStub< T > tempTTStub( stackDetid );
-        tempTTStub.addClusterRef( edmNew::makeRefTo( clusterHandle, lowerClusterIter ) );
-        tempTTStub.addClusterRef( edmNew::makeRefTo( clusterHandle, upperClusterIter ) );
-
-        /// Check for compatibility
-        bool thisConfirmation = false;
-        int thisDisplacement = 999999;
-        int thisOffset = 0;
-
-        theStubFindingAlgoHandle->PatternHitCorrelation( thisConfirmation, thisDisplacement, thisOffset, tempTTStub );
-
-        /// If the Stub is above threshold
-        if ( thisConfirmation )
-        {
-          tempTTStub.setTriggerDisplacement( thisDisplacement );
-          tempTTStub.setTriggerOffset( thisOffset );
+    stacks.emplace_back();
+    stacks.back().lowerDetid = lowerDetid;
+    stacks.back().upperDetid = upperDetid;
+    stacks.back().stackDetid = stackDetid;
+  } /// End of loop over detector elements
 
-          /// Put in the output
-          if ( maxStubs == 0 )
-          {
-            /// This means that ALL stubs go into the output
-            tempInner.push_back( *lowerClusterIter );
-            tempOuter.push_back( *upperClusterIter );
-            tempOutput.push_back( tempTTStub );
-          }
-          else
-          {
-            /// This means that only some of them do
-            /// Put in the temporary output
-            int chip = tempTTStub.getTriggerPosition() / chipSize; /// Find out which ASIC
-            if ( moduleStubs.find( chip ) == moduleStubs.end() ) /// Already a stub for this ASIC?
-            {
-              /// No, so new entry
-              std::vector< TTStub< T > > tempStubs;
-              tempStubs.push_back( tempTTStub );
-              moduleStubs.insert( std::pair< int, std::vector< TTStub< T > > >( chip, tempStubs ) );
-            }
-            else
-            {
-              /// Already existing entry
-              moduleStubs[chip].push_back( tempTTStub );
-            }
-          }
-        } /// Stub accepted
-      } /// End of nested loop
-    } /// End of loop over pairs of Clusters
+  /// The stubs of each stack depend only on its Clusters
+  if ( parallelStubs )
+  {
+    tbb::parallel_for( tbb::blocked_range< size_t >( 0, stacks.size() ),
+                       [&]( const tbb::blocked_range< size_t >& r ) {
+                         for ( size_t i = r.begin(); i != r.end(); ++i )
+                           findStackStubs( stacks[i], clusterHandle, theTrackerGeom, maxStubs );
+                       } );
+  }
+  else
+  {
+    for ( auto& stack : stacks )
+      findStackStubs( stack, clusterHandle, theTrackerGeom, maxStubs );
+  }
+
+  /// Fill the output in the order of the stacks
+  for ( auto const& stack : stacks ) {
+    DetId lowerDetid = stack.lowerDetid;
+    DetId upperDetid = stack.upperDetid;
+    DetId stackDetid = stack.stackDetid;
+    const std::vector< TTCluster< T > >& tempInner = stack.tempInner;
+    const std::vector< TTCluster< T > >& tempOuter = stack.tempOuter;
+    const std::vector< TTStub< T > >&   tempOutput = stack.tempOutput;
 
-    /// If we are working with max no. stub/ROC, then clean the temporary output
-    /// and store only the selected stubs
-    if ( moduleStubs.empty() == false )
-    {
-      /// Loop over ROC's
-      /// the ROC ID is not important
-      for ( auto const & is : moduleStubs )
-      {
-        /// Put the stubs into the output
-        if ( is.second.size() <= maxStubs )
-        {
-          for ( auto const & ts: is.second )
-          {
-            tempInner.push_back( *(ts.getClusterRef(0)) );
-            tempOuter.push_back( *(ts.getClusterRef(1)) );
-            tempOutput.push_back( ts );
-          }
-        }
-        else
-        {
-          /// Sort them and pick up only the first N.
-          std::vector< std::pair< unsigned int, double > > bendMap;
-          bendMap.reserve(is.second.size());
-          for ( unsigned int i = 0; i < is.second.size(); ++i )
-          {
-            bendMap.push_back( std::pair< unsigned int, double >( i, is.second[i].getTriggerBend() ) );
-          }
-          std::sort( bendMap.begin(), bendMap.end(), TTStubBuilder< T >::SortStubBendPairs );
-
-          for ( unsigned int i = 0; i < maxStubs; ++i )
-          {
-            /// Put the highest momenta (lowest bend) stubs into the event
-            tempInner.push_back( *(is.second[bendMap[i].first].getClusterRef(0)) );
-            tempOuter.push_back( *(is.second[bendMap[i].first].getClusterRef(1)) );
-            tempOutput.push_back( is.second[bendMap[i].first] );
-          }
-        }
-      } /// End of loop over temp output
-    } /// End store only the selected stubs if max no. stub/ROC is set
     /// Create the FastFillers
     if ( tempInner.size() > 0 )
     {
@@ -298,7 +236,7 @@ void TTStubBuilder< T >::produce( edm::Event& iEvent, const edm::EventSetup& iSe
         tempOutputFiller.abort();
     }
 
-  } /// End of loop over detector elements
+  } /// End of loop over stacks
 
   /// Put output in the event (1)
   /// Get also the OrphanHandle of the accepted clusters
@@ -381,6 +319,133 @@ void TTStubBuilder< T >::produce( edm::Event& iEvent, const edm::EventSetup& iSe
   iEvent.put( TTStubDSVForOutputRejected, "StubRejected" );
 }
 
+/// Stubs of one stack
+template< typename T >
+void TTStubBuilder< T >::findStackStubs( StackStubs& aStack,
+                                         const edm::Handle< edmNew::DetSetVector< TTCluster< T > > >& clusterHandle,
+                                         const TrackerGeometry* const theTrackerGeom,
+                                         unsigned maxStubs ) const
+{
+  DetId lowerDetid = aStack.lowerDetid;
+  DetId stackDetid = aStack.stackDetid;
+
+  /// Get the DetSets of the Clusters
+  edmNew::DetSet< TTCluster< T > > lowerClusters = (*clusterHandle)[ lowerDetid ];
+  edmNew::DetSet< TTCluster< T > > upperClusters = (*clusterHandle)[ aStack.upperDetid ];
+
+  /// Create the vectors of objects to be passed to the FastFillers
+  std::vector< TTCluster< T > >& tempInner = aStack.tempInner;
+  std::vector< TTCluster< T > >& tempOuter = aStack.tempOuter;
+  std::vector< TTStub< T > >&   tempOutput = aStack.tempOutput;
+  tempInner.clear();
+  tempOuter.clear();
+  tempOutput.clear();
+
+  /// Get chip size information
+  const GeomDetUnit* det0 = theTrackerGeom->idToDetUnit( lowerDetid );
+  const PixelGeomDetUnit* pix0 = dynamic_cast< const PixelGeomDetUnit* >( det0 );
+  const PixelTopology* top0 = dynamic_cast< const PixelTopology* >( &(pix0->specificTopology()) );
+  const int chipSize = 2 * top0->rowsperroc(); /// Need to find ASIC size in half-strip units
+
+  std::map< int, std::vector< TTStub< T > > > moduleStubs; /// Temporary storage for stubs before max check
+
+  /// Loop over pairs of Clusters
+  for ( auto lowerClusterIter = lowerClusters.begin();
+             lowerClusterIter != lowerClusters.end();
+             ++lowerClusterIter ) {
+    for ( auto upperClusterIter = upperClusters.begin();
+               upperClusterIter != upperClusters.end();
+               ++upperClusterIter ) {
+
+      /// Build a temporary Stub
+      TTStub< T > tempTTStub( stackDetid );
+      tempTTStub.addClusterRef( edmNew::makeRefTo( clusterHandle, lowerClusterIter ) );
+      tempTTStub.addClusterRef( edmNew::makeRefTo( clusterHandle, upperClusterIter ) );
+
+      /// Check for compatibility
+      bool thisConfirmation = false;
+      int thisDisplacement = 999999;
+      int thisOffset = 0;
+
+      theStubFindingAlgoHandle->PatternHitCorrelation( thisConfirmation, thisDisplacement, thisOffset, tempTTStub );
+
+      /// If the Stub is above threshold
+      if ( thisConfirmation )
+      {
+        tempTTStub.setTriggerDisplacement( thisDisplacement );
+        tempTTStub.setTriggerOffset( thisOffset );
+
+        /// Put in the output
+        if ( maxStubs == 0 )
+        {
+          /// This means that ALL stubs go into the output
+          tempInner.push_back( *lowerClusterIter );
+          tempOuter.push_back( *upperClusterIter );
+          tempOutput.push_back( tempTTStub );
+        }
+        else
+        {
+          /// This means that only some of them do
+          /// Put in the temporary output
+          int chip = tempTTStub.getTriggerPosition() / chipSize; /// Find out which ASIC
+          if ( moduleStubs.find( chip ) == moduleStubs.end() ) /// Already a stub for this ASIC?
+          {
+            /// No, so new entry
+            std::vector< TTStub< T > > tempStubs;
+            tempStubs.push_back( tempTTStub );
+            moduleStubs.insert( std::pair< int, std::vector< TTStub< T > > >( chip, tempStubs ) );
+          }
+          else
+          {
+            /// Already existing entry
+            moduleStubs[chip].push_back( tempTTStub );
+          }
+        }
+      } /// Stub accepted
+    } /// End of nested loop
+  } /// End of loop over pairs of Clusters
+
+  /// If we are working with max no. stub/ROC, then clean the temporary output
+  /// and store only the selected stubs
+  if ( moduleStubs.empty() == false )
+  {
+    /// Loop over ROC's
+    /// the ROC ID is not important
+    for ( auto const & is : moduleStubs )
+    {
+      /// Put the stubs into the output
+      if ( is.second.size() <= maxStubs )
+      {
+        for ( auto const & ts: is.second )
+        {
+          tempInner.push_back( *(ts.getClusterRef(0)) );
+          tempOuter.push_back( *(ts.getClusterRef(1)) );
+          tempOutput.push_back( ts );
+        }
+      }
+      else
+      {
+        /// Sort them and pick up only the first N.
+        std::vector< std::pair< unsigned int, double > > bendMap;
+        bendMap.reserve(is.second.size());
+        for ( unsigned int i = 0; i < is.second.size(); ++i )
+        {
+          bendMap.push_back( std::pair< unsigned int, double >( i, is.second[i].getTriggerBend() ) );
+        }
+        std::sort( bendMap.begin(), bendMap.end(), TTStubBuilder< T >::SortStubBendPairs );
+
+        for ( unsigned int i = 0; i < maxStubs; ++i )
+        {
+          /// Put the highest momenta (lowest bend) stubs into the event
+          tempInner.push_back( *(is.second[bendMap[i].first].getClusterRef(0)) );
+          tempOuter.push_back( *(is.second[bendMap[i].first].getClusterRef(1)) );
+          tempOutput.push_back( is.second[bendMap[i].first] );
+        }
+      }
+    } /// End of loop over temp output
+  } /// End store only the selected stubs if max no. stub/ROC is set
+}
+
 /// Sort routine for stub ordering
 template< typename T >
 bool TTStubBuilder< T >::SortStubBendPairs( const std::pair< unsigned int, double >& left, const std::pair< unsigned int, double >& right )
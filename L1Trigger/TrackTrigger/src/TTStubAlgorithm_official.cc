@@ -22,29 +22,16 @@ void TTStubAlgorithm_official< Ref_Phase2TrackerDigi_ >::PatternHitCorrelation(
   MeasurementPoint mp0 = aTTStub.getClusterRef(0)->findAverageLocalCoordinates();
   MeasurementPoint mp1 = aTTStub.getClusterRef(1)->findAverageLocalCoordinates();
 
-  /// Get the module position in global coordinates
-  bool isPS = (theTrackerGeom_->getDetectorType(aTTStub.getDetId())==TrackerGeometry::ModuleType::Ph2PSP);
-  // TODO temporary: should use a method from the topology
+  /// Get the geometry of the stack
   DetId stDetId( aTTStub.getDetId() );
-  const GeomDetUnit* det0 = theTrackerGeom_->idToDetUnit( stDetId+1 );
-  const GeomDetUnit* det1 = theTrackerGeom_->idToDetUnit( stDetId+2 );
-
-  /// Find pixel pitch and topology related information
-  const PixelGeomDetUnit* pix0 = dynamic_cast< const PixelGeomDetUnit* >( det0 );
-  const PixelGeomDetUnit* pix1 = dynamic_cast< const PixelGeomDetUnit* >( det1 );
-  const PixelTopology* top0 = dynamic_cast< const PixelTopology* >( &(pix0->specificTopology()) );
-  const PixelTopology* top1 = dynamic_cast< const PixelTopology* >( &(pix1->specificTopology()) );
-  std::pair< float, float > pitch0 = top0->pitch();
-  std::pair< float, float > pitch1 = top1->pitch();
+  auto itGeometry = theStackGeometry.find( stDetId.rawId() );
+  const StackGeometry sg = ( itGeometry != theStackGeometry.end() ) ? itGeometry->second : makeStackGeometry( stDetId );
 
   /// Stop if the clusters are not in the same z-segment
-  int cols0 = top0->ncolumns();
-  int cols1 = top1->ncolumns();
-  int ratio = cols0/cols1; /// This assumes the ratio is integer!
-  int segment0 = floor( mp0.y() / ratio );
+  int segment0 = floor( mp0.y() / sg.ratio );
 
 //  if ( ratio == 1 ) /// 2S Modules
-  if (!isPS)
+  if (!sg.isPS)
   {
     if ( mPerformZMatching2S && ( segment0 != floor( mp1.y() ) ) )
       return;
@@ -55,15 +42,6 @@ void TTStubAlgorithm_official< Ref_Phase2TrackerDigi_ >::PatternHitCorrelation(
       return;
   }
 
-  /// Get the Stack radius and z and displacements
-  double R0 = det0->position().perp();
-  double R1 = det1->position().perp();
-  double Z0 = det0->position().z();
-  double Z1 = det1->position().z();
-
-  double DR = R1-R0;
-  double DZ = Z1-Z0;
-
   /// Scale factor is already present in
   /// double mPtScalingFactor = (floor(mMagneticFieldStrength*10.0 + 0.5))/10.0*0.0015/mPtThreshold;
   /// hence the formula iis something like
@@ -71,7 +49,7 @@ void TTStubAlgorithm_official< Ref_Phase2TrackerDigi_ >::PatternHitCorrelation(
 
   if (stDetId.subdetId()==StripSubdetector::TOB)
   {
-    int window = 2*barrelCut.at( theTrackerTopo_->layer(stDetId) );
+    int window = sg.hasWindow ? sg.window : 2*barrelCut.at( theTrackerTopo_->layer(stDetId) );
     /// POSITION IN TERMS OF PITCH MULTIPLES:
     ///       0 1 2 3 4 5 5 6 8 9 ...
     /// COORD: 0 1 2 3 4 5 6 7 8 9 ...
@@ -82,13 +60,13 @@ void TTStubAlgorithm_official< Ref_Phase2TrackerDigi_ >::PatternHitCorrelation(
     /// 1) disp is the difference between average row coordinates
     ///    in inner and outer stack member, in terms of outer member pitch
     ///    (in case they are the same, this is just a plain coordinate difference)
-    double dispD = 2 * (mp1.x() - mp0.x()) * (pitch0.first / pitch1.first); /// In HALF-STRIP units!
+    double dispD = 2 * (mp1.x() - mp0.x()) * sg.pitchRatio; /// In HALF-STRIP units!
     int dispI = ((dispD>0)-(dispD<0))*floor(fabs(dispD)); /// In HALF-STRIP units!
     /// 2) offset is the projection with a straight line of the innermost
     ///    hit towards the ourermost stack member, still in terms of outer member pitch
     ///    NOTE: in terms of coordinates, the center of the module is at NROWS/2-0.5 to
     ///    be consistent with the definition given above 
-    double offsetD = 2 * DR/R0 * ( mp0.x() - (top0->nrows()/2 - 0.5) ) * (pitch0.first / pitch1.first); /// In HALF-STRIP units!
+    double offsetD = 2 * sg.DR/sg.R0 * ( mp0.x() - sg.rowCenter0 ) * sg.pitchRatio; /// In HALF-STRIP units!
     int offsetI = ((offsetD>0)-(offsetD<0))*floor(fabs(offsetD)); /// In HALF-STRIP units!
 
     /// Accept the stub if the post-offset correction displacement is smaller than the half-window
@@ -103,17 +81,17 @@ void TTStubAlgorithm_official< Ref_Phase2TrackerDigi_ >::PatternHitCorrelation(
   {
     /// All of these are calculated in terms of pixels in outer sensor
     /// 0) Calculate window in terms of multiples of outer sensor pitch
-    int window = 2*(ringCut.at( theTrackerTopo_->tidWheel(stDetId))).at(theTrackerTopo_->tidRing(stDetId));
+    int window = sg.hasWindow ? sg.window : 2*(ringCut.at( theTrackerTopo_->tidWheel(stDetId))).at(theTrackerTopo_->tidRing(stDetId));
     /// 1) disp is the difference between average row coordinates
     ///    in inner and outer stack member, in terms of outer member pitch
     ///    (in case they are the same, this is just a plain coordinate difference)
-    double dispD = 2 * (mp1.x() - mp0.x()) * (pitch0.first / pitch1.first); /// In HALF-STRIP units!
+    double dispD = 2 * (mp1.x() - mp0.x()) * sg.pitchRatio; /// In HALF-STRIP units!
     int dispI = ((dispD>0)-(dispD<0))*floor(fabs(dispD)); /// In HALF-STRIP units!
     /// 2) offset is the projection with a straight line of the innermost
     ///    hit towards the ourermost stack member, still in terms of outer member pitch
     ///    NOTE: in terms of coordinates, the center of the module is at NROWS/2-0.5 to
     ///    be consistent with the definition given above 
-    double offsetD = 2 * DZ/Z0 * ( mp0.x() - (top0->nrows()/2 - 0.5) ) * (pitch0.first / pitch1.first); /// In HALF-STRIP units!
+    double offsetD = 2 * sg.DZ/sg.Z0 * ( mp0.x() - sg.rowCenter0 ) * sg.pitchRatio; /// In HALF-STRIP units!
     int offsetI = ((offsetD>0)-(offsetD<0))*floor(fabs(offsetD)); /// In HALF-STRIP units!
 
     /// Accept the stub if the post-offset correction displacement is smaller than the half-window
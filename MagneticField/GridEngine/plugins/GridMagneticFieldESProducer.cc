@@ -0,0 +1,75 @@
+#include "MagneticField/GridEngine/plugins/GridMagneticFieldESProducer.h"
+#include "MagneticField/GridEngine/src/GridMagneticField.h"
+
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cmath>
+#include <random>
+
+using namespace magneticfield;
+
+GridMagneticFieldESProducer::GridMagneticFieldESProducer(const edm::ParameterSet& pset) :
+  fullMapLabel(pset.getParameter<std::string>("fullMapLabel")),
+  rMax(pset.getParameter<double>("rMax")),
+  zMax(pset.getParameter<double>("zMax")),
+  nR(pset.getParameter<unsigned int>("nR")),
+  nPhi(pset.getParameter<unsigned int>("nPhi")),
+  nZ(pset.getParameter<unsigned int>("nZ")),
+  validationPoints(pset.getUntrackedParameter<unsigned int>("validationPoints",0))
+{
+  std::string label = pset.getUntrackedParameter<std::string>("label","");
+  if (label == fullMapLabel) {
+    throw cms::Exception("Configuration") << "GridMagneticFieldESProducer: the grid and the full map it is sampled from "
+					  << "have the same label \"" << label << "\"";
+  }
+  if (nR == 0 || nPhi == 0 || nZ == 0 || !(rMax > 0) || !(zMax > 0)) {
+    throw cms::Exception("Configuration") << "GridMagneticFieldESProducer: empty grid";
+  }
+  setWhatProduced(this, label);
+}
+
+
+std::unique_ptr<MagneticField> GridMagneticFieldESProducer::produce(const IdealMagneticFieldRecord & iRecord)
+{
+  edm::ESHandle<MagneticField> fullMap;
+  iRecord.get(fullMapLabel, fullMap);
+
+  auto field = std::make_unique<GridMagneticField>(*fullMap, rMax, zMax, nR, nPhi, nZ);
+  if (validationPoints > 0) validate(*field, *fullMap);
+  return std::move(field);
+}
+
+
+void GridMagneticFieldESProducer::validate(const GridMagneticField& grid, const MagneticField& fullMap) const
+{
+  // fixed seed, for the report to be reproducible
+  std::mt19937 engine(12345);
+  std::uniform_real_distribution<float> r2(0, rMax*rMax), phi(-M_PI, M_PI), z(-zMax, zMax);
+
+  double sum = 0, sum2 = 0, maxDev = 0, maxRel = 0;
+  GlobalPoint maxPoint;
+  for (unsigned int i = 0; i < validationPoints; ++i) {
+    float r = std::sqrt(r2(engine)), p = phi(engine);
+    GlobalPoint gp(r*std::cos(p), r*std::sin(p), z(engine));
+    GlobalVector full = fullMap.inTesla(gp);
+    float dev = (grid.inTesla(gp) - full).mag();
+    sum += dev;
+    sum2 += dev*dev;
+    if (dev > maxDev) { maxDev = dev; maxPoint = gp; }
+    if (full.mag() > 0.1f) maxRel = std::max(maxRel, double(dev/full.mag()));
+  }
+
+  edm::LogInfo("GridMagneticField") << "Grid of " << nR << " x " << nPhi << " x " << nZ << " cells for r < " << rMax
+				    << ", |z| < " << zMax << " compared with the full map at " << validationPoints << " points:"
+				    << "\n  mean |dB| " << sum/validationPoints << " T, rms " << std::sqrt(sum2/validationPoints) << " T"
+				    << "\n  max |dB| " << maxDev << " T at (r,phi,z) = (" << maxPoint.perp() << ", " << maxPoint.phi()
+				    << ", " << maxPoint.z() << ")"
+				    << "\n  max |dB|/|B| " << maxRel << " (where |B| > 0.1 T)";
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(GridMagneticFieldESProducer);
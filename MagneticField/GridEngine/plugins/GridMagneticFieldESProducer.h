@@ -0,0 +1,44 @@
+#ifndef GridMagneticFieldESProducer_h
+#define GridMagneticFieldESProducer_h
+
+/** \class GridMagneticFieldESProducer
+ *
+ *  Producer for the GridMagneticField, sampled from the MagneticField
+ *  with label "fullMapLabel" of the same record.  If "validationPoints"
+ *  is set, the grid is compared with the full map at as many random
+ *  points of the grid volume and the deviation is reported.
+ */
+
+#include "FWCore/Framework/interface/ESProducer.h"
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <string>
+
+class IdealMagneticFieldRecord;
+class GridMagneticField;
+
+namespace magneticfield {
+  class GridMagneticFieldESProducer : public edm::ESProducer {
+  public:
+    GridMagneticFieldESProducer(const edm::ParameterSet& pset);
+
+    std::unique_ptr<MagneticField> produce(const IdealMagneticFieldRecord &);
+
+  private:
+    // forbid copy ctor and assignment op.
+    GridMagneticFieldESProducer(const GridMagneticFieldESProducer&);
+    const GridMagneticFieldESProducer& operator=(const GridMagneticFieldESProducer&);
+
+    void validate(const GridMagneticField& grid, const MagneticField& fullMap) const;
+
+    std::string fullMapLabel;
+    float rMax, zMax;
+    unsigned int nR, nPhi, nZ;
+    unsigned int validationPoints;
+  };
+}
+
+
+#endif
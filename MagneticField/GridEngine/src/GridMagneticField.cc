@@ -0,0 +1,75 @@
+#include "MagneticField/GridEngine/src/GridMagneticField.h"
+#include "DataFormats/Math/interface/approx_atan2.h"
+
+#include <algorithm>
+
+GridMagneticField::GridMagneticField(const MagneticField& fullMap, float rMax, float zMax,
+				     unsigned int nR, unsigned int nPhi, unsigned int nZ) :
+  theFullMap(fullMap),
+  theRMax(rMax), theZMax(zMax),
+  theNR(nR), theNPhi(nPhi), theNZ(nZ),
+  theRScale(nR/rMax), thePhiScale(nPhi/(2*M_PI)), theZScale(nZ/(2*zMax)),
+  theNodes((nR+1)*(nPhi+1)*(nZ+1))
+{
+  auto node = theNodes.begin();
+  for (unsigned int iz = 0; iz <= nZ; ++iz) {
+    float z = -zMax + iz/theZScale;
+    for (unsigned int iphi = 0; iphi <= nPhi; ++iphi) {
+      // the last phi node is the first one again
+      float phi = -M_PI + (iphi%nPhi)/thePhiScale;
+      for (unsigned int ir = 0; ir <= nR; ++ir, ++node) {
+	float r = ir/theRScale;
+	GlobalVector b = fullMap.inTesla(GlobalPoint(r*std::cos(phi), r*std::sin(phi), z));
+	*node = Node{b.x(), b.y(), b.z()};
+      }
+    }
+  }
+}
+
+inline void GridMagneticField::interpolate(float x, float y, float z, float& bx, float& by, float& bz) const {
+  // fractional cell coordinates, clamped to the grid
+  float r = std::sqrt(x*x+y*y);
+  float phi = safe_atan2f<9>(y,x);
+  float fr = std::min(r*theRScale, theNR*0.99999f);
+  float fphi = std::min(std::max((phi+float(M_PI))*thePhiScale, 0.f), theNPhi*0.99999f);
+  float fz = std::min(std::max((z+theZMax)*theZScale, 0.f), theNZ*0.99999f);
+  unsigned int ir = fr, iphi = fphi, iz = fz;
+  float dr = fr-ir, dphi = fphi-iphi, dz = fz-iz;
+
+  unsigned int strideR = 1, stridePhi = theNR+1, strideZ = stridePhi*(theNPhi+1);
+  const Node* n = &theNodes[iz*strideZ + iphi*stridePhi + ir];
+  float w[8] = { (1-dz)*(1-dphi)*(1-dr), (1-dz)*(1-dphi)*dr, (1-dz)*dphi*(1-dr), (1-dz)*dphi*dr,
+		 dz*(1-dphi)*(1-dr),     dz*(1-dphi)*dr,     dz*dphi*(1-dr),     dz*dphi*dr };
+  unsigned int offset[8] = { 0, strideR, stridePhi, stridePhi+strideR,
+			     strideZ, strideZ+strideR, strideZ+stridePhi, strideZ+stridePhi+strideR };
+  bx = by = bz = 0;
+  for (unsigned int i = 0; i < 8; ++i) {
+    bx += w[i]*n[offset[i]].x;
+    by += w[i]*n[offset[i]].y;
+    bz += w[i]*n[offset[i]].z;
+  }
+}
+
+GlobalVector GridMagneticField::inTesla(const GlobalPoint& gp) const {
+  if likely(inGrid(gp)) return inTeslaUnchecked(gp);
+  return theFullMap.inTesla(gp);
+}
+
+GlobalVector GridMagneticField::inTeslaUnchecked(const GlobalPoint& gp) const {
+  float bx, by, bz;
+  interpolate(gp.x(), gp.y(), gp.z(), bx, by, bz);
+  return GlobalVector(bx, by, bz);
+}
+
+void GridMagneticField::inTeslaBatch(unsigned int n, const float* x, const float* y, const float* z,
+				     float* bx, float* by, float* bz) const {
+  for (unsigned int i = 0; i < n; ++i) interpolate(x[i], y[i], z[i], bx[i], by[i], bz[i]);
+  // the points outside the grid are then taken from the full map
+  for (unsigned int i = 0; i < n; ++i) {
+    GlobalPoint gp(x[i], y[i], z[i]);
+    if unlikely(!inGrid(gp)) {
+      GlobalVector b = theFullMap.inTesla(gp);
+      bx[i] = b.x(); by[i] = b.y(); bz[i] = b.z();
+    }
+  }
+}
@@ -0,0 +1,57 @@
+#ifndef MagneticField_GridMagneticField_h
+#define MagneticField_GridMagneticField_h
+
+/** \class GridMagneticField
+ *
+ *  A MagneticField engine that samples another one (typically the full,
+ *  volume based map) once, on a uniform grid in cylindrical coordinates
+ *  (r, phi, z), and answers by trilinear interpolation of the cartesian
+ *  field components at the eight surrounding nodes.  The interpolation
+ *  has no branches: the grid indices are clamped and phi is wrapped with
+ *  an extra node.  Outside the grid the sampled map is queried, so it
+ *  must outlive this engine.
+ */
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+
+#include <cmath>
+#include <vector>
+
+class GridMagneticField : public MagneticField {
+ public:
+
+  /// Sample fullMap for r < rMax and |z| < zMax, in nR x nPhi x nZ cells
+  GridMagneticField(const MagneticField& fullMap, float rMax, float zMax,
+		    unsigned int nR, unsigned int nPhi, unsigned int nZ);
+
+  virtual ~GridMagneticField() {}
+
+  GlobalVector inTesla (const GlobalPoint& gp) const;
+
+  GlobalVector inTeslaUnchecked (const GlobalPoint& gp) const;
+
+  bool isDefined(const GlobalPoint& gp) const {return inGrid(gp) || theFullMap.isDefined(gp);}
+
+  /// Field in Tesla at the n points (x[i],y[i],z[i]) into (bx[i],by[i],bz[i]);
+  /// the points inside the grid are interpolated in a vectorizable loop
+  void inTeslaBatch(unsigned int n, const float* x, const float* y, const float* z,
+		    float* bx, float* by, float* bz) const;
+
+  /// True if gp is covered by the grid
+  bool inGrid(const GlobalPoint& gp) const {
+    return gp.perp2() < theRMax*theRMax && std::abs(gp.z()) < theZMax;
+  }
+
+ private:
+  struct Node { float x, y, z; };
+
+  void interpolate(float x, float y, float z, float& bx, float& by, float& bz) const;
+
+  const MagneticField& theFullMap;
+  float theRMax, theZMax;
+  unsigned int theNR, theNPhi, theNZ;  // number of cells
+  float theRScale, thePhiScale, theZScale;  // cells per unit
+  std::vector<Node> theNodes;  // (nR+1) x (nPhi+1) x (nZ+1), r fastest
+};
+
+#endif
@@ -4,6 +4,10 @@
 /** \class MagGeometry
  *  Entry point to the geometry of magnetic volumes.
  *
+ *  The volume search is cached: each thread remembers the last volume it
+ *  found, and the last volume found in each (r,z,phi) bin is shared by all
+ *  threads, so that the hierarchical search is only needed when both miss.
+ *
  *  \author N. Amapane - INFN Torino
  */
 
@@ -13,6 +17,7 @@
 
 #include <vector>
 #include <atomic>
+#include <memory>
 
 class MagBLayer;
 class MagESector;
@@ -62,7 +67,9 @@ private:
 
   bool inBarrel(const GlobalPoint& gp) const;
 
-  mutable std::atomic<MagVolume const*> lastVolume; // Cache last volume found
+  unsigned int theCacheId; // Identifies the per-thread cache of this geometry
+  // Cache last volume found in each (r,z,phi) bin
+  std::unique_ptr<std::atomic<MagVolume const*>[]> theBinVolumes;
 
   std::vector<MagBLayer const*> theBLayers;
   std::vector<MagESector const*> theESectors;
@@ -20,6 +20,34 @@
 using namespace std;
 using namespace edm;
 
+namespace {
+  // Per-thread cache of the last volume found, for a few geometries at a time.
+  // The geometries are identified by a unique id, not by address, so that the
+  // entries of a deleted geometry are never used.
+  struct LastVolume {
+    unsigned int geometry = 0;
+    MagVolume const* volume = nullptr;
+  };
+  constexpr unsigned int kThreadCacheSize = 4;
+  thread_local LastVolume s_lastVolume[kThreadCacheSize];
+  std::atomic<unsigned int> s_nGeometries(0);
+
+  // Bins of the shared volume cache
+  constexpr float kBinR = 20., kBinZ = 25., kMaxR = 1000., kMaxZ = 2000.;
+  constexpr unsigned int kNBinsR = kMaxR/kBinR, kNBinsZ = 2*kMaxZ/kBinZ, kNBinsPhi = 12;
+  constexpr unsigned int kNBins = kNBinsR*kNBinsZ*kNBinsPhi;
+
+  // -1 outside of the binned region (or for invalid input)
+  int volumeBin(const GlobalPoint & gp) {
+    float r = gp.perp();
+    float z = gp.z() + kMaxZ;
+    if (!(r < kMaxR && z >= 0 && z < 2*kMaxZ)) return -1;
+    float phi = gp.barePhi() + Geom::fpi();
+    unsigned int iphi = std::min((unsigned int)(phi*(kNBinsPhi/Geom::ftwoPi())), kNBinsPhi-1);
+    return ((unsigned int)(z/kBinZ)*kNBinsR + (unsigned int)(r/kBinR))*kNBinsPhi + iphi;
+  }
+}
+
 MagGeometry::MagGeometry(int geomVersion, const std::vector<MagBLayer *>& tbl,
 			 const std::vector<MagESector *>& tes,
 			 const std::vector<MagVolume6Faces*>& tbv,
@@ -31,8 +59,11 @@ MagGeometry::MagGeometry(int geomVersion, const std::vector<MagBLayer const*>& t
 			 const std::vector<MagESector const*>& tes,
 			 const std::vector<MagVolume6Faces const*>& tbv,
 			 const std::vector<MagVolume6Faces const*>& tev) : 
-  lastVolume(0), theBLayers(tbl), theESectors(tes), theBVolumes(tbv), theEVolumes(tev), cacheLastVolume(true), geometryVersion(geomVersion)
+  theCacheId(++s_nGeometries), theBinVolumes(new std::atomic<MagVolume const*>[kNBins]),
+  theBLayers(tbl), theESectors(tes), theBVolumes(tbv), theEVolumes(tev), cacheLastVolume(true), geometryVersion(geomVersion)
 {
+  for (unsigned int i = 0; i < kNBins; ++i) theBinVolumes[i].store(nullptr, std::memory_order_relaxed);
+
   vector<double> rBorders;
 
   for (vector<MagBLayer const*>::const_iterator ilay = theBLayers.begin();
@@ -135,10 +166,22 @@ MagGeometry::findVolume1(const GlobalPoint & gp, double tolerance) const {
 // Use hierarchical structure for fast lookup.
 MagVolume const* 
 MagGeometry::findVolume(const GlobalPoint & gp, double tolerance) const{
-  // Check volume cache
-  auto lastVolumeCheck = lastVolume.load(std::memory_order_acquire);
-  if (lastVolumeCheck!=nullptr && lastVolumeCheck->inside(gp)){
-    return lastVolumeCheck;
+  // Check the volume caches: last volume of this thread, then of the bin
+  LastVolume & last = s_lastVolume[theCacheId%kThreadCacheSize];
+  int cacheBin = -1;
+  if (cacheLastVolume) {
+    if (last.geometry==theCacheId && last.volume->inside(gp)) {
+      return last.volume;
+    }
+    cacheBin = volumeBin(gp);
+    if (cacheBin >= 0) {
+      auto binVolume = theBinVolumes[cacheBin].load(std::memory_order_acquire);
+      if (binVolume!=nullptr && binVolume->inside(gp)) {
+	last.geometry = theCacheId;
+	last.volume = binVolume;
+	return binVolume;
+      }
+    }
   }
 
   MagVolume const* result=0;
@@ -175,7 +218,11 @@ MagGeometry::findVolume(const GlobalPoint & gp, double tolerance) const{
     result = findVolume(gp, 0.03);
   }
 
-  if (cacheLastVolume) lastVolume.store(result,std::memory_order_release);
+  if (cacheLastVolume && result!=0) {
+    last.geometry = theCacheId;
+    last.volume = result;
+    if (cacheBin >= 0) theBinVolumes[cacheBin].store(result,std::memory_order_release);
+  }
 
   return result;
 }
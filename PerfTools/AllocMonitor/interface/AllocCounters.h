@@ -0,0 +1,45 @@
+#ifndef PerfTools_AllocMonitor_AllocCounters_h
+#define PerfTools_AllocMonitor_AllocCounters_h
+// -*- C++ -*-
+//
+// Package:     PerfTools/AllocMonitor
+// Class  :     edm_alloc_counters
+//
+/**\class edm_alloc_counters AllocCounters.h "PerfTools/AllocMonitor/interface/AllocCounters.h"
+
+ Description: Counters filled by the libPerfToolsAllocMonitor.so preload library
+
+ Usage:
+    When a job is started with
+       LD_PRELOAD=libPerfToolsAllocMonitor.so cmsRun ...
+    each call to malloc, free and their relatives is added to the counters
+    which the calling thread registered by calling the function named
+    edm::allocmonitor::kSetCountersFunctionName. Passing nullptr stops the
+    accounting for that thread. The counters are only ever touched by the
+    thread which registered them so they need no synchronization.
+
+    The library is looked up with dlsym so users of these counters must not
+    link against it.
+*/
+//
+
+extern "C" {
+  struct edm_alloc_counters {
+    unsigned long long nAllocations;
+    unsigned long long nDeallocations;
+    unsigned long long bytesAllocated;
+    unsigned long long bytesDeallocated;
+    //allocated minus deallocated since the counters were registered
+    long long liveBytes;
+    long long maxLiveBytes;
+  };
+
+  typedef void (*edm_alloc_monitor_set_counters_t)(edm_alloc_counters*);
+}
+
+namespace edm {
+  namespace allocmonitor {
+    char const* const kSetCountersFunctionName = "edm_alloc_monitor_set_counters";
+  }
+}
+#endif
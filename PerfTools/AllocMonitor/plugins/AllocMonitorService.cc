@@ -0,0 +1,220 @@
+// -*- C++ -*-
+//
+// Package:     PerfTools/AllocMonitor
+// Class  :     AllocMonitorService
+//
+// Implementation:
+//     Each time a module starts its event transition a fresh set of
+//  edm_alloc_counters is registered for the thread with the preload
+//  library. When the module finishes the counters are added to the totals
+//  for that module and, if it was run from a Path, to the totals of that
+//  Path. Modules run from within another module (e.g. unscheduled ones)
+//  get their own counters, so their allocations are not included in the
+//  module (or Path) which triggered them.
+//     Frees are attributed to the module running when the free happens,
+//  so memory made by one module and released by another shows up as
+//  a negative net for the releasing module.
+//
+
+// system include files
+#include <atomic>
+#include <dlfcn.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// user include files
+#include "PerfTools/AllocMonitor/interface/AllocCounters.h"
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/JobReport.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/PathContext.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
+#include "FWCore/ServiceRegistry/interface/PlaceInPathContext.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+
+namespace edm {
+  namespace service {
+    class AllocMonitorService {
+    public:
+      AllocMonitorService(ParameterSet const&, ActivityRegistry&);
+
+      AllocMonitorService(AllocMonitorService const&) = delete;
+      AllocMonitorService& operator=(AllocMonitorService const&) = delete;
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      struct Totals {
+        std::atomic<unsigned long long> nCalls{0};
+        std::atomic<unsigned long long> nAllocations{0};
+        std::atomic<unsigned long long> nDeallocations{0};
+        std::atomic<unsigned long long> bytesAllocated{0};
+        std::atomic<unsigned long long> bytesDeallocated{0};
+        std::atomic<long long> maxLiveBytesInCall{0};
+
+        void add(edm_alloc_counters const& iCounters);
+        std::map<std::string, std::string> metrics() const;
+      };
+
+      void preBeginJob(PathsAndConsumesOfModulesBase const&, ProcessContext const&);
+      void preModuleEvent(StreamContext const&, ModuleCallingContext const&);
+      void postModuleEvent(StreamContext const&, ModuleCallingContext const&);
+      void postEndJob();
+
+      edm_alloc_monitor_set_counters_t setCounters_;
+      //indexed by module id
+      std::vector<std::string> moduleLabels_;
+      std::unique_ptr<Totals[]> moduleTotals_;
+      //trigger paths followed by the end paths
+      std::vector<std::string> pathNames_;
+      std::unique_ptr<Totals[]> pathTotals_;
+      unsigned int nTriggerPaths_;
+    };
+  }
+}
+
+using namespace edm::service;
+
+namespace {
+  //modules can run other modules (e.g. unscheduled) so keep a stack per thread
+  constexpr unsigned int kMaxDepth = 32;
+  struct ThreadCounters {
+    edm_alloc_counters frames[kMaxDepth];
+    unsigned int depth;
+  };
+  thread_local ThreadCounters t_counters;
+}
+
+AllocMonitorService::AllocMonitorService(ParameterSet const&, ActivityRegistry& iRegistry) :
+  setCounters_(nullptr),
+  nTriggerPaths_(0) {
+  if(void* sym = dlsym(RTLD_DEFAULT, edm::allocmonitor::kSetCountersFunctionName)) {
+    setCounters_ = reinterpret_cast<edm_alloc_monitor_set_counters_t>(sym);
+  } else {
+    edm::LogWarning("AllocMonitor")
+      << "AllocMonitorService requested but the job was not started with\n"
+      << " LD_PRELOAD=libPerfToolsAllocMonitor.so so no allocations will be recorded.\n";
+    return;
+  }
+  iRegistry.watchPreBeginJob(this, &AllocMonitorService::preBeginJob);
+  iRegistry.watchPreModuleEvent(this, &AllocMonitorService::preModuleEvent);
+  iRegistry.watchPostModuleEvent(this, &AllocMonitorService::postModuleEvent);
+  iRegistry.watchPostEndJob(this, &AllocMonitorService::postEndJob);
+}
+
+void
+AllocMonitorService::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.setComment("Records the number and size of memory allocations made while each module processes events. "
+                  "Requires the job to be run with LD_PRELOAD=libPerfToolsAllocMonitor.so. "
+                  "The per module and per Path totals are written to the framework job report.");
+  descriptions.add("AllocMonitorService", desc);
+}
+
+void
+AllocMonitorService::Totals::add(edm_alloc_counters const& iCounters) {
+  nCalls.fetch_add(1, std::memory_order_relaxed);
+  nAllocations.fetch_add(iCounters.nAllocations, std::memory_order_relaxed);
+  nDeallocations.fetch_add(iCounters.nDeallocations, std::memory_order_relaxed);
+  bytesAllocated.fetch_add(iCounters.bytesAllocated, std::memory_order_relaxed);
+  bytesDeallocated.fetch_add(iCounters.bytesDeallocated, std::memory_order_relaxed);
+  long long presentMax = maxLiveBytesInCall.load(std::memory_order_relaxed);
+  while(iCounters.maxLiveBytes > presentMax and
+        not maxLiveBytesInCall.compare_exchange_weak(presentMax, iCounters.maxLiveBytes, std::memory_order_relaxed)) {
+  }
+}
+
+std::map<std::string, std::string>
+AllocMonitorService::Totals::metrics() const {
+  std::map<std::string, std::string> metrics;
+  unsigned long long const allocated = bytesAllocated.load();
+  unsigned long long const deallocated = bytesDeallocated.load();
+  metrics["NumberOfCalls"] = std::to_string(nCalls.load());
+  metrics["NumberOfAllocations"] = std::to_string(nAllocations.load());
+  metrics["NumberOfDeallocations"] = std::to_string(nDeallocations.load());
+  metrics["BytesAllocated"] = std::to_string(allocated);
+  metrics["BytesDeallocated"] = std::to_string(deallocated);
+  metrics["NetBytes"] = std::to_string(static_cast<long long>(allocated - deallocated));
+  metrics["MaxLiveBytesInCall"] = std::to_string(maxLiveBytesInCall.load());
+  return metrics;
+}
+
+void
+AllocMonitorService::preBeginJob(PathsAndConsumesOfModulesBase const& iPathsAndConsumes, ProcessContext const&) {
+  unsigned int nModules = 0;
+  for(auto const* description : iPathsAndConsumes.allModules()) {
+    if(description->id() + 1 > nModules) {
+      nModules = description->id() + 1;
+    }
+  }
+  moduleLabels_.resize(nModules);
+  for(auto const* description : iPathsAndConsumes.allModules()) {
+    moduleLabels_[description->id()] = description->moduleLabel();
+  }
+  moduleTotals_.reset(new Totals[nModules]);
+
+  nTriggerPaths_ = iPathsAndConsumes.paths().size();
+  pathNames_ = iPathsAndConsumes.paths();
+  pathNames_.insert(pathNames_.end(), iPathsAndConsumes.endPaths().begin(), iPathsAndConsumes.endPaths().end());
+  pathTotals_.reset(new Totals[pathNames_.size()]);
+}
+
+void
+AllocMonitorService::preModuleEvent(StreamContext const&, ModuleCallingContext const&) {
+  auto& counters = t_counters;
+  if(counters.depth < kMaxDepth) {
+    counters.frames[counters.depth] = edm_alloc_counters{};
+    setCounters_(&counters.frames[counters.depth]);
+  }
+  ++counters.depth;
+}
+
+void
+AllocMonitorService::postModuleEvent(StreamContext const&, ModuleCallingContext const& iContext) {
+  auto& counters = t_counters;
+  --counters.depth;
+  if(counters.depth >= kMaxDepth) {
+    return;
+  }
+  //go back to the module which called this one before touching the totals
+  setCounters_(counters.depth > 0 ? &counters.frames[counters.depth - 1] : nullptr);
+
+  auto const& frame = counters.frames[counters.depth];
+  unsigned int const moduleID = iContext.moduleDescription()->id();
+  if(moduleID < moduleLabels_.size()) {
+    moduleTotals_[moduleID].add(frame);
+  }
+  if(iContext.type() == ParentContext::Type::kPlaceInPath) {
+    auto const* pathContext = iContext.placeInPathContext()->pathContext();
+    unsigned int const pathIndex = pathContext->pathID() + (pathContext->isEndPath() ? nTriggerPaths_ : 0);
+    if(pathIndex < pathNames_.size()) {
+      pathTotals_[pathIndex].add(frame);
+    }
+  }
+}
+
+void
+AllocMonitorService::postEndJob() {
+  Service<JobReport> reportSvc;
+  for(unsigned int index = 0; index < moduleLabels_.size(); ++index) {
+    if(moduleTotals_[index].nCalls.load() != 0) {
+      reportSvc->reportPerformanceForModule("AllocMonitor", moduleLabels_[index], moduleTotals_[index].metrics());
+    }
+  }
+  for(unsigned int index = 0; index < pathNames_.size(); ++index) {
+    if(pathTotals_[index].nCalls.load() != 0) {
+      reportSvc->reportPerformanceSummary("AllocMonitorPath_" + pathNames_[index], pathTotals_[index].metrics());
+    }
+  }
+}
+
+DEFINE_FWK_SERVICE(AllocMonitorService);
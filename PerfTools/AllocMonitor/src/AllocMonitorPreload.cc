@@ -0,0 +1,274 @@
+// -*- C++ -*-
+//
+// Package:     PerfTools/AllocMonitor
+// File  :      AllocMonitorPreload
+//
+// Implementation:
+//     Meant to be loaded via LD_PRELOAD. The C allocation functions are
+//  replaced by versions which forward to the next definition (normally
+//  glibc) and add the usable size of each block to the counters registered
+//  by the calling thread. operator new/delete of libstdc++ are implemented
+//  with malloc/free so they are seen as well.
+//     dlsym can itself ask for memory before the real functions are known.
+//  Such requests, aligned ones included, are served from a small static
+//  buffer which is never given back.
+//
+
+// system include files
+#include <dlfcn.h>
+#include <malloc.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+// user include files
+#include "PerfTools/AllocMonitor/interface/AllocCounters.h"
+
+namespace {
+  typedef void* (*MallocType)(size_t);
+  typedef void* (*CallocType)(size_t, size_t);
+  typedef void* (*ReallocType)(void*, size_t);
+  typedef void (*FreeType)(void*);
+  typedef void* (*MemalignType)(size_t, size_t);
+  typedef int (*PosixMemalignType)(void**, size_t, size_t);
+  typedef void* (*VallocType)(size_t);
+
+  MallocType s_malloc = nullptr;
+  CallocType s_calloc = nullptr;
+  ReallocType s_realloc = nullptr;
+  FreeType s_free = nullptr;
+  MemalignType s_memalign = nullptr;
+  MemalignType s_alignedAlloc = nullptr;
+  PosixMemalignType s_posixMemalign = nullptr;
+  VallocType s_valloc = nullptr;
+  VallocType s_pvalloc = nullptr;
+
+  constexpr size_t kBootstrapSize = 8192;
+  //valloc and pvalloc ask for page alignment
+  constexpr size_t kPageSize = 4096;
+  alignas(16) char s_bootstrap[kBootstrapSize];
+  size_t s_bootstrapUsed = 0;
+  bool s_initializing = false;
+
+  //initial-exec avoids the TLS lookup calling malloc itself
+  __thread edm_alloc_counters* t_counters __attribute__((tls_model("initial-exec"))) = nullptr;
+
+  void* bootstrapAlignedAlloc(size_t iAlignment, size_t iSize) {
+    //keep at least 16 byte alignment for all blocks
+    if(iAlignment < 16) {
+      iAlignment = 16;
+    }
+    if((iAlignment & (iAlignment - 1)) != 0) {
+      return nullptr;
+    }
+    uintptr_t const base = reinterpret_cast<uintptr_t>(s_bootstrap);
+    uintptr_t const start = (base + s_bootstrapUsed + iAlignment - 1) & ~static_cast<uintptr_t>(iAlignment - 1);
+    size_t const offset = start - base;
+    size_t const size = (iSize + 15) & ~static_cast<size_t>(15);
+    if(offset + size > kBootstrapSize) {
+      return nullptr;
+    }
+    s_bootstrapUsed = offset + size;
+    return s_bootstrap + offset;
+  }
+
+  void* bootstrapAlloc(size_t iSize) {
+    return bootstrapAlignedAlloc(16, iSize);
+  }
+
+  bool isBootstrap(void const* p) {
+    return p >= s_bootstrap && p < s_bootstrap + kBootstrapSize;
+  }
+
+  void init() {
+    if(s_malloc != nullptr or s_initializing) {
+      return;
+    }
+    s_initializing = true;
+    s_calloc = reinterpret_cast<CallocType>(dlsym(RTLD_NEXT, "calloc"));
+    s_realloc = reinterpret_cast<ReallocType>(dlsym(RTLD_NEXT, "realloc"));
+    s_free = reinterpret_cast<FreeType>(dlsym(RTLD_NEXT, "free"));
+    s_memalign = reinterpret_cast<MemalignType>(dlsym(RTLD_NEXT, "memalign"));
+    s_alignedAlloc = reinterpret_cast<MemalignType>(dlsym(RTLD_NEXT, "aligned_alloc"));
+    s_posixMemalign = reinterpret_cast<PosixMemalignType>(dlsym(RTLD_NEXT, "posix_memalign"));
+    s_valloc = reinterpret_cast<VallocType>(dlsym(RTLD_NEXT, "valloc"));
+    s_pvalloc = reinterpret_cast<VallocType>(dlsym(RTLD_NEXT, "pvalloc"));
+    //set last since it is used to tell if initialization is done
+    s_malloc = reinterpret_cast<MallocType>(dlsym(RTLD_NEXT, "malloc"));
+    s_initializing = false;
+  }
+
+  struct Initializer {
+    Initializer() { init(); }
+  };
+  Initializer const s_initializer;
+
+  inline void recordAllocation(void* p) {
+    edm_alloc_counters* c = t_counters;
+    if(c != nullptr and p != nullptr) {
+      long long const size = malloc_usable_size(p);
+      ++c->nAllocations;
+      c->bytesAllocated += size;
+      c->liveBytes += size;
+      if(c->liveBytes > c->maxLiveBytes) {
+        c->maxLiveBytes = c->liveBytes;
+      }
+    }
+  }
+
+  //must be called before the memory is given back
+  inline size_t sizeToRecord(void* p) {
+    return (p != nullptr and t_counters != nullptr) ? malloc_usable_size(p) : 0;
+  }
+
+  inline void recordDeallocation(size_t iSize) {
+    edm_alloc_counters* c = t_counters;
+    if(c != nullptr) {
+      ++c->nDeallocations;
+      c->bytesDeallocated += iSize;
+      c->liveBytes -= static_cast<long long>(iSize);
+    }
+  }
+}
+
+extern "C" {
+  void edm_alloc_monitor_set_counters(edm_alloc_counters* iCounters) {
+    t_counters = iCounters;
+  }
+
+  void* malloc(size_t iSize) {
+    if(s_malloc == nullptr) {
+      init();
+      if(s_malloc == nullptr) {
+        return bootstrapAlloc(iSize);
+      }
+    }
+    void* p = s_malloc(iSize);
+    recordAllocation(p);
+    return p;
+  }
+
+  void* calloc(size_t iN, size_t iSize) {
+    if(s_calloc == nullptr) {
+      init();
+      if(s_calloc == nullptr) {
+        //the static buffer starts zeroed and is never reused
+        return bootstrapAlloc(iN*iSize);
+      }
+    }
+    void* p = s_calloc(iN, iSize);
+    recordAllocation(p);
+    return p;
+  }
+
+  void* realloc(void* iPtr, size_t iSize) {
+    if(isBootstrap(iPtr)) {
+      void* p = malloc(iSize);
+      if(p != nullptr) {
+        size_t const available = s_bootstrap + kBootstrapSize - static_cast<char*>(iPtr);
+        std::memcpy(p, iPtr, iSize < available ? iSize : available);
+      }
+      return p;
+    }
+    if(s_realloc == nullptr) {
+      init();
+      if(s_realloc == nullptr) {
+        return bootstrapAlloc(iSize);
+      }
+    }
+    size_t const oldSize = sizeToRecord(iPtr);
+    void* p = s_realloc(iPtr, iSize);
+    //on failure the old block is untouched unless the new size was 0
+    if(p != nullptr or iSize == 0) {
+      if(iPtr != nullptr) {
+        recordDeallocation(oldSize);
+      }
+      recordAllocation(p);
+    }
+    return p;
+  }
+
+  void free(void* iPtr) {
+    if(iPtr == nullptr or isBootstrap(iPtr)) {
+      return;
+    }
+    if(s_free == nullptr) {
+      init();
+      if(s_free == nullptr) {
+        //can only come from a block of the real malloc, which is not known yet
+        return;
+      }
+    }
+    recordDeallocation(sizeToRecord(iPtr));
+    s_free(iPtr);
+  }
+
+  void* memalign(size_t iAlignment, size_t iSize) {
+    if(s_memalign == nullptr) {
+      init();
+      if(s_memalign == nullptr) {
+        return bootstrapAlignedAlloc(iAlignment, iSize);
+      }
+    }
+    void* p = s_memalign(iAlignment, iSize);
+    recordAllocation(p);
+    return p;
+  }
+
+  void* aligned_alloc(size_t iAlignment, size_t iSize) {
+    if(s_alignedAlloc == nullptr) {
+      init();
+      if(s_alignedAlloc == nullptr) {
+        return bootstrapAlignedAlloc(iAlignment, iSize);
+      }
+    }
+    void* p = s_alignedAlloc(iAlignment, iSize);
+    recordAllocation(p);
+    return p;
+  }
+
+  int posix_memalign(void** oPtr, size_t iAlignment, size_t iSize) {
+    if(s_posixMemalign == nullptr) {
+      init();
+      if(s_posixMemalign == nullptr) {
+        void* p = bootstrapAlignedAlloc(iAlignment, iSize);
+        if(p == nullptr) {
+          return ENOMEM;
+        }
+        *oPtr = p;
+        return 0;
+      }
+    }
+    int const status = s_posixMemalign(oPtr, iAlignment, iSize);
+    if(status == 0) {
+      recordAllocation(*oPtr);
+    }
+    return status;
+  }
+
+  void* valloc(size_t iSize) {
+    if(s_valloc == nullptr) {
+      init();
+      if(s_valloc == nullptr) {
+        return bootstrapAlignedAlloc(kPageSize, iSize);
+      }
+    }
+    void* p = s_valloc(iSize);
+    recordAllocation(p);
+    return p;
+  }
+
+  void* pvalloc(size_t iSize) {
+    if(s_pvalloc == nullptr) {
+      init();
+      if(s_pvalloc == nullptr) {
+        size_t const size = (iSize + kPageSize - 1) & ~(kPageSize - 1);
+        return bootstrapAlignedAlloc(kPageSize, size);
+      }
+    }
+    void* p = s_pvalloc(iSize);
+    recordAllocation(p);
+    return p;
+  }
+}
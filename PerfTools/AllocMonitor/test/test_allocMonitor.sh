@@ -0,0 +1,10 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_allocMonitor_cfg.py
+
+(LD_PRELOAD=libPerfToolsAllocMonitor.so cmsRun -j allocMonitor_report.xml $F1 ) || die "Failure using $F1" $?
+grep -q 'Metric="AllocMonitor"  Module="thing"' allocMonitor_report.xml || die "No AllocMonitor report for module thing" 1
+grep -q 'AllocMonitorPath_p' allocMonitor_report.xml || die "No AllocMonitor report for path p" 1
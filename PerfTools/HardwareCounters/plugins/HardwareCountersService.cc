@@ -0,0 +1,367 @@
+// -*- C++ -*-
+//
+// Package:     PerfTools/HardwareCounters
+// Class  :     HardwareCountersService
+//
+// Implementation:
+//     Each thread which runs a module opens, the first time it does, one
+//  group of performance counters of the CPU on itself with perf_event_open:
+//  cycles, instructions, last level cache misses and branch misses, in user
+//  space only. The group is read when a module starts and when it finishes
+//  its event transition, and the difference is added to the totals of that
+//  module and, if it was run from a Path, to the totals of that Path. The
+//  totals are shared by all the streams.
+//     As for the AllocMonitorService, modules run from within another module
+//  (e.g. unscheduled ones) are counted on their own and are not included in
+//  the module (or Path) which triggered them.
+//     When the kernel has to multiplex the counters the values are scaled
+//  by the fraction of the time they were actually counting.
+//
+
+// system include files
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <linux/perf_event.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+// user include files
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/JobReport.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/PathContext.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
+#include "FWCore/ServiceRegistry/interface/PlaceInPathContext.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+
+namespace {
+  //the counters of a group, in the order they are opened
+  enum { kCycles, kInstructions, kCacheMisses, kBranchMisses, kNCounters };
+
+  struct Counts {
+    unsigned long long values[kNCounters];
+  };
+
+  //as read from a group opened with PERF_FORMAT_GROUP and the times
+  struct GroupReading {
+    unsigned long long nr;
+    unsigned long long timeEnabled;
+    unsigned long long timeRunning;
+    unsigned long long values[kNCounters];
+  };
+
+  //modules can run other modules (e.g. unscheduled) so keep a stack per thread
+  constexpr unsigned int kMaxDepth = 32;
+  struct Frame {
+    GroupReading start;
+    Counts nested;
+  };
+  struct ThreadCounters {
+    int leader = -1;
+    int fds[kNCounters];
+    bool failed = false;
+    unsigned int depth = 0;
+    Frame frames[kMaxDepth];
+  };
+  thread_local ThreadCounters t_counters;
+
+  int openCounter(unsigned long long iConfig, int iGroup) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = iConfig;
+    attr.disabled = (iGroup == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    //this thread, on any CPU
+    return syscall(__NR_perf_event_open, &attr, 0, -1, iGroup, 0);
+  }
+
+  bool readGroup(int iLeader, GroupReading& oReading) {
+    return read(iLeader, &oReading, sizeof(oReading)) == static_cast<ssize_t>(sizeof(oReading));
+  }
+}
+
+namespace edm {
+  namespace service {
+    class HardwareCountersService {
+    public:
+      HardwareCountersService(ParameterSet const&, ActivityRegistry&);
+      ~HardwareCountersService();
+
+      HardwareCountersService(HardwareCountersService const&) = delete;
+      HardwareCountersService& operator=(HardwareCountersService const&) = delete;
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      struct Totals {
+        std::atomic<unsigned long long> nCalls{0};
+        std::atomic<unsigned long long> values[kNCounters];
+
+        Totals() {
+          for(auto& value : values) {
+            value = 0;
+          }
+        }
+        void add(Counts const& iCounts);
+        std::map<std::string, std::string> metrics() const;
+      };
+
+      void preBeginJob(PathsAndConsumesOfModulesBase const&, ProcessContext const&);
+      void preModuleEvent(StreamContext const&, ModuleCallingContext const&);
+      void postModuleEvent(StreamContext const&, ModuleCallingContext const&);
+      void postEndJob();
+
+      bool openThisThread(ThreadCounters& ioCounters);
+      void printSummary() const;
+
+      bool printSummary_;
+      std::atomic<bool> warned_;
+      std::vector<int> openedFds_;
+      std::mutex mutex_;
+      //indexed by module id
+      std::vector<std::string> moduleLabels_;
+      std::unique_ptr<Totals[]> moduleTotals_;
+      //trigger paths followed by the end paths
+      std::vector<std::string> pathNames_;
+      std::unique_ptr<Totals[]> pathTotals_;
+      unsigned int nTriggerPaths_;
+    };
+  }
+}
+
+using namespace edm::service;
+
+HardwareCountersService::HardwareCountersService(ParameterSet const& iPS, ActivityRegistry& iRegistry) :
+  printSummary_(iPS.getUntrackedParameter<bool>("printSummary")),
+  warned_(false),
+  nTriggerPaths_(0) {
+  iRegistry.watchPreBeginJob(this, &HardwareCountersService::preBeginJob);
+  iRegistry.watchPreModuleEvent(this, &HardwareCountersService::preModuleEvent);
+  iRegistry.watchPostModuleEvent(this, &HardwareCountersService::postModuleEvent);
+  iRegistry.watchPostEndJob(this, &HardwareCountersService::postEndJob);
+}
+
+HardwareCountersService::~HardwareCountersService() {
+  for(int fd : openedFds_) {
+    close(fd);
+  }
+}
+
+void
+HardwareCountersService::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.addUntracked<bool>("printSummary", true)->setComment("Print the per module and per Path counts to the log at the end of the job.");
+  desc.setComment("Reads the cycles, instructions, last level cache misses and branch misses of the CPU, with perf_event_open, "
+                  "while each module processes events. "
+                  "The per module and per Path totals are written to the framework job report.");
+  descriptions.add("HardwareCountersService", desc);
+}
+
+void
+HardwareCountersService::Totals::add(Counts const& iCounts) {
+  nCalls.fetch_add(1, std::memory_order_relaxed);
+  for(unsigned int i = 0; i < kNCounters; ++i) {
+    values[i].fetch_add(iCounts.values[i], std::memory_order_relaxed);
+  }
+}
+
+std::map<std::string, std::string>
+HardwareCountersService::Totals::metrics() const {
+  std::map<std::string, std::string> metrics;
+  unsigned long long const cycles = values[kCycles].load();
+  unsigned long long const instructions = values[kInstructions].load();
+  metrics["NumberOfCalls"] = std::to_string(nCalls.load());
+  metrics["Cycles"] = std::to_string(cycles);
+  metrics["Instructions"] = std::to_string(instructions);
+  metrics["LastLevelCacheMisses"] = std::to_string(values[kCacheMisses].load());
+  metrics["BranchMisses"] = std::to_string(values[kBranchMisses].load());
+  metrics["InstructionsPerCycle"] = std::to_string(cycles == 0 ? 0. : static_cast<double>(instructions) / cycles);
+  return metrics;
+}
+
+void
+HardwareCountersService::preBeginJob(PathsAndConsumesOfModulesBase const& iPathsAndConsumes, ProcessContext const&) {
+  unsigned int nModules = 0;
+  for(auto const* description : iPathsAndConsumes.allModules()) {
+    if(description->id() + 1 > nModules) {
+      nModules = description->id() + 1;
+    }
+  }
+  moduleLabels_.resize(nModules);
+  for(auto const* description : iPathsAndConsumes.allModules()) {
+    moduleLabels_[description->id()] = description->moduleLabel();
+  }
+  moduleTotals_.reset(new Totals[nModules]);
+
+  nTriggerPaths_ = iPathsAndConsumes.paths().size();
+  pathNames_ = iPathsAndConsumes.paths();
+  pathNames_.insert(pathNames_.end(), iPathsAndConsumes.endPaths().begin(), iPathsAndConsumes.endPaths().end());
+  pathTotals_.reset(new Totals[pathNames_.size()]);
+}
+
+bool
+HardwareCountersService::openThisThread(ThreadCounters& ioCounters) {
+  static unsigned long long const kConfigs[kNCounters] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+  for(unsigned int i = 0; i < kNCounters; ++i) {
+    ioCounters.fds[i] = openCounter(kConfigs[i], i == 0 ? -1 : ioCounters.fds[0]);
+    if(ioCounters.fds[i] < 0) {
+      int const error = errno;
+      for(unsigned int j = 0; j < i; ++j) {
+        close(ioCounters.fds[j]);
+      }
+      ioCounters.failed = true;
+      if(not warned_.exchange(true)) {
+        edm::LogWarning("HardwareCounters")
+          << "HardwareCountersService could not open the performance counters of the CPU, errno " << error << " ("
+          << std::strerror(error) << ").\n"
+          << " Check /proc/sys/kernel/perf_event_paranoid; the threads without counters are not measured.\n";
+      }
+      return false;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    openedFds_.insert(openedFds_.end(), ioCounters.fds, ioCounters.fds + kNCounters);
+  }
+  ioCounters.leader = ioCounters.fds[0];
+  ioctl(ioCounters.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return true;
+}
+
+void
+HardwareCountersService::preModuleEvent(StreamContext const&, ModuleCallingContext const&) {
+  auto& counters = t_counters;
+  if(counters.leader < 0 and (counters.failed or not openThisThread(counters))) {
+    return;
+  }
+  if(counters.depth < kMaxDepth) {
+    auto& frame = counters.frames[counters.depth];
+    std::memset(&frame.nested, 0, sizeof(frame.nested));
+    if(not readGroup(counters.leader, frame.start)) {
+      frame.start.nr = 0;
+    }
+  }
+  ++counters.depth;
+}
+
+void
+HardwareCountersService::postModuleEvent(StreamContext const&, ModuleCallingContext const& iContext) {
+  GroupReading end;
+  auto& counters = t_counters;
+  if(counters.leader < 0 or counters.depth == 0) {
+    return;
+  }
+  bool const ok = readGroup(counters.leader, end);
+  --counters.depth;
+  if(counters.depth >= kMaxDepth) {
+    return;
+  }
+  auto const& frame = counters.frames[counters.depth];
+  if(not ok or frame.start.nr != kNCounters) {
+    return;
+  }
+
+  //when multiplexed, the counters only ran part of the time
+  unsigned long long const enabled = end.timeEnabled - frame.start.timeEnabled;
+  unsigned long long const running = end.timeRunning - frame.start.timeRunning;
+  double const scale = (running == 0 or running >= enabled) ? 1. : static_cast<double>(enabled) / running;
+
+  Counts all, own;
+  for(unsigned int i = 0; i < kNCounters; ++i) {
+    all.values[i] = static_cast<unsigned long long>((end.values[i] - frame.start.values[i]) * scale);
+    own.values[i] = all.values[i] > frame.nested.values[i] ? all.values[i] - frame.nested.values[i] : 0;
+  }
+  //the module which called this one must not count it
+  if(counters.depth > 0) {
+    auto& caller = counters.frames[counters.depth - 1];
+    for(unsigned int i = 0; i < kNCounters; ++i) {
+      caller.nested.values[i] += all.values[i];
+    }
+  }
+
+  unsigned int const moduleID = iContext.moduleDescription()->id();
+  if(moduleID < moduleLabels_.size()) {
+    moduleTotals_[moduleID].add(own);
+  }
+  if(iContext.type() == ParentContext::Type::kPlaceInPath) {
+    auto const* pathContext = iContext.placeInPathContext()->pathContext();
+    unsigned int const pathIndex = pathContext->pathID() + (pathContext->isEndPath() ? nTriggerPaths_ : 0);
+    if(pathIndex < pathNames_.size()) {
+      pathTotals_[pathIndex].add(own);
+    }
+  }
+}
+
+void
+HardwareCountersService::printSummary() const {
+  auto line = [](std::ostringstream& out, Totals const& totals, std::string const& name) {
+    double const cycles = totals.values[kCycles].load();
+    double const instructions = totals.values[kInstructions].load();
+    double const kilo = instructions > 0. ? instructions / 1000. : 1.;
+    out << "HardwareCounters " << std::setw(14) << totals.values[kCycles].load() << std::setw(14)
+        << totals.values[kInstructions].load() << std::setw(8) << (cycles > 0. ? instructions / cycles : 0.) << std::setw(10)
+        << totals.values[kCacheMisses].load() / kilo << std::setw(10) << totals.values[kBranchMisses].load() / kilo << "  "
+        << name << '\n';
+  };
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(2);
+  out << "HardwareCounters " << std::setw(14) << "cycles" << std::setw(14) << "instructions" << std::setw(8) << "IPC"
+      << std::setw(10) << "LLC MPKI" << std::setw(10) << "BR MPKI"
+      << "  Module\n";
+  for(unsigned int index = 0; index < moduleLabels_.size(); ++index) {
+    if(moduleTotals_[index].nCalls.load() != 0) {
+      line(out, moduleTotals_[index], moduleLabels_[index]);
+    }
+  }
+  out << "HardwareCounters " << std::setw(56) << ""
+      << "  Path\n";
+  for(unsigned int index = 0; index < pathNames_.size(); ++index) {
+    if(pathTotals_[index].nCalls.load() != 0) {
+      line(out, pathTotals_[index], pathNames_[index]);
+    }
+  }
+  edm::LogVerbatim("HardwareCounters") << out.str();
+}
+
+void
+HardwareCountersService::postEndJob() {
+  Service<JobReport> reportSvc;
+  for(unsigned int index = 0; index < moduleLabels_.size(); ++index) {
+    if(moduleTotals_[index].nCalls.load() != 0) {
+      reportSvc->reportPerformanceForModule("HardwareCounters", moduleLabels_[index], moduleTotals_[index].metrics());
+    }
+  }
+  for(unsigned int index = 0; index < pathNames_.size(); ++index) {
+    if(pathTotals_[index].nCalls.load() != 0) {
+      reportSvc->reportPerformanceSummary("HardwareCountersPath_" + pathNames_[index], pathTotals_[index].metrics());
+    }
+  }
+  if(printSummary_) {
+    printSummary();
+  }
+}
+
+DEFINE_FWK_SERVICE(HardwareCountersService);
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_hardwareCounters_cfg.py
+
+# the counters may not be readable on the test machine, the job must run either way
+(cmsRun -j hardwareCounters_report.xml $F1 ) || die "Failure using $F1" $?
+if [ "$(cat /proc/sys/kernel/perf_event_paranoid 2>/dev/null)" -le 2 ] 2>/dev/null; then
+  grep -q 'Metric="HardwareCounters"  Module="thing"' hardwareCounters_report.xml || die "No HardwareCounters report for module thing" 1
+fi
@@ -0,0 +1,17 @@
+import FWCore.ParameterSet.Config as cms
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(2),
+    numberOfStreams = cms.untracked.uint32(2)
+)
+
+process.add_(cms.Service("HardwareCountersService"))
+
+process.thing = cms.EDProducer("ThingProducer")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.p = cms.Path(process.thing)
@@ -0,0 +1,504 @@
+// -*- C++ -*-
+//
+// Package:     PerfTools/SamplingProfiler
+// Class  :     SamplingProfilerService
+//
+// Implementation:
+//     Each thread which runs a module, or reads from the source, gets a
+//  timer on its own CPU time, which sends it SIGPROF every samplingPeriod
+//  of CPU it uses. The signal handler records the call stack of the thread
+//  together with the module it is running, as known from the ActivityRegistry
+//  signals, into a buffer owned by that thread. Samples taken while no
+//  module is running are attributed to the framework.
+//     The buffers are emptied at the end of each luminosity block and at
+//  the end of the job, so a sample belongs to the lumi during which it was
+//  taken being processed, in the same way across all threads. Only then are
+//  the addresses turned into function names, outside of the signal handler.
+//     The stacks are written in the folded format read by flamegraph.pl
+//  (one line per stack, the frames separated by ';' starting with the
+//  module label, followed by the number of samples) and the functions
+//  which took the most samples in each module are printed to the log.
+//
+
+// system include files
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+// user include files
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/GlobalContext.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+// older glibc do not name the thread id of a sigevent
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace {
+  constexpr unsigned int kMaxStackDepth = 64;
+  //the signal handler and the signal trampoline
+  constexpr unsigned int kSkippedFrames = 2;
+  constexpr unsigned int kMaxModuleDepth = 32;
+  constexpr unsigned int kFramework = ~0u;
+  constexpr unsigned int kSource = ~0u - 1;
+
+  struct Sample {
+    unsigned int module;
+    unsigned int depth;
+    void* frames[kMaxStackDepth];
+  };
+
+  //written only by the signal handler of its thread, read under the mutex of the service
+  struct SampleBuffer {
+    explicit SampleBuffer(unsigned int iSize) : samples(iSize), written(0), read(0), dropped(0) {}
+
+    std::vector<Sample> samples;
+    std::atomic<unsigned long long> written;
+    std::atomic<unsigned long long> read;
+    std::atomic<unsigned long long> dropped;
+  };
+
+  //modules can run other modules (e.g. unscheduled) so keep a stack per thread
+  struct ThreadState {
+    SampleBuffer* buffer;
+    std::atomic<unsigned int> module;
+    unsigned int depth;
+    unsigned int callers[kMaxModuleDepth];
+  };
+  thread_local ThreadState t_state{nullptr, {kFramework}, 0, {}};
+
+  void sampleHandler(int, siginfo_t*, void*) {
+    int const savedErrno = errno;
+    auto& state = t_state;
+    SampleBuffer* buffer = state.buffer;
+    if(buffer != nullptr) {
+      auto const written = buffer->written.load(std::memory_order_relaxed);
+      if(written - buffer->read.load(std::memory_order_acquire) < buffer->samples.size()) {
+        Sample& sample = buffer->samples[written % buffer->samples.size()];
+        sample.module = state.module.load(std::memory_order_relaxed);
+        sample.depth = backtrace(sample.frames, kMaxStackDepth);
+        buffer->written.store(written + 1, std::memory_order_release);
+      } else {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    errno = savedErrno;
+  }
+}
+
+namespace edm {
+  namespace service {
+    class SamplingProfilerService {
+    public:
+      SamplingProfilerService(ParameterSet const&, ActivityRegistry&);
+      ~SamplingProfilerService();
+
+      SamplingProfilerService(SamplingProfilerService const&) = delete;
+      SamplingProfilerService& operator=(SamplingProfilerService const&) = delete;
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      //number of samples of each stack, the frames are the innermost first
+      typedef std::map<std::pair<unsigned int, std::vector<void*>>, unsigned long long> Profile;
+
+      void preBeginJob(PathsAndConsumesOfModulesBase const&, ProcessContext const&);
+      void preModule(StreamContext const&, ModuleCallingContext const&);
+      void postModule(StreamContext const&, ModuleCallingContext const&);
+      void preGlobalModule(GlobalContext const&, ModuleCallingContext const&);
+      void postGlobalModule(GlobalContext const&, ModuleCallingContext const&);
+      void preSourceEvent(StreamID);
+      void postSourceEvent(StreamID);
+      void postGlobalEndLumi(GlobalContext const&);
+      void postEndJob();
+
+      void enterModule(unsigned int iModule);
+      void leaveModule();
+      void startSamplingThisThread();
+      void stopSampling();
+      void drain(Profile& oProfile);
+      std::string const& symbol(void* iAddress);
+      std::string const& moduleName(unsigned int iModule) const;
+      void write(Profile const& iProfile, std::string const& iFileName);
+      void summarize(Profile const& iProfile, std::string const& iTitle);
+
+      long samplingPeriod_;
+      unsigned int bufferSize_;
+      unsigned int nHotspots_;
+      std::string outputFile_;
+      bool perLumiOutput_;
+      bool sampling_;
+
+      std::mutex mutex_;
+      std::vector<std::unique_ptr<SampleBuffer>> buffers_;
+      std::vector<timer_t> timers_;
+      Profile jobProfile_;
+      std::map<void*, std::string> symbols_;
+      //indexed by module id
+      std::vector<std::string> moduleLabels_;
+    };
+  }
+}
+
+using namespace edm::service;
+
+SamplingProfilerService::SamplingProfilerService(ParameterSet const& iPS, ActivityRegistry& iRegistry) :
+  samplingPeriod_(static_cast<long>(iPS.getUntrackedParameter<double>("samplingPeriod") * 1e6)),
+  bufferSize_(iPS.getUntrackedParameter<unsigned int>("bufferSize")),
+  nHotspots_(iPS.getUntrackedParameter<unsigned int>("numberOfHotspots")),
+  outputFile_(iPS.getUntrackedParameter<std::string>("outputFile")),
+  perLumiOutput_(iPS.getUntrackedParameter<bool>("perLumiOutput")),
+  sampling_(false) {
+  if(samplingPeriod_ <= 0 or bufferSize_ == 0) {
+    throw cms::Exception("Configuration") << "SamplingProfilerService: samplingPeriod and bufferSize must be positive";
+  }
+
+  //the first backtrace loads the unwinder, which must not happen in the signal handler
+  void* frames[kMaxStackDepth];
+  backtrace(frames, kMaxStackDepth);
+
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_sigaction = sampleHandler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if(sigaction(SIGPROF, &action, nullptr) != 0) {
+    edm::LogWarning("SamplingProfiler") << "SamplingProfilerService could not install its SIGPROF handler, errno " << errno
+                                        << ", no samples will be recorded.";
+    return;
+  }
+  sampling_ = true;
+
+  iRegistry.watchPreBeginJob(this, &SamplingProfilerService::preBeginJob);
+  iRegistry.watchPreModuleEvent(this, &SamplingProfilerService::preModule);
+  iRegistry.watchPostModuleEvent(this, &SamplingProfilerService::postModule);
+  iRegistry.watchPreModuleStreamBeginRun(this, &SamplingProfilerService::preModule);
+  iRegistry.watchPostModuleStreamBeginRun(this, &SamplingProfilerService::postModule);
+  iRegistry.watchPreModuleStreamEndRun(this, &SamplingProfilerService::preModule);
+  iRegistry.watchPostModuleStreamEndRun(this, &SamplingProfilerService::postModule);
+  iRegistry.watchPreModuleStreamBeginLumi(this, &SamplingProfilerService::preModule);
+  iRegistry.watchPostModuleStreamBeginLumi(this, &SamplingProfilerService::postModule);
+  iRegistry.watchPreModuleStreamEndLumi(this, &SamplingProfilerService::preModule);
+  iRegistry.watchPostModuleStreamEndLumi(this, &SamplingProfilerService::postModule);
+  iRegistry.watchPreModuleGlobalBeginRun(this, &SamplingProfilerService::preGlobalModule);
+  iRegistry.watchPostModuleGlobalBeginRun(this, &SamplingProfilerService::postGlobalModule);
+  iRegistry.watchPreModuleGlobalEndRun(this, &SamplingProfilerService::preGlobalModule);
+  iRegistry.watchPostModuleGlobalEndRun(this, &SamplingProfilerService::postGlobalModule);
+  iRegistry.watchPreModuleGlobalBeginLumi(this, &SamplingProfilerService::preGlobalModule);
+  iRegistry.watchPostModuleGlobalBeginLumi(this, &SamplingProfilerService::postGlobalModule);
+  iRegistry.watchPreModuleGlobalEndLumi(this, &SamplingProfilerService::preGlobalModule);
+  iRegistry.watchPostModuleGlobalEndLumi(this, &SamplingProfilerService::postGlobalModule);
+  iRegistry.watchPreSourceEvent(this, &SamplingProfilerService::preSourceEvent);
+  iRegistry.watchPostSourceEvent(this, &SamplingProfilerService::postSourceEvent);
+  iRegistry.watchPostGlobalEndLumi(this, &SamplingProfilerService::postGlobalEndLumi);
+  iRegistry.watchPostEndJob(this, &SamplingProfilerService::postEndJob);
+}
+
+SamplingProfilerService::~SamplingProfilerService() {
+  stopSampling();
+}
+
+void
+SamplingProfilerService::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.addUntracked<double>("samplingPeriod", 10.)->setComment("CPU time, in ms, between two samples of a thread.");
+  desc.addUntracked<unsigned int>("bufferSize", 4096)
+    ->setComment("Number of samples each thread can hold until they are collected at the end of the next luminosity block; "
+                 "samples taken while the buffer is full are dropped.");
+  desc.addUntracked<unsigned int>("numberOfHotspots", 10)->setComment("Number of functions listed for each module in the summary.");
+  desc.addUntracked<std::string>("outputFile", "samplingProfile.folded")
+    ->setComment("File the stacks of the job are written to, in the folded format of flamegraph.pl.");
+  desc.addUntracked<bool>("perLumiOutput", false)
+    ->setComment("Also write the stacks and the summary of each luminosity block, to run<R>_lumi<L>_<outputFile>.");
+  desc.setComment("Samples the call stacks of the threads running modules on their CPU time, using SIGPROF, "
+                  "and attributes each sample to the module being run.");
+  descriptions.add("SamplingProfilerService", desc);
+}
+
+void
+SamplingProfilerService::preBeginJob(PathsAndConsumesOfModulesBase const& iPathsAndConsumes, ProcessContext const&) {
+  unsigned int nModules = 0;
+  for(auto const* description : iPathsAndConsumes.allModules()) {
+    if(description->id() + 1 > nModules) {
+      nModules = description->id() + 1;
+    }
+  }
+  moduleLabels_.resize(nModules);
+  for(auto const* description : iPathsAndConsumes.allModules()) {
+    moduleLabels_[description->id()] = description->moduleLabel();
+  }
+}
+
+void
+SamplingProfilerService::preModule(StreamContext const&, ModuleCallingContext const& iContext) {
+  enterModule(iContext.moduleDescription()->id());
+}
+
+void
+SamplingProfilerService::postModule(StreamContext const&, ModuleCallingContext const&) {
+  leaveModule();
+}
+
+void
+SamplingProfilerService::preGlobalModule(GlobalContext const&, ModuleCallingContext const& iContext) {
+  enterModule(iContext.moduleDescription()->id());
+}
+
+void
+SamplingProfilerService::postGlobalModule(GlobalContext const&, ModuleCallingContext const&) {
+  leaveModule();
+}
+
+void
+SamplingProfilerService::preSourceEvent(StreamID) {
+  enterModule(kSource);
+}
+
+void
+SamplingProfilerService::postSourceEvent(StreamID) {
+  leaveModule();
+}
+
+void
+SamplingProfilerService::enterModule(unsigned int iModule) {
+  auto& state = t_state;
+  if(state.buffer == nullptr) {
+    startSamplingThisThread();
+  }
+  if(state.depth < kMaxModuleDepth) {
+    state.callers[state.depth] = state.module.load(std::memory_order_relaxed);
+  }
+  ++state.depth;
+  state.module.store(iModule, std::memory_order_relaxed);
+}
+
+void
+SamplingProfilerService::leaveModule() {
+  auto& state = t_state;
+  if(state.depth == 0) {
+    return;
+  }
+  --state.depth;
+  state.module.store(state.depth < kMaxModuleDepth ? state.callers[state.depth] : kFramework, std::memory_order_relaxed);
+}
+
+void
+SamplingProfilerService::startSamplingThisThread() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if(not sampling_) {
+    return;
+  }
+  buffers_.push_back(std::make_unique<SampleBuffer>(bufferSize_));
+
+  struct sigevent event;
+  std::memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = syscall(SYS_gettid);
+  timer_t timer;
+  if(timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) != 0) {
+    edm::LogWarning("SamplingProfiler") << "SamplingProfilerService could not create the timer of a thread, errno " << errno
+                                        << ", the thread will not be sampled.";
+    return;
+  }
+  //the buffer is set before the timer starts, so the handler never has to allocate the thread local state
+  t_state.buffer = buffers_.back().get();
+
+  struct itimerspec period;
+  period.it_interval.tv_sec = samplingPeriod_ / 1000000000L;
+  period.it_interval.tv_nsec = samplingPeriod_ % 1000000000L;
+  period.it_value = period.it_interval;
+  timer_settime(timer, 0, &period, nullptr);
+  timers_.push_back(timer);
+}
+
+void
+SamplingProfilerService::stopSampling() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if(not sampling_) {
+    return;
+  }
+  sampling_ = false;
+  for(auto timer : timers_) {
+    timer_delete(timer);
+  }
+  timers_.clear();
+  //a signal already sent is ignored rather than delivered to the previous handler
+  signal(SIGPROF, SIG_IGN);
+}
+
+void
+SamplingProfilerService::drain(Profile& oProfile) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for(auto& buffer : buffers_) {
+    auto const read = buffer->read.load(std::memory_order_relaxed);
+    auto const written = buffer->written.load(std::memory_order_acquire);
+    for(auto index = read; index != written; ++index) {
+      Sample const& sample = buffer->samples[index % buffer->samples.size()];
+      if(sample.depth <= kSkippedFrames) {
+        continue;
+      }
+      std::vector<void*> frames(sample.frames + kSkippedFrames, sample.frames + sample.depth);
+      ++oProfile[std::make_pair(sample.module, std::move(frames))];
+    }
+    buffer->read.store(written, std::memory_order_release);
+  }
+}
+
+std::string const&
+SamplingProfilerService::symbol(void* iAddress) {
+  auto found = symbols_.find(iAddress);
+  if(found != symbols_.end()) {
+    return found->second;
+  }
+  //a return address, look up the call just before it
+  std::ostringstream name;
+  Dl_info info;
+  void* const call = static_cast<char*>(iAddress) - 1;
+  if(dladdr(call, &info) != 0 and info.dli_sname != nullptr) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    name << (status == 0 ? demangled : info.dli_sname);
+    std::free(demangled);
+  } else if(info.dli_fname != nullptr) {
+    char const* library = std::strrchr(info.dli_fname, '/');
+    name << (library ? library + 1 : info.dli_fname) << "+0x" << std::hex
+         << (static_cast<char*>(call) - static_cast<char*>(info.dli_fbase));
+  } else {
+    name << call;
+  }
+  std::string text = name.str();
+  //';' separates the frames of the folded format
+  std::replace(text.begin(), text.end(), ';', ':');
+  return symbols_.emplace(iAddress, std::move(text)).first->second;
+}
+
+std::string const&
+SamplingProfilerService::moduleName(unsigned int iModule) const {
+  static std::string const kFrameworkName("(framework)");
+  static std::string const kSourceName("(source)");
+  if(iModule == kSource) {
+    return kSourceName;
+  }
+  if(iModule < moduleLabels_.size()) {
+    return moduleLabels_[iModule];
+  }
+  return kFrameworkName;
+}
+
+void
+SamplingProfilerService::write(Profile const& iProfile, std::string const& iFileName) {
+  std::ofstream out(iFileName.c_str());
+  for(auto const& stack : iProfile) {
+    out << moduleName(stack.first.first);
+    for(auto frame = stack.first.second.rbegin(); frame != stack.first.second.rend(); ++frame) {
+      out << ';' << symbol(*frame);
+    }
+    out << ' ' << stack.second << '\n';
+  }
+  out.close();
+  if(not out) {
+    edm::LogError("SamplingProfiler") << "SamplingProfilerService could not write the file " << iFileName;
+  }
+}
+
+void
+SamplingProfilerService::summarize(Profile const& iProfile, std::string const& iTitle) {
+  //samples of each module, and of each function the samples were in, by module
+  std::map<std::string, unsigned long long> moduleSamples;
+  std::map<std::string, std::map<std::string, unsigned long long>> functionSamples;
+  unsigned long long total = 0;
+  for(auto const& stack : iProfile) {
+    std::string const& module = moduleName(stack.first.first);
+    moduleSamples[module] += stack.second;
+    functionSamples[module][symbol(stack.first.second.front())] += stack.second;
+    total += stack.second;
+  }
+
+  std::vector<std::pair<unsigned long long, std::string>> modules;
+  for(auto const& module : moduleSamples) {
+    modules.emplace_back(module.second, module.first);
+  }
+  std::sort(modules.rbegin(), modules.rend());
+
+  unsigned long long dropped = 0;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for(auto const& buffer : buffers_) {
+      dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+  }
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1);
+  out << "SamplingProfiler " << iTitle << ": " << total << " samples, " << dropped << " dropped since the start of the job\n";
+  for(auto const& module : modules) {
+    out << "SamplingProfiler " << std::setw(6) << 100. * module.first / total << "%  " << module.second << '\n';
+    std::vector<std::pair<unsigned long long, std::string>> functions;
+    for(auto const& function : functionSamples[module.second]) {
+      functions.emplace_back(function.second, function.first);
+    }
+    std::sort(functions.rbegin(), functions.rend());
+    if(functions.size() > nHotspots_) {
+      functions.resize(nHotspots_);
+    }
+    for(auto const& function : functions) {
+      out << "SamplingProfiler         " << std::setw(6) << 100. * function.first / module.first << "%  " << function.second
+          << '\n';
+    }
+  }
+  edm::LogVerbatim("SamplingProfiler") << out.str();
+}
+
+void
+SamplingProfilerService::postGlobalEndLumi(GlobalContext const& iContext) {
+  Profile lumiProfile;
+  drain(lumiProfile);
+  if(perLumiOutput_) {
+    auto const& id = iContext.luminosityBlockID();
+    std::ostringstream prefix;
+    prefix << "run" << id.run() << "_lumi" << id.luminosityBlock() << '_';
+    write(lumiProfile, prefix.str() + outputFile_);
+    summarize(lumiProfile, "run " + std::to_string(id.run()) + " lumi " + std::to_string(id.luminosityBlock()));
+  }
+  for(auto& stack : lumiProfile) {
+    jobProfile_[stack.first] += stack.second;
+  }
+}
+
+void
+SamplingProfilerService::postEndJob() {
+  stopSampling();
+  drain(jobProfile_);
+  write(jobProfile_, outputFile_);
+  summarize(jobProfile_, "job");
+}
+
+DEFINE_FWK_SERVICE(SamplingProfilerService);
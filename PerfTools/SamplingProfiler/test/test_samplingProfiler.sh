@@ -0,0 +1,11 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_samplingProfiler_cfg.py
+
+rm -f samplingProfile.folded run1_lumi*_samplingProfile.folded
+(cmsRun $F1 ) || die "Failure using $F1" $?
+test -f samplingProfile.folded || die "No folded stacks written for the job" 1
+test -f run1_lumi1_samplingProfile.folded || die "No folded stacks written for lumi 1" 1
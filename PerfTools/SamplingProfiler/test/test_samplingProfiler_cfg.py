@@ -0,0 +1,25 @@
+import FWCore.ParameterSet.Config as cms
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource",
+    numberEventsInLuminosityBlock = cms.untracked.uint32(50)
+)
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(2),
+    numberOfStreams = cms.untracked.uint32(2)
+)
+
+process.add_(cms.Service("SamplingProfilerService",
+    samplingPeriod = cms.untracked.double(1.),
+    outputFile = cms.untracked.string("samplingProfile.folded"),
+    perLumiOutput = cms.untracked.bool(True)
+))
+
+process.thing = cms.EDProducer("ThingProducer",
+    nThings = cms.int32(2000)
+)
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(200))
+
+process.p = cms.Path(process.thing)
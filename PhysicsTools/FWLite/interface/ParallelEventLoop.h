@@ -0,0 +1,90 @@
+// -*- C++ -*-
+
+#if !defined(ParallelEventLoop_H)
+#define ParallelEventLoop_H
+
+/* Loop over the events of a set of files in several threads.
+ *
+ * The entries of the chain of files are split in contiguous ranges, one
+ * per thread.  Each thread has its own fwlite::ChainEvent, and so its own
+ * files, trees and read caches, and its own result, a copy of the initial
+ * value.  Once all the threads are done, their results are merged into
+ * the one of the first range, in the order of the ranges, and returned.
+ *
+ *    struct Counts { unsigned int events = 0, muons = 0; };
+ *    Counts total = fwlite::parallelEventLoop(inputFiles, 4, Counts(),
+ *       [](fwlite::ChainEvent const& ev, Counts& counts) {
+ *          edm::Handle<std::vector<reco::Muon> > muons;
+ *          ev.getByLabel(std::string("muons"), muons);
+ *          ++counts.events; counts.muons += muons->size();
+ *       },
+ *       [](Counts& total, Counts const& counts) {
+ *          total.events += counts.events; total.muons += counts.muons;
+ *       });
+ *
+ * The analyze function is called concurrently for different events, so it
+ * must not modify anything but its result.  Objects such as histograms
+ * belong in the result, and are merged with e.g. TH1::Add.  If nThreads
+ * is 0 or 1 the loop is done in the calling thread.  An exception thrown
+ * in a thread is rethrown by parallelEventLoop once all the threads are
+ * done.
+ */
+
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TROOT.h"
+
+#include "DataFormats/FWLite/interface/ChainEvent.h"
+
+namespace fwlite
+{
+
+   template <typename R, typename Analyze, typename Merge>
+   R parallelEventLoop(std::vector<std::string> const& fileNames, unsigned int nThreads,
+                       R const& init, Analyze analyze, Merge merge)
+   {
+      if (nThreads < 2) {
+         R result(init);
+         ChainEvent ev(fileNames);
+         for (ev.toBegin(); !ev.atEnd(); ++ev) analyze(ev, result);
+         return result;
+      }
+
+      // each thread opens its own files
+      ROOT::EnableThreadSafety();
+
+      std::vector<R> results(nThreads, init);
+      std::vector<std::exception_ptr> errors(nThreads);
+      std::vector<std::thread> threads;
+      threads.reserve(nThreads);
+      for (unsigned int i = 0; i != nThreads; ++i) {
+         threads.emplace_back([&, i]() {
+            try {
+               ChainEvent ev(fileNames);
+               Long64_t const size = ev.size();
+               Long64_t const first = size * i / nThreads;
+               Long64_t const last = size * (i + 1) / nThreads;
+               if (first == last || !ev.to(first)) return;
+               for (Long64_t entry = first; entry != last && !ev.atEnd(); ++entry, ++ev) {
+                  analyze(ev, results[i]);
+               }
+            } catch (...) {
+               errors[i] = std::current_exception();
+            }
+         });
+      }
+      for (auto& thread : threads) thread.join();
+      for (auto const& error : errors) {
+         if (error) std::rethrow_exception(error);
+      }
+
+      for (unsigned int i = 1; i != nThreads; ++i) merge(results[0], results[i]);
+      return results[0];
+   }
+
+}
+
+#endif
@@ -0,0 +1,23 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("WRITE")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(100))
+
+process.out1 = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('parallelEventLoop1.root'),
+    SelectEvents = cms.untracked.PSet(SelectEvents = cms.vstring('p1'))
+)
+process.out2 = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('parallelEventLoop2.root'),
+    SelectEvents = cms.untracked.PSet(SelectEvents = cms.vstring('p2'))
+)
+
+# every other event in the first file, the others in the second one
+process.half = cms.EDFilter("Prescaler", prescaleFactor = cms.int32(2), prescaleOffset = cms.int32(0))
+process.p1 = cms.Path(process.half)
+process.p2 = cms.Path(~process.half)
+
+process.outp = cms.EndPath(process.out1 + process.out2)
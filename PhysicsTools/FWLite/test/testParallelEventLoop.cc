@@ -0,0 +1,86 @@
+// -*- C++ -*-
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// CMS includes
+#include "FWCore/FWLite/interface/FWLiteEnabler.h"
+#include "PhysicsTools/FWLite/interface/ParallelEventLoop.h"
+
+using namespace std;
+
+typedef vector<unsigned long long> EventNumbers;
+
+// the event numbers of the chain, in the order they are read
+static EventNumbers
+readEvents (vector<string> const& fileNames, unsigned int nThreads)
+{
+   return fwlite::parallelEventLoop(fileNames, nThreads, EventNumbers(),
+      [](fwlite::ChainEvent const& ev, EventNumbers& events) {
+         events.push_back(ev.id().event());
+      },
+      [](EventNumbers& all, EventNumbers const& events) {
+         all.insert(all.end(), events.begin(), events.end());
+      });
+}
+
+///////////////////////////
+// ///////////////////// //
+// // Main Subroutine // //
+// ///////////////////// //
+///////////////////////////
+
+int main (int argc, char* argv[]) 
+{
+   if (argc < 2) {
+      cerr << "usage: " << argv[0] << " file.root [file.root ...]" << endl;
+      return 1;
+   }
+   FWLiteEnabler::enable();
+   vector<string> fileNames(argv + 1, argv + argc);
+
+   EventNumbers serial = readEvents(fileNames, 1);
+   cout << "read " << serial.size() << " events serially" << endl;
+   if (serial.empty()) {
+      cerr << "no events read" << endl;
+      return 1;
+   }
+   EventNumbers sorted(serial);
+   sort(sorted.begin(), sorted.end());
+   if (unique(sorted.begin(), sorted.end()) != sorted.end()) {
+      cerr << "an event was read twice" << endl;
+      return 1;
+   }
+
+   // the ranges do not divide the chain evenly for some of these, and
+   // cross the boundary between the files for all of them
+   for (unsigned int nThreads : {2u, 3u, 4u, 7u}) {
+      EventNumbers parallel = readEvents(fileNames, nThreads);
+      cout << "read " << parallel.size() << " events with " << nThreads << " threads" << endl;
+      if (parallel != serial) {
+         cerr << "the events read with " << nThreads << " threads differ from the serial loop" << endl;
+         return 1;
+      }
+   }
+
+   // an exception thrown in a thread is rethrown in the caller
+   bool thrown = false;
+   try {
+      fwlite::parallelEventLoop(fileNames, 4, 0,
+         [&serial](fwlite::ChainEvent const& ev, int&) {
+            if (ev.id().event() == serial.back()) throw runtime_error("last event");
+         },
+         [](int&, int const&) {});
+   } catch (runtime_error const& e) {
+      thrown = string(e.what()) == "last event";
+   }
+   if (!thrown) {
+      cerr << "the exception thrown while analyzing an event was lost" << endl;
+      return 1;
+   }
+
+   return 0;
+}
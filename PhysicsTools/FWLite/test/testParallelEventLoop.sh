@@ -0,0 +1,14 @@
+#!/bin/sh
+
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+pushd ${LOCAL_TMP_DIR}
+
+rm -f parallelEventLoop1.root parallelEventLoop2.root
+cmsRun ${LOCAL_TEST_DIR}/parallelEventLoop_cfg.py || die 'Failed to create files' $?
+testParallelEventLoop.exe parallelEventLoop1.root parallelEventLoop2.root || die 'Failed in testParallelEventLoop.exe' $?
+
+popd
+exit 0
@@ -11,6 +11,7 @@
 #include "DataFormats/RecoCandidate/interface/RecoCandidate.h"
 #include "PhysicsTools/PatUtils/interface/StringParserTools.h"
 #include "PhysicsTools/PatUtils/interface/PATDiObjectProxy.h"
+#include "CommonTools/Utils/interface/EtaPhiIndex.h"
 
 namespace pat { namespace helper {
 
@@ -69,6 +70,8 @@ class BasicOverlapTest : public OverlapTest {
         edm::Handle<reco::CandidateView> candidates_;
         /// Flag saying if each element has passed the preselection or not
         std::vector<bool> isPreselected_;
+        /// Index in eta and phi of the preselected elements
+        EtaPhiIndex preselectedIndex_;
 };
 
 class OverlapBySuperClusterSeed : public OverlapTest {
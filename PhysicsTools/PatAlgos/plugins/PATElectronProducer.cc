@@ -282,6 +282,11 @@ void PATElectronProducer::produce(edm::Event & iEvent, const edm::EventSetup & i
 
   std::vector<Electron> * patElectrons = new std::vector<Electron>();
 
+  // the PFCluster isolation maps and the reduced rechits are retrieved
+  // once per event, by the first electron which needs them
+  edm::Handle<edm::ValueMap<float> > ecalPFClusterIsoMapH, hcalPFClusterIsoMapH;
+  edm::Handle< EcalRecHitCollection > barrelRecHitsH, endcapRecHitsH;
+
   if( useParticleFlow_ ) {
     edm::Handle< reco::PFCandidateCollection >  pfElectrons;
     iEvent.getByToken(pfElecToken_, pfElectrons);
@@ -376,10 +381,8 @@ void PATElectronProducer::produce(edm::Event & iEvent, const edm::EventSetup & i
 	  // PFClusterIso
 	  if (addPFClusterIso_) {
 	    // Get PFCluster Isolation
-	    edm::Handle<edm::ValueMap<float> > ecalPFClusterIsoMapH;
-	    iEvent.getByToken(ecalPFClusterIsoT_, ecalPFClusterIsoMapH);
-	    edm::Handle<edm::ValueMap<float> > hcalPFClusterIsoMapH;
-	    iEvent.getByToken(hcalPFClusterIsoT_, hcalPFClusterIsoMapH);
+	    if (!ecalPFClusterIsoMapH.isValid()) iEvent.getByToken(ecalPFClusterIsoT_, ecalPFClusterIsoMapH);
+	    if (!hcalPFClusterIsoMapH.isValid()) iEvent.getByToken(hcalPFClusterIsoT_, hcalPFClusterIsoMapH);
 
 	    anElectron.setEcalPFClusterIso((*ecalPFClusterIsoMapH)[elecsRef]);
 	    anElectron.setHcalPFClusterIso((*hcalPFClusterIsoMapH)[elecsRef]);
@@ -430,11 +433,9 @@ void PATElectronProducer::produce(edm::Event & iEvent, const edm::EventSetup & i
 
 	  // Retrieve the corresponding RecHits
 
-	  edm::Handle< EcalRecHitCollection > rechitsH ;
-	  if(barrel)
-	    iEvent.getByToken(reducedBarrelRecHitCollectionToken_,rechitsH);
-	  else
-	    iEvent.getByToken(reducedEndcapRecHitCollectionToken_,rechitsH);
+	  edm::Handle< EcalRecHitCollection > & rechitsH = barrel ? barrelRecHitsH : endcapRecHitsH;
+	  if(!rechitsH.isValid())
+	    iEvent.getByToken(barrel ? reducedBarrelRecHitCollectionToken_ : reducedEndcapRecHitCollectionToken_,rechitsH);
 
 	  EcalRecHitCollection selectedRecHits;
 	  const EcalRecHitCollection *recHits = rechitsH.product();
@@ -594,10 +595,8 @@ void PATElectronProducer::produce(edm::Event & iEvent, const edm::EventSetup & i
       // PFCluster Isolation
       if (addPFClusterIso_) {
 	// Get PFCluster Isolation
-	edm::Handle<edm::ValueMap<float> > ecalPFClusterIsoMapH;
-	iEvent.getByToken(ecalPFClusterIsoT_, ecalPFClusterIsoMapH);
-	edm::Handle<edm::ValueMap<float> > hcalPFClusterIsoMapH;
-	iEvent.getByToken(hcalPFClusterIsoT_, hcalPFClusterIsoMapH);
+	if (!ecalPFClusterIsoMapH.isValid()) iEvent.getByToken(ecalPFClusterIsoT_, ecalPFClusterIsoMapH);
+	if (!hcalPFClusterIsoMapH.isValid()) iEvent.getByToken(hcalPFClusterIsoT_, hcalPFClusterIsoMapH);
 	
 	anElectron.setEcalPFClusterIso((*ecalPFClusterIsoMapH)[elecsRef]);
 	anElectron.setHcalPFClusterIso((*hcalPFClusterIsoMapH)[elecsRef]);
@@ -647,11 +646,9 @@ void PATElectronProducer::produce(edm::Event & iEvent, const edm::EventSetup & i
       
       // Retrieve the corresponding RecHits
 
-      edm::Handle< EcalRecHitCollection > rechitsH ;
-      if(barrel)
-	iEvent.getByToken(reducedBarrelRecHitCollectionToken_,rechitsH);
-      else
-	iEvent.getByToken(reducedEndcapRecHitCollectionToken_,rechitsH);
+      edm::Handle< EcalRecHitCollection > & rechitsH = barrel ? barrelRecHitsH : endcapRecHitsH;
+      if(!rechitsH.isValid())
+	iEvent.getByToken(barrel ? reducedBarrelRecHitCollectionToken_ : reducedEndcapRecHitCollectionToken_,rechitsH);
 
       EcalRecHitCollection selectedRecHits;
       const EcalRecHitCollection *recHits = rechitsH.product();
@@ -36,6 +36,8 @@
 #include <memory>
 #include <algorithm>
 
+#include "tbb/parallel_for.h"
+
 
 using namespace pat;
 
@@ -44,6 +46,7 @@ PATJetProducer::PATJetProducer(const edm::ParameterSet& iConfig)  :
   useUserData_(iConfig.exists("userData")),
   printWarning_(true)
 {
+  produceInParallel_ = iConfig.getParameter<bool>( "produceInParallel" );
   // initialize configurables
   jetsToken_ = consumes<edm::View<reco::Jet> >(iConfig.getParameter<edm::InputTag>( "jetSource" ));
   embedCaloTowers_ = false; // parameter is optional
@@ -172,12 +175,11 @@ void PATJetProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup
 */
 
   // read in the jet correction factors ValueMap
-  std::vector<edm::ValueMap<JetCorrFactors> > jetCorrs;
+  std::vector<edm::Handle<edm::ValueMap<JetCorrFactors> > > jetCorrs;
   if (addJetCorrFactors_) {
+    jetCorrs.resize(jetCorrFactorsTokens_.size());
     for ( size_t i = 0; i < jetCorrFactorsTokens_.size(); ++i ) {
-      edm::Handle<edm::ValueMap<JetCorrFactors> > jetCorr;
-      iEvent.getByToken(jetCorrFactorsTokens_[i], jetCorr);
-      jetCorrs.push_back( *jetCorr );
+      iEvent.getByToken(jetCorrFactorsTokens_[i], jetCorrs[i]);
     }
   }
 
@@ -221,13 +223,69 @@ void PATJetProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup
   edm::RefProd<reco::PFCandidateCollection > h_pfCandidatesOut = iEvent.getRefBeforePut<reco::PFCandidateCollection > ( "pfCandidates" );
   edm::RefProd<edm::OwnVector<reco::BaseTagInfo> > h_tagInfosOut = iEvent.getRefBeforePut<edm::OwnVector<reco::BaseTagInfo> > ( "tagInfos" );
 
+  // The jets are first made and given their JEC factors and jet ID, which
+  // only reads ValueMaps, so that this can be done concurrently.  All the
+  // rest fills the output collections or uses the event and the helpers,
+  // and follows in jet order.
+  patJets->resize(jets->size());
+  std::vector<char> uncorrected(jets->size(), 0);
+  auto makeJet = [&](size_t idx) {
+    // construct the Jet from the ref -> save ref to original object
+    edm::RefToBase<reco::Jet> jetRef = jets->refAt(idx);
+    Jet & ajet = (*patJets)[idx];
+    ajet = Jet(jetRef);
+
+    if (addJetCorrFactors_) {
+      // add additional JetCorrs to the jet
+      for ( unsigned int i=0; i<jetCorrs.size(); ++i ) {
+	const JetCorrFactors& jcf = (*jetCorrs[i])[jetRef];
+	// uncomment for debugging
+	// jcf.print();
+	ajet.addJECFactors(jcf);
+      }
+      const JetCorrFactors& jcf = (*jetCorrs[0])[jetRef];
+      std::vector<std::string> levels = jcf.correctionLabels();
+      if(std::find(levels.begin(), levels.end(), "L2L3Residual")!=levels.end()){
+	ajet.initializeJEC(jcf.jecLevel("L2L3Residual"));
+      }
+      else if(std::find(levels.begin(), levels.end(), "L3Absolute")!=levels.end()){
+	ajet.initializeJEC(jcf.jecLevel("L3Absolute"));
+      }
+      else{
+	ajet.initializeJEC(jcf.jecLevel("Uncorrected"));
+	uncorrected[idx] = 1;
+      }
+    }
+
+    // add jet ID for calo jets
+    if (addJetID_ && ajet.isCaloJet() ) {
+      reco::JetID jetId = (*hJetIDMap)[ jetRef ];
+      ajet.setJetID( jetId );
+    }
+    // add jet ID jpt jets
+    else if ( addJetID_ && ajet.isJPTJet() ){
+      const reco::JPTJet *jptj = dynamic_cast<const reco::JPTJet *>(jetRef.get());
+      reco::JetID jetId = (*hJetIDMap)[ jptj->getCaloJetRef() ];
+      ajet.setJetID( jetId );
+    }
+  };
+  if (produceInParallel_) {
+    tbb::parallel_for(size_t(0), jets->size(), makeJet);
+  } else {
+    for (size_t idx = 0; idx != jets->size(); ++idx) makeJet(idx);
+  }
+
   for (edm::View<reco::Jet>::const_iterator itJet = jets->begin(); itJet != jets->end(); itJet++) {
 
-    // construct the Jet from the ref -> save ref to original object
     unsigned int idx = itJet - jets->begin();
     edm::RefToBase<reco::Jet> jetRef = jets->refAt(idx);
-    edm::Ptr<reco::Jet> jetPtr = jets->ptrAt(idx);
-    Jet ajet(jetRef);
+    Jet & ajet = (*patJets)[idx];
+
+    if (uncorrected[idx] && printWarning_) {
+      edm::LogWarning("L3Absolute not found") << "L2L3Residual and L3Absolute are not part of the jetCorrFactors\n"
+					      << "of module " <<  (*jetCorrs[0])[jetRef].jecSet() << ". Jets will remain"
+					      << " uncorrected."; printWarning_=false;
+    }
 
     // add the FwdPtrs to the CaloTowers
     if ( (ajet.isCaloJet() || ajet.isJPTJet() ) && embedCaloTowers_) {
@@ -275,31 +333,6 @@ void PATJetProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup
       ajet.setPFCandidates( iparticlesRef );
     }
 
-    if (addJetCorrFactors_) {
-      // add additional JetCorrs to the jet
-      for ( unsigned int i=0; i<jetCorrFactorsTokens_.size(); ++i ) {
-	const JetCorrFactors& jcf = jetCorrs[i][jetRef];
-	// uncomment for debugging
-	// jcf.print();
-	ajet.addJECFactors(jcf);
-      }
-      std::vector<std::string> levels = jetCorrs[0][jetRef].correctionLabels();
-      if(std::find(levels.begin(), levels.end(), "L2L3Residual")!=levels.end()){
-	ajet.initializeJEC(jetCorrs[0][jetRef].jecLevel("L2L3Residual"));
-      }
-      else if(std::find(levels.begin(), levels.end(), "L3Absolute")!=levels.end()){
-	ajet.initializeJEC(jetCorrs[0][jetRef].jecLevel("L3Absolute"));
-      }
-      else{
-	ajet.initializeJEC(jetCorrs[0][jetRef].jecLevel("Uncorrected"));
-	if(printWarning_){
-	  edm::LogWarning("L3Absolute not found") << "L2L3Residual and L3Absolute are not part of the jetCorrFactors\n"
-						  << "of module " <<  jetCorrs[0][jetRef].jecSet() << ". Jets will remain"
-						  << " uncorrected."; printWarning_=false;
-	}
-      }
-    }
-
     // get the MC flavour information for this jet
     if (getJetMCFlavour_ && useLegacyJetMCFlavour_) {
         ajet.setPartonFlavour( (*jetFlavMatch)[edm::RefToBase<reco::Jet>(jetRef)].getFlavour() );
@@ -387,21 +420,9 @@ void PATJetProducer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup
 
     if (addJetCharge_) ajet.setJetCharge( (*hJetChargeAss)[jetRef] );
 
-    // add jet ID for calo jets
-    if (addJetID_ && ajet.isCaloJet() ) {
-      reco::JetID jetId = (*hJetIDMap)[ jetRef ];
-      ajet.setJetID( jetId );
-    }
-    // add jet ID jpt jets
-    else if ( addJetID_ && ajet.isJPTJet() ){
-      const reco::JPTJet *jptj = dynamic_cast<const reco::JPTJet *>(jetRef.get());
-      reco::JetID jetId = (*hJetIDMap)[ jptj->getCaloJetRef() ];
-      ajet.setJetID( jetId );
-    }
     if ( useUserData_ ) {
       userDataHelper_.add( ajet, iEvent, iSetup );
     }
-    patJets->push_back(ajet);
   }
 
   // sort jets in pt
@@ -459,6 +480,8 @@ void PATJetProducer::fillDescriptions(edm::ConfigurationDescriptions & descripti
   std::vector<edm::InputTag> emptyVInputTags;
   iDesc.add<std::vector<edm::InputTag> >("tagInfoSources", emptyVInputTags);
 
+  iDesc.add<bool>("produceInParallel", false)->setComment("make the jets and add their JEC factors and jet ID concurrently");
+
   // jet energy corrections
   iDesc.add<bool>("addJetCorrFactors", true);
   iDesc.add<std::vector<edm::InputTag> >("jetCorrFactorsSource", emptyVInputTags);
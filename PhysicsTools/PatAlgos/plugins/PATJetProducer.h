@@ -106,6 +106,7 @@ namespace pat {
       pat::PATUserDataHelper<pat::Jet>      userDataHelper_;
       //
       bool printWarning_; // this is introduced to issue warnings only once per job
+      bool produceInParallel_; // make the jets concurrently before the serial part of the loop
 
 
 
@@ -11,10 +11,13 @@ BasicOverlapTest::readInput(const edm::Event & iEvent, const edm::EventSetup &iS
 {
     iEvent.getByToken(srcToken_, candidates_);
     isPreselected_.resize(candidates_->size());
+    preselectedIndex_.clear();
     size_t idx = 0;
     for (reco::CandidateView::const_iterator it = candidates_->begin(); it != candidates_->end(); ++it, ++idx) {
         isPreselected_[idx] = presel_(*it);
+        if (isPreselected_[idx]) preselectedIndex_.add(it->eta(), it->phi(), idx);
     }
+    preselectedIndex_.sort();
     // Yes, I could use std::transform. But would people like it?
     // http://www.sgi.com/tech/stl/transform.html
 }
@@ -22,20 +25,20 @@ BasicOverlapTest::readInput(const edm::Event & iEvent, const edm::EventSetup &iS
 bool
 BasicOverlapTest::fillOverlapsForItem(const reco::Candidate &item, reco::CandidatePtrVector &overlapsToFill) const
 {
-    size_t idx = 0;
     std::vector<std::pair<float,size_t> > matches;
-    for (reco::CandidateView::const_iterator it = candidates_->begin(); it != candidates_->end(); ++it, ++idx) {
-        if (!isPreselected_[idx]) continue;
-        double dr = reco::deltaR(item, *it);
+    // only the preselected candidates near the item in eta and phi can be within deltaR
+    preselectedIndex_.forEachInBox(item.eta(), item.phi(), deltaR_, [&](size_t idx) {
+        const reco::Candidate &other = (*candidates_)[idx];
+        double dr = reco::deltaR(item, other);
         if (dr < deltaR_) {
             if (checkRecoComponents_) {
                 OverlapChecker overlaps;
-                if (!overlaps(item, *it)) continue;
+                if (!overlaps(item, other)) return;
             }
-            if (!pairCut_(pat::DiObjectProxy(item,*it))) continue;
+            if (!pairCut_(pat::DiObjectProxy(item,other))) return;
             matches.push_back(std::make_pair(dr, idx));
         }
-    }
+    });
     // see if we matched anything
     if (matches.empty()) return false;
 
@@ -153,6 +153,12 @@ void CombinedSVComputer::fillCommonVariables(reco::TaggingVariableList & vars, r
 
         std::vector<TrackRef> trackPairV0Test(2);
         range = flipIterate(indices.size(), false);
+
+        // the track selection is needed again for each pair of tracks, evaluate it once
+        std::vector<char> selected(indices.size());
+        range_for(i, range)
+                selected[i] = trackSelector(tracks[indices[i]], ipData[indices[i]], *jet, pv);
+
         range_for(i, range) {
                 std::size_t idx = indices[i];
                 const reco::btag::TrackIPData &data = ipData[idx];
@@ -164,7 +170,7 @@ void CombinedSVComputer::fillCommonVariables(reco::TaggingVariableList & vars, r
                 //allKinematics.add(track); // would make more sense for some variables, e.g. vertexEnergyRatio nicely between 0 and 1, but not necessarily the best option for the discriminating power...
 
                 // filter track -> this track selection can be tighter than the vertex track selection (used to fill the track related variables...)
-                if (!trackSelector(track, data, *jet, pv))
+                if (!selected[i])
                         continue;
 
                 // add track to kinematics for all tracks in jet
@@ -183,13 +189,11 @@ void CombinedSVComputer::fillCommonVariables(reco::TaggingVariableList & vars, r
                         if (i == j)
                                 continue;
 
-                        std::size_t pairIdx = indices[j];
-                        const reco::btag::TrackIPData &pairTrackData = ipData[pairIdx];
-                        const TrackRef &pairTrack = tracks[pairIdx];
-
-                        if (!trackSelector(pairTrack, pairTrackData, *jet, pv))
+                        if (!selected[j])
                                 continue;
 
+                        const TrackRef &pairTrack = tracks[indices[j]];
+
                         trackPairV0Test[1] = pairTrack;
                         if (!trackPairV0Filter(trackPairV0Test)) {
                                 ok = false;
@@ -243,10 +247,12 @@ void CombinedSVComputer::fillCommonVariables(reco::TaggingVariableList & vars, r
 	vars.insert(btau::trackSumJetDeltaR,VectorUtil::DeltaR(allKinematics.vectorSum(), jetDir), true);
 	vars.insert(btau::trackSumJetEtRatio,allKinematics.vectorSum().Et() / ipInfo.jet()->et(), true);
 	
-	vars.insert(btau::trackSip3dSigAboveCharm, flipValue(threshTrack(ipInfo, reco::btag::IP3DSig, *jet, pv).ip3d.significance(),false),true);
-	vars.insert(btau::trackSip3dValAboveCharm, flipValue(threshTrack(ipInfo, reco::btag::IP3DSig, *jet, pv).ip3d.value(),false),true);
-	vars.insert(btau::trackSip2dSigAboveCharm, flipValue(threshTrack(ipInfo, reco::btag::IP2DSig, *jet, pv).ip2d.significance(),false),true);
-	vars.insert(btau::trackSip2dValAboveCharm, flipValue(threshTrack(ipInfo, reco::btag::IP2DSig, *jet, pv).ip2d.value(),false),true);
+	const reco::btag::TrackIPData &thresh3d = threshTrack(ipInfo, reco::btag::IP3DSig, *jet, pv);
+	const reco::btag::TrackIPData &thresh2d = threshTrack(ipInfo, reco::btag::IP2DSig, *jet, pv);
+	vars.insert(btau::trackSip3dSigAboveCharm, flipValue(thresh3d.ip3d.significance(),false),true);
+	vars.insert(btau::trackSip3dValAboveCharm, flipValue(thresh3d.ip3d.value(),false),true);
+	vars.insert(btau::trackSip2dSigAboveCharm, flipValue(thresh2d.ip2d.significance(),false),true);
+	vars.insert(btau::trackSip2dValAboveCharm, flipValue(thresh2d.ip2d.value(),false),true);
 
         if (vtxType != btag::Vertices::NoVertex) {
                 math::XYZTLorentzVector allSum = useTrackWeights
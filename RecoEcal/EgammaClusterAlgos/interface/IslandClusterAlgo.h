@@ -7,6 +7,8 @@
 #include "DataFormats/EcalRecHit/interface/EcalRecHit.h"
 #include "DataFormats/EcalRecHit/interface/EcalRecHitCollections.h"
 #include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/Common/interface/SortedCollectionDenseIndex.h"
 #include "DataFormats/EgammaReco/interface/BasicCluster.h"
 
 #include "RecoCaloTools/Navigation/interface/CaloNavigator.h"
@@ -21,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <memory>
 
 typedef std::map<DetId, EcalRecHit> RecHitsMap;
 
@@ -73,6 +76,19 @@ class IslandClusterAlgo
   // collection of all rechits
   const EcalRecHitCollection *recHits_;
 
+  // hashed index of the crystals of the subdetector being clustered, out of range for the others
+  struct HashedIndex {
+    int subdet;
+    unsigned int operator()(DetId id) const {
+      if (id.det() != DetId::Ecal || id.subdetId() != subdet) return EBDetId::kSizeForDenseIndexing;
+      return subdet == EcalBarrel ? EBDetId(id).hashedIndex() : EEDetId(id).hashedIndex();
+    }
+  };
+
+  // constant time lookup of the rechits, used by the neighbour searches
+  typedef edm::SortedCollectionDenseIndex<EcalRecHit, HashedIndex> RecHitIndex;
+  std::unique_ptr<RecHitIndex> recHitIndex_;
+
   // The vector of seeds:
   std::vector<EcalRecHit> seeds;
 
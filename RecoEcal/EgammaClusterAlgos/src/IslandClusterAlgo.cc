@@ -28,6 +28,8 @@ std::vector<reco::BasicCluster> IslandClusterAlgo::makeClusters(
   clusters_v.clear();
 
   recHits_ = hits;
+  HashedIndex hashedIndex = { ecalPart == barrel ? EcalBarrel : EcalEndcap };
+  recHitIndex_.reset(new RecHitIndex(*hits, (ecalPart == barrel ? EBDetId::kSizeForDenseIndexing : EEDetId::kSizeForDenseIndexing), hashedIndex));
 
   double threshold = 0;
   std::string ecalPart_string;
@@ -165,8 +167,8 @@ void IslandClusterAlgo::searchNorth(const CaloNavigator<DetId> &navigator)
   if (used_s.find(northern) != used_s.end()) return;
 
 
-  EcalRecHitCollection::const_iterator southern_it = recHits_->find(southern);
-  EcalRecHitCollection::const_iterator northern_it = recHits_->find(northern);
+  EcalRecHitCollection::const_iterator southern_it = recHitIndex_->find(southern);
+  EcalRecHitCollection::const_iterator northern_it = recHitIndex_->find(northern);
 
   if (shouldBeAdded(northern_it, southern_it))
     {
@@ -186,8 +188,8 @@ void IslandClusterAlgo::searchSouth(const CaloNavigator<DetId> &navigator)
   if (used_s.find(southern) != used_s.end()) return;
 
 
-  EcalRecHitCollection::const_iterator northern_it = recHits_->find(northern);
-  EcalRecHitCollection::const_iterator southern_it = recHits_->find(southern);
+  EcalRecHitCollection::const_iterator northern_it = recHitIndex_->find(northern);
+  EcalRecHitCollection::const_iterator southern_it = recHitIndex_->find(southern);
 
   if (shouldBeAdded(southern_it, northern_it))
     {
@@ -201,11 +203,11 @@ void IslandClusterAlgo::searchSouth(const CaloNavigator<DetId> &navigator)
 void IslandClusterAlgo::searchWest(const CaloNavigator<DetId> &navigator, const CaloSubdetectorTopology* topology)
 {
   DetId eastern = navigator.pos();
-  EcalRecHitCollection::const_iterator eastern_it = recHits_->find(eastern);
+  EcalRecHitCollection::const_iterator eastern_it = recHitIndex_->find(eastern);
 
   DetId western = navigator.west();
   if (western == DetId(0)) return; // This means that we went off the ECAL!
-  EcalRecHitCollection::const_iterator western_it = recHits_->find(western);
+  EcalRecHitCollection::const_iterator western_it = recHitIndex_->find(western);
 
   if (shouldBeAdded(western_it, eastern_it))
     {
@@ -226,11 +228,11 @@ void IslandClusterAlgo::searchWest(const CaloNavigator<DetId> &navigator, const
 void IslandClusterAlgo::searchEast(const CaloNavigator<DetId> &navigator, const CaloSubdetectorTopology* topology)
 {
   DetId western = navigator.pos();
-  EcalRecHitCollection::const_iterator western_it = recHits_->find(western);
+  EcalRecHitCollection::const_iterator western_it = recHitIndex_->find(western);
 
   DetId eastern = navigator.east();
   if (eastern == DetId(0)) return; // This means that we went off the ECAL!
-  EcalRecHitCollection::const_iterator eastern_it = recHits_->find(eastern);
+  EcalRecHitCollection::const_iterator eastern_it = recHitIndex_->find(eastern);
 
   if (shouldBeAdded(eastern_it, western_it))
     {
@@ -276,7 +278,7 @@ void IslandClusterAlgo::makeCluster(const EcalRecHitCollection* hits,
   std::vector< std::pair<DetId, float> >::iterator it;
   for (it = current_v.begin(); it != current_v.end(); it++)
     {
-      EcalRecHitCollection::const_iterator itt = hits->find( (*it).first );
+      EcalRecHitCollection::const_iterator itt = recHitIndex_->find( (*it).first );
       EcalRecHit hit_p = *itt;
       if ( (*it).first.subdetId() == EcalBarrel ) {
               caloID = reco::CaloID::DET_ECAL_BARREL;
@@ -34,6 +34,7 @@
 //#include "DataFormats/Math/interface/Point3D.h"
 #include "DataFormats/Math/interface/Vector3D.h"
 //includes for ShowerShape function to work
+#include <algorithm>
 #include <vector>
 #include <math.h>
 #include <TMath.h>
@@ -623,9 +624,9 @@ std::vector<typename EcalClusterToolsT<noZS>::EcalClusterEnergyDeposition> EcalC
     // loop over crystals
     for(posCurrent=clusterDetIds.begin(); posCurrent!=clusterDetIds.end(); ++posCurrent) {
         EcalRecHitCollection::const_iterator itt = recHits->find( (*posCurrent).first );
-        testEcalRecHit=*itt;
 
-        if(( (*posCurrent).first != DetId(0)) && (recHits->find( (*posCurrent).first ) != recHits->end())) {
+        if(( (*posCurrent).first != DetId(0)) && (itt != recHits->end())) {
+            testEcalRecHit=*itt;
 	  clEdep.deposited_energy = testEcalRecHit.energy() * (noZS ? 1.0 : (*posCurrent).second);
             // if logarithmic weight is requested, apply cut on minimum energy of the recHit
             if(logW) {
@@ -1465,25 +1466,31 @@ std::vector<float> EcalClusterToolsT<noZS>::roundnessBarrelSuperClustersUserExte
 
     std::vector<int> seedPosition = EcalClusterToolsT<noZS>::getSeedPosition(  RH_ptrs_fracs  );
 
+    // the SC's recHits found in recHits, looked up once rather than for each recHit;
+    // the fraction used is the one of the last of them
+    std::vector<DetId> SCrhIds;
+    SCrhIds.reserve(myHitsPair.size());
+    float SCrh_fraction = 0;
+    for(unsigned int i=0; i<myHitsPair.size(); i++){
+        EcalRecHitCollection::const_iterator SCrh = recHits.find(myHitsPair[i].first);
+        if(SCrh != recHits.end()){
+	  SCrh_fraction = myHitsPair[i].second;
+	  SCrhIds.push_back(SCrh->detid());
+        }
+    }//for loop over SC's recHits
+    std::sort(SCrhIds.begin(), SCrhIds.end());
+    const bool is_SCrh_inside_recHits = !SCrhIds.empty();
+
     for(EcalRecHitCollection::const_iterator rh = recHits.begin(); rh != recHits.end(); rh++){
         EBDetId EBdetIdi( rh->detid() );
-	float the_fraction = 0;
+	const float the_fraction = SCrh_fraction;
         //if(rh != recHits.end())
         bool inEtaWindow = (   abs(  deltaIEta(seedPosition[0],EBdetIdi.ieta())  ) <= ieta_delta   );
         bool inPhiWindow = (   abs(  deltaIPhi(seedPosition[1],EBdetIdi.iphi())  ) <= iphi_delta   );
         bool passEThresh = (  rh->energy() > energyRHThresh  );
-        bool alreadyCounted = false;
 
         // figure out if the rechit considered now is already inside the SC
-        bool is_SCrh_inside_recHits = false;
-        for(unsigned int i=0; i<myHitsPair.size(); i++){
-            EcalRecHitCollection::const_iterator SCrh = recHits.find(myHitsPair[i].first);
-            if(SCrh != recHits.end()){
-	      the_fraction = myHitsPair[i].second;
-                is_SCrh_inside_recHits = true;
-                if( rh->detid() == SCrh->detid()  ) alreadyCounted = true;
-            }
-        }//for loop over SC's recHits
+        const bool alreadyCounted = std::binary_search(SCrhIds.begin(), SCrhIds.end(), rh->detid());
 
         if( is_SCrh_inside_recHits && !alreadyCounted && passEThresh && inEtaWindow && inPhiWindow){
 	  RH_ptrs_fracs.push_back( std::make_pair(&(*rh),the_fraction) );
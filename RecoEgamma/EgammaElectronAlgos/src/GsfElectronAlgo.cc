@@ -44,6 +44,7 @@
 #include <Math/Point3D.h>
 #include <sstream>
 #include <algorithm>
+#include <set>
 
 
 using namespace edm ;
@@ -906,25 +907,22 @@ void GsfElectronAlgo::completeElectrons(const gsfAlgoHelpers::HeavyObjectCache*
   if (electronData_!=0)
    { throw cms::Exception("GsfElectronAlgo|InternalError")<<"unexpected electron data" ; }
 
+  // the cores of the existing electrons ; the electrons created below
+  // have cores which are not met again in the loop
+  std::set<GsfElectronCoreRef> existingCores ;
+  GsfElectronPtrCollection::const_iterator itrEle ;
+  for
+   ( itrEle = eventData_->electrons->begin() ;
+     itrEle != eventData_->electrons->end() ;
+     itrEle++ )
+   { existingCores.insert((*itrEle)->core()) ; }
+
   const GsfElectronCoreCollection * coreCollection = eventData_->coreElectrons.product() ;
   for ( unsigned int i=0 ; i<coreCollection->size() ; ++i )
    {
     // check there is no existing electron with this core
     const GsfElectronCoreRef coreRef = edm::Ref<GsfElectronCoreCollection>(eventData_->coreElectrons,i) ;
-    bool coreFound = false ;
-    GsfElectronPtrCollection::const_iterator itrEle ;
-    for
-     ( itrEle = eventData_->electrons->begin() ;
-       itrEle != eventData_->electrons->end() ;
-       itrEle++ )
-     {
-      if ((*itrEle)->core()==coreRef)
-       {
-        coreFound = true ;
-        break ;
-       }
-     }
-    if (coreFound) continue ;
+    if (existingCores.find(coreRef)!=existingCores.end()) continue ;
 
     // check there is a super-cluster
     if (coreRef->superCluster().isNull()) continue ;
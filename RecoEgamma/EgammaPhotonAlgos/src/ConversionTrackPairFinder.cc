@@ -166,11 +166,19 @@ ConversionTrackPairFinder::~ConversionTrackPairFinder() {
   if ( scTrkAssocMap.size() > 2 ){
     
 
+    // consider only tracks associated to the same SC: group them by SC first,
+    // keeping the order of the map within each group
+    std::map<reco::CaloClusterPtr, std::vector<std::map<reco::TransientTrack,  reco::CaloClusterPtr>::const_iterator> > tracksOfSC;
     for( iMap1 =   scTrkAssocMap.begin(); iMap1 !=   scTrkAssocMap.end(); ++iMap1) {
-      for( iMap2 =  iMap1; iMap2 !=   scTrkAssocMap.end(); ++iMap2) {
-    	// consider only tracks associated to the same SC 
+      tracksOfSC[iMap1->second].push_back(iMap1);
+    }
 
-        if (  (iMap1->second) != (iMap2->second) ) continue;  
+    for( auto const& scAndTracks : tracksOfSC ) {
+      auto const& tracks = scAndTracks.second;
+      for( auto iTrk1 = tracks.begin(); iTrk1 != tracks.end(); ++iTrk1) {
+        iMap1 = *iTrk1;
+        for( auto iTrk2 = iTrk1; iTrk2 != tracks.end(); ++iTrk2) {
+          iMap2 = *iTrk2;
 	
 	if (   ((iMap1->first)).charge() *  ((iMap2->first)).charge()  < 0 ) {
 	  
@@ -187,6 +195,7 @@ ConversionTrackPairFinder::~ConversionTrackPairFinder() {
 	  allPairSCAss[thePair]= iMap1->second; 
 
 	}
+        }
       }
     }
 
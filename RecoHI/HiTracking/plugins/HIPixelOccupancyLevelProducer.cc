@@ -0,0 +1,43 @@
+#include "HIPixelOccupancyLevelProducer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <memory>
+
+/*****************************************************************************/
+HIPixelOccupancyLevelProducer::HIPixelOccupancyLevelProducer(const edm::ParameterSet& ps)
+  : theClusters(consumes<SiPixelClusterCollectionNew>(ps.getParameter<edm::InputTag>("source"))),
+    theThresholds(ps.getParameter<std::vector<unsigned int> >("clusterThresholds"))
+{
+  if(!std::is_sorted(theThresholds.begin(), theThresholds.end()))
+    throw cms::Exception("Configuration") << "HIPixelOccupancyLevelProducer: the clusterThresholds must be in increasing order";
+
+  produces<int>();
+}
+
+/*****************************************************************************/
+void HIPixelOccupancyLevelProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
+{
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("source", edm::InputTag("siPixelClusters"));
+  desc.add<std::vector<unsigned int> >("clusterThresholds", std::vector<unsigned int>())->setComment("Number of pixel clusters from which each level starts, in increasing order.");
+  descriptions.add("hiPixelOccupancyLevel", desc);
+}
+
+/*****************************************************************************/
+void HIPixelOccupancyLevelProducer::produce(edm::StreamID, edm::Event& ev, const edm::EventSetup& es) const
+{
+  edm::Handle<SiPixelClusterCollectionNew> clusters;
+  ev.getByToken(theClusters, clusters);
+  const unsigned int nClusters = clusters->dataSize();
+
+  const int level = std::upper_bound(theThresholds.begin(), theThresholds.end(), nClusters) - theThresholds.begin();
+  LogTrace("HIPixelOccupancyLevel") << "[HIPixelOccupancyLevel] " << nClusters << " pixel clusters, level " << level;
+
+  ev.put(std::make_unique<int>(level));
+}
@@ -0,0 +1,31 @@
+#ifndef HIPixelOccupancyLevelProducer_H
+#define HIPixelOccupancyLevelProducer_H
+
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+
+namespace edm { class Event; class EventSetup; class ConfigurationDescriptions; }
+
+/* The occupancy level of the event, from the number of pixel clusters
+ * as counted by FTSLuminosityFromPixelClusters: the number of the
+ * thresholds, in increasing order, that the count reaches.  The level
+ * is put in the event, so the tracking steps configured per level can
+ * read it, and the decision made for each event is kept with it.
+ */
+class HIPixelOccupancyLevelProducer : public edm::global::EDProducer<>
+{
+public:
+  explicit HIPixelOccupancyLevelProducer(const edm::ParameterSet& ps);
+  ~HIPixelOccupancyLevelProducer() {}
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  virtual void produce(edm::StreamID, edm::Event& ev, const edm::EventSetup& es) const override;
+
+  edm::EDGetTokenT<SiPixelClusterCollectionNew> theClusters;
+  std::vector<unsigned int> theThresholds;
+};
+#endif
@@ -23,8 +23,13 @@
 #include "DataFormats/Common/interface/DetSetVector.h"    
 #include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHitCollection.h"
 
+#include "FWCore/Utilities/interface/Exception.h"
+
 #include "TMath.h"
 
+#include <algorithm>
+#include <cmath>
+
 class HITrackingRegionForPrimaryVtxProducer : public TrackingRegionProducer {
   
  public:
@@ -53,6 +58,17 @@ class HITrackingRegionForPrimaryVtxProducer : public TrackingRegionProducer {
     theUseFixedError    = regionPSet.getParameter<bool>("useFixedError");
     vertexCollName      = regionPSet.getParameter<edm::InputTag>("VertexCollection");
     vertexCollToken     = iC.consumes<reco::VertexCollection>(vertexCollName);
+
+    // optional configuration per occupancy level, see HIPixelOccupancyLevelProducer
+    theUseOccupancyLevel = regionPSet.existsAs<edm::InputTag>("occupancyLevel");
+    if(theUseOccupancyLevel) {
+      theOccupancyLevelToken = iC.consumes<int>(regionPSet.getParameter<edm::InputTag>("occupancyLevel"));
+      thePtMinForLevel       = regionPSet.getParameter<std::vector<double> >("ptMinForLevel");
+      theNPhiRegionsForLevel = regionPSet.getParameter<std::vector<unsigned int> >("nPhiRegionsForLevel");
+      theEtaHalfWidth        = regionPSet.getParameter<double>("etaHalfWidth");
+      if(thePtMinForLevel.empty() || thePtMinForLevel.size() != theNPhiRegionsForLevel.size())
+        throw cms::Exception("Configuration") << "HITrackingRegionForPrimaryVtxProducer: ptMinForLevel and nPhiRegionsForLevel must have one entry per occupancy level";
+    }
   }   
   
   virtual ~HITrackingRegionForPrimaryVtxProducer(){}
@@ -75,6 +91,19 @@ class HITrackingRegionForPrimaryVtxProducer : public TrackingRegionProducer {
   
   virtual std::vector<std::unique_ptr<TrackingRegion> > regions(const edm::Event& ev, const edm::EventSetup& es) const {
     
+    // the occupancy level of the event, beyond the last one configured as the last one
+    unsigned int level = 0;
+    if(theUseOccupancyLevel) {
+      edm::Handle<int> levelHandle;
+      ev.getByToken(theOccupancyLevelToken, levelHandle);
+      level = std::min<unsigned int>(std::max(*levelHandle,0), thePtMinForLevel.size()-1);
+      LogTrace("heavyIonHLTVertexing")<<" [HIVertexing: occupancy level " << level << "]";
+
+      // a negative ptMin turns the step off at this level
+      if(thePtMinForLevel[level] < 0) return std::vector<std::unique_ptr<TrackingRegion> >();
+      if(theNPhiRegionsForLevel[level] > 1) return phiRegions(ev, thePtMinForLevel[level], theNPhiRegionsForLevel[level]);
+    }
+
     int estMult = estimateMultiplicity(ev, es);
     
     // from MC relating first layer pixel hits to "findable" sim tracks with pt>1 GeV
@@ -102,23 +131,42 @@ class HITrackingRegionForPrimaryVtxProducer : public TrackingRegionProducer {
       LogTrace("heavyIonHLTVertexing")<<"  [Regional Tracking: factor of decrease: " << decEta*2. << "]";  // 2:from phi
     }
     
-    float minpt = thePtMin;
+    const float ptMin = theUseOccupancyLevel ? thePtMinForLevel[level] : thePtMin;
+    float minpt = ptMin;
     float varPtCutoff = 1500; //cutoff
     if(doVariablePtMin && estMult < varPtCutoff) {
       minpt = 0.075;
-      if(estMult > 0) minpt += estMult * (thePtMin - 0.075)/varPtCutoff; // lower ptMin linearly with pixel hit multiplicity
+      if(estMult > 0) minpt += estMult * (ptMin - 0.075)/varPtCutoff; // lower ptMin linearly with pixel hit multiplicity
     }
     
     // tracking region selection
     std::vector<std::unique_ptr<TrackingRegion> > result;
     double halflength;
     GlobalPoint origin;
+    if(regionOrigin(ev, origin, halflength)) {
+      if(estTracks>regTracking) {  // regional tracking
+        result.push_back( 
+          std::make_unique<RectangularEtaPhiTrackingRegion>(theDirection, origin, ptMin, theOriginRadius, halflength, etaB, phiB, RectangularEtaPhiTrackingRegion::UseMeasurementTracker::kNever, thePrecise) );
+      }
+      else {                       // global tracking
+        LogTrace("heavyIonHLTVertexing")<<" [HIVertexing: Global Tracking]";
+        result.push_back( 
+          std::make_unique<GlobalTrackingRegion>(minpt, origin, theOriginRadius, halflength, thePrecise) );
+      }
+    } 
+    return result;
+  }
+  
+ private:
+  // origin and half length in z of the regions, false if there is no beam spot
+  bool regionOrigin(const edm::Event& ev, GlobalPoint& origin, double& halflength) const {
     edm::Handle<reco::BeamSpot> bsHandle;
     ev.getByToken(theBeamSpotToken, bsHandle);
-    if(bsHandle.isValid()) {
-      const reco::BeamSpot & bs = *bsHandle; 
-      origin=GlobalPoint(bs.x0(), bs.y0(), bs.z0()); 
-      halflength=theNSigmaZ*bs.sigmaZ();
+    if(!bsHandle.isValid()) return false;
+
+    const reco::BeamSpot & bs = *bsHandle; 
+    origin=GlobalPoint(bs.x0(), bs.y0(), bs.z0()); 
+    halflength=theNSigmaZ*bs.sigmaZ();
       
     if(theUseFoundVertices)
     {
@@ -132,21 +180,26 @@ class HITrackingRegionForPrimaryVtxProducer : public TrackingRegionProducer {
 	  halflength = (theUseFixedError ? theFixedError : (iV->zError())*theSigmaZVertex); 
       }
     }
+    return true;
+  }
 
-      if(estTracks>regTracking) {  // regional tracking
-        result.push_back( 
-          std::make_unique<RectangularEtaPhiTrackingRegion>(theDirection, origin, thePtMin, theOriginRadius, halflength, etaB, phiB, RectangularEtaPhiTrackingRegion::UseMeasurementTracker::kNever, thePrecise) );
-      }
-      else {                       // global tracking
-        LogTrace("heavyIonHLTVertexing")<<" [HIVertexing: Global Tracking]";
-        result.push_back( 
-          std::make_unique<GlobalTrackingRegion>(minpt, origin, theOriginRadius, halflength, thePrecise) );
-      }
-    } 
+  // the full azimuth split in nPhi regions, for the busiest events
+  std::vector<std::unique_ptr<TrackingRegion> > phiRegions(const edm::Event& ev, float ptMin, unsigned int nPhi) const {
+    std::vector<std::unique_ptr<TrackingRegion> > result;
+    double halflength;
+    GlobalPoint origin;
+    if(!regionOrigin(ev, origin, halflength)) return result;
+
+    const float phiB = TMath::Pi()/nPhi;
+    LogTrace("heavyIonHLTVertexing")<<" [HIVertexing: " << nPhi << " regions in phi, ptMin " << ptMin << "]";
+    for(unsigned int i = 0; i < nPhi; ++i) {
+      const float phi = -TMath::Pi() + (2*i+1)*phiB;
+      result.push_back(
+        std::make_unique<RectangularEtaPhiTrackingRegion>(GlobalVector(std::cos(phi), std::sin(phi), 0.), origin, ptMin, theOriginRadius, halflength, theEtaHalfWidth, phiB, RectangularEtaPhiTrackingRegion::UseMeasurementTracker::kNever, thePrecise) );
+    }
     return result;
   }
   
- private:
   double thePtMin; 
   double theOriginRadius; 
   double theNSigmaZ;
@@ -165,6 +218,11 @@ class HITrackingRegionForPrimaryVtxProducer : public TrackingRegionProducer {
   edm::InputTag vertexCollName;
   edm::EDGetTokenT<reco::VertexCollection> vertexCollToken;
 
+  bool theUseOccupancyLevel;
+  edm::EDGetTokenT<int> theOccupancyLevelToken;
+  std::vector<double> thePtMinForLevel;
+  std::vector<unsigned int> theNPhiRegionsForLevel;
+  double theEtaHalfWidth;
 
 };
 
@@ -11,6 +11,10 @@ DEFINE_FWK_MODULE(HIPixelClusterVtxProducer);
 #include "HIPixelMedianVtxProducer.h"
 DEFINE_FWK_MODULE(HIPixelMedianVtxProducer);
 
+// Occupancy level from the pixel clusters
+#include "HIPixelOccupancyLevelProducer.h"
+DEFINE_FWK_MODULE(HIPixelOccupancyLevelProducer);
+
 // Best Vertex Producer
 #include "RecoHI/HiTracking/interface/HIBestVertexProducer.h"
 DEFINE_FWK_MODULE(HIBestVertexProducer);
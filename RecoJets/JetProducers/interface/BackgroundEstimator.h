@@ -45,6 +45,15 @@ public:
   /// \param csa      the ClusterSequenceArea to use
   /// \param range    the range over which jets will be considered
   BackgroundEstimator(const ClusterSequenceAreaBase &csa, const RangeDefinition &range);
+
+  /// ctor with the jets to use given, to avoid getting the inclusive
+  /// jets of csa again when estimating the background in several ranges
+  /// \param csa                 the ClusterSequenceArea to use
+  /// \param range               the range over which jets will be considered
+  /// \param included_jets       the jets to use
+  /// \param all_from_inclusive  true if included_jets are all the inclusive jets of csa
+  BackgroundEstimator(const ClusterSequenceAreaBase &csa, const RangeDefinition &range,
+                      const std::vector<PseudoJet> &included_jets, bool all_from_inclusive = true);
   
   /// default dtor
   ~BackgroundEstimator();
@@ -136,6 +145,9 @@ public:
   }
   
 private:
+  /// reset everything but the list of included jets
+  void _reset_parameters();
+
   /// do the actual job
   void _compute();
   
@@ -9,6 +9,7 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "DataFormats/JetReco/interface/Jet.h"
 #include "DataFormats/Common/interface/ValueMap.h"
+#include "RecoJets/JetProducers/interface/ECFHelper.h"
 #include "fastjet/contrib/EnergyCorrelator.hh"
 
 
@@ -17,9 +18,11 @@ class ECFAdder : public edm::stream::EDProducer<> {
     explicit ECFAdder(const edm::ParameterSet& iConfig);
     
     void produce(edm::Event & iEvent, const edm::EventSetup & iSetup) override;
-    float getECF(unsigned index, const edm::Ptr<reco::Jet> & object) const;
     
  private:	
+    void getConstituents(const edm::Ptr<reco::Jet> & object, std::vector<fastjet::PseudoJet> & particles) const;
+    float getECF(unsigned index, const std::vector<fastjet::PseudoJet> & particles) const;
+
     edm::InputTag                          src_;
     edm::EDGetTokenT<edm::View<reco::Jet>> src_token_;
     std::vector<unsigned>                  Njets_;
@@ -27,6 +30,9 @@ class ECFAdder : public edm::stream::EDProducer<> {
     double                                 beta_ ;
 
     std::vector<std::auto_ptr<fastjet::contrib::EnergyCorrelator> >  routine_; 
+
+    // the N up to 3, without the reclustering
+    reco::helper::ECFHelper                ecfHelper_;
 };
 
 #endif
@@ -0,0 +1,35 @@
+#ifndef RecoJets_JetProducers_interface_ECFHelper_h
+#define RecoJets_JetProducers_interface_ECFHelper_h
+
+#include <vector>
+
+#include "fastjet/PseudoJet.hh"
+
+
+namespace reco {
+
+  namespace helper {
+
+    // The energy correlation functions up to N=3 of the pt_R measure of the fastjet contrib
+    // EnergyCorrelator, computed in a single pass over the constituents, without reclustering them.
+    class ECFHelper {
+
+    public :
+      explicit ECFHelper( double beta ) : beta_( beta ) {}
+
+      // ecf[N] for N up to maxN (at most 3), the others are zero. Without constituents
+      // all of them are -1, as when the reclustering finds no jet.
+      void calculate( const std::vector<fastjet::PseudoJet> & particles, unsigned maxN, double (&ecf)[4] );
+
+    private:
+
+      double beta_;
+
+      // the transverse momenta of the constituents and the angles of all their pairs, to the power beta
+      std::vector<double> pt_;
+      std::vector<double> angles_;
+
+    };
+  }
+}
+#endif
@@ -3,11 +3,14 @@
 #include "fastjet/ClusterSequence.hh"
 #include "FWCore/Framework/interface/MakerMacros.h"
 
+#include <algorithm>
+
 ECFAdder::ECFAdder(const edm::ParameterSet& iConfig) :
   src_(iConfig.getParameter<edm::InputTag>("src")),
   src_token_(consumes<edm::View<reco::Jet>>(src_)),
   Njets_(iConfig.getParameter<std::vector<unsigned> >("Njets")),
-  beta_(iConfig.getParameter<double>("beta"))
+  beta_(iConfig.getParameter<double>("beta")),
+  ecfHelper_(beta_)
 {
   for ( std::vector<unsigned>::const_iterator n = Njets_.begin(); n != Njets_.end(); ++n )
     {
@@ -24,35 +27,42 @@ void ECFAdder::produce(edm::Event & iEvent, const edm::EventSetup & iSetup) {
   edm::Handle<edm::View<reco::Jet> > jets;
   iEvent.getByToken(src_token_, jets);
   
-  unsigned i=0;
-  for ( std::vector<unsigned>::const_iterator n = Njets_.begin(); n != Njets_.end(); ++n )
-    {
-      // prepare room for output
-      std::vector<float> ecfN;
-      ecfN.reserve(jets->size());
-
-      for ( typename edm::View<reco::Jet>::const_iterator jetIt = jets->begin() ; jetIt != jets->end() ; ++jetIt ) {
+  // prepare room for output
+  std::vector<std::vector<float> > ecfN(Njets_.size());
+  for ( auto & v : ecfN ) v.reserve(jets->size());
 
-	edm::Ptr<reco::Jet> jetPtr = jets->ptrAt(jetIt - jets->begin());
+  // the constituents of each jet are read once for all the N, ECF(3) is
+  // the only costly one and only computed if asked for
+  unsigned maxN = 0;
+  for ( unsigned n : Njets_ ) if ( n < 4 ) maxN = std::max( maxN, n );
+  std::vector<fastjet::PseudoJet> FJparticles;
+  for ( typename edm::View<reco::Jet>::const_iterator jetIt = jets->begin() ; jetIt != jets->end() ; ++jetIt ) {
 
-	float t=getECF( i, jetPtr );
+    edm::Ptr<reco::Jet> jetPtr = jets->ptrAt(jetIt - jets->begin());
+    getConstituents( jetPtr, FJparticles );
 
-	ecfN.push_back(t);
-      }
+    double ecf[4];
+    ecfHelper_.calculate( FJparticles, maxN, ecf );
+    for ( unsigned i = 0; i < Njets_.size(); ++i ) {
+      float t = Njets_[i] < 4 ? ecf[Njets_[i]] : getECF( i, FJparticles );
+      ecfN[i].push_back(t);
+    }
+  }
 
+  for ( unsigned i = 0; i < Njets_.size(); ++i )
+    {
       std::auto_ptr<edm::ValueMap<float> > outT(new edm::ValueMap<float>());
       edm::ValueMap<float>::Filler fillerT(*outT);
-      fillerT.insert(jets, ecfN.begin(), ecfN.end());
+      fillerT.insert(jets, ecfN[i].begin(), ecfN[i].end());
       fillerT.fill();
 
       iEvent.put(outT,variables_[i].c_str());
-      ++i;
     }
 }
 
-float ECFAdder::getECF(unsigned index, const edm::Ptr<reco::Jet> & object) const
+void ECFAdder::getConstituents(const edm::Ptr<reco::Jet> & object, std::vector<fastjet::PseudoJet> & FJparticles) const
 {
-  std::vector<fastjet::PseudoJet> FJparticles;
+  FJparticles.clear();
   for (unsigned k = 0; k < object->numberOfDaughters(); ++k)
     {
       const reco::CandidatePtr & dp = object->daughterPtr(k);
@@ -61,6 +71,10 @@ float ECFAdder::getECF(unsigned index, const edm::Ptr<reco::Jet> & object) const
       else
 	edm::LogWarning("MissingJetConstituent") << "Jet constituent required for ECF computation is missing!";
     }
+}
+
+float ECFAdder::getECF(unsigned index, const std::vector<fastjet::PseudoJet> & FJparticles) const
+{
     fastjet::JetDefinition jetDef(fastjet::antikt_algorithm, 999);
     fastjet::ClusterSequence thisClustering_basic(FJparticles, jetDef);
     std::vector<fastjet::PseudoJet> out_jets_basic = thisClustering_basic.inclusive_jets(0);
@@ -68,6 +82,4 @@ float ECFAdder::getECF(unsigned index, const edm::Ptr<reco::Jet> & object) const
   return routine_[index]->result(out_jets_basic[0]); 
 }
 
-
-
 DEFINE_FWK_MODULE(ECFAdder);
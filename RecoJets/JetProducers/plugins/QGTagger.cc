@@ -133,6 +133,7 @@ bool QGTagger::isPackedCandidate(const reco::Candidate* candidate){
 
 /// Calculation of axis2, mult and ptD
 std::tuple<int, float, float> QGTagger::calcVariables(const reco::Jet *jet, edm::Handle<reco::VertexCollection>& vC){
+  static const reco::TrackBase::TrackQuality highPurity = reco::TrackBase::qualityByName("highPurity");
   float sum_weight = 0., sum_deta = 0., sum_dphi = 0., sum_deta2 = 0., sum_dphi2 = 0., sum_detadphi = 0., sum_pt = 0.;
   int mult = 0;
 
@@ -156,15 +157,18 @@ std::tuple<int, float, float> QGTagger::calcVariables(const reco::Jet *jet, edm:
 
       reco::TrackRef itrk = part->trackRef();
       if(itrk.isNonnull()){												//Track exists --> charged particle
+        if(vC->empty()) continue;											//No vertex the track could come from
         auto vtxLead  = vC->begin();
         auto vtxClose = vC->begin();											//Search for closest vertex to track
+        double closeDz = itrk->dz(vtxClose->position());
         for(auto vtx = vC->begin(); vtx != vC->end(); ++vtx){
-          if(fabs(itrk->dz(vtx->position())) < fabs(itrk->dz(vtxClose->position()))) vtxClose = vtx;
+          double vtxDz = itrk->dz(vtx->position());
+          if(fabs(vtxDz) < fabs(closeDz)){ vtxClose = vtx; closeDz = vtxDz; }
         }
-        if(!(vtxClose == vtxLead && itrk->quality(reco::TrackBase::qualityByName("highPurity")))) continue;
+        if(!(vtxClose == vtxLead && itrk->quality(highPurity))) continue;
 
         if(useQC){													//If useQC, require dz and d0 cuts
-          float dz = itrk->dz(vtxClose->position());
+          float dz = closeDz;
           float d0 = itrk->dxy(vtxClose->position());
           float dz_sigma_square = pow(itrk->dzError(),2) + pow(vtxClose->zError(),2);
           float d0_sigma_square = pow(itrk->d0Error(),2) + pow(vtxClose->xError(),2) + pow(vtxClose->yError(),2);
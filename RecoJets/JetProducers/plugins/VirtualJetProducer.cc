@@ -627,12 +627,14 @@ void VirtualJetProducer::writeJets( edm::Event & iEvent, edm::EventSetup const&
 	  throw cms::Exception("LogicError")<<"fjClusterSeq is not initialized while inputs are present\n ";
 	}
       } else {
+	// the inclusive jets are the same in all the eta ranges
+	const std::vector<fastjet::PseudoJet> inclusiveJets = clusterSequenceWithArea->inclusive_jets();
 	for(int ie = 0; ie < nEta; ++ie){
 	  double eta = puCenters_[ie];
 	  double etamin=eta-puWidth_;
 	  double etamax=eta+puWidth_;
 	  fastjet::RangeDefinition range_rho(etamin,etamax);
-	  fastjet::BackgroundEstimator bkgestim(*clusterSequenceWithArea,range_rho);
+	  fastjet::BackgroundEstimator bkgestim(*clusterSequenceWithArea,range_rho,inclusiveJets);
 	  bkgestim.set_excluded_jets(fjexcluded_jets);
 	  rhos->push_back(bkgestim.rho());
 	  sigmas->push_back(bkgestim.sigma());
@@ -26,6 +26,17 @@ BackgroundEstimator::BackgroundEstimator(const ClusterSequenceAreaBase &csa, con
   reset();
 }
 
+// ctor with the jets to use
+//  - csa                 the ClusterSequenceArea to use
+//  - range               the range over which jets will be considered
+//  - included_jets       the jets to use
+//  - all_from_inclusive  true if included_jets are all the inclusive jets of csa
+BackgroundEstimator::BackgroundEstimator(const ClusterSequenceAreaBase &csa, const RangeDefinition &range,
+                                         const vector<PseudoJet> &included_jets, bool all_from_inclusive)
+  : _csa(csa), _range(range), _included_jets(included_jets), _all_from_inclusive(all_from_inclusive){
+  _reset_parameters();
+}
+
 // default dtor
 BackgroundEstimator::~BackgroundEstimator(){
 
@@ -39,6 +50,11 @@ void BackgroundEstimator::reset(){
   _all_from_inclusive = true;
   //set_included_jets(_csa.inclusive_jets());
 
+  _reset_parameters();
+}
+
+// reset everything but the list of included jets
+void BackgroundEstimator::_reset_parameters(){
   // clear the list of explicitly excluded jets
   _excluded_jets.clear();
   //set_excluded_jets(vector<PseudoJet>());
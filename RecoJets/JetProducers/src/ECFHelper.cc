@@ -0,0 +1,52 @@
+#include "RecoJets/JetProducers/interface/ECFHelper.h"
+
+#include <cmath>
+
+
+// ECF(1) = sum_i pt_i, ECF(2) = sum_i<j pt_i pt_j R_ij^beta and
+// ECF(3) = sum_i<j<k pt_i pt_j pt_k (R_ij R_ik R_jk)^beta, R being the distance
+// in rapidity and phi.  The pair angles are computed once in a symmetric matrix, the
+// innermost sum of ECF(3) runs over contiguous rows of it with four partial sums,
+// which the compiler vectorizes.  The pairs are only computed for maxN > 1.
+void reco::helper::ECFHelper::calculate( const std::vector<fastjet::PseudoJet> & FJparticles, unsigned maxN, double (&ecf)[4] )
+{
+  const unsigned n = FJparticles.size();
+  if ( n == 0 ) {
+    for ( auto & e : ecf ) e = -1;
+    return;
+  }
+  pt_.resize(n);
+  for ( unsigned i = 0; i < n; ++i ) pt_[i] = FJparticles[i].perp();
+  const double * pt = pt_.data();
+
+  double ecf1 = 0, ecf2 = 0, ecf3 = 0;
+  for ( unsigned i = 0; i < n; ++i ) ecf1 += pt[i];
+
+  if ( maxN > 1 ) {
+    angles_.resize(n*n);
+    for ( unsigned i = 0; i < n; ++i ) {
+      angles_[i*n+i] = 0;
+      for ( unsigned j = i+1; j < n; ++j )
+	angles_[i*n+j] = angles_[j*n+i] = std::pow( FJparticles[i].squared_distance(FJparticles[j]), 0.5*beta_ );
+    }
+    for ( unsigned i = 0; i < n; ++i ) {
+      const double * ai = &angles_[i*n];
+      for ( unsigned j = i+1; j < n; ++j ) {
+	const double * aj = &angles_[j*n];
+	double wij = pt[i]*pt[j]*ai[j];
+	ecf2 += wij;
+	if ( maxN < 3 ) continue;
+	double s[4] = {0, 0, 0, 0};
+	unsigned k = j+1;
+	for ( ; k+4 <= n; k += 4 )
+	  for ( unsigned l = 0; l < 4; ++l ) s[l] += pt[k+l]*ai[k+l]*aj[k+l];
+	for ( ; k < n; ++k ) s[0] += pt[k]*ai[k]*aj[k];
+	ecf3 += wij*((s[0]+s[1])+(s[2]+s[3]));
+      }
+    }
+  }
+  ecf[0] = 1;
+  ecf[1] = ecf1;
+  ecf[2] = ecf2;
+  ecf[3] = ecf3;
+}
@@ -323,6 +323,23 @@ PileupJetIdentifier PileupJetIdAlgo::computeIdVariables(const reco::Jet * jet, f
 	internalId_.rho_ = rho;
 
 	float dRmin(1000);
+
+	// the vertices the charged constituents are compared to are the same for all of them:
+	// the good vertices and the copies of the primary one, with and without the ndof cut
+	std::vector<reco::Vertex::Point> goodVtxPos;
+	std::vector<unsigned int> notFakeVtx, primaryVtx;
+	bool anyOtherGoodVtx = false;
+	for (unsigned vtx_i = 0 ; vtx_i < allvtx.size() ; vtx_i++ ) {
+		const reco::Vertex & iv = allvtx[vtx_i];
+		if( iv.isFake() ) { continue; }
+		// the primary vertex may have been copied by the user: check identity by position
+		bool isVtx0 = (iv.position() - vtx->position()).r() < 0.02;
+		notFakeVtx.push_back(vtx_i);
+		if( isVtx0 ) { primaryVtx.push_back(vtx_i); }
+		if( iv.ndof() < 4 ) { continue; }
+		goodVtxPos.push_back(iv.position());
+		anyOtherGoodVtx = anyOtherGoodVtx || ! isVtx0;
+	}
 	
 	for ( unsigned i = 0; i < jet->numberOfSourceCandidatePtrs(); ++i ) {
 	  reco::CandidatePtr pfJetConstituent = jet->sourceCandidatePtr(i);
@@ -426,25 +443,19 @@ PileupJetIdentifier PileupJetIdAlgo::computeIdVariables(const reco::Jet * jet, f
 			   if(lPF->trackRef().isNonnull() ) { 
 	      			float tkpt = candPt;
 				sumTkPt += tkpt;
+				const reco::Track & track = *lPF->trackRef();
 				// 'classic' beta definition based on track-vertex association
 				bool inVtx0 = vtx->trackWeight ( lPF->trackRef()) > 0 ;
 
-				bool inAnyOther = false;
+				// 'classic' beta definition: the track is taken as associated with another
+				// vertex if it is not in the primary one and any other good vertex exists
+				bool inAnyOther = anyOtherGoodVtx && ! inVtx0;
 				// alternative beta definition based on track-vertex distance of closest approach
-				double dZ0 = std::abs(lPF->trackRef()->dz(vtx->position()));
+				double dZ0 = std::abs(track.dz(vtx->position()));
 				double dZ = dZ0;
-				for(reco::VertexCollection::const_iterator  vi=allvtx.begin(); vi!=allvtx.end(); ++vi ) {
-				    const reco::Vertex & iv = *vi;
-				    if( iv.isFake() || iv.ndof() < 4 ) { continue; }
-				        // the primary vertex may have been copied by the user: check identity by position
-				        bool isVtx0  = (iv.position() - vtx->position()).r() < 0.02;
-					// 'classic' beta definition: check if the track is associated with
-					// any vertex other than the primary one
-					if( ! isVtx0 && ! inAnyOther ) {
-					  inAnyOther =  vtx->trackWeight ( lPF->trackRef()) <= 0 ;
-					}
+				for(const auto & position : goodVtxPos) {
 					// alternative beta: find closest vertex to the track
-					dZ = std::min(dZ,std::abs(lPF->trackRef()->dz(iv.position())));
+					dZ = std::min(dZ,std::abs(track.dz(position)));
 				}
 				// classic beta/betaStar
 				if( inVtx0 && ! inAnyOther ) {
@@ -467,23 +478,16 @@ PileupJetIdentifier PileupJetIdAlgo::computeIdVariables(const reco::Jet * jet, f
 				bool inVtxOther = false; 
 				double dZ0=9999.;
 				double dZ_tmp = 9999.;
-				for (unsigned vtx_i = 0 ; vtx_i < allvtx.size() ; vtx_i++ ) {
-         			        auto iv = allvtx[vtx_i];
-
-					if (iv.isFake())
-						continue;
-
-					// Match to vertex in case of copy as above
-                                        bool isVtx0  = (iv.position() - vtx->position()).r() < 0.02;
-
-					if (isVtx0) {
-					    if (lPack->fromPV(vtx_i) == pat::PackedCandidate::PVUsedInFit) inVtx0 = true;
-					    if (lPack->fromPV(vtx_i) == 0) inVtxOther = true;
-					    dZ0 = lPack->dz(vtx_i);
-					}
-
-					if (fabs(lPack->dz(iv.position())) < fabs(dZ_tmp)) {
-						dZ_tmp = lPack->dz(iv.position());
+				// Match to vertex in case of copy as above
+				for (unsigned vtx_i : primaryVtx) {
+					if (lPack->fromPV(vtx_i) == pat::PackedCandidate::PVUsedInFit) inVtx0 = true;
+					if (lPack->fromPV(vtx_i) == 0) inVtxOther = true;
+					dZ0 = lPack->dz(vtx_i);
+				}
+				for (unsigned vtx_i : notFakeVtx) {
+					double dZ = lPack->dz(allvtx[vtx_i].position());
+					if (fabs(dZ) < fabs(dZ_tmp)) {
+						dZ_tmp = dZ;
 					}
 				}
 				if (inVtx0){
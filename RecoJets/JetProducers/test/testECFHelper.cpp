@@ -0,0 +1,80 @@
+// Compares the energy correlation functions of ECFHelper with the brute force
+// sums over all the pairs and triplets of constituents.
+
+#include "RecoJets/JetProducers/interface/ECFHelper.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+  void bruteForce(const std::vector<fastjet::PseudoJet>& particles, double beta, double (&ecf)[4]) {
+    const unsigned n = particles.size();
+    ecf[0] = 1;
+    ecf[1] = ecf[2] = ecf[3] = 0;
+    for (unsigned i = 0; i < n; ++i) {
+      ecf[1] += particles[i].perp();
+      for (unsigned j = i + 1; j < n; ++j) {
+        double rij = std::pow(particles[i].squared_distance(particles[j]), 0.5 * beta);
+        ecf[2] += particles[i].perp() * particles[j].perp() * rij;
+        for (unsigned k = j + 1; k < n; ++k) {
+          double rik = std::pow(particles[i].squared_distance(particles[k]), 0.5 * beta);
+          double rjk = std::pow(particles[j].squared_distance(particles[k]), 0.5 * beta);
+          ecf[3] += particles[i].perp() * particles[j].perp() * particles[k].perp() * rij * rik * rjk;
+        }
+      }
+    }
+  }
+
+  bool close(double a, double b) { return std::abs(a - b) <= 1e-9 * std::max(std::abs(a), std::abs(b)); }
+}
+
+int main() {
+  std::mt19937 engine(42);
+  std::uniform_real_distribution<double> momentum(-50., 50.);
+  std::uniform_real_distribution<double> longitudinal(-200., 200.);
+
+  for (double beta : {1.0, 2.0}) {
+    reco::helper::ECFHelper helper(beta);
+
+    // none of the functions without constituents
+    double ecf[4];
+    helper.calculate(std::vector<fastjet::PseudoJet>(), 3, ecf);
+    for (double e : ecf) {
+      assert(e == -1);
+    }
+
+    // all the sizes around the blocks of four of the innermost sum, and a large jet
+    std::vector<unsigned> sizes;
+    for (unsigned n = 1; n <= 12; ++n) {
+      sizes.push_back(n);
+    }
+    sizes.push_back(150);
+    for (unsigned n : sizes) {
+      std::vector<fastjet::PseudoJet> particles;
+      for (unsigned i = 0; i < n; ++i) {
+        double px = momentum(engine), py = momentum(engine), pz = longitudinal(engine);
+        particles.push_back(fastjet::PseudoJet(px, py, pz, std::sqrt(px * px + py * py + pz * pz) + 0.1));
+      }
+      double expected[4];
+      bruteForce(particles, beta, expected);
+
+      helper.calculate(particles, 3, ecf);
+      for (unsigned N = 0; N < 4; ++N) {
+        if (!close(ecf[N], expected[N])) {
+          std::cout << "ECF(" << N << ") of " << n << " constituents with beta " << beta << ": " << ecf[N]
+                    << " instead of " << expected[N] << std::endl;
+          return 1;
+        }
+      }
+      // the lower N alone, as when ECF(3) is not asked for
+      helper.calculate(particles, 2, ecf);
+      assert(close(ecf[1], expected[1]) && close(ecf[2], expected[2]));
+    }
+  }
+  std::cout << "ECFHelper agrees with the brute force sums" << std::endl;
+  return 0;
+}
@@ -109,6 +109,11 @@ public:
   
   void setGeometry(const CaloTowerTopology* cttopo, const CaloTowerConstituentsMap* ctmap, const HcalTopology* htopo, const CaloGeometry* geo);
 
+  // as above; the towers of the cells are looked up again only when one of the cache identifiers
+  // of the CaloGeometryRecord (constituents map) and HcalRecNumberingRecord (HCAL topology) changes
+  void setGeometry(const CaloTowerTopology* cttopo, const CaloTowerConstituentsMap* ctmap, const HcalTopology* htopo, const CaloGeometry* geo,
+                   unsigned long long geometryCacheId, unsigned long long topologyCacheId);
+
   // pass the containers of channels status from the event record (stored in DB)
   // these are called in  CaloTowersCreator
   void setHcalChStatusFromDB(const HcalChannelQuality* s) { theHcalChStatus = s; }
@@ -239,6 +244,9 @@ private:
 
   /// looks for a given tower in the internal cache.  If it can't find it, it makes it.
   MetaTower & find(const CaloTowerDetId & id);
+
+  /// the tower of a rechit, from the tables below, filled from the constituents map on first use
+  CaloTowerDetId towerOf(const DetId & id);
   
   /// helper method to look up the appropriate threshold & weight
   void getThresholdAndWeight(const DetId & detId, double & threshold, double & weight) const;
@@ -332,6 +340,13 @@ private:
   MetaTowerMap theTowerMap;
   unsigned int theTowerMapSize=0;
 
+  // raw id of the tower of each EB, EE and HCAL cell, by dense index of the cell.
+  // They are kept as long as the records they were filled from.
+  static constexpr uint32_t kUnknownTower = 0xFFFFFFFFu;
+  std::vector<uint32_t> theEBTowerIndex, theEETowerIndex, theHcalTowerIndex;
+  unsigned long long theTowerIndexGeometryCacheId = 0;
+  unsigned long long theTowerIndexTopologyCacheId = 0;
+
   // Number of channels in the tower that were not used in RecHit production (dead/off,...).
   // These channels are added to the other "bad" channels found in the recHit collection. 
   typedef std::map<CaloTowerDetId, int> HcalDropChMap;
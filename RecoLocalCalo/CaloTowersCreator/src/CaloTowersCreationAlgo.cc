@@ -2,6 +2,8 @@
 #include "Geometry/CaloTopology/interface/HcalTopology.h"
 #include "Geometry/CaloTopology/interface/CaloTowerTopology.h"
 #include "Geometry/CaloTopology/interface/CaloTowerConstituentsMap.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
 #include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
 #include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
 #include "Geometry/CaloGeometry/interface/CaloGeometry.h"
@@ -248,6 +250,12 @@ CaloTowersCreationAlgo::CaloTowersCreationAlgo(double EBthreshold, double EEthre
 
 
 void CaloTowersCreationAlgo::setGeometry(const CaloTowerTopology* cttopo, const CaloTowerConstituentsMap* ctmap, const HcalTopology* htopo, const CaloGeometry* geo) {
+  // without the cache identifiers, the towers of the cells are always looked up again
+  setGeometry(cttopo, ctmap, htopo, geo, 0, 0);
+}
+
+void CaloTowersCreationAlgo::setGeometry(const CaloTowerTopology* cttopo, const CaloTowerConstituentsMap* ctmap, const HcalTopology* htopo, const CaloGeometry* geo,
+                                         unsigned long long geometryCacheId, unsigned long long topologyCacheId) {
   theTowerTopology = cttopo;
   theTowerConstituentsMap = ctmap;
   theHcalTopology = htopo;
@@ -256,6 +264,16 @@ void CaloTowersCreationAlgo::setGeometry(const CaloTowerTopology* cttopo, const
   
   //initialize ecal bad channel map
   ecalBadChs.resize(theTowerTopology->sizeForDenseIndexing(),0);
+
+  //the towers of the cells are looked up again only for new records (a zero identifier is never valid)
+  if (geometryCacheId == 0 || geometryCacheId != theTowerIndexGeometryCacheId ||
+      topologyCacheId != theTowerIndexTopologyCacheId) {
+    theEBTowerIndex.assign(EBDetId::kSizeForDenseIndexing, kUnknownTower);
+    theEETowerIndex.assign(EEDetId::kSizeForDenseIndexing, kUnknownTower);
+    theHcalTowerIndex.assign(theHcalTopology->ncells(), kUnknownTower);
+    theTowerIndexGeometryCacheId = geometryCacheId;
+    theTowerIndexTopologyCacheId = topologyCacheId;
+  }
   
   //store some specific geom info
   
@@ -482,7 +500,7 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
     // bad channels are counted regardless of energy threshold
 
     if (chStatusForCT == CaloTowersCreationAlgo::BadChan) {
-      CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+      CaloTowerDetId towerDetId = towerOf(detId);
       if (towerDetId.null()) return;
       MetaTower & tower28 = find(towerDetId);
       CaloTowerDetId towerDetId29(towerDetId.ieta()+towerDetId.zside(),
@@ -494,7 +512,7 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
 
     else if (0.5*energy >= threshold) {  // not bad channel: use energy if above threshold
       
-      CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+      CaloTowerDetId towerDetId = towerOf(detId);
       if (towerDetId.null()) return;
       MetaTower & tower28 = find(towerDetId);
       CaloTowerDetId towerDetId29(towerDetId.ieta()+towerDetId.zside(),
@@ -547,7 +565,7 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
 
     if(hcalDetId.subdet() == HcalOuter) {
 
-      CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+      CaloTowerDetId towerDetId = towerOf(detId);
       if (towerDetId.null()) return;
       MetaTower & tower = find(towerDetId);
 
@@ -582,14 +600,14 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
     else if(hcalDetId.subdet() == HcalForward) {
 
       if (chStatusForCT == CaloTowersCreationAlgo::BadChan) {
-        CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+        CaloTowerDetId towerDetId = towerOf(detId);
         if (towerDetId.null()) return;
         MetaTower & tower = find(towerDetId);
         tower.numBadHcalCells += 1;
       }
       
       else if (energy >= threshold)  {
-        CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+        CaloTowerDetId towerDetId = towerOf(detId);
         if (towerDetId.null()) return;
         MetaTower & tower = find(towerDetId);
 
@@ -627,13 +645,13 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
     else {
       // HCAL situation normal in HB/HE
       if (chStatusForCT == CaloTowersCreationAlgo::BadChan) {
-        CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+        CaloTowerDetId towerDetId = towerOf(detId);
         if (towerDetId.null()) return;
         MetaTower & tower = find(towerDetId);
         tower.numBadHcalCells += 1;
       }
       else if (energy >= threshold) {
-        CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+        CaloTowerDetId towerDetId = towerOf(detId);
         if (towerDetId.null()) return;
         MetaTower & tower = find(towerDetId);
         tower.E_had += e;
@@ -711,7 +729,7 @@ void CaloTowersCreationAlgo::assignHitEcal(const EcalRecHit * recHit) {
     else  passEmThreshold = (energy >= threshold);
   }
 
-  CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+  CaloTowerDetId towerDetId = towerOf(detId);
   if (towerDetId.null()) return;
   MetaTower & tower = find(towerDetId);
 
@@ -828,6 +846,24 @@ CaloTowersCreationAlgo::MetaTower & CaloTowersCreationAlgo::find(const CaloTower
 }
 
 
+CaloTowerDetId CaloTowersCreationAlgo::towerOf(const DetId & detId) {
+  uint32_t * tower = nullptr;
+  if (detId.det() == DetId::Ecal) {
+    if (detId.subdetId() == EcalBarrel) tower = &theEBTowerIndex[EBDetId(detId).denseIndex()];
+    else if (detId.subdetId() == EcalEndcap) tower = &theEETowerIndex[EEDetId(detId).denseIndex()];
+  }
+  else if (detId.det() == DetId::Hcal) {
+    unsigned int index = theHcalTopology->detId2denseId(detId);
+    if (index < theHcalTowerIndex.size()) tower = &theHcalTowerIndex[index];
+  }
+
+  if (tower == nullptr) return theTowerConstituentsMap->towerOf(detId);
+
+  if (*tower == kUnknownTower) *tower = theTowerConstituentsMap->towerOf(detId).rawId();
+  return CaloTowerDetId(*tower);
+}
+
+
 void CaloTowersCreationAlgo::convert(const CaloTowerDetId& id, const MetaTower& mt,
                                      CaloTowerCollection & collection) 
 {
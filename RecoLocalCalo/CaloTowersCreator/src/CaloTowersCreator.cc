@@ -170,7 +170,8 @@ void CaloTowersCreator::produce(edm::Event& e, const edm::EventSetup& c) {
   algo_.setHOEScale(HOEScale);
   algo_.setHF1EScale(HF1EScale);
   algo_.setHF2EScale(HF2EScale);
-  algo_.setGeometry(cttopo.product(),ctmap.product(),htopo.product(),pG.product());
+  algo_.setGeometry(cttopo.product(),ctmap.product(),htopo.product(),pG.product(),
+                    c.get<CaloGeometryRecord>().cacheIdentifier(),c.get<HcalRecNumberingRecord>().cacheIdentifier());
 
   // for treatment of problematic and anomalous cells
 
@@ -75,7 +75,8 @@ void CaloTowersReCreator::produce(edm::Event& e, const edm::EventSetup& c) {
   algo_.setHOEScale(HOEScale);
   algo_.setHF1EScale(HF1EScale);
   algo_.setHF2EScale(HF2EScale);
-  algo_.setGeometry(cttopo.product(),ctmap.product(),htopo.product(),pG.product());
+  algo_.setGeometry(cttopo.product(),ctmap.product(),htopo.product(),pG.product(),
+                    c.get<CaloGeometryRecord>().cacheIdentifier(),c.get<HcalRecNumberingRecord>().cacheIdentifier());
 
   algo_.begin(); // clear the internal buffer
   
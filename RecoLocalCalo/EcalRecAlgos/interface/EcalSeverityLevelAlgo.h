@@ -75,6 +75,9 @@ private:
       in a bit-wise way*/
   std::vector<uint32_t> dbstatusMask_;
 
+  /// The EcalSeverityLevel of each DBStatus code, from dbstatusMask_
+  EcalSeverityLevel::SeverityLevel dbstatusLevel_[EcalChannelStatusCode::chStatusMask+1];
+
 
   /// Return kTime only if the rechit is flagged kOutOfTime and E>timeThresh_
   float timeThresh_;
@@ -76,6 +76,18 @@ EcalSeverityLevelAlgo::EcalSeverityLevelAlgo(const edm::ParameterSet& p){
     dbstatusMask_[snum]=mask;
   }
 
+  // the level of a DBStatus is the first one whose mask has its bit set:
+  // this implementation implies that the statuses have a priority
+  for (unsigned int code=0;code<=EcalChannelStatusCode::chStatusMask;++code){
+    dbstatusLevel_[code]=EcalSeverityLevel::kGood; // kGood==0 we know!
+    if (code==0) continue;
+    for (size_t i=0; i< dbstatusMask_.size();++i){
+      if (dbstatusMask_[i] & (0x1<<code)) {
+        dbstatusLevel_[code]=EcalSeverityLevel::SeverityLevel(i);
+        break;
+      }
+    }
+  }
 
 }
 
@@ -105,22 +117,8 @@ EcalSeverityLevelAlgo::severityLevel(const DetId& id) const {
 
   EcalChannelStatus::const_iterator chIt = chStatus_->find( id );
 
-  uint16_t dbStatus = chIt->getStatusCode();
- 
-  // kGood==0 we know!
-  if (0==dbStatus)  return kGood;
- 
-  // check if the bit corresponding to that dbStatus is set in the mask
-  // This implementation implies that the statuses have a priority
-  for (size_t i=0; i< dbstatusMask_.size();++i){
-    uint32_t tmp = 0x1<<dbStatus;
-    if (dbstatusMask_[i] & tmp) return SeverityLevel(i);
-  }
-
-  // no matching
-  LogDebug("EcalSeverityLevelAlgo")<< 
-    "Unmatched DB status, returning kGood";
-  return kGood;
+  // an unmatched DB status is kGood
+  return dbstatusLevel_[chIt->getStatusCode()];
 }
 
 
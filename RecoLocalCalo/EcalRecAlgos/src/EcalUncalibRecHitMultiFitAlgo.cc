@@ -31,40 +31,28 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   double pedval = 0.;
   double pedrms = 0.;
   
+  // pedestal, its rms and the ratio to gain 12 by gain id; id 3 is read as gain 1,
+  // and id 0 flags a saturated sample
+  const double gain1Ratio = aGain->gain6Over1()*aGain->gain12Over6();
+  const double pedestals[4] = { aped->mean_x1, aped->mean_x12, aped->mean_x6, aped->mean_x1 };
+  const double pederrs[4]   = { aped->rms_x1,  aped->rms_x12,  aped->rms_x6,  aped->rms_x1  };
+  const double gainratios[4] = { gain1Ratio, 1., aGain->gain12Over6(), gain1Ratio };
+
+  // the samples are read in place from the 16 bit words of the frame
+  const edm::DataFrame::data_type * words = dataFrame.frame().begin();
+
   SampleVector amplitudes;
   for(unsigned int iSample = 0; iSample < nsample; iSample++) {
     
-    const EcalMGPASample &sample = dataFrame.sample(iSample);
-    
-    double amplitude = 0.;
-    int gainId = sample.gainId();
+    const EcalMGPASample sample(words[iSample]);
     
-    double pedestal = 0.;
-    double pederr = 0.;
-    double gainratio = 1.;
-        
-    if (gainId==0 || gainId==3) {
-      pedestal = aped->mean_x1;
-      pederr = aped->rms_x1;
-      gainratio = aGain->gain6Over1()*aGain->gain12Over6();
-    }
-    else if (gainId==1) {
-      pedestal = aped->mean_x12;
-      pederr = aped->rms_x12;
-      gainratio = 1.;
-    }
-    else if (gainId==2) {
-      pedestal = aped->mean_x6;
-      pederr = aped->rms_x6;
-      gainratio = aGain->gain12Over6();
-    }
+    const int gainId = sample.gainId();
+    const double pedestal = pedestals[gainId];
+    const double gainratio = gainratios[gainId];
 
-    amplitude = ((double)(sample.adc()) - pedestal) * gainratio;
-    
-    if (gainId == 0) {
-      //saturation
-      amplitude = (4095. - pedestal) * gainratio;
-    }
+    //saturation
+    const double adc = gainId == 0 ? 4095. : (double)(sample.adc());
+    const double amplitude = (adc - pedestal) * gainratio;
         
     amplitudes[iSample] = amplitude;
     
@@ -72,7 +60,7 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
     //if (iSample==5) {
       maxamplitude = amplitude;
       pedval = pedestal;
-      pedrms = pederr*gainratio;
+      pedrms = pederrs[gainId]*gainratio;
     }    
         
   }
@@ -23,6 +23,10 @@ class EcalUncalibRecHitWorkerBaseClass {
   virtual void set(const edm::EventSetup& es) = 0;
   virtual void set(const edm::Event& evt) {}
   virtual bool run(const edm::Event& evt, const EcalDigiCollection::const_iterator & digi, EcalUncalibratedRecHitCollection & result) = 0;
+  /// reconstructs all the digis of a collection, by default one by one with run
+  virtual void runAll(const edm::Event& evt, const EcalDigiCollection & digis, EcalUncalibratedRecHitCollection & result) {
+    for (EcalDigiCollection::const_iterator itdg = digis.begin(); itdg != digis.end(); ++itdg) run(evt, itdg, result);
+  }
   virtual edm::ParameterSetDescription getAlgoDescription() = 0;
 };
 
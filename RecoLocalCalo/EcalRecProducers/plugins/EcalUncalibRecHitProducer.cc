@@ -118,18 +118,14 @@ EcalUncalibRecHitProducer::produce(edm::Event& evt, const edm::EventSetup& es) {
         if (ebDigis)
         {
                 ebUncalibRechits->reserve(ebDigis->size());
-                for(EBDigiCollection::const_iterator itdg = ebDigis->begin(); itdg != ebDigis->end(); ++itdg) {
-                        worker_->run(evt, itdg, *ebUncalibRechits);
-                }
+                worker_->runAll(evt, *ebDigis, *ebUncalibRechits);
         }
 
         // loop over EB digis
         if (eeDigis)
         {
                 eeUncalibRechits->reserve(eeDigis->size());
-                for(EEDigiCollection::const_iterator itdg = eeDigis->begin(); itdg != eeDigis->end(); ++itdg) {
-                        worker_->run(evt, itdg, *eeUncalibRechits);
-                }
+                worker_->runAll(evt, *eeDigis, *eeUncalibRechits);
         }
 
         // put the collection of recunstructed hits in the event
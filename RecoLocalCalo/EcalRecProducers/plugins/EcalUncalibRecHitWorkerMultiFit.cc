@@ -5,6 +5,7 @@
 #include "FWCore/Framework/interface/Run.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include "CondFormats/DataRecord/interface/EcalGainRatiosRcd.h"
 #include "CondFormats/DataRecord/interface/EcalPedestalsRcd.h"
@@ -22,6 +23,9 @@
 #include <FWCore/ParameterSet/interface/ParameterSetDescription.h>
 #include <FWCore/ParameterSet/interface/EmptyGroupDescription.h>
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 EcalUncalibRecHitWorkerMultiFit::EcalUncalibRecHitWorkerMultiFit(const edm::ParameterSet&ps,edm::ConsumesCollector& c) :
   EcalUncalibRecHitWorkerBaseClass(ps,c),
   noisecorEBg12(SampleMatrix::Zero()), noisecorEEg12(SampleMatrix::Zero()),
@@ -53,6 +57,11 @@ EcalUncalibRecHitWorkerMultiFit::EcalUncalibRecHitWorkerMultiFit(const edm::Para
   prefitMaxChiSqEB_ = ps.getParameter<double>("prefitMaxChiSqEB");
   prefitMaxChiSqEE_ = ps.getParameter<double>("prefitMaxChiSqEE");
 
+  parallelFit_ = ps.existsAs<bool>("parallelFit") ? ps.getParameter<bool>("parallelFit") : false;
+  parallelFitBlockSize_ = ps.existsAs<int>("parallelFitBlockSize") ? ps.getParameter<int>("parallelFitBlockSize") : 256;
+  if (parallelFitBlockSize_ < 1)
+    throw cms::Exception("Configuration") << "EcalUncalibRecHitWorkerMultiFit: parallelFitBlockSize must be positive";
+
   // algorithm to be used for timing
   auto const & timeAlgoName = ps.getParameter<std::string>("timealgo");
   if(timeAlgoName=="RatioMethod") timealgo_=ratioMethod;
@@ -235,10 +244,110 @@ double EcalUncalibRecHitWorkerMultiFit::timeCorrection(
 
 
 
+void
+EcalUncalibRecHitWorkerMultiFit::setupFit(EcalUncalibRecHitMultiFitAlgo & algo, const DetId & detid,
+                const EcalPedestals::Item * & aped, const EcalMGPAGainRatio * & aGain,
+                FullSampleVector & fullpulse, FullSampleMatrix & fullpulsecov) const
+{
+        const EcalPulseShapes::Item * aPulse = 0;
+        const EcalPulseCovariances::Item * aPulseCov = 0;
+
+        if (detid.subdetId()==EcalEndcap) {
+                unsigned int hashedIndex = EEDetId(detid).hashedIndex();
+                aped      = &peds->endcap(hashedIndex);
+                aGain     = &gains->endcap(hashedIndex);
+                aPulse    = &pulseshapes->endcap(hashedIndex);
+                aPulseCov = &pulsecovariances->endcap(hashedIndex);
+                algo.setDoPrefit(doPrefitEE_);
+                algo.setPrefitMaxChiSq(prefitMaxChiSqEE_);
+        } else {
+                unsigned int hashedIndex = EBDetId(detid).hashedIndex();
+                aped      = &peds->barrel(hashedIndex);
+                aGain     = &gains->barrel(hashedIndex);
+                aPulse    = &pulseshapes->barrel(hashedIndex);
+                aPulseCov = &pulsecovariances->barrel(hashedIndex);
+                algo.setDoPrefit(doPrefitEB_);
+                algo.setPrefitMaxChiSq(prefitMaxChiSqEB_);
+        }
+        if(!ampErrorCalculation_) algo.disableErrorCalculation();
+
+        fullpulse = FullSampleVector::Zero();
+        fullpulsecov = FullSampleMatrix::Zero();
+        for (int i=0; i<EcalPulseShape::TEMPLATESAMPLES; ++i)
+          fullpulse(i+7) = aPulse->pdfval[i];
+
+        for(int i=0; i<EcalPulseShape::TEMPLATESAMPLES;i++)
+        for(int j=0; j<EcalPulseShape::TEMPLATESAMPLES;j++)
+          fullpulsecov(i+7,j+7) = aPulseCov->covval[i][j];
+}
+
+EcalUncalibratedRecHit
+EcalUncalibRecHitWorkerMultiFit::fitDigi(EcalUncalibRecHitMultiFitAlgo & algo, const EcalDigiCollection::const_iterator & itdg,
+                const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain,
+                const FullSampleVector & fullpulse, const FullSampleMatrix & fullpulsecov) const
+{
+        bool barrel = DetId(itdg->id()).subdetId()==EcalBarrel;
+        int gain = 2;
+        if (((EcalDataFrame)(*itdg)).hasSwitchToGain6()) {
+          gain = 1;
+        }
+        if (((EcalDataFrame)(*itdg)).hasSwitchToGain1()) {
+          gain = 0;
+        }
+
+        return algo.makeRecHit(*itdg, aped, aGain, noisecor(barrel,gain), fullpulse, fullpulsecov, activeBX);
+}
+
+void
+EcalUncalibRecHitWorkerMultiFit::runAll(const edm::Event & evt,
+                const EcalDigiCollection & digis,
+                EcalUncalibratedRecHitCollection & result)
+{
+        if (!parallelFit_) {
+                EcalUncalibRecHitWorkerBaseClass::runAll(evt, digis, result);
+                return;
+        }
+
+        // the multifits are independent: do them first in parallel,
+        // then the time and the flags digi by digi, in order
+        const unsigned int ndigis = digis.size();
+        std::vector<EcalUncalibratedRecHit> fits(ndigis);
+        std::vector<char> fitted(ndigis, 0);
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, ndigis, parallelFitBlockSize_),
+                          [&](const tbb::blocked_range<unsigned int> & r) {
+                            auto & algo = parallelMultiFitMethods_.local();
+                            for (unsigned int i = r.begin(); i != r.end(); ++i) {
+                              EcalDigiCollection::const_iterator itdg = digis.begin() + i;
+                              if (((EcalDataFrame)(*itdg)).lastUnsaturatedSample() >= 0) continue;
+                              const EcalPedestals::Item * aped = 0;
+                              const EcalMGPAGainRatio * aGain = 0;
+                              FullSampleVector fullpulse;
+                              FullSampleMatrix fullpulsecov;
+                              setupFit(algo, itdg->id(), aped, aGain, fullpulse, fullpulsecov);
+                              fits[i] = fitDigi(algo, itdg, aped, aGain, fullpulse, fullpulsecov);
+                              fitted[i] = 1;
+                            }
+                          });
+
+        unsigned int i = 0;
+        for (EcalDigiCollection::const_iterator itdg = digis.begin(); itdg != digis.end(); ++itdg, ++i) {
+                run(evt, itdg, result, fitted[i] ? &fits[i] : nullptr);
+        }
+}
+
 bool
 EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
                 const EcalDigiCollection::const_iterator & itdg,
                 EcalUncalibratedRecHitCollection & result )
+{
+        return run(evt, itdg, result, nullptr);
+}
+
+bool
+EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
+                const EcalDigiCollection::const_iterator & itdg,
+                EcalUncalibratedRecHitCollection & result,
+                const EcalUncalibratedRecHit * fit )
 {
         DetId detid(itdg->id());
 
@@ -251,44 +360,21 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
         const EcalPedestals::Item * aped = 0;
         const EcalMGPAGainRatio * aGain = 0;
         const EcalXtalGroupId * gid = 0;
-        const EcalPulseShapes::Item * aPulse = 0;
-        const EcalPulseCovariances::Item * aPulseCov = 0;
+        FullSampleVector fullpulse;
+        FullSampleMatrix fullpulsecov;
+        setupFit(multiFitMethod_, detid, aped, aGain, fullpulse, fullpulsecov);
 
         if (detid.subdetId()==EcalEndcap) {
-                unsigned int hashedIndex = EEDetId(detid).hashedIndex();
-                aped      = &peds->endcap(hashedIndex);
-                aGain     = &gains->endcap(hashedIndex);
-                gid       = &grps->endcap(hashedIndex);
-                aPulse    = &pulseshapes->endcap(hashedIndex);
-                aPulseCov = &pulsecovariances->endcap(hashedIndex);
-                multiFitMethod_.setDoPrefit(doPrefitEE_);
-		multiFitMethod_.setPrefitMaxChiSq(prefitMaxChiSqEE_);
+                gid       = &grps->endcap(EEDetId(detid).hashedIndex());
 		offsetTime = offtime->getEEValue();
         } else {
-                unsigned int hashedIndex = EBDetId(detid).hashedIndex();
-                aped      = &peds->barrel(hashedIndex);
-                aGain     = &gains->barrel(hashedIndex);
-                gid       = &grps->barrel(hashedIndex);
-                aPulse    = &pulseshapes->barrel(hashedIndex);
-                aPulseCov = &pulsecovariances->barrel(hashedIndex);
-                multiFitMethod_.setDoPrefit(doPrefitEB_);
-		multiFitMethod_.setPrefitMaxChiSq(prefitMaxChiSqEB_);
+                gid       = &grps->barrel(EBDetId(detid).hashedIndex());
 		offsetTime = offtime->getEBValue();
         }
 
         double pedVec[3] = { aped->mean_x12, aped->mean_x6, aped->mean_x1 };
         double pedRMSVec[3] = { aped->rms_x12, aped->rms_x6, aped->rms_x1};
         double gainRatios[3] = { 1., aGain->gain12Over6(), aGain->gain6Over1()*aGain->gain12Over6()};
-
-        FullSampleVector fullpulse(FullSampleVector::Zero());
-        FullSampleMatrix fullpulsecov(FullSampleMatrix::Zero());
-        for (int i=0; i<EcalPulseShape::TEMPLATESAMPLES; ++i)
-          fullpulse(i+7) = aPulse->pdfval[i];
-    
-        for(int i=0; i<EcalPulseShape::TEMPLATESAMPLES;i++)
-        for(int j=0; j<EcalPulseShape::TEMPLATESAMPLES;j++)
-          fullpulsecov(i+7,j+7) = aPulseCov->covval[i][j];
-       
         
 	// compute the right bin of the pulse shape using time calibration constants
 	EcalTimeCalibConstantMap::const_iterator it = itime->find( detid );
@@ -321,17 +407,7 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
                uncalibRecHit.setChi2(0);
         } else {
                 // multifit
-                bool barrel = detid.subdetId()==EcalBarrel;
-                int gain = 2;
-                if (((EcalDataFrame)(*itdg)).hasSwitchToGain6()) {
-                  gain = 1;
-                }
-                if (((EcalDataFrame)(*itdg)).hasSwitchToGain1()) {
-                  gain = 0;
-                }
-                const SampleMatrix &noisecormat = noisecor(barrel,gain);
-                                
-                uncalibRecHit = multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecormat,fullpulse,fullpulsecov,activeBX);
+                uncalibRecHit = fit ? *fit : fitDigi(multiFitMethod_, itdg, aped, aGain, fullpulse, fullpulsecov);
                 
                 // === time computation ===
                 if(timealgo_==ratioMethod) {
@@ -577,6 +653,8 @@ EcalUncalibRecHitWorkerMultiFit::getAlgoDescription() {
 	      edm::ParameterDescription<bool>("doPrefitEE", false, true) and
 	      edm::ParameterDescription<double>("prefitMaxChiSqEB", 25., true) and
 	      edm::ParameterDescription<double>("prefitMaxChiSqEE", 10., true) and
+	      edm::ParameterDescription<bool>("parallelFit", false, true) and
+	      edm::ParameterDescription<int>("parallelFitBlockSize", 256, true) and
 	      edm::ParameterDescription<std::string>("timealgo", "RatioMethod", true) and
 	      edm::ParameterDescription<std::vector<double>>("EBtimeFitParameters", {-2.015452e+00, 3.130702e+00, -1.234730e+01, 4.188921e+01, -8.283944e+01, 9.101147e+01, -5.035761e+01, 1.105621e+01}, true) and
 	      edm::ParameterDescription<std::vector<double>>("EEtimeFitParameters", {-2.390548e+00, 3.553628e+00, -1.762341e+01, 6.767538e+01, -1.332130e+02, 1.407432e+02, -7.541106e+01, 1.620277e+01}, true) and
@@ -29,6 +29,8 @@
 #include "CondFormats/EcalObjects/interface/EcalPulseCovariances.h"
 #include "RecoLocalCalo/EcalRecAlgos/interface/EigenMatrixTypes.h"
 
+#include "tbb/enumerable_thread_specific.h"
+
 
 namespace edm {
         class Event;
@@ -47,6 +49,19 @@ class EcalUncalibRecHitWorkerMultiFit final : public EcalUncalibRecHitWorkerBase
                 void set(const edm::EventSetup& es) override;
                 void set(const edm::Event& evt) override;
                 bool run(const edm::Event& evt, const EcalDigiCollection::const_iterator & digi, EcalUncalibratedRecHitCollection & result) override;
+                void runAll(const edm::Event& evt, const EcalDigiCollection & digis, EcalUncalibratedRecHitCollection & result) override;
+                // as run, with the multifit of the digi already done if fit is not null
+                bool run(const edm::Event& evt, const EcalDigiCollection::const_iterator & digi, EcalUncalibratedRecHitCollection & result,
+                         const EcalUncalibratedRecHit * fit);
+                // the conditions of a digi, and the setup of the multifit algo for its subdetector
+                void setupFit(EcalUncalibRecHitMultiFitAlgo & algo, const DetId & detid,
+                              const EcalPedestals::Item * & aped, const EcalMGPAGainRatio * & aGain,
+                              FullSampleVector & fullpulse, FullSampleMatrix & fullpulsecov) const;
+                // the multifit of a digi not saturated on the max sample, with the algo set up by setupFit;
+                // thread safe for different algos
+                EcalUncalibratedRecHit fitDigi(EcalUncalibRecHitMultiFitAlgo & algo, const EcalDigiCollection::const_iterator & digi,
+                                               const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain,
+                                               const FullSampleVector & fullpulse, const FullSampleMatrix & fullpulsecov) const;
 	public:	
 		edm::ParameterSetDescription getAlgoDescription();
         private:
@@ -76,6 +91,10 @@ class EcalUncalibRecHitWorkerMultiFit final : public EcalUncalibRecHitWorkerBase
                 bool ampErrorCalculation_;
                 bool useLumiInfoRunHeader_;
                 EcalUncalibRecHitMultiFitAlgo multiFitMethod_;
+                // fit the digis of a collection in parallel, by blocks of consecutive digis
+                bool parallelFit_;
+                int parallelFitBlockSize_;
+                tbb::enumerable_thread_specific<EcalUncalibRecHitMultiFitAlgo> parallelMultiFitMethods_;
                 
 		int bunchSpacingManual_;
                 edm::EDGetTokenT<unsigned int> bunchSpacing_; 
@@ -0,0 +1,63 @@
+#ifndef __RecoLocalCalo_HGCalRecAlgos_HGCalDensityClustering_h__
+#define __RecoLocalCalo_HGCalRecAlgos_HGCalDensityClustering_h__
+
+#include <vector>
+
+namespace hgcal {
+  /** Density based 2D clustering of the rechits of one layer.
+   *
+   *  Each hit gets a density, the energy within deltac of it, and the
+   *  distance to its nearest hit of higher density.  The hits denser than
+   *  rhoc and farther than deltac from any denser hit are the seeds, the
+   *  other hits follow their nearest higher to a seed.  The hits with no
+   *  denser hit within outlierDeltaFactor*deltac are left out.
+   *
+   *  The hits are binned in a grid of deltac, so every search only looks
+   *  at the few bins around a hit and the cost grows linearly with the
+   *  number of hits.  The hits are given in flat arrays, and a layer does
+   *  not depend on any other: one instance can cluster different layers
+   *  in different threads.
+   */
+  class DensityClustering {
+  public:
+    /// the hits of one layer
+    struct LayerHits {
+      std::vector<float> x;
+      std::vector<float> y;
+      std::vector<float> energy;
+
+      void clear() { x.clear(); y.clear(); energy.clear(); }
+      unsigned int size() const { return x.size(); }
+      void push_back(float ix, float iy, float ienergy) {
+        x.push_back(ix); y.push_back(iy); energy.push_back(ienergy);
+      }
+    };
+
+    /// throws a cms::Exception unless deltac is positive
+    DensityClustering(float deltac, float rhoc, float outlierDeltaFactor);
+
+    /// the cluster of each hit, -1 for the outliers, in the order of the
+    /// seeds in the hits; returns the number of clusters
+    unsigned int cluster(const LayerHits& hits, std::vector<int>& clusterOfHit) const;
+
+  private:
+    // the hits sorted by bin of the grid
+    struct Grid {
+      float xMin, yMin, binSize;
+      int nx, ny;
+      std::vector<unsigned int> first;   // nx*ny+1 offsets in hits
+      std::vector<unsigned int> hits;
+
+      int binX(float x) const;
+      int binY(float y) const;
+    };
+
+    void fillGrid(const LayerHits& hits, Grid& grid) const;
+
+    const float deltac_;
+    const float rhoc_;
+    const float outlierDeltaFactor_;
+  };
+}
+
+#endif
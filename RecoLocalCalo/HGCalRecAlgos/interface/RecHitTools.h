@@ -4,6 +4,8 @@
 #include <array>
 #include <cmath>
 
+#include "DataFormats/GeometryVector/interface/GlobalPoint.h"
+
 class HGCalGeometry;
 class HGCalDDDConstants;
 class DetId;
@@ -27,6 +29,9 @@ namespace hgcal {
     
     bool isHalfCell(const DetId&) const;
 
+    GlobalPoint getPosition(const DetId&) const;
+    unsigned int getLayer(const DetId&) const;
+
   private:
     std::array<const HGCalGeometry*,2>     geom_;
     std::array<const HGCalDDDConstants*,2> ddd_;
@@ -0,0 +1,151 @@
+#include "RecoLocalCalo/HGCalRecAlgos/interface/HGCalDensityClustering.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace hgcal;
+
+namespace {
+  // a hit is higher than another if it is denser, the ties are broken by
+  // the index so that the nearest higher chains have no loops
+  inline bool isHigher(const std::vector<float>& rho, unsigned int j, unsigned int i) {
+    return rho[j] > rho[i] || (rho[j] == rho[i] && j > i);
+  }
+}
+
+DensityClustering::DensityClustering(float deltac, float rhoc, float outlierDeltaFactor) :
+  deltac_(deltac), rhoc_(rhoc), outlierDeltaFactor_(outlierDeltaFactor) {
+  // the grid is binned in deltac
+  if( !(deltac_ > 0.f) ) {
+    throw cms::Exception("hgcal::DensityClustering")
+      << "deltac must be positive, got " << deltac_;
+  }
+}
+
+int DensityClustering::Grid::binX(float x) const {
+  return std::min(int((x-xMin)/binSize), nx-1);
+}
+
+int DensityClustering::Grid::binY(float y) const {
+  return std::min(int((y-yMin)/binSize), ny-1);
+}
+
+void DensityClustering::fillGrid(const LayerHits& hits, Grid& grid) const {
+  const unsigned int n = hits.size();
+  auto xRange = std::minmax_element(hits.x.begin(),hits.x.end());
+  auto yRange = std::minmax_element(hits.y.begin(),hits.y.end());
+  grid.xMin = *xRange.first;
+  grid.yMin = *yRange.first;
+  const float width = *xRange.second - grid.xMin;
+  const float height = *yRange.second - grid.yMin;
+
+  // bins of deltac, larger if there would be many more bins than hits
+  grid.binSize = deltac_;
+  const float maxBins = 4.f*n + 16.f;
+  if( (width/deltac_+1.f)*(height/deltac_+1.f) > maxBins ) {
+    grid.binSize = std::max(deltac_, std::sqrt(width*height/maxBins) + std::max(width,height)/maxBins);
+  }
+  grid.nx = int(width/grid.binSize) + 1;
+  grid.ny = int(height/grid.binSize) + 1;
+
+  // counting sort of the hits by bin, in the order of the hits within a bin
+  std::vector<unsigned int> binOfHit(n);
+  grid.first.assign(grid.nx*grid.ny+1, 0);
+  for( unsigned int i = 0; i < n; ++i ) {
+    binOfHit[i] = grid.binY(hits.y[i])*grid.nx + grid.binX(hits.x[i]);
+    ++grid.first[binOfHit[i]+1];
+  }
+  for( unsigned int b = 1; b < grid.first.size(); ++b ) grid.first[b] += grid.first[b-1];
+  grid.hits.resize(n);
+  std::vector<unsigned int> next(grid.first.begin(),grid.first.end()-1);
+  for( unsigned int i = 0; i < n; ++i ) grid.hits[next[binOfHit[i]]++] = i;
+}
+
+unsigned int DensityClustering::cluster(const LayerHits& hits, std::vector<int>& clusterOfHit) const {
+  const unsigned int n = hits.size();
+  clusterOfHit.assign(n, -1);
+  if( n == 0 ) return 0;
+
+  Grid grid;
+  fillGrid(hits, grid);
+
+  // loops over the hits in the bins within range of hit i
+  auto forNeighbours = [&](unsigned int i, float range, auto&& f) {
+    const int nBins = int(std::ceil(range/grid.binSize));
+    const int bx = grid.binX(hits.x[i]), by = grid.binY(hits.y[i]);
+    for( int iy = std::max(by-nBins,0); iy <= std::min(by+nBins,grid.ny-1); ++iy ) {
+      for( int ix = std::max(bx-nBins,0); ix <= std::min(bx+nBins,grid.nx-1); ++ix ) {
+        const int b = iy*grid.nx + ix;
+        for( unsigned int k = grid.first[b]; k < grid.first[b+1]; ++k ) {
+          const unsigned int j = grid.hits[k];
+          const float dx = hits.x[j] - hits.x[i], dy = hits.y[j] - hits.y[i];
+          f(j, dx*dx + dy*dy);
+        }
+      }
+    }
+  };
+
+  // local density
+  const float deltac2 = deltac_*deltac_;
+  std::vector<float> rho(n, 0.f);
+  for( unsigned int i = 0; i < n; ++i ) {
+    forNeighbours(i, deltac_, [&](unsigned int j, float d2) {
+        if( d2 <= deltac2 ) rho[i] += hits.energy[j];
+      });
+  }
+
+  // nearest higher, looked for up to the outlier distance
+  const float maxDelta = outlierDeltaFactor_*deltac_;
+  std::vector<int> nearestHigher(n, -1);
+  std::vector<float> delta(n, std::numeric_limits<float>::max());
+  for( unsigned int i = 0; i < n; ++i ) {
+    float best2 = std::numeric_limits<float>::max();
+    forNeighbours(i, std::max(maxDelta,deltac_), [&](unsigned int j, float d2) {
+        if( d2 < best2 && isHigher(rho, j, i) ) {
+          best2 = d2;
+          nearestHigher[i] = j;
+        }
+      });
+    if( nearestHigher[i] >= 0 ) delta[i] = std::sqrt(best2);
+  }
+
+  // seeds, in the order of the hits, and followers of the other hits
+  unsigned int nClusters = 0;
+  std::vector<unsigned int> firstFollower(n+1, 0);
+  for( unsigned int i = 0; i < n; ++i ) {
+    if( rho[i] > rhoc_ && delta[i] > deltac_ ) {
+      clusterOfHit[i] = nClusters++;
+      nearestHigher[i] = -1;
+    }
+    else if( delta[i] > maxDelta ) {
+      nearestHigher[i] = -1;   // outlier
+    }
+    else {
+      ++firstFollower[nearestHigher[i]+1];
+    }
+  }
+  for( unsigned int i = 1; i <= n; ++i ) firstFollower[i] += firstFollower[i-1];
+  std::vector<unsigned int> followers(firstFollower[n]);
+  std::vector<unsigned int> next(firstFollower.begin(),firstFollower.end()-1);
+  for( unsigned int i = 0; i < n; ++i ) {
+    if( nearestHigher[i] >= 0 ) followers[next[nearestHigher[i]]++] = i;
+  }
+
+  // the followers of each seed, down the chains
+  std::vector<unsigned int> stack;
+  for( unsigned int i = 0; i < n; ++i ) {
+    if( clusterOfHit[i] < 0 || nearestHigher[i] >= 0 ) continue;
+    stack.push_back(i);
+    while( !stack.empty() ) {
+      const unsigned int h = stack.back();
+      stack.pop_back();
+      for( unsigned int k = firstFollower[h]; k < firstFollower[h+1]; ++k ) {
+        clusterOfHit[followers[k]] = clusterOfHit[i];
+        stack.push_back(followers[k]);
+      }
+    }
+  }
+  return nClusters;
+}
@@ -23,6 +23,13 @@ namespace {
         << "HGCalGeometry not provided yet to hgcal::RecHitTools!";
     }
   }
+
+  inline void check_geom(const HGCalGeometry* geom) {
+    if( nullptr == geom ) {
+      throw cms::Exception("hgcal::RecHitTools")
+        << "HGCalGeometry not provided yet to hgcal::RecHitTools!";
+    }
+  }
 }
 
 void RecHitTools::getEvent(const edm::Event& ev) {
@@ -61,4 +68,12 @@ bool RecHitTools::isHalfCell(const DetId& id) const {
   return ddd->isHalfCell(waferType,hid.cell());
 }
 
+GlobalPoint RecHitTools::getPosition(const DetId& id) const {
+  auto geom = id.subdetId() == HGCEE ? geom_[0] : geom_[1];
+  check_geom(geom);
+  return geom->getPosition(id);
+}
 
+unsigned int RecHitTools::getLayer(const DetId& id) const {
+  return HGCalDetId(id).layer();
+}
@@ -0,0 +1,138 @@
+/* Unit test of hgcal::DensityClustering, against a brute-force
+   implementation of the same definitions on random layers.
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "RecoLocalCalo/HGCalRecAlgos/interface/HGCalDensityClustering.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+class testHGCalDensityClustering: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(testHGCalDensityClustering);
+  CPPUNIT_TEST(testRandomLayers);
+  CPPUNIT_TEST(testSmallLayers);
+  CPPUNIT_TEST_EXCEPTION(testZeroDeltac, cms::Exception);
+  CPPUNIT_TEST_EXCEPTION(testNegativeDeltac, cms::Exception);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp(){}
+  void tearDown(){}
+
+  void testRandomLayers();
+  void testSmallLayers();
+  void testZeroDeltac() { hgcal::DensityClustering(0.f, 1.f, 2.f); }
+  void testNegativeDeltac() { hgcal::DensityClustering(-1.f, 1.f, 2.f); }
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testHGCalDensityClustering);
+
+namespace {
+  typedef hgcal::DensityClustering::LayerHits LayerHits;
+
+  // the definitions of DensityClustering, looking at all the pairs of hits
+  unsigned int bruteForce(const LayerHits& hits, float deltac, float rhoc, float outlierDeltaFactor,
+                          std::vector<int>& clusterOfHit) {
+    const unsigned int n = hits.size();
+    auto dist2 = [&](unsigned int i, unsigned int j) {
+      const float dx = hits.x[j] - hits.x[i], dy = hits.y[j] - hits.y[i];
+      return dx*dx + dy*dy;
+    };
+
+    std::vector<float> rho(n, 0.f);
+    for( unsigned int i = 0; i < n; ++i ) {
+      for( unsigned int j = 0; j < n; ++j ) {
+        if( dist2(i,j) <= deltac*deltac ) rho[i] += hits.energy[j];
+      }
+    }
+
+    std::vector<int> nearestHigher(n, -1);
+    std::vector<float> delta(n, std::numeric_limits<float>::max());
+    for( unsigned int i = 0; i < n; ++i ) {
+      float best2 = std::numeric_limits<float>::max();
+      for( unsigned int j = 0; j < n; ++j ) {
+        const bool higher = rho[j] > rho[i] || (rho[j] == rho[i] && j > i);
+        if( higher && dist2(i,j) < best2 ) {
+          best2 = dist2(i,j);
+          nearestHigher[i] = j;
+        }
+      }
+      if( nearestHigher[i] >= 0 ) delta[i] = std::sqrt(best2);
+    }
+
+    unsigned int nClusters = 0;
+    std::vector<int> seedCluster(n, -1);
+    for( unsigned int i = 0; i < n; ++i ) {
+      if( rho[i] > rhoc && delta[i] > deltac ) seedCluster[i] = nClusters++;
+      else if( delta[i] > outlierDeltaFactor*deltac ) nearestHigher[i] = -1;
+    }
+
+    // up the nearest higher chain, to a seed or an outlier
+    clusterOfHit.assign(n, -1);
+    for( unsigned int i = 0; i < n; ++i ) {
+      int h = i;
+      while( seedCluster[h] < 0 && nearestHigher[h] >= 0 ) h = nearestHigher[h];
+      clusterOfHit[i] = seedCluster[h];
+    }
+    return nClusters;
+  }
+
+  void check(const LayerHits& hits, float deltac, float rhoc, float outlierDeltaFactor) {
+    std::vector<int> expected, clusterOfHit;
+    const unsigned int nExpected = bruteForce(hits, deltac, rhoc, outlierDeltaFactor, expected);
+    hgcal::DensityClustering clustering(deltac, rhoc, outlierDeltaFactor);
+    CPPUNIT_ASSERT_EQUAL(nExpected, clustering.cluster(hits, clusterOfHit));
+    CPPUNIT_ASSERT(expected == clusterOfHit);
+  }
+}
+
+void testHGCalDensityClustering::testRandomLayers() {
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<float> energy(0.f, 1.f);
+
+  // dense and sparse layers, with some showers on top of the noise
+  const unsigned int nHits[] = {10, 100, 1000, 3000};
+  const float sizes[] = {5.f, 50.f, 500.f};
+  for( unsigned int n : nHits ) {
+    for( float size : sizes ) {
+      std::uniform_real_distribution<float> position(-size, size);
+      std::normal_distribution<float> spread(0.f, 1.5f);
+      LayerHits hits;
+      for( unsigned int i = 0; i < n/2; ++i ) {
+        hits.push_back(position(rng), position(rng), energy(rng));
+      }
+      for( unsigned int shower = 0; shower < 5; ++shower ) {
+        const float x = position(rng), y = position(rng);
+        for( unsigned int i = 0; i < n/10; ++i ) {
+          hits.push_back(x + spread(rng), y + spread(rng), 5.f*energy(rng));
+        }
+      }
+      check(hits, 2.f, 1.f, 2.f);
+      check(hits, 1.f, 0.5f, 5.f);
+      check(hits, 3.f, 4.f, 0.5f);
+    }
+  }
+}
+
+void testHGCalDensityClustering::testSmallLayers() {
+  LayerHits hits;
+  check(hits, 2.f, 1.f, 2.f);
+
+  hits.push_back(1.f, 1.f, 2.f);
+  check(hits, 2.f, 1.f, 2.f);
+  check(hits, 2.f, 3.f, 2.f);
+
+  // all the hits at the same place, and on a line
+  hits.push_back(1.f, 1.f, 1.f);
+  hits.push_back(1.f, 1.f, 1.f);
+  check(hits, 2.f, 1.f, 2.f);
+  for( unsigned int i = 0; i < 20; ++i ) hits.push_back(1.f + 0.7f*i, 1.f, 1.f + 0.1f*(i%3));
+  check(hits, 2.f, 1.f, 2.f);
+  check(hits, 0.5f, 1.f, 3.f);
+}
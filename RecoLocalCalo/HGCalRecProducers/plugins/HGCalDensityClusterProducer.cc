@@ -0,0 +1,164 @@
+/** \class HGCalDensityClusterProducer
+ *   produce the 2D clusters of the HGCAL layers from the rechits
+ *
+ *  The rechits of each layer, of each side, of the EE and of the FH, are
+ *  clustered on their own by hgcal::DensityClustering.  The geometry of
+ *  each rechit is looked up once, into the flat arrays of its layer.  The
+ *  layers can be clustered in parallel; the clusters are put in the event
+ *  in the order of the layers either way.
+ *
+ **/
+#include "DataFormats/Common/interface/Handle.h"
+
+#include "DataFormats/HGCRecHit/interface/HGCRecHitCollections.h"
+#include "DataFormats/ForwardDetId/interface/HGCalDetId.h"
+#include "DataFormats/EgammaReco/interface/BasicCluster.h"
+#include "DataFormats/EgammaReco/interface/BasicClusterFwd.h"
+
+#include "RecoLocalCalo/HGCalRecAlgos/interface/HGCalDensityClustering.h"
+#include "RecoLocalCalo/HGCalRecAlgos/interface/RecHitTools.h"
+
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "tbb/parallel_for.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+class HGCalDensityClusterProducer : public edm::stream::EDProducer<> {
+
+ public:
+  explicit HGCalDensityClusterProducer(const edm::ParameterSet& ps);
+  ~HGCalDensityClusterProducer() {}
+  virtual void produce(edm::Event& evt, const edm::EventSetup& es) override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+ private:
+  // one group of hits per subdetector, side and layer
+  static constexpr unsigned int nLayers = HGCalDetId::kHGCalLayerMask + 1;
+  static constexpr unsigned int nGroups = 2*2*nLayers;
+
+  struct LayerGroup {
+    hgcal::DensityClustering::LayerHits hits;
+    std::vector<float> z;
+    std::vector<const HGCRecHit*> recHits;
+    std::vector<reco::BasicCluster> clusters;
+
+    void clear() { hits.clear(); z.clear(); recHits.clear(); clusters.clear(); }
+  };
+
+  void fillGroups(const HGCRecHitCollection& recHits, unsigned int subdet);
+  void clusterGroup(LayerGroup& group, reco::CaloCluster::AlgoId algo) const;
+
+  const edm::EDGetTokenT<HGCeeRecHitCollection> eeRecHitCollection_;
+  const edm::EDGetTokenT<HGChefRecHitCollection> hefRecHitCollection_;
+  const float eCut_;
+  const bool parallelLayers_;
+  const hgcal::DensityClustering clustering_;
+
+  hgcal::RecHitTools recHitTools_;
+  std::array<LayerGroup, nGroups> groups_;
+};
+
+HGCalDensityClusterProducer::HGCalDensityClusterProducer(const edm::ParameterSet& ps) :
+  eeRecHitCollection_( consumes<HGCeeRecHitCollection>( ps.getParameter<edm::InputTag>("HGCEErechitCollection") ) ),
+  hefRecHitCollection_( consumes<HGChefRecHitCollection>( ps.getParameter<edm::InputTag>("HGCHEFrechitCollection") ) ),
+  eCut_( ps.getParameter<double>("ecut") ),
+  parallelLayers_( ps.getParameter<bool>("parallelLayers") ),
+  clustering_( ps.getParameter<double>("deltac"), ps.getParameter<double>("rhoc"), ps.getParameter<double>("outlierDeltaFactor") ) {
+  produces<reco::BasicClusterCollection>();
+}
+
+void
+HGCalDensityClusterProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("HGCEErechitCollection", edm::InputTag("HGCalRecHit","HGCEERecHits"));
+  desc.add<edm::InputTag>("HGCHEFrechitCollection", edm::InputTag("HGCalRecHit","HGCHEFRecHits"));
+  desc.add<double>("ecut", 0.)->setComment("Minimum energy of the rechits clustered.");
+  desc.add<double>("deltac", 2.)->setComment("Radius of the density, and minimum distance of a seed to a denser hit.");
+  desc.add<double>("rhoc", 0.)->setComment("Minimum density of a seed.");
+  desc.add<double>("outlierDeltaFactor", 2.)->setComment("Hits farther than outlierDeltaFactor*deltac from any denser hit are not clustered.");
+  desc.add<bool>("parallelLayers", false)->setComment("Cluster the layers in parallel.");
+  descriptions.add("hgcalDensityClusters", desc);
+}
+
+void
+HGCalDensityClusterProducer::fillGroups(const HGCRecHitCollection& recHits, unsigned int subdet) {
+  for(auto const& recHit : recHits) {
+    if( recHit.energy() < eCut_ ) continue;
+    const HGCalDetId id(recHit.id());
+    auto& group = groups_[(subdet*2 + (id.zside() > 0 ? 1 : 0))*nLayers + id.layer()];
+    const GlobalPoint position = recHitTools_.getPosition(id);
+    group.hits.push_back(position.x(), position.y(), recHit.energy());
+    group.z.push_back(position.z());
+    group.recHits.push_back(&recHit);
+  }
+}
+
+void
+HGCalDensityClusterProducer::clusterGroup(LayerGroup& group, reco::CaloCluster::AlgoId algo) const {
+  std::vector<int> clusterOfHit;
+  const unsigned int nClusters = clustering_.cluster(group.hits, clusterOfHit);
+
+  std::vector<double> energy(nClusters, 0.), x(nClusters, 0.), y(nClusters, 0.), z(nClusters, 0.);
+  std::vector<int> seed(nClusters, -1);
+  std::vector<std::vector<std::pair<DetId, float> > > hitsAndFractions(nClusters);
+  for(unsigned int i = 0; i < clusterOfHit.size(); ++i) {
+    const int c = clusterOfHit[i];
+    if( c < 0 ) continue;
+    const float e = group.hits.energy[i];
+    energy[c] += e;
+    x[c] += e*group.hits.x[i];
+    y[c] += e*group.hits.y[i];
+    z[c] += e*group.z[i];
+    if( seed[c] < 0 || e > group.hits.energy[seed[c]] ) seed[c] = i;
+    hitsAndFractions[c].emplace_back(group.recHits[i]->id(), 1.f);
+  }
+
+  group.clusters.reserve(nClusters);
+  for(unsigned int c = 0; c < nClusters; ++c) {
+    const double w = energy[c] > 0. ? 1./energy[c] : 0.;
+    group.clusters.emplace_back(energy[c], math::XYZPoint(x[c]*w, y[c]*w, z[c]*w),
+                                reco::CaloID(reco::CaloID::DET_HGCAL_ENDCAP),
+                                hitsAndFractions[c], algo, group.recHits[seed[c]]->id());
+  }
+}
+
+void
+HGCalDensityClusterProducer::produce(edm::Event& evt, const edm::EventSetup& es) {
+  edm::Handle<HGCeeRecHitCollection> eeRecHits;
+  edm::Handle<HGChefRecHitCollection> hefRecHits;
+  evt.getByToken(eeRecHitCollection_, eeRecHits);
+  evt.getByToken(hefRecHitCollection_, hefRecHits);
+
+  recHitTools_.getEventSetup(es);
+
+  for(auto& group : groups_) group.clear();
+  fillGroups(*eeRecHits, 0);
+  fillGroups(*hefRecHits, 1);
+
+  auto algo = [](unsigned int g) { return g < 2*nLayers ? reco::CaloCluster::hgcal_em : reco::CaloCluster::hgcal_had; };
+  if( parallelLayers_ ) {
+    tbb::parallel_for(0u, (unsigned int)nGroups, [&](unsigned int g) { clusterGroup(groups_[g], algo(g)); });
+  } else {
+    for(unsigned int g = 0; g < nGroups; ++g) clusterGroup(groups_[g], algo(g));
+  }
+
+  auto clusters = std::make_unique<reco::BasicClusterCollection>();
+  for(auto& group : groups_) {
+    for(auto& cluster : group.clusters) clusters->push_back(std::move(cluster));
+  }
+  LogDebug("HGCalDensityClusterProducer") << "total # HGCal 2D clusters: " << clusters->size();
+  evt.put(std::move(clusters));
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE( HGCalDensityClusterProducer );
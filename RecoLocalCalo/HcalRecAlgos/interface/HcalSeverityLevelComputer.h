@@ -53,6 +53,22 @@ class HcalSeverityLevelComputer
   };
 
   std::vector<HcalSeverityDefinition> SevDef;
+
+  // SevDef flattened for getSeverityLevel, from the highest level down: the
+  // rechit flag mask of each kind of cell, and whether the level applies to
+  // all the cells, having neither rechit flags nor channel statuses
+  enum CellKind { kHBHECell, kHOCell, kHFCell, kZDCCell, kCalibCell, kOtherCell, kNCellKinds };
+  class HcalSeverityLookup
+  {
+  public:
+    int sevLevel;
+    uint32_t chStatusMask;
+    uint32_t flagMask[kNCellKinds];
+    bool matchesAll;
+  };
+  std::vector<HcalSeverityLookup> SevLookup_;
+  static CellKind cellKind(HcalGenericDetId::HcalGenericSubdetector mysubdet);
+
   HcalSeverityDefinition* RecoveredRecHit_;
   HcalSeverityDefinition* DropChannel_;
  
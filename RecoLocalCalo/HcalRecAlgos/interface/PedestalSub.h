@@ -18,6 +18,11 @@ class PedestalSub
   
   double getCorrection(const std::vector<double> & inputCharge, const std::vector<double> & inputPedestal) const;
 
+  // the same on arrays of 10 time slices, without allocation
+  void calculate(const double * inputCharge, const double * inputPedestal, double * corrCharge) const;
+
+  double getCorrection(const double * inputCharge, const double * inputPedestal) const;
+
   
  private:
   Method fMethod;
@@ -194,6 +194,22 @@ HcalSeverityLevelComputer::HcalSeverityLevelComputer( const edm::ParameterSet& i
 	<< (*it) << std::endl;
     }
 
+  for (std::vector<HcalSeverityDefinition>::reverse_iterator it = SevDef.rbegin(); it != SevDef.rend(); ++it)
+    {
+      HcalSeverityLookup mylookup;
+      mylookup.sevLevel = it->sevLevel;
+      mylookup.chStatusMask = it->chStatusMask;
+      mylookup.flagMask[kHBHECell] = it->HBHEFlagMask;
+      mylookup.flagMask[kHOCell] = it->HOFlagMask;
+      mylookup.flagMask[kHFCell] = it->HFFlagMask;
+      mylookup.flagMask[kZDCCell] = it->ZDCFlagMask;
+      mylookup.flagMask[kCalibCell] = it->CalibFlagMask;
+      mylookup.flagMask[kOtherCell] = 0;
+      mylookup.matchesAll = !it->HBHEFlagMask && !it->HOFlagMask && !it->HFFlagMask
+	&& !it->ZDCFlagMask && !it->CalibFlagMask && !it->chStatusMask;
+      SevLookup_.push_back(mylookup);
+    }
+
   //
   // Now make the definition for recoveredRecHit
   //
@@ -234,57 +250,33 @@ HcalSeverityLevelComputer::~HcalSeverityLevelComputer() {}
 int HcalSeverityLevelComputer::getSeverityLevel(const DetId& myid, const uint32_t& myflag, 
 						const uint32_t& mystatus) const
 {
-  uint32_t myRecHitMask;
-  HcalGenericDetId myId(myid);
-  HcalGenericDetId::HcalGenericSubdetector mysubdet = myId.genericSubdet();
+  CellKind mykind = cellKind(HcalGenericDetId(myid).genericSubdet());
 
-  // for (unsigned i=(SevDef.size()-1); i >= 0; i--) // Wrong
-  // Since i is unsigned, i >= 0 is always true,
-  // and the loop termination condition is never reached.
-  // We offset the loop index by one to fix this.
-  for (size_t j=(SevDef.size()); j > 0; j--)
+  // the highest level that applies, true if:
+  // rechitmask&myflag true OR chstatusmask&mychstat true
+  // rechitmasks of all the subdetectors empty and chstatusmask empty
+  for (std::vector<HcalSeverityLookup>::const_iterator it = SevLookup_.begin(); it != SevLookup_.end(); ++it)
     {
-      size_t i = j - 1;
-      switch (mysubdet)
-	{
-	case HcalGenericDetId::HcalGenBarrel : case HcalGenericDetId::HcalGenEndcap : 
-	  myRecHitMask = SevDef[i].HBHEFlagMask; break;
-	case HcalGenericDetId::HcalGenOuter : myRecHitMask = SevDef[i].HOFlagMask; break;
-	case HcalGenericDetId::HcalGenForward : myRecHitMask = SevDef[i].HFFlagMask; break;
-	case HcalGenericDetId::HcalGenZDC : myRecHitMask = SevDef[i].ZDCFlagMask; break;
-	case HcalGenericDetId::HcalGenCalibration : myRecHitMask = SevDef[i].CalibFlagMask; break;
-	default: myRecHitMask = 0;
-	}
- 
-      // for debugging:     
-//      std::cout << std::hex << " SLD: RHMask 0x" << myRecHitMask
-//		<< " chstmask 0x" << SevDef[i].chStatusMask
-//		<< " RHmask & myflag 0x" << (myRecHitMask&myflag)
-//		<< " chstmask & mystatus 0x" << (SevDef[i].chStatusMask&mystatus)
-//		<< std::dec << " level = " << SevDef[i].sevLevel << std::endl;
-      
-      // true if:
-      // rechitmask empty and chstatusmask empty
-      // rechitmask empty and chstatusmask&mychstat true
-      // chstatusmask empty and rechitmask&myflag true
-      // rechitmask&myflag true OR chstatusmask&mychstat true
-
-
-      //      if ( ( ( (!myRecHitMask) || (myRecHitMask & myflag) ) &&
-      if ( ( ( ( !SevDef[i].HBHEFlagMask 
-		 && !SevDef[i].HOFlagMask 
-		 && !SevDef[i].HFFlagMask 
-		 && !SevDef[i].ZDCFlagMask 
-		 && !SevDef[i].CalibFlagMask ) 
-	       || (myRecHitMask & myflag) ) 
-	     && ( (!SevDef[i].chStatusMask) || (SevDef[i].chStatusMask & mystatus) ) )
-	   || ( (myRecHitMask & myflag) || (SevDef[i].chStatusMask & mystatus) ) )
-	return SevDef[i].sevLevel;
-
+      if ( (it->flagMask[mykind] & myflag) || (it->chStatusMask & mystatus) || it->matchesAll )
+	return it->sevLevel;
     }
 
   return -100;  // default value, if no definition applies
 }
+
+HcalSeverityLevelComputer::CellKind
+HcalSeverityLevelComputer::cellKind(HcalGenericDetId::HcalGenericSubdetector mysubdet)
+{
+  switch (mysubdet)
+    {
+    case HcalGenericDetId::HcalGenBarrel : case HcalGenericDetId::HcalGenEndcap : return kHBHECell;
+    case HcalGenericDetId::HcalGenOuter : return kHOCell;
+    case HcalGenericDetId::HcalGenForward : return kHFCell;
+    case HcalGenericDetId::HcalGenZDC : return kZDCCell;
+    case HcalGenericDetId::HcalGenCalibration : return kCalibCell;
+    default: return kOtherCell;
+    }
+}
   
 bool HcalSeverityLevelComputer::recoveredRecHit(const DetId& myid, const uint32_t& myflag) const
 {
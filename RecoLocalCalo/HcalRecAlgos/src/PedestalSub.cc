@@ -20,18 +20,29 @@ void PedestalSub::init(Method method=AvgWithThresh, int runCond=0, float thresho
 
 void PedestalSub::calculate(const std::vector<double> & inputCharge, const std::vector<double> & inputPedestal, std::vector<double> & corrCharge) const {
 
+  double corr[10];
+  calculate(&inputCharge[0], &inputPedestal[0], corr);
+  corrCharge.insert(corrCharge.end(), corr, corr+10);
+}
+
+double PedestalSub::getCorrection(const std::vector<double> & inputCharge, const std::vector<double> & inputPedestal) const {
+  return getCorrection(&inputCharge[0], &inputPedestal[0]);
+}
+
+void PedestalSub::calculate(const double * inputCharge, const double * inputPedestal, double * corrCharge) const {
+
   double bseCorr=PedestalSub::getCorrection(inputCharge, inputPedestal);
   for (auto i=0; i<10; i++) {
     if (fMethod==AvgWithThresh||fMethod==Percentile||fMethod==AvgWithoutThresh) {
-      corrCharge.push_back(inputCharge[i]-inputPedestal[i]-bseCorr);
+      corrCharge[i]=inputCharge[i]-inputPedestal[i]-bseCorr;
     }
     else {
-      corrCharge.push_back(inputCharge[i]-bseCorr);
+      corrCharge[i]=inputCharge[i]-bseCorr;
     }
   }
 }
 
-double PedestalSub::getCorrection(const std::vector<double> & inputCharge, const std::vector<double> & inputPedestal) const {
+double PedestalSub::getCorrection(const double * inputCharge, const double * inputPedestal) const {
 
   double baseline=0;
 
@@ -339,52 +339,41 @@ DTCombinatorialPatternReco::buildBestSegment(std::vector<DTSegmentCand::AssPoint
     cout << "pointsNoLR " << pointsNoLR.size() << endl;
   }
 
-  // build all possible candidates using L/R ambiguity
-  vector<DTSegmentCand*> candidates ;
-
-  buildPointsCollection(points, pointsNoLR, candidates, sl);
-
-  if(debug)
-    cout << "candidates " << candidates.size() << endl;
-
-  // so now I have build a given number of segments, I should find the best one,
-  // by #hits and chi2.
-  vector<DTSegmentCand*>::const_iterator bestCandIter = candidates.end();
-  double minChi2=999999.;
-  unsigned int maxNumHits=0;
-  for (vector<DTSegmentCand*>::const_iterator iter=candidates.begin();
-       iter!=candidates.end(); ++iter) {
-    if ((*iter)->nHits()==maxNumHits && (*iter)->chi2()<minChi2) {
-      minChi2=(*iter)->chi2();
-      bestCandIter=iter;
-    } else if ((*iter)->nHits()>maxNumHits) {
-      maxNumHits=(*iter)->nHits();
-      minChi2=(*iter)->chi2();
-      bestCandIter=iter;
-    }
-  }
+  // build all possible candidates using L/R ambiguity, and keep the best one:
+  // all of them have the same hits, so it is the first with the lowest chi2
+  DTSegmentCand* bestCand = 0;
+
+  buildPointsCollection(points, pointsNoLR, bestCand, sl);
 
-  // delete all candidates but the best one!
-  for (vector<DTSegmentCand*>::iterator iter=candidates.begin();
-       iter!=candidates.end(); ++iter) if (iter!=bestCandIter) delete *iter;
+  if(debug && bestCand)
+    cout << "best candidate " << *bestCand << endl;
 
-       // return the best candate if any
-       if (bestCandIter != candidates.end()) {
-         return (*bestCandIter);
-       }
-       return 0;
+  return bestCand;
 }
 
 void
 DTCombinatorialPatternReco::buildPointsCollection(vector<DTSegmentCand::AssPoint>& points, 
                                                   deque<std::shared_ptr<DTHitPairForFit>>& pointsNoLR, 
-                                                  vector<DTSegmentCand*>& candidates,
+                                                  DTSegmentCand*& bestCand,
                                                   const DTSuperLayer* sl) {
 
   if(debug) {
     cout << "buildPointsCollection " << endl;
     cout << "points: " << points.size() << " NOLR: " << pointsNoLR.size()<< endl;
   }
+  // The chi2 of the fit to the points with LR assigned so far is a lower bound
+  // to the chi2 of any candidate built from them: skip the whole L/R subtree
+  // if it cannot beat the best candidate (with a margin for the rounding).
+  if (bestCand && pointsNoLR.size()>1 && points.size()>2) {
+    DTSegmentCand::AssPointCont pointsSet(points.begin(),points.end());
+    DTSegmentCand partialCand(pointsSet,sl);
+    theUpdator->fit(&partialCand,0,0);
+    if (partialCand.chi2() > bestCand->chi2()*1.001 + 0.01) {
+      if(debug)
+        cout << "Pruned: chi2 " << partialCand.chi2() << " > best " << bestCand->chi2() << endl;
+      return;
+    }
+  }
   if (pointsNoLR.size()>0) { // still unassociated points!
     std::shared_ptr<DTHitPairForFit> unassHit = pointsNoLR.front();
     // try with the right
@@ -392,7 +381,7 @@ DTCombinatorialPatternReco::buildPointsCollection(vector<DTSegmentCand::AssPoint
       cout << "Right hit" << endl;
     points.push_back(DTSegmentCand::AssPoint(unassHit, DTEnums::Right));
     pointsNoLR.pop_front();
-    buildPointsCollection(points, pointsNoLR, candidates, sl);
+    buildPointsCollection(points, pointsNoLR, bestCand, sl);
     pointsNoLR.push_front((unassHit));
     points.pop_back();
 
@@ -401,7 +390,7 @@ DTCombinatorialPatternReco::buildPointsCollection(vector<DTSegmentCand::AssPoint
       cout << "Left hit" << endl;
     points.push_back(DTSegmentCand::AssPoint(unassHit, DTEnums::Left));
     pointsNoLR.pop_front();
-    buildPointsCollection(points, pointsNoLR, candidates, sl);
+    buildPointsCollection(points, pointsNoLR, bestCand, sl);
     pointsNoLR.push_front((unassHit));
     points.pop_back();
   } else { // all associated
@@ -427,8 +416,11 @@ DTCombinatorialPatternReco::buildPointsCollection(vector<DTSegmentCand::AssPoint
     }
 
     DTSegmentCand* newCand = new DTSegmentCand(pointsSet,sl);
-    if (theUpdator->fit(newCand,0,0)) candidates.push_back(newCand);
-    else delete newCand; // bad seg, too few hits
+    if (theUpdator->fit(newCand,0,0) && (!bestCand || newCand->chi2()<bestCand->chi2())) {
+      delete bestCand;
+      bestCand = newCand;
+    }
+    else delete newCand; // bad seg, too few hits, or worse than the best one
   }
 }
 
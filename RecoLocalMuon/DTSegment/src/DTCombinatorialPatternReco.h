@@ -89,11 +89,12 @@ class DTCombinatorialPatternReco : public DTRecSegment2DBaseAlgo {
     bool checkDoubleCandidates(std::vector<DTSegmentCand*>& segs,
                                DTSegmentCand* seg);
 
-    /** build collection of compatible hits for L/R hits: the candidates is
-     * updated with the segment candidates found */
+    /** build collection of compatible hits for L/R hits: the best candidate is
+     * updated with the segment candidates found, the L/R combinations which
+     * cannot do better are not fitted */
     void buildPointsCollection(std::vector<DTSegmentCand::AssPoint>& points, 
                                std::deque<std::shared_ptr<DTHitPairForFit> >& pointsNoLR,
-                               std::vector<DTSegmentCand*>& candidates,
+                               DTSegmentCand*& bestCand,
                                const DTSuperLayer* sl);
   private:
 
@@ -0,0 +1,175 @@
+//----------------------------------------------------------------------------
+//! \class PixelUnionFindClusterizer
+//! \brief A threshold-based pixel clustering algorithm using union-find
+//!
+//! See PixelUnionFindClusterizer.h
+//----------------------------------------------------------------------------
+
+#include "PixelUnionFindClusterizer.h"
+// Geometry
+#include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetUnit.h"
+#include "Geometry/CommonTopologies/interface/PixelTopology.h"
+#include "DataFormats/SiPixelDetId/interface/PXBDetId.h"
+
+// STL
+#include <algorithm>
+#include <vector>
+
+
+PixelUnionFindClusterizer::PixelUnionFindClusterizer(edm::ParameterSet const& conf) :
+  thePixelThreshold(conf.getParameter<int>("ChannelThreshold")),
+  theSeedThreshold(conf.getParameter<int>("SeedThreshold")),
+  theClusterThreshold(conf.getParameter<double>("ClusterThreshold")),
+  theConversionFactor(conf.getParameter<int>("VCaltoElectronGain")),
+  theOffset(conf.getParameter<int>("VCaltoElectronOffset")),
+  theStackADC_(conf.exists("AdcFullScaleStack") ? conf.getParameter<int>("AdcFullScaleStack") : 255),
+  theFirstStack_(conf.exists("FirstStackLayer") ? conf.getParameter<int>("FirstStackLayer") : 5),
+  doMissCalibrate(conf.getUntrackedParameter<bool>("MissCalibrate",true))
+{}
+
+PixelUnionFindClusterizer::~PixelUnionFindClusterizer() {}
+
+
+void PixelUnionFindClusterizer::clusterizeDetUnit( const edm::DetSet<PixelDigi> & input,
+						   const PixelGeomDetUnit * pixDet,
+						   const std::vector<short>& badChannels,
+						   edmNew::DetSetVector<SiPixelCluster>::FastFiller& output) {
+  std::vector<int> electron(input.size());
+  calibrate(input, electron.data());
+  std::vector<SiPixelCluster> clusters;
+  clusterize(input, electron.data(), pixDet, clusters);
+  for (auto & cluster : clusters) output.push_back(std::move(cluster));
+}
+
+
+//----------------------------------------------------------------------------
+//! As in PixelThresholdClusterizer::copy_to_buffer
+//----------------------------------------------------------------------------
+void PixelUnionFindClusterizer::calibrate( const edm::DetSet<PixelDigi> & input, int * electron) {
+  DigiIterator begin = input.begin();
+  DigiIterator end   = input.end();
+  uint32_t detid = input.detId();
+  if ( doMissCalibrate ) {
+    (*theSiPixelGainCalibrationService_).calibrate(detid,begin,end,theConversionFactor, theOffset,electron);
+    return;
+  }
+  int layer = (DetId(detid).subdetId()==1) ? PXBDetId(detid).layer() : 0;
+  int i=0;
+  for(DigiIterator di = begin; di != end; ++di) {
+    auto adc = di->adc();
+    const float gain = 135.; // 1 ADC = 135 electrons
+    const float pedestal = 0.; //
+    electron[i] = int(adc * gain + pedestal);
+    if (layer>=theFirstStack_) {
+      if (theStackADC_==1&&adc==1) {
+	electron[i] = int(255*135); // Arbitrarily use overflow value.
+      }
+      if (theStackADC_>1&&theStackADC_!=255&&adc>=1){
+	electron[i] = int((adc-1) * gain * 255/float(theStackADC_-1));
+      }
+    }
+    ++i;
+  }
+}
+
+
+namespace {
+
+  // index of the pixel above threshold at each position of the module, -1 elsewhere;
+  // one per thread, as large as the largest module seen, and reset after each module
+  thread_local std::vector<int> s_image;
+
+  int findRoot(std::vector<int> & parent, int i) {
+    while (parent[i]!=i) {
+      parent[i] = parent[parent[i]];  // path halving
+      i = parent[i];
+    }
+    return i;
+  }
+
+}
+
+//----------------------------------------------------------------------------
+//!  \brief The clustering: label the 8-connected groups of pixels above threshold.
+//----------------------------------------------------------------------------
+void PixelUnionFindClusterizer::clusterize( const edm::DetSet<PixelDigi> & input, const int * electron,
+					    const PixelGeomDetUnit * pixDet,
+					    std::vector<SiPixelCluster> & clusters) const {
+  typedef unsigned short UShort;
+  static constexpr unsigned int MAXSIZE = 256;
+
+  const PixelTopology & topol = pixDet->specificTopology();
+  const int nrows = topol.nrows();
+  const int ncols = topol.ncolumns();
+  if (int(s_image.size()) < nrows*ncols) s_image.resize(nrows*ncols, -1);
+  int * image = s_image.data();
+
+  // the pixels above threshold, in digi order; a repeated pixel keeps its last charge
+  std::vector<UShort> row, col;
+  std::vector<int> adc;
+  row.reserve(input.size()); col.reserve(input.size()); adc.reserve(input.size());
+  int i=0;
+  for (DigiIterator di = input.begin(); di != input.end(); ++di, ++i) {
+    if (electron[i] < thePixelThreshold) continue;
+    int & index = image[di->column()*nrows + di->row()];
+    if (index>=0) { adc[index] = electron[i]; continue; }
+    index = row.size();
+    row.push_back(di->row()); col.push_back(di->column()); adc.push_back(electron[i]);
+  }
+  const int npix = row.size();
+  if (npix==0) return;
+
+  // join each pixel with its neighbours
+  std::vector<int> parent(npix);
+  for (int k=0; k!=npix; ++k) parent[k]=k;
+  for (int k=0; k!=npix; ++k) {
+    for (int c = std::max(0,int(col[k])-1); c < std::min(int(col[k])+2,ncols); ++c) {
+      for (int r = std::max(0,int(row[k])-1); r < std::min(int(row[k])+2,nrows); ++r) {
+	int j = image[c*nrows + r];
+	if (j<0 || j>=k) continue;  // each pair once
+	int rk = findRoot(parent,k), rj = findRoot(parent,j);
+	if (rk!=rj) parent[std::max(rk,rj)] = std::min(rk,rj);
+      }
+    }
+  }
+
+  // number the groups with a seed in the order of their first seed
+  std::vector<int> label(npix,-1);
+  int nclus=0;
+  for (int k=0; k!=npix; ++k) {
+    if (adc[k] < theSeedThreshold) continue;
+    int root = findRoot(parent,k);
+    if (label[root]<0) label[root] = nclus++;
+  }
+
+  // gather the pixels of each cluster, in digi order
+  std::vector<int> first(nclus+1,0), member(npix);
+  for (int k=0; k!=npix; ++k) {
+    int l = label[findRoot(parent,k)];
+    if (l>=0) ++first[l+1];
+  }
+  for (int l=0; l!=nclus; ++l) first[l+1] += first[l];
+  {
+    std::vector<int> next(first.begin(), first.end()-1);
+    for (int k=0; k!=npix; ++k) {
+      int l = label[findRoot(parent,k)];
+      if (l>=0) member[next[l]++] = k;
+    }
+  }
+
+  UShort cadc[MAXSIZE], cx[MAXSIZE], cy[MAXSIZE];
+  for (int l=0; l!=nclus; ++l) {
+    unsigned int isize = std::min(unsigned(first[l+1]-first[l]), MAXSIZE);
+    UShort xmin=16000, ymin=16000;
+    for (unsigned int m=0; m!=isize; ++m) {
+      int k = member[first[l]+m];
+      cadc[m] = adc[k]; cx[m] = row[k]; cy[m] = col[k];
+      xmin = std::min(xmin,cx[m]); ymin = std::min(ymin,cy[m]);
+    }
+    SiPixelCluster cluster(isize, cadc, cx, cy, xmin, ymin);
+    if ( cluster.charge() >= theClusterThreshold) clusters.push_back(std::move(cluster));
+  }
+
+  // reset the image
+  for (int k=0; k!=npix; ++k) image[col[k]*nrows + row[k]] = -1;
+}
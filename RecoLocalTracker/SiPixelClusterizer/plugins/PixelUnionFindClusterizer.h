@@ -0,0 +1,69 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_PixelUnionFindClusterizer_H
+#define RecoLocalTracker_SiPixelClusterizer_PixelUnionFindClusterizer_H
+
+//-----------------------------------------------------------------------
+//! \class PixelUnionFindClusterizer
+//! \brief A threshold-based clustering algorithm using union-find labelling.
+//!
+//! Makes the same clusters as PixelThresholdClusterizer: the 8-connected
+//! groups of pixels above the pixel threshold that contain at least one
+//! pixel above the seed threshold, kept if above the cluster threshold,
+//! in the order of their first seed.
+//!
+//! The pixels above threshold are entered in a flat index image of the
+//! module, their neighbours are joined with union-find, and the clusters
+//! are read off the labels; no stack is walked.  Only the pixels of the
+//! module are touched, and the image is reset after each module.
+//!
+//! The calibration uses the gain calibration service, and must run in
+//! sequence; the clustering itself keeps no state in the clusterizer,
+//! so that the modules of an event can be clustered in parallel.
+//!
+//! As in PixelThresholdClusterizer, a cluster holds at most 256 pixels;
+//! a larger one keeps its first pixels in digi order.  The pixels of a
+//! cluster are in digi order.
+//-----------------------------------------------------------------------
+
+#include "DataFormats/Common/interface/DetSetVector.h"
+#include "PixelClusterizerBase.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <vector>
+
+
+class dso_hidden PixelUnionFindClusterizer final : public PixelClusterizerBase {
+ public:
+
+  PixelUnionFindClusterizer(edm::ParameterSet const& conf);
+  ~PixelUnionFindClusterizer();
+
+  // Full I/O in DetSet
+  void clusterizeDetUnit( const edm::DetSet<PixelDigi> & input,
+			  const PixelGeomDetUnit * pixDet,
+			  const std::vector<short>& badChannels,
+			  edmNew::DetSetVector<SiPixelCluster>::FastFiller& output) override;
+
+  //! Converts the adc counts of the digis to electrons; not thread safe.
+  void calibrate( const edm::DetSet<PixelDigi> & input, int * electron);
+
+  //! Clusters the digis of a module, given their charges in electrons; thread safe.
+  void clusterize( const edm::DetSet<PixelDigi> & input, const int * electron,
+		   const PixelGeomDetUnit * pixDet,
+		   std::vector<SiPixelCluster> & clusters) const;
+
+ private:
+
+  //! Clustering-related quantities:
+  int   thePixelThreshold;    // Pixel threshold in electrons
+  int   theSeedThreshold;     // Seed threshold in electrons
+  float theClusterThreshold;  // Cluster threshold in electrons
+  int   theConversionFactor;  // adc to electron conversion factor
+  int   theOffset;            // adc to electron conversion offset
+  int   theStackADC_;         // The maximum ADC count for the stack layers
+  int   theFirstStack_;       // The index of the first stack layer
+  bool  doMissCalibrate;      // Use calibration or not
+
+};
+
+#endif
@@ -14,6 +14,7 @@
 // Our own stuff
 #include "SiPixelClusterProducer.h"
 #include "PixelThresholdClusterizer.h"
+#include "PixelUnionFindClusterizer.h"
 
 // Geometry
 #include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
@@ -39,6 +40,8 @@
 #include <string>
 #include <iostream>
 
+#include "tbb/parallel_for.h"
+
 // MessageLogger
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
@@ -52,6 +55,7 @@
     theSiPixelGainCalibration_(0), 
     clusterMode_("None"),     // bogus
     clusterizer_(0),          // the default, in case we fail to make one
+    unionFindClusterizer_(0),
     readyToCluster_(false),   // since we obviously aren't
     src_( conf.getParameter<edm::InputTag>( "src" ) ),
     maxTotalClusters_( conf.getParameter<int32_t>( "maxNumberOfClusters" ) )
@@ -106,7 +110,10 @@
 
     // Step C: Iterate over DetIds and invoke the pixel clusterizer algorithm
     // on each DetUnit
-    run(*input, geom, *output );
+    if (unionFindClusterizer_)
+      runInParallel(*input, geom, *output );
+    else
+      run(*input, geom, *output );
 
     // Step D: write output to file
     output->shrink_to_fit();
@@ -128,11 +135,18 @@
       clusterizer_->setSiPixelGainCalibrationService(theSiPixelGainCalibration_);
       readyToCluster_ = true;
     } 
+    else if ( clusterMode_ == "PixelUnionFindClusterizer" ) {
+      unionFindClusterizer_ = new PixelUnionFindClusterizer(conf_);
+      clusterizer_ = unionFindClusterizer_;
+      clusterizer_->setSiPixelGainCalibrationService(theSiPixelGainCalibration_);
+      readyToCluster_ = true;
+    } 
     else {
       edm::LogError("SiPixelClusterProducer") << "[SiPixelClusterProducer]:"
 		<<" choice " << clusterMode_ << " is invalid.\n"
 		<< "Possible choices:\n" 
-		<< "    PixelThresholdClusterizer";
+		<< "    PixelThresholdClusterizer\n"
+		<< "    PixelUnionFindClusterizer";
       readyToCluster_ = false;
     }
   }
@@ -199,6 +213,52 @@
     //				    << " SiPixelClusters in " << numberOfDetUnits << " DetUnits."; 
   }
 
+  //---------------------------------------------------------------------------
+  //!  Same as run, with the clustering of the modules done in parallel.
+  //!  The charges are calibrated first, in sequence, as the gain calibration
+  //!  service is not thread safe; the clusters of each module are then made
+  //!  in parallel, and copied in order to the output, sized beforehand.
+  //---------------------------------------------------------------------------
+  void SiPixelClusterProducer::runInParallel(const edm::DetSetVector<PixelDigi>   & input,
+					     edm::ESHandle<TrackerGeometry>       & geom,
+					     edmNew::DetSetVector<SiPixelCluster> & output) {
+    const unsigned int numberOfDetUnits = input.size();
+    std::vector<const PixelGeomDetUnit*> pixDets(numberOfDetUnits);
+    std::vector<unsigned int> firstDigi(numberOfDetUnits+1,0);
+    for (unsigned int i=0; i!=numberOfDetUnits; ++i) {
+      const edm::DetSet<PixelDigi> & digis = *(input.begin()+i);
+      pixDets[i] = dynamic_cast<const PixelGeomDetUnit*>(geom->idToDetUnit( DetId(digis.detId()) ));
+      if (! pixDets[i]) {
+	// Fatal error!  TO DO: throw an exception!
+	assert(0);
+      }
+      firstDigi[i+1] = firstDigi[i] + digis.size();
+    }
+
+    std::vector<int> electrons(firstDigi.back());
+    for (unsigned int i=0; i!=numberOfDetUnits; ++i)
+      unionFindClusterizer_->calibrate(*(input.begin()+i), electrons.data()+firstDigi[i]);
+
+    std::vector<std::vector<SiPixelCluster>> clusters(numberOfDetUnits);
+    tbb::parallel_for(0U, numberOfDetUnits, [&](unsigned int i) {
+	unionFindClusterizer_->clusterize(*(input.begin()+i), electrons.data()+firstDigi[i], pixDets[i], clusters[i]);
+      });
+
+    int numberOfClusters = 0;
+    for (auto const & detClusters : clusters) numberOfClusters += detClusters.size();
+    if ((maxTotalClusters_ >= 0) && (numberOfClusters > maxTotalClusters_)) {
+      edm::LogError("TooManyClusters") <<  "Limit on the number of clusters exceeded. An empty cluster collection will be produced instead.\n";
+      return;
+    }
+
+    output.reserve(numberOfDetUnits, numberOfClusters);
+    for (unsigned int i=0; i!=numberOfDetUnits; ++i) {
+      if (clusters[i].empty()) continue;
+      edmNew::DetSetVector<SiPixelCluster>::FastFiller spc(output, (input.begin()+i)->detId());
+      for (auto & cluster : clusters[i]) spc.push_back(std::move(cluster));
+    }
+  }
+
 
 
 
@@ -30,6 +30,8 @@
 
 #include "PixelClusterizerBase.h"
 
+class PixelUnionFindClusterizer;
+
 //#include "Geometry/CommonDetUnit/interface/TrackingGeometry.h"
 
 #include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
@@ -65,6 +67,11 @@
 	     edm::ESHandle<TrackerGeometry>       & geom,
              edmNew::DetSetVector<SiPixelCluster> & output);
 
+    //--- Same, clustering the modules in parallel (PixelUnionFindClusterizer only).
+    void runInParallel(const edm::DetSetVector<PixelDigi>   & input,
+		       edm::ESHandle<TrackerGeometry>       & geom,
+		       edmNew::DetSetVector<SiPixelCluster> & output);
+
   private:
     edm::ParameterSet conf_;
     edm::EDGetTokenT<edm::DetSetVector<PixelDigi>> tPixelDigi;
@@ -72,6 +79,7 @@
     SiPixelGainCalibrationServiceBase * theSiPixelGainCalibration_;
     std::string clusterMode_;               // user's choice of the clusterizer
     PixelClusterizerBase * clusterizer_;    // what we got (for now, one ptr to base class)
+    PixelUnionFindClusterizer * unionFindClusterizer_; // the same, if it is a PixelUnionFindClusterizer
     bool readyToCluster_;                   // needed clusterizers valid => good to go!
     edm::InputTag src_;
 
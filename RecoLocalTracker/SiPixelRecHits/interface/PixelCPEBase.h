@@ -145,7 +145,8 @@ public:
 #endif 
 
       DetParam const & theDetParam = detParam(det);
-      ClusterParam * theClusterParam = createClusterParam(cl);
+      alignas(ClusterParamBufferAlignment) char buffer[ClusterParamBufferSize];
+      ClusterParam * theClusterParam = createClusterParam(cl, buffer);
       setTheClu( theDetParam, *theClusterParam );
       computeAnglesFromDetPosition(theDetParam, *theClusterParam);
       
@@ -154,7 +155,7 @@ public:
       LocalError le = localError(theDetParam, *theClusterParam);        
       SiPixelRecHitQuality::QualWordType rqw = rawQualityWord(*theClusterParam);
       auto tuple = std::make_tuple(lp, le , rqw);
-      delete theClusterParam;
+      theClusterParam->~ClusterParam();
       
       //std::cout<<" in PixelCPEBase:localParameters(all) - "<<lp.x()<<" "<<lp.y()<<std::endl;  //dk
       return tuple;
@@ -173,7 +174,8 @@ public:
 #endif 
 
     DetParam const & theDetParam = detParam(det);
-    ClusterParam *  theClusterParam = createClusterParam(cl);
+    alignas(ClusterParamBufferAlignment) char buffer[ClusterParamBufferSize];
+    ClusterParam *  theClusterParam = createClusterParam(cl, buffer);
     setTheClu( theDetParam, *theClusterParam );
     computeAnglesFromTrajectory(theDetParam, *theClusterParam, ltp);
     
@@ -182,7 +184,7 @@ public:
     LocalError le = localError(theDetParam, *theClusterParam);        
     SiPixelRecHitQuality::QualWordType rqw = rawQualityWord(*theClusterParam);
     auto tuple = std::make_tuple(lp, le , rqw);
-    delete theClusterParam;
+    theClusterParam->~ClusterParam();
 
     //std::cout<<" in PixelCPEBase:localParameters(on track) - "<<lp.x()<<" "<<lp.y()<<std::endl;  //dk
     return tuple;
@@ -190,8 +192,17 @@ public:
   
   
   
+protected:
+  //--------------------------------------------------------------------------
+  // The cluster parameters are built in place, in a buffer on the stack of
+  // getParameters, as they are for every hit of every track (re)fit.
+  // The concrete ClusterParam must fit, and be trivially destructible.
+  //--------------------------------------------------------------------------
+  static constexpr unsigned int ClusterParamBufferSize = 256;
+  static constexpr unsigned int ClusterParamBufferAlignment = alignof(ClusterParam);
+
 private:
-  virtual ClusterParam * createClusterParam(const SiPixelCluster & cl) const = 0;
+  virtual ClusterParam * createClusterParam(const SiPixelCluster & cl, void * buffer) const = 0;
 
   //--------------------------------------------------------------------------
   // This is where the action happens.
@@ -89,7 +89,7 @@ class PixelCPEGeneric : public PixelCPEBase
 
  
 private:
-  ClusterParam * createClusterParam(const SiPixelCluster & cl) const;
+  ClusterParam * createClusterParam(const SiPixelCluster & cl, void * buffer) const;
 
   LocalPoint localPosition (DetParam const & theDetParam, ClusterParam & theClusterParam) const; 
   LocalError localError   (DetParam const & theDetParam, ClusterParam & theClusterParam) const;
@@ -62,7 +62,7 @@ class PixelCPETemplateReco : public PixelCPEBase
   ~PixelCPETemplateReco();
 
  private:
-  ClusterParam * createClusterParam(const SiPixelCluster & cl) const;
+  ClusterParam * createClusterParam(const SiPixelCluster & cl, void * buffer) const;
 
   // We only need to implement measurementPosition, since localPosition() from
   // PixelCPEBase will call it and do the transformation
@@ -1,5 +1,8 @@
 #include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEGeneric.h"
 
+#include <new>
+#include <type_traits>
+
 #include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetUnit.h"
 #include "Geometry/TrackerGeometryBuilder/interface/RectangularPixelTopology.h"
 
@@ -148,9 +151,11 @@ PixelCPEGeneric::PixelCPEGeneric(edm::ParameterSet const & conf,
 
 }
 
-PixelCPEBase::ClusterParam* PixelCPEGeneric::createClusterParam(const SiPixelCluster & cl) const
+PixelCPEBase::ClusterParam* PixelCPEGeneric::createClusterParam(const SiPixelCluster & cl, void * buffer) const
 {
-   return new ClusterParamGeneric(cl);
+   static_assert(sizeof(ClusterParamGeneric) <= ClusterParamBufferSize && alignof(ClusterParamGeneric) <= ClusterParamBufferAlignment, "ClusterParamGeneric does not fit the buffer");
+   static_assert(std::is_trivially_destructible<ClusterParamGeneric>::value, "ClusterParamGeneric must be trivially destructible");
+   return new (buffer) ClusterParamGeneric(cl);
 }
 
 
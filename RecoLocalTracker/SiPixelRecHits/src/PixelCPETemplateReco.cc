@@ -1,6 +1,9 @@
 // Include our own header first
 #include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPETemplateReco.h"
 
+#include <new>
+#include <type_traits>
+
 // Geometry services
 #include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetUnit.h"
 #include "Geometry/TrackerGeometryBuilder/interface/RectangularPixelTopology.h"
@@ -99,9 +102,11 @@ PixelCPETemplateReco::~PixelCPETemplateReco()
   // &&& delete template store?
 }
 
-PixelCPEBase::ClusterParam* PixelCPETemplateReco::createClusterParam(const SiPixelCluster & cl) const
+PixelCPEBase::ClusterParam* PixelCPETemplateReco::createClusterParam(const SiPixelCluster & cl, void * buffer) const
 {
-   return new ClusterParamTemplate(cl);
+   static_assert(sizeof(ClusterParamTemplate) <= ClusterParamBufferSize && alignof(ClusterParamTemplate) <= ClusterParamBufferAlignment, "ClusterParamTemplate does not fit the buffer");
+   static_assert(std::is_trivially_destructible<ClusterParamTemplate>::value, "ClusterParamTemplate must be trivially destructible");
+   return new (buffer) ClusterParamTemplate(cl);
 }
 
 
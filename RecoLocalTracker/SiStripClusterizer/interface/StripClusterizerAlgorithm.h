@@ -9,6 +9,7 @@ class SiStripDigi;
 #include "FWCore/Framework/interface/ESHandle.h"
 #include "CalibFormats/SiStripObjects/interface/SiStripGain.h"
 #include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+#include "CalibFormats/SiStripObjects/interface/SiStripDenseNoises.h"
 #include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
 #include "EventFilter/SiStripRawToDigi/interface/SiStripFEDBuffer.h"
 #include <limits>
@@ -24,7 +25,7 @@ class StripClusterizerAlgorithm {
   // state of detID
   struct Det {
     bool valid() const { return ind!=invalidI; }
-    float noise(const uint16_t& strip) const { return SiStripNoises::getNoise( strip, noiseRange ); }
+    float noise(const uint16_t& strip) const { return denseNoises ? denseNoises[strip] : SiStripNoises::getNoise( strip, noiseRange ); }
     float gain(const uint16_t& strip)  const { return SiStripGain::getStripGain( strip, gainRange ); }
     bool bad(const uint16_t& strip)    const { return quality->IsStripBad( qualityRange, strip ); }
     bool allBadBetween(uint16_t L, const uint16_t& R) const { while( ++L < R  &&  bad(L) ); return L == R; }
@@ -32,6 +33,8 @@ class StripClusterizerAlgorithm {
     SiStripApvGain::Range gainRange;
     SiStripNoises::Range  noiseRange;
     SiStripQuality::Range qualityRange;
+    // noises of the strips already decoded, if the dense noises are used
+    float const * denseNoises=nullptr;
     uint32_t detId=0;
     unsigned short ind=invalidI;
   };
@@ -82,13 +85,15 @@ class StripClusterizerAlgorithm {
 
  protected:
 
-  StripClusterizerAlgorithm() : qualityLabel(""), noise_cache_id(0), gain_cache_id(0), quality_cache_id(0) {}
+  StripClusterizerAlgorithm() : qualityLabel(""), useDenseNoises(false), noise_cache_id(0), gain_cache_id(0), quality_cache_id(0), dense_noise_cache_id(0) {}
 
   Det findDetId(const uint32_t) const;
   bool isModuleBad(const uint32_t& id)  const { return qualityHandle->IsModuleBad( id ); }
   bool isModuleUsable(const uint32_t& id)  const { return qualityHandle->IsModuleUsable( id ); }
 
   std::string qualityLabel;
+  // read the noises from the SiStripDenseNoisesRcd instead of unpacking them strip by strip
+  bool useDenseNoises;
 
  private:
 
@@ -112,8 +117,9 @@ class StripClusterizerAlgorithm {
   edm::ESHandle<SiStripGain> gainHandle;
   edm::ESHandle<SiStripNoises> noiseHandle;
   edm::ESHandle<SiStripQuality> qualityHandle;
+  edm::ESHandle<SiStripDenseNoises> denseNoiseHandle;
   SiStripDetCabling const * theCabling = nullptr;
-  uint32_t noise_cache_id, gain_cache_id, quality_cache_id;
+  uint32_t noise_cache_id, gain_cache_id, quality_cache_id, dense_noise_cache_id;
     
 
 };
@@ -48,7 +48,7 @@ class ThreeThresholdAlgorithm final : public StripClusterizerAlgorithm {
   template<class T> void clusterizeDetUnit_(const T&, output_t::TSFastFiller&) const;
 
   ThreeThresholdAlgorithm(float, float, float, unsigned, unsigned, unsigned, std::string qualityLabel,
-			  bool removeApvShots, float minGoodCharge);
+			  bool removeApvShots, float minGoodCharge, bool denseNoises=false);
 
 
     //constant methods with state information
@@ -61,6 +61,7 @@ class ThreeThresholdAlgorithm final : public StripClusterizerAlgorithm {
     void clearCandidate(State & state) const { state.candidateLacksSeed = true;  state.noiseSquared = 0;  state.ADCs.clear();}
     void addToCandidate(State & state, const SiStripDigi& digi) const { addToCandidate(state, digi.strip(),digi.adc());}
     void addToCandidate(State & state, uint16_t strip, uint8_t adc) const;
+    void addOverThresholdToCandidate(State & state, uint16_t strip, uint8_t adc, float noise) const;
     void appendBadNeighbors(State & state) const;
     void applyGains(State & state) const;
 
@@ -133,6 +133,8 @@ namespace {
     
     StripClusterizerAlgorithm & clusterizer;
     SiStripRawProcessingAlgorithms & rawAlgos;
+    // the raw processing keeps per-call state: dets filled concurrently on demand take turns
+    std::mutex rawAlgosMutex;
     
     
     // March 2012: add flag for disabling APVe check in configuration
@@ -414,7 +416,10 @@ try { // edmNew::CapacityExaustedException
 	//rawAlgos_->subtractorCMN->subtract( id, digis);
 	//rawAlgos_->suppressor->suppress( digis, zsdigis);
 	uint16_t firstAPV = ipair*2;
-	rawAlgos.SuppressVirginRawData(id, firstAPV,digis, zsdigis);
+	{
+	  std::lock_guard<std::mutex> guard(rawAlgosMutex);
+	  rawAlgos.SuppressVirginRawData(id, firstAPV,digis, zsdigis);
+	}
  	for( edm::DetSet<SiStripDigi>::const_iterator it = zsdigis.begin(); it!=zsdigis.end(); it++) {
 	  clusterizer.stripByStripAdd(state, it->strip(), it->adc(), record);
 	}
@@ -438,7 +443,10 @@ try { // edmNew::CapacityExaustedException
 	//rawAlgos_->subtractorCMN->subtract( id, digis);
 	//rawAlgos_->suppressor->suppress( digis, zsdigis);
 	uint16_t firstAPV = ipair*2;
-	rawAlgos.SuppressProcessedRawData(id, firstAPV,digis, zsdigis);
+	{
+	  std::lock_guard<std::mutex> guard(rawAlgosMutex);
+	  rawAlgos.SuppressProcessedRawData(id, firstAPV,digis, zsdigis);
+	}
 	for( edm::DetSet<SiStripDigi>::const_iterator it = zsdigis.begin(); it!=zsdigis.end(); it++) {
 	  clusterizer.stripByStripAdd(state, it->strip(), it->adc(), record);
 	}
@@ -4,6 +4,7 @@
 #include "CondFormats/DataRecord/interface/SiStripNoisesRcd.h"
 #include "CalibTracker/Records/interface/SiStripGainRcd.h"
 #include "CalibTracker/Records/interface/SiStripQualityRcd.h"
+#include "CalibTracker/Records/interface/SiStripDependentRecords.h"
 #include "DataFormats/SiStripDigi/interface/SiStripDigi.h"
 #include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
 #include "CalibFormats/SiStripObjects/interface/SiStripDetCabling.h"
@@ -43,6 +44,14 @@ initialize(const edm::EventSetup& es) {
     quality_cache_id = q_cache_id;
     mod=true;
   }
+  if(useDenseNoises) {
+    // built from the same noises, so its positions are the ones of the noise indices
+    uint32_t d_cache_id = es.get<SiStripDenseNoisesRcd>().cacheIdentifier();
+    if(d_cache_id != dense_noise_cache_id) {
+      es.get<SiStripDenseNoisesRcd>().get( denseNoiseHandle );
+      dense_noise_cache_id = d_cache_id;
+    }
+  }
 
   if (mod) { 
     // redo indexing!
@@ -147,6 +156,7 @@ findDetId(const uint32_t id) const {
   det.gainRange = gainHandle->getRangeByPos(indices[det.ind].gi);
   det.qualityRange = qualityHandle->getRangeByPos(indices[det.ind].qi);
   det.quality =   qualityHandle.product();
+  if (useDenseNoises) det.denseNoises = denseNoiseHandle->noisesByPos(indices[det.ind].ni);
 
 #ifdef EDM_ML_DEBUG
   assert(detIds[det.ind]==det.detId); 
@@ -156,6 +166,7 @@ findDetId(const uint32_t id) const {
   assert(oldn==det.noiseRange);
   auto oldq = qualityHandle->getRange(id);
   assert(oldq==det.qualityRange);
+  if (det.denseNoises) assert(denseNoiseHandle->detIds()[indices[det.ind].ni]==id);
 #endif
 #ifdef EDM_ML_DEBUG
   assert(isModuleUsable( id ));
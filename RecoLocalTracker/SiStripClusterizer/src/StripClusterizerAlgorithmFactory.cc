@@ -20,7 +20,9 @@ create(const edm::ParameterSet& conf) {
 	       conf.getParameter<unsigned>("MaxAdjacentBad"),
 	       conf.getParameter<std::string>("QualityLabel"),
 	       conf.getParameter<bool>("RemoveApvShots"),
-               clusterChargeCut(conf)
+               clusterChargeCut(conf),
+	       // needs the SiStripDenseNoisesESProducer in the job
+	       conf.getUntrackedParameter<bool>("DenseNoises", false)
            ));
   }
 
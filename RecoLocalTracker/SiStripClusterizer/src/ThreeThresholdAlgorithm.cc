@@ -9,10 +9,11 @@
 
 ThreeThresholdAlgorithm::
 ThreeThresholdAlgorithm(float chan, float seed, float cluster, unsigned holes, unsigned bad, unsigned adj, std::string qL, 
-			bool removeApvShots, float minGoodCharge) 
+			bool removeApvShots, float minGoodCharge, bool denseNoises) 
   : ChannelThreshold( chan ), SeedThreshold( seed ), ClusterThresholdSquared( cluster*cluster ),
     MaxSequentialHoles( holes ), MaxSequentialBad( bad ), MaxAdjacentBad( adj ), RemoveApvShots(removeApvShots), minGoodCharge(minGoodCharge) {
   qualityLabel = (qL);
+  useDenseNoises = denseNoises;
 }
 
 template<class digiDetSet>
@@ -39,12 +40,24 @@ clusterizeDetUnit_(const digiDetSet& digis, output_t::TSFastFiller& output) cons
     ApvCleaner.clean(digis,scan,end);
   }
 
+  // digis are taken in blocks: the noises are looked up and the channel threshold mask is computed
+  // for the whole block in flat loops, and only the digis over threshold go through the candidate logic.
+  // Skipping the others does not change the clusters, as candidateEnded only grows with the strip number.
+  constexpr int blockSize = 128;
+  uint16_t strips[blockSize]; uint8_t adcs[blockSize]; float noises[blockSize]; bool overThreshold[blockSize];
   State state(det);
   while( scan != end ) {
-    while( scan != end  && !candidateEnded(state, scan->strip() ) ) 
-      addToCandidate( state, *scan++);
-    endCandidate(state, output);
+    int n=0;
+    for ( ; n!=blockSize && scan!=end; ++n, ++scan) { strips[n] = scan->strip(); adcs[n] = scan->adc(); }
+    for (int i=0; i!=n; ++i) noises[i] = det.noise(strips[i]);
+    for (int i=0; i!=n; ++i) overThreshold[i] = adcs[i] >= static_cast<uint8_t>( noises[i] * ChannelThreshold);
+    for (int i=0; i!=n; ++i) {
+      if (!overThreshold[i]) continue;
+      if (candidateEnded(state, strips[i])) endCandidate(state, output);
+      addOverThresholdToCandidate(state, strips[i], adcs[i], noises[i]);
+    }
   }
+  endCandidate(state, output);
 }
 
 inline 
@@ -64,7 +77,15 @@ inline
 void ThreeThresholdAlgorithm::
 addToCandidate(State & state, uint16_t strip, uint8_t adc) const { 
   float Noise = state.det().noise( strip );
-  if(  adc < static_cast<uint8_t>( Noise * ChannelThreshold) || state.det().bad(strip) )
+  if(  adc < static_cast<uint8_t>( Noise * ChannelThreshold) )
+    return;
+  addOverThresholdToCandidate(state, strip, adc, Noise);
+}
+
+inline 
+void ThreeThresholdAlgorithm::
+addOverThresholdToCandidate(State & state, uint16_t strip, uint8_t adc, float Noise) const { 
+  if( state.det().bad(strip) )
     return;
 
   if(state.candidateLacksSeed) state.candidateLacksSeed  =  adc < static_cast<uint8_t>( Noise * SeedThreshold);
@@ -0,0 +1,167 @@
+/*
+ * Replays the digis of a ClusterizerFixture, written by the
+ * ClusterizerFixtureWriter, through the ThreeThresholdAlgorithm and reports
+ * its throughput for each number of threads, the events being shared among
+ * the threads.  The strip by strip interface is used with the conditions of
+ * the fixture, so no EventSetup is needed.
+ *
+ *   ClusterizerBenchmark [fixture file] [repetitions] [threads...]
+ *
+ * Without a fixture a small synthetic one is generated, so the benchmark
+ * also runs as a test.  The checksum of the clusters must not depend on the
+ * number of threads.  For the cache behaviour run it under "perf stat".
+ */
+
+#include "RecoLocalTracker/SiStripClusterizer/test/ClusterizerFixture.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/StripClusterizerAlgorithm.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/StripClusterizerAlgorithmFactory.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "tbb/task_arena.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+  // the default offline clusterizer
+  std::auto_ptr<StripClusterizerAlgorithm> makeAlgorithm() {
+    edm::ParameterSet chargeCut;
+    chargeCut.addParameter<double>("value", -1.0);
+    edm::ParameterSet conf;
+    conf.addParameter<std::string>("Algorithm", "ThreeThresholdAlgorithm");
+    conf.addParameter<double>("ChannelThreshold", 2.0);
+    conf.addParameter<double>("SeedThreshold", 3.0);
+    conf.addParameter<double>("ClusterThreshold", 5.0);
+    conf.addParameter<unsigned>("MaxSequentialHoles", 0);
+    conf.addParameter<unsigned>("MaxSequentialBad", 1);
+    conf.addParameter<unsigned>("MaxAdjacentBad", 0);
+    conf.addParameter<std::string>("QualityLabel", "");
+    conf.addParameter<bool>("RemoveApvShots", true);
+    conf.addParameter<edm::ParameterSet>("clusterChargeCut", chargeCut);
+    return StripClusterizerAlgorithmFactory::create(conf);
+  }
+
+  void makeSyntheticFixture(ClusterizerFixture& fixture) {
+    std::mt19937 engine(12345);
+    std::uniform_int_distribution<int> adc(0,255);
+    std::uniform_int_distribution<int> gap(1,40);
+    fixture.modules.resize(200);
+    for(unsigned int i=0; i<fixture.modules.size(); ++i) {
+      auto& module = fixture.modules[i];
+      module.detId = 369120000+i;
+      module.noises.assign(512, 4.f);
+      module.gains.assign(4, 1.f);
+      if(i%10==0) module.badStrips.push_back(SiStripBadStrip().encode(100, 3));
+    }
+    fixture.events.resize(20);
+    for(auto& event : fixture.events) {
+      for(uint32_t i=0; i<fixture.modules.size(); ++i) {
+        ClusterizerFixture::ModuleDigis digis;
+        digis.module = i;
+        for(int strip=gap(engine); strip<512; strip+=gap(engine)) {
+          for(int width=0; width<3 && strip<512; ++width, ++strip) {
+            digis.strips.push_back(strip);
+            digis.adcs.push_back(adc(engine));
+          }
+        }
+        event.push_back(std::move(digis));
+      }
+    }
+  }
+
+  struct Result {
+    double seconds;
+    unsigned long long clusters, checksum;
+  };
+
+  Result run(const StripClusterizerAlgorithm& algorithm, const SiStripQuality& quality,
+             const ClusterizerFixture& fixture, unsigned int repetitions, int threads) {
+    // the module states are built once, as findDetId does once per module and event
+    std::vector<StripClusterizerAlgorithm::Det> dets(fixture.modules.size());
+    for(unsigned int i=0; i<dets.size(); ++i) {
+      auto const& module = fixture.modules[i];
+      auto& det = dets[i];
+      det.ind = 0;
+      det.detId = module.detId;
+      det.quality = &quality;
+      det.gainRange = SiStripApvGain::Range(module.gains.begin(), module.gains.end());
+      det.qualityRange = SiStripQuality::Range(module.badStrips.begin(), module.badStrips.end());
+      det.denseNoises = module.noises.data();
+    }
+
+    std::atomic<unsigned long long> clusters(0), checksum(0);
+    tbb::task_arena arena(threads);
+    auto start = std::chrono::steady_clock::now();
+    arena.execute([&] {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, fixture.events.size()*repetitions),
+        [&](const tbb::blocked_range<size_t>& range) {
+          std::vector<SiStripCluster> out;
+          unsigned long long n=0, sum=0;
+          for(size_t i=range.begin(); i!=range.end(); ++i) {
+            for(auto const& digis : fixture.events[i%fixture.events.size()]) {
+              out.clear();
+              StripClusterizerAlgorithm::State state(dets[digis.module]);
+              for(unsigned int j=0; j<digis.strips.size(); ++j)
+                algorithm.stripByStripAdd(state, digis.strips[j], digis.adcs[j], out);
+              algorithm.stripByStripEnd(state, out);
+              n += out.size();
+              for(auto const& cluster : out)
+                sum += cluster.firstStrip() + cluster.amplitudes().size();
+            }
+          }
+          clusters += n;
+          checksum += sum;
+        });
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count(), clusters, checksum};
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ClusterizerFixture fixture;
+  if(argc > 1) fixture.read(argv[1]);
+  else makeSyntheticFixture(fixture);
+  unsigned int repetitions = argc > 2 ? std::atoi(argv[2]) : 10;
+  std::vector<int> threads;
+  for(int i=3; i<argc; ++i) threads.push_back(std::atoi(argv[i]));
+  if(threads.empty()) threads = {1, 2, 4};
+  if(fixture.events.empty() || repetitions == 0) {
+    std::cerr << "nothing to run" << std::endl;
+    return 1;
+  }
+
+  unsigned long long digis = 0;
+  for(auto const& event : fixture.events)
+    for(auto const& module : event) digis += module.strips.size();
+  digis *= repetitions;
+
+  auto algorithm = makeAlgorithm();
+  SiStripQuality quality;
+
+  std::cout << fixture.events.size() << " events, " << fixture.modules.size() << " modules, "
+            << repetitions << " repetitions" << std::endl;
+  // warm up the caches and the allocator
+  Result reference = run(*algorithm, quality, fixture, 1, 1);
+  reference = run(*algorithm, quality, fixture, repetitions, 1);
+  bool consistent = true;
+  for(int n : threads) {
+    Result result = n == 1 ? reference : run(*algorithm, quality, fixture, repetitions, n);
+    std::cout << n << " threads: " << result.seconds << " s, "
+              << fixture.events.size()*repetitions/result.seconds << " events/s, "
+              << 1.e9*result.seconds/digis << " ns/digi, "
+              << result.clusters << " clusters, checksum " << result.checksum << std::endl;
+    if(result.clusters != reference.clusters || result.checksum != reference.checksum) {
+      std::cerr << "the clusters found with " << n << " threads differ from the ones found with 1" << std::endl;
+      consistent = false;
+    }
+  }
+  return consistent ? 0 : 1;
+}
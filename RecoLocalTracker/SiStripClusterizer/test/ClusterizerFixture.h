@@ -0,0 +1,119 @@
+#ifndef ClusterizerFixture_h
+#define ClusterizerFixture_h
+
+/*
+ * Recorded inputs of the strip clusterizer: the conditions of every module
+ * that had digis, written once, and the zero suppressed digis of each event.
+ * The file is a flat binary dump in the byte order of the machine that wrote
+ * it, meant to be replayed by the clusterizer benchmark and not to be kept.
+ *
+ *   "SSCF" version nModules
+ *     per module: detId nStrips noises[nStrips] gains[nStrips/128] nBad badStrips[nBad]
+ *   nEvents
+ *     per event:  nModules
+ *       per module: module index nDigis strips[nDigis] adcs[nDigis]
+ *
+ * The bad strips are kept in the SiStripBadStrip encoding.
+ */
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct ClusterizerFixture {
+
+  struct Module {
+    uint32_t detId=0;
+    std::vector<float> noises;
+    std::vector<float> gains;
+    std::vector<unsigned int> badStrips;
+  };
+
+  struct ModuleDigis {
+    uint32_t module=0;
+    std::vector<uint16_t> strips;
+    std::vector<uint8_t> adcs;
+  };
+
+  typedef std::vector<ModuleDigis> Event;
+
+  std::vector<Module> modules;
+  std::vector<Event> events;
+
+  static constexpr uint32_t version = 1;
+
+  void write(const std::string& fileName) const {
+    std::ofstream out(fileName.c_str(), std::ios::binary);
+    if(!out) throw cms::Exception("ClusterizerFixture") << "cannot open " << fileName << " for writing";
+    out.write("SSCF",4);
+    put(out, version);
+    put(out, uint32_t(modules.size()));
+    for(auto const& module : modules) {
+      put(out, module.detId);
+      put(out, uint32_t(module.noises.size()));
+      putArray(out, module.noises);
+      putArray(out, module.gains);
+      put(out, uint32_t(module.badStrips.size()));
+      putArray(out, module.badStrips);
+    }
+    put(out, uint32_t(events.size()));
+    for(auto const& event : events) {
+      put(out, uint32_t(event.size()));
+      for(auto const& digis : event) {
+	put(out, digis.module);
+	put(out, uint32_t(digis.strips.size()));
+	putArray(out, digis.strips);
+	putArray(out, digis.adcs);
+      }
+    }
+    if(!out) throw cms::Exception("ClusterizerFixture") << "error writing " << fileName;
+  }
+
+  void read(const std::string& fileName) {
+    std::ifstream in(fileName.c_str(), std::ios::binary);
+    if(!in) throw cms::Exception("ClusterizerFixture") << "cannot open " << fileName;
+    char magic[4] = {0,0,0,0};
+    in.read(magic,4);
+    if(std::string(magic,4) != "SSCF" || get(in) != version)
+      throw cms::Exception("ClusterizerFixture") << fileName << " is not a clusterizer fixture of version " << version;
+    modules.resize(get(in));
+    for(auto& module : modules) {
+      module.detId = get(in);
+      uint32_t nStrips = get(in);
+      getArray(in, module.noises, nStrips);
+      getArray(in, module.gains, nStrips/128);
+      getArray(in, module.badStrips, get(in));
+    }
+    events.resize(get(in));
+    for(auto& event : events) {
+      event.resize(get(in));
+      for(auto& digis : event) {
+	digis.module = get(in);
+	if(digis.module >= modules.size()) in.setstate(std::ios::failbit);
+	uint32_t nDigis = get(in);
+	getArray(in, digis.strips, nDigis);
+	getArray(in, digis.adcs, nDigis);
+      }
+      if(!in) break;
+    }
+    if(!in) throw cms::Exception("ClusterizerFixture") << fileName << " is truncated or corrupted";
+  }
+
+private:
+  static void put(std::ostream& out, uint32_t value) { out.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+  template<class T> static void putArray(std::ostream& out, const std::vector<T>& v) {
+    out.write(reinterpret_cast<const char*>(v.data()), v.size()*sizeof(T));
+  }
+  static uint32_t get(std::istream& in) { uint32_t value=0; in.read(reinterpret_cast<char*>(&value), sizeof(value)); return value; }
+  template<class T> static void getArray(std::istream& in, std::vector<T>& v, uint32_t size) {
+    // a corrupted size must not turn into a huge allocation
+    if(!in || size > (1u<<24)) { in.setstate(std::ios::failbit); return; }
+    v.resize(size);
+    in.read(reinterpret_cast<char*>(v.data()), size*sizeof(T));
+  }
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "RecoLocalTracker/SiStripClusterizer/test/ClusterizerFixtureWriter.h"
+
+#include "CalibFormats/SiStripObjects/interface/SiStripGain.h"
+#include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+#include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
+#include "CondFormats/DataRecord/interface/SiStripNoisesRcd.h"
+#include "CalibTracker/Records/interface/SiStripGainRcd.h"
+#include "CalibTracker/Records/interface/SiStripQualityRcd.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+ClusterizerFixtureWriter::
+ClusterizerFixtureWriter(const edm::ParameterSet& conf)
+  : digisToken( consumes<edm::DetSetVector<SiStripDigi> >(conf.getParameter<edm::InputTag>("Digis"))),
+    qualityLabel( conf.getParameter<std::string>("QualityLabel")),
+    fileName( conf.getParameter<std::string>("FileName")),
+    noiseCacheId(0), gainCacheId(0), qualityCacheId(0)
+{}
+
+void ClusterizerFixtureWriter::
+analyze(const edm::Event& event, const edm::EventSetup& es) {
+  uint32_t n = es.get<SiStripNoisesRcd>().cacheIdentifier();
+  uint32_t g = es.get<SiStripGainRcd>().cacheIdentifier();
+  uint32_t q = es.get<SiStripQualityRcd>().cacheIdentifier();
+  if( !fixture.events.empty() && (n != noiseCacheId || g != gainCacheId || q != qualityCacheId) )
+    throw cms::Exception("ClusterizerFixtureWriter") << "the strip conditions changed in the job, a fixture holds a single set of them";
+  noiseCacheId = n;  gainCacheId = g;  qualityCacheId = q;
+
+  edm::ESHandle<SiStripNoises> noiseHandle;    es.get<SiStripNoisesRcd>().get(noiseHandle);
+  edm::ESHandle<SiStripGain> gainHandle;       es.get<SiStripGainRcd>().get(gainHandle);
+  edm::ESHandle<SiStripQuality> qualityHandle; es.get<SiStripQualityRcd>().get(qualityLabel, qualityHandle);
+
+  edm::Handle<edm::DetSetVector<SiStripDigi> > digis;
+  event.getByToken(digisToken, digis);
+
+  fixture.events.emplace_back();
+  auto& fixtureEvent = fixture.events.back();
+  for(auto const& detSet : *digis) {
+    if(detSet.empty()) continue;
+    auto inserted = moduleIndex.insert(std::make_pair(detSet.detId(), uint32_t(fixture.modules.size())));
+    if( inserted.second ) {
+      ClusterizerFixture::Module module;
+      module.detId = detSet.detId();
+      SiStripApvGain::Range gainRange = gainHandle->getRange(module.detId);
+      module.gains.assign(gainRange.first, gainRange.second);
+      SiStripNoises::Range noiseRange = noiseHandle->getRange(module.detId);
+      for(uint16_t strip=0; strip < 128*module.gains.size(); ++strip)
+	module.noises.push_back(SiStripNoises::getNoise(strip, noiseRange));
+      SiStripQuality::Range qualityRange = qualityHandle->getRange(module.detId);
+      module.badStrips.assign(qualityRange.first, qualityRange.second);
+      fixture.modules.push_back(std::move(module));
+    }
+    ClusterizerFixture::ModuleDigis moduleDigis;
+    moduleDigis.module = inserted.first->second;
+    for(auto const& digi : detSet) {
+      moduleDigis.strips.push_back(digi.strip());
+      moduleDigis.adcs.push_back(digi.adc());
+    }
+    fixtureEvent.push_back(std::move(moduleDigis));
+  }
+}
+
+void ClusterizerFixtureWriter::
+endJob() {
+  fixture.write(fileName);
+  edm::LogInfo("ClusterizerFixtureWriter") << "wrote " << fixture.events.size() << " events and "
+					   << fixture.modules.size() << " modules to " << fileName;
+}
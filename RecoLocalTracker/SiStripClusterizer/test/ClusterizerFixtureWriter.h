@@ -0,0 +1,37 @@
+#ifndef ClusterizerFixtureWriter_h
+#define ClusterizerFixtureWriter_h
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/Common/interface/DetSetVector.h"
+#include "DataFormats/SiStripDigi/interface/SiStripDigi.h"
+#include "RecoLocalTracker/SiStripClusterizer/test/ClusterizerFixture.h"
+
+#include <map>
+#include <string>
+
+// Records the digis of the events and the conditions of their modules into
+// a ClusterizerFixture file, written at the end of the job.
+class ClusterizerFixtureWriter : public edm::EDAnalyzer {
+
+ public:
+
+  ClusterizerFixtureWriter(const edm::ParameterSet& conf);
+
+ private:
+
+  void analyze(const edm::Event&, const edm::EventSetup&);
+  void endJob();
+
+  edm::EDGetTokenT<edm::DetSetVector<SiStripDigi> > digisToken;
+  const std::string qualityLabel;
+  const std::string fileName;
+
+  ClusterizerFixture fixture;
+  uint32_t noiseCacheId, gainCacheId, qualityCacheId;
+  std::map<uint32_t,uint32_t> moduleIndex;
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include "RecoLocalTracker/SiStripClusterizer/test/StripByStripTestDriver.h"
 #include "RecoLocalTracker/SiStripClusterizer/test/ClusterizerUnitTesterESProducer.h"
 #include "RecoLocalTracker/SiStripClusterizer/test/ClusterRefinerTagMCmerged.h"
+#include "RecoLocalTracker/SiStripClusterizer/test/ClusterizerFixtureWriter.h"
 
 
 DEFINE_FWK_MODULE(CompareClusters);
@@ -16,3 +17,4 @@ DEFINE_FWK_MODULE(ClusterizerUnitTester);
 DEFINE_FWK_MODULE(StripByStripTestDriver);
 DEFINE_FWK_EVENTSETUP_MODULE(ClusterizerUnitTesterESProducer);
 DEFINE_FWK_MODULE(ClusterRefinerTagMCmerged);
+DEFINE_FWK_MODULE(ClusterizerFixtureWriter);
@@ -0,0 +1,25 @@
+# Records the zero suppressed strip digis of a few events, with the conditions
+# of their modules, into clusterizer.fixture for the ClusterizerBenchmark:
+#   cmsRun writeClusterizerFixture_cfg.py
+#   ClusterizerBenchmark clusterizer.fixture 10 1 2 4 8
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process('FIXTURE')
+
+process.source = cms.Source ( "PoolSource",
+                              fileNames = cms.untracked.vstring("/store/data/Run2011B/MinimumBias/RAW-RECO/ValSkim-PromptSkim-v1/0000/00A7606D-22F9-E011-8437-001A92971BDC.root")
+                              )
+process.maxEvents = cms.untracked.PSet( input = cms.untracked.int32(100) )
+
+process.load('Configuration/StandardSequences/GeometryIdeal_cff')
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+process.load("Configuration/StandardSequences/RawToDigi_Data_cff")
+process.GlobalTag.globaltag = 'GR_R_44_V14::All'
+
+process.clusterizerFixture = cms.EDAnalyzer("ClusterizerFixtureWriter",
+                                            Digis = cms.InputTag('siStripDigis','ZeroSuppressed'),
+                                            QualityLabel = cms.string(''),
+                                            FileName = cms.string('clusterizer.fixture')
+                                            )
+
+process.p = cms.Path(process.siStripDigis*process.clusterizerFixture)
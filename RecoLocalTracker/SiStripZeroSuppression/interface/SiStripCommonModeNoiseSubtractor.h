@@ -23,6 +23,7 @@ class SiStripCommonModeNoiseSubtractor {
 
   SiStripCommonModeNoiseSubtractor(){};
   template<typename T> float median(std::vector<T>&);
+  template<typename T> static void subtractAPV(T* apv, float offset);
 
   std::vector< std::pair<short,float> > _vmedians;
 };
@@ -40,5 +41,14 @@ median( std::vector<T>& sample) {
     return *mid;
   return ( *std::max_element(sample.begin(), mid) + *mid ) / 2.;
 }
+
+// a fixed trip count over the contiguous strips of one APV, which the compiler vectorises
+template<typename T>
+inline
+void SiStripCommonModeNoiseSubtractor::
+subtractAPV( T* apv, float offset) {
+  for (int i=0; i!=128; ++i)
+    apv[i] = static_cast<T>(apv[i]-offset);
+}
   
 #endif
@@ -4,6 +4,7 @@
 #include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
 #include "CondFormats/DataRecord/interface/SiStripNoisesRcd.h"
 #include "CalibTracker/Records/interface/SiStripQualityRcd.h"
+#include <algorithm>
 #include <cmath>
 
 void IteratedMedianCMNSubtractor::init(const edm::EventSetup& es){
@@ -31,7 +32,6 @@ subtract_(const uint32_t& detId, const uint16_t& firstAPV, std::vector<T>& digis
   SiStripNoises::Range detNoiseRange = noiseHandle->getRange(detId);
   SiStripQuality::Range detQualityRange = qualityHandle->getRange(detId);
 
-  typename std::vector<T>::iterator fs,ls;
   float offset = 0;  
   std::vector< std::pair<float,float> > subset;
   subset.reserve(128);
@@ -60,14 +60,9 @@ subtract_(const uint32_t& detId, const uint16_t& firstAPV, std::vector<T>& digis
     // and recalculate offset on remaining strips
     for ( int ii = 0; ii<iterations_-1; ++ii )
     {
-      std::vector< std::pair<float,float> >::iterator si = subset.begin();
-      while(  si != subset.end() )
-      {
-        if( si->first-offset > cut_to_avoid_signal_*si->second )  
-          si = subset.erase(si);
-        else
-          ++si;
-      }
+      subset.erase( std::remove_if( subset.begin(), subset.end(),
+                                    [&](const std::pair<float,float>& si) { return si.first-offset > cut_to_avoid_signal_*si.second; } ),
+                    subset.end() );
       if ( subset.size() == 0 ) break;
       offset = pairMedian(subset);
     }        
@@ -75,12 +70,7 @@ subtract_(const uint32_t& detId, const uint16_t& firstAPV, std::vector<T>& digis
     _vmedians.push_back(std::pair<short,float>(APV,offset));
     
     // remove offset
-    fs = digis.begin()+(APV-firstAPV)*128;
-    ls = digis.begin()+(APV-firstAPV+1)*128;
-    while (fs < ls) {
-      *fs = static_cast<T>(*fs-offset);
-      fs++;
-    }
+    subtractAPV(&digis[(APV-firstAPV)*128], offset);
 
   }
 }
@@ -23,10 +23,8 @@ subtract_(const uint32_t& detId,const uint16_t& firstAPV, std::vector<T>& digis)
 
     _vmedians.push_back(std::pair<short,float>((strip-digis.begin())/128+firstAPV,offset));
 
-    while (strip < endAPV) {
-      *strip = static_cast<T>(*strip-offset);
-      strip++;
-    }
+    subtractAPV(&*strip, offset);
+    strip = endAPV;
 
   }
 }
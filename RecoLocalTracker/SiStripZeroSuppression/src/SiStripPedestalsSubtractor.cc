@@ -2,6 +2,7 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "CondFormats/DataRecord/interface/SiStripPedestalsRcd.h"
 #include "FWCore/Utilities/interface/Exception.h"
+#include <algorithm>
 
 void SiStripPedestalsSubtractor::init(const edm::EventSetup& es){
   uint32_t p_cache_id = es.get<SiStripPedestalsRcd>().cacheIdentifier();
@@ -25,23 +26,17 @@ subtract_(const uint32_t& id, const uint16_t& firstStrip, const input_t& input,
     pedestalsHandle->allPeds(pedestals, pedestalsRange);
 
     typename input_t::const_iterator inDigi = input.begin();
-    std::vector<int>::const_iterator ped = pedestals.begin() + firstStrip;  
-    std::vector<int16_t>::iterator   outDigi = output.begin();
-
-    while( inDigi != input.end() ) {
-      
-      *outDigi = ( *ped > 895 )        
-	? eval(*inDigi) - *ped + 1024
-	: eval(*inDigi) - *ped;
-      
-      if(fedmode_ && *outDigi < 0) //FED bottoms out at 0
-	*outDigi=0;
-      
-      ++inDigi; 
-      ++ped; 
-      ++outDigi;
-    }
+    const int* ped = pedestals.data() + firstStrip;
+    int16_t* outDigi = output.data();
+    const int n = input.size();
 
+    // branch-free, so that the loops over the strips vectorise
+    for (int i=0; i!=n; ++i, ++inDigi)
+      outDigi[i] = eval(*inDigi) - ped[i] + ( ped[i] > 895 ? 1024 : 0 );
+
+    if(fedmode_) //FED bottoms out at 0
+      for (int i=0; i!=n; ++i)
+	outDigi[i] = std::max<int16_t>(outDigi[i], 0);
 
   } catch(cms::Exception& e){
     edm::LogError("SiStripPedestalsSubtractor")  
@@ -0,0 +1,95 @@
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+
+#include "DataFormats/Common/interface/DetSetVectorNew.h"
+#include "DataFormats/Common/interface/ContainerMask.h"
+
+#include <memory>
+#include <vector>
+
+/*
+ * Merges the cluster masks of tracking steps that start from the same mask
+ * and do not depend on each other: a cluster is masked if any of the steps
+ * masks it.  The steps can then run concurrently, and the following step
+ * starts from the merged mask instead of being chained behind each of them.
+ */
+
+namespace {
+
+  class ClusterMaskMerger final : public edm::global::EDProducer<> {
+  public:
+    ClusterMaskMerger(const edm::ParameterSet& iConfig) ;
+    ~ClusterMaskMerger(){}
+    static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+  private:
+
+    virtual void produce(edm::StreamID, edm::Event& evt, const edm::EventSetup&) const override;
+
+    using PixelMaskContainer    = edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster>>;
+    using StripMaskContainer    = edm::ContainerMask<edmNew::DetSetVector<SiStripCluster>>;
+
+    template<typename T>
+    static void merge(edm::Event& iEvent, const std::vector<edm::EDGetTokenT<T>> & tokens);
+
+    std::vector<edm::EDGetTokenT<PixelMaskContainer>> pxlMaskTokens_;
+    std::vector<edm::EDGetTokenT<StripMaskContainer>> strMaskTokens_;
+  };
+
+  void ClusterMaskMerger::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<std::vector<edm::InputTag>>("clusterRemovalInfos",std::vector<edm::InputTag>());
+    descriptions.add("clusterMaskMerger", desc);
+  }
+
+  ClusterMaskMerger::ClusterMaskMerger(const edm::ParameterSet& iConfig)
+  {
+    auto const & infos = iConfig.getParameter<std::vector<edm::InputTag>>("clusterRemovalInfos");
+    if (infos.empty())
+      throw cms::Exception("Configuration") << "ClusterMaskMerger: no cluster masks to merge\n";
+    for (auto const & info : infos) {
+      pxlMaskTokens_.push_back(consumes<PixelMaskContainer>(info));
+      strMaskTokens_.push_back(consumes<StripMaskContainer>(info));
+    }
+
+    produces<PixelMaskContainer>();
+    produces<StripMaskContainer>();
+  }
+
+  template<typename T>
+  void ClusterMaskMerger::merge(edm::Event& iEvent, const std::vector<edm::EDGetTokenT<T>> & tokens) {
+    edm::Handle<T> first;
+    iEvent.getByToken(tokens.front(), first);
+    std::vector<bool> collected;
+    first->copyMaskTo(collected);
+    for (auto it = tokens.begin()+1; it != tokens.end(); ++it) {
+      edm::Handle<T> mask;
+      iEvent.getByToken(*it, mask);
+      if (mask->refProd().id() != first->refProd().id())
+        throw cms::Exception("Configuration") << "ClusterMaskMerger: the cluster masks do not point to the same collection of clusters: "
+                                              << mask->refProd().id() << "!=" << first->refProd().id() << "\n";
+      mask->applyOrTo(collected);
+    }
+    iEvent.put(std::make_unique<T>(first->refProd(), collected));
+  }
+
+  void
+  ClusterMaskMerger::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup&) const
+  {
+    merge(iEvent, pxlMaskTokens_);
+    merge(iEvent, strMaskTokens_);
+  }
+
+}
+
+
+#include "FWCore/PluginManager/interface/ModuleDef.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(ClusterMaskMerger);
@@ -61,6 +61,7 @@ from the configuration file, the DB is not implemented yet)
 #include <vector>
 #include <cstring>
 #include <iterator>
+#include <limits>
 #include <boost/foreach.hpp>
 #include <boost/tokenizer.hpp>
 #include <xercesc/dom/DOM.hpp>
@@ -139,6 +140,7 @@ private:
   bool fillLumi(edm::LuminosityBlock & iLBlock);
   void fillRunCache(const coral::ISchema& schema,unsigned int runnumber);
   void fillLSCache(unsigned int luminum);
+  PerLSData& lsCacheEntry(unsigned int luminum);
   void writeProductsForEntry(edm::LuminosityBlock & iLBlock,unsigned int runnumber,unsigned int luminum);
   const std::string servletTranslation(const std::string& servlet) const;
   std::string x2s(const XMLCh* input)const;
@@ -159,6 +161,9 @@ private:
   std::map< unsigned int,PerLSData > m_lscache;
   bool m_isNullRun;
   unsigned int m_cachesize;
+  bool m_cachewholerun;
+  //with cacheWholeRun, the first LS from which the rest of the run is in the cache, 0 if not loaded
+  unsigned int m_wholerunfirstls;
 };
 
 //
@@ -243,7 +248,7 @@ LumiProducer::servletTranslation(const std::string& servlet) const{
 }
 
 LumiProducer::
-LumiProducer::LumiProducer(const edm::ParameterSet& iConfig):m_cachedrun(0),m_isNullRun(false),m_cachesize(0)
+LumiProducer::LumiProducer(const edm::ParameterSet& iConfig):m_cachedrun(0),m_isNullRun(false),m_cachesize(0),m_cachewholerun(false),m_wholerunfirstls(0)
 {
   // register your products
   produces<LumiSummaryRunHeader, edm::InRun>();
@@ -252,6 +257,8 @@ LumiProducer::LumiProducer(const edm::ParameterSet& iConfig):m_cachedrun(0),m_is
   // set up cache
   std::string connectStr=iConfig.getParameter<std::string>("connect");
   m_cachesize=iConfig.getUntrackedParameter<unsigned int>("ncacheEntries",5);
+  //load all the remaining LS of the run at once instead of ncacheEntries of them, about 130kB per LS
+  m_cachewholerun=iConfig.getUntrackedParameter<bool>("cacheWholeRun",false);
   m_lumiversion=iConfig.getUntrackedParameter<std::string>("lumiversion","");
   const std::string fproto("frontier://");
   //test if need frontier servlet site-local translation  
@@ -416,6 +423,9 @@ LumiProducer::beginRun(edm::Run const& run,edm::EventSetup const &iSetup)
   if(m_cachedrun!=runnumber){
     //queries once per run
     m_cachedrun=runnumber;
+    //the cache is indexed by LS only
+    m_lscache.clear();
+    m_wholerunfirstls=0;
     edm::Service<lumi::service::DBService> mydbservice;
     if( !mydbservice.isAvailable() ){
       throw cms::Exception("Non existing service lumi::service::DBService");
@@ -550,17 +560,22 @@ void
 LumiProducer::fillLSCache(unsigned int luminum){
   //initialize cache
   if(m_isNullRun) return;
+  //the rest of the run is already loaded, this LS has no data
+  if(m_wholerunfirstls!=0 && luminum>=m_wholerunfirstls){
+    lsCacheEntry(luminum);
+    return;
+  }
   m_lscache.clear();
-  for(unsigned int n=luminum;n<luminum+m_cachesize;++n){
-    PerLSData l;
-    l.hltdata.reserve(250);
-    l.l1data.reserve(192);
-    l.bunchlumivalue.reserve(5);
-    l.bunchlumierror.reserve(5);
-    l.bunchlumiquality.reserve(5);
-    l.beam1intensity.resize(3564,0.0);
-    l.beam2intensity.resize(3564,0.0);
-    m_lscache.insert(std::make_pair(n,l));
+  //the LS queried: the next m_cachesize ones or, with cacheWholeRun, all the following ones
+  //of the run with one round-trip per table, their entries being made as they come
+  unsigned int lsmax=m_cachewholerun ? std::numeric_limits<unsigned int>::max() : luminum+m_cachesize;
+  if(!m_cachewholerun){
+    for(unsigned int n=luminum;n<lsmax;++n){
+      lsCacheEntry(n);
+    }
+  }else{
+    //the LS asked for is there even without data
+    lsCacheEntry(luminum);
   }
   //queries once per cache refill
   //
@@ -580,7 +595,7 @@ LumiProducer::fillLSCache(unsigned int luminum){
     lumisummaryBindVariables.extend("lumidataid",typeid(unsigned long long));
     lumisummaryBindVariables["lumidataid"].data<unsigned long long>()=m_cachedlumidataid;
     lumisummaryBindVariables["lsmin"].data<unsigned int>()=luminum;
-    lumisummaryBindVariables["lsmax"].data<unsigned int>()=luminum+m_cachesize;
+    lumisummaryBindVariables["lsmax"].data<unsigned int>()=lsmax;
     coral::AttributeList lumisummaryOutput;
     lumisummaryOutput.extend("CMSLSNUM",typeid(unsigned int));
     lumisummaryOutput.extend("INSTLUMI",typeid(float));
@@ -608,11 +623,13 @@ LumiProducer::fillLSCache(unsigned int luminum){
     lumisummaryQuery->defineOutput(lumisummaryOutput);
     coral::ICursor& lumisummarycursor=lumisummaryQuery->execute();
     unsigned int rowcounter=0;
+    unsigned int lastls=luminum;
     while( lumisummarycursor.next() ){
       const coral::AttributeList& row=lumisummarycursor.currentRow();
       unsigned int cmslsnum=row["CMSLSNUM"].data<unsigned int>();
+      lastls=std::max(lastls,cmslsnum);
       //std::cout<<"cmslsnum "<<cmslsnum<<std::endl;
-      PerLSData& lsdata=m_lscache[cmslsnum];
+      PerLSData& lsdata=lsCacheEntry(cmslsnum);
       lsdata.lumivalue=row["INSTLUMI"].data<float>();
       lsdata.lumierror=0.0;
       lsdata.lumiquality=0;
@@ -687,6 +704,12 @@ LumiProducer::fillLSCache(unsigned int luminum){
       return;
     }
     delete lumisummaryQuery;
+    //as with the fixed size cache, the LS without data up to the last one are cached empty
+    if(m_cachewholerun){
+      for(unsigned int n=luminum;n<lastls;++n){
+	lsCacheEntry(n);
+      }
+    }
     
     //
     //select cmslsnum,deadtimecount,bitzerocount,bitzeroprescale,prescaleblob,trgcountblob from lstrg where cmslsnum >=:luminum and cmslsnum<:luminum+cachesize AND data_id=:trgdataid;
@@ -696,7 +719,7 @@ LumiProducer::fillLSCache(unsigned int luminum){
     trgBindVariables.extend("lsmax",typeid(unsigned int));
     trgBindVariables.extend("trgdataid",typeid(unsigned long long));
     trgBindVariables["lsmin"].data<unsigned int>()=luminum;
-    trgBindVariables["lsmax"].data<unsigned int>()=luminum+m_cachesize;
+    trgBindVariables["lsmax"].data<unsigned int>()=lsmax;
     trgBindVariables["trgdataid"].data<unsigned long long>()=m_cachedtrgdataid;
     coral::AttributeList trgOutput;
     trgOutput.extend("CMSLSNUM",typeid(unsigned int));
@@ -720,7 +743,7 @@ LumiProducer::fillLSCache(unsigned int luminum){
     while( trgcursor.next() ){
       const coral::AttributeList& row=trgcursor.currentRow();
       unsigned int cmslsnum=row["CMSLSNUM"].data<unsigned int>();
-      PerLSData& lsdata=m_lscache[cmslsnum];
+      PerLSData& lsdata=lsCacheEntry(cmslsnum);
       lsdata.deadcount=row["DEADTIMECOUNT"].data<unsigned long long>();
       lsdata.bitzerocount=row["BITZEROCOUNT"].data<unsigned int>();
       lsdata.bitzeroprescale=row["BITZEROPRESCALE"].data<unsigned int>();
@@ -753,7 +776,7 @@ LumiProducer::fillLSCache(unsigned int luminum){
     hltBindVariables.extend("lsmax",typeid(unsigned int));
     hltBindVariables.extend("hltdataid",typeid(unsigned long long));
     hltBindVariables["lsmin"].data<unsigned int>()=luminum;
-    hltBindVariables["lsmax"].data<unsigned int>()=luminum+m_cachesize;
+    hltBindVariables["lsmax"].data<unsigned int>()=lsmax;
     hltBindVariables["hltdataid"].data<unsigned long long>()=m_cachedhltdataid;
     coral::AttributeList hltOutput;
     hltOutput.extend("CMSLSNUM",typeid(unsigned int));
@@ -772,7 +795,7 @@ LumiProducer::fillLSCache(unsigned int luminum){
     while( hltcursor.next() ){
       const coral::AttributeList& row=hltcursor.currentRow();   
       unsigned int cmslsnum=row["CMSLSNUM"].data<unsigned int>();
-      PerLSData& lsdata=m_lscache[cmslsnum];
+      PerLSData& lsdata=lsCacheEntry(cmslsnum);
       if(!row["PRESCALEBLOB"].isNull()){
 	const coral::Blob& hltprescaleblob=row["PRESCALEBLOB"].data<coral::Blob>();
 	const void* hltprescaleblob_StartAddress=hltprescaleblob.startingAddress();
@@ -808,6 +831,7 @@ LumiProducer::fillLSCache(unsigned int luminum){
     }
     delete hltQuery;
     session->transaction().commit();
+    if(m_cachewholerun) m_wholerunfirstls=luminum;
   }catch(const coral::Exception& er){
     session->transaction().rollback();
     mydbservice->disconnect(session);
@@ -815,6 +839,22 @@ LumiProducer::fillLSCache(unsigned int luminum){
   }
   mydbservice->disconnect(session);
 }
+LumiProducer::PerLSData&
+LumiProducer::lsCacheEntry(unsigned int luminum){
+  std::map< unsigned int,PerLSData >::iterator it=m_lscache.lower_bound(luminum);
+  if(it==m_lscache.end() || it->first!=luminum){
+    PerLSData l;
+    l.hltdata.reserve(250);
+    l.l1data.reserve(192);
+    l.bunchlumivalue.reserve(5);
+    l.bunchlumierror.reserve(5);
+    l.bunchlumiquality.reserve(5);
+    l.beam1intensity.resize(3564,0.0);
+    l.beam2intensity.resize(3564,0.0);
+    it=m_lscache.insert(it,std::make_pair(luminum,l));
+  }
+  return it->second;
+}
 void
 LumiProducer::writeProductsForEntry(edm::LuminosityBlock & iLBlock,unsigned int runnumber,unsigned int luminum){
   //std::cout<<"writing runnumber,luminum "<<runnumber<<" "<<luminum<<std::endl;
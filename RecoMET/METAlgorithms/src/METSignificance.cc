@@ -16,6 +16,22 @@ Implementation:
 
 #include "RecoMET/METAlgorithms/interface/METSignificance.h"
 
+#include <functional>
+#include <unordered_set>
+
+namespace {
+  // the footprint is matched to the candidates by their four-momentum
+  struct HashP4 {
+    size_t operator()(const reco::Candidate::LorentzVector& p4) const {
+      std::hash<double> h;
+      size_t seed = h(p4.px());
+      seed ^= h(p4.py()) + 0x9e3779b9 + (seed<<6) + (seed>>2);
+      seed ^= h(p4.pz()) + 0x9e3779b9 + (seed<<6) + (seed>>2);
+      seed ^= h(p4.energy()) + 0x9e3779b9 + (seed<<6) + (seed>>2);
+      return seed;
+    }
+  };
+}
 
 metsig::METSignificance::METSignificance(const edm::ParameterSet& iConfig) {
 
@@ -66,11 +82,17 @@ metsig::METSignificance::getCovariance(const edm::View<reco::Jet>& jets,
          }
       }
    }
+   // disambiguate jets and leptons
+   std::vector<bool> cleanJets;
+   cleanJets.reserve(jets.size());
+   for(edm::View<reco::Jet>::const_iterator jet = jets.begin(); jet != jets.end(); ++jet) {
+      cleanJets.push_back(cleanJet(*jet, leptons));
+   }
+
    // subtract jets out of sumPt
    for(edm::View<reco::Jet>::const_iterator jet = jets.begin(); jet != jets.end(); ++jet) {
 
-      // disambiguate jets and leptons
-      if(!cleanJet(*jet, leptons) ) continue;
+      if(!cleanJets[jet - jets.begin()] ) continue;
 
       for( unsigned int n=0; n < jet->numberOfSourceCandidatePtrs(); n++){
          if( jet->sourceCandidatePtr(n).isNonnull() and jet->sourceCandidatePtr(n).isAvailable() ){
@@ -80,18 +102,19 @@ metsig::METSignificance::getCovariance(const edm::View<reco::Jet>& jets,
 
    }
 
+   std::unordered_set<reco::Candidate::LorentzVector, HashP4> footprintP4s;
+   footprintP4s.reserve(footprint.size());
+   for(unsigned int i=0; i < footprint.size(); i++){
+      footprintP4s.insert(footprint[i]->p4());
+   }
+
    // calculate sumPt
    double sumPt = 0;
    for( edm::View<reco::Candidate>::const_iterator cand = pfCandidates.begin();
          cand != pfCandidates.end(); ++cand){
 
       // check if candidate exists in a lepton or jet
-      bool cleancand = true;
-      for(unsigned int i=0; i < footprint.size(); i++){
-         if( footprint[i]->p4() == cand->p4() ){
-            cleancand = false;
-         }
-      }
+      bool cleancand = footprintP4s.find(cand->p4()) == footprintP4s.end();
       // if not, add to sumPt
       if( cleancand ){
          sumPt += cand->pt();
@@ -103,7 +126,7 @@ metsig::METSignificance::getCovariance(const edm::View<reco::Jet>& jets,
    for(edm::View<reco::Jet>::const_iterator jet = jets.begin(); jet != jets.end(); ++jet) {
      
      // disambiguate jets and leptons
-     if(!cleanJet(*jet, leptons) ) continue;
+     if(!cleanJets[jet - jets.begin()] ) continue;
 
       double jpt  = jet->pt();
       double jeta = jet->eta();
@@ -33,6 +33,11 @@
 
 #include "RecoMuon/MuonIdentification/interface/MuonKinkFinder.h"
 
+#include "Geometry/Records/interface/GlobalTrackingGeometryRecord.h"
+#include "Geometry/CommonDetUnit/interface/GlobalTrackingGeometry.h"
+
+#include <algorithm>
+
 MuonIdProducer::MuonIdProducer(const edm::ParameterSet& iConfig):
 muIsoExtractorCalo_(0),muIsoExtractorTrack_(0),muIsoExtractorJet_(0)
 {
@@ -75,6 +80,15 @@ muIsoExtractorCalo_(0),muIsoExtractorTrack_(0),muIsoExtractorJet_(0)
    edm::ParameterSet parameters = iConfig.getParameter<edm::ParameterSet>("TrackAssociatorParameters");
    edm::ConsumesCollector iC = consumesCollector();
    parameters_.loadParameters( parameters, iC );
+   parametersNoMuon_ = parameters_;
+   parametersNoMuon_.useMuon = false;
+
+   coarseMuonMatching_      = iConfig.getParameter<bool>("coarseMuonMatching");
+   coarseMaxDEta_           = iConfig.getParameter<double>("coarseMaxDEta");
+   coarseMaxDPhi_           = iConfig.getParameter<double>("coarseMaxDPhi");
+   coarseDPhiTimesPt_       = iConfig.getParameter<double>("coarseDPhiTimesPt");
+   // the coarse matching does not look at the GEM and ME0 segments
+   if (parameters_.useGEM || parameters_.useME0) coarseMuonMatching_ = false;
 
    // Load parameters for the TimingFiller
    edm::ParameterSet timingParameters = iConfig.getParameter<edm::ParameterSet>("TimingFillerParameters");
@@ -453,6 +467,7 @@ void MuonIdProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
    std::auto_ptr<reco::CaloMuonCollection> caloMuons( new reco::CaloMuonCollection );
 
    init(iEvent, iSetup);
+   if ( coarseMuonMatching_ ) fillMuonHitDirections(iEvent, iSetup);
 
    // loop over input collections
 
@@ -539,10 +554,17 @@ void MuonIdProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
        if ( track.extra().isAvailable() &&
             TrackDetectorAssociator::crossedIP( track ) ) splitTrack = true;
        const auto& directions = splitTrack ? directions1 : directions2;
+       // a track without muon hits around it is only associated with the
+       // calorimeters, unless one of the muons already made uses it
+       const TrackAssociatorParameters* parameters = &parameters_;
+       if ( coarseMuonMatching_ && ! splitTrack && ! hasMuonHitsInCone( track ) &&
+            std::none_of( outputMuons->begin(), outputMuons->end(),
+                          [&track](const reco::Muon& muon) { return muon.innerTrack().get() == &track; } ) )
+         parameters = &parametersNoMuon_;
        for ( const auto direction : directions ) {
          // make muon
          reco::Muon trackerMuon( makeMuon(iEvent, iSetup, trackRef, reco::Muon::InnerTrack) );
-         fillMuonId(iEvent, iSetup, trackerMuon, direction);
+         fillMuonId(iEvent, iSetup, trackerMuon, direction, *parameters);
 
          if ( debugWithTruthMatching_ ) {
            // add MC hits to a list of matched segments.
@@ -778,6 +800,14 @@ void MuonIdProducer::fillMuonId(edm::Event& iEvent, const edm::EventSetup& iSetu
 				reco::Muon& aMuon,
 				TrackDetectorAssociator::Direction direction)
 {
+   fillMuonId(iEvent, iSetup, aMuon, direction, parameters_);
+}
+
+void MuonIdProducer::fillMuonId(edm::Event& iEvent, const edm::EventSetup& iSetup,
+				reco::Muon& aMuon,
+				TrackDetectorAssociator::Direction direction,
+				const TrackAssociatorParameters& parameters)
+{
 
    LogTrace("MuonIdentification") << "RecoMuon/MuonIdProducer :: fillMuonId";
 
@@ -788,7 +818,7 @@ void MuonIdProducer::fillMuonId(edm::Event& iEvent, const edm::EventSetup& iSetu
    else throw cms::Exception("FatalError") << "Failed to fill muon id information for a muon with undefined references to tracks";
 
 
-   TrackDetMatchInfo info = trackAssociator_.associate(iEvent, iSetup, *track, parameters_, direction);
+   TrackDetMatchInfo info = trackAssociator_.associate(iEvent, iSetup, *track, parameters, direction);
 
    LogTrace("MuonIdentification") << "RecoMuon/MuonIdProducer :: fillMuonId :: fillEnergy = "<<fillEnergy_;
 
@@ -1253,6 +1283,50 @@ void MuonIdProducer::fillTrackerKink( reco::Muon& aMuon ) {
     if (filled || aMuon.isQualityValid()) aMuon.setCombinedQuality(quality);
 }
 
+void MuonIdProducer::fillMuonHitDirections(const edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+   muonHitDirections_.clear();
+
+   edm::ESHandle<GlobalTrackingGeometry> geometry;
+   iSetup.get<GlobalTrackingGeometryRecord>().get(geometry);
+   auto addHit = [&](const TrackingRecHit& hit) {
+     const GlobalPoint& position = geometry->idToDet(hit.geographicalId())->toGlobal(hit.localPosition());
+     muonHitDirections_.emplace_back(position.barePhi(), position.eta());
+   };
+
+   edm::Handle<DTRecSegment4DCollection> dtSegments;
+   iEvent.getByToken(parameters_.dtSegmentsToken, dtSegments);
+   if ( dtSegments.isValid() ) for ( const auto& segment : *dtSegments ) addHit(segment);
+   edm::Handle<CSCSegmentCollection> cscSegments;
+   iEvent.getByToken(parameters_.cscSegmentsToken, cscSegments);
+   if ( cscSegments.isValid() ) for ( const auto& segment : *cscSegments ) addHit(segment);
+   if ( rpcHitHandle_.isValid() ) for ( const auto& hit : *rpcHitHandle_ ) addHit(hit);
+
+   std::sort(muonHitDirections_.begin(), muonHitDirections_.end());
+   LogTrace("MuonIdentification") << "Number of muon hits for the coarse matching: " << muonHitDirections_.size();
+}
+
+bool MuonIdProducer::hasMuonHitsInCone(const reco::Track& track) const
+{
+   const float eta = track.eta();
+   auto inPhiRange = [&](float phiMin, float phiMax) {
+     auto hit = std::lower_bound(muonHitDirections_.begin(), muonHitDirections_.end(), phiMin,
+                                 [](const std::pair<float,float>& h, float phi) { return h.first < phi; });
+     for ( ; hit != muonHitDirections_.end() && hit->first <= phiMax; ++hit )
+       if ( std::abs(hit->second - eta) < coarseMaxDEta_ ) return true;
+     return false;
+   };
+
+   // the cone is wider at low pt, where the track bends more
+   const float maxDPhi = coarseMaxDPhi_ + coarseDPhiTimesPt_/track.pt();
+   const float phi = track.phi();
+   const float pi = M_PI;
+   if ( maxDPhi >= pi ) return inPhiRange(-pi, pi);
+   if ( phi - maxDPhi < -pi ) return inPhiRange(-pi, phi + maxDPhi) || inPhiRange(phi - maxDPhi + 2*pi, pi);
+   if ( phi + maxDPhi > pi ) return inPhiRange(phi - maxDPhi, pi) || inPhiRange(-pi, phi + maxDPhi - 2*pi);
+   return inPhiRange(phi - maxDPhi, phi + maxDPhi);
+}
+
 bool MuonIdProducer::checkLinks(const reco::MuonTrackLinks* links) const {
   const bool trackBAD = links->trackerTrack().isNull();
   const bool staBAD = links->standAloneTrack().isNull();
@@ -1270,6 +1344,11 @@ bool MuonIdProducer::checkLinks(const reco::MuonTrackLinks* links) const {
 void MuonIdProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {  
   edm::ParameterSetDescription desc;  
   desc.setAllowAnything();
+
+  desc.add<bool>("coarseMuonMatching", false);
+  desc.add<double>("coarseMaxDEta", 0.5);
+  desc.add<double>("coarseMaxDPhi", 0.5);
+  desc.add<double>("coarseDPhiTimesPt", 2.0);
   
   edm::ParameterSetDescription descTrkAsoPar;
   descTrkAsoPar.add<edm::InputTag>("GEMSegmentCollectionLabel",edm::InputTag("gemSegments"));
@@ -82,6 +82,9 @@ class MuonIdProducer : public edm::stream::EDProducer<> {
  private:
    void          fillMuonId( edm::Event&, const edm::EventSetup&, reco::Muon&, 
 			     TrackDetectorAssociator::Direction direction = TrackDetectorAssociator::InsideOut );
+   void          fillMuonId( edm::Event&, const edm::EventSetup&, reco::Muon&,
+			     TrackDetectorAssociator::Direction direction,
+			     const TrackAssociatorParameters& parameters );
    void          fillArbitrationInfo( reco::MuonCollection* );
    void          fillMuonIsolation( edm::Event&, const edm::EventSetup&, reco::Muon& aMuon,
 				    reco::IsoDeposit& trackDep, reco::IsoDeposit& ecalDep, reco::IsoDeposit& hcalDep, reco::IsoDeposit& hoDep,
@@ -118,6 +121,11 @@ class MuonIdProducer : public edm::stream::EDProducer<> {
    double phiOfMuonIneteractionRegion( const reco::Muon& muon ) const;
 
    bool checkLinks(const reco::MuonTrackLinks*) const ;
+
+   // collect the directions of the muon segments and RPC hits of the event
+   void fillMuonHitDirections( const edm::Event&, const edm::EventSetup& );
+   // coarse matching: is there a muon segment or RPC hit in a cone around the track
+   bool hasMuonHitsInCone( const reco::Track& track ) const;
    inline bool approxEqual(const double a, const double b, const double tol=1E-3) const
    {
      return std::abs(a-b) < tol;
@@ -125,6 +133,8 @@ class MuonIdProducer : public edm::stream::EDProducer<> {
      
    TrackDetectorAssociator trackAssociator_;
    TrackAssociatorParameters parameters_;
+   // the same without the muon system, for the tracks failing the coarse matching
+   TrackAssociatorParameters parametersNoMuon_;
 
    struct ICTypes
    {
@@ -191,6 +201,17 @@ class MuonIdProducer : public edm::stream::EDProducer<> {
    
    bool debugWithTruthMatching_;
 
+   // coarse matching of the tracker muon candidates: the tracks without a muon
+   // segment or RPC hit in a cone of |deta| < coarseMaxDEta_ and
+   // |dphi| < coarseMaxDPhi_ + coarseDPhiTimesPt_/pt are not propagated
+   // through the muon system, only to the calorimeters
+   bool   coarseMuonMatching_;
+   double coarseMaxDEta_;
+   double coarseMaxDPhi_;
+   double coarseDPhiTimesPt_;
+   // (phi, eta) of the muon segments and RPC hits of the event, sorted in phi
+   std::vector<std::pair<float,float> > muonHitDirections_;
+
    edm::Handle<reco::TrackCollection>             innerTrackCollectionHandle_;
    edm::Handle<reco::TrackCollection>             outerTrackCollectionHandle_;
    edm::Handle<reco::MuonCollection>              muonCollectionHandle_;
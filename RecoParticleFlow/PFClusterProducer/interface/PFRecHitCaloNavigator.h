@@ -21,6 +21,26 @@
 #include "DataFormats/CaloTowers/interface/CaloTowerDetId.h"
 
 
+#include <vector>
+
+namespace pfnavigation {
+  // dense indexing of the cells of a topology, used to cache their neighbours
+  template <typename DET,typename TOPO>
+  inline unsigned int denseSize(const TOPO&) { return DET::kSizeForDenseIndexing; }
+  template <typename DET,typename TOPO>
+  inline unsigned int denseIndex(const TOPO&, const DetId& id) { return DET(id).denseIndex(); }
+
+  template <>
+  inline unsigned int denseSize<HcalDetId,HcalTopology>(const HcalTopology& topo) { return topo.ncells(); }
+  template <>
+  inline unsigned int denseIndex<HcalDetId,HcalTopology>(const HcalTopology& topo, const DetId& id) { return topo.detId2denseId(id); }
+
+  template <>
+  inline unsigned int denseSize<CaloTowerDetId,CaloTowerTopology>(const CaloTowerTopology& topo) { return topo.sizeForDenseIndexing(); }
+  template <>
+  inline unsigned int denseIndex<CaloTowerDetId,CaloTowerTopology>(const CaloTowerTopology& topo, const DetId& id) { return topo.denseIndex(id); }
+}
+
 template <typename DET,typename TOPO,bool ownsTopo=true>
 class PFRecHitCaloNavigator : public PFRecHitNavigatorBase {
  public:
@@ -28,8 +48,50 @@ class PFRecHitCaloNavigator : public PFRecHitNavigatorBase {
  virtual ~PFRecHitCaloNavigator() { if(!ownsTopo) { topology_.release(); } }
 
   void associateNeighbours(reco::PFRecHit& hit,std::auto_ptr<reco::PFRecHitCollection>& hits,edm::RefProd<reco::PFRecHitCollection>& refProd) {
-      DetId detid( hit.detId() );
-      
+      const DetId * nb = neighbours(DetId(hit.detId()));
+      for (unsigned int i=0; i!=8; ++i)
+	associateNeighbour(nb[i],hit,hits,refProd,s_eta[i],s_phi[i],0);
+  }
+
+
+
+ protected:
+  //to be called whenever the topology changes
+  void clearNeighbours() {
+    neighbours_.clear();
+    found_.clear();
+  }
+
+  std::unique_ptr<const TOPO> topology_;
+
+ private:
+  static constexpr short s_eta[8] = { 0, 1, 0,-1, 1, 1,-1,-1};
+  static constexpr short s_phi[8] = { 1, 1,-1,-1, 0,-1, 0, 1};
+
+  // the neighbours are found with the topology the first time a cell is seen,
+  // and kept in a flat table indexed by the dense index of the cell until the
+  // topology changes
+  const DetId * neighbours(const DetId& detid) {
+    const unsigned int size = pfnavigation::denseSize<DET>(*topology_);
+    const unsigned int index = pfnavigation::denseIndex<DET>(*topology_,detid);
+    if (index >= size) {
+      findNeighbours(detid,scratch_);
+      return scratch_;
+    }
+    if (found_.size() != size) {
+      neighbours_.assign(8*size,DetId(0));
+      found_.assign(size,false);
+    }
+    DetId * nb = &neighbours_[8*index];
+    if (!found_[index]) {
+      findNeighbours(detid,nb);
+      found_[index] = true;
+    }
+    return nb;
+  }
+
+  // the eight neighbours of a cell, in the order of s_eta and s_phi
+  void findNeighbours(const DetId& detid, DetId * nb) const {
       CaloNavigator<DET> navigator(detid, topology_.get());
       
       DetId N(0);
@@ -43,7 +105,7 @@ class PFRecHitCaloNavigator : public PFRecHitNavigatorBase {
 
 
       N=navigator.north();  
-      associateNeighbour(N,hit,hits,refProd,0,1,0);
+      nb[0]=N;
 
 
       if (N !=DetId(0)) {
@@ -55,11 +117,11 @@ class PFRecHitCaloNavigator : public PFRecHitNavigatorBase {
 	  E=navigator.east();
 	  NE=navigator.north();
 	}
-      associateNeighbour(NE,hit,hits,refProd,1,1,0);
+      nb[1]=NE;
       navigator.home();
 
       S = navigator.south();
-      associateNeighbour(S,hit,hits,refProd,0,-1,0);
+      nb[2]=S;
       
       if (S !=DetId(0)) {
 	SW = navigator.west();
@@ -68,11 +130,11 @@ class PFRecHitCaloNavigator : public PFRecHitNavigatorBase {
 	W=navigator.west();
 	SW=navigator.south();
       }
-      associateNeighbour(SW,hit,hits,refProd,-1,-1,0);
+      nb[3]=SW;
       navigator.home();
 
       E = navigator.east();
-      associateNeighbour(E,hit,hits,refProd,1,0,0);
+      nb[4]=E;
       
       if (E !=DetId(0)) {
 	SE = navigator.south();
@@ -81,12 +143,12 @@ class PFRecHitCaloNavigator : public PFRecHitNavigatorBase {
 	S=navigator.south();
 	SE=navigator.east();
       }
-      associateNeighbour(SE,hit,hits,refProd,1,-1,0);
+      nb[5]=SE;
       navigator.home();
 
 
       W = navigator.west();
-      associateNeighbour(W,hit,hits,refProd,-1,0,0);
+      nb[6]=W;
 
       if (W !=DetId(0)) {
 	NW = navigator.north();
@@ -95,17 +157,21 @@ class PFRecHitCaloNavigator : public PFRecHitNavigatorBase {
 	N=navigator.north();
 	NW=navigator.west();
       }
-      associateNeighbour(NW,hit,hits,refProd,-1,1,0);
+      nb[7]=NW;
   }
 
-
-
- protected:
-  std::unique_ptr<const TOPO> topology_;
+  std::vector<DetId> neighbours_;
+  std::vector<bool> found_;
+  DetId scratch_[8];
 
 
 };
 
+template <typename DET,typename TOPO,bool ownsTopo>
+constexpr short PFRecHitCaloNavigator<DET,TOPO,ownsTopo>::s_eta[8];
+template <typename DET,typename TOPO,bool ownsTopo>
+constexpr short PFRecHitCaloNavigator<DET,TOPO,ownsTopo>::s_phi[8];
+
 #endif
 
 
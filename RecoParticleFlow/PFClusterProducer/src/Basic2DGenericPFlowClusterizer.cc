@@ -7,7 +7,12 @@
 
 #include "vdt/vdtMath.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include <algorithm>
 #include <iterator>
+#include <numeric>
 
 #ifdef PFLOW_DEBUG
 #define LOGVERB(x) edm::LogVerbatim(x)
@@ -24,6 +29,8 @@
 Basic2DGenericPFlowClusterizer::
 Basic2DGenericPFlowClusterizer(const edm::ParameterSet& conf) :
     PFClusterBuilderBase(conf),
+    _parallelTopoClusters(conf.existsAs<bool>("parallelTopoClusters") ?
+			  conf.getParameter<bool>("parallelTopoClusters") : false),
     _maxIterations(conf.getParameter<unsigned>("maxIterations")),
     _stoppingTolerance(conf.getParameter<double>("stoppingTolerance")),
     _showerSigma2(std::pow(conf.getParameter<double>("showerSigma"),2.0)),
@@ -81,34 +88,73 @@ void Basic2DGenericPFlowClusterizer::
 buildClusters(const reco::PFClusterCollection& input,
 	      const std::vector<bool>& seedable,
 	      reco::PFClusterCollection& output) {
+  if( _parallelTopoClusters ) {
+    buildClustersInParallel(input,seedable,output);
+    return;
+  }
   reco::PFClusterCollection clustersInTopo;
   for( const auto& topocluster : input ) {
     clustersInTopo.clear();
-    seedPFClustersFromTopo(topocluster,seedable,clustersInTopo);
-    const unsigned tolScal = 
-      std::pow(std::max(1.0,clustersInTopo.size()-1.0),2.0);
-    growPFClusters(topocluster,seedable,tolScal,0,tolScal,clustersInTopo);
-    // step added by Josh Bendavid, removes low-fraction clusters
-    // did not impact position resolution with fraction cut of 1e-7
-    // decreases the size of each pf cluster considerably
-    prunePFClusters(clustersInTopo);
-    // recalculate the positions of the pruned clusters
-    if( _convergencePosCalc ) { 
-      // if defined, use the special position calculation for convergence tests
-      _convergencePosCalc->calculateAndSetPositions(clustersInTopo);
-    } else {
-      if( clustersInTopo.size() == 1 && _allCellsPosCalc ) {
-	_allCellsPosCalc->calculateAndSetPosition(clustersInTopo.back());
-      } else {
-	_positionCalc->calculateAndSetPositions(clustersInTopo);
-      }   
-    }
+    buildClustersInTopo(topocluster,seedable,clustersInTopo);
     for( auto& clusterout : clustersInTopo ) {
       output.insert(output.end(),std::move(clusterout));
     }
   }
 }
 
+void Basic2DGenericPFlowClusterizer::
+buildClustersInParallel(const reco::PFClusterCollection& input,
+			const std::vector<bool>& seedable,
+			reco::PFClusterCollection& output) const {
+  // start with the topo clusters with the most rechits, which take longest,
+  // and keep the output in the order of the topo clusters
+  std::vector<unsigned> order(input.size());
+  std::iota(order.begin(),order.end(),0);
+  std::stable_sort(order.begin(),order.end(),
+		   [&](unsigned a, unsigned b) {
+		     return ( input[a].recHitFractions().size() > 
+			      input[b].recHitFractions().size() );
+		   });
+  std::vector<reco::PFClusterCollection> clustersInTopo(input.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0,order.size(),1),
+		    [&](const tbb::blocked_range<size_t>& range) {
+		      for( size_t i = range.begin(); i != range.end(); ++i ) {
+			const unsigned itopo = order[i];
+			buildClustersInTopo(input[itopo],seedable,clustersInTopo[itopo]);
+		      }
+		    });
+  for( auto& clusters : clustersInTopo ) {
+    for( auto& clusterout : clusters ) {
+      output.insert(output.end(),std::move(clusterout));
+    }
+  }
+}
+
+void Basic2DGenericPFlowClusterizer::
+buildClustersInTopo(const reco::PFCluster& topocluster,
+		    const std::vector<bool>& seedable,
+		    reco::PFClusterCollection& clustersInTopo) const {
+  seedPFClustersFromTopo(topocluster,seedable,clustersInTopo);
+  const unsigned tolScal = 
+    std::pow(std::max(1.0,clustersInTopo.size()-1.0),2.0);
+  growPFClusters(topocluster,seedable,tolScal,0,tolScal,clustersInTopo);
+  // step added by Josh Bendavid, removes low-fraction clusters
+  // did not impact position resolution with fraction cut of 1e-7
+  // decreases the size of each pf cluster considerably
+  prunePFClusters(clustersInTopo);
+  // recalculate the positions of the pruned clusters
+  if( _convergencePosCalc ) { 
+    // if defined, use the special position calculation for convergence tests
+    _convergencePosCalc->calculateAndSetPositions(clustersInTopo);
+  } else {
+    if( clustersInTopo.size() == 1 && _allCellsPosCalc ) {
+      _allCellsPosCalc->calculateAndSetPosition(clustersInTopo.back());
+    } else {
+      _positionCalc->calculateAndSetPositions(clustersInTopo);
+    }   
+  }
+}
+
 void Basic2DGenericPFlowClusterizer::
 seedPFClustersFromTopo(const reco::PFCluster& topo,
 		       const std::vector<bool>& seedable,
@@ -156,9 +202,21 @@ growPFClusters(const reco::PFCluster& topo,
     }
     cluster.resetHitsAndFractions();
   }
+  // the positions and energies of the clusters do not change while the
+  // rechits are shared out: read them once, so that the distances and 
+  // fractions of a rechit are computed in plain loops over the clusters
+  const unsigned nclus = clusters.size();
+  std::vector<double> clus_x(nclus), clus_y(nclus), clus_z(nclus), clus_e(nclus);
+  for( unsigned i = 0; i < nclus; ++i ) {
+    const math::XYZPoint& clusterpos_xyz = clusters[i].position();
+    clus_x[i] = clusterpos_xyz.x();
+    clus_y[i] = clusterpos_xyz.y();
+    clus_z[i] = clusterpos_xyz.z();
+    clus_e[i] = clusters[i].energy();
+  }
   // loop over topo cluster and grow current PFCluster hypothesis 
-  std::vector<double> dist2, frac;
-  double fractot = 0, fraction = 0;
+  std::vector<double> dist2(nclus), frac(nclus);
+  double fractot = 0;
   for( const reco::PFRecHitFraction& rhf : topo.recHitFractions() ) {
     const reco::PFRecHitRef& refhit = rhf.recHitRef();
     int cell_layer = (int)refhit->layer();
@@ -168,30 +226,39 @@ growPFClusters(const reco::PFCluster& topo,
     }  
     const double recHitEnergyNorm = 
       _recHitEnergyNorms.find(cell_layer)->second; 
-    math::XYZPoint topocellpos_xyz(refhit->position());
-    dist2.clear(); frac.clear(); fractot = 0;
+    const math::XYZPoint& topocellpos_xyz = refhit->position();
+    const double cell_x = topocellpos_xyz.x();
+    const double cell_y = topocellpos_xyz.y();
+    const double cell_z = topocellpos_xyz.z();
     // add rechits to clusters, calculating fraction based on distance
-    for( auto& cluster : clusters ) {      
-      const math::XYZPoint& clusterpos_xyz = cluster.position();
-      fraction = 0.0;
-      const math::XYZVector deltav = clusterpos_xyz - topocellpos_xyz;
-      const double d2 = deltav.Mag2()/_showerSigma2;
-      dist2.emplace_back( d2 );
-      if( d2 > 100 ) {
+    for( unsigned i = 0; i < nclus; ++i ) {
+      const double dx = clus_x[i] - cell_x;
+      const double dy = clus_y[i] - cell_y;
+      const double dz = clus_z[i] - cell_z;
+      dist2[i] = (dx*dx + dy*dy + dz*dz)/_showerSigma2;
+    }
+    for( unsigned i = 0; i < nclus; ++i ) {
+      frac[i] = clus_e[i]/recHitEnergyNorm * vdt::fast_expf( -0.5*dist2[i] );
+    }
+    // fraction assignment logic
+    if( _excludeOtherSeeds ) {
+      const bool isSeedable = seedable[refhit.key()];
+      for( unsigned i = 0; i < nclus; ++i ) {
+	if( refhit->detId() == clusters[i].seed() ) {
+	  frac[i] = 1.0;
+	} else if( isSeedable ) {
+	  frac[i] = 0.0;
+	}
+      }
+    }
+    fractot = 0;
+    for( unsigned i = 0; i < nclus; ++i ) {
+      if( dist2[i] > 100 ) {
 	LOGDRESSED("Basic2DGenericPFlowClusterizer:growAndStabilizePFClusters")
 	  << "Warning! :: pfcluster-topocell distance is too large! d= "
-	  << d2;
+	  << dist2[i];
       }
-      // fraction assignment logic
-      if( refhit->detId() == cluster.seed() && _excludeOtherSeeds ) {
-	fraction = 1.0;	
-      } else if ( seedable[refhit.key()] && _excludeOtherSeeds ) {
-	fraction = 0.0;
-      } else {
-	fraction = cluster.energy()/recHitEnergyNorm * vdt::fast_expf( -0.5*d2 );
-      }      
-      fractot += fraction;
-      frac.emplace_back(fraction);
+      fractot += frac[i];
     }
     for( unsigned i = 0; i < clusters.size(); ++i ) {      
       if( fractot > _minFracTot || 
@@ -234,6 +301,7 @@ growPFClusters(const reco::PFCluster& topo,
   }
   diff = std::sqrt(diff2);
   dist2.clear(); frac.clear(); clus_prev_pos.clear();// avoid badness
+  clus_x.clear(); clus_y.clear(); clus_z.clear(); clus_e.clear();
   growPFClusters(topo,seedable,toleranceScaling,iter+1,diff,clusters);
 }
 
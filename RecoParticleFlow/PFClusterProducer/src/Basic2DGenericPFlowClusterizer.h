@@ -26,6 +26,8 @@ class Basic2DGenericPFlowClusterizer : public PFClusterBuilderBase {
 		     reco::PFClusterCollection& outclus);
 
  private:  
+  // the topo clusters are clustered concurrently, the largest first
+  const bool _parallelTopoClusters;
   const unsigned _maxIterations;
   const double _stoppingTolerance;
   const double _showerSigma2;
@@ -36,6 +38,14 @@ class Basic2DGenericPFlowClusterizer : public PFClusterBuilderBase {
   std::unique_ptr<PFCPositionCalculatorBase> _allCellsPosCalc;
   std::unique_ptr<PFCPositionCalculatorBase> _convergencePosCalc;
   
+  void buildClustersInTopo(const reco::PFCluster&,
+			   const std::vector<bool>&,
+			   reco::PFClusterCollection&) const;
+
+  void buildClustersInParallel(const reco::PFClusterCollection&,
+			       const std::vector<bool>&,
+			       reco::PFClusterCollection&) const;
+
   void seedPFClustersFromTopo(const reco::PFCluster&,
 			      const std::vector<bool>&,
 			      reco::PFClusterCollection&) const;
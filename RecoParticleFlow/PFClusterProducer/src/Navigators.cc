@@ -1,4 +1,6 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/ESWatcher.h"
+#include "Geometry/Records/interface/HcalRecNumberingRecord.h"
 
 #include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitFakeNavigator.h"
 
@@ -46,10 +48,15 @@ class PFRecHitEcalBarrelNavigator final : public PFRecHitCaloNavigator<EBDetId,E
   }
 
   void beginEvent(const edm::EventSetup& iSetup) {
+    if (!geomWatcher_.check(iSetup)) return;
     edm::ESHandle<CaloGeometry> geoHandle;
     iSetup.get<CaloGeometryRecord>().get(geoHandle);
     topology_.reset( new EcalBarrelTopology(geoHandle) );
+    clearNeighbours();
   }
+
+ private:
+  edm::ESWatcher<CaloGeometryRecord> geomWatcher_;
 };
 
 class PFRecHitEcalEndcapNavigator final : public PFRecHitCaloNavigator<EEDetId,EcalEndcapTopology> {
@@ -59,10 +66,15 @@ class PFRecHitEcalEndcapNavigator final : public PFRecHitCaloNavigator<EEDetId,E
   }
 
   void beginEvent(const edm::EventSetup& iSetup) {
+    if (!geomWatcher_.check(iSetup)) return;
     edm::ESHandle<CaloGeometry> geoHandle;
     iSetup.get<CaloGeometryRecord>().get(geoHandle);
     topology_.reset( new EcalEndcapTopology(geoHandle) );
+    clearNeighbours();
   }
+
+ private:
+  edm::ESWatcher<CaloGeometryRecord> geomWatcher_;
 };
 
 class PFRecHitPreshowerNavigator final : public PFRecHitCaloNavigator<ESDetId,EcalPreshowerTopology> {
@@ -73,10 +85,15 @@ class PFRecHitPreshowerNavigator final : public PFRecHitCaloNavigator<ESDetId,Ec
 
 
   void beginEvent(const edm::EventSetup& iSetup) {
+    if (!geomWatcher_.check(iSetup)) return;
     edm::ESHandle<CaloGeometry> geoHandle;
     iSetup.get<CaloGeometryRecord>().get(geoHandle);
     topology_.reset( new EcalPreshowerTopology(geoHandle) );
+    clearNeighbours();
   }
+
+ private:
+  edm::ESWatcher<CaloGeometryRecord> geomWatcher_;
 };
 
 
@@ -88,11 +105,16 @@ class PFRecHitHCALNavigator final : public PFRecHitCaloNavigator<HcalDetId,HcalT
 
 
   void beginEvent(const edm::EventSetup& iSetup) {    
+      if (!topoWatcher_.check(iSetup)) return;
       edm::ESHandle<HcalTopology> hcalTopology;
       iSetup.get<HcalRecNumberingRecord>().get( hcalTopology );
       topology_.release();
       topology_.reset(hcalTopology.product());
+      clearNeighbours();
   }
+
+ private:
+  edm::ESWatcher<HcalRecNumberingRecord> topoWatcher_;
 };
 class PFRecHitHCALNavigatorWithTime : public PFRecHitCaloNavigatorWithTime<HcalDetId,HcalTopology,false> {
  public:
@@ -120,11 +142,16 @@ class PFRecHitCaloTowerNavigator : public PFRecHitCaloNavigator<CaloTowerDetId,C
 
 
   void beginEvent(const edm::EventSetup& iSetup) {
+    if (!topoWatcher_.check(iSetup)) return;
     edm::ESHandle<CaloTowerTopology> caloTowerTopology;
     iSetup.get<HcalRecNumberingRecord>().get(caloTowerTopology);
     topology_.release();
     topology_.reset(caloTowerTopology.product());
+    clearNeighbours();
   }
+
+ private:
+  edm::ESWatcher<HcalRecNumberingRecord> topoWatcher_;
 };
 
 typedef PFRecHitDualNavigator<PFLayer::ECAL_BARREL,
@@ -240,7 +240,11 @@ class PFAlgo {
  protected:
 
   /// process one block. can be reimplemented in more sophisticated 
-  /// algorithms
+  /// algorithms. The candidates are appended to pfCandidates_ and 
+  /// addressed by their index there, and the electron and photon 
+  /// algorithms keep the state of the current block, so that the 
+  /// blocks must be processed in sequence. The lists of single HCAL 
+  /// and ECAL blocks are not used by PFAlgo itself.
   virtual void processBlock( const reco::PFBlockRef& blockref,
                              std::list<reco::PFBlockRef>& hcalBlockRefs, 
                              std::list<reco::PFBlockRef>& ecalBlockRefs ); 
@@ -123,6 +123,9 @@ class PFBlockAlgo {
 
   /// sets debug printout flag
   void setDebug( bool debug ) {debug_ = debug;}
+
+  /// sets whether the links of the blocks are computed in parallel
+  void setParallelBlocks( bool parallel ) {parallelBlocks_ = parallel;}
   
   /// \return collection of blocks
   /*   const  reco::PFBlockCollection& blocks() const {return *blocks_;} */
@@ -162,6 +165,9 @@ class PFBlockAlgo {
   
   /// if true, debug printouts activated
   bool   debug_;
+
+  /// if true, the blocks are filled in parallel
+  bool   parallelBlocks_;
   
   friend std::ostream& operator<<(std::ostream&, const PFBlockAlgo&);
   bool useHO_;
@@ -26,6 +26,8 @@ PFBlockProducer::PFBlockProducer(const edm::ParameterSet& iConfig) {
   bool debug_ = 
     iConfig.getUntrackedParameter<bool>("debug",false);  
   pfBlockAlgo_.setDebug(debug_);  
+
+  pfBlockAlgo_.setParallelBlocks(iConfig.getUntrackedParameter<bool>("parallelBlocks",false));
       
   edm::ConsumesCollector coll = consumesCollector();
   const std::vector<edm::ParameterSet>& importers
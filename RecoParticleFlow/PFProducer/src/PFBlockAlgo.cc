@@ -11,6 +11,8 @@
 #include <algorithm>
 #include "TMath.h"
 
+#include "tbb/parallel_for.h"
+
 using namespace std;
 using namespace reco;
 
@@ -67,6 +69,7 @@ namespace {
 PFBlockAlgo::PFBlockAlgo() : 
   blocks_( new reco::PFBlockCollection ),  
   debug_(false),
+  parallelBlocks_(false),
   _elementTypes( {
         INIT_ENTRY(PFBlockElement::TRACK),
 	INIT_ENTRY(PFBlockElement::PS1),
@@ -163,9 +166,11 @@ void PFBlockAlgo::findBlocks() {
 
   QuickUnion qu(bare_elements_.size());
   const auto elem_size = bare_elements_.size();
+  // the link tests are symmetric, so that a pair (i,j) with j < i was 
+  // already tested as (j,i), or skipped because it was already connected
   for( unsigned i = 0; i < elem_size; ++i ) {
-    for( unsigned j = 0; j < elem_size; ++j ) {
-      if( qu.connected(i,j) || j == i ) continue;
+    for( unsigned j = i+1; j < elem_size; ++j ) {
+      if( qu.connected(i,j) ) continue;
       if( !_linkTests[_linkTestSquare[bare_elements_[i]->type()][bare_elements_[j]->type()]] ) {
         j = ranges_[bare_elements_[j]->type()].second;
         continue;
@@ -197,12 +202,12 @@ void PFBlockAlgo::findBlocks() {
     blocksmap.emplace(key,i);
   }
 
-  PFBlockLink::Type linktype = PFBlockLink::NONE;
-  PFBlock::LinkTest linktest = PFBlock::LINKTEST_RECHIT;
-  for( auto key : keys ) {
-    blocks_->push_back( reco::PFBlock() );
+  // the blocks are independent of each other, and are filled in place
+  blocks_->resize(keys.size());
+  auto fillBlock = [&](unsigned iblock) {
+    const unsigned key = keys[iblock];
     auto range = blocksmap.equal_range(key);
-    auto& the_block = blocks_->back();
+    auto& the_block = (*blocks_)[iblock];
     ElementList::value_type::pointer p1(bare_elements_[range.first->second]);
     the_block.addElement(p1);
     const unsigned block_size = blocksmap.count(key) + 1;
@@ -214,8 +219,8 @@ void PFBlockAlgo::findBlocks() {
       const PFBlockElement::Type type1 = p1->type();
       const PFBlockElement::Type type2 = p2->type();        
       the_block.addElement(p2);
-      linktest = PFBlock::LINKTEST_RECHIT; //rechit by default 
-      linktype = static_cast<PFBlockLink::Type>(1<<(type1-1)|1<<(type2-1));
+      const PFBlock::LinkTest linktest = PFBlock::LINKTEST_RECHIT; //rechit by default 
+      const PFBlockLink::Type linktype = static_cast<PFBlockLink::Type>(1<<(type1-1)|1<<(type2-1));
       const unsigned index = _linkTestSquare[type1][type2];
       if( nullptr != _linkTests[index] ) {
         const double dist = _linkTests[index]->testLink(p1,p2);
@@ -225,6 +230,11 @@ void PFBlockAlgo::findBlocks() {
       }
     }
     packLinks( the_block, links );    
+  };
+  if( parallelBlocks_ ) {
+    tbb::parallel_for(0u,(unsigned)keys.size(),fillBlock);
+  } else {
+    for( unsigned iblock = 0; iblock < keys.size(); ++iblock ) fillBlock(iblock);
   }
   
   bare_elements_.clear();
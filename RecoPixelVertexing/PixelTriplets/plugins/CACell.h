@@ -10,21 +10,30 @@
 #include <cmath>
 #include <array>
 
+// The cells of a CellularAutomaton are stored in one flat vector, and refer
+// to their neighbors by their index in it.
 class CACell {
 public:
     using Hit = RecHitsSortedInPhi::Hit;
-    using CAntuplet = std::vector<CACell*>;
+    using CAColl = std::vector<CACell>;
+    using CAntuplet = std::vector<unsigned int>;
 
-    CACell(const HitDoublets* doublets, int doubletId, const unsigned int cellId, const int innerHitId, const int outerHitId) :
-    theCAState(0), theInnerHitId(innerHitId), theOuterHitId(outerHitId), theCellId(cellId), hasSameStateNeighbors(0), theDoublets(doublets), theDoubletId(doubletId),
+    CACell(const HitDoublets* doublets, int doubletId, const unsigned int cellId, const unsigned int layerPairId, const int innerHitId, const int outerHitId) :
+    theCAState(0), theInnerHitId(innerHitId), theOuterHitId(outerHitId), theCellId(cellId), theLayerPairId(layerPairId), hasSameStateNeighbors(0), theDoublets(doublets), theDoubletId(doubletId),
     theInnerR(doublets->r(doubletId, HitDoublets::inner)), theOuterR(doublets->r(doubletId, HitDoublets::outer)),
-    theInnerZ(doublets->z(doubletId, HitDoublets::inner)), theOuterZ(doublets->z(doubletId, HitDoublets::outer)) {
+    theInnerZ(doublets->z(doubletId, HitDoublets::inner)), theOuterZ(doublets->z(doubletId, HitDoublets::outer)),
+    theInnerX(doublets->x(doubletId, HitDoublets::inner)), theOuterX(doublets->x(doubletId, HitDoublets::outer)),
+    theInnerY(doublets->y(doubletId, HitDoublets::inner)), theOuterY(doublets->y(doubletId, HitDoublets::outer)) {
     }
 
     unsigned int getCellId() const {
         return theCellId;
     }
 
+    unsigned int getLayerPairId() const {
+        return theLayerPairId;
+    }
+
     Hit const & getInnerHit() const {
         return theDoublets->hit(theDoubletId, HitDoublets::inner);
     }
@@ -34,19 +43,19 @@ public:
     }
 
     float getInnerX() const {
-        return theDoublets->x(theDoubletId, HitDoublets::inner);
+        return theInnerX;
     }
 
     float getOuterX() const {
-        return theDoublets->x(theDoubletId, HitDoublets::outer);
+        return theOuterX;
     }
 
     float getInnerY() const {
-        return theDoublets->y(theDoubletId, HitDoublets::inner);
+        return theInnerY;
     }
 
     float getOuterY() const {
-        return theDoublets->y(theDoubletId, HitDoublets::outer);
+        return theOuterY;
     }
 
     float getInnerZ() const {
@@ -81,14 +90,15 @@ public:
         return theOuterHitId;
     }
 
-    void evolve() {
+    // reads the state of the neighbors and writes only this cell: can run on all the cells in parallel
+    void evolve(const CAColl& allCells) {
 
         hasSameStateNeighbors = 0;
         unsigned int numberOfNeighbors = theOuterNeighbors.size();
 
         for (unsigned int i = 0; i < numberOfNeighbors; ++i) {
 
-            if (theOuterNeighbors[i]->getCAState() == theCAState) {
+            if (allCells[theOuterNeighbors[i]].getCAState() == theCAState) {
 
                 hasSameStateNeighbors = 1;
 
@@ -98,11 +108,13 @@ public:
 
     }
 
-    void checkAlignmentAndTag(CACell* innerCell, const float ptmin, const float region_origin_x, const float region_origin_y, const float region_origin_radius, const float thetaCut, const float phiCut) {
+    // only tags the inner neighbor, so that the outer cells can be connected in parallel;
+    // the outer neighbors are tagged afterwards, from the inner ones
+    void checkAlignmentAndTag(const CAColl& allCells, unsigned int innerCellId, const float ptmin, const float region_origin_x, const float region_origin_y, const float region_origin_radius, const float thetaCut, const float phiCut) {
 
+        const CACell* innerCell = &allCells[innerCellId];
         if (areAlignedRZ(innerCell, ptmin, thetaCut) && haveSimilarCurvature(innerCell, region_origin_x, region_origin_y, region_origin_radius, phiCut)) {
-            tagAsInnerNeighbor(innerCell);
-            innerCell->tagAsOuterNeighbor(this);
+            tagAsInnerNeighbor(innerCellId);
         }
     }
 
@@ -115,12 +127,16 @@ public:
         return tan_12_13_half_mul_distance_13_squared * ptmin <= thetaCut * distance_13_squared;
     }
 
-    void tagAsOuterNeighbor(CACell* otherCell) {
-        theOuterNeighbors.push_back(otherCell);
+    void tagAsOuterNeighbor(unsigned int otherCellId) {
+        theOuterNeighbors.push_back(otherCellId);
+    }
+
+    void tagAsInnerNeighbor(unsigned int otherCellId) {
+        theInnerNeighbors.push_back(otherCellId);
     }
 
-    void tagAsInnerNeighbor(CACell* otherCell) {
-        theInnerNeighbors.push_back(otherCell);
+    const std::vector<unsigned int>& getInnerNeighbors() const {
+        return theInnerNeighbors;
     }
 
     bool haveSimilarCurvature(const CACell* otherCell,
@@ -185,7 +201,7 @@ public:
     // trying to free the track building process from hardcoded layers, leaving the visit of the graph
     // based on the neighborhood connections between cells.
 
-    void findNtuplets(std::vector<CAntuplet>& foundNtuplets, CAntuplet& tmpNtuplet, const unsigned int minHitsPerNtuplet) const {
+    void findNtuplets(const CAColl& allCells, std::vector<CAntuplet>& foundNtuplets, CAntuplet& tmpNtuplet, const unsigned int minHitsPerNtuplet) const {
 
         // the building process for a track ends if:
         // it has no right neighbor
@@ -201,7 +217,7 @@ public:
             unsigned int numberOfOuterNeighbors = theOuterNeighbors.size();
             for (unsigned int i = 0; i < numberOfOuterNeighbors; ++i) {
                 tmpNtuplet.push_back((theOuterNeighbors[i]));
-                theOuterNeighbors[i]->findNtuplets(foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
+                allCells[theOuterNeighbors[i]].findNtuplets(allCells, foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
                 tmpNtuplet.pop_back();
             }
         }
@@ -209,14 +225,15 @@ public:
     
     
 private:
-    std::vector<CACell*> theInnerNeighbors;
-    std::vector<CACell*> theOuterNeighbors;
+    std::vector<unsigned int> theInnerNeighbors;
+    std::vector<unsigned int> theOuterNeighbors;
 
     unsigned int theCAState;
 
     const unsigned int theInnerHitId;
     const unsigned int theOuterHitId;
     const unsigned int theCellId;
+    const unsigned int theLayerPairId;
     unsigned int hasSameStateNeighbors;
 
     const HitDoublets* theDoublets;
@@ -226,6 +243,10 @@ private:
     const float theOuterR;
     const float theInnerZ;
     const float theOuterZ;
+    const float theInnerX;
+    const float theOuterX;
+    const float theInnerY;
+    const float theOuterY;
 
 };
 
@@ -126,16 +126,19 @@ CAHitQuadrupletGenerator::findQuadruplets (const TrackingRegion& region, Ordered
     {
       return id == PixelSubdetector::PixelBarrel;
     };
+    //the positions come from the arrays of the cells, only the errors from the hits
     for(unsigned int i = 0; i< 3; ++i)
     {
-        auto const& ahit = foundQuadruplets[quadId][i]->getInnerHit();
-        gps[i] = ahit->globalPosition();
+        auto const& cell = ca.getCell(foundQuadruplets[quadId][i]);
+        auto const& ahit = cell.getInnerHit();
+        gps[i] = GlobalPoint(cell.getInnerX(), cell.getInnerY(), cell.getInnerZ());
         ges[i] = ahit->globalPositionError();
         barrels[i] = isBarrel(ahit->geographicalId().subdetId());
     }
 
-    auto const& ahit = foundQuadruplets[quadId][2]->getOuterHit();
-    gps[3] = ahit->globalPosition();
+    auto const& lastCell = ca.getCell(foundQuadruplets[quadId][2]);
+    auto const& ahit = lastCell.getOuterHit();
+    gps[3] = GlobalPoint(lastCell.getOuterX(), lastCell.getOuterY(), lastCell.getOuterZ());
     ges[3] = ahit->globalPositionError();
     barrels[3] = isBarrel(ahit->geographicalId().subdetId());
 
@@ -147,7 +150,7 @@ CAHitQuadrupletGenerator::findQuadruplets (const TrackingRegion& region, Ordered
 
     if (theComparitor)
     {
-      SeedingHitSet tmpTriplet(foundQuadruplets[quadId][0]->getInnerHit(), foundQuadruplets[quadId][2]->getInnerHit(), foundQuadruplets[quadId][2]->getOuterHit());
+      SeedingHitSet tmpTriplet(ca.getCell(foundQuadruplets[quadId][0]).getInnerHit(), lastCell.getInnerHit(), lastCell.getOuterHit());
 
 
       if (!theComparitor->compatible(tmpTriplet, region) )
@@ -196,7 +199,7 @@ CAHitQuadrupletGenerator::findQuadruplets (const TrackingRegion& region, Ordered
         continue;
     }
 
-    result.emplace_back(foundQuadruplets[quadId][0]->getInnerHit(), foundQuadruplets[quadId][1]->getInnerHit(), foundQuadruplets[quadId][2]->getInnerHit(), foundQuadruplets[quadId][2]->getOuterHit());
+    result.emplace_back(ca.getCell(foundQuadruplets[quadId][0]).getInnerHit(), ca.getCell(foundQuadruplets[quadId][1]).getInnerHit(), lastCell.getInnerHit(), lastCell.getOuterHit());
   }
 
 }
@@ -1,53 +1,70 @@
-
 #include "CellularAutomaton.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+namespace {
+  // below this number of cells the tasks cost more than they save
+  constexpr unsigned int cellsPerTask = 256;
+}
+
 template <unsigned int numberOfLayers>
-void CellularAutomaton<numberOfLayers>::createAndConnectCells (std::vector<const HitDoublets*> doublets, const SeedingLayerSetsHits::SeedingLayerSet& fourLayers, const TrackingRegion& region, const float thetaCut, const float phiCut)
+void CellularAutomaton<numberOfLayers>::createAndConnectCells (const std::vector<const HitDoublets*>& doublets, const SeedingLayerSetsHits::SeedingLayerSet& fourLayers, const TrackingRegion& region, const float thetaCut, const float phiCut)
 {
-  unsigned int cellId = 0;
   constexpr unsigned int numberOfLayerPairs =   numberOfLayers - 1;
   float ptmin = region.ptMin();
   float region_origin_x = region.origin().x();
   float region_origin_y = region.origin().y();
   float region_origin_radius = region.originRBound();
-  unsigned int layerPairId = 0;
-  auto innerLayerId = layerPairId;
-  auto outerLayerId = innerLayerId + 1;
-  auto & doubletLayerPairId = doublets[layerPairId];
-  auto numberOfDoublets = doubletLayerPairId->size ();
 
-  isOuterHitOfCell[outerLayerId].resize(fourLayers[outerLayerId].hits().size());
-
-  theFoundCellsPerLayer[layerPairId].reserve (numberOfDoublets);
-  for (unsigned int i = 0; i < numberOfDoublets; ++i)
+  unsigned int numberOfCells = 0;
+  for (unsigned int layerPairId = 0; layerPairId < numberOfLayerPairs; ++layerPairId)
   {
-    theFoundCellsPerLayer[layerPairId].emplace_back (doubletLayerPairId, i,  cellId,  doubletLayerPairId->innerHitId(i), doubletLayerPairId->outerHitId(i));
-
-    isOuterHitOfCell[outerLayerId][doubletLayerPairId->outerHitId(i)].push_back (&(theFoundCellsPerLayer[layerPairId][i]));
-    cellId++;
-
+    theLayerPairFirstCell[layerPairId] = numberOfCells;
+    numberOfCells += doublets[layerPairId]->size ();
   }
+  theLayerPairFirstCell[numberOfLayerPairs] = numberOfCells;
 
-  for (layerPairId = 1; layerPairId < numberOfLayerPairs; ++layerPairId)
+  //create the cells, and the map from the hits to the cells ending on them
+  theCells.reserve (numberOfCells);
+  for (unsigned int layerPairId = 0; layerPairId < numberOfLayerPairs; ++layerPairId)
   {
-	doubletLayerPairId = doublets[layerPairId];
-    innerLayerId = layerPairId;
-    outerLayerId = innerLayerId + 1;
-    numberOfDoublets =doubletLayerPairId->size ();
+    auto const & doubletLayerPairId = doublets[layerPairId];
+    auto outerLayerId = layerPairId + 1;
+    auto numberOfDoublets = doubletLayerPairId->size ();
     isOuterHitOfCell[outerLayerId].resize(fourLayers[outerLayerId].hits().size());
 
-    theFoundCellsPerLayer[layerPairId].reserve (numberOfDoublets);
     for (unsigned int i = 0; i < numberOfDoublets; ++i)
     {
-      theFoundCellsPerLayer[layerPairId].emplace_back (doublets[layerPairId], i, cellId, doubletLayerPairId->innerHitId(i), doubletLayerPairId->outerHitId(i));
-      isOuterHitOfCell[outerLayerId][doubletLayerPairId->outerHitId(i)].push_back (&(theFoundCellsPerLayer[layerPairId][i]));
-      cellId++;
-      for (auto neigCell : isOuterHitOfCell[innerLayerId][doubletLayerPairId->innerHitId(i)])
+      unsigned int cellId = theCells.size();
+      theCells.emplace_back (doubletLayerPairId, i, cellId, layerPairId, doubletLayerPairId->innerHitId(i), doubletLayerPairId->outerHitId(i));
+      isOuterHitOfCell[outerLayerId][doubletLayerPairId->outerHitId(i)].push_back (cellId);
+    }
+  }
+
+  //connect each cell to its inner neighbors: every cell writes only its own list
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(theLayerPairFirstCell[1], numberOfCells, cellsPerTask),
+                    [&](const tbb::blocked_range<unsigned int>& range) {
+    for (unsigned int cellId = range.begin(); cellId != range.end(); ++cellId)
+    {
+      auto & cell = theCells[cellId];
+      for (auto neigCellId : isOuterHitOfCell[cell.getLayerPairId()][cell.getInnerHitId()])
       {
-        theFoundCellsPerLayer[layerPairId][i].checkAlignmentAndTag (neigCell, ptmin, region_origin_x, region_origin_y, region_origin_radius, thetaCut, phiCut);
+        cell.checkAlignmentAndTag (theCells, neigCellId, ptmin, region_origin_x, region_origin_y, region_origin_radius, thetaCut, phiCut);
       }
     }
-  }
+  });
+
+  //the outer neighbors, from the cells of the next layer pair, in cell order: each layer pair is done by one task
+  tbb::parallel_for(1U, numberOfLayerPairs, [&](unsigned int layerPairId) {
+    for (unsigned int cellId = theLayerPairFirstCell[layerPairId]; cellId != theLayerPairFirstCell[layerPairId+1]; ++cellId)
+    {
+      for (auto neigCellId : theCells[cellId].getInnerNeighbors())
+      {
+        theCells[neigCellId].tagAsOuterNeighbor (cellId);
+      }
+    }
+  });
 }
 
 template <unsigned int numberOfLayers>
@@ -55,42 +72,31 @@ void
 CellularAutomaton<numberOfLayers>::evolve ()
 {
   constexpr unsigned int numberOfIterations = numberOfLayers - 2;
-  unsigned int numberOfCellsFound ;
-  for (unsigned int iteration = 0; iteration < numberOfIterations - 1; ++iteration)
+  //at each iteration the cells of one more outer layer pair have reached their final state;
+  // within an iteration all the cells first look at their neighbors, then all update their state
+  for (unsigned int iteration = 0; iteration < numberOfIterations; ++iteration)
   {
-    for (unsigned int innerLayerId = 0; innerLayerId < numberOfIterations - iteration ; ++innerLayerId)
-    {
-
-      for (auto& cell : theFoundCellsPerLayer[innerLayerId])
+    tbb::blocked_range<unsigned int> cells(0, theLayerPairFirstCell[numberOfIterations - iteration], cellsPerTask);
+    tbb::parallel_for(cells, [this](const tbb::blocked_range<unsigned int>& range) {
+      for (unsigned int cellId = range.begin(); cellId != range.end(); ++cellId)
       {
-        cell.evolve();
+        theCells[cellId].evolve(theCells);
       }
-    }
-
-    for (unsigned int innerLayerId = 0; innerLayerId < numberOfLayers - iteration - 2; ++innerLayerId)
-    {
+    });
 
-      for (auto& cell : theFoundCellsPerLayer[innerLayerId])
+    tbb::parallel_for(cells, [this](const tbb::blocked_range<unsigned int>& range) {
+      for (unsigned int cellId = range.begin(); cellId != range.end(); ++cellId)
       {
-        cell.updateState();
+        theCells[cellId].updateState();
       }
-    }
+    });
   }
 
-  //last iteration 
-  numberOfCellsFound = theFoundCellsPerLayer[0].size();
-
-  for (unsigned int cellId = 0; cellId < numberOfCellsFound; ++cellId)
+  for (unsigned int cellId = 0; cellId < theLayerPairFirstCell[1]; ++cellId)
   {
-    theFoundCellsPerLayer[0][cellId].evolve();
-  }
-
-  for (auto& cell : theFoundCellsPerLayer[0])
-  {
-    cell.updateState();
-    if (cell.isRootCell (numberOfLayers - 2 ))
+    if (theCells[cellId].isRootCell (numberOfLayers - 2 ))
     {
-      theRootCells.push_back (&cell);
+      theRootCells.push_back (cellId);
     }
   }
 }
@@ -99,18 +105,16 @@ template <unsigned int numberOfLayers>
 void
 CellularAutomaton<numberOfLayers>::findNtuplets(std::vector<CACell::CAntuplet>& foundNtuplets,  const unsigned int minHitsPerNtuplet)
 {
-  std::vector<CACell*> tmpNtuplet;
+  CACell::CAntuplet tmpNtuplet;
   tmpNtuplet.reserve(numberOfLayers);
 
-  for (CACell* root_cell : theRootCells)
+  for (auto root_cell : theRootCells)
   {
     tmpNtuplet.clear();
     tmpNtuplet.push_back(root_cell);
-    root_cell->findNtuplets (foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
+    theCells[root_cell].findNtuplets (theCells, foundNtuplets, tmpNtuplet, minHitsPerNtuplet);
   }
 
 }
 
 template class CellularAutomaton<4>;
-
-
@@ -5,6 +5,9 @@
 #include "TrackingTools/TransientTrackingRecHit/interface/SeedingLayerSetsHits.h"
 #include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
 
+// The cells of all the layer pairs are stored in one vector, those of a
+// layer pair being contiguous, and refer to each other by index: the
+// connection and the evolution run in parallel over all the cells.
 template<unsigned int theNumberOfLayers>
 class CellularAutomaton {
 public:
@@ -13,22 +16,26 @@ public:
 
     }
 
-    void createAndConnectCells(std::vector<const HitDoublets*>, const SeedingLayerSetsHits::SeedingLayerSet&, const TrackingRegion&, const float, const float);
+    void createAndConnectCells(const std::vector<const HitDoublets*>&, const SeedingLayerSetsHits::SeedingLayerSet&, const TrackingRegion&, const float, const float);
     void evolve();
     void findNtuplets(std::vector<CACell::CAntuplet>&, const unsigned int);
 
-
+    // the ntuplets found refer to the cells by index
+    const CACell& getCell(unsigned int cellId) const {
+        return theCells[cellId];
+    }
 
 private:
 
 
 
-    //for each hit in each layer, store the pointers of the Cells of which it is outerHit
-    std::array<std::vector<std::vector<CACell*> >, theNumberOfLayers> isOuterHitOfCell;
-    std::array<std::vector<CACell>, theNumberOfLayers> theFoundCellsPerLayer;
+    //for each hit in each layer, store the indices of the Cells of which it is outerHit
+    std::array<std::vector<std::vector<unsigned int> >, theNumberOfLayers> isOuterHitOfCell;
+    CACell::CAColl theCells;
+    //the cells of layer pair i are [theLayerPairFirstCell[i],theLayerPairFirstCell[i+1])
+    std::array<unsigned int, theNumberOfLayers> theLayerPairFirstCell;
 
-    std::vector<CACell*> theRootCells;
-    std::vector<std::vector<CACell*> > theNtuplets;
+    std::vector<unsigned int> theRootCells;
 
 };
 
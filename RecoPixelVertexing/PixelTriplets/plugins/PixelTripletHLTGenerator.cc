@@ -272,8 +272,23 @@ void PixelTripletHLTGenerator::hitTriplets(
       // std::cout << ip << ": " << thirdLayerDetLayer[il]->seqNum() << " " << foundNodes.size() << " " << prmin << " " << prmax << std::endl;
 
 
-      // int kk=0;
-      for (auto KDdata : foundNodes) {
+      // first the r-z compatibility of all the candidates, from the hit arrays,
+      // then the r-phi check for the ones that survive
+      int nFound = foundNodes.size();
+      bool okRZ[nFound];
+      for (int k=0; k!=nFound; ++k) {
+	auto KDdata = foundNodes[k];
+	float p3_u = hits.u[KDdata];
+	float p3_v =  hits.v[KDdata];
+	Range allowed = predictionRZ(p3_u);
+	correction.correctRZRange(allowed);
+	float vErr = nSigmaRZ *hits.dv[KDdata];
+	Range hitRange(p3_v-vErr, p3_v+vErr);
+	okRZ[k] = !allowed.intersection(hitRange).empty();
+      }
+
+      for (int k=0; k!=nFound; ++k) {
+	auto KDdata = foundNodes[k];
 	
 	if (theMaxElement!=0 && result.size() >= theMaxElement){
 	  result.clear();
@@ -281,20 +296,9 @@ void PixelTripletHLTGenerator::hitTriplets(
 	  return;
 	}
 	
-	float p3_u = hits.u[KDdata]; 
-	float p3_v =  hits.v[KDdata]; 
-	float p3_phi =  hits.lphi[KDdata]; 
+	if (!okRZ[k])  continue;
 
-       //if ((kk++)%100==0)
-       //std::cout << kk << ": " << p3_u << " " << p3_v << " " << p3_phi << std::endl;
-
-	
-	Range allowed = predictionRZ(p3_u);
-	correction.correctRZRange(allowed);
-	float vErr = nSigmaRZ *hits.dv[KDdata];
-	Range hitRange(p3_v-vErr, p3_v+vErr);
-	Range crossingRange = allowed.intersection(hitRange);
-	if (crossingRange.empty())  continue;
+	float p3_phi =  hits.lphi[KDdata]; 
 	
 	float ir = 1.f/hits.rv(KDdata);
         // limit error to 90 degree
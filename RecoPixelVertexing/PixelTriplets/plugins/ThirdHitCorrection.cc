@@ -102,31 +102,3 @@ void ThirdHitCorrection::init(
     }
 
 }
-
-
-void ThirdHitCorrection::correctRZRange( Range & range) const
-{ 
-  range.first -= theMScoeff;
-  range.second += theMScoeff;
-   
-
-  if (theUseBendingCorrection) {
-    if (theBarrel) {
-      float cotTheta = theLine.cotLine();
-      if (cotTheta > 0) {
-        float radius = theLine.rAtZ(range.max());
-        float corr = theBendingCorrection(radius) * cotTheta;
-        range.second +=  corr;
-      } else {
-        float radius = theLine.rAtZ(range.min());
-        float corr = theBendingCorrection(radius) * std::abs(cotTheta);
-        range.first -=  corr;
-      }
-    } 
-    else {
-      float radius = range.max();
-      float corr = theBendingCorrection(radius);
-      range.first -= corr;
-    }
-  }
-}
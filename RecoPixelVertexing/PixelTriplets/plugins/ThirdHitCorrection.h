@@ -11,6 +11,8 @@ class DetLayer;
 #include "RecoTracker/TkMSParametrization/interface/PixelRecoPointRZ.h"
 #include "RecoTracker/TkMSParametrization/interface/PixelRecoLineRZ.h"
 
+#include <cmath>
+
 class ThirdHitCorrection {
 public:
 
@@ -60,7 +62,31 @@ public:
     range.second += theMultScattCorrRPhi;
   }
 
-  void correctRZRange( Range & range) const;
+  // inline, as it is called for each candidate hit in the triplet search
+  void correctRZRange( Range & range) const {
+    range.first -= theMScoeff;
+    range.second += theMScoeff;
+
+    if (theUseBendingCorrection) {
+      if (theBarrel) {
+        float cotTheta = theLine.cotLine();
+        if (cotTheta > 0) {
+          float radius = theLine.rAtZ(range.max());
+          float corr = theBendingCorrection(radius) * cotTheta;
+          range.second +=  corr;
+        } else {
+          float radius = theLine.rAtZ(range.min());
+          float corr = theBendingCorrection(radius) * std::abs(cotTheta);
+          range.first -=  corr;
+        }
+      }
+      else {
+        float radius = range.max();
+        float corr = theBendingCorrection(radius);
+        range.first -= corr;
+      }
+    }
+  }
 
 private:
   bool theBarrel;
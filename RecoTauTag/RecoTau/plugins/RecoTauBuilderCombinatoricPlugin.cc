@@ -215,6 +215,22 @@ RecoTauBuilderCombinatoricPlugin::operator()(
   /// Apply quality cuts to the regional junk around the jet.  Note that the
   /// particle contents of the junk is exclusive to the jet content.
   PFCandPtrs regionalJunk = qcuts_.filterCandRefs(regionalExtras);
+
+  // Cross cleaning predicate to select the neutral PFCandidates within the jet:
+  // remove any PFCandidatePtrs that are contained within the ChargedHadrons or PiZeros.
+  // It does not depend on the combination, so it is built once for all taus of the jet.
+  xclean::CrossCleanPtrs<ChargedHadronList::const_iterator> pfChargedHadronXCleaner_allChargedHadrons(chargedHadrons.begin(), chargedHadrons.end());
+  xclean::CrossCleanPtrs<PiZeroList::const_iterator> piZeroXCleaner(piZeros.begin(), piZeros.end());
+  typedef xclean::PredicateAND<xclean::CrossCleanPtrs<ChargedHadronList::const_iterator>, xclean::CrossCleanPtrs<PiZeroList::const_iterator> > pfCandXCleanerType;
+  pfCandXCleanerType pfCandXCleaner_allChargedHadrons(pfChargedHadronXCleaner_allChargedHadrons, piZeroXCleaner);
+
+  // Predicates to select the different PF object types of the regional junk
+  xclean::FilterPFCandByParticleId
+    pfchCandSelector(reco::PFCandidate::h);
+  xclean::FilterPFCandByParticleId
+    pfgammaCandSelector(reco::PFCandidate::gamma);
+  xclean::FilterPFCandByParticleId
+    pfnhCandSelector(reco::PFCandidate::h0);
     
   // Loop over the decay modes we want to build
   for ( std::vector<decayModeInfo>::const_iterator decayMode = decayModesToBuild_.begin();
@@ -271,6 +287,19 @@ RecoTauBuilderCombinatoricPlugin::operator()(
       
       // Build our piZero combo generator     
       PiZeroCombo piZeroCombos(signalPiZero_begin, signalPiZero_end, piZerosToBuild);
+
+      // The isolation PiZeros cleaned of the charged hadrons of the combination,
+      // common to all the PiZero combinations
+      xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator> isolationPiZeroXCleaner(
+        trackCombo->combo_begin(), trackCombo->combo_end(), 
+        xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator>::kRemoveChargedAndNeutralDaughterOverlaps);
+      PiZeroList precleanedIsolationPiZeros = isolationPiZeroXCleaner(piZeros);
+
+      // Cross cleaning predicate to select the charged PFCandidates within the jet
+      // that are not signalPFChargedHadrons of the combination
+      typedef xclean::CrossCleanPtrs<ChargedHadronCombo::combo_iterator> pfChargedHadronXCleanerType;
+      pfChargedHadronXCleanerType pfChargedHadronXCleaner_comboChargedHadrons(trackCombo->combo_begin(), trackCombo->combo_end());
+
       // Loop over the different combinations of PiZeros
       for ( PiZeroCombo::iterator piZeroCombo = piZeroCombos.begin();
             piZeroCombo != piZeroCombos.end(); ++piZeroCombo ) {
@@ -287,12 +316,7 @@ RecoTauBuilderCombinatoricPlugin::operator()(
             RecoTauConstructor::kSignal,
             RecoTauConstructor::kGamma, 2*piZerosToBuild); // k-factor = 2
         tau.reservePiZero(RecoTauConstructor::kSignal, piZerosToBuild);
-	
-	xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator> isolationPiZeroXCleaner(
-          trackCombo->combo_begin(), trackCombo->combo_end(), 
-	  xclean::CrossCleanPiZeros<ChargedHadronCombo::combo_iterator>::kRemoveChargedAndNeutralDaughterOverlaps);
 
-	PiZeroList precleanedIsolationPiZeros = isolationPiZeroXCleaner(piZeros);
 	std::set<reco::CandidatePtr> toRemove;
 	for ( PiZeroCombo::combo_iterator signalPiZero = piZeroCombo->combo_begin();
 	      signalPiZero != piZeroCombo->combo_end(); ++signalPiZero ) {
@@ -353,19 +377,9 @@ RecoTauBuilderCombinatoricPlugin::operator()(
         using namespace reco::tau::cone;
         PFCandPtrDRFilter isolationConeFilter(tau.p4(), -0.1, isolationConeSize_);
 
-        // Cross cleaning predicate: Remove any PFCandidatePtrs that are contained within existing ChargedHadrons or PiZeros.  
-	// The predicate will return false for any object that overlaps with chargedHadrons or cleanPiZeros.
-	//  1.) to select charged PFCandidates within jet that are not signalPFChargedHadrons 
-	typedef xclean::CrossCleanPtrs<ChargedHadronCombo::combo_iterator> pfChargedHadronXCleanerType;
-	pfChargedHadronXCleanerType pfChargedHadronXCleaner_comboChargedHadrons(trackCombo->combo_begin(), trackCombo->combo_end());
-	// And this cleaning filter predicate with our Iso cone filter
+        // Combine the cross cleaning predicates with our Iso cone filter.
+	// The predicates return false for any object that overlaps with chargedHadrons or cleanPiZeros.
         xclean::PredicateAND<PFCandPtrDRFilter, pfChargedHadronXCleanerType> pfCandFilter_comboChargedHadrons(isolationConeFilter, pfChargedHadronXCleaner_comboChargedHadrons);
-	//  2.) to select neutral PFCandidates within jet
-	xclean::CrossCleanPtrs<ChargedHadronList::const_iterator> pfChargedHadronXCleaner_allChargedHadrons(chargedHadrons.begin(), chargedHadrons.end());
-	xclean::CrossCleanPtrs<PiZeroList::const_iterator> piZeroXCleaner(piZeros.begin(), piZeros.end());
-	typedef xclean::PredicateAND<xclean::CrossCleanPtrs<ChargedHadronList::const_iterator>, xclean::CrossCleanPtrs<PiZeroList::const_iterator> > pfCandXCleanerType;
-        pfCandXCleanerType pfCandXCleaner_allChargedHadrons(pfChargedHadronXCleaner_allChargedHadrons, piZeroXCleaner);
-        // And this cleaning filter predicate with our Iso cone filter
         xclean::PredicateAND<PFCandPtrDRFilter, pfCandXCleanerType> pfCandFilter_allChargedHadrons(isolationConeFilter, pfCandXCleaner_allChargedHadrons);
 
 	ChargedHadronDRFilter isolationConeFilterChargedHadron(tau.p4(), -0.1, isolationConeSize_);
@@ -376,13 +390,6 @@ RecoTauBuilderCombinatoricPlugin::operator()(
         typedef xclean::PredicateAND<xclean::FilterPFCandByParticleId,
 	    PFCandPtrDRFilter> RegionalJunkConeAndIdFilter;
 
-        xclean::FilterPFCandByParticleId
-          pfchCandSelector(reco::PFCandidate::h);
-        xclean::FilterPFCandByParticleId
-          pfgammaCandSelector(reco::PFCandidate::gamma);
-        xclean::FilterPFCandByParticleId
-          pfnhCandSelector(reco::PFCandidate::h0);
-
         RegionalJunkConeAndIdFilter pfChargedJunk(
             pfchCandSelector, // select charged stuff from junk
             isolationConeFilter); // only take those in iso cone
@@ -0,0 +1,111 @@
+/*
+ * RecoTauMultiDiscriminatorProducer
+ *
+ * Evaluates a list of RecoTauDiscriminantPlugins in a single pass over a
+ * PFTau collection, and writes a PFTauDiscriminator for each of them, with
+ * the discriminant name as product instance label.  This replaces a chain
+ * of single discriminator modules, each fetching the taus and looping over
+ * them, by one module and one loop.
+ *
+ * Each entry of the "discriminants" VPSet is the configuration of a plugin:
+ *
+ *    name         - the name of the discriminant and of the output product
+ *    plugin       - the plugin type, e.g. RecoTauDiscriminationPt
+ *    index        - (optional) the element of the plugin output to store,
+ *                   default 0
+ *    defaultValue - (optional) the value stored when the plugin output has
+ *                   no such element, default -1
+ *
+ * The plugins are set up with the event before the loop, and all of them are
+ * evaluated on a tau before moving to the next one.
+ *
+ */
+
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "RecoTauTag/RecoTau/interface/RecoTauDiscriminantPlugins.h"
+
+#include "DataFormats/TauReco/interface/PFTau.h"
+#include "DataFormats/TauReco/interface/PFTauFwd.h"
+#include "DataFormats/TauReco/interface/PFTauDiscriminator.h"
+
+class RecoTauMultiDiscriminatorProducer : public edm::stream::EDProducer<>
+{
+ public:
+  typedef reco::tau::RecoTauDiscriminantPlugin Discriminant;
+  typedef boost::ptr_vector<Discriminant> DiscriminantList;
+
+  explicit RecoTauMultiDiscriminatorProducer(const edm::ParameterSet& pset);
+  ~RecoTauMultiDiscriminatorProducer() {}
+  void produce(edm::Event& evt, const edm::EventSetup& es) override;
+
+ private:
+  edm::EDGetTokenT<reco::PFTauCollection> tau_token;
+
+  DiscriminantList discriminants_;
+  std::vector<unsigned int> indices_;
+  std::vector<double> defaultValues_;
+};
+
+RecoTauMultiDiscriminatorProducer::RecoTauMultiDiscriminatorProducer(const edm::ParameterSet& pset)
+{
+  tau_token = consumes<reco::PFTauCollection>(pset.getParameter<edm::InputTag>("PFTauProducer"));
+
+  typedef std::vector<edm::ParameterSet> VPSet;
+  const VPSet& discriminants = pset.getParameter<VPSet>("discriminants");
+  for ( VPSet::const_iterator discPSet = discriminants.begin();
+	discPSet != discriminants.end(); ++discPSet ) {
+    // Get plugin name
+    const std::string& pluginType = discPSet->getParameter<std::string>("plugin");
+    // Build the plugin
+    discriminants_.push_back(RecoTauDiscriminantPluginFactory::get()->create(pluginType, *discPSet));
+    indices_.push_back(discPSet->exists("index") ? discPSet->getParameter<unsigned int>("index") : 0);
+    defaultValues_.push_back(discPSet->exists("defaultValue") ? discPSet->getParameter<double>("defaultValue") : -1.);
+    produces<reco::PFTauDiscriminator>(discriminants_.back().name());
+  }
+}
+
+void RecoTauMultiDiscriminatorProducer::produce(edm::Event& evt, const edm::EventSetup& es)
+{
+  edm::Handle<reco::PFTauCollection> taus;
+  evt.getByToken(tau_token, taus);
+
+  // Give each plugin access to the event
+  for ( DiscriminantList::iterator disc = discriminants_.begin();
+	disc != discriminants_.end(); ++disc ) {
+    disc->setup(evt, es);
+  }
+
+  const size_t nDiscriminants = discriminants_.size();
+  std::vector<std::unique_ptr<reco::PFTauDiscriminator> > outputs;
+  outputs.reserve(nDiscriminants);
+  for ( size_t iDisc = 0; iDisc < nDiscriminants; ++iDisc ) {
+    outputs.push_back(std::make_unique<reco::PFTauDiscriminator>(reco::PFTauRefProd(taus)));
+  }
+
+  // Evaluate all the discriminants of a tau in turn
+  for ( size_t iTau = 0; iTau < taus->size(); ++iTau ) {
+    reco::PFTauRef tauRef(taus, iTau);
+    for ( size_t iDisc = 0; iDisc < nDiscriminants; ++iDisc ) {
+      std::vector<double> values = discriminants_[iDisc](tauRef);
+      double value = ( indices_[iDisc] < values.size() ) ? values[indices_[iDisc]] : defaultValues_[iDisc];
+      outputs[iDisc]->setValue(iTau, value);
+    }
+  }
+
+  for ( size_t iDisc = 0; iDisc < nDiscriminants; ++iDisc ) {
+    evt.put(std::move(outputs[iDisc]), discriminants_[iDisc].name());
+  }
+}
+
+DEFINE_FWK_MODULE(RecoTauMultiDiscriminatorProducer);
@@ -0,0 +1,41 @@
+#ifndef CachingSeedCleanerByClusterKey_H
+#define CachingSeedCleanerByClusterKey_H
+#include "RecoTracker/CkfPattern/interface/RedundantSeedCleaner.h"
+#include <boost/unordered_map.hpp>
+#include <cstdint>
+
+/** As CachingSeedCleanerBySharedInput, with the first hits of the trajectories
+    cached by cluster (OmniClusterRef index) instead of by det id: only the
+    trajectories that use the cluster of the first hit of the seed are compared
+    with it, not all those that cross its module.
+    Hits that are not made of clusters are cached by det id. */
+class CachingSeedCleanerByClusterKey : public RedundantSeedCleaner  {
+  public:
+
+   /** \brief Caches the first hits of the trajectory */
+   virtual void add(const Trajectory *traj) ;
+
+   /** \brief Provides the cleaner a pointer to the vector where trajectories are stored, in case it does not want to keep a local collection of trajectories */
+   virtual void init(const std::vector<Trajectory> *vect) ;
+
+   virtual void done() ;
+   
+   /** \brief Returns true if the seed is not overlapping with another trajectory */
+   virtual bool good(const TrajectorySeed *seed) ;
+
+ CachingSeedCleanerByClusterKey(unsigned int numHitsForSeedCleaner=4,
+				bool onlyPixelHits=false) : 
+   RedundantSeedCleaner(), theVault(), theCache(),
+   theNumHitsForSeedCleaner(numHitsForSeedCleaner),theOnlyPixelHits(onlyPixelHits){}
+
+   virtual ~CachingSeedCleanerByClusterKey() { theVault.clear(); theCache.clear(); }
+  private:
+    typedef boost::unordered_multimap<uint64_t, unsigned int> Cache;
+    std::vector<Trajectory::RecHitContainer> theVault;
+    Cache theCache;
+
+    int  theNumHitsForSeedCleaner;
+    bool theOnlyPixelHits;
+};
+
+#endif
@@ -70,6 +70,11 @@ namespace cms
     RedundantSeedCleaner*  theSeedCleaner;
 
     unsigned int maxSeedsBeforeCleaning_;
+
+    // for the concurrent building of batches of seeds: the builders and seed cleaners
+    // of all the batches but the first, which uses theTrajectoryBuilder and theSeedCleaner
+    std::vector<std::unique_ptr<BaseCkfTrajectoryBuilder> > theConcurrentBuilders;
+    std::vector<std::unique_ptr<RedundantSeedCleaner> > theConcurrentSeedCleaners;
     
     edm::EDGetTokenT<edm::View<TrajectorySeed> >  theSeedLabel;
     edm::EDGetTokenT<MeasurementTrackerEvent>     theMTELabel;
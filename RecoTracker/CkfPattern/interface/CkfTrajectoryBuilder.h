@@ -80,6 +80,8 @@ public:
   void limitedCandidates(const boost::shared_ptr<const TrajectorySeed> & sharedSeed, TempTrajectoryContainer &candidates, TrajectoryContainer& result) const;
   
   void updateTrajectory( TempTrajectory& traj, TM && tm) const;
+  /// as above, for a valid hit, with the state already updated
+  void updateTrajectory( TempTrajectory& traj, TM && tm, TSOS && upState) const;
 
   /*  
       //not mature for integration.  
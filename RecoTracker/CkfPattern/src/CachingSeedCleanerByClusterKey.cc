@@ -0,0 +1,86 @@
+#include "RecoTracker/CkfPattern/interface/CachingSeedCleanerByClusterKey.h"
+
+#include "DataFormats/TrajectorySeed/interface/TrajectorySeed.h"
+#include "DataFormats/TrackerRecHit2D/interface/BaseTrackerRecHit.h"
+
+#include "DataFormats/SiPixelDetId/interface/PixelSubdetector.h"
+
+#include<algorithm>
+
+namespace {
+  // a hit shares all its input with another one only if they have the same first
+  // cluster, whose index tells pixels from strips; the hits not made of clusters
+  // are keyed by det
+  uint64_t clusterKey(const TrackingRecHit & hit) {
+    if (!trackerHitRTTI::isFast(hit) &&
+	(trackerHitRTTI::isSingleType(hit) || trackerHitRTTI::isMatched(hit))) {
+      auto const & cluster = static_cast<const BaseTrackerRecHit &>(hit).firstClusterRef();
+      if (cluster.isValid()) return cluster.rawIndex();
+    }
+    return (uint64_t(hit.geographicalId().rawId()) << 32) | 0xffffffff;
+  }
+}
+
+void CachingSeedCleanerByClusterKey::init(const std::vector<Trajectory> *vect) { 
+    theVault.clear(); theCache.clear();
+}
+
+void CachingSeedCleanerByClusterKey::done() { 
+    theVault.clear(); theCache.clear();
+}
+
+
+void CachingSeedCleanerByClusterKey::add(const Trajectory *trj) {
+    unsigned int idx = theVault.size();
+    theVault.resize(idx+1);
+    Trajectory::ConstRecHitContainer & hits = theVault.back();
+    (*trj).validRecHits(hits);
+
+    // seeds are compared with the first "theNumHitsForSeedCleaner" hits only,
+    // and the first hit of the seed must be one of them
+    int ext = std::min(theNumHitsForSeedCleaner,int(hits.size()));
+    for (int i = 0; i < ext; ++i) {
+      auto const & hit = *hits[i];
+      if (!hit.geographicalId().rawId()) continue;
+      //For seeds that are made only of pixel hits, it is pointless to store the 
+      //information about hits on other sub-detector of the trajectory.
+      if( theOnlyPixelHits && 
+	  hit.geographicalId().subdetId() != PixelSubdetector::PixelBarrel && 
+	  hit.geographicalId().subdetId() != PixelSubdetector::PixelEndcap    ) continue;
+      theCache.insert(std::make_pair(clusterKey(hit), idx));
+    }
+}
+
+bool CachingSeedCleanerByClusterKey::good(const TrajectorySeed *seed) {
+  if (seed->nHits()==0){    return true; }
+
+    typedef TrajectorySeed::const_iterator SI;
+    typedef Trajectory::RecHitContainer::const_iterator TI;
+    TrajectorySeed::range range = seed->recHits();
+
+    SI first = range.first, last = range.second;
+    uint64_t key = clusterKey(*first);
+    uint64_t detKey = (uint64_t(first->geographicalId().rawId()) << 32) | 0xffffffff;
+
+    // the trajectories with the cluster of the first hit, then those with
+    // hits on its det that are not made of clusters
+    for (uint64_t k : {key, detKey}) {
+      auto itrange = theCache.equal_range(k);
+      for (auto it = itrange.first; it != itrange.second; ++it) {
+	int ext = std::min(theNumHitsForSeedCleaner,int(theVault[it->second].size()));
+	TI te =  theVault[it->second].begin()+ext;
+	TI t = theVault[it->second].begin();
+	SI curr;
+	for (curr = first; curr != last; ++curr) {
+	  bool found = false;
+	  for (;t != te; ++t) {
+	    if ( curr->sharesInput((**t).hit(),TrackingRecHit::all) ) { found = true; ++t; break; }
+	  }
+	  if (!found) break;
+	}
+	if (curr == last) return false;
+      }
+      if (key == detKey) break;
+    }
+    return true;
+}
@@ -27,6 +27,7 @@
 #include "RecoTracker/CkfPattern/interface/CachingSeedCleanerByHitPosition.h"
 #include "RecoTracker/CkfPattern/interface/SeedCleanerBySharedInput.h"
 #include "RecoTracker/CkfPattern/interface/CachingSeedCleanerBySharedInput.h"
+#include "RecoTracker/CkfPattern/interface/CachingSeedCleanerByClusterKey.h"
 
 #include "RecoTracker/MeasurementDet/interface/MeasurementTrackerEvent.h"
 
@@ -42,10 +43,9 @@
 // #define VI_REPRODUCIBLE
 // #define VI_TBB
 
+#include <iterator>
 #include <thread>
-#ifdef VI_TBB
 #include "tbb/parallel_for.h"
-#endif
 
 #include "RecoTracker/CkfPattern/interface/PrintoutHelper.h"
 
@@ -56,6 +56,33 @@ namespace {
   BaseCkfTrajectoryBuilder *createBaseCkfTrajectoryBuilder(const edm::ParameterSet& pset, edm::ConsumesCollector& iC) {
     return BaseCkfTrajectoryBuilderFactory::get()->create(pset.getParameter<std::string>("ComponentType"), pset, iC);
   }
+
+  RedundantSeedCleaner *createRedundantSeedCleaner(const edm::ParameterSet& conf) {
+    std::string cleaner = conf.getParameter<std::string>("RedundantSeedCleaner");
+    if (cleaner == "SeedCleanerByHitPosition") {
+        return new SeedCleanerByHitPosition();
+    } else if (cleaner == "SeedCleanerBySharedInput") {
+        return new SeedCleanerBySharedInput();
+    } else if (cleaner == "CachingSeedCleanerByHitPosition") {
+        return new CachingSeedCleanerByHitPosition();
+    } else if (cleaner == "CachingSeedCleanerBySharedInput") {
+      int numHitsForSeedCleaner = conf.existsAs<int>("numHitsForSeedCleaner") ?
+	conf.getParameter<int>("numHitsForSeedCleaner") : 4;
+      int onlyPixelHits = conf.existsAs<bool>("onlyPixelHitsForSeedCleaner") ?
+	conf.getParameter<bool>("onlyPixelHitsForSeedCleaner") : false;
+      return new CachingSeedCleanerBySharedInput(numHitsForSeedCleaner,onlyPixelHits);
+    } else if (cleaner == "CachingSeedCleanerByClusterKey") {
+      int numHitsForSeedCleaner = conf.existsAs<int>("numHitsForSeedCleaner") ?
+	conf.getParameter<int>("numHitsForSeedCleaner") : 4;
+      int onlyPixelHits = conf.existsAs<bool>("onlyPixelHitsForSeedCleaner") ?
+	conf.getParameter<bool>("onlyPixelHitsForSeedCleaner") : false;
+      return new CachingSeedCleanerByClusterKey(numHitsForSeedCleaner,onlyPixelHits);
+    } else if (cleaner == "none") {
+        return 0;
+    } else {
+        throw cms::Exception("RedundantSeedCleaner not found", cleaner);
+    }
+  }
 }
 
 namespace cms{
@@ -97,26 +124,19 @@ namespace cms{
         maskPhase2OTs_ = iC.consumes<Phase2OTClusterMask>(conf.getParameter<edm::InputTag>("phase2clustersToSkip"));
       }
 #ifndef VI_REPRODUCIBLE
-    std::string cleaner = conf.getParameter<std::string>("RedundantSeedCleaner");
-    if (cleaner == "SeedCleanerByHitPosition") {
-        theSeedCleaner = new SeedCleanerByHitPosition();
-    } else if (cleaner == "SeedCleanerBySharedInput") {
-        theSeedCleaner = new SeedCleanerBySharedInput();
-    } else if (cleaner == "CachingSeedCleanerByHitPosition") {
-        theSeedCleaner = new CachingSeedCleanerByHitPosition();
-    } else if (cleaner == "CachingSeedCleanerBySharedInput") {
-      int numHitsForSeedCleaner = conf.existsAs<int>("numHitsForSeedCleaner") ?
-	conf.getParameter<int>("numHitsForSeedCleaner") : 4;
-      int onlyPixelHits = conf.existsAs<bool>("onlyPixelHitsForSeedCleaner") ?
-	conf.getParameter<bool>("onlyPixelHitsForSeedCleaner") : false;
-      theSeedCleaner = new CachingSeedCleanerBySharedInput(numHitsForSeedCleaner,onlyPixelHits);
-    } else if (cleaner == "none") {
-        theSeedCleaner = 0;
-    } else {
-        throw cms::Exception("RedundantSeedCleaner not found", cleaner);
-    }
+    theSeedCleaner = createRedundantSeedCleaner(conf);
 #endif
 
+    // Optionally build contiguous batches of seeds concurrently, each with its own builder
+    // and seed cleaner. The seed cleaning (and maxSeedsBeforeCleaning) then only sees the
+    // seeds of the same batch, so the result is the sequential one only without them.
+    unsigned int nBatches = conf.existsAs<unsigned int>("numberOfConcurrentSeedBatches") ?
+      conf.getParameter<unsigned int>("numberOfConcurrentSeedBatches") : 1;
+    for (unsigned int batch = 1; batch < nBatches; ++batch) {
+      theConcurrentBuilders.emplace_back(createBaseCkfTrajectoryBuilder(conf.getParameter<edm::ParameterSet>("TrajectoryBuilderPSet"), iC));
+      if (theSeedCleaner) theConcurrentSeedCleaners.emplace_back(createRedundantSeedCleaner(conf));
+    }
+
 #ifdef VI_REPRODUCIBLE
    std::cout << "CkfTrackCandidateMaker in reproducible setting" << std::endl;
    assert(nullptr==theSeedCleaner);
@@ -152,6 +172,7 @@ namespace cms{
     es.get<NavigationSchoolRecord>().get(theNavigationSchoolName, navigationSchoolH);
     theNavigationSchool = navigationSchoolH.product();
     theTrajectoryBuilder->setNavigationSchool(theNavigationSchool);
+    for (auto & builder : theConcurrentBuilders) builder->setNavigationSchool(theNavigationSchool);
   }
 
   // Functions that gets called by framework every event
@@ -176,6 +197,7 @@ namespace cms{
     e.getByToken(theMTELabel, data);
 
     std::auto_ptr<MeasurementTrackerEvent> dataWithMasks;
+    const MeasurementTrackerEvent* measurementTrackerEvent = &*data;
     if (skipClusters_) {
         edm::Handle<PixelClusterMask> pixelMask;
         e.getByToken(maskPixels_, pixelMask);
@@ -183,7 +205,7 @@ namespace cms{
         e.getByToken(maskStrips_, stripMask);
         dataWithMasks.reset(new MeasurementTrackerEvent(*data, *stripMask, *pixelMask));
         //std::cout << "Trajectory builder " << conf_.getParameter<std::string>("@module_label") << " created with masks " << std::endl;
-        theTrajectoryBuilder->setEvent(e, es, &*dataWithMasks);
+        measurementTrackerEvent = &*dataWithMasks;
     } else if (phase2skipClusters_) {
         //FIXME:just temporary solution for phase2!
         edm::Handle<PixelClusterMask> pixelMask;
@@ -192,11 +214,11 @@ namespace cms{
         e.getByToken(maskPhase2OTs_, phase2OTMask);
         dataWithMasks.reset(new MeasurementTrackerEvent(*data, *pixelMask, *phase2OTMask));
         //std::cout << "Trajectory builder " << conf_.getParameter<std::string>("@module_label") << " created with phase2 masks " << std::endl;
-        theTrajectoryBuilder->setEvent(e, es, &*dataWithMasks);
-    } else {
-        //std::cout << "Trajectory builder " << conf_.getParameter<std::string>("@module_label") << " created without masks " << std::endl;
-        theTrajectoryBuilder->setEvent(e, es, &*data);
+        measurementTrackerEvent = &*dataWithMasks;
     }
+    theTrajectoryBuilder->setEvent(e, es, measurementTrackerEvent);
+    // the MeasurementTrackerEvent is only read while building: it is shared by the concurrent builders
+    for (auto & builder : theConcurrentBuilders) builder->setEvent(e, es, measurementTrackerEvent);
     // TISE ES must be set here due to dependence on theTrajectoryBuilder
     theInitialState->setEventSetup( es, static_cast<TkTransientTrackingRecHitBuilder const *>(theTrajectoryBuilder->hitBuilder())->cloner() );
 
@@ -223,8 +245,6 @@ namespace cms{
       std::vector<Trajectory> rawResult;
       rawResult.reserve(collseed->size() * 4);
 
-      if (theSeedCleaner) theSeedCleaner->init( &rawResult );
-
       // method for debugging
       countSeedsDebugger();
 
@@ -273,7 +293,8 @@ namespace cms{
 #endif
 
       std::atomic<unsigned int> ntseed(0);
-      auto theLoop = [&](size_t ii) {
+      auto theSeedLoop = [&](size_t ii, BaseCkfTrajectoryBuilder & trajectoryBuilder, RedundantSeedCleaner * seedCleaner,
+                             std::vector<Trajectory> & result, unsigned int & lastClean) {
         auto j = indeces[ii];
 
         ntseed++;
@@ -286,7 +307,7 @@ namespace cms{
 
         { Lock lock(theMutex);
 	// Check if seed hits already used by another track
-	if (theSeedCleaner && !theSeedCleaner->good( &((*collseed)[j])) ) {
+	if (seedCleaner && !seedCleaner->good( &((*collseed)[j])) ) {
           LogDebug("CkfTrackCandidateMakerBase")<<" Seed cleaning kills seed "<<j;
           return;  // from the lambda!
         }}
@@ -294,7 +315,7 @@ namespace cms{
 
 	// Build trajectory from seed outwards
         theTmpTrajectories.clear();
-	auto const & startTraj = theTrajectoryBuilder->buildTrajectories( (*collseed)[j], theTmpTrajectories, nullptr );
+	auto const & startTraj = trajectoryBuilder.buildTrajectories( (*collseed)[j], theTmpTrajectories, nullptr );
 
 	LogDebug("CkfPattern") << "======== In-out trajectory building found " << theTmpTrajectories.size()
 			            << " trajectories from seed " << j << " ========\n"
@@ -315,7 +336,7 @@ namespace cms{
 	// seed and if possible further inwards.
 
 	if (doSeedingRegionRebuilding) {
-	  theTrajectoryBuilder->rebuildTrajectories(startTraj,(*collseed)[j],theTmpTrajectories);
+	  trajectoryBuilder.rebuildTrajectories(startTraj,(*collseed)[j],theTmpTrajectories);
 
   	  LogDebug("CkfPattern") << "======== Out-in trajectory building found " << theTmpTrajectories.size()
   			              << " valid/invalid trajectories from seed " << j << " ========\n"
@@ -336,31 +357,34 @@ namespace cms{
 	  if( it->isValid() ) {
 	    it->setSeedRef(collseed->refAt(j));
 	    // Store trajectory
-	    rawResult.push_back(std::move(*it));
+	    result.push_back(std::move(*it));
   	    // Tell seed cleaner which hits this trajectory used.
             //TO BE FIXED: this cut should be configurable via cfi file
-            if (theSeedCleaner && rawResult.back().foundHits()>3) theSeedCleaner->add( &rawResult.back() );
-            //if (theSeedCleaner ) theSeedCleaner->add( & (*it) );
+            if (seedCleaner && result.back().foundHits()>3) seedCleaner->add( &result.back() );
+            //if (seedCleaner ) seedCleaner->add( & (*it) );
 	  }
 	}}
 
         theTmpTrajectories.clear();
 
-	LogDebug("CkfPattern") << "rawResult trajectories found so far = " << rawResult.size();
+	LogDebug("CkfPattern") << "rawResult trajectories found so far = " << result.size();
 
         { Lock lock(theMutex);
-	if ( maxSeedsBeforeCleaning_ >0 && rawResult.size() > maxSeedsBeforeCleaning_+lastCleanResult) {
-          theTrajectoryCleaner->clean(rawResult);
-          rawResult.erase(std::remove_if(rawResult.begin()+lastCleanResult,rawResult.end(),
+	if ( maxSeedsBeforeCleaning_ >0 && result.size() > maxSeedsBeforeCleaning_+lastClean) {
+          theTrajectoryCleaner->clean(result);
+          result.erase(std::remove_if(result.begin()+lastClean,result.end(),
 					 std::not1(std::mem_fun_ref(&Trajectory::isValid))),
-			  rawResult.end());
-          lastCleanResult=rawResult.size();
+			  result.end());
+          lastClean=result.size();
         }
         }
 
       };
       // end of loop over seeds
 
+      if (theConcurrentBuilders.empty()) {
+      auto theLoop = [&](size_t ii) { theSeedLoop(ii, *theTrajectoryBuilder, theSeedCleaner, rawResult, lastCleanResult); };
+      if (theSeedCleaner) theSeedCleaner->init( &rawResult );
 
 #ifdef VI_TBB
      tbb::parallel_for(0UL,collseed_size,1UL,theLoop);
@@ -372,8 +396,30 @@ namespace cms{
        theLoop(j);
       }
 #endif
-      assert(ntseed==collseed_size);
       if (theSeedCleaner) theSeedCleaner->done();
+      } else {
+        // contiguous batches of seeds, each built by one task with its own builder
+        // and seed cleaner: concatenated in batch order, the results are in seed order
+        unsigned int nBatches = theConcurrentBuilders.size()+1;
+        std::vector<std::vector<Trajectory> > batchResults(nBatches);
+        tbb::parallel_for(0U, nBatches, [&](unsigned int batch) {
+          auto & trajectoryBuilder = batch==0 ? *theTrajectoryBuilder : *theConcurrentBuilders[batch-1];
+          auto seedCleaner = (batch==0 || !theSeedCleaner) ? theSeedCleaner : theConcurrentSeedCleaners[batch-1].get();
+          auto & batchResult = batchResults[batch];
+          size_t begin = collseed_size*batch/nBatches, end = collseed_size*(batch+1)/nBatches;
+          batchResult.reserve((end-begin) * 4);
+          unsigned int lastBatchCleanResult=0;
+          if (seedCleaner) seedCleaner->init( &batchResult );
+          for (size_t j = begin; j < end; j++){
+            theSeedLoop(j, trajectoryBuilder, seedCleaner, batchResult, lastBatchCleanResult);
+          }
+          if (seedCleaner) seedCleaner->done();
+        });
+        for (auto & batchResult : batchResults) {
+          std::move(batchResult.begin(), batchResult.end(), std::back_inserter(rawResult));
+        }
+      }
+      assert(ntseed==collseed_size);
 
       // std::cout << "VICkfPattern " << "rawResult trajectories found = " << rawResult.size() << " in " << ntseed << " seeds " << collseed_size << std::endl;
 
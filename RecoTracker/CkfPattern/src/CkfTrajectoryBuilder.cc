@@ -220,9 +220,23 @@ limitedCandidates(const boost::shared_ptr<const TrajectorySeed> & sharedSeed, Te
 	  else last = meas.end();
 	}
 
+	// update the states with all the valid hits in one go
+	std::vector<const TSOS*> predictedStates;
+	std::vector<const TrackingRecHit*> validHits;
+	for(auto itm = meas.begin(); itm != last; itm++) {
+	  if (itm->recHit()->isValid()) {
+	    predictedStates.push_back(&itm->predictedState());
+	    validHits.push_back(&*itm->recHit());
+	  }
+	}
+	std::vector<TSOS> updatedStates(validHits.size());
+	theUpdator->updateBatch(validHits.size(), predictedStates.data(), validHits.data(), updatedStates.data());
+
+	auto upState = updatedStates.begin();
 	for(auto itm = meas.begin(); itm != last; itm++) {
 	  TempTrajectory newTraj = *traj;
-	  updateTrajectory( newTraj, std::move(*itm));
+	  if (itm->recHit()->isValid()) updateTrajectory( newTraj, std::move(*itm), std::move(*upState++));
+	  else updateTrajectory( newTraj, std::move(*itm));
 
 	  if ( toBeContinued(newTraj)) {
 	    newCand.push_back(std::move(newTraj));  std::push_heap(newCand.begin(),newCand.end(),trajCandLess);
@@ -317,6 +331,15 @@ void CkfTrajectoryBuilder::updateTrajectory( TempTrajectory& traj,
   }
 }
 
+void CkfTrajectoryBuilder::updateTrajectory( TempTrajectory& traj,
+					     TM && tm, TSOS && upState) const
+{
+  auto && predictedState = tm.predictedState();
+  auto  && hit = tm.recHit();
+  traj.emplace( std::move(predictedState), std::move(upState),
+	       std::move(hit), tm.estimate(), tm.layer());
+}
+
 
 void 
 CkfTrajectoryBuilder::findCompatibleMeasurements(const TrajectorySeed&seed,
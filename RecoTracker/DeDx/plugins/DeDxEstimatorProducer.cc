@@ -123,11 +123,12 @@ void DeDxEstimatorProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
 
   TrajTrackAssociationCollection::const_iterator cit;
   if(useTrajectory)cit = trajTrackAssociationHandle->begin();
+  DeDxHitCollection dedxHits;  // reused for all the tracks
   for(unsigned int j=0;j<trackCollectionHandle->size();j++){            
      const reco::TrackRef track = reco::TrackRef( trackCollectionHandle.product(), j );
 
      int NClusterSaturating = 0; 
-     DeDxHitCollection dedxHits;
+     dedxHits.clear();
    
      if(useTrajectory){  //trajectory allows to take into account the local direction of the particle on the module sensor --> muc much better 'dx' measurement
         const edm::Ref<std::vector<Trajectory> > traj = cit->key; cit++;
@@ -173,10 +173,10 @@ int getCharge(const SiStripCluster* cluster, int& nSatStrip, const GeomDetUnit&
      }
    }
    else{
+     auto & gains     = calibGains[detUnit.index()-m_off];
      for(unsigned int i=0;i<Ampls.size();i++){
        int calibratedCharge = Ampls[i];
        
-       auto & gains     = calibGains[detUnit.index()-m_off];
        calibratedCharge = (int)(calibratedCharge / gains[(cluster->firstStrip()+i)/128] );
        if ( calibratedCharge>=255 ) {
 	 if ( calibratedCharge>=1025 )
@@ -3,6 +3,7 @@
 
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
+#include <cmath>
 #include <limits>
 
 #include "getBestVertex.h"
@@ -11,13 +12,42 @@ namespace {
   
 template<bool PROMPT>
 struct mva {
+  static constexpr unsigned int nVars = PROMPT ? 16 : 12;
+
   mva(const edm::ParameterSet &){}
   float operator()(reco::Track const & trk,
 		   reco::BeamSpot const & beamSpot,
 		   reco::VertexCollection const & vertices,
 		   GBRForest const * forestP) const {
+    float gbrVals_[nVars];
+    fillInputs(trk,beamSpot,vertices,gbrVals_);
+    return forestP->GetClassifier(gbrVals_);
+  }
+
+  // all the tracks at once: each tree of the forest is applied to all of them in turn
+  void operator()(reco::TrackCollection const & tracks,
+		  reco::BeamSpot const & beamSpot,
+		  reco::VertexCollection const & vertices,
+		  GBRForest const * forestP,
+		  std::vector<float> & mvas) const {
+    std::vector<float> inputs(nVars*tracks.size());
+    size_t current = 0;
+    for (auto const & trk : tracks) {
+      fillInputs(trk,beamSpot,vertices,&inputs[nVars*current++]);
+    }
+    std::vector<double> responses(tracks.size());
+    forestP->GetResponses(inputs.data(),tracks.size(),nVars,responses.data());
+    for (size_t i=0; i<tracks.size(); ++i) {
+      // as GBRForest::GetGradBoostClassifier
+      mvas[i] = 2.0/(1.0+exp(-2.0*responses[i]))-1;
+    }
+  }
+
+  void fillInputs(reco::Track const & trk,
+		  reco::BeamSpot const & beamSpot,
+		  reco::VertexCollection const & vertices,
+		  float * gbrVals_) const {
 
-    auto const & forest = *forestP;
     auto tmva_pt_ = trk.pt();
     auto tmva_ndof_ = trk.ndof();
     auto tmva_nlayers_ = trk.hitPattern().trackerLayersWithMeasurement();
@@ -48,7 +78,6 @@ struct mva {
     auto tmva_minlost_ = std::min(lostIn,lostOut);
     auto tmva_lostmidfrac_ = trk.numberOfLostHits() / (trk.numberOfValidHits() + trk.numberOfLostHits());
    
-    float gbrVals_[PROMPT ? 16 : 12];
     gbrVals_[0] = tmva_pt_;
     gbrVals_[1] = tmva_lostmidfrac_;
     gbrVals_[2] = tmva_minlost_;
@@ -74,12 +103,6 @@ struct mva {
       gbrVals_[14] = tmva_absdz_;
       gbrVals_[15] = tmva_absd0_;
     }
-
- 
-
-    
-    return forest.GetClassifier(gbrVals_);
-    
   }
 
   static const char * name();
@@ -99,6 +122,24 @@ struct mva {
   
 }
 
+// the GBRForest classifiers evaluate the whole collection in one go
+template<>
+void TrackMVAClassifierDetached::computeMVA(reco::TrackCollection const & tracks,
+					    reco::BeamSpot const & beamSpot,
+					    reco::VertexCollection const & vertices,
+					    GBRForest const * forestP,
+					    MVACollection & mvas) const {
+  mva(tracks,beamSpot,vertices,forestP,mvas);
+}
+template<>
+void TrackMVAClassifierPrompt::computeMVA(reco::TrackCollection const & tracks,
+					  reco::BeamSpot const & beamSpot,
+					  reco::VertexCollection const & vertices,
+					  GBRForest const * forestP,
+					  MVACollection & mvas) const {
+  mva(tracks,beamSpot,vertices,forestP,mvas);
+}
+
 #include "FWCore/PluginManager/interface/ModuleDef.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 
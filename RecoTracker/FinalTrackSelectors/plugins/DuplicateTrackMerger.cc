@@ -230,16 +230,25 @@ void DuplicateTrackMerger::produce(edm::Event& iEvent, const edm::EventSetup& iS
 
   std::unique_ptr<CandidateToDuplicate> out_candidateMap(new CandidateToDuplicate());
 
+  // the (charge, index) of the tracks above the pT cut, sorted: each track is paired
+  // only with the following ones of the same charge, in the order of the collection
+  std::vector<std::pair<int,int>> chargeAndIndex;
+  chargeAndIndex.reserve(tracks.size());
+  for(int i = 0; i < (int)tracks.size(); i++){
+    if(tracks[i].innerMomentum().perp2() >= minpT2_) chargeAndIndex.emplace_back(tracks[i].charge(),i);
+  }
+  std::sort(chargeAndIndex.begin(),chargeAndIndex.end());
+
   for(int i = 0; i < (int)tracks.size(); i++){
     const reco::Track *rt1 = &tracks[i];
     if(rt1->innerMomentum().perp2() < minpT2_)continue;
     // if(rt1->innerMomentum().R() < minP_)continue;
-    for(int j = i+1; j < (int)tracks.size();j++){
+    for(auto it = std::upper_bound(chargeAndIndex.begin(),chargeAndIndex.end(),std::make_pair(rt1->charge(),i));
+	it != chargeAndIndex.end() && it->first == rt1->charge(); ++it){
+      int j = it->second;
       const reco::Track *rt2 = &tracks[j];
-      if(rt1->charge() != rt2->charge())continue;
       auto cosT = (*rt1).momentum().unit().Dot((*rt2).momentum().unit());
       if (cosT<0.) continue;
-      if(rt2->innerMomentum().perp2() < minpT2_)continue;
       // if(rt2->innerMomentum().R() < minP_)continue;
       const reco::Track* t1,*t2;
       if(rt1->outerPosition().perp2() < rt2->outerPosition().perp2()){
@@ -108,6 +108,7 @@ class dso_hidden TrackListMerger : public edm::stream::EDProducer<>
 
 
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <iostream>
@@ -457,6 +458,25 @@ TrackListMerger::~TrackListMerger() { }
       std::sort_heap(rh1[i].begin(),rh1[i].end(),compById);
     }
 
+    // two tracks with no hit id in common share no hit: unless a negative share fraction
+    // makes them duplicates anyway, each track is compared only with the ones found here,
+    // from the (id, track) pairs of all the good tracks sorted by id and then by track
+    bool pairOnSharedIds = shareFrac_>=0;
+    for (auto frac : indivShareFrac_) if (frac<0) pairOnSharedIds = false;
+    typedef std::pair<unsigned int, unsigned int> IdTrack;
+    std::vector<IdTrack> tracksOfId;
+    if (pairOnSharedIds) {
+      for ( unsigned int j=0; j<rSize; j++) {
+	if (selected[j]==0) continue;
+	auto const & hits = rh1[indexG[j]];
+	for (unsigned int ih=0; ih!=hits.size(); ++ih)
+	  if (ih==0 || hits[ih].first!=hits[ih-1].first) tracksOfId.emplace_back(hits[ih].first,j);
+      }
+      std::sort(tracksOfId.begin(),tracksOfId.end());
+    }
+    std::vector<unsigned int> partners;
+    partners.reserve(rSize);
+
     //DL here
     if likely(ngood>1 && collsSize>1)
     for ( unsigned int ltm=0; ltm<listsToMerge_.size(); ltm++) {
@@ -482,8 +502,22 @@ TrackListMerger::~TrackListMerger() { }
 	int nhit1 = nh1; // validHits[k1];
 	float score1 = score[k1];
 
+	partners.clear();
+	if (pairOnSharedIds) {
+	  for (unsigned int ih=0; ih!=nh1; ++ih) {
+	    auto const id = rh1[k1][ih].first;
+	    if (ih>0 && id==rh1[k1][ih-1].first) continue;
+	    for (auto it = std::lower_bound(tracksOfId.begin(),tracksOfId.end(),IdTrack(id,i+1));
+		 it!=tracksOfId.end() && it->first==id; ++it) partners.push_back(it->second);
+	  }
+	  std::sort(partners.begin(),partners.end());
+	  partners.erase(std::unique(partners.begin(),partners.end()),partners.end());
+	} else {
+	  for ( unsigned int j=i+1; j<rSize; j++) partners.push_back(j);
+	}
+
 	// start at next collection
-	for ( unsigned int j=i+1; j<rSize; j++) {
+	for (unsigned int j : partners) {
 	  if (selected[j]==0) continue;
 	  unsigned int collNum2=trackCollNum[j];
 	  if ( (collNum == collNum2) && indivShareFrac_[collNum] > 0.99) continue;
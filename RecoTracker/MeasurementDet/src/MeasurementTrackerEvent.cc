@@ -22,6 +22,7 @@ MeasurementTrackerEvent::swap(MeasurementTrackerEvent &other)
         swap(theOwner, other.theOwner);
         swap(theStripClustersToSkip, other.theStripClustersToSkip);
         swap(thePixelClustersToSkip, other.thePixelClustersToSkip);
+        swap(thePhase2OTClustersToSkip, other.thePhase2OTClustersToSkip);
     }
 }
 
@@ -45,10 +46,8 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(const MeasurementTrackerEvent &
         throw cms::Exception("Configuration")<<"The pixel masking does not point to the proper collection of clusters: "<<pixelClustersToSkip.refProd().id()<<"!="<<thePixelData->handle().id()<<"\n";
     }
 
-    theStripClustersToSkip.resize(stripClustersToSkip.size());
     stripClustersToSkip.copyMaskTo(theStripClustersToSkip);
 
-    thePixelClustersToSkip.resize(pixelClustersToSkip.size());
     pixelClustersToSkip.copyMaskTo(thePixelClustersToSkip);
 }
 
@@ -73,9 +72,7 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(const MeasurementTrackerEvent &
         throw cms::Exception("Configuration")<<"The pixel masking does not point to the proper collection of clusters: "<<pixelClustersToSkip.refProd().id()<<"!="<<thePixelData->handle().id()<<"\n";
     }
 
-    thePixelClustersToSkip.resize(pixelClustersToSkip.size());
     pixelClustersToSkip.copyMaskTo(thePixelClustersToSkip);
 
-    thePhase2OTClustersToSkip.resize(phase2OTClustersToSkip.size());
     phase2OTClustersToSkip.copyMaskTo(thePhase2OTClustersToSkip);
 }
@@ -271,7 +271,7 @@ bool Phase1PixelBlade::overlap( const GlobalPoint& crossPoint, const GeomDet& de
 int
 Phase1PixelBlade::findBin( float R,int diskSectorIndex) const
 {
-  vector<const GeomDet*> localDets = diskSectorIndex==0 ? theFrontDets : theBackDets;
+  const vector<const GeomDet*> & localDets = diskSectorIndex==0 ? theFrontDets : theBackDets;
 
 
   int theBin = 0;
@@ -294,10 +294,11 @@ Phase1PixelBlade::findBin2( GlobalPoint thispoint,int diskSectorIndex) const
 
 
   int theBin = 0;
-  float sDiff = (thispoint - localDets.front()->surface().position()).mag();
+  // the closest in distance squared
+  float sDiff = (thispoint - localDets.front()->surface().position()).mag2();
 
   for (vector<const GeomDet*>::const_iterator i=localDets.begin(); i !=localDets.end(); i++){
-    float testDiff = ( thispoint - (**i).surface().position()).mag();
+    float testDiff = ( thispoint - (**i).surface().position()).mag2();
     if ( testDiff < sDiff) {
       sDiff = testDiff;
       theBin = i - localDets.begin();
@@ -311,7 +312,7 @@ Phase1PixelBlade::findBin2( GlobalPoint thispoint,int diskSectorIndex) const
 GlobalPoint
 Phase1PixelBlade::findPosition(int index,int diskSectorType) const
 {
-  vector<const GeomDet*> diskSector = diskSectorType == 0 ? theFrontDets : theBackDets;
+  const vector<const GeomDet*> & diskSector = diskSectorType == 0 ? theFrontDets : theBackDets;
   return (diskSector[index])->surface().position();
 }
 
@@ -150,22 +150,20 @@ PixelForwardLayerPhase1::groupedCompatibleDetsV( const TrajectoryStateOnSurface&
 	int crossingSide = LayerCrossingSide().endcapSide( tsos, prop);
 	int theHelicity = computeHelicity(theComps[theBinFinder_inner.binIndex(crossings_inner.closestIndex)],
 					  theComps[theBinFinder_inner.binIndex(crossings_inner.nextIndex)] );
-	std::vector<DetGroup> tmp99 = closestResult_inner;
-	DetGroupMerger::orderAndMergeTwoLevels( std::move(tmp99), std::move(nextResult_inner), result_inner,
+	// the neighbours are searched around the closest det after the merge
+	DetGroupElement closestGel( closestResult_inner.front().front());
+	float window = computeWindowSize( closestGel.det(), closestGel.trajectoryState(), est);
+	DetGroupMerger::orderAndMergeTwoLevels( std::move(closestResult_inner), std::move(nextResult_inner), result_inner,
 						theHelicity, crossingSide);
 	if (theHelicity == crossingSide) frontindex_inner = crossings_inner.closestIndex;
 	else                             frontindex_inner = crossings_inner.nextIndex;
+	searchNeighbors( tsos, prop, est, crossings_inner, window, result_inner, true);
       } else {
 	result_inner.swap(closestResult_inner);
 	frontindex_inner = crossings_inner.closestIndex;
       }
     }
   }
-  if(!closestResult_inner.empty()){
-    DetGroupElement closestGel( closestResult_inner.front().front());
-    float window = computeWindowSize( closestGel.det(), closestGel.trajectoryState(), est);
-    searchNeighbors( tsos, prop, est, crossings_inner, window, result_inner, true);
-  }
 
   //DetGroupElement closestGel( closestResult.front().front());
   //float window = computeWindowSize( closestGel.det(), closestGel.trajectoryState(), est);
@@ -185,21 +183,19 @@ PixelForwardLayerPhase1::groupedCompatibleDetsV( const TrajectoryStateOnSurface&
       int crossingSide = LayerCrossingSide().endcapSide( tsos, prop);
       int theHelicity = computeHelicity(theComps[theBinFinder_outer.binIndex(crossings_outer.closestIndex) + _num_innerpanels],
   					theComps[theBinFinder_outer.binIndex(crossings_outer.nextIndex) + _num_innerpanels] );
-      std::vector<DetGroup> tmp99 = closestResult_outer;
-      DetGroupMerger::orderAndMergeTwoLevels( std::move(tmp99), std::move(nextResult_outer), result_outer,
+      // the neighbours are searched around the closest det after the merge
+      DetGroupElement closestGel( closestResult_outer.front().front());
+      float window = computeWindowSize( closestGel.det(), closestGel.trajectoryState(), est);
+      DetGroupMerger::orderAndMergeTwoLevels( std::move(closestResult_outer), std::move(nextResult_outer), result_outer,
                                               theHelicity, crossingSide);
       if (theHelicity == crossingSide) frontindex_outer = crossings_outer.closestIndex;
       else                             frontindex_outer = crossings_outer.nextIndex;
+      searchNeighbors( tsos, prop, est, crossings_outer, window, result_outer, false);
     } else {
       result_outer.swap(closestResult_outer);
       frontindex_outer = crossings_outer.closestIndex;
     }
   }
-  if(!closestResult_outer.empty()){
-    DetGroupElement closestGel( closestResult_outer.front().front());
-    float window = computeWindowSize( closestGel.det(), closestGel.trajectoryState(), est);
-    searchNeighbors( tsos, prop, est, crossings_outer, window, result_outer, false);
-  }
 
   if(result_inner.empty() && result_outer.empty() ) return;
   if(result_inner.empty()) result.swap(result_outer);
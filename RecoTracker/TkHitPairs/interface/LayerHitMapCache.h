@@ -3,12 +3,19 @@
 
 /** A cache adressable by DetLayer* and TrackingRegion* .
  *  Used to cache all the hits of a DetLayer.
+ *  The hits of a layer queried by more than one region of an event
+ *  are also kept sorted in phi, across the regions, for
+ *  TrackingRegion::regionHits.
  */
 
 #include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
 #include "RecoTracker/TkHitPairs/interface/RecHitsSortedInPhi.h"
 #include "TrackingTools/TransientTrackingRecHit/interface/SeedingLayerSetsHits.h"
 #include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/Event.h"
+
+#include <memory>
+#include <vector>
 
 
 class LayerHitMapCache {
@@ -52,7 +59,9 @@ public:
     assert (key>=0);
     const RecHitsSortedInPhi * lhm = theCache.get(key);
     if (lhm==nullptr) {
-      lhm=new RecHitsSortedInPhi (region.hits(iEvent,iSetup,layer), region.origin(), layer.detLayer());
+      auto const * layerHits = sortedLayerHits(layer, iEvent);
+      lhm=new RecHitsSortedInPhi (layerHits ? region.regionHits(iEvent,iSetup,*layerHits) : region.hits(iEvent,iSetup,layer),
+				  region.origin(), layer.detLayer());
       lhm->theOrigin = region.origin();
       LogDebug("LayerHitMapCache")<<" I got"<< lhm->all().second-lhm->all().first<<" hits in the cache for: "<<layer.detLayer();
       theCache.add( key, lhm);
@@ -65,7 +74,29 @@ public:
   }
 
 private:
+  // made at the second region asking for the layer in the event
+  const TrackingRegion::LayerHits * sortedLayerHits(const SeedingLayerSetsHits::SeedingLayer& layer,
+						    const edm::Event & iEvent) {
+    if (iEvent.cacheIdentifier() != theEventId) {
+      theEventId = iEvent.cacheIdentifier();
+      theLayerHits.clear();
+      theNRegions.clear();
+    }
+    unsigned int key = layer.index();
+    if (key >= theLayerHits.size()) {
+      theLayerHits.resize(key+1);
+      theNRegions.resize(key+1,0);
+    }
+    auto & layerHits = theLayerHits[key];
+    if (layerHits && layerHits->layer().detLayer() != layer.detLayer()) layerHits.reset();
+    if (!layerHits && ++theNRegions[key] > 1) layerHits = std::make_unique<TrackingRegion::LayerHits>(layer);
+    return layerHits.get();
+  }
+
   Cache theCache; 
+  edm::Event::CacheIdentifier_t theEventId = 0;
+  std::vector<std::unique_ptr<TrackingRegion::LayerHits>> theLayerHits;
+  std::vector<unsigned int> theNRegions;
 };
 
 #endif
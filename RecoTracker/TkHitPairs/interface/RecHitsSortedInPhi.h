@@ -10,6 +10,9 @@
 /** A RecHit container sorted in phi.
  *  Provides fast access for hits in a given phi window
  *  using binary search.
+ *  Besides the hits, it keeps their positions, errors and ids
+ *  as structure of arrays, so that the seeding loops can run
+ *  over plain floats instead of going through the hits.
  */
 
 class RecHitsSortedInPhi {
@@ -84,7 +87,7 @@ public:
   }
 
 public:
-  float       phi(int i) const { return theHits[i].phi();}
+  float       phi(int i) const { return gphi[i];}
   float        gv(int i) const { return isBarrel ? z[i] : gp(i).perp();}  // global v
   float        rv(int i) const { return isBarrel ? u[i] : v[i];}  // dispaced r
   GlobalPoint gp(int i) const { return GlobalPoint(x[i],y[i],z[i]);}
@@ -102,6 +105,10 @@ public:
   std::vector<float> y;
   std::vector<float> z;
   std::vector<float> drphi;
+  std::vector<float> gphi;  // as in theHits, sorted: used by the binary search
+
+  std::vector<unsigned int> detId;
+  std::vector<unsigned int> clusterIndex; // of the first cluster of the hit
 
   // barrel: u=r, v=z, forward the opposite...
   std::vector<float> u;
@@ -149,8 +149,11 @@ void HitPairGeneratorFromLayerPair::doublets(const TrackingRegion& region,
 
   // constexpr float nSigmaRZ = std::sqrt(12.f);
   constexpr float nSigmaPhi = 3.f;
-  for (int io = 0; io!=int(outerHitsMap.theHits.size()); ++io) {
-    if (!deltaPhi.prefilter(outerHitsMap.x[io],outerHitsMap.y[io])) continue;
+  int nOuter = outerHitsMap.theHits.size();
+  bool prefiltered[nOuter];
+  deltaPhi.prefilter(nOuter, outerHitsMap.x.data(), outerHitsMap.y.data(), prefiltered);
+  for (int io = 0; io!=nOuter; ++io) {
+    if (!prefiltered[io]) continue;
     Hit const & ohit =  outerHitsMap.theHits[io].hit();
     PixelRecoRange<float> phiRange = deltaPhi(outerHitsMap.x[io],
 					      outerHitsMap.y[io],
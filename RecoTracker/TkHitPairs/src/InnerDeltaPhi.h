@@ -33,6 +33,12 @@ public:
    return xHit*xHit + yHit*yHit > theRLayer*theRLayer;
   }
 
+  // same as above for n hits at once, in a loop the compiler can vectorize
+  void prefilter( int n, float const * xHit, float const * yHit, bool * ok) const {
+   float r2 = theRLayer*theRLayer;
+   for (int i=0; i!=n; ++i) ok[i] = xHit[i]*xHit[i] + yHit[i]*yHit[i] > r2;
+  }
+
   PixelRecoRange<float> operator()( float xHit, float yHit, float zHit, float errRPhi) const {
     return phiRange( Point2D(xHit,yHit), zHit, errRPhi); 
   }
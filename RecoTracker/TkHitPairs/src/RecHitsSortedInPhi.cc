@@ -9,7 +9,8 @@
 RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint const & origin, DetLayer const * il) :
   layer(il),
   isBarrel(il->isBarrel()),
-  x(hits.size()),y(hits.size()),z(hits.size()),drphi(hits.size()),
+  x(hits.size()),y(hits.size()),z(hits.size()),drphi(hits.size()),gphi(hits.size()),
+  detId(hits.size()),clusterIndex(hits.size()),
   u(hits.size()),v(hits.size()),du(hits.size()),dv(hits.size()),
   lphi(hits.size())
 {
@@ -38,6 +39,9 @@ RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint
     y[i] = gs.position.y();
     z[i] = lz;
     drphi[i] = gs.errorRPhi;
+    gphi[i] = theHits[i].phi();
+    detId[i] = h.rawId();
+    clusterIndex[i] = h.firstClusterRef().index();
     u[i] = isBarrel ? lr : lz;
     v[i] = isBarrel ? lz : lr;
     du[i] = isBarrel ? dr : dz;
@@ -105,7 +109,8 @@ std::vector<RecHitsSortedInPhi::Hit> RecHitsSortedInPhi::hits( float phiMin, flo
 RecHitsSortedInPhi::Range 
 RecHitsSortedInPhi::unsafeRange( float phiMin, float phiMax) const
 {
-  auto low = std::lower_bound( theHits.begin(), theHits.end(), HitWithPhi(phiMin), HitLessPhi());
-  return Range( low,
-	       std::upper_bound(low, theHits.end(), HitWithPhi(phiMax), HitLessPhi()));
+  // search the contiguous phi array rather than the hits
+  auto low = std::lower_bound( gphi.begin(), gphi.end(), phiMin);
+  auto high = std::upper_bound( low, gphi.end(), phiMax);
+  return Range( theHits.begin()+(low-gphi.begin()), theHits.begin()+(high-gphi.begin()));
 }
@@ -161,6 +161,13 @@ public:
       const edm::EventSetup& es,
       const SeedingLayerSetsHits::SeedingLayer& layer) const override;
 
+  /// the hits in the phi window of the region at the layer are found
+  /// with a binary search, before the same checks as in hits()
+  virtual TrackingRegion::Hits regionHits(
+      const edm::Event& ev,
+      const edm::EventSetup& es,
+      const LayerHits& layerHits) const override;
+
   virtual HitRZCompatibility * checkRZ(const DetLayer* layer,  
 				       const Hit &  outerHit,
 				       const edm::EventSetup&iSetup,
@@ -185,6 +192,8 @@ private:
   std::unique_ptr<MeasurementEstimator> estimator(const BarrelDetLayer* layer,const edm::EventSetup& iSetup) const dso_internal;
   std::unique_ptr<MeasurementEstimator> estimator(const ForwardDetLayer* layer,const edm::EventSetup& iSetup) const dso_internal;
 
+  bool useMeasurementTracker(const DetLayer* layer) const dso_internal;
+
   OuterHitPhiPrediction phiWindow(const edm::EventSetup& iSetup) const dso_internal;
   HitRZConstraint rzConstraint() const dso_internal;
 
@@ -47,6 +47,41 @@ public:
   typedef SeedingLayerSetsHits::Hits Hits;
   using   ctfHits = ctfseeding::SeedingLayer::Hits;
 
+  /** The hits of a layer with their r, z and phi, and their order in phi.
+   *  Made once per event and layer, they serve the hit selection of all
+   *  the regions of the event through regionHits.
+   */
+  class LayerHits {
+  public:
+    explicit LayerHits(const SeedingLayerSetsHits::SeedingLayer& layer);
+
+    const SeedingLayerSetsHits::SeedingLayer& layer() const { return theLayer; }
+    /// as layer().hits()
+    const Hits& hits() const { return theHits; }
+    bool empty() const { return theHits.empty(); }
+
+    float r(unsigned int i) const { return theR[i]; }
+    float z(unsigned int i) const { return theZ[i]; }
+    float phi(unsigned int i) const { return thePhi[i]; }
+    float rMin() const { return theRMin; }
+    float rMax() const { return theRMax; }
+
+    /// adds the indices of the hits with phi in [phiMin, phiMax], modulo 2pi, in the order of hits():
+    /// the interval must be shorter than 2pi
+    void inPhi(float phiMin, float phiMax, std::vector<unsigned int>& indices) const;
+
+  private:
+    SeedingLayerSetsHits::SeedingLayer theLayer;
+    Hits theHits;
+    std::vector<float> theR;
+    std::vector<float> theZ;
+    std::vector<float> thePhi;
+    std::vector<unsigned int> theOrderInPhi;
+    std::vector<float> theSortedPhi;
+    float theRMin = 0.f;
+    float theRMax = 0.f;
+  };
+
 public:
 
   TrackingRegion( const GlobalVector & direction,
@@ -100,6 +135,12 @@ public:
 		    const edm::Event& ev,
 		    const edm::EventSetup& es,
 		    const SeedingLayerSetsHits::SeedingLayer& layer) const = 0;
+
+  /// as hits(), from the hits of the layer prepared once for all the regions of the event
+  virtual Hits regionHits(
+		    const edm::Event& ev,
+		    const edm::EventSetup& es,
+		    const LayerHits& layerHits) const { return hits(ev, es, layerHits.layer()); }
   
   /// clone region with new vertex position
   TrackingRegion* restrictedRegion( const GlobalPoint &  originPos,
@@ -19,6 +19,8 @@
 
 #include "FWCore/Utilities/interface/Visibility.h"
 
+#include <algorithm>
+
 template<typename Algo>
 class dso_internal OuterHitCompatibility {
 public:
@@ -42,6 +44,20 @@ public:
      return checkPhi(hitPhi, hitR);
    }
 
+  /// as above, from the r, z and phi of the hit
+  bool operator() (float hitR, float hitZ, float hitPhi) const {
+    return theRZCompatibility(hitR,hitZ) && checkPhi(hitPhi, hitR);
+  }
+
+  /// a phi range containing the ones of checkPhi for all the radii in [rMin, rMax]:
+  /// the half width grows with r*curvature and with originRBound/r, so that
+  /// its largest value is at one of the two ends
+  PixelRecoRange<float> phiRange(float rMin, float rMax) const {
+    auto atMin = thePhiPrediction(rMin);
+    auto atMax = thePhiPrediction(rMax);
+    return PixelRecoRange<float>(std::min(atMin.min(),atMax.min()), std::max(atMin.max(),atMax.max()));
+  }
+
 
   bool checkPhi(float phi, float r) const {
     auto hitPhiRange = thePhiPrediction(r);
@@ -37,6 +37,7 @@
 #include<iostream>
 #include <algorithm>
 #include <cctype>
+#include <numeric>
 
 namespace {
 template <class T> T sqr( T t) {return t*t;}
@@ -299,6 +300,12 @@ HitRZConstraint
 			 );
 }
 
+bool RectangularEtaPhiTrackingRegion::useMeasurementTracker(const DetLayer* detLayer) const {
+  if(theMeasurementTrackerUsage == UseMeasurementTracker::kAlways) return true;
+  return theMeasurementTrackerUsage == UseMeasurementTracker::kForSiStrips &&
+    GeomDetEnumerators::isTrackerStrip(detLayer->subDetector());
+}
+
 TrackingRegion::Hits RectangularEtaPhiTrackingRegion::hits(
       const edm::Event& ev,
       const edm::EventSetup& es,
@@ -309,12 +316,7 @@ TrackingRegion::Hits RectangularEtaPhiTrackingRegion::hits(
 
   const DetLayer * detLayer = layer.detLayer();
 
-  bool measurementMethod = false;
-  if(theMeasurementTrackerUsage == UseMeasurementTracker::kAlways) measurementMethod = true;
-  else if(theMeasurementTrackerUsage == UseMeasurementTracker::kForSiStrips &&
-          GeomDetEnumerators::isTrackerStrip(detLayer->subDetector())) measurementMethod = true;
-
-  if(measurementMethod) {
+  if(useMeasurementTracker(detLayer)) {
     edm::ESHandle<MagneticField> field;
     es.get<IdealMagneticFieldRecord>().get(field);
     const MagneticField * magField = field.product();
@@ -423,6 +425,53 @@ TrackingRegion::Hits RectangularEtaPhiTrackingRegion::hits(
   return result;
 }
 
+namespace {
+  template<typename Algo>
+  TrackingRegion::Hits selectHits(OuterHitCompatibility<Algo> const & hitComp,
+				  TrackingRegion::LayerHits const & layerHits) {
+    TrackingRegion::Hits result;
+    if (layerHits.empty()) return result;
+
+    std::vector<unsigned int> indices;
+    auto phiRange = hitComp.phiRange(layerHits.rMin(), layerHits.rMax());
+    // beyond pi the phi check itself no longer takes the whole window
+    if (phiRange.max()-phiRange.min() < float(M_PI)) {
+      constexpr float margin = 1.e-3f; // for the approximate asin of OuterHitPhiPrediction
+      layerHits.inPhi(phiRange.min()-margin, phiRange.max()+margin, indices);
+    } else {
+      indices.resize(layerHits.hits().size());
+      std::iota(indices.begin(),indices.end(),0);
+    }
+
+    result.reserve(indices.size());
+    for (auto i : indices) {
+      if ( hitComp(layerHits.r(i), layerHits.z(i), layerHits.phi(i)) )
+	result.emplace_back( layerHits.hits()[i] );
+    }
+    return result;
+  }
+}
+
+TrackingRegion::Hits RectangularEtaPhiTrackingRegion::regionHits(
+      const edm::Event& ev,
+      const edm::EventSetup& es,
+      const LayerHits& layerHits) const {
+  const DetLayer * detLayer = layerHits.layer().detLayer();
+  if(useMeasurementTracker(detLayer)) return hits(ev, es, layerHits.layer());
+
+  if (detLayer->location() == GeomDetEnumerators::barrel) {
+    const BarrelDetLayer& bl = dynamic_cast<const BarrelDetLayer&>(*detLayer);
+    auto est = estimator(&bl,es);
+    if (!est) return TrackingRegion::Hits();
+    return selectHits((reinterpret_cast<OuterEstimator<HitZCheck> const&>(*est)).hitCompatibility(), layerHits);
+  } else {
+    const ForwardDetLayer& fl = dynamic_cast<const ForwardDetLayer&>(*detLayer);
+    auto est = estimator(&fl,es);
+    if (!est) return TrackingRegion::Hits();
+    return selectHits((reinterpret_cast<OuterEstimator<HitRCheck> const&>(*est)).hitCompatibility(), layerHits);
+  }
+}
+
 std::string RectangularEtaPhiTrackingRegion::print() const {
   std::ostringstream str;
   str << TrackingRegionBase::print() 
@@ -0,0 +1,47 @@
+#include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
+#include "DataFormats/Math/interface/approx_atan2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+TrackingRegion::LayerHits::LayerHits(const SeedingLayerSetsHits::SeedingLayer& layer) :
+  theLayer(layer), theHits(layer.hits())
+{
+  auto const n = theHits.size();
+  theR.reserve(n);
+  theZ.reserve(n);
+  thePhi.reserve(n);
+  // as in OuterHitCompatibility
+  for (auto const & hit : theHits) {
+    auto hitPos = hit->globalPosition();
+    theR.push_back(hitPos.perp());
+    theZ.push_back(hitPos.z());
+    thePhi.push_back(unsafe_atan2f<9>(hitPos.y(),hitPos.x()));
+  }
+  if (n==0) return;
+
+  theOrderInPhi.resize(n);
+  std::iota(theOrderInPhi.begin(),theOrderInPhi.end(),0);
+  std::sort(theOrderInPhi.begin(),theOrderInPhi.end(),
+	    [this](unsigned int i, unsigned int j) { return thePhi[i] < thePhi[j]; });
+  theSortedPhi.reserve(n);
+  for (auto i : theOrderInPhi) theSortedPhi.push_back(thePhi[i]);
+
+  auto rRange = std::minmax_element(theR.begin(),theR.end());
+  theRMin = *rRange.first;
+  theRMax = *rRange.second;
+}
+
+void TrackingRegion::LayerHits::inPhi(float phiMin, float phiMax, std::vector<unsigned int>& indices) const
+{
+  auto const first = indices.size();
+  // the phi of the hits are in [-pi,pi], the interval may be anywhere near it
+  constexpr float twoPi = 2.f*float(M_PI);
+  for (float shift : {-twoPi, 0.f, twoPi}) {
+    auto b = std::lower_bound(theSortedPhi.begin(),theSortedPhi.end(),phiMin+shift);
+    auto e = std::upper_bound(b,theSortedPhi.end(),phiMax+shift);
+    for (auto it = b; it != e; ++it) indices.push_back(theOrderInPhi[it-theSortedPhi.begin()]);
+  }
+  std::sort(indices.begin()+first,indices.end());
+}
@@ -137,6 +137,15 @@ public:
 		  int qualityMask=0,
 		  signed char nLoops=0);
 
+  /// Construct the Track of a Trajectory already fitted to the hits of the
+  /// Track theT, instead of refitting it (for Refitter); takes over theTraj
+  bool buildTrackFromFit(Trajectory * theTraj,
+			 const T & theT,
+			 const MagneticField *,
+			 const Propagator *,
+			 AlgoProductCollection& ,
+			 const reco::BeamSpot&);
+
 
  private:
   reco::TrackBase::TrackAlgorithm algo_;
@@ -148,6 +157,16 @@ public:
   bool geometricInnerState_;
   bool usePropagatorForPCA_;
 
+  /// The Track of a fitted Trajectory
+  bool buildTrackFromTrajectory(Trajectory * theTraj,
+				const MagneticField *,
+				const Propagator *,
+				AlgoProductCollection& ,
+				PropagationDirection seedDir,
+				const reco::BeamSpot&,
+				int qualityMask,
+				signed char nLoops);
+
   TrajectoryStateOnSurface getInitialState(const T * theT,
 					   TransientTrackingRecHit::RecHitContainer& hits,
 					   const TrackingGeometry * theG,
@@ -171,6 +190,25 @@ TrackProducerAlgorithm<reco::Track>::buildTrack(const TrajectoryFitter *,
 						signed char nLoops);
 
 
+template <> bool
+TrackProducerAlgorithm<reco::Track>::buildTrackFromFit(Trajectory *,
+						       const reco::Track &,
+						       const MagneticField *,
+						       const Propagator *,
+						       AlgoProductCollection& ,
+						       const reco::BeamSpot&);
+
+template <> bool
+TrackProducerAlgorithm<reco::Track>::buildTrackFromTrajectory(Trajectory *,
+							      const MagneticField *,
+							      const Propagator *,
+							      AlgoProductCollection& ,
+							      PropagationDirection,
+							      const reco::BeamSpot&,
+							      int qualityMask,
+							      signed char nLoops);
+
+
 template <> bool
 TrackProducerAlgorithm<reco::GsfTrack>::buildTrack(const TrajectoryFitter *,
 						   const Propagator *,
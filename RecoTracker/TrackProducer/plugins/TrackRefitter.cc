@@ -5,6 +5,10 @@
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Common/interface/Provenance.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "DataFormats/Provenance/interface/Provenance.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
 
 #include "TrackingTools/PatternTools/interface/Trajectory.h"
 #include "TrackingTools/PatternTools/interface/TrajTrackAssociation.h"
@@ -36,6 +40,14 @@ TrackRefitter::TrackRefitter(const edm::ParameterSet& iConfig):
     throw cms::Exception("TrackRefitter") << "unknown type of contraint! Set it to 'momentum', 'vertex', 'trackParameters' or leave it empty";    
   }
 
+  // the trajectories of the input tracks, from a producer run with the same fitter in this process
+  reuseTrajectories_ = iConfig.exists("reuseTrajectories") && !iConfig.getParameter<edm::InputTag>("reuseTrajectories").label().empty();
+  if (reuseTrajectories_) {
+    if (constraint_ != none)
+      throw cms::Exception("TrackRefitter") << "reuseTrajectories can only be used without constraint";
+    reuseTrajectoriesToken_ = consumes<TrajTrackAssociationCollection>(iConfig.getParameter<edm::InputTag>("reuseTrajectories"));
+  }
+
   //register your products
   produces<reco::TrackCollection>().setBranchAlias( alias_ + "Tracks" );
   produces<reco::TrackExtraCollection>().setBranchAlias( alias_ + "TrackExtras" );
@@ -92,10 +104,37 @@ void TrackRefitter::produce(edm::Event& theEvent, const edm::EventSetup& setup)
 	edm::LogError("TrackRefitter")<<"could not get the reco::TrackCollection."; break;}
       LogDebug("TrackRefitter") << "run the algorithm" << "\n";
 
+      if (!reuseTrajectories_) {
+	try {
+	  theAlgo.runWithTrack(theG.product(), theMF.product(), *theTCollection, 
+			       theFitter.product(), thePropagator.product(), 
+			       theBuilder.product(), bs, algoResults);
+	}catch (cms::Exception &e){ edm::LogError("TrackProducer") << "cms::Exception caught during theAlgo.runWithTrack." << "\n" << e << "\n"; throw; }
+	break;
+      }
+
+      // the tracks with a trajectory are rebuilt from it, the others are refitted
+      edm::Handle<TrajTrackAssociationCollection> theAssociation;
+      theEvent.getByToken(reuseTrajectoriesToken_, theAssociation);
+      checkReusedTrajectories(theAssociation);
+      std::vector<const Trajectory *> trajectories(theTCollection->size(), nullptr);
+      for (auto const & a : *theAssociation) {
+	if (a.val.id() != theTCollection.id())
+	  throw cms::Exception("TrackRefitter") << "reuseTrajectories: the trajectories are not associated to the input tracks";
+	trajectories[a.val.key()] = &(*a.key);
+      }
       try {
-	theAlgo.runWithTrack(theG.product(), theMF.product(), *theTCollection, 
-			     theFitter.product(), thePropagator.product(), 
-			     theBuilder.product(), bs, algoResults);
+	for (unsigned int i = 0; i != theTCollection->size(); ++i) {
+	  auto const & theT = (*theTCollection)[i];
+	  if (trajectories[i]) {
+	    theAlgo.buildTrackFromFit(new Trajectory(*trajectories[i]), theT, theMF.product(), thePropagator.product(), algoResults, bs);
+	  } else {
+	    reco::TrackCollection one(1, theT);
+	    theAlgo.runWithTrack(theG.product(), theMF.product(), one, 
+				 theFitter.product(), thePropagator.product(), 
+				 theBuilder.product(), bs, algoResults);
+	  }
+	}
       }catch (cms::Exception &e){ edm::LogError("TrackProducer") << "cms::Exception caught during theAlgo.runWithTrack." << "\n" << e << "\n"; throw; }
       break;
     }
@@ -161,3 +200,27 @@ void TrackRefitter::produce(edm::Event& theEvent, const edm::EventSetup& setup)
   LogDebug("TrackRefitter") << "end" << "\n";
 }
 
+void TrackRefitter::checkReusedTrajectories(const edm::Handle<TrajTrackAssociationCollection>& theAssociation)
+{
+  const edm::Provenance& provenance = *theAssociation.provenance();
+  if (provenance.branchID() == checkedTrajectoriesBranchID_) return;
+
+  // All the modules of a process see the same EventSetup for a given event: the trajectories
+  // fitted earlier in this process used the same IOVs of the conditions and geometry. The ones
+  // read from a file may have been fitted with any other, which can't be told from the event.
+  if (provenance.processName() != moduleDescription().processName())
+    throw cms::Exception("TrackRefitter") << "reuseTrajectories: the trajectories " << provenance.moduleLabel()
+					  << " were fitted in process " << provenance.processName()
+					  << ", with conditions and geometry which may differ from the ones of process "
+					  << moduleDescription().processName() << "; refit the tracks instead";
+
+  const edm::ParameterSet& producerConf = edm::parameterSet(provenance);
+  for (auto const & component : {"Fitter", "Propagator", "TTRHBuilder"}) {
+    if (!producerConf.existsAs<std::string>(component) ||
+	producerConf.getParameter<std::string>(component) != getConf().getParameter<std::string>(component))
+      throw cms::Exception("TrackRefitter") << "reuseTrajectories: the trajectories " << provenance.moduleLabel()
+					    << " were not fitted with the " << component << " '"
+					    << getConf().getParameter<std::string>(component) << "' of this refitter";
+  }
+  checkedTrajectoriesBranchID_ = provenance.branchID();
+}
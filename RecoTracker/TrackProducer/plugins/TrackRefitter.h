@@ -10,6 +10,8 @@
 #include "FWCore/Framework/interface/stream/EDProducer.h"
 #include "RecoTracker/TrackProducer/interface/KfTrackProducerBase.h"
 #include "RecoTracker/TrackProducer/interface/TrackProducerAlgorithm.h"
+#include "TrackingTools/PatternTools/interface/TrajTrackAssociation.h"
+#include "DataFormats/Provenance/interface/BranchID.h"
 
 class TrackRefitter : public KfTrackProducerBase, public edm::stream::EDProducer<> {
 public:
@@ -25,6 +27,15 @@ private:
   enum Constraint { none, momentum, vertex, trackParameters };
   Constraint constraint_;
   edm::EDGetToken trkconstrcoll_;
+  // trajectories fitted to the input tracks by their producer, used instead of refitting them
+  bool reuseTrajectories_;
+  edm::EDGetTokenT<TrajTrackAssociationCollection> reuseTrajectoriesToken_;
+  // branch of the reused trajectories last found consistent with this refitter
+  edm::BranchID checkedTrajectoriesBranchID_;
+
+  /// Throws unless the trajectories were fitted in this process, hence with the same
+  /// conditions and geometry, and with the same fitter, propagator and hit builder
+  void checkReusedTrajectories(const edm::Handle<TrajTrackAssociationCollection>&);
 
 };
 
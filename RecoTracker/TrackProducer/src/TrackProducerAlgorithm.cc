@@ -112,7 +112,36 @@ TrackProducerAlgorithm<reco::Track>::buildTrack (const TrajectoryFitter * theFit
   
   auto theTraj = new Trajectory(std::move(trajTmp));
   theTraj->setSeedRef(seedRef);
-  
+
+  return buildTrackFromTrajectory(theTraj, theTSOS.magneticField(), thePropagator, algoResults, seedDir, bs, qualityMask, nLoops);
+}
+
+template <> bool
+TrackProducerAlgorithm<reco::Track>::buildTrackFromFit(Trajectory * theTraj,
+						       const reco::Track & theT,
+						       const MagneticField * theMF,
+						       const Propagator * thePropagator,
+						       AlgoProductCollection& algoResults,
+						       const reco::BeamSpot& bs)
+{
+  //propagate the old algo name, as in runWithTrack
+  algo_=theT.algo();
+  originalAlgo_ = theT.originalAlgo();
+  algoMask_ = theT.algoMask();
+  stopReason_ = theT.stopReason();
+
+  return buildTrackFromTrajectory(theTraj, theMF, thePropagator, algoResults, theT.seedDirection(), bs, theT.qualityMask(), theT.nLoops());
+}
+
+template <> bool
+TrackProducerAlgorithm<reco::Track>::buildTrackFromTrajectory(Trajectory * theTraj,
+							      const MagneticField * theMF,
+							      const Propagator * thePropagator,
+							      AlgoProductCollection& algoResults,
+							      PropagationDirection seedDir,
+							      const reco::BeamSpot& bs,
+							      int qualityMask,signed char nLoops)
+{
   statCount.hits(theTraj->foundHits(),theTraj->lostHits());
   statCount.algo(int(algo_));
 
@@ -123,14 +152,14 @@ TrackProducerAlgorithm<reco::Track>::buildTrack (const TrajectoryFitter * theFit
   //  innertsos = theTraj->lastMeasurement().updatedState();
   // }
   
-  ndof = 0;
+  float ndof = 0;
   for (auto const & tm : theTraj->measurements()) {
     auto const & h = tm.recHitR();
     if (h.isValid()) ndof = ndof + float(h.dimension())*h.weight();  // two virtual calls!
   }
   
   ndof -= 5.f;
-  if unlikely(std::abs(theTSOS.magneticField()->nominalValue())<DBL_MIN) ++ndof;  // same as -4
+  if unlikely(std::abs(theMF->nominalValue())<DBL_MIN) ++ndof;  // same as -4
  
 
 #if defined(VI_DEBUG) || defined(EDM_ML_DEBUG)
@@ -160,7 +189,7 @@ for (auto const & tm : theTraj->measurements()) {
  }
 
    std::ostringstream ss;
-   ss << algo_ << ": " <<  hits.size() <<'|' <<theTraj->measurements().size()<<'|' << int(nLoops) << ' ';   for (auto c:chit) ss << c <<'/'; ss << std::endl;
+   ss << algo_ << ": " <<  theTraj->foundHits() <<'|' <<theTraj->measurements().size()<<'|' << int(nLoops) << ' ';   for (auto c:chit) ss << c <<'/'; ss << std::endl;
    DPRINT("TrackProducer") << ss.str();
 
 #endif
@@ -7,6 +7,11 @@
 
 	Version which auto-vectorizes with gcc 4.6 or newer
 
+	With runInBlocks, the tracks ordered in z are annealed in blocks of
+	block_size tracks overlapping by overlap_frac, in parallel; the
+	prototypes of all blocks are then thermalized together with all
+	tracks, which merges the duplicates in the overlaps.
+
  */
 
 #include "RecoVertex/PrimaryVertexProducer/interface/TrackClusterizerInZ.h"
@@ -178,6 +183,13 @@ public:
   
   track_t	fill(const std::vector<reco::TransientTrack> & tracks) const;
   
+  // anneal down to the freeze-out temperature, returns the final beta
+  double anneal(track_t & tks, vertex_t & y) const;
+  // same, in overlapping blocks of tracks ordered in z, in parallel
+  double annealInBlocks(track_t & tks, vertex_t & y) const;
+  // outlier rejection and purging down to Tstop, and track assignment
+  std::vector<TransientVertex> finish(track_t & tks, vertex_t & y, double beta) const;
+  
   double update(double beta, track_t & gtracks,
 		vertex_t & gvertices, bool useRho0, double & rho0) const;
   
@@ -204,6 +216,9 @@ private:
   double dzCutOff_;
   double d0CutOff_;
   bool useTc_;
+  bool runInBlocks_;
+  unsigned int block_size_;
+  double overlap_frac_;
 };
 
 
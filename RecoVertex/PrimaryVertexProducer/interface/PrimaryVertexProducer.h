@@ -79,6 +79,7 @@ private:
 
   edm::ParameterSet theConfig;
   bool fVerbose;
+  bool fitInParallel_;  // fit the vertex candidates concurrently
   edm::EDGetTokenT<reco::BeamSpot> bsToken;
   edm::EDGetTokenT<reco::TrackCollection> trkToken;
 
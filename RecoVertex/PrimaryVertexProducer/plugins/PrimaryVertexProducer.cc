@@ -16,12 +16,16 @@
 #include "TrackingTools/Records/interface/TransientTrackRecord.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+
 
 PrimaryVertexProducer::PrimaryVertexProducer(const edm::ParameterSet& conf)
   :theConfig(conf)
 {
 
   fVerbose   = conf.getUntrackedParameter<bool>("verbose", false);
+  fitInParallel_ = conf.existsAs<bool>("fitInParallel") ? conf.getParameter<bool>("fitInParallel") : false;
   trkToken = consumes<reco::TrackCollection>(conf.getParameter<edm::InputTag>("TrackLabel"));
   bsToken = consumes<reco::BeamSpot>(conf.getParameter<edm::InputTag>("beamSpotLabel"));
 
@@ -169,22 +173,37 @@ PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup
     reco::VertexCollection & vColl = (*result);
 
 
-    std::vector<TransientVertex> pvs;
-    for (std::vector< std::vector<reco::TransientTrack> >::const_iterator iclus
-	   = clusters.begin(); iclus != clusters.end(); iclus++) {
-
-
+    // the fits of the clusters are independent, they share no tracks
+    auto fitCluster = [&](VertexFitter<5> const & fitter, std::vector<reco::TransientTrack> const & clus) {
       TransientVertex v; 
-      if( algorithm->useBeamConstraint && validBS &&((*iclus).size()>1) ){
+      if( algorithm->useBeamConstraint && validBS &&(clus.size()>1) ){
 	
-	v = algorithm->fitter->vertex(*iclus, beamSpot);
+	v = fitter.vertex(clus, beamSpot);
 	
-      }else if( !(algorithm->useBeamConstraint) && ((*iclus).size()>1) ) {
+      }else if( !(algorithm->useBeamConstraint) && (clus.size()>1) ) {
       
-	v = algorithm->fitter->vertex(*iclus); 
+	v = fitter.vertex(clus); 
 	
       }// else: no fit ==> v.isValid()=False
+      return v;
+    };
+
+    std::vector<TransientVertex> fitted(clusters.size());
+    if (fitInParallel_) {
+      // a fitter keeps its annealing state while fitting: one copy per thread
+      tbb::enumerable_thread_specific<std::unique_ptr<VertexFitter<5> > > fitters;
+      tbb::parallel_for(size_t(0), clusters.size(), [&](size_t iclus) {
+	  auto & fitter = fitters.local();
+	  if (!fitter) fitter.reset(algorithm->fitter->clone());
+	  fitted[iclus] = fitCluster(*fitter, clusters[iclus]);
+	});
+    } else {
+      for (size_t iclus = 0; iclus != clusters.size(); ++iclus)
+	fitted[iclus] = fitCluster(*algorithm->fitter, clusters[iclus]);
+    }
 
+    std::vector<TransientVertex> pvs;
+    for (auto const & v : fitted) {
 
       if (fVerbose){
 	if (v.isValid()) std::cout << "x,y,z=" << v.position().x() <<" " << v.position().y() << " " <<  v.position().z() << std::endl;
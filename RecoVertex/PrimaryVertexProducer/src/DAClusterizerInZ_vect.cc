@@ -7,9 +7,12 @@
 #include <cassert>
 #include <limits>
 #include <iomanip>
+#include <algorithm>
 #include "FWCore/Utilities/interface/isFinite.h"
 #include "vdt/vdtMath.h"
 
+#include "tbb/parallel_for.h"
+
 using namespace std;
 
 DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
@@ -38,6 +41,13 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
   d0CutOff_ = conf.getParameter<double> ("d0CutOff");
   dzCutOff_ = conf.getParameter<double> ("dzCutOff");
   maxIterations_ = 100;
+  // optionally, anneal overlapping blocks of tracks ordered in z in parallel
+  runInBlocks_ = conf.existsAs<bool>("runInBlocks") ? conf.getParameter<bool>("runInBlocks") : false;
+  block_size_ = conf.existsAs<unsigned int>("block_size") ? conf.getParameter<unsigned int>("block_size") : 512;
+  overlap_frac_ = conf.existsAs<double>("overlap_frac") ? conf.getParameter<double>("overlap_frac") : 0.5;
+  if (block_size_ == 0 || overlap_frac_ < 0 || overlap_frac_ >= 1) {
+    throw VertexException("DAClusterizerInZ_vect: invalid block_size or overlap_frac");
+  }
   if (Tmin == 0) {
     LogDebug("DAClusterizerinZ_vectorized")  << "DAClusterizerInZ: invalid Tmin" << Tmin
 					     << "  reset do default " << 1. / betamax_ << endl;
@@ -518,13 +528,64 @@ DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, con
   track_t && tks = fill(tracks);
   tks.ExtractRaw();
   
-  unsigned int nt = tks.GetSize();
-  double rho0 = 0.0; // start with no outlier rejection
-  
   vector<TransientVertex> clusters;
   if (tks.GetSize() == 0) return clusters;
   
   vertex_t y; // the vertex prototypes
+  double beta;
+  
+  if (runInBlocks_ && tks.GetSize() > block_size_) {
+    beta = annealInBlocks(tks, y);
+  } else {
+    beta = anneal(tks, y);
+  }
+  
+  return finish(tks, y, beta);
+}
+
+
+double DAClusterizerInZ_vect::annealInBlocks(track_t & tks, vertex_t & y) const {
+  // the tracks ordered in z, in blocks of block_size_ overlapping by overlap_frac_
+  const unsigned int nt = tks.GetSize();
+  std::vector<unsigned int> order(nt);
+  for (unsigned int i = 0; i < nt; i++) order[i] = i;
+  std::sort(order.begin(), order.end(), [&tks](unsigned int i, unsigned int j) { return tks._z[i] < tks._z[j]; });
+  
+  const unsigned int step = std::max(1U, (unsigned int)(block_size_ * (1. - overlap_frac_)));
+  std::vector<unsigned int> firsts;
+  for (unsigned int first = 0; ; first += step) {
+    firsts.push_back(first);
+    if (first + block_size_ >= nt) break;
+  }
+  
+  // each block is annealed independently down to the freeze-out temperature
+  const unsigned int nblocks = firsts.size();
+  std::vector<vertex_t> yblock(nblocks);
+  std::vector<double> betablock(nblocks);
+  tbb::parallel_for(0U, nblocks, [&](unsigned int b) {
+      track_t block;
+      for (unsigned int i = firsts[b]; i < std::min(firsts[b] + block_size_, nt); i++) {
+	unsigned int t = order[i];
+	block.AddItem(tks._z[t], tks._dz2[t], tks.tt[t], tks._pi[t]);
+      }
+      block.ExtractRaw();
+      betablock[b] = anneal(block, yblock[b]);
+    });
+  
+  // the prototypes of all blocks, in z order; those found twice in the overlaps
+  // are merged once all tracks are used, as the collapsed ones of a single block
+  std::vector<std::pair<double, double> > prototypes;
+  for (auto const & yb : yblock)
+    for (unsigned int k = 0; k < yb.GetSize(); k++) prototypes.emplace_back(yb._z[k], yb._pk[k]);
+  std::sort(prototypes.begin(), prototypes.end());
+  for (auto const & p : prototypes) y.AddItem(p.first, p.second);
+  
+  return *std::min_element(betablock.begin(), betablock.end());
+}
+
+
+double DAClusterizerInZ_vect::anneal(track_t & tks, vertex_t & y) const {
+  double rho0 = 0.0; // no outlier rejection
   
   // initialize:single vertex at infinite temperature
   y.AddItem( 0, 1.0);
@@ -581,8 +642,18 @@ DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, con
     dump(beta, y, tks, 2);
   }
   
+  return beta;
+}
+
+
+vector<TransientVertex>
+DAClusterizerInZ_vect::finish(track_t & tks, vertex_t & y, double beta) const {
+  const unsigned int nt = tks.GetSize();
+  int niter = 0; // number of iterations
+  vector<TransientVertex> clusters;
+  
   // switch on outlier rejection
-  rho0 = 1. / nt;
+  double rho0 = 1. / nt;
   
   // auto-vectorized
   for (unsigned int k = 0; k < y.GetSize(); k++) y._pk[k] = 1.; // democratic
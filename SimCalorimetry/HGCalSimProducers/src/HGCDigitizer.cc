@@ -218,7 +218,10 @@ void HGCDigitizer::accumulate(edm::Handle<edm::PCaloHitContainer> const &hits,
   }
   std::sort(hitRefs.begin(),hitRefs.end(),this->orderByDetIdThenTime);
   
-  //loop over sorted hits
+  //loop over sorted hits; the consecutive hits of a DetId share its position and accumulator
+  uint32_t cachedId(0);
+  float dist2center(0.f);
+  HGCSimHitDataAccumulator::iterator simHitIt=simHitAccumulator_->end();
   for(int i=0; i<nchits; ++i) {
     const int hitidx   = std::get<0>(hitRefs[i]);
     const uint32_t id  = std::get<1>(hitRefs[i]);
@@ -229,7 +232,11 @@ void HGCDigitizer::accumulate(edm::Handle<edm::PCaloHitContainer> const &hits,
     const float charge = hit.energy()*1e6*keV2fC;
       
     //distance to the center of the detector
-    const float dist2center( geom->getPosition(id).mag() );
+    if(id != cachedId) {
+      cachedId    = id;
+      dist2center = geom->getPosition(id).mag();
+      simHitIt    = simHitAccumulator_->end();
+    }
       
     //hit time: [time()]=ns  [centerDist]=cm [refSpeed_]=cm/ns + delay by 1ns
     //accumulate in 15 buckets of 25ns (9 pre-samples, 1 in-time, 5 post-samples)
@@ -243,9 +250,11 @@ void HGCDigitizer::accumulate(edm::Handle<edm::PCaloHitContainer> const &hits,
     if(itime<0 || itime>14) continue; 
     
     //check if already existing (perhaps could remove this in the future - 2nd event should have all defined)
-    HGCSimHitDataAccumulator::iterator simHitIt=simHitAccumulator_->find(id);
     if(simHitIt == simHitAccumulator_->end()) {
-      simHitIt = simHitAccumulator_->insert( std::make_pair(id,baseData) ).first;      
+      simHitIt = simHitAccumulator_->find(id);
+      if(simHitIt == simHitAccumulator_->end()) {
+        simHitIt = simHitAccumulator_->insert( std::make_pair(id,baseData) ).first;
+      }
     }
       
     //check if time index is ok and store energy
@@ -201,7 +201,11 @@ bool CaloSD::ProcessHits(G4GFlashSpot* aSpot, G4TouchableHistory*) {
 }                                   
 
 double CaloSD::getEnergyDeposit(G4Step* aStep) {
-  return aStep->GetTotalEnergyDeposit();
+  double edep = aStep->GetTotalEnergyDeposit();
+  // weight of the track after Russian roulette in the StackingAction
+  double wt2 = aStep->GetTrack()->GetWeight();
+  if(wt2 > 0.0) { edep *= wt2; }
+  return edep;
 }
 
 void CaloSD::Initialize(G4HCofThisEvent * HCE) { 
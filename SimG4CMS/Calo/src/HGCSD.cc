@@ -108,6 +108,9 @@ bool HGCSD::ProcessHits(G4Step * aStep, G4TouchableHistory * ) {
 
 double HGCSD::getEnergyDeposit(G4Step* aStep) {
   double destep = aStep->GetTotalEnergyDeposit();
+  // weight of the track after Russian roulette in the StackingAction
+  double wt2 = aStep->GetTrack()->GetWeight();
+  if(wt2 > 0.0) { destep *= wt2; }
   return destep;
 }
 
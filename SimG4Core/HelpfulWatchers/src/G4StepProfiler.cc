@@ -0,0 +1,124 @@
+// -*- C++ -*-
+//
+// Package:     HelpfulWatchers
+// Class  :     G4StepProfiler
+//
+
+// system include files
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <vector>
+
+// user include files
+#include "SimG4Core/HelpfulWatchers/src/G4StepProfiler.h"
+#include "SimG4Core/Notification/interface/BeginOfRun.h"
+#include "SimG4Core/Notification/interface/BeginOfTrack.h"
+#include "SimG4Core/Notification/interface/EndOfRun.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4Region.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace {
+  // decades of kinetic energy in MeV, the lowest and highest collect the rest
+  constexpr int kMinEnergyBin = -6;
+  constexpr int kMaxEnergyBin = 6;
+}
+
+G4StepProfiler::G4StepProfiler(const edm::ParameterSet& iPSet) :
+   m_sampleEvery(std::max(1U, iPSet.getUntrackedParameter<unsigned int>("sampleEvery", 100))),
+   m_maxPrint(iPSet.getUntrackedParameter<unsigned int>("maxPrint", 50)),
+   m_stepCount(0),
+   m_nSecondaries(0),
+   m_timing(false)
+{
+}
+
+void
+G4StepProfiler::update(const BeginOfRun*)
+{
+   m_stats.clear();
+   m_stepCount = 0;
+   m_timing = false;
+}
+
+void
+G4StepProfiler::update(const BeginOfTrack*)
+{
+   m_nSecondaries = 0;
+   // a sampled first step is timed from the start of its track
+   if (m_timing) m_start = std::chrono::steady_clock::now();
+}
+
+void
+G4StepProfiler::update(const G4Step* iStep)
+{
+   const G4StepPoint* pre = iStep->GetPreStepPoint();
+   const G4VPhysicalVolume* volume = pre->GetPhysicalVolume();
+   const G4Region* region = volume ? volume->GetLogicalVolume()->GetRegion() : nullptr;
+   const double energy = pre->GetKineticEnergy()/MeV;
+   const int energyBin = energy > 0. ? std::min(std::max(int(std::floor(std::log10(energy))), kMinEnergyBin), kMaxEnergyBin) : kMinEnergyBin;
+
+   Stats& stats = m_stats[Key(region, iStep->GetTrack()->GetDefinition(), energyBin)];
+   ++stats.steps;
+   // the secondaries of the track are accumulated over its steps
+   const size_t nSecondaries = iStep->GetSecondary() ? iStep->GetSecondary()->size() : 0;
+   if (nSecondaries > m_nSecondaries) stats.secondaries += nSecondaries - m_nSecondaries;
+   m_nSecondaries = nSecondaries;
+
+   if (m_timing) {
+      stats.sampledTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+      ++stats.sampledSteps;
+      m_timing = false;
+   }
+   if (++m_stepCount == m_sampleEvery) {
+      m_stepCount = 0;
+      m_timing = true;
+      m_start = std::chrono::steady_clock::now();
+   }
+}
+
+void
+G4StepProfiler::update(const EndOfRun*)
+{
+   typedef std::pair<Key, Stats> Entry;
+   std::vector<Entry> entries(m_stats.begin(), m_stats.end());
+   std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+         return a.second.sampledTime > b.second.sampledTime;
+      });
+
+   double totalTime = 0.;
+   unsigned long long totalSteps = 0;
+   for (auto const& entry : entries) {
+      totalTime += entry.second.sampledTime;
+      totalSteps += entry.second.steps;
+   }
+
+   edm::LogVerbatim out("G4StepProfiler");
+   out << "G4StepProfiler: " << totalSteps << " steps in " << entries.size()
+       << " categories, estimated time " << totalTime*m_sampleEvery << " s from one step in "
+       << m_sampleEvery << "\n"
+       << std::setw(24) << "region" << std::setw(16) << "particle" << std::setw(10) << "log10(E/MeV)"
+       << std::setw(14) << "steps" << std::setw(14) << "secondaries" << std::setw(12) << "time [s]"
+       << std::setw(10) << "fraction" << "\n";
+   unsigned int nPrinted = 0;
+   for (auto const& entry : entries) {
+      if (nPrinted++ == m_maxPrint) break;
+      const G4Region* region = std::get<0>(entry.first);
+      const G4ParticleDefinition* particle = std::get<1>(entry.first);
+      out << std::setw(24) << (region ? region->GetName() : G4String("none"))
+          << std::setw(16) << (particle ? particle->GetParticleName() : G4String("none"))
+          << std::setw(10) << std::get<2>(entry.first)
+          << std::setw(14) << entry.second.steps << std::setw(14) << entry.second.secondaries
+          << std::setw(12) << entry.second.sampledTime*m_sampleEvery
+          << std::setw(10) << (totalTime > 0. ? entry.second.sampledTime/totalTime : 0.) << "\n";
+   }
+}
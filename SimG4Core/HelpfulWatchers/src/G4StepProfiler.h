@@ -0,0 +1,84 @@
+#ifndef HelpfulWatchers_G4StepProfiler_h
+#define HelpfulWatchers_G4StepProfiler_h
+// -*- C++ -*-
+//
+// Package:     HelpfulWatchers
+// Class  :     G4StepProfiler
+//
+/**\class G4StepProfiler G4StepProfiler.h SimG4Core/HelpfulWatchers/src/G4StepProfiler.h
+
+ Description: Profiles the Geant4 steps by region, particle and kinetic energy
+
+ Usage:
+    The watcher counts the steps and their secondaries for each G4Region,
+    particle type and decade of pre-step kinetic energy, and measures the
+    wall-clock time of one step out of "sampleEvery" (default 100).  The time
+    of a sampled step is the time since the previous step of the same track,
+    so that it includes the stepping, the sensitive detectors and the other
+    watchers.  At the end of each run the categories are printed by estimated
+    time, the "maxPrint" (default 50) most expensive first, on the
+    "G4StepProfiler" LogVerbatim category.
+
+    With the multi-threaded run manager each worker thread has its own
+    watcher, and prints the profile of its own steps.
+*/
+//
+
+// system include files
+#include <chrono>
+#include <map>
+#include <tuple>
+
+// user include files
+#include "SimG4Core/Watcher/interface/SimWatcher.h"
+#include "SimG4Core/Notification/interface/Observer.h"
+
+// forward declarations
+namespace edm {
+   class ParameterSet;
+}
+class BeginOfRun;
+class BeginOfTrack;
+class EndOfRun;
+class G4Step;
+class G4Region;
+class G4ParticleDefinition;
+
+class G4StepProfiler : public SimWatcher,
+                       public Observer<const BeginOfRun *>,
+                       public Observer<const BeginOfTrack *>,
+                       public Observer<const G4Step *>,
+                       public Observer<const EndOfRun *>
+{
+   public:
+      G4StepProfiler(const edm::ParameterSet&);
+
+   private:
+      G4StepProfiler(const G4StepProfiler&) = delete;
+      const G4StepProfiler& operator=(const G4StepProfiler&) = delete;
+
+      void update(const BeginOfRun*) override;
+      void update(const BeginOfTrack*) override;
+      void update(const G4Step*) override;
+      void update(const EndOfRun*) override;
+
+      // region, particle, decade of the kinetic energy in MeV
+      typedef std::tuple<const G4Region*, const G4ParticleDefinition*, int> Key;
+      struct Stats {
+         unsigned long long steps = 0;
+         unsigned long long secondaries = 0;
+         unsigned long long sampledSteps = 0;
+         double sampledTime = 0.;   // seconds
+      };
+
+      // ---------- member data --------------------------------
+      unsigned int m_sampleEvery;
+      unsigned int m_maxPrint;
+      std::map<Key, Stats> m_stats;
+      unsigned int m_stepCount;
+      size_t m_nSecondaries;       // secondaries of the current track so far
+      bool m_timing;
+      std::chrono::steady_clock::time_point m_start;
+};
+
+#endif
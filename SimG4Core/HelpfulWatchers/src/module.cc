@@ -4,6 +4,7 @@
 //Adding a Watcher to collect G4step statistics:
 #include "SimG4Core/HelpfulWatchers/src/G4StepStatistics.h"
 #include "SimG4Core/HelpfulWatchers/interface/MonopoleSteppingAction.h"
+#include "SimG4Core/HelpfulWatchers/src/G4StepProfiler.h"
 
 #include "FWCore/PluginManager/interface/ModuleDef.h"
 
@@ -17,3 +18,6 @@ DEFINE_SIMWATCHER (G4StepStatistics);
 
 //Adding a Watcher to take care of steps of a monopole:
 DEFINE_SIMWATCHER (MonopoleSteppingAction);
+
+//Adding a Watcher to profile the G4 steps by region, particle and energy:
+DEFINE_SIMWATCHER (G4StepProfiler);
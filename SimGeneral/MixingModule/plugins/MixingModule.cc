@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <numeric>
 
 #include "MixingModule.h"
 #include "MixingWorker.h"
@@ -373,6 +374,9 @@ namespace edm {
 
       source0->CalculatePileup(minBunch_, maxBunch_, PileupList, TrueNumInteractions_, e.streamID());
 
+      // the other sources get one event per bunch crossing; record all the events without reallocating
+      recordEventID.reserve(std::accumulate(PileupList.begin(), PileupList.end(), size_t(0)) +
+                            (maxNbSources_ - 1)*(maxBunch_ + 1 - minBunch_));
     }
 
     //    for (int bunchIdx = minBunch_; bunchIdx <= maxBunch_; ++bunchIdx) {
@@ -452,7 +456,8 @@ namespace edm {
     // Save playback information
 
     std::vector<edm::EventID> eventInfoList;
-    for (auto const item : recordEventID) {
+    eventInfoList.reserve(recordEventID.size());
+    for (auto const& item : recordEventID) {
       eventInfoList.emplace_back(item.eventID());
     }
 
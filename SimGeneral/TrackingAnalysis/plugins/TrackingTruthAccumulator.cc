@@ -52,6 +52,8 @@
 #include "Geometry/Records/interface/TrackerTopologyRcd.h"
 #include "FWCore/Framework/interface/ESHandle.h"
 
+#include <algorithm>
+
 
 
 
@@ -521,6 +523,7 @@ template<class T> void TrackingTruthAccumulator::fillSimHits( std::vector<const
 		event.getByLabel( collectionTag, hSimHits );
 
 		// TODO - implement removing the dead modules
+		returnValue.reserve( returnValue.size()+hSimHits->size() );
 		for( const auto& simHit : *hSimHits )
 		{
 			returnValue.push_back( &simHit );
@@ -744,12 +747,16 @@ namespace // Unnamed namespace for things only used in this file
 		  decayVertices( decayVertices_ ),
 		  rootVertices( rootVertices_ )
 	{
-		// I need some maps to be able to get object pointers from the track/vertex ID
-		std::map<int,::DecayChainTrack*> trackIdToDecayTrack;
-		std::map<int,::DecayChainVertex*> vertexIdToDecayVertex;
+		// I need some lookup tables to be able to get object pointers from the track/vertex ID. The
+		// vertex index is the position in the SimVertex collection so a flat array does, the trackIds
+		// are sparse so they are kept in a vector sorted afterwards. Both are sized up front, which
+		// at high pileup is much lighter than a map node per track and per vertex.
+		std::vector<std::pair<int,::DecayChainTrack*> > trackIdToDecayTrack;
+		trackIdToDecayTrack.reserve( trackCollection.size() );
+		std::vector< ::DecayChainVertex*> vertexIdToDecayVertex( vertexCollection.size(), NULL );
 
 		// First create a DecayChainTrack for every SimTrack and make a note of the
-		// trackIds in the map. Also add a pointer to the daughter list of the parent
+		// trackIds in the table. Also add a pointer to the daughter list of the parent
 		// DecayChainVertex, which might include creating the vertex object if it
 		// doesn't already exist.
 		size_t decayVertexIndex=0; // The index of the next free slot in the DecayChainVertex array.
@@ -762,16 +769,22 @@ namespace // Unnamed namespace for things only used in this file
 			// necessarily be accessed through the array later so it's still required to store it.
 			pDecayTrack->simTrackIndex=index;
 
-			trackIdToDecayTrack[ trackCollection[index].trackId() ]=pDecayTrack;
+			trackIdToDecayTrack.push_back( std::make_pair( trackCollection[index].trackId(), pDecayTrack ) );
 
 			int parentVertexIndex=trackCollection[index].vertIndex();
 			if( parentVertexIndex>=0 )
 			{
+				if( static_cast<size_t>(parentVertexIndex)>=vertexCollection.size() )
+				{
+					std::stringstream errorStream;
+					errorStream << "TrackingTruthAccumulator: Found a track with a parent vertex index " << parentVertexIndex << " beyond the " << vertexCollection.size() << " SimVertices.";
+					throw std::runtime_error( errorStream.str() );
+				}
 				// Get the DecayChainVertex corresponding to this SimVertex, or initialise it if it hasn't been done already.
 				::DecayChainVertex*& pParentVertex=vertexIdToDecayVertex[parentVertexIndex];
 				if( pParentVertex==NULL )
 				{
-					// Note that I'm using a reference, so changing pParentVertex will change the entry in the map too.
+					// Note that I'm using a reference, so changing pParentVertex will change the entry in the table too.
 					pParentVertex=&decayVertices_[decayVertexIndex];
 					++decayVertexIndex;
 					pParentVertex->simVertexIndex=parentVertexIndex;
@@ -782,6 +795,10 @@ namespace // Unnamed namespace for things only used in this file
 			else throw std::runtime_error( "TrackingTruthAccumulator: Found a track with an invalid parent vertex index." );
 		}
 
+		// Stable so that, as with a map filled in order, the last of any repeated trackId is the one found.
+		std::stable_sort( trackIdToDecayTrack.begin(), trackIdToDecayTrack.end(),
+			[]( const std::pair<int,::DecayChainTrack*>& a, const std::pair<int,::DecayChainTrack*>& b ){ return a.first<b.first; } );
+
 		// This assert was originally in to check the internal consistency of the decay chain. Fast sim
 		// pileup seems to have a load of vertices with no tracks pointing to them though, so fast sim fails
 		// this assert if pileup is added. I don't think the problem is vital however, so if the assert is
@@ -790,28 +807,30 @@ namespace // Unnamed namespace for things only used in this file
 
 		// I still need to set DecayChainTrack::daughterVertices and DecayChainVertex::pParentTrack.
 		// The information to do this comes from SimVertex::parentIndex. I couldn't do this before
-		// because I need all of the DecayChainTracks initialised.
-		for( auto& decayVertexMapPair : vertexIdToDecayVertex )
+		// because I need all of the DecayChainTracks initialised. The vertices are visited in order
+		// of their index.
+		for( ::DecayChainVertex* pDecayVertex : vertexIdToDecayVertex )
 		{
-			::DecayChainVertex* pDecayVertex=decayVertexMapPair.second;
+			if( pDecayVertex==NULL ) continue;
 			int parentTrackIndex=vertexCollection[pDecayVertex->simVertexIndex].parentIndex();
 			if( parentTrackIndex!=-1 )
 			{
-				std::map<int,::DecayChainTrack*>::iterator iParentTrackMapPair=trackIdToDecayTrack.find(parentTrackIndex);
-				if( iParentTrackMapPair==trackIdToDecayTrack.end() )
+				auto iParentTrackPair=std::upper_bound( trackIdToDecayTrack.begin(), trackIdToDecayTrack.end(), parentTrackIndex,
+					[]( int trackId, const std::pair<int,::DecayChainTrack*>& entry ){ return trackId<entry.first; } );
+				if( iParentTrackPair==trackIdToDecayTrack.begin() || (iParentTrackPair-1)->first!=parentTrackIndex )
 				{
 					std::stringstream errorStream;
 					errorStream << "TrackingTruthAccumulator: Something has gone wrong with the indexing. Parent track index is " << parentTrackIndex << ".";
 					throw std::runtime_error( errorStream.str() );
 				}
 
-				::DecayChainTrack* pParentTrackHierarchy=iParentTrackMapPair->second;
+				::DecayChainTrack* pParentTrackHierarchy=(iParentTrackPair-1)->second;
 
 				pParentTrackHierarchy->daughterVertices.push_back( pDecayVertex );
 				pDecayVertex->pParentTrack=pParentTrackHierarchy;
 			}
 			else rootVertices_.push_back(pDecayVertex); // Has no parent so is at the top of the decay chain.
-		} // end of loop over the vertexIdToDecayVertex map
+		} // end of loop over the vertexIdToDecayVertex table
 
 		findBrem( trackCollection, vertexCollection );
 
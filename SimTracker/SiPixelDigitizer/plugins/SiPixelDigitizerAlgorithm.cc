@@ -39,6 +39,7 @@
 // November, 2010: Bug fix in removing TBMB/A half-modules (V. Cuplov)
 // February, 2011: Time improvement in DriftDirection()  (J. Bashir Butt)
 // June, 2011: Bug Fix for pixels on ROC edges in module_killing_DB() (J. Bashir Butt)
+#include <algorithm>
 #include <iostream>
 
 #include "SimGeneral/NoiseGenerators/interface/GaussianTailNoiseGenerator.h"
@@ -1031,8 +1032,8 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
    typedef std::map< int, float, std::less<int> > hit_map_type;
    hit_map_type hit_signal;
 
-   // map to store pixel integrals in the x and in the y directions
-   std::map<int, float, std::less<int> > x,y;
+   // pixel integrals in the x and in the y directions, from the first pixel of the cloud
+   std::vector<float> x,y;
 
    // Assign signals to readout channels and store sorted by channel number
 
@@ -1108,8 +1109,8 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
      IPixLeftDownX = 0<IPixLeftDownX ? IPixLeftDownX : 0 ;
      IPixLeftDownY = 0<IPixLeftDownY ? IPixLeftDownY : 0 ;
 
-     x.clear(); // clear temporary integration array
-     y.clear();
+     x.resize(std::max(IPixRightUpX-IPixLeftDownX+1,0)); // temporary integration arrays
+     y.resize(std::max(IPixRightUpY-IPixLeftDownY+1,0));
 
      // First integrate charge strips in x
      int ix; // TT for compatibility
@@ -1136,7 +1137,7 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
        }
 
        float   TotalIntegrationRange = UpperBound - LowerBound; // get strip
-       x[ix] = TotalIntegrationRange; // save strip integral
+       x[ix-IPixLeftDownX] = TotalIntegrationRange; // save strip integral
        //if(SigmaX==0 || SigmaY==0)
        //cout<<TotalIntegrationRange<<" "<<ix<<std::endl;
 
@@ -1164,7 +1165,7 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
       }
 
       float   TotalIntegrationRange = UpperBound - LowerBound;
-      y[iy] = TotalIntegrationRange; // save strip integral
+      y[iy-IPixLeftDownY] = TotalIntegrationRange; // save strip integral
       //if(SigmaX==0 || SigmaY==0)
       //cout<<TotalIntegrationRange<<" "<<iy<<std::endl;
     }
@@ -1174,7 +1175,7 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
     for (ix=IPixLeftDownX; ix<=IPixRightUpX; ix++) {  // loop over x index
       for (iy=IPixLeftDownY; iy<=IPixRightUpY; iy++) { //loope over y ind
 
-        float ChargeFraction = Charge*x[ix]*y[iy];
+        float ChargeFraction = Charge*x[ix-IPixLeftDownX]*y[iy-IPixLeftDownY];
 
         if( ChargeFraction > 0. ) {
 	  chan = PixelDigi::pixelToChannel( ix, iy);  // Get index
@@ -1182,12 +1183,11 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
           hit_signal[chan] += ChargeFraction;
 	} // endif
 
-
+#ifdef TP_DEBUG
 	mp = MeasurementPoint( float(ix), float(iy) );
 	LocalPoint lp = topol->localPosition(mp);
 	chan = topol->channel(lp);
 
-#ifdef TP_DEBUG
 	LogDebug ("Pixel Digitizer")
 	  << " pixel " << ix << " " << iy << " - "<<" "
 	  << chan << " " << ChargeFraction<<" "
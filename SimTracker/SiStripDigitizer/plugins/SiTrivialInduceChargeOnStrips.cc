@@ -191,6 +191,13 @@ induceVector(const SiChargeCollectionDrifter::collection_type& collection_points
     }
     int tot=0;
     for (int i=0; i!=N;++i) tot += nStrip[i];
+    // the strips which get charge; the others of the module are not touched
+    int firstStrip=Nstrips, lastStrip=0;
+    for (int i=0; i!=N;++i) {
+      if (nStrip[i]<=0) continue;
+      firstStrip = std::min(firstStrip,fromStrip[i]);
+      lastStrip = std::max(lastStrip,fromStrip[i]+nStrip[i]);
+    }
     tot+=N; // add last strip 
     count.val(tot);
     float value[tot];
@@ -229,7 +236,7 @@ induceVector(const SiChargeCollectionDrifter::collection_type& collection_points
       value[k]-=value[k+1];  // this is negative!
     
     
-    float charge[Nstrips]; for (int i=0;i!=Nstrips; ++i) charge[i]=0;
+    float charge[Nstrips]; for (int i=firstStrip;i<lastStrip; ++i) charge[i]=0;
     kk=0;
     for (int i=0; i!=N;++i){ 
       for (int j=0;j!=nStrip[i]; ++j)
@@ -242,7 +249,7 @@ induceVector(const SiChargeCollectionDrifter::collection_type& collection_points
     /// do crosstalk... (can be done better, most probably not worth)
     int minA=recordMinAffectedStrip, maxA=recordMaxAffectedStrip;
     int sc = coupling.size();
-    for (int i=0;i!=Nstrips; ++i) {
+    for (int i=firstStrip;i<lastStrip; ++i) {
       int strip = i;
       if (0==charge[i]) continue;
       auto affectedFromStrip  = std::max( 0, strip - sc + 1);
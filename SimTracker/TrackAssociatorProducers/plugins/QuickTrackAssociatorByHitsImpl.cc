@@ -1,5 +1,6 @@
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 #include "QuickTrackAssociatorByHitsImpl.h"
 
@@ -340,7 +341,6 @@ template<typename T_TPCollection,typename iter> std::vector< std::pair<edm::Ref<
 	// number of reco clusters though.
 	std::vector<OmniClusterRef> oClusters=getMatchedClusters( begin, end );
 
-	std::map < TrackingParticleRef, size_t > lmap;
 	for( std::vector<OmniClusterRef>::const_iterator it=oClusters.begin(); it != oClusters.end(); ++it )
 	{
 		auto range = clusterToTPMap.equal_range(*it);
@@ -370,17 +370,17 @@ template<typename T_TPCollection,typename iter> std::vector< std::pair<edm::Ref<
 				 std::sort(returnValue.begin(), returnValue.end(), tpIntPairGreater);
 				 }
 				 */
-				auto jpos=lmap.find( trackingParticle );
-				if( jpos != lmap.end() ) ++jpos->second;
-				else lmap.insert( std::make_pair( trackingParticle, 1 ) );
+				// a track has few TrackingParticles: a linear search in a flat vector beats a map
+				auto jpos=std::find_if( returnValue.begin(), returnValue.end(),
+							[&trackingParticle](const std::pair<edm::Ref<TrackingParticleCollection>,size_t>& p) { return p.first==trackingParticle; } );
+				if( jpos != returnValue.end() ) ++jpos->second;
+				else returnValue.push_back( std::make_pair( trackingParticle, 1 ) );
 			}
 		}
 	}
-	// now copy the map to returnValue
-	for( auto ip=lmap.begin(); ip != lmap.end(); ++ip )
-	{
-		returnValue.push_back( std::make_pair( ip->first, ip->second ) );
-	}
+	// in TrackingParticle order, as from a map
+	std::sort( returnValue.begin(), returnValue.end(),
+		   [](const std::pair<edm::Ref<TrackingParticleCollection>,size_t>& a, const std::pair<edm::Ref<TrackingParticleCollection>,size_t>& b) { return a.first < b.first; } );
 	return returnValue;
 }
 
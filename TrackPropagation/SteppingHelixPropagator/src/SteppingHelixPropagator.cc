@@ -800,7 +800,12 @@ void SteppingHelixPropagator::getNextState(const SteppingHelixPropagator::StateI
 
   if (useMagVolumes_){
     if (vbField_ != 0){
-      svNext.magVol = vbField_->findVolume(gPointNorZ);
+      //most steps stay in the volume of the previous one: check it before searching the geometry
+      if (svPrevious.magVol != 0 && svPrevious.magVol->inside(gPointNorZ)){
+	svNext.magVol = svPrevious.magVol;
+      } else {
+	svNext.magVol = vbField_->findVolume(gPointNorZ);
+      }
       if (useIsYokeFlag_){
 	double curRad = svNext.r3.perp();
 	if (curRad > 380 && curRad < 850 && fabs(svNext.r3.z()) < 667){
@@ -72,6 +72,17 @@ public:
     return new AnalyticalPropagator(*this);
   }
   
+  /** Propagation of the parameters of fts to n planes in one go, in the
+   *  parabolic approximation (see HelixMultiPlaneCrossing): for each plane,
+   *  status (false also beyond the maximal direction change), path length
+   *  and local position of the crossing point.  Meant for the compatibility
+   *  checks of many dets with the same state, before precise propagation.
+   */
+  void propagateParametersOnPlanes(const FreeTrajectoryState& fts,
+				   unsigned int n, const Plane* const* planes,
+				   bool* valid, float* pathLength,
+				   float* localX, float* localY) const;
+
   /** Set the maximum relative change in Bz (Bz_at_end-Bz_at_start)/Bz_at_start
    * for a single propagation. The default is no limit.
    * NB: this propagator assumes constant, non-zero magnetic field parallel to the z-axis!
@@ -0,0 +1,44 @@
+#ifndef HelixMultiPlaneCrossing_H
+#define HelixMultiPlaneCrossing_H
+
+#include "DataFormats/TrajectorySeed/interface/PropagationDirection.h"
+#include "DataFormats/GeometryVector/interface/Basic3DVector.h"
+
+class Plane;
+
+/** Calculates the intersections of one helix with many planes of any
+ *  orientation, using the parabolic approximation of
+ *  HelixArbitraryPlaneCrossing2Order.  The helix is set up once, the
+ *  planes are processed in groups in structure-of-arrays layout, and the
+ *  results are returned the same way: meant for the compatibility checks
+ *  of the measurement search, before the precise propagation.
+ */
+
+class HelixMultiPlaneCrossing {
+public:
+  typedef Basic3DVector<float>   PositionType;
+  typedef Basic3DVector<float>   DirectionType;
+
+  /** Constructor using point, direction and (transverse!) curvature.
+   */
+  HelixMultiPlaneCrossing(const PositionType& point,
+			  const DirectionType& direction,
+			  const float curvature,
+			  const PropagationDirection propDir = alongMomentum);
+
+  /** For each of the n planes: propagation status (true if valid), the
+   *  (signed) path length to the plane and the crossing point in the
+   *  local frame of the plane.
+   */
+  void crossings(unsigned int n, const Plane* const* planes,
+		 bool* valid, float* pathLength, float* localX, float* localY) const;
+
+private:
+  double theX0,theY0,theZ0;
+  double theCosPhi0,theSinPhi0;
+  double theCosTheta,theSinThetaI;
+  double theRho;
+  PropagationDirection thePropDir;
+};
+
+#endif
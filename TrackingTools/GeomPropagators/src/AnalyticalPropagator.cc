@@ -11,6 +11,7 @@
 #include "TrackingTools/GeomPropagators/interface/StraightLineBarrelCylinderCrossing.h"
 #include "TrackingTools/GeomPropagators/interface/OptimalHelixPlaneCrossing.h"
 #include "TrackingTools/GeomPropagators/interface/HelixBarrelCylinderCrossing.h"
+#include "TrackingTools/GeomPropagators/interface/HelixMultiPlaneCrossing.h"
 #include "TrackingTools/AnalyticalJacobians/interface/AnalyticalCurvilinearJacobian.h"
 #include "TrackingTools/GeomPropagators/interface/PropagationDirectionFromPath.h"
 #include "TrackingTools/TrajectoryState/interface/SurfaceSideDefinition.h"
@@ -140,6 +141,25 @@ AnalyticalPropagator::propagatedStateWithPath (const FreeTrajectoryState& fts,
   }
 }
 
+void
+AnalyticalPropagator::propagateParametersOnPlanes(const FreeTrajectoryState& fts,
+						  unsigned int n, const Plane* const* planes,
+						  bool* valid, float* pathLength,
+						  float* localX, float* localY) const
+{
+  float rho = fts.transverseCurvature();
+  HelixMultiPlaneCrossing crossing(HelixMultiPlaneCrossing::PositionType(fts.position()),
+				   HelixMultiPlaneCrossing::DirectionType(fts.momentum()),
+				   rho, propagationDirection());
+  crossing.crossings(n, planes, valid, pathLength, localX, localY);
+  // deltaPhi limit, as in propagateWithPath
+  float maxDPhi2 = theMaxDPhi2*fts.momentum().mag2()/fts.momentum().perp2();
+  for (unsigned int i=0; i<n; ++i) {
+    float dphi = pathLength[i]*rho;
+    valid[i] = valid[i] && dphi*dphi<=maxDPhi2;
+  }
+}
+
 bool AnalyticalPropagator::propagateParametersOnCylinder(
   const FreeTrajectoryState& fts, const Cylinder& cylinder, 
   GlobalPoint& x, GlobalVector& p, double& s) const
@@ -0,0 +1,112 @@
+#include "TrackingTools/GeomPropagators/interface/HelixMultiPlaneCrossing.h"
+
+#include "DataFormats/GeometrySurface/interface/Plane.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+namespace {
+  // planes processed together
+  constexpr unsigned int kGroupSize = 16;
+}
+
+HelixMultiPlaneCrossing::HelixMultiPlaneCrossing(const PositionType& point,
+						 const DirectionType& direction,
+						 const float curvature,
+						 const PropagationDirection propDir) :
+  theX0(point.x()),
+  theY0(point.y()),
+  theZ0(point.z()),
+  theRho(curvature),
+  thePropDir(propDir)
+{
+  // as in HelixArbitraryPlaneCrossing2Order
+  double px = direction.x();
+  double py = direction.y();
+  double pz = direction.z();
+  double pt2 = px*px+py*py;
+  double p2 = pt2+pz*pz;
+  double pI = 1./sqrt(p2);
+  double ptI = 1./sqrt(pt2);
+  theCosPhi0 = px*ptI;
+  theSinPhi0 = py*ptI;
+  theCosTheta = pz*pI;
+  theSinThetaI = p2*pI*ptI;
+}
+
+void
+HelixMultiPlaneCrossing::crossings(unsigned int n, const Plane* const* planes,
+				   bool* valid, float* pathLength, float* localX, float* localY) const {
+  // plane position and rotation rows (local x, y and normal), gathered per group
+  double dx[kGroupSize], dy[kGroupSize], dz[kGroupSize];
+  double rot[9][kGroupSize];
+
+  const double propSign = thePropDir==alongMomentum ? 1 : -1;
+
+  for (unsigned int first = 0; first < n; first += kGroupSize) {
+    unsigned int m = std::min(kGroupSize, n-first);
+    for (unsigned int l=0; l<m; ++l) {
+      auto const & plane = *planes[first+l];
+      auto const & r = plane.rotation();
+      dx[l] = theX0 - plane.position().x();
+      dy[l] = theY0 - plane.position().y();
+      dz[l] = theZ0 - plane.position().z();
+      rot[0][l] = r.xx(); rot[1][l] = r.xy(); rot[2][l] = r.xz();
+      rot[3][l] = r.yx(); rot[4][l] = r.yy(); rot[5][l] = r.yz();
+      rot[6][l] = r.zx(); rot[7][l] = r.zy(); rot[8][l] = r.zz();
+    }
+
+    // same solutions as HelixArbitraryPlaneCrossing2Order::pathLength: all the cases
+    // are computed and the right one selected, for the loop to vectorize
+    for (unsigned int l=0; l<m; ++l) {
+      double nPx = rot[6][l], nPy = rot[7][l], nPz = rot[8][l];
+      double ceq1 = theRho*(nPx*theSinPhi0-nPy*theCosPhi0);
+      double ceq2 = nPx*theCosPhi0 + nPy*theSinPhi0 + nPz*theCosTheta*theSinThetaI;
+      double ceq3 = nPx*dx[l] + nPy*dy[l] + nPz*dz[l];
+
+      bool linear = !(std::abs(ceq1)>FLT_MIN);
+      double deq1 = ceq2*ceq2;
+      double deq2 = ceq1*ceq3;
+      bool expand = !linear && !(std::abs(deq1)<FLT_MIN || std::abs(deq2/deq1)>1.e-6);
+
+      // standard solution for quadratic equations
+      double deq = deq1+2*deq2;
+      bool ok = linear || expand || deq>=0.;
+      double ceq = ceq2+std::copysign(std::sqrt(std::max(deq,0.)),ceq2);
+      double c1 = linear ? 1. : ceq1;
+      double dS1 = (ceq/c1)*theSinThetaI;
+      double dS2 = -2.*(ceq3/ceq)*theSinThetaI;
+      // solution by expansion of sqrt(1+deq)
+      double ceqe = (ceq2/c1)*theSinThetaI;
+      double deqe = deq2/deq1;
+      deqe *= (1-0.5*deqe);
+      if (expand) { dS1 = -ceqe*deqe; dS2 = ceqe*(2+deqe); }
+      // linear equation
+      if (linear) { ok = ceq2!=0.; dS1 = dS2 = -(ceq3/ceq2)*theSinThetaI; }
+
+      // choice of the solution by direction
+      double path;
+      if (thePropDir == anyDirection) {
+	path = std::abs(dS1)<std::abs(dS2) ? dS1 : dS2;
+      }
+      else {
+	double s1 = std::min(propSign*dS1,propSign*dS2);
+	double s2 = std::max(propSign*dS1,propSign*dS2);
+	ok = ok && s2>=0;
+	path = propSign*(s1>=0 ? s1 : s2);
+      }
+      if (!ok) path = 0;
+
+      // position at the crossing, in the local frame
+      double st = path/theSinThetaI;
+      double gx = dx[l]+(theCosPhi0-(st*0.5*theRho)*theSinPhi0)*st;
+      double gy = dy[l]+(theSinPhi0+(st*0.5*theRho)*theCosPhi0)*st;
+      double gz = dz[l]+st*theCosTheta*theSinThetaI;
+      valid[first+l] = ok;
+      pathLength[first+l] = path;
+      localX[first+l] = rot[0][l]*gx + rot[1][l]*gy + rot[2][l]*gz;
+      localY[first+l] = rot[3][l]*gx + rot[4][l]*gy + rot[5][l]*gz;
+    }
+  }
+}
@@ -3,6 +3,8 @@
 #include "TrackingTools/GeomPropagators/interface/HelixBarrelPlaneCrossing2OrderLocal.h"
 #include "TrackingTools/GeomPropagators/interface/HelixBarrelPlaneCrossingByCircle.h"
 #include "TrackingTools/GeomPropagators/interface/OptimalHelixPlaneCrossing.h"
+#include "TrackingTools/GeomPropagators/interface/HelixArbitraryPlaneCrossing2Order.h"
+#include "TrackingTools/GeomPropagators/interface/HelixMultiPlaneCrossing.h"
 
 
 #include <algorithm>
@@ -10,6 +12,8 @@
 #include<tuple>
 
 #include<iostream>
+#include<memory>
+#include<vector>
 
   typedef Surface::GlobalPoint    GlobalPoint;
   typedef Surface::GlobalVector   GlobalVector;
@@ -206,10 +210,55 @@ void testHelixBarrelPlaneCrossing2OrderLocal() {
 
 
 
+// the crossings with many planes in one go must be those of HelixArbitraryPlaneCrossing2Order
+void testHelixMultiPlaneCrossing() {
+
+  constexpr unsigned int nPlanes = 37;
+  std::vector<std::unique_ptr<Plane> > planes;
+  std::vector<const Plane*> pplanes;
+  for (unsigned int i=0; i<nPlanes; ++i) {
+    float phi = 0.17f*i, a = 0.3f*i;
+    Basic3DVector<float> axis(std::cos(a),std::sin(a),0.3f*(i%3));
+    Surface::RotationType rot(axis,0.2f*i);
+    planes.emplace_back(new Plane(Surface::PositionType(30*std::cos(phi),30*std::sin(phi),5.f*(i%7)-15.f),rot));
+    pplanes.push_back(planes.back().get());
+  }
+
+  HelixPlaneCrossing::PositionType startingPos(1,2,3);
+  HelixPlaneCrossing::DirectionType startingDir(1.,0.5,0.7);
+  for (auto dir : {alongMomentum, oppositeToMomentum, anyDirection}) {
+    for (float rho : {0.f, 0.002f, -0.03f}) {
+      HelixMultiPlaneCrossing mcrossing(startingPos, startingDir, rho, dir);
+      bool valid[nPlanes]; float s[nPlanes], x[nPlanes], y[nPlanes];
+      mcrossing.crossings(nPlanes, pplanes.data(), valid, s, x, y);
+
+      unsigned int nDiff = 0;
+      for (unsigned int i=0; i<nPlanes; ++i) {
+	HelixArbitraryPlaneCrossing2Order crossing(startingPos, startingDir, rho, dir);
+	bool cross; double path;
+	std::tie(cross,path) = crossing.pathLength(*pplanes[i]);
+	if (cross!=valid[i]) { ++nDiff; continue; }
+	if (!cross) continue;
+	LocalPoint lp = pplanes[i]->toLocal(GlobalPoint(crossing.position(path)));
+	float tol = 1.e-5f*std::max(1.f,std::abs(float(path)));
+	if (std::abs(lp.x()-x[i])>tol || std::abs(lp.y()-y[i])>tol || std::abs(path-s[i])>tol) {
+	  std::cout << "plane " << i << ": " << lp << ' ' << path << " batch " << x[i] << ' ' << y[i] << ' ' << s[i] << std::endl;
+	  ++nDiff;
+	}
+      }
+      std::cout << "HelixMultiPlaneCrossing dir " << dir << " rho " << rho << ": " << nDiff << " differences" << std::endl;
+    }
+  }
+}
+
+
 int main() {
 
 
   testHelixBarrelPlaneCrossing2OrderLocal();
+  std::cout << std::endl;
+
+  testHelixMultiPlaneCrossing();
 
   return 0;
 }
@@ -35,8 +35,7 @@ void MultiTrajectoryStateAssembler::addState (const TrajectoryStateOnSurface tso
   // Add components (i.e. state to be added can be single or multi state)
   //
   GetComponents comps(tsos);
-  MultiTSOS components(comps());
-  addStateVector(components);
+  addStateVector(comps());
 }
 
 void MultiTrajectoryStateAssembler::addStateVector (const MultiTSOS& states)
@@ -18,6 +18,11 @@
  * It relies on CLHEP double precision vectors and matrices for 
  * matrix calculations. <BR>
  *
+ * updateBatch updates many states at once: the 1D and 2D measurements are
+ * processed in groups, with the states and hits laid out by component
+ * (structure of arrays) so that the matrix algebra vectorizes over the group.
+ * It gives the same results as update, up to rounding. <BR>
+ *
  * Arguments: TrajectoryState &   predicted state <BR>
  *            RecHit &            reconstructed hit <BR>
  *
@@ -40,6 +45,9 @@ public:
   TrajectoryStateOnSurface update(const TrajectoryStateOnSurface&,
                                   const TrackingRecHit&) const;
 
+  virtual void updateBatch(unsigned int n, const TrajectoryStateOnSurface* const* states,
+                           const TrackingRecHit* const* hits, TrajectoryStateOnSurface* result) const;
+
 
   virtual KFUpdator * clone() const {
     return new KFUpdator(*this);
@@ -70,6 +70,151 @@ TrajectoryStateOnSurface lupdate(const TrajectoryStateOnSurface& tsos,
   }
 
 }
+
+// states updated together by updateBatch
+constexpr unsigned int kBatchSize = 16;
+
+// position of (i,j) in a packed symmetric matrix
+constexpr unsigned int sym(unsigned int i, unsigned int j) {
+  return i>=j ? i*(i+1)/2+j : j*(j+1)/2+i;
+}
+
+template <unsigned int N>
+inline void invertSym(const double (&R)[1][N], double (&Rinv)[1][N], bool (&ok)[N], unsigned int n) {
+  for (unsigned int l=0; l<n; ++l) {
+    ok[l] = R[0][l] > 0;
+    Rinv[0][l] = ok[l] ? 1./R[0][l] : 0;
+  }
+}
+
+template <unsigned int N>
+inline void invertSym(const double (&R)[3][N], double (&Rinv)[3][N], bool (&ok)[N], unsigned int n) {
+  for (unsigned int l=0; l<n; ++l) {
+    double det = R[0][l]*R[2][l] - R[1][l]*R[1][l];
+    ok[l] = R[0][l] > 0 && det > 0;
+    double idet = ok[l] ? 1./det : 0;
+    Rinv[0][l] =  R[2][l]*idet;
+    Rinv[1][l] = -R[1][l]*idet;
+    Rinv[2][l] =  R[0][l]*idet;
+  }
+}
+
+/* Kalman update of up to N states with measurements of dimension D, stored
+ * component by component (structure of arrays): every loop over the states
+ * is innermost, so that the compiler vectorizes it.
+ * The projected covariance H*C is gathered beforehand, the kernel does not
+ * depend on the projection of the hits.  The filtered covariance is computed
+ * in the same (Joseph) form as lupdate, (1-KH) C (1-KH)^T + K V K^T.
+ */
+template <unsigned int D, unsigned int N>
+struct KFBatch {
+  static constexpr unsigned int S = D*(D+1)/2;
+
+  double x[5][N];      // predicted parameters
+  double C[15][N];     // predicted covariance
+  double HC[D][5][N];  // H*C
+  double HCH[S][N];    // H*C*H^T
+  double V[S][N];      // hit covariance
+  double r[D][N];      // residuals
+  bool ok[N];
+
+  void run(unsigned int n) {
+    double R[S][N], Rinv[S][N];
+    for (unsigned int i=0; i<S; ++i)
+      for (unsigned int l=0; l<n; ++l)
+	R[i][l] = V[i][l] + HCH[i][l];
+    invertSym(R, Rinv, ok, n);
+
+    // gain K = C*H^T*R^-1
+    double K[5][D][N];
+    for (unsigned int i=0; i<5; ++i)
+      for (unsigned int j=0; j<D; ++j) {
+	for (unsigned int l=0; l<n; ++l) K[i][j][l] = 0;
+	for (unsigned int m=0; m<D; ++m)
+	  for (unsigned int l=0; l<n; ++l)
+	    K[i][j][l] += HC[m][i][l]*Rinv[sym(m,j)][l];
+      }
+
+    for (unsigned int i=0; i<5; ++i)
+      for (unsigned int j=0; j<D; ++j)
+	for (unsigned int l=0; l<n; ++l)
+	  x[i][l] += K[i][j][l]*r[j][l];
+
+    // W = (1-KH)*C*H^T - K*V, then C' = C - K*H*C - W*K^T
+    double W[5][D][N];
+    for (unsigned int i=0; i<5; ++i)
+      for (unsigned int j=0; j<D; ++j) {
+	for (unsigned int l=0; l<n; ++l) W[i][j][l] = HC[j][i][l];
+	for (unsigned int m=0; m<D; ++m)
+	  for (unsigned int l=0; l<n; ++l)
+	    W[i][j][l] -= K[i][m][l]*(HCH[sym(m,j)][l] + V[sym(m,j)][l]);
+      }
+
+    for (unsigned int i=0; i<5; ++i)
+      for (unsigned int k=0; k<=i; ++k)
+	for (unsigned int j=0; j<D; ++j)
+	  for (unsigned int l=0; l<n; ++l)
+	    C[sym(i,k)][l] -= K[i][j][l]*HC[j][k][l] + W[i][j][l]*K[k][j][l];
+  }
+};
+
+template <unsigned int D>
+void lupdateBatch(unsigned int n, const unsigned int* index,
+		  const TrajectoryStateOnSurface* const* states,
+		  const TrackingRecHit* const* hits,
+		  TrajectoryStateOnSurface* result) {
+
+  typedef typename AlgebraicROOTObject<D,D>::SymMatrix SMatDD;
+  typedef typename AlgebraicROOTObject<D>::Vector VecD;
+  using ROOT::Math::SMatrixNoInit;
+
+  KFBatch<D,kBatchSize> batch;
+  for (unsigned int l=0; l<n; ++l) {
+    auto const & tsos = *states[index[l]];
+    auto && x = tsos.localParameters().vector();
+    auto && C = tsos.localError().matrix();
+
+    ProjectMatrix<double,5,D>  pf;
+    VecD r, rMeas;
+    SMatDD V(SMatrixNoInit{}), VMeas(SMatrixNoInit{});
+    KfComponentsHolder holder;
+    holder.template setup<D>(&r, &V, &pf, &rMeas, &VMeas, x, C);
+    hits[index[l]]->getKfComponents(holder);
+
+    for (unsigned int i=0; i<5; ++i) {
+      batch.x[i][l] = x[i];
+      for (unsigned int k=0; k<=i; ++k) batch.C[sym(i,k)][l] = C(i,k);
+    }
+    for (unsigned int j=0; j<D; ++j) {
+      batch.r[j][l] = r[j] - rMeas[j];
+      for (unsigned int k=0; k<5; ++k) batch.HC[j][k][l] = C(pf.index[j],k);
+      for (unsigned int m=0; m<=j; ++m) {
+	batch.V[sym(j,m)][l] = V(j,m);
+	batch.HCH[sym(j,m)][l] = VMeas(j,m);
+      }
+    }
+  }
+
+  batch.run(n);
+
+  for (unsigned int l=0; l<n; ++l) {
+    auto const & tsos = *states[index[l]];
+    if (!batch.ok[l]) {
+      edm::LogError("KFUpdator")<<" could not invert martix of hit of dimension " << D;
+      result[index[l]] = TrajectoryStateOnSurface();
+      continue;
+    }
+    AlgebraicVector5 fsv;
+    AlgebraicSymMatrix55 fse;
+    for (unsigned int i=0; i<5; ++i) {
+      fsv[i] = batch.x[i][l];
+      for (unsigned int k=0; k<=i; ++k) fse(i,k) = batch.C[sym(i,k)][l];
+    }
+    result[index[l]] = TrajectoryStateOnSurface( LocalTrajectoryParameters(fsv, tsos.localParameters().pzSign()),
+						 LocalTrajectoryError(fse), tsos.surface(),&(tsos.globalParameters().magneticField()), tsos.surfaceSide() );
+  }
+}
+
 }
 
 TrajectoryStateOnSurface KFUpdator::update(const TrajectoryStateOnSurface& tsos,
@@ -86,3 +231,26 @@ TrajectoryStateOnSurface KFUpdator::update(const TrajectoryStateOnSurface& tsos,
         ", type is " << typeid(aRecHit).name() << "\n";
 }
 
+
+void KFUpdator::updateBatch(unsigned int n, const TrajectoryStateOnSurface* const* states,
+                            const TrackingRecHit* const* hits, TrajectoryStateOnSurface* result) const {
+  // the 1D and 2D hits are collected in groups of kBatchSize, the others are updated one by one
+  unsigned int index1[kBatchSize], index2[kBatchSize];
+  unsigned int n1 = 0, n2 = 0;
+  for (unsigned int i = 0; i != n; ++i) {
+    switch (hits[i]->dimension()) {
+        case 1:
+          index1[n1++] = i;
+          if (n1 == kBatchSize) { lupdateBatch<1>(n1, index1, states, hits, result); n1 = 0; }
+          break;
+        case 2:
+          index2[n2++] = i;
+          if (n2 == kBatchSize) { lupdateBatch<2>(n2, index2, states, hits, result); n2 = 0; }
+          break;
+        default:
+          result[i] = update(*states[i], *hits[i]);
+    }
+  }
+  if (n1 > 0) lupdateBatch<1>(n1, index1, states, hits, result);
+  if (n2 > 0) lupdateBatch<2>(n2, index2, states, hits, result);
+}
@@ -14,6 +14,8 @@
 #include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHit.h" 
 #include "DataFormats/TrackerRecHit2D/interface/ProjectedSiStripRecHit2D.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 class ConstMagneticField : public MagneticField {
 public:
@@ -128,6 +130,19 @@ struct KFUTest {
   }
   
 
+  // updateBatch must give the same states as update
+  void batch(std::vector<const TrajectoryStateOnSurface*> const & tsos,
+	     std::vector<const TrackingRecHit*> const & hits) const {
+    std::vector<TrajectoryStateOnSurface> tsn(hits.size());
+    tsu.updateBatch(hits.size(), tsos.data(), hits.data(), tsn.data());
+    for (unsigned int i=0; i!=hits.size(); ++i) {
+      TrajectoryStateOnSurface ref =  tsu.update(*tsos[i], *hits[i]);
+      auto dp = tsn[i].localParameters().vector() - ref.localParameters().vector();
+      auto de = tsn[i].localError().matrix() - ref.localError().matrix();
+      std::cout << "batch " << i << " max diff " << std::max(std::sqrt(ROOT::Math::Dot(dp,dp)), de.MaxNorm()) << std::endl;
+    }
+  }
+
   void time(const TrajectoryStateOnSurface& tsos,
 	     const TrackingRecHit& hit) const {
     edm::HRTimeType s= edm::hrRealTime();
@@ -232,6 +247,16 @@ int main() {
   kt.time(ts,*thit);
   kt.time(ts2,*thit);
 
+  std::vector<const TrajectoryStateOnSurface*> states;
+  std::vector<const TrackingRecHit*> hits;
+  for (int i=0; i<20; ++i) {
+    for (auto h : std::vector<const TrackingRecHit*>{thit, &hit2d, &hitpx, &hitpj, &hit1d}) {
+      states.push_back(i%2 ? &ts : &ts2);
+      hits.push_back(h);
+    }
+  }
+  kt.batch(states,hits);
+
 
 
   std::cout << "\n** Chi2 ** \n" << std::endl;
@@ -19,6 +19,13 @@ class TrajectoryStateUpdator {
   
   virtual TrajectoryStateOnSurface update(const TrajectoryStateOnSurface&,
 					  const TrackingRecHit&) const = 0;
+
+  /// Updates states[i] with hits[i] into result[i], for i < n.
+  /// Implementations may update them together; by default they are updated one by one.
+  virtual void updateBatch(unsigned int n, const TrajectoryStateOnSurface* const* states,
+			   const TrackingRecHit* const* hits, TrajectoryStateOnSurface* result) const {
+    for (unsigned int i = 0; i != n; ++i) result[i] = update(*states[i], *hits[i]);
+  }
   
   virtual TrajectoryStateUpdator * clone() const = 0;
   
@@ -2,6 +2,8 @@
 #define CMSUTILS_BEUEUE_H
 #include <boost/intrusive_ptr.hpp>
 #include<cassert>
+#include<cstddef>
+#include<new>
 
 /**  Backwards linked queue with "head sharing"
 
@@ -23,6 +25,9 @@
      Note that boost::intrusive_ptr is used for items, so they are deleted automatically
      while avoiding problems if one deletes a queue which shares the head with another one
 
+     The memory of the deleted items is kept in a per-thread free list and reused for the
+     next items of the same type, as trajectory building makes and drops many of them.
+
      Disclaimer: I'm not sure the const_iterator is really const-correct..
 
      V.I. 22/08/2012 As the bqueue is made to be shared its content ahs been forced to be constant.
@@ -41,6 +46,32 @@ namespace cmsutils {
   template<class T> void intrusive_ptr_add_ref(_bqueue_item<T> *it) ;
   template<class T> void intrusive_ptr_release(_bqueue_item<T> *it) ;
   
+  // free list of the memory of the items of one type, one per thread;
+  // plain thread_local pointers, so that it is usable up to the very end of the thread
+  template<class T>
+  class _bqueue_item_pool {
+  public:
+    static constexpr unsigned int maxFree = 4096;
+    static void * get(std::size_t sz) {
+      if (head() == nullptr) return ::operator new(sz);
+      Node * n = head();
+      head() = n->next;
+      --nfree();
+      return n;
+    }
+    static void put(void * p) {
+      if (nfree() == maxFree) { ::operator delete(p); return; }
+      Node * n = static_cast<Node *>(p);
+      n->next = head();
+      head() = n;
+      ++nfree();
+    }
+  private:
+    struct Node { Node * next; };
+    static Node * & head() { static thread_local Node * h = nullptr; return h; }
+    static unsigned int & nfree() { static thread_local unsigned int n = 0; return n; }
+  };
+
   template <class T> 
   class _bqueue_item  {
     friend class bqueue<T>;
@@ -49,6 +80,9 @@ namespace cmsutils {
     friend void intrusive_ptr_release<T>(_bqueue_item<T> *it);
     void addRef() { ++refCount; }
     void delRef() { if ((--refCount) == 0) delete this; }
+  public:
+    static void * operator new(std::size_t sz) { return _bqueue_item_pool<T>::get(sz); }
+    static void operator delete(void * p) { _bqueue_item_pool<T>::put(p); }
   private:
     _bqueue_item() : back(0), value(), refCount(0) { }
     _bqueue_item(boost::intrusive_ptr< _bqueue_item<T> > tail, const T &val) : back(tail), value(val), refCount(0) { }
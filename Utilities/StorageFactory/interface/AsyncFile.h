@@ -0,0 +1,29 @@
+#ifndef STORAGE_FACTORY_ASYNC_FILE_H
+# define STORAGE_FACTORY_ASYNC_FILE_H
+
+# include "Utilities/StorageFactory/interface/File.h"
+# include "Utilities/StorageFactory/interface/StorageAccount.h"
+# include <string>
+
+/** Local file issuing the parts of a vector read concurrently.
+
+    Up to @a depth reads of one readv() are in flight at the same time,
+    each done with pread() by a thread of a shared pool of reader threads,
+    so that devices with deep queues (e.g. NVMe) are kept busy.  Each of
+    these reads is accounted as "readAsync" of the "file" storage class.  */
+class AsyncFile : public File
+{
+public:
+  AsyncFile (const std::string &name, int flags, unsigned int depth);
+  ~AsyncFile (void);
+
+  using File::readv;
+
+  virtual IOSize	readv (IOPosBuffer *into, IOSize buffers);
+
+private:
+  unsigned int		m_depth;
+  StorageAccount::Counter &m_statsReadAsync;
+};
+
+#endif // STORAGE_FACTORY_ASYNC_FILE_H
@@ -0,0 +1,72 @@
+#ifndef STORAGE_FACTORY_BLOCK_CACHE_FILE_H
+# define STORAGE_FACTORY_BLOCK_CACHE_FILE_H
+
+# include "Utilities/StorageFactory/interface/Storage.h"
+# include "Utilities/StorageFactory/interface/StorageAccount.h"
+#include "FWCore/Utilities/interface/propagate_const.h"
+# include <atomic>
+# include <vector>
+# include <string>
+# include <memory>
+
+/** Proxy class caching the blocks read from a remote file on a local disk.
+
+    The blocks are kept as files in a directory shared by all the jobs of
+    the node, named after the logical file name, the file size and the block
+    index, so that jobs re-reading the same files (e.g. pileup) read them
+    from the local disk.  A block is fetched from the remote storage when it
+    is first used, and written to a temporary name and renamed, so it is
+    never seen partially written.  Failing to cache a block is not an error.
+    When the cache grows beyond its maximum size, the least recently used
+    blocks are removed.  Reads served from the cache are accounted as
+    "readViaCache" and the blocks fetched as "readPrefetchToCache" of the
+    "block-cache" storage class.  */
+class BlockCacheFile : public Storage
+{
+public:
+  BlockCacheFile (std::unique_ptr<Storage> base, const std::string &name,
+		  const std::string &dir, IOSize blockSize, IOOffset maxSize);
+  ~BlockCacheFile (void);
+
+  using Storage::read;
+  using Storage::readv;
+  using Storage::write;
+
+  virtual IOSize	read (void *into, IOSize n);
+  virtual IOSize	read (void *into, IOSize n, IOOffset pos);
+  virtual IOSize	readv (IOPosBuffer *into, IOSize n);
+  virtual IOSize	write (const void *from, IOSize n);
+  virtual IOSize	write (const void *from, IOSize n, IOOffset pos);
+  virtual IOSize	writev (const IOBuffer *from, IOSize n);
+  virtual IOSize	writev (const IOPosBuffer *from, IOSize n);
+
+  virtual IOOffset	size (void) const;
+  virtual IOOffset	position (IOOffset offset, Relative whence = SET);
+  virtual void		resize (IOOffset size);
+  virtual void		flush (void);
+  virtual void		close (void);
+
+  /// Name identifying the file @a url in the cache: its LFN, if it has one.
+  static std::string	logicalName (const std::string &url);
+
+private:
+  IOSize		blockLength (IOSize index) const;
+  std::string		blockPath (IOSize index) const;
+  void			getBlocks (const std::vector<IOSize> &blocks, std::vector<char> &data);
+  bool			load (IOSize index, char *into);
+  void			store (IOSize index, const char *from, IOSize len);
+  void			evict (void);
+
+  IOOffset		image_;
+  IOOffset		position_;
+  IOSize		blockSize_;
+  IOOffset		maxSize_;
+  std::string		dir_;
+  std::string		fileDir_;
+  std::atomic<IOOffset>	stored_;
+  edm::propagate_const<std::unique_ptr<Storage>> storage_;
+  StorageAccount::Counter &statsHit_;
+  StorageAccount::Counter &statsMiss_;
+};
+
+#endif // STORAGE_FACTORY_BLOCK_CACHE_FILE_H
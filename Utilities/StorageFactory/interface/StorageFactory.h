@@ -51,6 +51,14 @@ public:
   void          setDebugLevel(unsigned int level);
   unsigned int  debugLevel(void) const;
 
+  void		setAsyncReadDepth(unsigned int depth);
+  unsigned int	asyncReadDepth(void) const;
+
+  void		setBlockCache (const std::string &dir, IOSize blockSize, double maxSize);
+  std::string	blockCacheDir (void) const;
+  IOSize	blockCacheBlockSize (void) const;
+  double	blockCacheMaxSize (void) const;
+
   void		setTempDir (const std::string &s, double minFreeSpace);
   std::string	tempDir (void) const;
   std::string	tempPath (void) const;
@@ -86,6 +94,10 @@ private:
   std::string m_unusableDirWarnings;
   unsigned int  m_timeout;
   unsigned int  m_debugLevel;
+  unsigned int  m_asyncReadDepth;
+  std::string	m_blockCacheDir;
+  IOSize	m_blockCacheBlockSize;
+  double	m_blockCacheMaxSize;
   LocalFileSystem m_lfs;
   static StorageFactory s_instance;
 };
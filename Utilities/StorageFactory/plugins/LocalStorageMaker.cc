@@ -4,6 +4,7 @@
 #include "Utilities/StorageFactory/interface/StorageMakerFactory.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 #include "Utilities/StorageFactory/interface/File.h"
+#include "Utilities/StorageFactory/interface/AsyncFile.h"
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -26,7 +27,11 @@ public:
       else
 	mode |= IOFlags::OpenUnbuffered;
 
-      auto file = std::make_unique<File> (path, mode);
+      std::unique_ptr<Storage> file;
+      if (f->asyncReadDepth() > 1 && ! (mode & IOFlags::OpenWrite))
+	file = std::make_unique<AsyncFile> (path, mode, f->asyncReadDepth());
+      else
+	file = std::make_unique<File> (path, mode);
       return f->wrapNonLocalFile (std::move(file), proto, path, mode);
     }
 
@@ -0,0 +1,172 @@
+#include "Utilities/StorageFactory/interface/AsyncFile.h"
+#include "Utilities/StorageFactory/src/Throw.h"
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <unistd.h>
+
+namespace {
+  /** Threads doing the reads of all the AsyncFiles.  They spend their
+      time blocked in the kernel, so they do not compete with the
+      processing threads for CPU.  */
+  class ReaderPool
+  {
+  public:
+    static ReaderPool &instance (void)
+    {
+      static ReaderPool s_pool;
+      return s_pool;
+    }
+
+    ~ReaderPool (void)
+    {
+      {
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_stop = true;
+      }
+      m_wakeup.notify_all();
+      for (auto &thread : m_threads)
+	thread.join();
+    }
+
+    /// Make sure at least @a n threads exist.
+    void reserve (unsigned int n)
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      while (m_threads.size() < n)
+	m_threads.emplace_back([this](){ run(); });
+    }
+
+    void submit (std::function<void()> work)
+    {
+      {
+	std::lock_guard<std::mutex> guard(m_mutex);
+	m_work.push_back(std::move(work));
+      }
+      m_wakeup.notify_one();
+    }
+
+  private:
+    ReaderPool (void) : m_stop(false) {}
+
+    void run (void)
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (true)
+      {
+	m_wakeup.wait(lock, [this](){ return m_stop || ! m_work.empty(); });
+	if (m_work.empty())
+	  return;
+	auto work = std::move(m_work.front());
+	m_work.pop_front();
+	lock.unlock();
+	work();
+	lock.lock();
+      }
+    }
+
+    std::mutex				m_mutex;
+    std::condition_variable		m_wakeup;
+    std::deque<std::function<void()>>	m_work;
+    std::vector<std::thread>		m_threads;
+    bool				m_stop;
+  };
+
+  /** Outcome of the read of one buffer.  */
+  struct ReadResult
+  {
+    IOSize	size = 0;
+    int		error = 0;
+  };
+}
+
+AsyncFile::AsyncFile (const std::string &name, int flags, unsigned int depth)
+  : File (name, flags),
+    m_depth (std::max(depth, 1U)),
+    m_statsReadAsync (StorageAccount::counter (StorageAccount::tokenForStorageClassName("file"),
+					       StorageAccount::Operation::readAsync))
+{
+  ReaderPool::instance().reserve(m_depth);
+}
+
+AsyncFile::~AsyncFile (void)
+{}
+
+/** Read the buffers @a into, keeping up to the configured depth of
+    reads in flight, and wait for all of them.  As for the sequential
+    Storage::readv(), the result is the number of bytes read into the
+    buffers up to the first incomplete one; an error is thrown only if
+    nothing at all could be read.  */
+IOSize
+AsyncFile::readv (IOPosBuffer *into, IOSize buffers)
+{
+  if (buffers == 0)
+    return 0;
+
+  IOFD fd = this->fd ();
+  std::vector<ReadResult> results (buffers);
+  std::mutex mutex;
+  std::condition_variable done;
+  IOSize next = 0;
+  unsigned int running = std::min<IOSize>(m_depth, buffers);
+
+  // each reader takes the next buffer not yet read, until there are none left
+  auto reader = [&]() {
+    while (true)
+    {
+      IOSize i;
+      {
+	std::lock_guard<std::mutex> guard(mutex);
+	if (next == buffers)
+	  break;
+	i = next++;
+      }
+      StorageAccount::Stamp stats (m_statsReadAsync);
+      char *data = static_cast<char *>(into[i].data());
+      IOSize size = into[i].size();
+      IOOffset pos = into[i].offset();
+      assert (pos >= 0);
+      while (results[i].size < size)
+      {
+	ssize_t s = ::pread (fd, data + results[i].size, size - results[i].size, pos + results[i].size);
+	if (s == -1 && errno == EINTR)
+	  continue;
+	if (s == -1)
+	  results[i].error = errno;
+	if (s <= 0)
+	  break;
+	results[i].size += s;
+      }
+      stats.tick (results[i].size);
+    }
+    std::lock_guard<std::mutex> guard(mutex);
+    if (--running == 0)
+      done.notify_one();
+  };
+
+  for (unsigned int i = 1, n = running; i < n; ++i)
+    ReaderPool::instance().submit(reader);
+  // the calling thread is one of the readers
+  reader();
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&running](){ return running == 0; });
+  }
+
+  IOSize total = 0;
+  for (IOSize i = 0; i < buffers; ++i)
+  {
+    if (results[i].error && total == 0)
+      throwStorageError(edm::errors::FileReadError, "Calling AsyncFile::readv()", "pread()", results[i].error);
+    total += results[i].size;
+    if (results[i].error || results[i].size < into[i].size())
+      break;
+  }
+  return total;
+}
@@ -0,0 +1,399 @@
+#include "Utilities/StorageFactory/interface/BlockCacheFile.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+// number of blocks fetched from the remote storage with one vector read
+static const IOSize BLOCK_BATCH = 16;
+// fraction of the maximum size stored by a file between two eviction passes
+static const IOOffset EVICTION_INTERVAL = 16;
+// fraction of the maximum size left in use by an eviction pass, in percent
+static const IOOffset EVICTION_TARGET = 90;
+
+/// A hash of @a key which is the same for every job: the FNV-1a hash.
+static std::string
+stableHash(const std::string &key)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key)
+  {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  std::ostringstream out;
+  out << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return out.str();
+}
+
+static void
+nowrite(const std::string &why)
+{
+  cms::Exception ex("BlockCacheFile");
+  ex << "Cannot change file but operation '" << why << "' was called";
+  ex.addContext("BlockCacheFile::" + why + "()");
+  throw ex;
+}
+
+
+BlockCacheFile::BlockCacheFile(std::unique_ptr<Storage> base, const std::string &name,
+			       const std::string &dir, IOSize blockSize, IOOffset maxSize)
+  : image_(base->size()),
+    position_(0),
+    blockSize_(blockSize),
+    maxSize_(maxSize),
+    dir_(dir),
+    stored_(0),
+    storage_(std::move(base)),
+    statsHit_(StorageAccount::counter(StorageAccount::tokenForStorageClassName("block-cache"),
+				      StorageAccount::Operation::readViaCache)),
+    statsMiss_(StorageAccount::counter(StorageAccount::tokenForStorageClassName("block-cache"),
+				       StorageAccount::Operation::readPrefetchToCache))
+{
+  // the size is part of the key so that a file of the same name but
+  // different content never picks up stale blocks
+  std::ostringstream key;
+  key << name << ':' << image_;
+  fileDir_ = dir_ + "/" + stableHash(key.str());
+
+  // the directories are shared with the other jobs: they may exist already
+  mkdir(dir_.c_str(), 0755);
+  mkdir(fileDir_.c_str(), 0755);
+}
+
+BlockCacheFile::~BlockCacheFile(void)
+{
+}
+
+std::string
+BlockCacheFile::logicalName(const std::string &url)
+{
+  std::string name = url.substr(0, url.find('?'));
+  size_t lfn = name.find("/store/");
+  return lfn == std::string::npos ? name : name.substr(lfn);
+}
+
+IOSize
+BlockCacheFile::blockLength(IOSize index) const
+{
+  return std::min<IOOffset>(blockSize_, image_ - static_cast<IOOffset>(index) * blockSize_);
+}
+
+std::string
+BlockCacheFile::blockPath(IOSize index) const
+{
+  std::ostringstream path;
+  path << fileDir_ << '/' << index;
+  return path.str();
+}
+
+bool
+BlockCacheFile::load(IOSize index, char *into)
+{
+  int fd = ::open(blockPath(index).c_str(), O_RDONLY);
+  if (fd == -1)
+    return false;
+
+  StorageAccount::Stamp stats(statsHit_);
+  IOSize len = blockLength(index);
+  IOSize done = 0;
+  while (done < len)
+  {
+    ssize_t n = ::pread(fd, into + done, len - done, done);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+    done += n;
+  }
+
+  // mark the block as recently used for the eviction; this may fail
+  // if the block was written by a job of another user, which is harmless
+  if (done == len)
+    ::futimens(fd, nullptr);
+  ::close(fd);
+
+  if (done != len)
+    return false;
+  stats.tick(len);
+  return true;
+}
+
+void
+BlockCacheFile::store(IOSize index, const char *from, IOSize len)
+{
+  // write to a name unique to this process and call, then rename: other jobs either see the whole block or none
+  static std::atomic<unsigned int> s_counter(0);
+  std::string target = blockPath(index);
+  std::ostringstream temporary;
+  temporary << target << ".tmp." << ::getpid() << "." << s_counter++;
+
+  int fd = ::open(temporary.str().c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+  if (fd == -1 && errno == ENOENT)
+  {
+    // the directory of the file was removed from under us, e.g. by a cleanup of the cache
+    mkdir(dir_.c_str(), 0755);
+    mkdir(fileDir_.c_str(), 0755);
+    fd = ::open(temporary.str().c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+  }
+  if (fd == -1)
+    return;
+
+  IOSize done = 0;
+  while (done < len)
+  {
+    ssize_t n = ::write(fd, from + done, len - done);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+    done += n;
+  }
+  bool ok = (::close(fd) == 0) && done == len;
+  if (ok)
+    ok = (::rename(temporary.str().c_str(), target.c_str()) == 0);
+  if (! ok)
+  {
+    ::unlink(temporary.str().c_str());
+    return;
+  }
+
+  if ((stored_ += len) >= maxSize_ / EVICTION_INTERVAL)
+  {
+    stored_ = 0;
+    evict();
+  }
+}
+
+/** Remove the least recently used blocks of all the files in the cache
+    until it is back under the maximum size.  Other jobs may be evicting
+    at the same time, so the files may disappear while we look at them;
+    a reader which opened a block before it is removed still reads it.  */
+void
+BlockCacheFile::evict(void)
+{
+  struct Entry
+  {
+    time_t	used;
+    IOOffset	size;
+    std::string	path;
+  };
+
+  std::vector<Entry> entries;
+  IOOffset total = 0;
+  if (DIR *top = opendir(dir_.c_str()))
+  {
+    while (struct dirent *file = readdir(top))
+    {
+      if (file->d_name[0] == '.')
+	continue;
+      std::string fileDir = dir_ + "/" + file->d_name;
+      DIR *blocks = opendir(fileDir.c_str());
+      if (! blocks)
+	continue;
+      while (struct dirent *block = readdir(blocks))
+      {
+	if (block->d_name[0] == '.')
+	  continue;
+	std::string path = fileDir + "/" + block->d_name;
+	struct stat st;
+	if (::stat(path.c_str(), &st) != 0 || ! S_ISREG(st.st_mode))
+	  continue;
+	entries.push_back(Entry{st.st_mtime, st.st_size, path});
+	total += st.st_size;
+      }
+      closedir(blocks);
+    }
+    closedir(top);
+  }
+
+  if (total <= maxSize_)
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+	    [](const Entry &a, const Entry &b) { return a.used < b.used; });
+  IOOffset target = maxSize_ / 100 * EVICTION_TARGET;
+  for (const auto &entry : entries)
+  {
+    if (total <= target)
+      break;
+    if (::unlink(entry.path.c_str()) == 0)
+      total -= entry.size;
+  }
+}
+
+/** Make the data of the @a blocks available in @a data, one block
+    every blockSize_ bytes.  The blocks not in the cache are fetched
+    from the remote storage with a single vector read and stored.  */
+void
+BlockCacheFile::getBlocks(const std::vector<IOSize> &blocks, std::vector<char> &data)
+{
+  data.resize(blocks.size() * blockSize_);
+
+  std::vector<IOPosBuffer> missing;
+  std::vector<IOSize> missingIndex;
+  IOSize expected = 0;
+  for (IOSize i = 0; i < blocks.size(); ++i)
+  {
+    char *into = &data[i * blockSize_];
+    if (! load(blocks[i], into))
+    {
+      missing.emplace_back(static_cast<IOOffset>(blocks[i]) * blockSize_, into, blockLength(blocks[i]));
+      missingIndex.push_back(blocks[i]);
+      expected += missing.back().size();
+    }
+  }
+  if (missing.empty())
+    return;
+
+  StorageAccount::Stamp stats(statsMiss_);
+  IOSize nread;
+  try
+  {
+    if (missing.size() == 1)
+      nread = storage_->read(missing[0].data(), missing[0].size(), missing[0].offset());
+    else
+      nread = storage_->readv(&missing[0], missing.size());
+  }
+  catch (cms::Exception &e)
+  {
+    std::ostringstream ost;
+    ost << "Unable to cache " << missing.size() << " blocks of " << blockSize_ << " bytes: ";
+    edm::Exception ex(edm::errors::FileReadError, ost.str(), e);
+    ex.addContext("BlockCacheFile::getBlocks()");
+    throw ex;
+  }
+
+  if (nread != expected)
+  {
+    edm::Exception ex(edm::errors::FileReadError);
+    ex << "Unable to cache " << missing.size() << " blocks of " << blockSize_
+       << " bytes: got only " << nread << " of " << expected << " bytes back";
+    ex.addContext("BlockCacheFile::getBlocks()");
+    throw ex;
+  }
+  stats.tick(nread);
+
+  for (IOSize i = 0; i < missing.size(); ++i)
+    store(missingIndex[i], static_cast<const char *>(missing[i].data()), missing[i].size());
+}
+
+IOSize
+BlockCacheFile::read(void *into, IOSize n)
+{
+  IOSize nread = read(into, n, position_);
+  position_ += nread;
+  return nread;
+}
+
+IOSize
+BlockCacheFile::read(void *into, IOSize n, IOOffset pos)
+{
+  IOPosBuffer buffer(pos, into, n);
+  return readv(&buffer, 1);
+}
+
+IOSize
+BlockCacheFile::readv(IOPosBuffer *into, IOSize n)
+{
+  // the blocks touched by the request, and the amount of data before the end of file
+  std::vector<IOSize> blocks;
+  IOSize total = 0;
+  for (IOSize i = 0; i < n; ++i)
+  {
+    IOOffset start = into[i].offset();
+    IOOffset end = std::min<IOOffset>(start + into[i].size(), image_);
+    if (start >= end)
+      continue;
+    total += end - start;
+    for (IOSize block = start / blockSize_; block <= (end - 1) / blockSize_; ++block)
+      blocks.push_back(block);
+  }
+  std::sort(blocks.begin(), blocks.end());
+  blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+
+  std::vector<char> data;
+  std::vector<IOSize> batch;
+  for (IOSize first = 0; first < blocks.size(); first += BLOCK_BATCH)
+  {
+    batch.assign(blocks.begin() + first, blocks.begin() + std::min<IOSize>(first + BLOCK_BATCH, blocks.size()));
+    getBlocks(batch, data);
+
+    // copy the parts of the buffers inside this batch of blocks
+    IOOffset batchStart = static_cast<IOOffset>(batch.front()) * blockSize_;
+    IOOffset batchEnd = static_cast<IOOffset>(batch.back()) * blockSize_ + blockLength(batch.back());
+    for (IOSize i = 0; i < n; ++i)
+    {
+      IOOffset start = std::max<IOOffset>(into[i].offset(), batchStart);
+      IOOffset end = std::min<IOOffset>(std::min<IOOffset>(into[i].offset() + into[i].size(), image_), batchEnd);
+      while (start < end)
+      {
+	IOSize block = start / blockSize_;
+	IOOffset blockEnd = std::min<IOOffset>(end, static_cast<IOOffset>(block + 1) * blockSize_);
+	auto k = std::lower_bound(batch.begin(), batch.end(), block);
+	if (k != batch.end() && *k == block)
+	  memcpy(static_cast<char *>(into[i].data()) + (start - into[i].offset()),
+		 &data[(k - batch.begin()) * blockSize_ + (start - static_cast<IOOffset>(block) * blockSize_)],
+		 blockEnd - start);
+	start = blockEnd;
+      }
+    }
+  }
+
+  return total;
+}
+
+IOSize
+BlockCacheFile::write(const void */*from*/, IOSize)
+{ nowrite("write"); return 0; }
+
+IOSize
+BlockCacheFile::write(const void */*from*/, IOSize, IOOffset /*pos*/)
+{ nowrite("write"); return 0; }
+
+IOSize
+BlockCacheFile::writev(const IOBuffer */*from*/, IOSize)
+{ nowrite("writev"); return 0; }
+
+IOSize
+BlockCacheFile::writev(const IOPosBuffer */*from*/, IOSize)
+{ nowrite("writev"); return 0; }
+
+IOOffset
+BlockCacheFile::size(void) const
+{ return image_; }
+
+IOOffset
+BlockCacheFile::position(IOOffset offset, Relative whence)
+{
+  if (whence == CURRENT)
+    offset += position_;
+  else if (whence == END)
+    offset += image_;
+  if (offset < 0)
+  {
+    cms::Exception ex("BlockCacheFile");
+    ex << "Cannot seek to negative position " << offset;
+    ex.addContext("BlockCacheFile::position()");
+    throw ex;
+  }
+  return position_ = offset;
+}
+
+void
+BlockCacheFile::resize(IOOffset /*size*/)
+{ nowrite("resize"); }
+
+void
+BlockCacheFile::flush(void)
+{ nowrite("flush"); }
+
+void
+BlockCacheFile::close(void)
+{ storage_->close(); }
@@ -3,6 +3,7 @@
 #include "Utilities/StorageFactory/interface/StorageAccount.h"
 #include "Utilities/StorageFactory/interface/StorageAccountProxy.h"
 #include "Utilities/StorageFactory/interface/LocalCacheFile.h"
+#include "Utilities/StorageFactory/interface/BlockCacheFile.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/PluginManager/interface/standard.h"
@@ -17,7 +18,10 @@ StorageFactory::StorageFactory (void)
     m_tempfree (4.), // GB
     m_temppath (".:$TMPDIR"),
     m_timeout(0U),
-    m_debugLevel(0U)
+    m_debugLevel(0U),
+    m_asyncReadDepth(0U),
+    m_blockCacheBlockSize(1024*1024),
+    m_blockCacheMaxSize(10.) // GB
 {
   setTempDir(m_temppath, m_tempfree);
 }
@@ -78,6 +82,34 @@ unsigned int
 StorageFactory::debugLevel(void) const
 { return m_debugLevel; }
 
+void
+StorageFactory::setAsyncReadDepth(unsigned int depth)
+{ m_asyncReadDepth = depth; }
+
+unsigned int
+StorageFactory::asyncReadDepth(void) const
+{ return m_asyncReadDepth; }
+
+void
+StorageFactory::setBlockCache(const std::string &dir, IOSize blockSize, double maxSize)
+{
+  m_blockCacheDir = dir;
+  m_blockCacheBlockSize = blockSize;
+  m_blockCacheMaxSize = maxSize;
+}
+
+std::string
+StorageFactory::blockCacheDir(void) const
+{ return m_blockCacheDir; }
+
+IOSize
+StorageFactory::blockCacheBlockSize(void) const
+{ return m_blockCacheBlockSize; }
+
+double
+StorageFactory::blockCacheMaxSize(void) const
+{ return m_blockCacheMaxSize; }
+
 void
 StorageFactory::setTempDir(const std::string &s, double minFreeSpace)
 {
@@ -186,6 +218,17 @@ StorageFactory::open (const std::string &url, int mode /* = IOFlags::OpenRead */
       {
 	if (dynamic_cast<LocalCacheFile *>(storage.get()))
 	  protocol = "local-cache";
+	else if (! m_blockCacheDir.empty() && m_blockCacheBlockSize && protocol != "file"
+		 && ! (mode & IOFlags::OpenWrite))
+	{
+	  // read-through cache of the remote file on the local disk
+	  if (m_accounting)
+	    storage = std::make_unique<StorageAccountProxy>(protocol, std::move(storage));
+	  storage = std::make_unique<BlockCacheFile>(std::move(storage), BlockCacheFile::logicalName(url),
+						     m_blockCacheDir, m_blockCacheBlockSize,
+						     static_cast<IOOffset>(m_blockCacheMaxSize * 1024 * 1024 * 1024));
+	  protocol = "block-cache";
+	}
 
 	if (m_accounting)
     ret = std::make_unique<StorageAccountProxy>(protocol, std::move(storage));
@@ -6,6 +6,7 @@
 
 #include "XrdRequest.h"
 #include "XrdRequestManager.h"
+#include "XrdSource.h"
 
 using namespace XrdAdaptor;
 
@@ -33,7 +34,13 @@ XrdAdaptor::ClientRequest::HandleResponse(XrdCl::XRootDStatus *stat, XrdCl::AnyO
     }
     m_stats = nullptr; // propagate_const<T> has no reset() function
 
-    if ((!FAKE_ERROR_COUNTER || ((++g_fakeError % FAKE_ERROR_COUNTER) != 0)) && (status->IsOK() && resp))
+    bool success = (!FAKE_ERROR_COUNTER || ((++g_fakeError % FAKE_ERROR_COUNTER) != 0)) && (status->IsOK() && resp);
+    if (m_source)
+    {
+        m_source->performance().finishRead(m_size, std::chrono::steady_clock::now() - m_start, success);
+    }
+
+    if (success)
     {
         if (m_into)
         {
@@ -1,6 +1,7 @@
 #ifndef Utilities_XrdAdaptor_XrdRequest_h
 #define Utilities_XrdAdaptor_XrdRequest_h
 
+#include <chrono>
 #include <future>
 #include <vector>
 
@@ -74,6 +75,12 @@ public:
 
     size_t getCount() const {return m_into ? 1 : m_iolist->size();}
 
+    /**
+     * Destination and offset of a single read; the buffer is nullptr for vector reads.
+     */
+    void * getBuffer() const {return m_into;}
+    IOOffset getOffset() const {return m_off;}
+
     /**
      * Returns a pointer to the current source; may be nullptr
      * if there is no outstanding IO
@@ -104,6 +111,8 @@ private:
     std::promise<IOSize> m_promise;
 
     QualityMetricWatch m_qmw;
+    // Start of the outstanding IO; feeds the latency and bandwidth estimates of the source.
+    std::chrono::steady_clock::time_point m_start;
 };
 
 }
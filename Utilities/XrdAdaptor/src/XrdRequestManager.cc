@@ -1,7 +1,10 @@
 
 #include <assert.h>
+#include <string.h>
 #include <iostream>
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <netdb.h>
 
 #include "XrdCl/XrdClFile.hh"
@@ -35,6 +38,20 @@
 
 #define XRD_ADAPTOR_CHUNK_THRESHOLD 1000
 
+// Maximum number of sources reads are spread over at once.
+#define XRD_ADAPTOR_MAX_ACTIVE_SOURCES 3
+// Percentage of single reads sent round-robin rather than to the fastest source,
+// so the estimates of every active source are kept up to date.
+#define XRD_ADAPTOR_EXPLORE_PERCENT 5
+
+// Single reads up to this size, to a source which recently had a straggler, are
+// duplicated to a second source when the first one takes XRD_ADAPTOR_HEDGE_FACTOR
+// times longer than expected (and at least XRD_ADAPTOR_HEDGE_MIN_DELAY ms).  Set the
+// size to 0 to disable hedging.
+#define XRD_ADAPTOR_HEDGE_MAX_SIZE 1024*1024
+#define XRD_ADAPTOR_HEDGE_FACTOR 4
+#define XRD_ADAPTOR_HEDGE_MIN_DELAY 100
+
 
 #ifdef __MACH__
 #include <mach/clock.h>
@@ -87,6 +104,64 @@ class SendMonitoringInfoHandler : boost::noncopyable, public XrdCl::ResponseHand
 [[cms::thread_safe]] SendMonitoringInfoHandler nullHandler;
 
 
+/*
+ * A single read into a buffer owned by the request itself.  Used for hedged reads:
+ * the read which loses the race may still be outstanding after the client got its
+ * data, so it must not write into the client buffer.
+ */
+class BufferedClientRequest : public ClientRequest
+{
+public:
+    /*
+     * Shared by the two reads of a hedged pair; the waiting client is woken up by
+     * each response.
+     */
+    struct Race
+    {
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        unsigned m_responses = 0;
+    };
+
+    BufferedClientRequest(std::shared_ptr<RequestManager> manager, std::shared_ptr<Race> race, IOSize size, IOOffset off)
+      : BufferedClientRequest(std::move(manager), std::move(race), std::unique_ptr<char[]>(new char[size]), size, off)
+    {}
+
+    virtual void HandleResponse(XrdCl::XRootDStatus *status, XrdCl::AnyObject *response) override
+    {
+        // The base class may drop the last reference to this request: only the local copy
+        // of the race can be used afterwards.
+        std::shared_ptr<Race> race = m_race;
+        ClientRequest::HandleResponse(status, response);
+        {
+            std::lock_guard<std::mutex> sentry(race->m_mutex);
+            race->m_responses++;
+        }
+        race->m_cv.notify_all();
+    }
+
+    IOSize copyTo(void *into, IOSize size) const
+    {
+        memcpy(into, m_buffer.get(), size);
+        return size;
+    }
+
+private:
+    BufferedClientRequest(std::shared_ptr<RequestManager> manager, std::shared_ptr<Race> race, std::unique_ptr<char[]> buffer, IOSize size, IOOffset off)
+      : ClientRequest(*manager, buffer.get(), size, off),
+        m_buffer(std::move(buffer)),
+        m_manager_ref(std::move(manager)),
+        m_race(std::move(race))
+    {}
+
+    std::unique_ptr<char[]> m_buffer;
+    // The loser may complete, or fail and call back into the RequestManager, after the
+    // client returned and the XrdFile released the RequestManager: keep it alive until then.
+    std::shared_ptr<RequestManager> m_manager_ref;
+    std::shared_ptr<Race> m_race;
+};
+
+
 static void
 SendMonitoringInfo(XrdCl::File &file)
 {
@@ -115,7 +190,7 @@ SendMonitoringInfo(XrdCl::File &file)
 RequestManager::RequestManager(const std::string &filename, XrdCl::OpenFlags::Flags flags, XrdCl::Access::Mode perms)
     : m_serverToAdvertise(nullptr),
       m_timeout(XRD_DEFAULT_TIMEOUT),
-      m_nextInitialSourceToggle(false),
+      m_nextInitialSource(0),
       m_name(filename),
       m_flags(flags),
       m_perms(perms),
@@ -128,6 +203,7 @@ RequestManager::RequestManager(const std::string &filename, XrdCl::OpenFlags::Fl
 void
 RequestManager::initialize(std::weak_ptr<RequestManager> self)
 {
+  m_self_weak = self;
   m_open_handler = OpenHandler::getInstance(self);
 
   XrdCl::Env *env = XrdCl::DefaultEnv::GetEnv();
@@ -331,10 +407,8 @@ RequestManager::checkSources(timespec &now, IOSize requestSize,
     << "; next check " << m_nextActiveSourceCheck.tv_sec << std::endl;  
   if (timeDiffMS(now, m_lastSourceCheck) > 1000)
   {
-    { // Be more aggressive about getting rid of very bad sources.
-      compareSources(now, 0, 1, activeSources, inactiveSources);
-      compareSources(now, 1, 0, activeSources, inactiveSources);
-    }
+    // Be more aggressive about getting rid of very bad sources.
+    pruneActiveSources(now, activeSources, inactiveSources);
     if (timeDiffMS(now, m_nextActiveSourceCheck) > 0)
     {
       checkSourcesImpl(now, requestSize, activeSources, inactiveSources);
@@ -367,6 +441,26 @@ RequestManager::compareSources(const timespec &now, unsigned a, unsigned b,
   return findNewSource;
 }
 
+bool
+RequestManager::pruneActiveSources(const timespec &now,
+                                   std::vector<std::shared_ptr<Source>>& activeSources,
+                                   std::vector<std::shared_ptr<Source>>& inactiveSources) const
+{
+  bool findNewSource = false;
+  // Walk backward so removing a source does not skip the next one; the best
+  // source is never removed.
+  for (unsigned idx = activeSources.size(); idx-- > 0; )
+  {
+    unsigned best = std::min_element(activeSources.cbegin(), activeSources.cend(),
+        [](const std::shared_ptr<Source> &s1, const std::shared_ptr<Source> &s2) {return s1->getQuality() < s2->getQuality();}) - activeSources.cbegin();
+    if (idx != best)
+    {
+      findNewSource |= compareSources(now, idx, best, activeSources, inactiveSources);
+    }
+  }
+  return findNewSource;
+}
+
 void
 RequestManager::checkSourcesImpl(timespec &now,
                                  IOSize requestSize,
@@ -381,9 +475,15 @@ RequestManager::checkSourcesImpl(timespec &now,
   }
   else if (activeSources.size() > 1)
   {
-    edm::LogVerbatim("XrdAdaptorInternal") << "Source 0 quality " << activeSources[0]->getQuality() << ", source 1 quality " << activeSources[1]->getQuality() << std::endl;
-    findNewSource |= compareSources(now, 0, 1, activeSources,inactiveSources);
-    findNewSource |= compareSources(now, 1, 0,activeSources, inactiveSources);
+    for (unsigned idx = 0; idx < activeSources.size(); idx++)
+    {
+      edm::LogVerbatim("XrdAdaptorInternal") << "Source " << idx << " quality " << activeSources[idx]->getQuality()
+          << ", latency " << activeSources[idx]->performance().latencyMS() << " ms, bandwidth "
+          << activeSources[idx]->performance().bandwidth() << " bytes/ms" << std::endl;
+    }
+    findNewSource |= pruneActiveSources(now, activeSources, inactiveSources);
+    // Keep searching until we have as many sources as we are willing to read from.
+    if (activeSources.size() < XRD_ADAPTOR_MAX_ACTIVE_SOURCES) {findNewSource = true;}
 
     // NOTE: We could probably replace the copy with a better sort function.
     // However, there are typically very few sources and the correctness is more obvious right now.
@@ -396,6 +496,8 @@ RequestManager::checkSourcesImpl(timespec &now,
         [](const std::shared_ptr<Source> &s1, const std::shared_ptr<Source> &s2) {return s1->getQuality() < s2->getQuality();});
     auto worstActiveSource = std::max_element(activeSources.cbegin(), activeSources.cend(),
         [](const std::shared_ptr<Source> &s1, const std::shared_ptr<Source> &s2) {return s1->getQuality() < s2->getQuality();});
+    auto bestActiveSource = std::min_element(activeSources.cbegin(), activeSources.cend(),
+        [](const std::shared_ptr<Source> &s1, const std::shared_ptr<Source> &s2) {return s1->getQuality() < s2->getQuality();});
     if (bestInactiveSource != eligibleInactiveSources.end() && bestInactiveSource->get())
     {
       edm::LogVerbatim("XrdAdaptorInternal") << "Best inactive source: " <<(*bestInactiveSource)->PrettyID()
@@ -403,9 +505,9 @@ RequestManager::checkSourcesImpl(timespec &now,
     }
     edm::LogVerbatim("XrdAdaptorInternal") << "Worst active source: " <<(*worstActiveSource)->PrettyID() 
         << ", quality " << (*worstActiveSource)->getQuality();
-        // Only upgrade the source if we only have one source and the best inactive one isn't too horrible.
+        // Only upgrade the source if we have room for another source and the best inactive one isn't too horrible.
         // Regardless, we will want to re-evaluate the new source quickly (within 5s).
-    if ((bestInactiveSource != eligibleInactiveSources.end()) && activeSources.size() == 1 && ((*bestInactiveSource)->getQuality() < 4*activeSources[0]->getQuality()))
+    if ((bestInactiveSource != eligibleInactiveSources.end()) && activeSources.size() < XRD_ADAPTOR_MAX_ACTIVE_SOURCES && ((*bestInactiveSource)->getQuality() < 4*(*bestActiveSource)->getQuality()))
     {
         auto oldSources = activeSources;
         activeSources.push_back(*bestInactiveSource);
@@ -447,8 +549,8 @@ RequestManager::checkSourcesImpl(timespec &now,
     m_lastSourceCheck = now;
   }
 
-  // Only aggressively look for new sources if we don't have two.
-  if (activeSources.size() == 2)
+  // Only aggressively look for new sources if we don't have enough.
+  if (activeSources.size() >= XRD_ADAPTOR_MAX_ACTIVE_SOURCES)
   {
     now.tv_sec += XRD_ADAPTOR_LONG_OPEN_DELAY - XRD_ADAPTOR_SHORT_OPEN_DELAY;
   }
@@ -524,22 +626,28 @@ RequestManager::addConnections(cms::Exception &ex) const
 }
 
 std::shared_ptr<Source>
-RequestManager::pickSingleSource()
+RequestManager::pickSingleSource(IOSize size)
 {
   std::shared_ptr<Source> source = nullptr;
   {
     std::lock_guard<std::recursive_mutex> sentry(m_source_mutex);
-    if (m_activeSources.size() == 2)
+    if (m_activeSources.size() > 1)
     {
-        if (m_nextInitialSourceToggle)
+        // Send the read to the source expected to complete it first, accounting for the
+        // reads it already has outstanding.  Alternate between the sources while the
+        // bandwidth of one is unknown, and occasionally anyway to keep the estimates fresh.
+        source = m_activeSources[m_nextInitialSource++ % m_activeSources.size()];
+        if (m_distribution(m_generator) >= XRD_ADAPTOR_EXPLORE_PERCENT)
         {
-            source = m_activeSources[0];
-            m_nextInitialSourceToggle = false;
-        }
-        else
-        {
-            source = m_activeSources[1];
-            m_nextInitialSourceToggle = true;
+            std::shared_ptr<Source> fastest = nullptr;
+            float fastestMS = 0;
+            for (auto const& s : m_activeSources)
+            {
+                float ms = s->performance().expectedMS(size);
+                if (ms < 0) {fastest = nullptr; break;}
+                if (!fastest || ms < fastestMS) {fastest = s; fastestMS = ms;}
+            }
+            if (fastest) {source = fastest;}
         }
     }
     else if (m_activeSources.empty())
@@ -561,6 +669,23 @@ RequestManager::pickSingleSource()
   return source;
 }
 
+std::shared_ptr<Source>
+RequestManager::pickHedgeSource(std::shared_ptr<Source> const& primary, IOSize size)
+{
+  std::lock_guard<std::recursive_mutex> sentry(m_source_mutex);
+  std::shared_ptr<Source> source = nullptr;
+  float sourceMS = 0;
+  for (auto const& s : m_activeSources)
+  {
+    if (s.get() == primary.get()) {continue;}
+    // Fall back to the quality (itself an average request time) if the bandwidth is unknown.
+    float ms = s->performance().expectedMS(size);
+    if (ms < 0) {ms = s->getQuality();}
+    if (!source || ms < sourceMS) {source = s; sourceMS = ms;}
+  }
+  return source;
+}
+
 std::future<IOSize>
 RequestManager::handle(std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr)
 {
@@ -574,6 +699,7 @@ RequestManager::handle(std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr)
     activeSources = m_activeSources;
     inactiveSources = m_inactiveSources;
   }
+  bool hedge = false;
   {
     //make sure we update values before calling pickSingelSource
     std::shared_ptr<void*> guard(nullptr, [this, &activeSources, &inactiveSources](void *) {
@@ -583,13 +709,108 @@ RequestManager::handle(std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr)
     });
 
     checkSources(now, c_ptr->getSize(), activeSources, inactiveSources);
+    hedge = (activeSources.size() > 1) && c_ptr->getBuffer() && (c_ptr->getSize() <= XRD_ADAPTOR_HEDGE_MAX_SIZE);
   }
   
-  std::shared_ptr<Source> source = pickSingleSource();
+  std::shared_ptr<Source> source = pickSingleSource(c_ptr->getSize());
+  // Hedged reads are buffered and copied: only pay for it when the source is known to straggle.
+  if (hedge && source->performance().recentStraggler())
+  {
+    return handleHedged(source, c_ptr);
+  }
   source->handle(c_ptr);
   return c_ptr->get_future();
 }
 
+std::future<IOSize>
+RequestManager::handleHedged(std::shared_ptr<Source> const& source, std::shared_ptr<XrdAdaptor::ClientRequest> const& c_ptr)
+{
+  void *into = c_ptr->getBuffer();
+  IOSize size = c_ptr->getSize();
+  IOOffset off = c_ptr->getOffset();
+
+  float expectedMS = source->performance().expectedMS(size);
+  if (expectedMS < 0) {expectedMS = source->getQuality();}
+  std::chrono::milliseconds delay(std::max(static_cast<long long>(XRD_ADAPTOR_HEDGE_FACTOR*expectedMS),
+                                           static_cast<long long>(XRD_ADAPTOR_HEDGE_MIN_DELAY)));
+
+  // The caller holds the RequestManager while it waits on the returned future, but
+  // the losing read may complete later: each read keeps its own reference.
+  std::shared_ptr<RequestManager> self = m_self_weak.lock();
+  std::shared_ptr<BufferedClientRequest::Race> race = std::make_shared<BufferedClientRequest::Race>();
+  std::shared_ptr<BufferedClientRequest> primary(new BufferedClientRequest(self, race, size, off));
+  std::future<IOSize> primaryFuture = primary->get_future();
+  source->handle(primary);
+
+  return std::async(std::launch::deferred,
+    [this, self, race, into, size, off, delay, source, primary](std::future<IOSize> primaryFuture) {
+      if (primaryFuture.wait_for(delay) == std::future_status::ready)
+      {
+        return primary->copyTo(into, primaryFuture.get());
+      }
+      source->performance().markStraggler();
+      std::shared_ptr<Source> hedgeSource = pickHedgeSource(source, size);
+      if (!hedgeSource)
+      {
+        return primary->copyTo(into, primaryFuture.get());
+      }
+      edm::LogVerbatim("XrdAdaptorInternal") << "Read of " << size << " bytes from " << source->PrettyID()
+          << " is taking longer than " << delay.count() << " ms; duplicating it to " << hedgeSource->PrettyID() << std::endl;
+      std::shared_ptr<BufferedClientRequest> hedge(new BufferedClientRequest(self, race, size, off));
+      std::future<IOSize> hedgeFuture = hedge->get_future();
+      try
+      {
+        hedgeSource->handle(hedge);
+      }
+      catch (edm::Exception &)
+      {
+        return primary->copyTo(into, primaryFuture.get());
+      }
+
+      // Return the first successful result; only give up if both reads failed.  The promises
+      // are fulfilled before the responses are counted, under the lock held here between the
+      // checks: no response can be missed while waiting.
+      std::exception_ptr primaryError;
+      std::unique_lock<std::mutex> sentry(race->m_mutex);
+      while (primaryFuture.valid() || hedgeFuture.valid())
+      {
+        unsigned responses = race->m_responses;
+        if (primaryFuture.valid() && (primaryFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+        {
+          try
+          {
+            IOSize result = primary->copyTo(into, primaryFuture.get());
+            if (hedgeSource->siteStatistics()) {hedgeSource->siteStatistics()->hedgedRead(false);}
+            return result;
+          }
+          catch (...)
+          {
+            primaryError = std::current_exception();
+          }
+        }
+        if (hedgeFuture.valid() && (hedgeFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+        {
+          try
+          {
+            IOSize result = hedge->copyTo(into, hedgeFuture.get());
+            if (hedgeSource->siteStatistics()) {hedgeSource->siteStatistics()->hedgedRead(true);}
+            return result;
+          }
+          catch (...)
+          {
+            if (!primaryFuture.valid()) {std::rethrow_exception(primaryError);}
+          }
+        }
+        if (primaryFuture.valid() || hedgeFuture.valid())
+        {
+          race->m_cv.wait(sentry, [&race, responses]() {return race->m_responses != responses;});
+        }
+      }
+      std::rethrow_exception(primaryError);
+    },
+    std::move(primaryFuture));
+}
+
 std::string
 RequestManager::prepareOpaqueString() const
 {
@@ -652,7 +873,7 @@ XrdAdaptor::RequestManager::handleOpen(XrdCl::XRootDStatus &status, std::shared_
                 return;
             }
         }
-        if (m_activeSources.size() < 2)
+        if (m_activeSources.size() < XRD_ADAPTOR_MAX_ACTIVE_SOURCES)
         {
             auto oldSources = m_activeSources;
             m_activeSources.push_back(source);
@@ -698,15 +919,7 @@ XrdAdaptor::RequestManager::handle(std::shared_ptr<std::vector<IOPosBuffer> > io
     edm::CPUTimer timer;
     timer.start();
 
-    if (activeSources.size() == 1)
-    {
-        std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr(new XrdAdaptor::ClientRequest(*this, iolist));
-        checkSources(now, c_ptr->getSize(), activeSources,inactiveSources);
-        activeSources[0]->handle(c_ptr);
-        return c_ptr->get_future();
-    }
-    // Make sure active
-    else if (activeSources.empty())
+    if (activeSources.empty())
     {
         edm::Exception ex(edm::errors::FileReadError);
         ex << "XrdAdaptor::RequestManager::handle readv(name='" << m_name
@@ -719,11 +932,7 @@ XrdAdaptor::RequestManager::handle(std::shared_ptr<std::vector<IOPosBuffer> > io
     }
 
     assert(iolist.get());
-    std::shared_ptr<std::vector<IOPosBuffer> > req1(new std::vector<IOPosBuffer>);
-    std::shared_ptr<std::vector<IOPosBuffer> > req2(new std::vector<IOPosBuffer>);
-    splitClientRequest(*iolist, *req1, *req2, activeSources);
-
-    checkSources(now, req1->size() + req2->size(), activeSources, inactiveSources);
+    checkSources(now, iolist->size(), activeSources, inactiveSources);
     // CheckSources may have removed a source
     if (activeSources.size() == 1)
     {
@@ -732,28 +941,32 @@ XrdAdaptor::RequestManager::handle(std::shared_ptr<std::vector<IOPosBuffer> > io
         return c_ptr->get_future();
     }
 
-    std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr1, c_ptr2;
-    std::future<IOSize> future1, future2;
-    if (req1->size())
-    {
-        c_ptr1.reset(new XrdAdaptor::ClientRequest(*this, req1));
-        activeSources[0]->handle(c_ptr1);
-        future1 = c_ptr1->get_future();
-    }
-    if (req2->size())
+    std::vector<std::vector<IOPosBuffer> > requests;
+    splitClientRequest(*iolist, requests, activeSources);
+
+    std::vector<std::future<IOSize> > futures;
+    std::vector<std::shared_ptr<Source> > usedSources;
+    for (size_t idx = 0; idx < requests.size(); idx++)
     {
-        c_ptr2.reset(new XrdAdaptor::ClientRequest(*this, req2));
-        activeSources[1]->handle(c_ptr2);
-        future2 = c_ptr2->get_future();
+        if (requests[idx].empty()) {continue;}
+        std::shared_ptr<std::vector<IOPosBuffer> > req(new std::vector<IOPosBuffer>(std::move(requests[idx])));
+        std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr(new XrdAdaptor::ClientRequest(*this, req));
+        activeSources[idx]->handle(c_ptr);
+        futures.emplace_back(c_ptr->get_future());
+        usedSources.push_back(activeSources[idx]);
     }
-    if (req1->size() && req2->size())
+    if (futures.size() > 1)
     {
+        for (auto & source : usedSources)
+        {
+            if (source->siteStatistics()) {source->siteStatistics()->stripedRead(usedSources.size());}
+        }
         std::future<IOSize> task = std::async(std::launch::deferred,
-            [](std::future<IOSize> a, std::future<IOSize> b){
-                // Wait until *both* results are available.  This is essential
+            [](std::vector<std::future<IOSize> > futures){
+                // Wait until *all* results are available.  This is essential
                 // as the callback may try referencing the RequestManager.  If one
                 // throws an exception (causing the RequestManager to be destroyed by
-                // XrdFile) and the other has a failure, then the recovery code will
+                // XrdFile) and another has a failure, then the recovery code will
                 // reference the destroyed RequestManager.
                 //
                 // Unlike other places where we use shared/weak ptrs to maintain object
@@ -761,17 +974,17 @@ XrdAdaptor::RequestManager::handle(std::shared_ptr<std::vector<IOPosBuffer> > io
                 // asynchronously as it is associated with a ROOT buffer.  We must wait until we
                 // are guaranteed that XrdCl will not write into the ROOT buffer before we
                 // can return.
-                b.wait(); a.wait();
-                return b.get() + a.get();
+                for (auto & future : futures) {future.wait();}
+                IOSize total = 0;
+                for (auto & future : futures) {total += future.get();}
+                return total;
             },
-            std::move(future1),
-            std::move(future2));
+            std::move(futures));
         timer.stop();
         //edm::LogVerbatim("XrdAdaptorInternal") << "Total time to create requests " << static_cast<int>(1000*timer.realTime()) << std::endl;
         return task;
     }
-    else if (req1->size()) { return future1; }
-    else if (req2->size()) { return future2; }
+    else if (futures.size() == 1) { return std::move(futures[0]); }
     else
     {   // Degenerate case - no bytes to read.
         std::promise<IOSize> p; p.set_value(0);
@@ -808,16 +1021,12 @@ RequestManager::requestFailure(std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr,
     m_disabledSources.insert(source_ptr);
 
     std::unique_lock<std::recursive_mutex> sentry(m_source_mutex);
-    if ((m_activeSources.size() > 0) && (m_activeSources[0].get() == source_ptr.get()))
+    auto failed = std::find_if(m_activeSources.begin(), m_activeSources.end(),
+        [&source_ptr](const std::shared_ptr<Source> &s) {return s.get() == source_ptr.get();});
+    if (failed != m_activeSources.end())
     {
         auto oldSources = m_activeSources;
-        m_activeSources.erase(m_activeSources.begin());
-        reportSiteChange(oldSources, m_activeSources);
-    }
-    else if ((m_activeSources.size() > 1) && (m_activeSources[1].get() == source_ptr.get()))
-    {
-        auto oldSources = m_activeSources;
-        m_activeSources.erase(m_activeSources.begin()+1);
+        m_activeSources.erase(failed);
         reportSiteChange(oldSources, m_activeSources);
     }
     std::shared_ptr<Source> new_source;
@@ -998,29 +1207,98 @@ static IOSize validateList(const std::vector<IOPosBuffer> req)
     return total;
 }
 
+/*
+ * Compute the fraction of a vector read of the given size to send to each source.
+ * If the bandwidth of every source is known, the shares are chosen so all sources
+ * are expected to finish at the same time, accounting for their latency and the
+ * data they already have in flight; sources too slow to help get no share.
+ * Otherwise, weight each source by the inverse square of its quality.
+ */
+static void
+computeShares(IOSize size, std::vector<std::shared_ptr<Source>> const& sources, std::vector<float> &shares)
+{
+    size_t count = sources.size();
+    shares.assign(count, 0);
+    std::vector<double> latency(count), bandwidth(count), inflight(count);
+    bool known = size > 0;
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        latency[idx] = sources[idx]->performance().latencyMS();
+        bandwidth[idx] = sources[idx]->performance().bandwidth();
+        inflight[idx] = sources[idx]->performance().bytesInFlight();
+        if (bandwidth[idx] <= 0) {known = false;}
+    }
+    if (known)
+    {
+        // Each pass drops at least one source, and the source with the earliest
+        // availability always keeps a positive share.
+        std::vector<bool> used(count, true);
+        for (size_t pass = 0; pass < count; pass++)
+        {
+            double num = size, den = 0;
+            for (size_t idx = 0; idx < count; idx++)
+            {
+                if (!used[idx]) {continue;}
+                num += inflight[idx] + bandwidth[idx]*latency[idx];
+                den += bandwidth[idx];
+            }
+            double finish = num/den;
+            bool dropped = false;
+            for (size_t idx = 0; idx < count; idx++)
+            {
+                if (!used[idx]) {continue;}
+                double share = bandwidth[idx]*(finish-latency[idx]) - inflight[idx];
+                if (share <= 0) {used[idx] = false; dropped = true;}
+                else {shares[idx] = share/size;}
+            }
+            if (!dropped) {return;}
+            shares.assign(count, 0);
+        }
+    }
+        // The quality of all is increased by 5 to prevent strange effects if quality is 0 for one source.
+    float total = 0;
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        float q = static_cast<float>(sources[idx]->getQuality())+5;
+        shares[idx] = 1/(q*q);
+        total += shares[idx];
+    }
+    for (auto & share : shares) {share /= total;}
+}
+
 void
-XrdAdaptor::RequestManager::splitClientRequest(const std::vector<IOPosBuffer> &iolist, std::vector<IOPosBuffer> &req1, std::vector<IOPosBuffer> &req2, std::vector<std::shared_ptr<Source>> const& activeSources) const
+XrdAdaptor::RequestManager::splitClientRequest(const std::vector<IOPosBuffer> &iolist, std::vector<std::vector<IOPosBuffer>> &requests, std::vector<std::shared_ptr<Source>> const& activeSources) const
 {
+    requests.clear();
+    requests.resize(activeSources.size());
     if (iolist.size() == 0) return;
     std::vector<IOPosBuffer> tmp_iolist(iolist.begin(), iolist.end());
-    req1.reserve(iolist.size()/2+1);
-    req2.reserve(iolist.size()/2+1);
+    for (auto & req : requests) {req.reserve(iolist.size()/requests.size()+1);}
     size_t front=0;
 
-        // The quality of both is increased by 5 to prevent strange effects if quality is 0 for one source.
-    float q1 = static_cast<float>(activeSources[0]->getQuality())+5;
-    float q2 = static_cast<float>(activeSources[1]->getQuality())+5;
-    IOSize chunk1, chunk2;
-    // Make sure the chunk size is at least 1024; little point to reads less than that size.
-    chunk1 = std::max(static_cast<IOSize>(static_cast<float>(XRD_CL_MAX_CHUNK)*(q2*q2/(q1*q1+q2*q2))), static_cast<IOSize>(1024));
-    chunk2 = std::max(static_cast<IOSize>(static_cast<float>(XRD_CL_MAX_CHUNK)*(q1*q1/(q1*q1+q2*q2))), static_cast<IOSize>(1024));
-
     IOSize size_orig = 0;
     for (const auto & it : iolist) size_orig += it.size();
 
+    std::vector<float> shares;
+    computeShares(size_orig, activeSources, shares);
+    std::vector<IOSize> chunks(shares.size(), 0);
+    for (size_t idx = 0; idx < shares.size(); idx++)
+    {
+        // Make sure the chunk size is at least 1024; little point to reads less than that size.
+        if (shares[idx] > 0) {chunks[idx] = std::max(static_cast<IOSize>(static_cast<float>(XRD_CL_MAX_CHUNK)*shares[idx]), static_cast<IOSize>(1024));}
+    }
+
+    // All sources but the last one consume from the front of the list, and the last
+    // one from the back; with two sources, each gets a mostly-contiguous range.
+    size_t last = requests.size()-1;
     while (tmp_iolist.size()-front > 0)
     {
-        if ((req1.size() >= XRD_ADAPTOR_CHUNK_THRESHOLD) && (req2.size() >= XRD_ADAPTOR_CHUNK_THRESHOLD))
+        bool room = false;
+        for (size_t idx = 0; idx < requests.size(); idx++)
+        {
+            if (chunks[idx] && (requests[idx].size() < XRD_ADAPTOR_CHUNK_THRESHOLD)) {room = true;}
+        }
+        if (!room)
         {   // The XrdFile::readv implementation should guarantee that no more than approximately 1024 chunks
             // are passed to the request manager.  However, because we have a max chunk size, we increase
             // the total number slightly.  Theoretically, it's possible an individual readv of total size >2GB where
@@ -1035,22 +1313,33 @@ XrdAdaptor::RequestManager::splitClientRequest(const std::vector<IOPosBuffer> &i
             addConnections(ex);
             std::stringstream ss; ss << "Original request size " << iolist.size() << "(" << size_orig << " bytes)";
             ex.addAdditionalInfo(ss.str());
-            std::stringstream ss2; ss2 << "Quality source 1 " << q1-5 << ", quality source 2: " << q2-5;
-            ex.addAdditionalInfo(ss2.str());
+            for (size_t idx = 0; idx < activeSources.size(); idx++)
+            {
+                std::stringstream ss2; ss2 << "Quality source " << idx+1 << ": " << activeSources[idx]->getQuality() << ", share " << shares[idx];
+                ex.addAdditionalInfo(ss2.str());
+            }
             throw ex;
         }
-        if (req1.size() < XRD_ADAPTOR_CHUNK_THRESHOLD) {consumeChunkFront(front, tmp_iolist, req1, chunk1);}
-        if (req2.size() < XRD_ADAPTOR_CHUNK_THRESHOLD) {consumeChunkBack(front, tmp_iolist, req2, chunk2);}
+        for (size_t idx = 0; idx < last; idx++)
+        {
+            if (chunks[idx] && (requests[idx].size() < XRD_ADAPTOR_CHUNK_THRESHOLD)) {consumeChunkFront(front, tmp_iolist, requests[idx], chunks[idx]);}
+        }
+        if (chunks[last] && (requests[last].size() < XRD_ADAPTOR_CHUNK_THRESHOLD)) {consumeChunkBack(front, tmp_iolist, requests[last], chunks[last]);}
     }
-    std::sort(req1.begin(), req1.end(), [](const IOPosBuffer & left, const IOPosBuffer & right){return left.offset() < right.offset();});
-    std::sort(req2.begin(), req2.end(), [](const IOPosBuffer & left, const IOPosBuffer & right){return left.offset() < right.offset();});
 
-    IOSize size1 = validateList(req1);
-    IOSize size2 = validateList(req2);
+    std::stringstream ss;
+    IOSize size_total = 0;
+    for (auto & req : requests)
+    {
+        std::sort(req.begin(), req.end(), [](const IOPosBuffer & left, const IOPosBuffer & right){return left.offset() < right.offset();});
+        IOSize size = validateList(req);
+        size_total += size;
+        ss << " " << req.size() << " (" << size << " bytes)";
+    }
 
-    assert(size_orig == size1 + size2);
+    assert(size_orig == size_total);
 
-    edm::LogVerbatim("XrdAdaptorInternal") << "Original request size " << iolist.size() << " (" << size_orig << " bytes) split into requests size " << req1.size() << " (" << size1 << " bytes) and " << req2.size() << " (" << size2 << " bytes)" << std::endl;
+    edm::LogVerbatim("XrdAdaptorInternal") << "Original request size " << iolist.size() << " (" << size_orig << " bytes) split into requests size" << ss.str() << std::endl;
 }
 
 XrdAdaptor::RequestManager::OpenHandler::OpenHandler(std::weak_ptr<RequestManager> manager)
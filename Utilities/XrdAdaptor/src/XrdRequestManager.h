@@ -143,12 +143,24 @@ private:
     virtual void handleOpen(XrdCl::XRootDStatus &status, std::shared_ptr<Source>);
 
     /**
-     * Given a client request, split it into two requests lists.
+     * Given a client request, split it into one request list per active source.
+     * The share of each source follows its expected latency and bandwidth; a
+     * list may be left empty if the source is too slow to help.
      */
     void splitClientRequest(const std::vector<IOPosBuffer> &iolist,
-                            std::vector<IOPosBuffer> &req1, std::vector<IOPosBuffer> &req2,
+                            std::vector<std::vector<IOPosBuffer>> &requests,
                             std::vector<std::shared_ptr<Source>> const& activeSources) const;
 
+    /**
+     * Issue a single read to the given source; if it does not complete within
+     * a few times its expected duration, duplicate it to another active source and
+     * return whichever result comes first.  Both reads go to private buffers
+     * so the loser may complete after the client buffer was handed back; each
+     * one holds a reference to the RequestManager until it is done.
+     */
+    std::future<IOSize> handleHedged(std::shared_ptr<Source> const& source,
+                                     std::shared_ptr<XrdAdaptor::ClientRequest> const& c_ptr);
+
     /**
      * Given a request, broadcast it to all sources.
      * If active is true, broadcast is made to all active sources.
@@ -173,13 +185,21 @@ private:
      * versus source B; if source A is significantly worse, remove it from
      * the list of active sources.
      *
-     * NOTE: assumes two sources are active and the caller must already hold
+     * NOTE: assumes at least two sources are active and the caller must already hold
      * m_source_mutex
      */
     bool compareSources(const timespec &now, unsigned a, unsigned b,
                         std::vector<std::shared_ptr<Source>>& activeSources,
                         std::vector<std::shared_ptr<Source>>& inactiveSources) const;
 
+    /**
+     * Compare every active source against the best one, removing those which
+     * are significantly worse.  Returns true if a new source should be searched for.
+     */
+    bool pruneActiveSources(const timespec &now,
+                            std::vector<std::shared_ptr<Source>>& activeSources,
+                            std::vector<std::shared_ptr<Source>>& inactiveSources) const;
+
     /**
      * Anytime we potentially switch sources, update the internal site source list;
      * alert the user if necessary.
@@ -195,9 +215,15 @@ private:
     void queueUpdateCurrentServer(const std::string &);
 
     /**
-     * Picks a single source for the next operation.
+     * Picks a single source for the next operation of the given size.
+     */
+    std::shared_ptr<Source> pickSingleSource(IOSize size);
+
+    /**
+     * Picks the active source, other than the given one, expected to serve
+     * a read of the given size the fastest; nullptr if there is none.
      */
-    std::shared_ptr<Source> pickSingleSource();
+    std::shared_ptr<Source> pickHedgeSource(std::shared_ptr<Source> const& primary, IOSize size);
 
     /**
      * Prepare an opaque string appropriate for asking a redirector to open the
@@ -222,8 +248,8 @@ private:
 
     timespec m_lastSourceCheck;
     int m_timeout;
-    // If set to true, the next active source should be 1; 0 otherwise.
-    bool m_nextInitialSourceToggle;
+    // Index of the next active source to use when alternating between sources.
+    unsigned m_nextInitialSource;
     // The time when the next active source check should be performed.
     timespec m_nextActiveSourceCheck;
     bool searchMode;
@@ -295,6 +321,8 @@ private:
     };
 
     std::shared_ptr<OpenHandler> m_open_handler;
+    // Lets the hedged reads share the ownership of the RequestManager.
+    std::weak_ptr<RequestManager> m_self_weak;
 };
 
 }
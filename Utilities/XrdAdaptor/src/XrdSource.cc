@@ -423,6 +423,8 @@ Source::handle(std::shared_ptr<ClientRequest> c)
     c->m_source = shared_from_this();
     c->m_self_reference = c;
     m_qm->startWatch(c->m_qmw);
+    m_perf.startRead(c->m_size);
+    c->m_start = std::chrono::steady_clock::now();
     if (m_stats)
     {
         std::shared_ptr<XrdReadStatistics> readStats = XrdSiteStatistics::startRead(stats(), c);
@@ -9,6 +9,7 @@
 #include <boost/utility.hpp>
 
 #include "QualityMetric.h"
+#include "XrdStatistics.h"
 
 namespace XrdCl {
     class File;
@@ -18,7 +19,6 @@ namespace XrdAdaptor {
 
 class RequestList;
 class ClientRequest;
-class XrdSiteStatistics;
 class XrdStatisticsService;
 
 class Source : public std::enable_shared_from_this<Source>, boost::noncopyable {
@@ -41,6 +41,13 @@ public:
 
     unsigned getQuality() {return m_qm->get();}
 
+    // Latency and bandwidth estimates used to steer the reads between sources.
+    XrdSourcePerformance const& performance() const {return m_perf;}
+    XrdSourcePerformance & performance() {return m_perf;}
+
+    // Site statistics, if the XrdStatisticsService is active; may be nullptr.
+    std::shared_ptr<XrdSiteStatistics>& siteStatistics() {return stats();}
+
     struct timespec getLastDowngrade() const {return m_lastDowngrade;}
     void setLastDowngrade(struct timespec now) {m_lastDowngrade = now;}
 
@@ -79,6 +86,7 @@ private:
 
     edm::propagate_const<std::unique_ptr<QualityMetricSource>> m_qm;
     edm::propagate_const<std::shared_ptr<XrdSiteStatistics>> m_stats;
+    XrdSourcePerformance m_perf;
 
 #ifdef XRD_FAKE_SLOW
     bool m_slow;
@@ -9,8 +9,19 @@
 #include "XrdRequest.h"
 #include "XrdStatistics.h"
 
+#include <algorithm>
 #include <chrono>
 
+// Reads up to this size measure the latency of a source, larger ones its bandwidth.
+#define XRD_LATENCY_READ_SIZE 64*1024
+// Weight of the newest measurement in the running estimates.
+#define XRD_PERFORMANCE_SMOOTHING 0.2f
+// A read is a straggler when it takes XRD_STRAGGLER_FACTOR times longer than expected,
+// and at least XRD_STRAGGLER_MIN_MS ms; it is remembered for XRD_STRAGGLER_MEMORY seconds.
+#define XRD_STRAGGLER_FACTOR 4
+#define XRD_STRAGGLER_MIN_MS 100
+#define XRD_STRAGGLER_MEMORY 60
+
 using namespace XrdAdaptor;
 
 
@@ -97,7 +108,11 @@ XrdSiteStatistics::XrdSiteStatistics(std::string const &site) :
     m_readvNS(0.0),
     m_readCount(0),
     m_readSize(0),
-    m_readNS(0)
+    m_readNS(0),
+    m_stripedCount(0),
+    m_stripeSources(0),
+    m_hedgeCount(0),
+    m_hedgeWins(0)
 {
 }
 
@@ -140,6 +155,11 @@ XrdSiteStatistics::recomputeProperties(std::map<std::string, std::string> &props
     props["read-numOperations"] = i2str(m_readCount);
     props["read-totalMegabytes"] = d2str(static_cast<float>(m_readSize)/(1024.0*1024.0));
     props["read-totalMsecs"] = d2str(static_cast<float>(m_readNS)/1e6);
+
+    props["readv-numStriped"] = i2str(m_stripedCount);
+    props["readv-numStripes"] = i2str(m_stripeSources);
+    props["read-numHedged"] = i2str(m_hedgeCount);
+    props["read-numHedgeWins"] = i2str(m_hedgeWins);
 }
 
 
@@ -162,6 +182,22 @@ XrdSiteStatistics::finishRead(XrdReadStatistics const &readStats)
 }
 
 
+void
+XrdSiteStatistics::stripedRead(unsigned sources)
+{
+    m_stripedCount ++;
+    m_stripeSources += sources;
+}
+
+
+void
+XrdSiteStatistics::hedgedRead(bool won)
+{
+    m_hedgeCount ++;
+    if (won) {m_hedgeWins ++;}
+}
+
+
 XrdReadStatistics::XrdReadStatistics(std::shared_ptr<XrdSiteStatistics> parent, IOSize size, size_t count) :
     m_size(size),
     m_count(count),
@@ -178,3 +214,81 @@ XrdReadStatistics::elapsedNS() const
     return static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(end-m_start).count());
 }
 
+
+
+XrdSourcePerformance::XrdSourcePerformance() :
+    m_latencyMS(-1),
+    m_bandwidth(0),
+    m_bytesInFlight(0),
+    m_lastStraggler(0)
+{
+}
+
+
+void
+XrdSourcePerformance::finishRead(IOSize size, std::chrono::nanoseconds elapsed, bool success)
+{
+    m_bytesInFlight -= size;
+    if (!success) {return;}
+
+    float ms = std::max(static_cast<float>(elapsed.count())/1e6f, 0.001f);
+    std::lock_guard<std::mutex> sentry(m_mutex);
+    if (m_bandwidth > 0 && ms > XRD_STRAGGLER_MIN_MS &&
+        ms > XRD_STRAGGLER_FACTOR*(std::max(m_latencyMS, 0.f) + static_cast<float>(size)/m_bandwidth))
+    {
+        markStraggler();
+    }
+    if (size <= XRD_LATENCY_READ_SIZE)
+    {
+        m_latencyMS = (m_latencyMS < 0) ? ms : (1-XRD_PERFORMANCE_SMOOTHING)*m_latencyMS + XRD_PERFORMANCE_SMOOTHING*ms;
+    }
+    else
+    {
+        // Do not charge the latency of the request to the transfer itself.
+        float transferMS = std::max(ms - std::max(m_latencyMS, 0.f), ms/2);
+        float sample = static_cast<float>(size)/transferMS;
+        m_bandwidth = (m_bandwidth <= 0) ? sample : (1-XRD_PERFORMANCE_SMOOTHING)*m_bandwidth + XRD_PERFORMANCE_SMOOTHING*sample;
+    }
+}
+
+
+float
+XrdSourcePerformance::latencyMS() const
+{
+    std::lock_guard<std::mutex> sentry(m_mutex);
+    return std::max(m_latencyMS, 0.f);
+}
+
+
+float
+XrdSourcePerformance::bandwidth() const
+{
+    std::lock_guard<std::mutex> sentry(m_mutex);
+    return m_bandwidth;
+}
+
+
+void
+XrdSourcePerformance::markStraggler()
+{
+    m_lastStraggler = std::max<std::chrono::steady_clock::rep>(std::chrono::steady_clock::now().time_since_epoch().count(), 1);
+}
+
+
+bool
+XrdSourcePerformance::recentStraggler() const
+{
+    auto last = m_lastStraggler.load();
+    if (!last) {return false;}
+    auto since = std::chrono::steady_clock::now() - std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(last));
+    return since < std::chrono::seconds(XRD_STRAGGLER_MEMORY);
+}
+
+
+float
+XrdSourcePerformance::expectedMS(IOSize size) const
+{
+    std::lock_guard<std::mutex> sentry(m_mutex);
+    if (m_bandwidth <= 0) {return -1;}
+    return std::max(m_latencyMS, 0.f) + static_cast<float>(m_bytesInFlight + size)/m_bandwidth;
+}
@@ -24,6 +24,7 @@ namespace XrdAdaptor
 class ClientRequest;
 class XrdReadStatistics;
 class XrdSiteStatistics;
+class XrdSourcePerformance;
 
 
 /* NOTE: All member information is kept in the XrdSiteStatisticsInformation singleton,
@@ -81,6 +82,11 @@ public:
 
     void finishRead(XrdReadStatistics const &);
 
+    // Record a vector read striped across several sources, and a single read
+    // duplicated to a second source because the first was slow.
+    void stripedRead(unsigned sources);
+    void hedgedRead(bool won);
+
 private:
     const std::string m_site = "Unknown";
 
@@ -91,6 +97,10 @@ private:
     std::atomic<unsigned> m_readCount;
     std::atomic<uint64_t> m_readSize;
     std::atomic<uint64_t> m_readNS;
+    std::atomic<unsigned> m_stripedCount;
+    std::atomic<unsigned> m_stripeSources;
+    std::atomic<unsigned> m_hedgeCount;
+    std::atomic<unsigned> m_hedgeWins;
 };
 
 class XrdReadStatistics
@@ -115,6 +125,44 @@ private:
     std::chrono::time_point<std::chrono::high_resolution_clock> m_start;
 };
 
+/* Continuously-updated latency and bandwidth estimates for a single source.
+ * Unlike the per-site statistics, these are always kept: the RequestManager
+ * uses them to decide how to share the reads between the active sources.
+ */
+class XrdSourcePerformance
+{
+public:
+    XrdSourcePerformance();
+    XrdSourcePerformance(const XrdSourcePerformance&) = delete;
+    XrdSourcePerformance &operator=(const XrdSourcePerformance&) = delete;
+
+    void startRead(IOSize size) {m_bytesInFlight += size;}
+    void finishRead(IOSize size, std::chrono::nanoseconds elapsed, bool success);
+
+    // Latency in ms, estimated from the small reads.
+    float latencyMS() const;
+    // Bandwidth in bytes per ms, estimated from the large reads; 0 until one completed.
+    float bandwidth() const;
+    uint64_t bytesInFlight() const {return m_bytesInFlight;}
+
+    // Expected time, in ms, for this source to serve a new read of the given size
+    // once the outstanding reads are done; negative if the bandwidth is unknown.
+    float expectedMS(IOSize size) const;
+
+    // A straggler is a read taking several times longer than expected.  Reads are only
+    // hedged on sources which recently had one, so the others are spared the buffering.
+    void markStraggler();
+    bool recentStraggler() const;
+
+private:
+    mutable std::mutex m_mutex;
+    float m_latencyMS;
+    float m_bandwidth;
+    std::atomic<uint64_t> m_bytesInFlight;
+    // Time of the last straggler, in steady_clock ticks; 0 if there was none.
+    std::atomic<std::chrono::steady_clock::rep> m_lastStraggler;
+};
+
 }
 
 #endif
@@ -52,6 +52,7 @@ class MultiTrackValidator : public DQMEDAnalyzer, protected MultiTrackValidatorB
   edm::EDGetTokenT<edm::ValueMap<unsigned int> > tpNStripStereoLayersToken_;
 
   std::string dirName_;
+  bool parallelAssociation_;
 
   bool useGsf;
   // select tracking particles 
@@ -28,6 +28,7 @@
 #include "CommonTools/Utils/interface/associationMapFilterValues.h"
 #include<type_traits>
 #include <unordered_set>
+#include "tbb/parallel_for.h"
 
 
 #include "TMath.h"
@@ -59,6 +60,7 @@ MultiTrackValidator::MultiTrackValidator(const edm::ParameterSet& pset):
 
   dirName_ = pset.getParameter<std::string>("dirName");
   UseAssociators = pset.getParameter< bool >("UseAssociators");
+  parallelAssociation_ = pset.exists("parallelAssociation") ? pset.getUntrackedParameter<bool>("parallelAssociation") : false;
 
   tpNLayersToken_ = consumes<edm::ValueMap<unsigned int> >(pset.getParameter<edm::InputTag>("label_tp_nlayers"));
   tpNPixelLayersToken_ = consumes<edm::ValueMap<unsigned int> >(pset.getParameter<edm::InputTag>("label_tp_npixellayers"));
@@ -520,6 +522,38 @@ void MultiTrackValidator::analyze(const edm::Event& event, const edm::EventSetup
     v_dEdx.push_back(dEdx2Handle.product());
   }
 
+  // With parallelAssociation, the track collections are associated with all
+  // associators up front, as concurrent tasks; the histograms are filled
+  // in the loop below as before, in the same order.
+  std::vector<reco::RecoToSimCollection> recSimColls;
+  std::vector<reco::SimToRecoCollection> simRecColls;
+  if(UseAssociators && parallelAssociation_) {
+    std::vector<const reco::TrackToTrackingParticleAssociator *> theAssociators(associators.size());
+    for (unsigned int ww=0;ww<associators.size();ww++){
+      edm::Handle<reco::TrackToTrackingParticleAssociator> theAssociator;
+      event.getByToken(associatorTokens[ww], theAssociator);
+      theAssociators[ww] = theAssociator.product();
+    }
+    // a missing collection is left empty here, and handled in the loop below
+    std::vector<edm::RefToBaseVector<reco::Track> > trackRefs(label.size());
+    for (unsigned int www=0;www<label.size();www++){
+      edm::Handle<View<Track> >  trackCollectionHandle;
+      if(!event.getByToken(labelToken[www], trackCollectionHandle)) continue;
+      for(edm::View<Track>::size_type i=0; i<trackCollectionHandle->size(); ++i) {
+        trackRefs[www].push_back(trackCollectionHandle->refAt(i));
+      }
+    }
+
+    recSimColls.resize(associators.size()*label.size());
+    simRecColls.resize(associators.size()*label.size());
+    tbb::parallel_for(0U, (unsigned int)(associators.size()*label.size()), [&](unsigned int iw) {
+        const unsigned int ww = iw / label.size();
+        const unsigned int www = iw % label.size();
+        recSimColls[iw] = theAssociators[ww]->associateRecoToSim(trackRefs[www], tPCfake);
+        simRecColls[iw] = theAssociators[ww]->associateSimToReco(trackRefs[www], tPCfake);
+      });
+  }
+
   int w=0; //counter counting the number of sets of histograms
   for (unsigned int ww=0;ww<associators.size();ww++){
     for (unsigned int www=0;www<label.size();www++, w++){ // need to increment w here, since there are many continues in the loop body
@@ -539,7 +573,11 @@ void MultiTrackValidator::analyze(const edm::Event& event, const edm::EventSetup
       LogTrace("TrackValidator") << "Analyzing "
                                  << label[www] << " with "
                                  << associators[ww] <<"\n";
-      if(UseAssociators){
+      if(UseAssociators && parallelAssociation_){
+        recSimCollP = &recSimColls[w];
+        simRecCollP = &simRecColls[w];
+      }
+      else if(UseAssociators){
         edm::Handle<reco::TrackToTrackingParticleAssociator> theAssociator;
         event.getByToken(associatorTokens[ww], theAssociator);
 